@@ -0,0 +1,30 @@
+TARGET = boardimg
+DESTDIR = $$PWD
+
+include(../lib/lib.pri)
+include(../lib/libexport.pri)
+include(../gui/src/boardview/boardview.pri)
+
+INCLUDEPATH += ../gui/src/boardview
+
+OBJECTS_DIR = .obj/
+MOC_DIR = .moc/
+RCC_DIR = .rcc/
+
+win32 {
+    CONFIG += console
+}
+
+!win32-msvc* {
+	QMAKE_CXXFLAGS += -Wextra -Wshadow
+}
+
+mac {
+    CONFIG -= app_bundle
+}
+
+QT = core gui svg widgets
+
+RESOURCES += ../gui/res/chessboard/chessboard.qrc
+
+SOURCES += main.cpp
@@ -0,0 +1,185 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * A headless board image renderer for broadcast overlays.
+ *
+ * Renders positions to PNG or SVG with the same BoardScene drawing
+ * code the GUI uses, so overlays don't have to screenshot a desktop.
+ * A single render:
+ *
+ *     boardimg [-variant <variant>] [-size <pixels>] <file> <fen>
+ *
+ * or a long-running batch mode that reads "<file>\t<fen>" lines from
+ * standard input and renders one image per line:
+ *
+ *     boardimg [-variant <variant>] [-size <pixels>] -
+ *
+ * Batch mode reports "ok <file>" or "error <reason>" per line on
+ * standard output. It keeps the process and the shared piece pixmap
+ * cache warm, so re-rendering thumbnails for many live games every
+ * second costs milliseconds per board. Pass "-platform offscreen" to
+ * run without a display server.
+ */
+
+#include <QApplication>
+#include <QImage>
+#include <QPainter>
+#include <QSvgGenerator>
+#include <QTextStream>
+
+#include <board/boardfactory.h>
+#include <boardscene.h>
+
+namespace {
+
+bool renderImage(BoardScene* scene, const QString& fileName, int size)
+{
+	scene->setSceneRect(scene->itemsBoundingRect());
+
+	if (fileName.endsWith(".svg", Qt::CaseInsensitive))
+	{
+		QSvgGenerator svg;
+		svg.setFileName(fileName);
+		svg.setSize(QSize(size, size));
+		svg.setViewBox(QRect(0, 0, size, size));
+
+		QPainter painter;
+		if (!painter.begin(&svg))
+			return false;
+		scene->render(&painter, QRectF(0, 0, size, size));
+		return painter.end();
+	}
+
+	QImage image(size, size, QImage::Format_ARGB32_Premultiplied);
+	image.fill(Qt::transparent);
+
+	QPainter painter(&image);
+	painter.setRenderHint(QPainter::Antialiasing);
+	painter.setRenderHint(QPainter::SmoothPixmapTransform);
+	scene->render(&painter, QRectF(0, 0, size, size));
+	painter.end();
+
+	return image.save(fileName);
+}
+
+bool renderPosition(BoardScene* scene,
+		    const QString& fileName,
+		    const QString& fen,
+		    int size)
+{
+	if (!scene->board()->setFenString(fen))
+		return false;
+	scene->populate();
+
+	return renderImage(scene, fileName, size);
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+	QApplication app(argc, argv);
+
+	QString variant = "standard";
+	int size = 512;
+
+	QStringList args = app.arguments();
+	args.removeFirst();
+
+	while (!args.isEmpty()
+	&&     args.first().startsWith('-')
+	&&     args.first() != "-")
+	{
+		QString arg = args.takeFirst();
+		if (arg == "-variant" && !args.isEmpty())
+			variant = args.takeFirst();
+		else if (arg == "-size" && !args.isEmpty())
+			size = args.takeFirst().toInt();
+		else
+		{
+			qWarning("Unknown option: \"%s\"", qUtf8Printable(arg));
+			return 1;
+		}
+	}
+
+	if (size <= 0)
+	{
+		qWarning("Invalid image size");
+		return 1;
+	}
+	if (!Chess::BoardFactory::variants().contains(variant))
+	{
+		qWarning("Unknown variant: \"%s\"", qUtf8Printable(variant));
+		return 1;
+	}
+
+	BoardScene scene;
+	scene.setBoard(Chess::BoardFactory::create(variant));
+	scene.setAnimationDuration(0);
+
+	if (args.size() == 2)
+	{
+		if (!renderPosition(&scene, args.at(0), args.at(1), size))
+		{
+			qWarning("Cannot render \"%s\"",
+				 qUtf8Printable(args.at(0)));
+			return 1;
+		}
+		return 0;
+	}
+
+	if (args.size() != 1 || args.first() != "-")
+	{
+		qWarning("Usage: boardimg [-variant <variant>] [-size <pixels>] <file> <fen>\n"
+			 "       boardimg [-variant <variant>] [-size <pixels>] -");
+		return 1;
+	}
+
+	QTextStream in(stdin);
+	QTextStream out(stdout);
+	int errors = 0;
+
+	QString line;
+	while (in.readLineInto(&line))
+	{
+		if (line.isEmpty())
+			continue;
+
+		const int sep = line.indexOf('\t');
+		if (sep <= 0)
+		{
+			out << "error invalid input line" << '\n' << flush;
+			errors++;
+			continue;
+		}
+
+		const QString fileName = line.left(sep);
+		const QString fen = line.mid(sep + 1);
+
+		if (renderPosition(&scene, fileName, fen, size))
+			out << "ok " << fileName << '\n' << flush;
+		else
+		{
+			out << "error " << fileName << '\n' << flush;
+			errors++;
+		}
+	}
+
+	return errors == 0 ? 0 : 1;
+}
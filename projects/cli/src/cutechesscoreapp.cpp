@@ -20,18 +20,92 @@
 #include <QTime>
 #include <QFileInfo>
 #include <QDir>
+#include <QThread>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include <QPair>
+#include <QTimer>
+#include <QUdpSocket>
 #include <mersenne.h>
 #include <enginemanager.h>
 #include <gamemanager.h>
+#include <metrics.h>
+#include <tracer.h>
 #include <board/syzygytablebase.h>
 #include <cstdlib>
 #include <cstdio>
 
+namespace {
+
+// Writes console output on its own thread so that a slow terminal or
+// a blocked stdout can't stall the threads that run the tournament
+// and the games.
+class ConsoleWriter : public QThread
+{
+	public:
+		ConsoleWriter()
+			: m_quit(false)
+		{
+		}
+
+		void post(FILE* stream, const QByteArray& line)
+		{
+			QMutexLocker locker(&m_mutex);
+			m_queue.append(qMakePair(stream, line));
+			m_cond.wakeOne();
+		}
+
+		// Drains the queue and terminates the thread
+		void stop()
+		{
+			m_mutex.lock();
+			m_quit = true;
+			m_cond.wakeOne();
+			m_mutex.unlock();
+			wait();
+		}
+
+	protected:
+		virtual void run()
+		{
+			QMutexLocker locker(&m_mutex);
+			for (;;)
+			{
+				while (m_queue.isEmpty() && !m_quit)
+					m_cond.wait(&m_mutex);
+				if (m_queue.isEmpty())
+					return;
+
+				const auto batch = m_queue;
+				m_queue.clear();
+
+				locker.unlock();
+				for (const auto& item : batch)
+					fputs(item.second.constData(),
+					      item.first);
+				locker.relock();
+			}
+		}
+
+	private:
+		QMutex m_mutex;
+		QWaitCondition m_cond;
+		QList<QPair<FILE*, QByteArray> > m_queue;
+		bool m_quit;
+};
+
+ConsoleWriter* s_consoleWriter = nullptr;
+
+} // anonymous namespace
+
 
 CuteChessCoreApplication::CuteChessCoreApplication(int& argc, char* argv[])
 	: QCoreApplication(argc, argv),
 	  m_engineManager(nullptr),
-	  m_gameManager(nullptr)
+	  m_gameManager(nullptr),
+	  m_statsdSocket(nullptr),
+	  m_statsdPort(0)
 {
 	Mersenne::initialize(QTime(0,0,0).msecsTo(QTime::currentTime()));
 
@@ -42,17 +116,35 @@ CuteChessCoreApplication::CuteChessCoreApplication(int& argc, char* argv[])
 	// Use Ini format on all platforms
 	QSettings::setDefaultFormat(QSettings::IniFormat);
 
+	s_consoleWriter = new ConsoleWriter;
+	s_consoleWriter->start();
 	qInstallMessageHandler(CuteChessCoreApplication::messageHandler);
 
-	// Load the engines
+	// Locate the engine configuration file. Its entries are
+	// parsed on demand, so startup doesn't pay for engines the
+	// match doesn't reference.
 	QString configFile("engines.json");
 	if (!QFile::exists(configFile))
 		configFile = configPath() + "/" + configFile;
-	engineManager()->loadEngines(configFile);
+	engineManager()->setConfigFile(configFile);
+
+	startMetricsExporter();
+
+	// Opt-in lifecycle tracing: CUTECHESS_TRACE=<file> writes a
+	// Chrome trace-event JSON log of the run to <file>
+	const QString traceFile =
+		QString::fromLocal8Bit(qgetenv("CUTECHESS_TRACE"));
+	if (!traceFile.isEmpty())
+		Tracer::start(traceFile);
 }
 
 CuteChessCoreApplication::~CuteChessCoreApplication()
 {
+	Tracer::finish();
+	qInstallMessageHandler(nullptr);
+	s_consoleWriter->stop();
+	delete s_consoleWriter;
+	s_consoleWriter = nullptr;
 }
 
 void CuteChessCoreApplication::messageHandler(QtMsgType type,
@@ -60,26 +152,39 @@ void CuteChessCoreApplication::messageHandler(QtMsgType type,
 					      const QString &message)
 {
 	QByteArray msg = message.toLocal8Bit();
+	QByteArray line;
+	FILE* stream = stdout;
 	switch (type)
 	{
 	case QtInfoMsg:
-		fprintf(stdout, "%s\n", msg.constData());
+		line = msg + '\n';
 		break;
 	case QtDebugMsg:
-		fprintf(stdout, "Debug: %s\n", msg.constData());
+		line = "Debug: " + msg + '\n';
 		break;
 	case QtWarningMsg:
-		fprintf(stderr, "Warning: %s\n", msg.constData());
+		stream = stderr;
+		line = "Warning: " + msg + '\n';
 		break;
 	case QtCriticalMsg:
-		fprintf(stderr, "Critical: %s (%s:%u, %s)\n", msg.constData(),
-			context.file, context.line, context.function);
+		stream = stderr;
+		line = "Critical: " + msg + " (" + context.file + ':'
+		     + QByteArray::number(context.line) + ", "
+		     + context.function + ")\n";
 		break;
 	case QtFatalMsg:
+		// Drain any pending output before aborting
+		if (s_consoleWriter != nullptr)
+			s_consoleWriter->stop();
 		fprintf(stderr, "Fatal: %s (%s:%u, %s)\n", msg.constData(),
 			context.file, context.line, context.function);
 		abort();
 	}
+
+	if (s_consoleWriter != nullptr)
+		s_consoleWriter->post(stream, line);
+	else
+		fputs(line.constData(), stream);
 }
 
 QString CuteChessCoreApplication::configPath()
@@ -95,6 +200,57 @@ QString CuteChessCoreApplication::configPath()
 	return fi.absolutePath();
 }
 
+void CuteChessCoreApplication::startMetricsExporter()
+{
+	// The exporter is off by default; setting the CUTECHESS_STATSD
+	// environment variable to "address:port" (or just an address,
+	// defaulting to port 8125) makes the application push its
+	// Metrics counters to that statsd server every ten seconds.
+	// UDP gauges were chosen over an HTTP endpoint to keep the
+	// exporter passive: a stalled collector can't block or slow
+	// down the tournament.
+	const QString target = QString::fromLocal8Bit(qgetenv("CUTECHESS_STATSD"));
+	if (target.isEmpty())
+		return;
+
+	const int sep = target.lastIndexOf(':');
+	const QHostAddress address(sep < 0 ? target : target.left(sep));
+	quint16 port = 8125;
+	bool ok = !address.isNull();
+	if (ok && sep >= 0)
+		port = target.midRef(sep + 1).toUShort(&ok);
+	if (!ok)
+	{
+		qWarning("Invalid CUTECHESS_STATSD value \"%s\", expected "
+			 "\"address:port\"", qUtf8Printable(target));
+		return;
+	}
+
+	m_statsdAddress = address;
+	m_statsdPort = port;
+	m_statsdSocket = new QUdpSocket(this);
+
+	QTimer* timer = new QTimer(this);
+	connect(timer, SIGNAL(timeout()), this, SLOT(exportMetrics()));
+	timer->start(10000);
+}
+
+void CuteChessCoreApplication::exportMetrics()
+{
+	QByteArray datagram;
+	for (int i = 0; i < Metrics::CounterCount; i++)
+	{
+		const auto counter = Metrics::Counter(i);
+		datagram += "cutechess.";
+		datagram += Metrics::key(counter).toLatin1();
+		datagram += ':';
+		datagram += QByteArray::number(Metrics::value(counter));
+		datagram += "|g\n";
+	}
+
+	m_statsdSocket->writeDatagram(datagram, m_statsdAddress, m_statsdPort);
+}
+
 EngineManager* CuteChessCoreApplication::engineManager()
 {
 	if (m_engineManager == nullptr)
@@ -21,7 +21,9 @@
 
 #include <QCoreApplication>
 #include <QMessageLogContext>
+#include <QHostAddress>
 
+class QUdpSocket;
 class EngineManager;
 class GameManager;
 
@@ -41,9 +43,19 @@ class CuteChessCoreApplication : public QCoreApplication
 		static void messageHandler(QtMsgType type,
 					   const QMessageLogContext &context,
 					   const QString &message);
+	private slots:
+		// Sends the current Metrics counters to the statsd
+		// server configured with CUTECHESS_STATSD
+		void exportMetrics();
+
 	private:
+		void startMetricsExporter();
+
 		EngineManager* m_engineManager;
 		GameManager* m_gameManager;
+		QUdpSocket* m_statsdSocket;
+		QHostAddress m_statsdAddress;
+		quint16 m_statsdPort;
 };
 
 #endif  // CUTE_CHESS_CORE_APPLICATION_H
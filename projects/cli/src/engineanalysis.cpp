@@ -0,0 +1,373 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "engineanalysis.h"
+#include <QFile>
+#include <QTextStream>
+#include <board/board.h>
+#include <board/boardfactory.h>
+#include <chessplayer.h>
+#include <randomplayer.h>
+#include <playerbuilder.h>
+#include <moveevaluation.h>
+#include <tournament.h>
+#include <tournamentplayer.h>
+#include <jsonserializer.h>
+
+namespace {
+
+QString csvField(const QString& str)
+{
+	if (!str.contains(',') && !str.contains('"'))
+		return str;
+
+	QString quoted(str);
+	quoted.replace("\"", "\"\"");
+	return '\"' + quoted + '\"';
+}
+
+} // anonymous namespace
+
+EngineAnalysis::EngineAnalysis(Tournament* tournament, QObject* parent)
+	: QObject(parent),
+	  m_tournament(tournament),
+	  m_nextPosition(0),
+	  m_activeWorkers(0),
+	  m_stopped(false)
+{
+	Q_ASSERT(tournament != nullptr);
+}
+
+EngineAnalysis::~EngineAnalysis()
+{
+	for (const Worker& worker : m_workers)
+		delete worker.board;
+}
+
+bool EngineAnalysis::setEpdFile(const QString& fileName)
+{
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+		return false;
+
+	QTextStream in(&file);
+	while (!in.atEnd())
+	{
+		QString line = in.readLine().trimmed();
+		if (line.isEmpty() || line.startsWith('#'))
+			continue;
+
+		QStringList tokens = line.split(' ', QString::SkipEmptyParts);
+		if (tokens.size() < 4)
+			continue;
+
+		Position pos;
+		pos.fen = QStringList(tokens.mid(0, 4)).join(' ');
+
+		int idIndex = tokens.indexOf("id");
+		if (idIndex > 3 && idIndex < tokens.size() - 1)
+		{
+			QString id = QStringList(tokens.mid(idIndex + 1)).join(' ');
+			int end = id.indexOf(';');
+			if (end >= 0)
+				id.truncate(end);
+			id.remove('\"');
+			pos.id = id.trimmed();
+		}
+
+		m_positions.append(pos);
+	}
+
+	return !m_positions.isEmpty();
+}
+
+void EngineAnalysis::setOutputFile(const QString& fileName)
+{
+	m_outputFile = fileName;
+}
+
+void EngineAnalysis::start()
+{
+	m_timer.start();
+	m_results.resize(m_positions.size());
+
+	for (int i = 0; i < m_tournament->playerCount(); i++)
+	{
+		const TournamentPlayer& player = m_tournament->playerAt(i);
+
+		QString error;
+		ChessPlayer* engine = player.builder()->create(nullptr,
+							       nullptr,
+							       this,
+							       &error);
+		if (engine == nullptr)
+		{
+			qWarning("%s", qUtf8Printable(error));
+			continue;
+		}
+
+		if (player.timeControl().isInfinite())
+			qWarning("Engine %s has an infinite time control; "
+				 "use a tc, st or depth limit for analysis",
+				 qUtf8Printable(engine->name()));
+		engine->setTimeControl(player.timeControl());
+
+		Worker worker = { engine,
+				  new RandomPlayer(this),
+				  Chess::BoardFactory::create(m_tournament->variant()),
+				  -1 };
+		m_workers.append(worker);
+	}
+
+	if (m_workers.isEmpty())
+	{
+		qWarning("No engines could be started for analysis");
+		finish();
+		return;
+	}
+	m_activeWorkers = m_workers.size();
+
+	// The workers are all in place now, so the vector won't
+	// reallocate under the pointers used by the slots
+	for (const Worker& worker : m_workers)
+	{
+		connect(worker.engine, SIGNAL(ready()),
+			this, SLOT(onReady()));
+		connect(worker.engine, SIGNAL(moveMade(Chess::Move)),
+			this, SLOT(onMoveMade(Chess::Move)));
+		connect(worker.engine, SIGNAL(resultClaim(Chess::Result)),
+			this, SLOT(onResultClaim(Chess::Result)));
+		connect(worker.engine, SIGNAL(disconnected()),
+			this, SLOT(onDisconnected()));
+	}
+}
+
+void EngineAnalysis::stop()
+{
+	if (m_stopped)
+		return;
+	m_stopped = true;
+
+	for (const Worker& worker : m_workers)
+	{
+		if (worker.engine->state() != ChessPlayer::Disconnected)
+			worker.engine->quit();
+	}
+}
+
+EngineAnalysis::Worker* EngineAnalysis::workerFromSender()
+{
+	QObject* obj = QObject::sender();
+	for (Worker& worker : m_workers)
+	{
+		if (worker.engine == obj)
+			return &worker;
+	}
+
+	return nullptr;
+}
+
+void EngineAnalysis::assignNext(Worker* worker)
+{
+	if (m_stopped || m_nextPosition >= m_positions.size())
+	{
+		worker->engine->quit();
+		return;
+	}
+
+	int index = m_nextPosition++;
+	const Position& pos = m_positions.at(index);
+
+	if (!worker->board->setFenString(pos.fen))
+	{
+		qWarning("Invalid EPD position %d: %s",
+			 index + 1, qUtf8Printable(pos.fen));
+
+		QVariantMap result;
+		result["fen"] = pos.fen;
+		if (!pos.id.isEmpty())
+			result["id"] = pos.id;
+		result["error"] = "invalid position";
+		m_results[index] = result;
+
+		assignNext(worker);
+		return;
+	}
+
+	worker->position = index;
+	worker->engine->newGame(worker->board->sideToMove(),
+				worker->opponent,
+				worker->board);
+	worker->engine->go();
+}
+
+void EngineAnalysis::onReady()
+{
+	Worker* worker = workerFromSender();
+	if (worker == nullptr || worker->position >= 0)
+		return;
+
+	assignNext(worker);
+}
+
+void EngineAnalysis::onMoveMade(const Chess::Move& move)
+{
+	Worker* worker = workerFromSender();
+	if (worker == nullptr || worker->position < 0)
+		return;
+
+	int index = worker->position;
+	const Position& pos = m_positions.at(index);
+	const MoveEvaluation& eval = worker->engine->evaluation();
+
+	QVariantMap result;
+	result["fen"] = pos.fen;
+	if (!pos.id.isEmpty())
+		result["id"] = pos.id;
+	result["engine"] = worker->engine->name();
+	result["bestmove"] = worker->board->moveString(move,
+		Chess::Board::StandardAlgebraic);
+	result["score"] = eval.score();
+	result["depth"] = eval.depth();
+	result["time"] = eval.time();
+	m_results[index] = result;
+
+	qInfo("Analyzed position %d of %d (%s): %s",
+	      index + 1,
+	      m_positions.size(),
+	      qUtf8Printable(pos.id.isEmpty() ? pos.fen : pos.id),
+	      qUtf8Printable(result["bestmove"].toString()));
+
+	worker->position = -1;
+	// Ends with a ping; the engine picks up its next position
+	// when the ready() signal arrives
+	worker->engine->endGame(Chess::Result());
+}
+
+void EngineAnalysis::onResultClaim(const Chess::Result& result)
+{
+	Worker* worker = workerFromSender();
+	if (worker == nullptr || worker->position < 0)
+		return;
+
+	int index = worker->position;
+	const Position& pos = m_positions.at(index);
+
+	qWarning("Engine %s failed on position %d: %s",
+		 qUtf8Printable(worker->engine->name()),
+		 index + 1,
+		 qUtf8Printable(result.description()));
+
+	QVariantMap entry;
+	entry["fen"] = pos.fen;
+	if (!pos.id.isEmpty())
+		entry["id"] = pos.id;
+	entry["engine"] = worker->engine->name();
+	entry["error"] = result.description();
+	m_results[index] = entry;
+
+	worker->position = -1;
+	worker->engine->endGame(Chess::Result());
+}
+
+void EngineAnalysis::onDisconnected()
+{
+	Worker* worker = workerFromSender();
+	if (worker == nullptr)
+		return;
+
+	if (worker->position >= 0)
+	{
+		const Position& pos = m_positions.at(worker->position);
+
+		QVariantMap entry;
+		entry["fen"] = pos.fen;
+		if (!pos.id.isEmpty())
+			entry["id"] = pos.id;
+		entry["engine"] = worker->engine->name();
+		entry["error"] = "engine terminated";
+		m_results[worker->position] = entry;
+
+		worker->position = -1;
+	}
+
+	if (--m_activeWorkers <= 0)
+		finish();
+}
+
+void EngineAnalysis::writeResults()
+{
+	QFile file(m_outputFile);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+	{
+		qWarning("Cannot open analysis output file %s",
+			 qUtf8Printable(m_outputFile));
+		return;
+	}
+	QTextStream out(&file);
+
+	if (m_outputFile.endsWith(".csv", Qt::CaseInsensitive))
+	{
+		out << "id,fen,engine,bestmove,score,depth,time,error\n";
+		for (const QVariant& entry : m_results)
+		{
+			if (entry.isNull())
+				continue;
+
+			QVariantMap map = entry.toMap();
+			out << csvField(map["id"].toString()) << ','
+			    << csvField(map["fen"].toString()) << ','
+			    << csvField(map["engine"].toString()) << ','
+			    << map["bestmove"].toString() << ','
+			    << map["score"].toInt() << ','
+			    << map["depth"].toInt() << ','
+			    << map["time"].toInt() << ','
+			    << csvField(map["error"].toString()) << '\n';
+		}
+	}
+	else
+	{
+		QVariantList list;
+		for (const QVariant& entry : m_results)
+		{
+			if (!entry.isNull())
+				list.append(entry);
+		}
+
+		JsonSerializer serializer(list);
+		serializer.serialize(out);
+	}
+}
+
+void EngineAnalysis::finish()
+{
+	writeResults();
+
+	int analyzed = 0;
+	for (const QVariant& entry : m_results)
+	{
+		if (!entry.isNull())
+			analyzed++;
+	}
+	qInfo("Analyzed %d of %d positions in %.2f seconds",
+	      analyzed,
+	      m_positions.size(),
+	      m_timer.elapsed() / 1000.0);
+
+	emit finished();
+}
@@ -0,0 +1,121 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ENGINEANALYSIS_H
+#define ENGINEANALYSIS_H
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <QVariant>
+#include <QElapsedTimer>
+#include <board/move.h>
+#include <board/result.h>
+
+namespace Chess { class Board; }
+class ChessPlayer;
+class Tournament;
+
+/*!
+ * \brief A batch analysis session for EPD test suites.
+ *
+ * EngineAnalysis feeds the positions of an EPD file through the
+ * engines configured for a tournament. Each engine process is
+ * started once and stays running for the whole suite; an engine is
+ * handed the next unanalyzed position as soon as it reports a best
+ * move, so all engines stay busy until the suite runs out.
+ *
+ * The best move, score, depth and thinking time of every position
+ * are written to an output file in JSON format, or in CSV format
+ * if the file name ends in ".csv".
+ */
+class EngineAnalysis : public QObject
+{
+	Q_OBJECT
+
+	public:
+		/*!
+		 * Creates a new analysis session that uses the engines
+		 * and time controls of \a tournament.
+		 */
+		EngineAnalysis(Tournament* tournament, QObject* parent = nullptr);
+		virtual ~EngineAnalysis();
+
+		/*!
+		 * Loads the positions to analyze from the EPD file
+		 * \a fileName. Lines that don't begin with a valid
+		 * position are skipped; the "id" opcode, if present,
+		 * names the position in the results.
+		 *
+		 * Returns true if at least one position was loaded;
+		 * otherwise returns false.
+		 */
+		bool setEpdFile(const QString& fileName);
+		/*! Sets the output file to \a fileName. */
+		void setOutputFile(const QString& fileName);
+
+	public slots:
+		/*! Starts the engines and the analysis. */
+		void start();
+		/*!
+		 * Stops the analysis. The results collected so far are
+		 * still written to the output file.
+		 */
+		void stop();
+
+	signals:
+		/*! This signal is emitted when the analysis is done. */
+		void finished();
+
+	private slots:
+		void onReady();
+		void onMoveMade(const Chess::Move& move);
+		void onResultClaim(const Chess::Result& result);
+		void onDisconnected();
+
+	private:
+		struct Position
+		{
+			QString fen;
+			QString id;
+		};
+		struct Worker
+		{
+			ChessPlayer* engine;
+			ChessPlayer* opponent;
+			Chess::Board* board;
+			int position;
+		};
+
+		Worker* workerFromSender();
+		void assignNext(Worker* worker);
+		void writeResults();
+		void finish();
+
+		Tournament* m_tournament;
+		QString m_outputFile;
+		QVector<Position> m_positions;
+		QVector<Worker> m_workers;
+		QVector<QVariant> m_results;
+		QElapsedTimer m_timer;
+		int m_nextPosition;
+		int m_activeWorkers;
+		bool m_stopped;
+};
+
+#endif // ENGINEANALYSIS_H
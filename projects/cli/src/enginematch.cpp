@@ -17,16 +17,21 @@
 
 #include "econode.h"
 #include "board/board.h"
+#include "board/syzygytablebase.h"
 
 #include "enginematch.h"
+#include "engineanalysis.h"
 #include <QtMath>
 #include <QList>
+#include <QVector>
 #include <QMultiMap>
 #include <QTextCodec>
+#include <QTimer>
 #include <chessplayer.h>
 #include <playerbuilder.h>
 #include <chessgame.h>
 #include <polyglotbook.h>
+#include <layeredbook.h>
 #include <tournament.h>
 #include <gamemanager.h>
 #include <sprt.h>
@@ -37,11 +42,18 @@ EngineMatch::EngineMatch(Tournament* tournament, QObject* parent)
 	: QObject(parent),
 	  m_tournament(tournament),
 	  m_debug(false),
+	  m_quiet(false),
 	  m_ratingInterval(0),
+	  m_tableInterval(1),
 	  m_bookMode(OpeningBook::Ram),
 	  m_eloKfactor(32.0),
 	  m_pgnFormat(true),
-	  m_jsonFormat(true)
+	  m_jsonFormat(true),
+	  m_stopFileTimer(nullptr),
+	  m_benchmark(false),
+	  m_sharedGameManager(false),
+	  m_analysis(nullptr),
+	  m_stopping(false)
 {
 	Q_ASSERT(tournament != nullptr);
 
@@ -64,6 +76,31 @@ OpeningBook* EngineMatch::addOpeningBook(const QString& fileName)
 	if (m_books.contains(fileName))
 		return m_books[fileName];
 
+	// A semicolon-separated list of book files is layered into
+	// one logical book, with the first file probed first
+	const QStringList fileNames =
+		fileName.split(';', QString::SkipEmptyParts);
+	if (fileNames.size() > 1)
+	{
+		LayeredBook* book = new LayeredBook(LayeredBook::Priority);
+		for (const QString& name : fileNames)
+		{
+			PolyglotBook* layer = new PolyglotBook(m_bookMode);
+			if (!layer->read(name))
+			{
+				delete layer;
+				delete book;
+				qWarning("Can't read opening book file %s",
+					 qUtf8Printable(name));
+				return nullptr;
+			}
+			book->addLayer(layer);
+		}
+
+		m_books[fileName] = book;
+		return book;
+	}
+
 	PolyglotBook* book = new PolyglotBook(m_bookMode);
 	if (!book->read(fileName))
 	{
@@ -78,6 +115,27 @@ OpeningBook* EngineMatch::addOpeningBook(const QString& fileName)
 
 void EngineMatch::start()
 {
+	if (!m_analyzeFile.isEmpty())
+	{
+		m_analysis = new EngineAnalysis(m_tournament, this);
+		m_analysis->setOutputFile(m_analyzeOutput);
+		connect(m_analysis, SIGNAL(finished()),
+			this, SIGNAL(finished()));
+
+		if (!m_analysis->setEpdFile(m_analyzeFile))
+		{
+			qWarning("Cannot read any positions from %s",
+				 qUtf8Printable(m_analyzeFile));
+			QMetaObject::invokeMethod(this, "finished",
+						  Qt::QueuedConnection);
+			return;
+		}
+
+		QMetaObject::invokeMethod(m_analysis, "start",
+					  Qt::QueuedConnection);
+		return;
+	}
+
 	connect(m_tournament, SIGNAL(finished()),
 		this, SLOT(onTournamentFinished()));
 	connect(m_tournament, SIGNAL(gameStarted(ChessGame*, int, int, int)),
@@ -91,25 +149,163 @@ void EngineMatch::start()
 		connect(m_tournament->gameManager(), SIGNAL(debugMessage(QString)),
 			this, SLOT(print(QString)));
 
+	if (!m_stopFile.isEmpty())
+	{
+		m_stopFileTimer = new QTimer(this);
+		m_stopFileTimer->setInterval(1000);
+		connect(m_stopFileTimer, SIGNAL(timeout()),
+			this, SLOT(onStopFilePoll()));
+		m_stopFileTimer->start();
+	}
+
 	QMetaObject::invokeMethod(m_tournament, "start", Qt::QueuedConnection);
 }
 
 void EngineMatch::stop()
 {
+	if (m_analysis != nullptr)
+	{
+		QMetaObject::invokeMethod(m_analysis, "stop",
+					  Qt::QueuedConnection);
+		return;
+	}
+
+	if (m_stopping)
+	{
+		// A repeated stop request aborts the match: terminate the
+		// engines instead of waiting for their games to finish
+		qInfo("Aborting the tournament");
+		QMetaObject::invokeMethod(m_tournament, "abort",
+					  Qt::QueuedConnection);
+		return;
+	}
+
+	m_stopping = true;
 	QMetaObject::invokeMethod(m_tournament, "stop", Qt::QueuedConnection);
 }
 
+void EngineMatch::setStopFile(const QString& fileName)
+{
+	m_stopFile = fileName;
+}
+
+void EngineMatch::onStopFilePoll()
+{
+	if (!QFile::exists(m_stopFile))
+		return;
+
+	m_stopFileTimer->stop();
+	qInfo("Stop file %s found: stopping the tournament",
+	      qUtf8Printable(m_stopFile));
+	stop();
+}
+
 void EngineMatch::setDebugMode(bool debug)
 {
 	m_debug = debug;
 }
 
+void EngineMatch::setQuietMode(bool quiet)
+{
+	m_quiet = quiet;
+}
+
+void EngineMatch::setBenchmarkMode(bool benchmark)
+{
+	m_benchmark = benchmark;
+}
+
+void EngineMatch::setSharedGameManager(bool shared)
+{
+	m_sharedGameManager = shared;
+}
+
+void EngineMatch::setAnalysis(const QString& epdFile,
+			      const QString& outputFile)
+{
+	m_analyzeFile = epdFile;
+	m_analyzeOutput = outputFile;
+}
+
 void EngineMatch::setRatingInterval(int interval)
 {
 	Q_ASSERT(interval >= 0);
 	m_ratingInterval = interval;
 }
 
+void EngineMatch::setTableInterval(int interval)
+{
+	Q_ASSERT(interval > 0);
+	m_tableInterval = interval;
+}
+
+bool EngineMatch::tablesDue() const
+{
+	return m_tableInterval <= 1
+	    || (m_tournament->finishedGameCount() % m_tableInterval) == 0;
+}
+
+void EngineMatch::regenerateTables()
+{
+	if (m_tournamentFile.isEmpty() || !QFile::exists(m_tournamentFile))
+		return;
+
+	QFile input(m_tournamentFile);
+	if (!input.open(QIODevice::ReadOnly | QIODevice::Text))
+	{
+		qWarning("cannot open tournament configuration file: %s",
+			 qUtf8Printable(m_tournamentFile));
+		return;
+	}
+
+	QTextStream stream(&input);
+	JsonParser jsonParser(stream);
+	QVariantMap tfMap = jsonParser.parse().toMap();
+
+	QVariantMap eMap;
+	eMap.insert("matchProgress", tfMap["matchProgress"].toList());
+	eMap.insert("tournamentSettings", tfMap["tournamentSettings"].toMap());
+
+	generateSchedule(eMap);
+	generateCrossTable(eMap);
+}
+
+// Writes the tournament file to a temporary file first and renames it
+// into place, so a crash mid-write can never leave a truncated file
+// behind: after a crash either the old or the new checkpoint is intact
+// and the tournament can always be resumed.
+void EngineMatch::writeTournamentFile(const QVariantMap& tfMap,
+				      const QString& fileName)
+{
+	const QString tempName(fileName + ".temp");
+	if (QFile::exists(tempName))
+		QFile::remove(tempName);
+	QFile output(tempName);
+	if (!output.open(QIODevice::WriteOnly | QIODevice::Text)) {
+		qWarning("cannot open tournament configuration file: %s", qUtf8Printable(tempName));
+		return;
+	}
+	QTextStream out(&output);
+	JsonSerializer serializer(tfMap);
+	serializer.serialize(out);
+	output.close();
+	if (QFile::exists(fileName))
+		QFile::remove(fileName);
+	if (!QFile::rename(tempName, fileName))
+		qWarning("cannot rename tournament configuration file: %s to %s",
+			 qUtf8Printable(tempName), qUtf8Printable(fileName));
+}
+
+void EngineMatch::saveTournamentFile(const QVariantMap& tfMap)
+{
+	writeTournamentFile(tfMap, m_tournamentFile);
+
+	// Mirror the checkpoint so that a standby machine can resume
+	// the tournament if this one dies
+	if (!m_tournamentStandbyFile.isEmpty())
+		writeTournamentFile(tfMap, m_tournamentStandbyFile);
+}
+
 void EngineMatch::setBookMode(OpeningBook::AccessMode mode)
 {
 	m_bookMode = mode;
@@ -120,6 +316,11 @@ void EngineMatch::setTournamentFile(QString& tournamentFile)
 	m_tournamentFile = tournamentFile;
 }
 
+void EngineMatch::setTournamentFileStandby(const QString& fileName)
+{
+	m_tournamentStandbyFile = fileName;
+}
+
 void EngineMatch::setEloKfactor(qreal eloKfactor)
 {
 	m_eloKfactor = eloKfactor;
@@ -608,59 +809,50 @@ void EngineMatch::generateCrossTable(QVariantMap& eMap)
 			}
 		}
 	}
-	// calculate SB (nullified by disqualification)
+	// Pack the pairwise results into flat index-addressed arrays
+	// once, so the SB/Elo/performance passes below read plain
+	// integers instead of re-parsing the result strings behind
+	// nested QMap lookups for every pair of players
+	const int ctSize = ctMap.size();
+	QMap<QString, int> ctIndex;
+	QVector<qreal> ctScores(ctSize);
+	QVector<qreal> ctRatings(ctSize);
+	QVector<bool> ctDisqualified(ctSize);
+	QVector<int> pairWins(ctSize * ctSize, 0);
+	QVector<int> pairDraws(ctSize * ctSize, 0);
+	QVector<int> pairGames(ctSize * ctSize, 0);
+
 	QMapIterator<QString, CrossTableData> ct(ctMap);
-	qreal largestSB = 1.0;
-	qreal largestScore = 1.0;
-	while (ct.hasNext()) {
-		ct.next();
-		CrossTableData& ctd = ctMap[ct.key()];
-		if (!ctd.m_disqualified) {
-			QMapIterator<QString, QString> td(ctd.m_tableData);
-			qreal sb = 0.0;
-			while (td.hasNext()) {
-				td.next();
-				CrossTableData& otd = ctMap[td.key()];
-				if (!otd.m_disqualified) {
-					QString::ConstIterator c = td.value().begin();
-					while (c != td.value().end()) {
-						if (*c == QChar('1')) {
-							sb += otd.m_score;
-						} else if (*c == QChar('=')) {
-							sb += otd.m_score / 2.;
-						}
-						c++;
-					}
-				}
-			}
-			ctd.m_neustadtlScore = sb;
-			if (ctd.m_neustadtlScore > largestSB) largestSB = ctd.m_neustadtlScore;
-			if (ctd.m_score > largestScore) largestScore = ctd.m_score;
+	{
+		int index = 0;
+		while (ct.hasNext()) {
+			ct.next();
+			ctIndex.insert(ct.key(), index);
+			ctScores[index] = ct.value().m_score;
+			ctRatings[index] = ct.value().m_rating;
+			ctDisqualified[index] = ct.value().m_disqualified;
+			++index;
 		}
 	}
-	// calculate Elo (not nullified by disqualification)
-	qreal maxElo = 1;
 	ct.toFront();
 	while (ct.hasNext()) {
 		ct.next();
-		CrossTableData& ctd = ctMap[ct.key()];
-
-		QMapIterator<QString, CrossTableData> ot(ct);
-		while (ot.hasNext()) {
-			ot.next();
-			CrossTableData& otd = ctMap[ot.key()];
-			const QString& tds = ctd.m_tableData[ot.key()];
-
-			int score = 0;
+		const int i = ctIndex.value(ct.key());
+		QMapIterator<QString, QString> td(ct.value().m_tableData);
+		while (td.hasNext()) {
+			td.next();
+			const int j = ctIndex.value(td.key());
+			int wins = 0;
+			int draws = 0;
 			int games = 0;
-			for (QString::ConstIterator c = tds.begin(); c != tds.end(); ++c)
+			for (QString::ConstIterator c = td.value().begin(); c != td.value().end(); ++c)
 				switch(c->toLatin1()) {
 				case '1':
-					score += 2;
+					++wins;
 					++games;
 					break;
 				case '=':
-					++score;
+					++draws;
 					++games;
 					break;
 				case '0':
@@ -669,16 +861,57 @@ void EngineMatch::generateCrossTable(QVariantMap& eMap)
 				default:
 					break;
 				}
+			pairWins[i * ctSize + j] = wins;
+			pairDraws[i * ctSize + j] = draws;
+			pairGames[i * ctSize + j] = games;
+		}
+	}
 
-			if (games > 0) {
-				const qreal real = static_cast<qreal>(score) / (games * 2);
-				const qreal expected = 1.0 / (1.0 + qPow(10.0, (otd.m_rating - ctd.m_rating) / 400.0));
-				const qreal elo =  m_eloKfactor * (real - expected) * games;
-
-				ctd.m_elo += elo;
-				otd.m_elo -= elo;
+	// calculate SB (nullified by disqualification)
+	qreal largestSB = 1.0;
+	qreal largestScore = 1.0;
+	ct.toFront();
+	while (ct.hasNext()) {
+		ct.next();
+		CrossTableData& ctd = ctMap[ct.key()];
+		if (!ctd.m_disqualified) {
+			const int i = ctIndex.value(ct.key());
+			qreal sb = 0.0;
+			for (int j = 0; j < ctSize; j++) {
+				if (ctDisqualified[j])
+					continue;
+				sb += pairWins[i * ctSize + j] * ctScores[j]
+				   +  pairDraws[i * ctSize + j] * ctScores[j] / 2.;
 			}
+			ctd.m_neustadtlScore = sb;
+			if (ctd.m_neustadtlScore > largestSB) largestSB = ctd.m_neustadtlScore;
+			if (ctd.m_score > largestScore) largestScore = ctd.m_score;
+		}
+	}
+	// calculate Elo (not nullified by disqualification)
+	qreal maxElo = 1;
+	QVector<qreal> eloDiff(ctSize, 0.0);
+	for (int i = 0; i < ctSize; i++) {
+		for (int j = i + 1; j < ctSize; j++) {
+			const int games = pairGames[i * ctSize + j];
+			if (games <= 0)
+				continue;
+
+			const int score = pairWins[i * ctSize + j] * 2
+					+ pairDraws[i * ctSize + j];
+			const qreal real = static_cast<qreal>(score) / (games * 2);
+			const qreal expected = 1.0 / (1.0 + qPow(10.0, (ctRatings[j] - ctRatings[i]) / 400.0));
+			const qreal elo =  m_eloKfactor * (real - expected) * games;
+
+			eloDiff[i] += elo;
+			eloDiff[j] -= elo;
 		}
+	}
+	ct.toFront();
+	while (ct.hasNext()) {
+		ct.next();
+		CrossTableData& ctd = ctMap[ct.key()];
+		ctd.m_elo += eloDiff[ctIndex.value(ct.key())];
 
 		const qreal totElo = ctd.m_elo < 0 ? -ctd.m_elo : ctd.m_elo;
 		if (totElo > maxElo)
@@ -692,37 +925,14 @@ void EngineMatch::generateCrossTable(QVariantMap& eMap)
 	while (ct.hasNext()) {
 		ct.next();
 		CrossTableData& ctd = ctMap[ct.key()];
+		const int i = ctIndex.value(ct.key());
 
 		int totScore = 0;
 		int totGames = 0;
-		QMapIterator<QString, CrossTableData> ot(ctMap);
-		while (ot.hasNext()) {
-			ot.next();
-			if (ot.key() == ct.key()) continue;
-
-			const QString& tds = ctd.m_tableData[ot.key()];
-
-			int score = 0;
-			int games = 0;
-			for (QString::ConstIterator c = tds.begin(); c != tds.end(); ++c)
-				switch(c->toLatin1()) {
-				case '1':
-					score += 2;
-					++games;
-					break;
-				case '=':
-					++score;
-					++games;
-					break;
-				case '0':
-					++games;
-					break;
-				default:
-					break;
-				}
-
-			totScore += score;
-			totGames += games;
+		for (int j = 0; j < ctSize; j++) {
+			totScore += pairWins[i * ctSize + j] * 2
+				  + pairDraws[i * ctSize + j];
+			totGames += pairGames[i * ctSize + j];
 		}
 
 		if (totGames > 0) {
@@ -949,11 +1159,12 @@ void EngineMatch::onGameStarted(ChessGame* game, int number)
 {
 	Q_ASSERT(game != nullptr);
 
-	qInfo("Started game %d of %d (%s vs %s)",
-	      number,
-	      m_tournament->finalGameCount(),
-	      qUtf8Printable(game->player(Chess::Side::White)->name()),
-	      qUtf8Printable(game->player(Chess::Side::Black)->name()));
+	if (!m_quiet)
+		qInfo("Started game %d of %d (%s vs %s)",
+		      number,
+		      m_tournament->finalGameCount(),
+		      qUtf8Printable(game->player(Chess::Side::White)->name()),
+		      qUtf8Printable(game->player(Chess::Side::Black)->name()));
 
 	if (!m_tournamentFile.isEmpty()) {
 		QVariantMap tfMap;
@@ -996,22 +1207,16 @@ void EngineMatch::onGameStarted(ChessGame* game, int number)
 		pMap.insert("terminationDetails", "in progress");
 		pList.append(pMap);
 		tfMap.insert("matchProgress", pList);
+		saveTournamentFile(tfMap);
+		if (tablesDue())
 		{
-			QFile output(m_tournamentFile);
-			if (!output.open(QIODevice::WriteOnly | QIODevice::Text)) {
-				qWarning("cannot open tournament configuration file: %s", qUtf8Printable(m_tournamentFile));
-			} else {
-				QTextStream out(&output);
-				JsonSerializer serializer(tfMap);
-				serializer.serialize(out);
-			}
-		}
-		QVariantMap eMap;
-		eMap.insert("matchProgress", pList);
-		eMap.insert("tournamentSettings", tsMap);
+			QVariantMap eMap;
+			eMap.insert("matchProgress", pList);
+			eMap.insert("tournamentSettings", tsMap);
 
-		generateSchedule(eMap);
-		generateCrossTable(eMap);
+			generateSchedule(eMap);
+			generateCrossTable(eMap);
+		}
 	}
 }
 
@@ -1026,11 +1231,12 @@ void EngineMatch::onGameFinished(ChessGame* game, int number)
 	Q_ASSERT(game != nullptr);
 
 	Chess::Result result(game->result());
-	qInfo("Finished game %d (%s vs %s): %s",
-	      number,
-	      qUtf8Printable(game->player(Chess::Side::White)->name()),
-	      qUtf8Printable(game->player(Chess::Side::Black)->name()),
-	      qUtf8Printable(result.toVerboseString()));
+	if (!m_quiet)
+		qInfo("Finished game %d (%s vs %s): %s",
+		      number,
+		      qUtf8Printable(game->player(Chess::Side::White)->name()),
+		      qUtf8Printable(game->player(Chess::Side::Black)->name()),
+		      qUtf8Printable(result.toVerboseString()));
 
 	if (!m_tournamentFile.isEmpty()) {
 		QVariantMap tfMap;
@@ -1119,25 +1325,21 @@ void EngineMatch::onGameFinished(ChessGame* game, int number)
 				tfMap.insert("matchProgress", pList);
 				tfMap.insert("strikes", stMap);
 
-				QFile output(m_tournamentFile);
-				if (!output.open(QIODevice::WriteOnly | QIODevice::Text)) {
-					qWarning("cannot open tournament configuration file: %s", qUtf8Printable(m_tournamentFile));
-				} else {
-					QTextStream out(&output);
-					JsonSerializer serializer(tfMap);
-					serializer.serialize(out);
-				}
-				QVariantMap eMap;
-				eMap.insert("matchProgress", pList);
-				eMap.insert("tournamentSettings", tsMap);
+				saveTournamentFile(tfMap);
+				if (tablesDue())
+				{
+					QVariantMap eMap;
+					eMap.insert("matchProgress", pList);
+					eMap.insert("tournamentSettings", tsMap);
 
-				generateSchedule(eMap);
-				generateCrossTable(eMap);
+					generateSchedule(eMap);
+					generateCrossTable(eMap);
+				}
 			}
 		}
 	}
 
-	if (m_tournament->playerCount() == 2)
+	if (m_tournament->playerCount() == 2 && !m_quiet)
 	{
 		TournamentPlayer fcp = m_tournament->playerAt(0);
 		TournamentPlayer scp = m_tournament->playerAt(1);
@@ -1157,10 +1359,11 @@ void EngineMatch::onGameFinished(ChessGame* game, int number)
 
 void EngineMatch::onGameSkipped(int number, int iWhite, int iBlack)
 {
-	qInfo("Skipped game %d (%s vs %s)",
-	      number,
-	      qUtf8Printable(m_tournament->playerAt(iWhite).name()),
-	      qUtf8Printable(m_tournament->playerAt(iBlack).name()));
+	if (!m_quiet)
+		qInfo("Skipped game %d (%s vs %s)",
+		      number,
+		      qUtf8Printable(m_tournament->playerAt(iWhite).name()),
+		      qUtf8Printable(m_tournament->playerAt(iBlack).name()));
 
 	if (!m_tournamentFile.isEmpty()) {
 		QVariantMap tfMap;
@@ -1202,25 +1405,19 @@ void EngineMatch::onGameSkipped(int number, int iWhite, int iBlack)
 		pMap.insert("terminationDetails", "Skipped");
 		pList.append(pMap);
 		tfMap.insert("matchProgress", pList);
+		saveTournamentFile(tfMap);
+		if (tablesDue())
 		{
-			QFile output(m_tournamentFile);
-			if (!output.open(QIODevice::WriteOnly | QIODevice::Text)) {
-				qWarning("cannot open tournament configuration file: %s", qUtf8Printable(m_tournamentFile));
-			} else {
-				QTextStream out(&output);
-				JsonSerializer serializer(tfMap);
-				serializer.serialize(out);
-			}
-		}
-		QVariantMap eMap;
-		eMap.insert("matchProgress", pList);
-		eMap.insert("tournamentSettings", tsMap);
+			QVariantMap eMap;
+			eMap.insert("matchProgress", pList);
+			eMap.insert("tournamentSettings", tsMap);
 
-		generateSchedule(eMap);
-		generateCrossTable(eMap);
+			generateSchedule(eMap);
+			generateCrossTable(eMap);
+		}
 	}
 
-	if (m_tournament->playerCount() == 2)
+	if (m_tournament->playerCount() == 2 && !m_quiet)
 	{
 		TournamentPlayer fcp = m_tournament->playerAt(0);
 		TournamentPlayer scp = m_tournament->playerAt(1);
@@ -1244,11 +1441,54 @@ void EngineMatch::onTournamentFinished()
 	||  m_tournament->finishedGameCount() % m_ratingInterval != 0)
 		printRanking();
 
+	if (m_tableInterval > 1)
+		regenerateTables();
+
 	QString error = m_tournament->errorString();
 	if (!error.isEmpty())
 		qWarning("%s", qUtf8Printable(error));
 
+	if (m_benchmark)
+	{
+		const int games = m_tournament->finishedGameCount();
+		const qint64 msecs = m_startTime.elapsed();
+		qInfo("Benchmark: %d games in %.2f seconds (%.1f games/sec)",
+		      games,
+		      msecs / 1000.0,
+		      msecs > 0 ? games * 1000.0 / msecs : 0.0);
+	}
+
+	QString tbStats = SyzygyTablebase::probeStats();
+	if (!tbStats.isEmpty())
+		qInfo("Tablebase: %s", qUtf8Printable(tbStats));
+
+	const auto& engineStats = m_tournament->engineStats();
+	for (auto it = engineStats.constBegin();
+	     it != engineStats.constEnd(); ++it)
+	{
+		const auto& stats = it.value();
+		if (stats.moveTime.count() == 0)
+			continue;
+
+		qInfo("Latency profile of %s:", qUtf8Printable(it.key()));
+		qInfo("  move time (ms): %s",
+		      qUtf8Printable(stats.moveTime.toString()));
+		qInfo("  time usage (%%): %s",
+		      qUtf8Printable(stats.timeUsage.toString()));
+		qInfo("  output lines/s: %s",
+		      qUtf8Printable(stats.infoLineRate.toString()));
+		qInfo("  time-forfeit near-misses: %lld",
+		      stats.timeNearMisses);
+	}
+
 	qInfo("Finished match");
+	if (m_sharedGameManager)
+	{
+		// Other matches are still using the game manager;
+		// finishing it here would clear their queued games
+		emit finished();
+		return;
+	}
 	connect(m_tournament->gameManager(), SIGNAL(finished()),
 		this, SIGNAL(finished()));
 	m_tournament->gameManager()->finish();
@@ -26,8 +26,10 @@
 #include <QTextStream>
 #include <QElapsedTimer>
 #include <openingbook.h>
+class QTimer;
 
 class ChessGame;
+class EngineAnalysis;
 class OpeningBook;
 class Tournament;
 
@@ -42,14 +44,102 @@ class EngineMatch : public QObject
 
 		OpeningBook* addOpeningBook(const QString& fileName);
 		void setDebugMode(bool debug);
+		/*!
+		 * Enables or disables quiet mode.
+		 *
+		 * In quiet mode the per-game "Started game" and
+		 * "Finished game" lines are not printed; only the
+		 * periodic rankings (\a setRatingInterval) and the
+		 * final results are. At high concurrency the per-game
+		 * lines dominate the console traffic without adding
+		 * much over the summaries.
+		 */
+		void setQuietMode(bool quiet);
 		void setRatingInterval(int interval);
+		/*!
+		 * Sets the interval for regenerating the schedule and
+		 * crosstable files to \a interval games.
+		 *
+		 * The default is 1 (regenerate after every game).
+		 * Regeneration scans the whole match progress, so with
+		 * many players and games a larger interval saves
+		 * considerable time; the files are always brought up
+		 * to date when the tournament ends.
+		 */
+		void setTableInterval(int interval);
 		void setBookMode(OpeningBook::AccessMode mode);
 		void setTournamentFile(QString &tournamentFile);
+		/*!
+		 * Sets the standby copy of the tournament file to
+		 * \a fileName.
+		 *
+		 * Every checkpoint written to the tournament file is
+		 * mirrored synchronously to \a fileName, which should
+		 * live on storage that another machine can reach. If
+		 * the machine running the tournament dies, a standby
+		 * takes over by resuming from the copy with
+		 * '-tournamentfile FILE -resume', without losing
+		 * finished games or the state of an SPRT test.
+		 */
+		void setTournamentFileStandby(const QString& fileName);
 		void setEloKfactor(qreal eloKfactor);
 		void setOutputFormats(bool pgnFormat, bool jsonFormat);
 		void setDebugFile(const QString& debugFile);
+		/*!
+		 * Sets the stop file to \a fileName.
+		 *
+		 * While the match runs, the file is polled once a
+		 * second; as soon as it exists the tournament is
+		 * stopped gracefully. This lets a coordinator stop
+		 * every worker of a multi-machine match (eg. when a
+		 * shared SPRT crosses its bound) by creating one file
+		 * on each machine.
+		 */
+		void setStopFile(const QString& fileName);
+		/*!
+		 * Enables or disables benchmark mode.
+		 *
+		 * In benchmark mode a summary of the tournament's
+		 * throughput (games played and games per second) is
+		 * printed when the tournament ends. It's meant to be
+		 * used with instant players (\a RandomPlayer) to measure
+		 * the overhead of the tournament pipeline itself.
+		 */
+		void setBenchmarkMode(bool benchmark);
+		/*!
+		 * Tells the match that its game manager is shared with
+		 * other concurrently running matches.
+		 *
+		 * A shared game manager is not shut down when this
+		 * match's tournament finishes - doing so would clear the
+		 * queued games of the other matches. Whoever runs the
+		 * matches has to finish the manager after the last one.
+		 */
+		void setSharedGameManager(bool shared);
+		/*!
+		 * Sets up batch analysis mode.
+		 *
+		 * Instead of playing a tournament, the configured
+		 * engines analyze the positions of the EPD file
+		 * \a epdFile and the results are written to
+		 * \a outputFile.
+		 *
+		 * \sa EngineAnalysis
+		 */
+		void setAnalysis(const QString& epdFile,
+				 const QString& outputFile);
 
 		void start();
+		/*!
+		 * Stops the match.
+		 *
+		 * The first call stops the tournament gracefully,
+		 * waiting for the ongoing games to finish. A repeated
+		 * call (e.g. a second Ctrl-C) aborts: the engines are
+		 * terminated without waiting for their games, so a
+		 * misconfigured run frees its machine in a couple of
+		 * seconds instead of minutes.
+		 */
 		void stop();
 
 	signals:
@@ -60,25 +150,42 @@ class EngineMatch : public QObject
 		void onGameFinished(ChessGame* game, int number);
 		void onGameSkipped(int number, int white, int black);
 		void onTournamentFinished();
+		void onStopFilePoll();
 		void print(const QString& msg);
 
 	private:
 		void printRanking();
+		bool tablesDue() const;
+		void regenerateTables();
+		void saveTournamentFile(const QVariantMap& tfMap);
+		void writeTournamentFile(const QVariantMap& tfMap,
+					 const QString& fileName);
 		void generateSchedule(QVariantMap& eMap);
 		void generateCrossTable(QVariantMap& eMap);
 
 		Tournament* m_tournament;
 		bool m_debug;
+		bool m_quiet;
 		int m_ratingInterval;
+		int m_tableInterval;
 		OpeningBook::AccessMode m_bookMode;
 		QMap<QString, OpeningBook*> m_books;
 		QElapsedTimer m_startTime;
 		QString m_tournamentFile;
+		QString m_tournamentStandbyFile;
 		qreal m_eloKfactor;
 		bool m_pgnFormat;
 		bool m_jsonFormat;
 		QFile m_debugFile;
 		QTextStream m_debugOut;
+		QString m_stopFile;
+		QTimer* m_stopFileTimer;
+		bool m_benchmark;
+		bool m_sharedGameManager;
+		QString m_analyzeFile;
+		QString m_analyzeOutput;
+		EngineAnalysis* m_analysis;
+		bool m_stopping;
 };
 
 #endif // ENGINEMATCH_H
@@ -29,6 +29,7 @@
 #include <mersenne.h>
 #include <enginemanager.h>
 #include <enginebuilder.h>
+#include <randombuilder.h>
 #include <gamemanager.h>
 #include <tournament.h>
 #include <tournamentfactory.h>
@@ -43,6 +44,12 @@
 #include <jsonserializer.h>
 #include <econode.h>
 #include <pgnstream.h>
+#include <chessengine.h>
+#include <enginecommlog.h>
+#include <enginecommreplay.h>
+#include <uciengine.h>
+#include <xboardengine.h>
+#include <QElapsedTimer>
 
 #include "cutechesscoreapp.h"
 #include "matchparser.h"
@@ -50,15 +57,16 @@
 
 namespace {
 
-EngineMatch* s_match = nullptr;
+QList<EngineMatch*> s_matches;
+int s_runningMatches = 0;
 
 void sigintHandler(int param)
 {
 	Q_UNUSED(param);
-	if (s_match != nullptr)
-		s_match->stop();
-	else
+	if (s_matches.isEmpty())
 		abort();
+	for (EngineMatch* match : qAsConst(s_matches))
+		match->stop();
 }
 
 
@@ -75,22 +83,14 @@ struct EngineData
 bool readEngineConfig(const QString& name, EngineConfiguration& config)
 {
 	const auto app = CuteChessCoreApplication::instance();
-	const auto engines = app->engineManager()->engines();
-	for (const auto& engine : engines)
-	{
-		if (engine.name() == name)
-		{
-			config = engine;
-			return true;
-		}
-	}
-	return false;
+	return app->engineManager()->findEngine(name, &config);
 }
 
 OpeningSuite* parseOpenings(const MatchParser::Option& option, Tournament* tournament)
 {
 	QMap<QString, QString> params =
-		option.toMap("file|format=pgn|order=sequential|plies=1024|start=1");
+		option.toMap("file|format=pgn|order=sequential|plies=1024|"
+			     "start=1|dedupe=false");
 	bool ok = !params.isEmpty();
 
 	OpeningSuite::Format format = OpeningSuite::EpdFormat;
@@ -117,6 +117,16 @@ OpeningSuite* parseOpenings(const MatchParser::Option& option, Tournament* tourn
 		ok = false;
 	}
 
+	bool dedupe = false;
+	if (params["dedupe"] == "true")
+		dedupe = true;
+	else if (params["dedupe"] != "false" && ok)
+	{
+		qWarning("Invalid opening deduplication setting: \"%s\"",
+			 qUtf8Printable(params["dedupe"]));
+		ok = false;
+	}
+
 	int plies = params["plies"].toInt();
 	int start = params["start"].toInt();
 
@@ -129,6 +139,7 @@ OpeningSuite* parseOpenings(const MatchParser::Option& option, Tournament* tourn
 							   format,
 							   order,
 							   start - 1);
+		suite->setDeduplication(dedupe);
 		if (order == OpeningSuite::RandomOrder)
 			qInfo("Indexing opening suite...");
 		ok = suite->initialize();
@@ -347,6 +358,21 @@ bool parseEngine(const QStringList& args, EngineData& data, QVariantMap stMap, Q
 			data.config.setOption(name.section('.', 1), val);
 		else if (name == "stderr")
 			data.config.setStderrFile(val);
+		else if (name == "affinity")
+			data.config.setCpuAffinity(val);
+		else if (name == "nice")
+		{
+			bool ok = false;
+			int niceness = val.toInt(&ok);
+			if (!ok || niceness < -20 || niceness > 19)
+			{
+				qWarning() << "Invalid niceness:" << val;
+				return false;
+			}
+			data.config.setNiceness(niceness);
+		}
+		else if (name == "ionice")
+			data.config.setIoPriority(val);
 		else
 		{
 			qWarning() << "Invalid engine option:" << name;
@@ -366,6 +392,7 @@ EngineMatch* parseMatch(const QStringList& args, CuteChessCoreApplication& app)
 	parser.addOption("-each", QVariant::StringList, 1);
 	parser.addOption("-variant", QVariant::String, 1, 1);
 	parser.addOption("-concurrency", QVariant::Int, 1, 1);
+	parser.addOption("-maxcores", QVariant::Int, 1, 1);
 	parser.addOption("-draw", QVariant::StringList);
 	parser.addOption("-resign", QVariant::StringList);
 	parser.addOption("-maxmoves", QVariant::Int, 1, 1);
@@ -373,12 +400,19 @@ EngineMatch* parseMatch(const QStringList& args, CuteChessCoreApplication& app)
  	parser.addOption("-tbdrawonly", QVariant::Bool, 0, 0); 
 	parser.addOption("-tbpieces", QVariant::Int, 1, 1);
 	parser.addOption("-tbignore50", QVariant::Bool, 0, 0);
+	parser.addOption("-tbmlock", QVariant::Bool, 0, 0);
 	parser.addOption("-event", QVariant::String, 1, 1);
 	parser.addOption("-games", QVariant::Int, 1, 1);
 	parser.addOption("-rounds", QVariant::Int, 1, 1);
 	parser.addOption("-sprt", QVariant::StringList);
 	parser.addOption("-ratinginterval", QVariant::Int, 1, 1);
+	parser.addOption("-tableinterval", QVariant::Int, 1, 1);
 	parser.addOption("-debug", QVariant::String, 0, 1);
+	parser.addOption("-quiet", QVariant::Bool, 0, 0);
+	parser.addOption("-commlog", QVariant::String, 1, 1);
+	parser.addOption("-stopfile", QVariant::String, 1, 1);
+	parser.addOption("-tournamentstandby", QVariant::String, 1, 1);
+	parser.addOption("-stalltimeout", QVariant::Int, 1, 1);
 	parser.addOption("-openings", QVariant::StringList);
 	parser.addOption("-bookmode", QVariant::String);
 	parser.addOption("-pgnout", QVariant::StringList, 1, 3);
@@ -386,10 +420,13 @@ EngineMatch* parseMatch(const QStringList& args, CuteChessCoreApplication& app)
 	parser.addOption("-repeat", QVariant::Int, 0, 1);
 	parser.addOption("-noswap", QVariant::Bool, 0, 0);
 	parser.addOption("-recover", QVariant::Bool, 0, 0);
+	parser.addOption("-restarts", QVariant::Int, 1, 1);
+	parser.addOption("-verifygames", QVariant::Bool, 0, 0);
 	parser.addOption("-site", QVariant::String, 1, 1);
 	parser.addOption("-wait", QVariant::Int, 1, 1);
 	parser.addOption("-seeds", QVariant::UInt, 1, 1);
-	parser.addOption("-livepgnout", QVariant::StringList, 1, 4);
+	parser.addOption("-livepgnout", QVariant::StringList, 1, 5);
+	parser.addOption("-eventstream", QVariant::String, 1, 1);
 	parser.addOption("-tournamentfile", QVariant::String, 1, 1);
 	parser.addOption("-resume", QVariant::Bool, 0, 0);
 	parser.addOption("-ecopgn", QVariant::String, 1, 1);
@@ -398,6 +435,9 @@ EngineMatch* parseMatch(const QStringList& args, CuteChessCoreApplication& app)
 	parser.addOption("-reloadconf", QVariant::Bool, 0, 0);
 	parser.addOption("-tcecadj", QVariant::Bool, 0, 0);
 	parser.addOption("-strikes", QVariant::Int, 1, 1);
+	parser.addOption("-benchmark", QVariant::Int, 1, 1);
+	parser.addOption("-analyze", QVariant::String, 1, 1);
+	parser.addOption("-analyzeout", QVariant::String, 1, 1);
 
 	if (!parser.parse())
 		return nullptr;
@@ -532,6 +572,10 @@ EngineMatch* parseMatch(const QStringList& args, CuteChessCoreApplication& app)
 			tournament->setVariant(tMap["variant"].toString());
 		if (tMap.contains("recoveryMode"))
 			tournament->setRecoveryMode(tMap["recoveryMode"].toBool());
+		if (tMap.contains("crashRestarts"))
+			tournament->setCrashRecovery(tMap["crashRestarts"].toInt());
+		if (tMap.contains("verifyGames"))
+			tournament->setPgnVerification(tMap["verifyGames"].toBool());
 		if (tMap.contains("pgnOutput")) {
 			if (tMap.contains("pgnOutMode"))
 				tournament->setPgnOutput(tMap["pgnOutput"].toString(), (PgnGame::PgnMode)tMap["pgnOutMode"].toInt());
@@ -550,7 +594,11 @@ EngineMatch* parseMatch(const QStringList& args, CuteChessCoreApplication& app)
 			if (tMap.contains("jsonFormat"))
 				wantsJsonFormat = tMap["jsonFormat"].toBool();
 			tournament->setLivePgnFormats(wantsPgnFormat, wantsJsonFormat);
+			if (tMap.contains("livePgnStream"))
+				tournament->setLivePgnStream(tMap["livePgnStream"].toBool());
 		}
+		if (tMap.contains("eventStreamOutput"))
+			tournament->setEventStreamOutput(tMap["eventStreamOutput"].toString());
 		if (tMap.contains("Strikes"))
 			tournament->setStrikes(tMap["Strikes"].toInt());
 		if (tMap.contains("epdOutput"))
@@ -561,6 +609,8 @@ EngineMatch* parseMatch(const QStringList& args, CuteChessCoreApplication& app)
 			tournament->setOpeningRepetitions(tMap["openingRepetitions"].toInt());
 		if (tMap.contains("concurrency"))
 			gameManager->setConcurrency(tMap["concurrency"].toInt());
+		if (tMap.contains("maxCpuCores"))
+			gameManager->setMaxCpuCores(tMap["maxCpuCores"].toInt());
 		if (tMap.contains("drawAdjudication")) {
 			QVariantMap dMap = tMap["drawAdjudication"].toMap();
 			if (dMap.contains("movenumber") &&
@@ -607,6 +657,9 @@ EngineMatch* parseMatch(const QStringList& args, CuteChessCoreApplication& app)
 		if (tMap.contains("tbIgnore50"))
 			if (tMap["tbIgnore50"].toBool())
 				SyzygyTablebase::setNoRule50();
+		if (tMap.contains("tbMlock"))
+			if (tMap["tbMlock"].toBool())
+				SyzygyTablebase::setMemoryLock();
 
 		if (tMap.contains("openings")) {
 			openingsOption.name = "-openings";
@@ -622,9 +675,19 @@ EngineMatch* parseMatch(const QStringList& args, CuteChessCoreApplication& app)
 			tournament->setReloadEngines(tMap["reloadConfiguration"].toBool());
 		if (tMap.contains("tcecAdjudication"))
 			adjudicator.setTcecAdjudication(tMap["tcecAdjudication"].toBool());
+		if (tMap.contains("sprt")) {
+			QVariantMap sMap = tMap["sprt"].toMap();
+			tournament->sprt()->initialize(
+				sMap["elo0"].toDouble(),
+				sMap["elo1"].toDouble(),
+				sMap["alpha"].toDouble(),
+				sMap["beta"].toDouble());
+		}
 		if (tfMap.contains("strikes")) {
 			stMap = tfMap["strikes"].toMap();
 		}
+		QMap<QString, int> resumeWins;
+		int resumeDraws = 0;
 		if (tfMap.contains("matchProgress")) {
 			if (!wantsResume) {
 				tfMap.remove("matchProgress");
@@ -640,6 +703,12 @@ EngineMatch* parseMatch(const QStringList& args, CuteChessCoreApplication& app)
 				for (p = pList.begin(); p != pList.end(); ++p) {
 					QVariantMap pMap = p->toMap();
 					addResumeScore(pMap["result"], pMap["white"], pMap["black"], &engineMap);
+					if (pMap["result"] == "1-0")
+						resumeWins[pMap["white"].toString()]++;
+					else if (pMap["result"] == "0-1")
+						resumeWins[pMap["black"].toString()]++;
+					else if (pMap["result"] == "1/2-1/2")
+						resumeDraws++;
 					matchNum = matchNum + 1;
 					if (pMap["result"] == "*") {
 						pList.erase(p, pList.end());
@@ -669,6 +738,15 @@ EngineMatch* parseMatch(const QStringList& args, CuteChessCoreApplication& app)
 					engines.append(engine);
 			}
 		}
+		// Restore the state of the SPRT from the replayed results so
+		// that a resumed test continues where it left off instead of
+		// starting the llr from zero
+		if (!tournament->sprt()->isNull() && engines.size() == 2) {
+			tournament->sprt()->setGameResults(
+				resumeWins.value(engines.at(0).config.name()),
+				resumeWins.value(engines.at(1).config.name()),
+				resumeDraws);
+		}
 		if (eMap.contains("each")) {
 			eachOptions = eMap["each"].toStringList();
 		}
@@ -716,6 +794,15 @@ EngineMatch* parseMatch(const QStringList& args, CuteChessCoreApplication& app)
 					tMap.insert("concurrency", value.toInt());
 				}
 			}
+			// CPU core budget for concurrent games
+			else if (name == "-maxcores")
+			{
+				ok = value.toInt() > 0;
+				if (ok) {
+					gameManager->setMaxCpuCores(value.toInt());
+					tMap.insert("maxCpuCores", value.toInt());
+				}
+			}
 			// Threshold for draw adjudication
 			else if (name == "-draw")
 			{
@@ -803,6 +890,14 @@ EngineMatch* parseMatch(const QStringList& args, CuteChessCoreApplication& app)
 					SyzygyTablebase::setNoRule50();
 				tMap.insert("tbIgnore50", flag);
 			}
+			// Lock Syzygy tablebases in memory
+			else if (name == "-tbmlock")
+			{
+				bool flag = value.toBool();
+				if (flag)
+					SyzygyTablebase::setMemoryLock();
+				tMap.insert("tbMlock", flag);
+			}
 			// Event name
 			else if (name == "-event")
 			{
@@ -866,6 +961,12 @@ EngineMatch* parseMatch(const QStringList& args, CuteChessCoreApplication& app)
 				match->setRatingInterval(value.toInt());
 				tMap.insert("ratingInterval", value.toInt());
 			}
+			// Interval for schedule/crosstable regeneration
+			else if (name == "-tableinterval")
+			{
+				match->setTableInterval(value.toInt());
+				tMap.insert("tableInterval", value.toInt());
+			}
 			// Use an opening suite
 			else if (name == "-openings")
 				openingsOption = option;
@@ -903,6 +1004,7 @@ EngineMatch* parseMatch(const QStringList& args, CuteChessCoreApplication& app)
 			else if (name == "-livepgnout")
 			{
 				PgnGame::PgnMode mode = PgnGame::Verbose;
+				bool wantsStreamFormat = false;
 				QStringList list = value.toStringList();
 				int params = 1;
 				if (list.contains("min"))
@@ -920,17 +1022,30 @@ EngineMatch* parseMatch(const QStringList& args, CuteChessCoreApplication& app)
 					wantsJsonFormat = false;
 					++params;
 				}
+				if (list.contains("stream"))
+				{
+					wantsStreamFormat = true;
+					++params;
+				}
 				if (list.size() != params)
 					ok = false;
 				if (ok) {
 					tournament->setLivePgnOutput(list.at(0), mode);
 					tournament->setLivePgnFormats(wantsPgnFormat, wantsJsonFormat);
+					tournament->setLivePgnStream(wantsStreamFormat);
 					tMap.insert("livePgnOutput", list.at(0));
 					tMap.insert("livePgnOutMode", mode);
 					tMap.insert("pgnFormat", wantsPgnFormat);
 					tMap.insert("jsonFormat", wantsJsonFormat);
+					tMap.insert("livePgnStream", wantsStreamFormat);
 				}
 			}
+			// NDJSON event stream file for broadcast consumers
+			else if (name == "-eventstream")
+			{
+				tournament->setEventStreamOutput(value.toString());
+				tMap.insert("eventStreamOutput", value.toString());
+			}
 			else if (name == "-strikes")
 			{
 				const int st = value.toInt();
@@ -980,6 +1095,21 @@ EngineMatch* parseMatch(const QStringList& args, CuteChessCoreApplication& app)
 				tournament->setRecoveryMode(true);
 				tMap.insert("recoveryMode", true);
 			}
+			// Restart crashed engines mid-game
+			else if (name == "-restarts")
+			{
+				ok = value.toInt() >= 0;
+				if (ok) {
+					tournament->setCrashRecovery(value.toInt());
+					tMap.insert("crashRestarts", value.toInt());
+				}
+			}
+			// Verify finished games in the background
+			else if (name == "-verifygames")
+			{
+				tournament->setPgnVerification(true);
+				tMap.insert("verifyGames", true);
+			}
 			// Site/location name
 			else if (name == "-site")
 			{
@@ -1074,6 +1204,69 @@ EngineMatch* parseMatch(const QStringList& args, CuteChessCoreApplication& app)
 			match->setDebugFile(debugOption.toString());
 	}
 
+	// Quiet mode. Suppresses the per-game console lines.
+	if (parser.takeOption("-quiet").toBool())
+		match->setQuietMode(true);
+
+	// Stalled-engine watchdog timeout
+	int stallTimeout = parser.takeOption("-stalltimeout").toInt();
+	if (stallTimeout > 0)
+		ChessEngine::setStallTimeout(stallTimeout);
+
+	// Coordination hook for multi-machine matches
+	QString stopFile = parser.takeOption("-stopfile").toString();
+	if (!stopFile.isEmpty())
+		match->setStopFile(stopFile);
+
+	// Standby copy of the tournament file, for failover
+	QString standbyFile = parser.takeOption("-tournamentstandby").toString();
+	if (!standbyFile.isEmpty())
+	{
+		if (!standbyFile.endsWith(".json"))
+			standbyFile.append(".json");
+		match->setTournamentFileStandby(standbyFile);
+	}
+
+	// Binary engine communication log. Cheaper than -debug.
+	QString commLogFile = parser.takeOption("-commlog").toString();
+	if (!commLogFile.isEmpty())
+	{
+		auto commLog = new EngineCommLog(commLogFile,
+			CuteChessCoreApplication::instance());
+		if (commLog->open())
+			ChessEngine::setCommLog(commLog);
+		else
+		{
+			qWarning("cannot open engine log file %s",
+				 qUtf8Printable(commLogFile));
+			delete commLog;
+		}
+	}
+
+	// Synthetic tournament for measuring pipeline overhead
+	int benchmarkGames = parser.takeOption("-benchmark").toInt();
+	if (benchmarkGames > 0)
+	{
+		tournament->addPlayer(new RandomBuilder("Random1"),
+				      TimeControl("inf"));
+		tournament->addPlayer(new RandomBuilder("Random2"),
+				      TimeControl("inf"));
+		tournament->setRoundMultiplier(benchmarkGames);
+		match->setBenchmarkMode(true);
+	}
+
+	// Batch EPD analysis instead of a tournament
+	QString analyzeFile = parser.takeOption("-analyze").toString();
+	QString analyzeOut = parser.takeOption("-analyzeout").toString();
+	if (!analyzeFile.isEmpty())
+	{
+		if (analyzeOut.isEmpty())
+			analyzeOut = analyzeFile + ".json";
+		match->setAnalysis(analyzeFile, analyzeOut);
+	}
+	else if (!analyzeOut.isEmpty())
+		qWarning("-analyzeout has no effect without -analyze");
+
 	match->setOutputFormats(wantsPgnFormat, wantsJsonFormat);
 
 	if (tMap.contains("eloKfactor"))
@@ -1140,11 +1333,16 @@ EngineMatch* parseMatch(const QStringList& args, CuteChessCoreApplication& app)
 			ok = false;
 	}
 
-	if (engines.size() < 2)
+	if (engines.size() < 2 && benchmarkGames <= 0 && analyzeFile.isEmpty())
 	{
 		qWarning("At least two engines are needed");
 		ok = false;
 	}
+	if (engines.isEmpty() && !analyzeFile.isEmpty())
+	{
+		qWarning("At least one engine is needed for analysis");
+		ok = false;
+	}
 
 	if (!ok)
 	{
@@ -1180,6 +1378,71 @@ EngineMatch* parseMatch(const QStringList& args, CuteChessCoreApplication& app)
 	return match;
 }
 
+// Reads the argument list of one experiment from 'fileName'.
+// The file holds normal cutechess-cli arguments, split over any
+// number of lines; tokens can be quoted with double quotes and
+// lines starting with '#' are comments.
+QStringList readExperimentArguments(const QString& fileName, bool* ok)
+{
+	Q_ASSERT(ok != nullptr);
+	*ok = false;
+
+	QStringList args;
+
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+	{
+		qWarning("cannot open experiment file: %s",
+			 qUtf8Printable(fileName));
+		return args;
+	}
+
+	QTextStream in(&file);
+	QString line;
+	while (in.readLineInto(&line))
+	{
+		if (line.trimmed().startsWith('#'))
+			continue;
+
+		QString token;
+		bool inQuotes = false;
+		bool inToken = false;
+
+		for (const QChar& c : qAsConst(line))
+		{
+			if (c == '\"')
+			{
+				inQuotes = !inQuotes;
+				inToken = true;
+			}
+			else if (c.isSpace() && !inQuotes)
+			{
+				if (inToken)
+					args << token;
+				token.clear();
+				inToken = false;
+			}
+			else
+			{
+				token += c;
+				inToken = true;
+			}
+		}
+		if (inQuotes)
+		{
+			qWarning("unterminated quote in experiment file %s: %s",
+				 qUtf8Printable(fileName),
+				 qUtf8Printable(line));
+			return QStringList();
+		}
+		if (inToken)
+			args << token;
+	}
+
+	*ok = true;
+	return args;
+}
+
 } // anonymous namespace
 
 int main(int argc, char* argv[])
@@ -1216,7 +1479,11 @@ int main(int argc, char* argv[])
 		}
 		else if (arg == "--engines" || arg == "-engines")
 		{
-			const auto engines = app.engineManager()->engines();
+			// Listing needs every entry, not just the ones a
+			// match would reference
+			auto manager = app.engineManager();
+			manager->loadEngines(manager->configFile());
+			const auto engines = manager->engines();
 			for (const auto& engine : engines)
 				out << engine.name() << endl;
 
@@ -1231,11 +1498,139 @@ int main(int argc, char* argv[])
 		}
 	}
 
-	s_match = parseMatch(arguments, app);
-	if (s_match == nullptr)
-		return 1;
-	QObject::connect(s_match, SIGNAL(finished()), &app, SLOT(quit()));
+	int readLogIndex = arguments.indexOf("-readlog");
+	if (readLogIndex >= 0)
+	{
+		if (readLogIndex + 1 >= arguments.size())
+		{
+			qWarning("The -readlog option needs a file name");
+			return 1;
+		}
+		const QString fileName = arguments.at(readLogIndex + 1);
+		if (!EngineCommLog::writeAsText(fileName, out))
+		{
+			qWarning("cannot read engine log file %s",
+				 qUtf8Printable(fileName));
+			return 1;
+		}
+		return 0;
+	}
+
+	int replayLogIndex = arguments.indexOf("-replaylog");
+	if (replayLogIndex >= 0)
+	{
+		if (replayLogIndex + 1 >= arguments.size())
+		{
+			qWarning("The -replaylog option needs a file name");
+			return 1;
+		}
+		const QString fileName = arguments.at(replayLogIndex + 1);
+
+		EngineCommReplay replay;
+		if (!replay.load(fileName))
+		{
+			qWarning("cannot read engine log file %s",
+				 qUtf8Printable(fileName));
+			return 1;
+		}
+
+		// A replayed session has no game attached, so warnings
+		// about unexpected moves are expected; silence them
+		QLoggingCategory::defaultCategory()->setEnabled(QtWarningMsg,
+								false);
+
+		// Feed the recorded session through the protocol parser
+		// as fast as it will go
+		ChessEngine* engine;
+		if (replay.isUci())
+			engine = new UciEngine(&app);
+		else
+			engine = new XboardEngine(&app);
+		engine->setDevice(&replay);
+		engine->start();
+
+		QElapsedTimer timer;
+		timer.start();
+		replay.start();
+		const qint64 nsecs = timer.nsecsElapsed();
+
+		qInfo("Replayed %d records (%lld bytes) through the %s "
+		      "parser in %.3f ms",
+		      replay.recordCount(),
+		      replay.byteCount(),
+		      qUtf8Printable(engine->protocol()),
+		      nsecs / 1E6);
+		return 0;
+	}
+
+	// Each -experiment option adds a full tournament of its own,
+	// read from an argument file. All experiments share the game
+	// manager's slot pool, so a finishing experiment's slots are
+	// reused by the others immediately.
+	QList<QStringList> experiments;
+	int expIndex;
+	while ((expIndex = arguments.indexOf("-experiment")) >= 0)
+	{
+		if (expIndex + 1 >= arguments.size())
+		{
+			qWarning("The -experiment option needs a file name");
+			return 1;
+		}
+
+		bool ok = false;
+		QStringList expArgs = readExperimentArguments(
+			arguments.at(expIndex + 1), &ok);
+		if (!ok)
+			return 1;
+
+		experiments << expArgs;
+		arguments.removeAt(expIndex + 1);
+		arguments.removeAt(expIndex);
+	}
+
+	if (experiments.isEmpty())
+	{
+		EngineMatch* match = parseMatch(arguments, app);
+		if (match == nullptr)
+			return 1;
+		s_matches << match;
+
+		QObject::connect(match, SIGNAL(finished()), &app, SLOT(quit()));
+		match->start();
+		return app.exec();
+	}
+
+	// The arguments outside the experiment files are shared by
+	// every experiment (eg. -concurrency or -maxcores)
+	for (const QStringList& expArgs : qAsConst(experiments))
+	{
+		EngineMatch* match = parseMatch(arguments + expArgs, app);
+		if (match == nullptr)
+			return 1;
+
+		match->setSharedGameManager(true);
+		s_matches << match;
+	}
+
+	s_runningMatches = s_matches.size();
+	for (EngineMatch* match : qAsConst(s_matches))
+	{
+		QObject::connect(match, &EngineMatch::finished, &app, []()
+		{
+			if (--s_runningMatches > 0)
+				return;
+
+			// The last experiment shuts the shared game
+			// manager down
+			auto coreApp = CuteChessCoreApplication::instance();
+			QObject::connect(coreApp->gameManager(), SIGNAL(finished()),
+					 coreApp, SLOT(quit()));
+			coreApp->gameManager()->finish();
+		});
+	}
+
+	for (EngineMatch* match : qAsConst(s_matches))
+		match->start();
 
-	s_match->start();
 	return app.exec();
 }
@@ -1,8 +1,10 @@
 DEPENDPATH += $$PWD
 HEADERS += $$PWD/enginematch.h \
+    $$PWD/engineanalysis.h \
     $$PWD/cutechesscoreapp.h \
     $$PWD/matchparser.h
 SOURCES += $$PWD/main.cpp \
     $$PWD/cutechesscoreapp.cpp \
     $$PWD/enginematch.cpp \
+    $$PWD/engineanalysis.cpp \
     $$PWD/matchparser.cpp
@@ -24,9 +24,26 @@
 */
 
 #include <QTextDocument>
+#include <QTextBlockUserData>
+#include <QVector>
 
 #include "pgnhighlighter.h"
 
+/*
+    Cached scan of the leading part of a block. The cached prefix
+    always ends at a whitespace character in normal state, so when
+    text is only appended to the block (a live game growing every
+    few seconds) the scan can resume after the prefix and produce
+    the same result as a full pass over the block.
+*/
+class PgnHighlighter::BlockData : public QTextBlockUserData
+{
+	public:
+		int initialState;
+		QString scannedText;
+		QVector<FormatRange> ranges;
+};
+
 PgnHighlighter::PgnHighlighter(QTextDocument* document)
 	: QSyntaxHighlighter(document)
 {
@@ -71,6 +88,27 @@ void PgnHighlighter::highlightBlock(const QString& text)
 	int start = 0;
 	int pos = 0;
 
+	QVector<FormatRange> ranges;
+
+	// Resume after the cached prefix when only trailing text has
+	// changed, so appending moves to a long block costs only a scan
+	// of the appended part
+	BlockData* data = static_cast<BlockData*>(currentBlockUserData());
+	if (data != nullptr
+	&&  data->initialState == state
+	&&  !data->scannedText.isEmpty()
+	&&  text.startsWith(data->scannedText))
+	{
+		ranges = data->ranges;
+		pos = data->scannedText.length();
+		// Safe resume points are only recorded in normal state
+		state = NormalState;
+	}
+
+	// Last position where the scan can safely resume later
+	int safePos = pos;
+	int safeRangeCount = ranges.size();
+
 	while (pos < len)
 	{
 		QChar ch = text.at(pos);
@@ -79,12 +117,12 @@ void PgnHighlighter::highlightBlock(const QString& text)
 		{
 			default:
 			case NormalState:
-				if (pos == 0 && ch == '%') {
-					setFormat(pos, len, m_formats[Comment]);
-					pos = len - 1; // end of line
-				} else if (ch == ';') {
-					setFormat(pos, len - pos, m_formats[Comment]);
-					pos = len - 1; // end of line
+				if (ch.isSpace()) {
+					safePos = pos;
+					safeRangeCount = ranges.size();
+				} else if ((pos == 0 && ch == '%') || ch == ';') {
+					start = pos;
+					state = InLineComment;
 				} else if (ch == '{') {
 					start = pos;
 					state = InComment;
@@ -96,11 +134,11 @@ void PgnHighlighter::highlightBlock(const QString& text)
 
 					if (text.mid(pos, 3) == "0-1" || text.mid(pos, 3) == "1-0") {
 						pos += 3;
-						setFormat(start, pos - start, m_formats[Result]);
+						ranges.append(FormatRange{start, pos - start, Result});
 						state = NormalState;
 					} else if (text.mid(pos, 7) == "1/2-1/2") {
 						pos += 7;
-						setFormat(start, pos - start, m_formats[Result]);
+						ranges.append(FormatRange{start, pos - start, Result});
 						state = NormalState;
 					} else if (ch.digitValue() >= 1) {
 						state = InMoveNumber;
@@ -110,17 +148,21 @@ void PgnHighlighter::highlightBlock(const QString& text)
 
 			case InComment:
 				if (ch == '}') {
-					setFormat(start, pos + 1 - start, m_formats[Comment]);
+					ranges.append(FormatRange{start, pos + 1 - start, Comment});
 					state = NormalState;
 				}
 				break;
 
+			case InLineComment:
+				// consumes the rest of the line
+				break;
+
 			case InTag:
 				if (ch == ']') {
-					setFormat(start, pos + 1 - start, m_formats[Tag]);
+					ranges.append(FormatRange{start, pos + 1 - start, Tag});
 					state = NormalState;
 				} else if (ch == '"') {
-					setFormat(start, pos - start, m_formats[Tag]);
+					ranges.append(FormatRange{start, pos - start, Tag});
 					start = pos;
 					state = InString;
 				}
@@ -128,7 +170,7 @@ void PgnHighlighter::highlightBlock(const QString& text)
 
 			case InString:
 				if (ch == '"') {
-					setFormat(start, pos + 1 - start, m_formats[String]);
+					ranges.append(FormatRange{start, pos + 1 - start, String});
 					start = pos + 1;
 					state = InTag;
 				}
@@ -136,7 +178,7 @@ void PgnHighlighter::highlightBlock(const QString& text)
 
 			case InMoveNumber:
 				if (ch == '.') {
-					setFormat(start, pos + 1 - start, m_formats[MoveNumber]);
+					ranges.append(FormatRange{start, pos + 1 - start, MoveNumber});
 					state = NormalState;
 				} else if (ch.isDigit()) {
 					state = InMoveNumber;
@@ -149,9 +191,25 @@ void PgnHighlighter::highlightBlock(const QString& text)
 		}
 		pos++;
 	}
-	if (state == InComment)
-		setFormat(start, len - start, m_formats[Comment]);
-	else if (state == InTag || state == InString || state == InMoveNumber)
+	if (state == InComment || state == InLineComment)
+		ranges.append(FormatRange{start, len - start, Comment});
+
+	for (const FormatRange& range : ranges)
+		setFormat(range.start, range.length, m_formats[range.construct]);
+
+	// Cache the scan up to the last safe resume point; everything
+	// after it (open constructs, result lookahead) is re-scanned
+	// next time in case the block grows
+	if (data == nullptr)
+	{
+		data = new BlockData();
+		setCurrentBlockUserData(data);
+	}
+	data->initialState = previousBlockState();
+	data->scannedText = text.left(safePos);
+	data->ranges = ranges.mid(0, safeRangeCount);
+
+	if (state != InComment)
 		state = NormalState;
 
 	setCurrentBlockState(state);
@@ -57,12 +57,21 @@ class PgnHighlighter : public QSyntaxHighlighter
 			InTag,
 			InString,
 			InMoveNumber,
-			InComment
+			InComment,
+			InLineComment
 		};
 
 		void highlightBlock(const QString& text);
 
 	private:
+		struct FormatRange
+		{
+			int start;
+			int length;
+			Construct construct;
+		};
+		class BlockData;
+
 		QTextCharFormat m_formats[LastConstrcut + 1];
 
 };
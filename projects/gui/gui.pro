@@ -20,7 +20,7 @@ macx-xcode {
     DEFINES += CUTECHESS_VERSION=\\\"$$CUTECHESS_VERSION\\\"
 }
 
-QT += svg widgets concurrent printsupport
+QT += svg widgets concurrent printsupport network
 
 win32 {
     CONFIG(debug, debug|release) {
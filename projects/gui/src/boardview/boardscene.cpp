@@ -48,7 +48,8 @@ BoardScene::BoardScene(QObject* parent)
 	  m_anim(nullptr),
 	  m_renderer(new QSvgRenderer(QString(":/default.svg"), this)),
 	  m_highlightPiece(nullptr),
-	  m_moveArrows(nullptr)
+	  m_moveArrows(nullptr),
+	  m_animationDuration(300)
 {
 }
 
@@ -80,6 +81,11 @@ void BoardScene::setBoard(Chess::Board* board)
 	m_board = board;
 }
 
+void BoardScene::setAnimationDuration(int msecs)
+{
+	m_animationDuration = qMax(msecs, 0);
+}
+
 void BoardScene::populate()
 {
 	Q_ASSERT(m_board != nullptr);
@@ -282,14 +288,14 @@ void BoardScene::mouseReleaseEvent(QGraphicsSceneMouseEvent* event)
 
 void BoardScene::onTransitionFinished()
 {
-	const auto drops = m_transition.drops();
+	const auto& drops = m_transition.drops();
 	if (m_direction == Backward)
 	{
 		for (const auto& drop : drops)
 			m_reserve->addPiece(m_squares->takePieceAt(drop.target));
 	}
 
-	const auto moves = m_transition.moves();
+	const auto& moves = m_transition.moves();
 	for (const auto& move : moves)
 	{
 		if (m_direction == Forward)
@@ -305,7 +311,7 @@ void BoardScene::onTransitionFinished()
 					     m_reserve->takePiece(drop.piece));
 	}
 
-	const auto squares = m_transition.squares();
+	const auto& squares = m_transition.squares();
 	for (const auto& square : squares)
 	{
 		Chess::Piece type = m_board->pieceAt(square);
@@ -313,7 +319,7 @@ void BoardScene::onTransitionFinished()
 			m_squares->setSquare(square, createPiece(type));
 	}
 
-	const auto reserve = m_transition.reserve();
+	const auto& reserve = m_transition.reserve();
 	for (const auto& piece : reserve)
 	{
 		int count = m_reserve->pieceCount(piece);
@@ -436,7 +442,7 @@ QPropertyAnimation* BoardScene::pieceAnimation(GraphicsPiece* piece,
 	anim->setStartValue(startPoint);
 	anim->setEndValue(endPoint);
 	anim->setEasingCurve(QEasingCurve::InOutQuad);
-	anim->setDuration(300);
+	anim->setDuration(m_animationDuration);
 
 	piece->setParentItem(nullptr);
 	piece->setPos(startPoint);
@@ -551,7 +557,7 @@ void BoardScene::applyTransition(const Chess::BoardTransition& transition,
 	connect(group, SIGNAL(finished()), this, SLOT(onTransitionFinished()));
 	m_anim = group;
 
-	const auto drops = transition.drops();
+	const auto& drops = transition.drops();
 	if (direction == Backward)
 	{
 		for (const auto& drop : drops)
@@ -561,7 +567,7 @@ void BoardScene::applyTransition(const Chess::BoardTransition& transition,
 		}
 	}
 
-	const auto moves = transition.moves();
+	const auto& moves = transition.moves();
 	for (const auto& move : moves)
 	{
 		Chess::Square source = move.source;
@@ -73,6 +73,15 @@ class BoardScene : public QGraphicsScene
 		 * best to give the scene its own copy of a board.
 		 */
 		void setBoard(Chess::Board* board);
+		/*!
+		 * Sets the duration of piece animations to \a msecs.
+		 *
+		 * The default is 300 milliseconds. A duration of zero
+		 * makes pieces jump to their target square immediately,
+		 * which saves a lot of repainting when many scenes are
+		 * shown at once (eg. in a game wall).
+		 */
+		void setAnimationDuration(int msecs);
 
 	public slots:
 		/*!
@@ -159,6 +168,7 @@ class BoardScene : public QGraphicsScene
 		Chess::GenericMove m_promotionMove;
 		GraphicsPiece* m_highlightPiece;
 		QGraphicsItemGroup* m_moveArrows;
+		int m_animationDuration;
 };
 
 #endif // BOARDSCENE_H
@@ -20,6 +20,8 @@
 #include <QPainter>
 #include <QResizeEvent>
 #include <QTimer>
+#include <QSettings>
+#include <QOpenGLWidget>
 
 
 BoardView::BoardView(QGraphicsScene* scene, QWidget* parent)
@@ -27,6 +29,16 @@ BoardView::BoardView(QGraphicsScene* scene, QWidget* parent)
 	  m_initialized(false),
 	  m_resizeTimer(new QTimer(this))
 {
+	// Optionally render the scene through OpenGL instead of the
+	// raster engine; useful on high-resolution displays where
+	// software compositing becomes the bottleneck
+	if (QSettings().value("ui/opengl_board", false).toBool())
+	{
+		setViewport(new QOpenGLWidget(this));
+		// A GL viewport can't do partial updates
+		setViewportUpdateMode(FullViewportUpdate);
+	}
+
 	setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
 	setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
 	setRenderHint(QPainter::Antialiasing);
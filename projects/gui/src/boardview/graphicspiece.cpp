@@ -18,6 +18,8 @@
 
 #include "graphicspiece.h"
 #include <QSvgRenderer>
+#include <QPainter>
+#include <QPixmapCache>
 
 
 GraphicsPiece::GraphicsPiece(const Chess::Piece& piece,
@@ -54,23 +56,45 @@ void GraphicsPiece::paint(QPainter* painter,
 	Q_UNUSED(option);
 	Q_UNUSED(widget);
 
-	QRectF bounds(m_renderer->boundsOnElement(m_elementId));
-	qreal ar = bounds.width() / bounds.height();
-	qreal width = m_rect.width() * 0.8;
+	// Rasterize each piece type only once per size and share the
+	// pixmap between all items: rendering SVG is by far the most
+	// expensive part of painting a board, and a position can have
+	// dozens of identical pieces (and a game wall hundreds)
+	qreal dpr = painter->device()->devicePixelRatioF();
+	int size = qRound(m_rect.width() * dpr);
 
-	if (ar > 1.0)
+	QString key = QString("cutechess_%1_%2").arg(m_elementId).arg(size);
+	QPixmap pixmap;
+	if (!QPixmapCache::find(key, &pixmap))
 	{
-		bounds.setWidth(width);
-		bounds.setHeight(width / ar);
+		pixmap = QPixmap(size, size);
+		pixmap.fill(Qt::transparent);
+
+		QRectF bounds(m_renderer->boundsOnElement(m_elementId));
+		qreal ar = bounds.width() / bounds.height();
+		qreal width = size * 0.8;
+
+		if (ar > 1.0)
+		{
+			bounds.setWidth(width);
+			bounds.setHeight(width / ar);
+		}
+		else
+		{
+			bounds.setHeight(width);
+			bounds.setWidth(width * ar);
+		}
+		bounds.moveCenter(QRectF(pixmap.rect()).center());
+
+		QPainter pixmapPainter(&pixmap);
+		m_renderer->render(&pixmapPainter, m_elementId, bounds);
+		pixmapPainter.end();
+
+		pixmap.setDevicePixelRatio(dpr);
+		QPixmapCache::insert(key, pixmap);
 	}
-	else
-	{
-		bounds.setHeight(width);
-		bounds.setWidth(width * ar);
-	}
-	bounds.moveCenter(m_rect.center());
 
-	m_renderer->render(painter, m_elementId, bounds);
+	painter->drawPixmap(m_rect, pixmap, pixmap.rect());
 }
 
 Chess::Piece GraphicsPiece::pieceType() const
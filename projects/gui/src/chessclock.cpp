@@ -17,16 +17,41 @@
 */
 
 #include "chessclock.h"
-#include <QTimerEvent>
+#include <QCoreApplication>
 #include <QLabel>
+#include <QTimer>
 #include <QVBoxLayout>
 
+namespace {
+
+int s_activeClocks = 0;
+
+// All running clocks tick off this one shared timer, so a wall full
+// of games costs a single timer event per tick instead of one per
+// clock. The short period keeps the displayed second accurate
+// without the drift of per-clock 1000 ms timers; actual re-formatting
+// still happens only when the visible second changes.
+QTimer* tickTimer()
+{
+	static QTimer* timer = nullptr;
+	if (timer == nullptr)
+	{
+		timer = new QTimer(QCoreApplication::instance());
+		timer->setTimerType(Qt::CoarseTimer);
+		timer->setInterval(100);
+	}
+	return timer;
+}
+
+} // anonymous namespace
 
 ChessClock::ChessClock(QWidget* parent)
 	: QWidget(parent),
 	  m_totalTime(0),
-	  m_timerId(-1),
+	  m_ticking(false),
 	  m_infiniteTime(false),
+	  m_displayedSecs(-1),
+	  m_displayedNegative(false),
 	  m_nameLabel(new QLabel()),
 	  m_timeLabel(new QLabel())
 {
@@ -45,6 +70,11 @@ ChessClock::ChessClock(QWidget* parent)
 	setLayout(layout);
 }
 
+ChessClock::~ChessClock()
+{
+	stopTicking();
+}
+
 void ChessClock::setPlayerName(const QString& name)
 {
 	if (name.isEmpty())
@@ -59,7 +89,8 @@ void ChessClock::setInfiniteTime(bool infinite)
 	if (!infinite)
 		return;
 
-	stopTimer();
+	stopTicking();
+	m_displayedSecs = -1;
 	m_timeLabel->setText(QString::fromUtf8("<h1>\xE2\x88\x9E</h1>"));
 }
 
@@ -68,6 +99,15 @@ void ChessClock::setTime(int totalTime)
 	if (m_infiniteTime)
 		return;
 
+	// Formatting and label updates only when the displayed second
+	// actually changes
+	const int secs = abs(totalTime + 500) / 1000;
+	const bool negative = totalTime <= -500;
+	if (secs == m_displayedSecs && negative == m_displayedNegative)
+		return;
+	m_displayedSecs = secs;
+	m_displayedNegative = negative;
+
 	QTime timeLeft = QTime(0, 0).addMSecs(abs(totalTime + 500));
 
 	QString format;
@@ -77,7 +117,7 @@ void ChessClock::setTime(int totalTime)
 		format = "mm:ss";
 
 	QString str;
-	if (totalTime <= -500)
+	if (negative)
 		str.append("-");
 	str.append(timeLeft.toString(format));
 
@@ -97,7 +137,14 @@ void ChessClock::start(int totalTime)
 	{
 		m_time.start();
 		m_totalTime = totalTime;
-		m_timerId = startTimer(1000);
+		if (!m_ticking)
+		{
+			m_ticking = true;
+			connect(tickTimer(), SIGNAL(timeout()),
+				this, SLOT(onTick()));
+			if (++s_activeClocks == 1)
+				tickTimer()->start();
+		}
 		setTime(totalTime);
 	}
 }
@@ -106,25 +153,23 @@ void ChessClock::stop()
 {
 	m_timeLabel->setPalette(m_defaultPalette);
 
-	stopTimer();
+	stopTicking();
 	if (!m_infiniteTime)
 		setTime(m_totalTime - m_time.elapsed());
 }
 
-void ChessClock::timerEvent(QTimerEvent* event)
+void ChessClock::onTick()
 {
-	if (!event)
-		return;
-	
-	if (event->timerId() == m_timerId)
-		setTime(m_totalTime - m_time.elapsed());
+	setTime(m_totalTime - m_time.elapsed());
 }
 
-void ChessClock::stopTimer()
+void ChessClock::stopTicking()
 {
-	if (m_timerId != -1)
-	{
-		killTimer(m_timerId);
-		m_timerId = -1;
-	}
+	if (!m_ticking)
+		return;
+
+	m_ticking = false;
+	disconnect(tickTimer(), SIGNAL(timeout()), this, SLOT(onTick()));
+	if (--s_activeClocks == 0)
+		tickTimer()->stop();
 }
@@ -22,32 +22,37 @@
 #include <QWidget>
 #include <QTime>
 
-class QTimerEvent;
 class QLabel;
 
 class ChessClock: public QWidget
 {
 	Q_OBJECT
-	
+
 	public:
 		ChessClock(QWidget* parent = nullptr);
-	
+		virtual ~ChessClock();
+
 	public slots:
 		void setPlayerName(const QString& name);
 		void setInfiniteTime(bool infinite);
 		void setTime(int totalTime);
 		void start(int totalTime);
 		void stop();
-	
-	protected:
-		virtual void timerEvent(QTimerEvent* event);
-	
+
+	private slots:
+		// Updates the display from the shared tick timer
+		void onTick();
+
 	private:
-		void stopTimer();
+		void stopTicking();
 
 		int m_totalTime;
-		int m_timerId;
+		bool m_ticking;
 		bool m_infiniteTime;
+		// Currently displayed time, for skipping re-formatting
+		// on ticks that don't change the visible second
+		int m_displayedSecs;
+		bool m_displayedNegative;
 		QTime m_time;
 		QLabel* m_nameLabel;
 		QLabel* m_timeLabel;
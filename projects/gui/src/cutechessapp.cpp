@@ -23,6 +23,7 @@
 #include <QTime>
 #include <QFileInfo>
 #include <QSettings>
+#include <QEvent>
 
 #include <mersenne.h>
 #include <enginemanager.h>
@@ -40,6 +41,7 @@
 #include "importprogressdlg.h"
 #include "pgnimporter.h"
 #include "gamewall.h"
+#include "framepublisher.h"
 #ifndef Q_OS_WIN32
 #	include <sys/types.h>
 #	include <pwd.h>
@@ -55,7 +57,8 @@ CuteChessApplication::CuteChessApplication(int& argc, char* argv[])
 	  m_gameDatabaseManager(nullptr),
 	  m_gameDatabaseDialog(nullptr),
 	  m_gameWall(nullptr),
-	  m_initialWindowCreated(false)
+	  m_initialWindowCreated(false),
+	  m_renderStats(false)
 {
 	Mersenne::initialize(QTime(0,0,0).msecsTo(QTime::currentTime()));
 
@@ -80,11 +83,17 @@ CuteChessApplication::CuteChessApplication(int& argc, char* argv[])
 	// Use Ini format on all platforms
 	QSettings::setDefaultFormat(QSettings::IniFormat);
 
+	m_renderStats = QSettings().value("ui/render_stats", false).toBool();
+	if (m_renderStats)
+		m_renderStatsTimer.start();
+
 	// Load the engines
 	engineManager()->loadEngines(configPath() + QLatin1String("/engines.json"));
 
-	// Read the game database state
-	gameDatabaseManager()->readState(configPath() + QLatin1String("/gamedb.bin"));
+	// Point the game database manager at its state file. The state
+	// is read lazily on first access to the databases, so showing
+	// the main window doesn't wait for the stored collections.
+	gameDatabaseManager()->setStateFile(configPath() + QLatin1String("/gamedb.bin"));
 
 	connect(this, SIGNAL(lastWindowClosed()), this, SLOT(onLastWindowClosed()));
 	connect(this, SIGNAL(aboutToQuit()), this, SLOT(onAboutToQuit()));
@@ -103,6 +112,40 @@ CuteChessApplication* CuteChessApplication::instance()
 	return static_cast<CuteChessApplication*>(QApplication::instance());
 }
 
+bool CuteChessApplication::notify(QObject* receiver, QEvent* event)
+{
+	if (Q_LIKELY(!m_renderStats) || event->type() != QEvent::Paint)
+		return QApplication::notify(receiver, event);
+
+	QElapsedTimer timer;
+	timer.start();
+	bool ret = QApplication::notify(receiver, event);
+
+	auto& stat = m_paintStats[receiver->metaObject()->className()];
+	stat.first++;
+	stat.second += timer.nsecsElapsed();
+
+	// Print a summary every few seconds and start over, so the
+	// numbers reflect what's on screen right now
+	if (m_renderStatsTimer.elapsed() >= 5000)
+	{
+		qInfo("Render stats for the last %.1f s:",
+		      m_renderStatsTimer.elapsed() / 1000.0);
+		for (auto it = m_paintStats.constBegin();
+		     it != m_paintStats.constEnd(); ++it)
+		{
+			qInfo("  %-28s %6d repaints %8.1f ms",
+			      it.key().constData(),
+			      it.value().first,
+			      it.value().second / 1000000.0);
+		}
+		m_paintStats.clear();
+		m_renderStatsTimer.restart();
+	}
+
+	return ret;
+}
+
 QString CuteChessApplication::userName()
 {
 	#ifdef Q_OS_WIN32
@@ -246,6 +289,17 @@ void CuteChessApplication::showGameWall()
 		m_gameWall->setWindowFlags(flags | Qt::Window);
 		m_gameWall->setAttribute(Qt::WA_DeleteOnClose, true);
 		m_gameWall->setWindowTitle(tr("Active Games"));
+
+		// Export the wall's frames to capture tools through
+		// shared memory if a segment name is configured
+		const QString exportKey = QSettings()
+			.value("ui/gamewall_export_key").toString();
+		if (!exportKey.isEmpty())
+		{
+			int frameRate = QSettings()
+				.value("ui/gamewall_export_fps", 10).toInt();
+			new FramePublisher(m_gameWall, exportKey, frameRate);
+		}
 	}
 
 	showDialog(m_gameWall);
@@ -274,7 +328,7 @@ void CuteChessApplication::onLastWindowClosed()
 void CuteChessApplication::onAboutToQuit()
 {
 	if (gameDatabaseManager()->isModified())
-		gameDatabaseManager()->writeState(configPath() + QLatin1String("/gamedb.bin"));
+		gameDatabaseManager()->saveState(configPath() + QLatin1String("/gamedb.bin"));
 }
 
 void CuteChessApplication::showDialog(QWidget* dlg)
@@ -21,6 +21,9 @@
 
 #include <QApplication>
 #include <QPointer>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QPair>
 
 class EngineManager;
 class GameManager;
@@ -52,6 +55,13 @@ class CuteChessApplication : public QApplication
 		static CuteChessApplication* instance();
 		static QString userName();
 
+		/*!
+		 * Reimplemented to collect per-widget-class repaint
+		 * counts and paint times when the "ui/render_stats"
+		 * setting is enabled.
+		 */
+		virtual bool notify(QObject* receiver, QEvent* event);
+
 	public slots:
 		MainWindow* newGameWindow(ChessGame* game);
 		void newDefaultGame();
@@ -74,6 +84,9 @@ class CuteChessApplication : public QApplication
 		GameDatabaseDialog* m_gameDatabaseDialog;
 		QPointer<GameWall> m_gameWall;
 		bool m_initialWindowCreated;
+		bool m_renderStats;
+		QElapsedTimer m_renderStatsTimer;
+		QHash<QByteArray, QPair<int, qint64> > m_paintStats;
 
 	private slots:
 		void onLastWindowClosed();
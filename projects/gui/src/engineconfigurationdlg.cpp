@@ -28,6 +28,8 @@
 
 #include <enginefactory.h>
 #include <engineoption.h>
+#include <engineoptioncache.h>
+#include <engineoptionfactory.h>
 #include <chessplayer.h>
 #include <enginebuilder.h>
 
@@ -285,6 +287,45 @@ void EngineConfigurationDialog::detectEngineOptions()
 	m_oldPath = ui->m_workingDirEdit->text();
 	m_oldProtocol = ui->m_protocolCombo->currentText();
 
+	// An unchanged binary that was probed before can be served
+	// from the option cache without launching it
+	QVariantMap cached;
+	if (EngineOptionCache::lookup(
+		EngineOptionCache::binaryKey(m_oldCommand, m_oldPath),
+		m_oldProtocol, &cached))
+	{
+		QList<EngineOption*> options;
+		const QVariantList optionList = cached.value("options").toList();
+		for (const QVariant& optionData : optionList)
+		{
+			EngineOption* option =
+				EngineOptionFactory::create(optionData.toMap());
+			if (option == nullptr)
+				continue;
+
+			// Keep the values the user has already configured
+			for (const EngineOption* old : qAsConst(m_options))
+			{
+				if (old->name() == option->name()
+				&&  option->isValid(old->value()))
+				{
+					option->setValue(old->value());
+					break;
+				}
+			}
+			options << option;
+		}
+
+		qDeleteAll(m_options);
+		m_options = options;
+		m_engineOptionModel->setOptions(m_options);
+		m_variants = cached.value("variants").toStringList();
+
+		ui->m_restoreBtn->setDisabled(m_options.isEmpty());
+		emit detectionFinished();
+		return;
+	}
+
 	ui->m_detectBtn->setEnabled(false);
 	ui->m_restoreBtn->setEnabled(false);
 	ui->m_buttonBox->button(QDialogButtonBox::Ok)->setEnabled(false);
@@ -0,0 +1,185 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "enginedetectionbatch.h"
+
+#include <QFileInfo>
+#include <QThread>
+#include <QTimer>
+
+#include <chessengine.h>
+#include <enginebuilder.h>
+#include <engineoption.h>
+
+namespace {
+
+// Time an engine gets to respond before its probe is killed
+const int probeTimeout = 10000;
+
+int maxConcurrentProbes()
+{
+	return qMax(2, QThread::idealThreadCount());
+}
+
+// Returns the file name of the binary in an engine command,
+// for naming engines that don't report a name themselves
+QString commandFileName(const QString& command)
+{
+	QString cmd = command;
+	if (cmd.startsWith("wine "))
+		cmd = cmd.mid(5);
+	cmd.remove('\"');
+
+	return QFileInfo(cmd).completeBaseName();
+}
+
+} // anonymous namespace
+
+EngineDetectionBatch::EngineDetectionBatch(const QList<EngineConfiguration>& engines,
+					   QObject* parent)
+	: QObject(parent),
+	  m_queue(engines),
+	  m_total(engines.size()),
+	  m_done(0),
+	  m_cancelled(false)
+{
+}
+
+void EngineDetectionBatch::start()
+{
+	startNext();
+}
+
+void EngineDetectionBatch::cancel()
+{
+	if (m_cancelled)
+		return;
+	m_cancelled = true;
+
+	m_done += m_queue.size();
+	m_queue.clear();
+
+	if (m_probes.isEmpty())
+	{
+		emit progress(m_done, m_total);
+		emit finished();
+		return;
+	}
+
+	// The probes resolve through onEngineQuit() as usual
+	const auto engines = m_probes.keys();
+	for (ChessEngine* engine : engines)
+		engine->kill();
+}
+
+void EngineDetectionBatch::startNext()
+{
+	while (!m_queue.isEmpty()
+	&&     m_probes.size() < maxConcurrentProbes())
+		startProbe(m_queue.takeFirst());
+
+	if (m_probes.isEmpty() && m_queue.isEmpty())
+		emit finished();
+}
+
+void EngineDetectionBatch::startProbe(const EngineConfiguration& config)
+{
+	EngineBuilder builder(config);
+	QString error;
+	auto engine = qobject_cast<ChessEngine*>(
+		builder.create(nullptr, nullptr, this, &error));
+
+	if (engine == nullptr)
+	{
+		m_done++;
+		emit progress(m_done, m_total);
+		return;
+	}
+
+	Probe probe = { config, false };
+	m_probes[engine] = probe;
+
+	connect(engine, SIGNAL(ready()),
+		this, SLOT(onEngineReady()));
+	connect(engine, SIGNAL(disconnected()),
+		this, SLOT(onEngineQuit()));
+
+	// The timer dies with the engine, so a normal quit cancels it
+	QTimer::singleShot(probeTimeout, engine, SLOT(kill()));
+}
+
+void EngineDetectionBatch::onEngineReady()
+{
+	auto engine = qobject_cast<ChessEngine*>(QObject::sender());
+	Q_ASSERT(engine != nullptr);
+	if (!m_probes.contains(engine))
+		return;
+
+	Probe& probe = m_probes[engine];
+	probe.ready = true;
+
+	// The engine's reported name, with the binary name as a
+	// fallback for engines that don't send one
+	QString name = engine->name();
+	if (name.isEmpty()
+	||  name == QLatin1String("UciEngine")
+	||  name == QLatin1String("XboardEngine"))
+		name = commandFileName(probe.config.command());
+	probe.config.setName(name);
+
+	QList<EngineOption*> options;
+	const auto engineOptions = engine->options();
+	for (const EngineOption* option : engineOptions)
+		options << option->copy();
+	probe.config.setOptions(options);
+
+	probe.config.setSupportedVariants(engine->variants());
+
+	if (!m_cancelled)
+		emit engineDetected(probe.config);
+
+	engine->quit();
+}
+
+void EngineDetectionBatch::onEngineQuit()
+{
+	auto engine = qobject_cast<ChessEngine*>(QObject::sender());
+	Q_ASSERT(engine != nullptr);
+	if (!m_probes.contains(engine))
+		return;
+
+	const Probe probe = m_probes.take(engine);
+	engine->deleteLater();
+
+	// Silent binaries get one more chance with the other protocol
+	if (!probe.ready
+	&&  !m_cancelled
+	&&  probe.config.protocol() == QLatin1String("uci"))
+	{
+		EngineConfiguration retry(probe.config);
+		retry.setProtocol("xboard");
+		m_queue.prepend(retry);
+	}
+	else
+	{
+		m_done++;
+		emit progress(m_done, m_total);
+	}
+
+	startNext();
+}
@@ -0,0 +1,105 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ENGINE_DETECTION_BATCH_H
+#define ENGINE_DETECTION_BATCH_H
+
+#include <QObject>
+#include <QList>
+#include <QHash>
+#include <engineconfiguration.h>
+
+class ChessEngine;
+
+/*!
+ * \brief Probes a batch of engine binaries concurrently.
+ *
+ * EngineDetectionBatch runs the same detection as the "Detect"
+ * button in EngineConfigurationDialog - start the engine, wait for
+ * its protocol response, read its name, options and variants - but
+ * for many binaries at once. A bounded number of engines is probed
+ * concurrently and each probe is killed after a timeout, so one
+ * unresponsive binary can't stall a whole folder.
+ *
+ * Binaries are first probed with the UCI protocol; ones that don't
+ * respond are retried with xboard before being given up on.
+ *
+ * \sa EngineManagementWidget
+ */
+class EngineDetectionBatch : public QObject
+{
+	Q_OBJECT
+
+	public:
+		/*!
+		 * Creates a new batch for \a engines.
+		 *
+		 * The configurations only need a command and a working
+		 * directory; the rest is filled in by detection.
+		 */
+		EngineDetectionBatch(const QList<EngineConfiguration>& engines,
+				     QObject* parent = nullptr);
+
+		/*! Starts probing the binaries. */
+		void start();
+
+	public slots:
+		/*!
+		 * Stops the batch as soon as possible. Engines being
+		 * probed are killed and the queue is dropped; the
+		 * finished() signal is still emitted at the end.
+		 */
+		void cancel();
+
+	signals:
+		/*!
+		 * Emitted when \a engine responded to detection. The
+		 * configuration holds the engine's reported name,
+		 * options and supported variants.
+		 */
+		void engineDetected(const EngineConfiguration& engine);
+		/*!
+		 * Emitted when a binary is resolved (detected, failed
+		 * or cancelled); \a done of \a total are resolved.
+		 */
+		void progress(int done, int total);
+		/*! Emitted when every binary is resolved. */
+		void finished();
+
+	private slots:
+		void onEngineReady();
+		void onEngineQuit();
+
+	private:
+		struct Probe
+		{
+			EngineConfiguration config;
+			bool ready;
+		};
+
+		void startNext();
+		void startProbe(const EngineConfiguration& config);
+
+		QList<EngineConfiguration> m_queue;
+		QHash<ChessEngine*, Probe> m_probes;
+		int m_total;
+		int m_done;
+		bool m_cancelled;
+};
+
+#endif // ENGINE_DETECTION_BATCH_H
@@ -20,7 +20,10 @@
 #include "ui_enginemanagementwidget.h"
 
 #include <QSortFilterProxyModel>
+#include <QDir>
 #include <QFileDialog>
+#include <QFileInfo>
+#include <QProgressDialog>
 #include <QSettings>
 #include <functional>
 #include <algorithm>
@@ -30,6 +33,57 @@
 #include "cutechessapp.h"
 #include "engineconfigurationmodel.h"
 #include "engineconfigurationdlg.h"
+#include "enginedetectionbatch.h"
+
+namespace {
+
+// Returns the absolute path of the binary an engine configuration
+// runs, for recognizing binaries that are already configured
+QString resolvedCommand(const EngineConfiguration& config)
+{
+	QString cmd = config.command();
+	if (cmd.startsWith("wine "))
+		cmd = cmd.mid(5);
+	cmd.remove('\"');
+
+	QFileInfo info(cmd);
+	if (info.isRelative() && !config.workingDirectory().isEmpty())
+		info.setFile(QDir(config.workingDirectory()), cmd);
+
+	return info.absoluteFilePath();
+}
+
+// Builds an undetected configuration for a binary, mirroring what
+// EngineConfigurationDialog::setExecutable() does for a single file
+EngineConfiguration configForBinary(const QFileInfo& info)
+{
+	EngineConfiguration config;
+	config.setWorkingDirectory(QDir::toNativeSeparators(info.absolutePath()));
+	config.setProtocol("uci");
+
+	QString fileName = info.fileName();
+	QString prefix;
+	QString suffix(info.suffix().toLower());
+	bool isExe = (suffix == "exe" || suffix == "bat" || suffix == "cmd");
+
+	#ifndef Q_OS_WIN32
+	if (isExe)
+		prefix = "wine ";
+	else
+		fileName.prepend("./");
+	#endif
+
+	if (fileName.contains(' '))
+	{
+		fileName.prepend('\"');
+		fileName.append('\"');
+	}
+
+	config.setCommand(QDir::toNativeSeparators(prefix + fileName));
+	return config;
+}
+
+} // anonymous namespace
 
 
 EngineManagementWidget::EngineManagementWidget(QWidget* parent)
@@ -63,6 +117,10 @@ EngineManagementWidget::EngineManagementWidget(QWidget* parent)
 	// Add button
 	connect(ui->m_addBtn, SIGNAL(clicked(bool)), this, SLOT(addEngine()));
 
+	// Add folder button
+	connect(ui->m_addFolderBtn, SIGNAL(clicked(bool)),
+		this, SLOT(addEngineFolder()));
+
 	// Configure button
 	connect(ui->m_configureBtn, SIGNAL(clicked(bool)), this,
 		SLOT(configureEngine()));
@@ -134,6 +192,80 @@ void EngineManagementWidget::addEngine()
 	dlg->open();
 }
 
+void EngineManagementWidget::addEngineFolder()
+{
+	auto dlg = new QFileDialog(
+		this, tr("Select Engine Folder"),
+		ui->m_defaultLocationEdit->text());
+	dlg->setFileMode(QFileDialog::Directory);
+	dlg->setOption(QFileDialog::ShowDirsOnly);
+	dlg->setAttribute(Qt::WA_DeleteOnClose);
+	dlg->setAcceptMode(QFileDialog::AcceptOpen);
+
+	connect(dlg, &QFileDialog::fileSelected,
+		[=](const QString& dir) { detectEngines(dir); });
+	dlg->open();
+}
+
+void EngineManagementWidget::detectEngines(const QString& dir)
+{
+	// Binaries that are already configured are skipped
+	QSet<QString> knownBinaries;
+	const auto engines = m_engineManager->engines();
+	for (const EngineConfiguration& config : engines)
+		knownBinaries.insert(resolvedCommand(config));
+
+	QList<EngineConfiguration> candidates;
+	const auto binaries = QDir(dir).entryInfoList(
+		QDir::Files | QDir::Executable, QDir::Name);
+	for (const QFileInfo& info : binaries)
+	{
+		if (!knownBinaries.contains(info.absoluteFilePath()))
+			candidates << configForBinary(info);
+	}
+	if (candidates.isEmpty())
+		return;
+
+	auto batch = new EngineDetectionBatch(candidates, this);
+	auto progressDlg = new QProgressDialog(
+		tr("Detecting engines..."), tr("Cancel"),
+		0, candidates.size(), this);
+	progressDlg->setWindowModality(Qt::WindowModal);
+	progressDlg->setWindowTitle(tr("Add Engine Folder"));
+	progressDlg->setMinimumDuration(0);
+	progressDlg->setValue(0);
+
+	connect(progressDlg, SIGNAL(canceled()), batch, SLOT(cancel()));
+	connect(batch, &EngineDetectionBatch::progress,
+		[=](int done, int total)
+	{
+		Q_UNUSED(total);
+		progressDlg->setValue(done);
+	});
+	connect(batch, &EngineDetectionBatch::engineDetected,
+		[=](const EngineConfiguration& engine)
+	{
+		// Make the name unique among the configured engines
+		EngineConfiguration config(engine);
+		QSet<QString> names = m_engineManager->engineNames();
+		QString name = config.name();
+		for (int i = 2; names.contains(name); i++)
+			name = QString("%1 (%2)").arg(config.name()).arg(i);
+		config.setName(name);
+
+		m_engineManager->addEngine(config);
+		m_hasChanged = true;
+		updateEngineCount();
+	});
+	connect(batch, &EngineDetectionBatch::finished, [=]()
+	{
+		progressDlg->deleteLater();
+		batch->deleteLater();
+	});
+
+	batch->start();
+}
+
 void EngineManagementWidget::configureEngine()
 {
 	configureEngine(ui->m_enginesList->currentIndex());
@@ -57,6 +57,7 @@ class EngineManagementWidget : public QWidget
 		void updateUi();
 		void updateSearch(const QString& terms);
 		void addEngine();
+		void addEngineFolder();
 		void configureEngine();
 		void configureEngine(const QModelIndex& index);
 		void removeEngine();
@@ -64,6 +65,7 @@ class EngineManagementWidget : public QWidget
 
 	private:
 		void updateEngineCount();
+		void detectEngines(const QString& dir);
 
 		EngineManager* m_engineManager;
 		bool m_hasChanged;
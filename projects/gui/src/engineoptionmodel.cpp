@@ -87,10 +87,10 @@ QVariant EngineOptionModel::data(const QModelIndex& index, int role) const
 
 			case 1:
 				// see Qt::CheckStateRole
-				if (option->value().type() == QVariant::Bool)
+				if (option->value().type() == EngineOptionValue::Bool)
 					return QVariant();
 
-				return option->value();
+				return option->value().toVariant();
 
 			case 2:
 				return option->alias();
@@ -101,7 +101,7 @@ QVariant EngineOptionModel::data(const QModelIndex& index, int role) const
 	}
 	else if (role == Qt::CheckStateRole)
 	{
-		if (index.column() == 1 && option->value().type() == QVariant::Bool)
+		if (index.column() == 1 && option->value().type() == EngineOptionValue::Bool)
 			return option->value().toBool() ? Qt::Checked : Qt::Unchecked;
 
 		return QVariant();
@@ -168,7 +168,7 @@ Qt::ItemFlags EngineOptionModel::flags(const QModelIndex& index) const
 			return defaultFlags;
 
 		// make check options checkable
-		if (option->value().type() == QVariant::Bool)
+		if (option->value().type() == EngineOptionValue::Bool)
 			return Qt::ItemFlags(defaultFlags | Qt::ItemIsUserCheckable);
 
 		return Qt::ItemFlags(defaultFlags | Qt::ItemIsEditable);
@@ -202,10 +202,14 @@ bool EngineOptionModel::setData(const QModelIndex& index, const QVariant& data,
 			option->setValue(data.toInt() == Qt::Checked);
 			return true;
 		}
-		else if (option->isValid(data))
+		else
 		{
-			option->setValue(data);
-			return true;
+			EngineOptionValue value(EngineOptionValue::fromVariant(data));
+			if (option->isValid(value))
+			{
+				option->setValue(value);
+				return true;
+			}
 		}
 	}
 	else if (index.column() == 2)
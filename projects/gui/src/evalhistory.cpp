@@ -18,6 +18,7 @@
 
 #include "evalhistory.h"
 #include <QVBoxLayout>
+#include <QTimer>
 #include <QtGlobal>
 #include <qcustomplot.h>
 #include <chessgame.h>
@@ -26,8 +27,18 @@
 EvalHistory::EvalHistory(QWidget *parent)
 	: QWidget(parent),
 	  m_plot(new QCustomPlot(this)),
-	  m_game(nullptr)
+	  m_game(nullptr),
+	  m_maxPly(-1)
 {
+	// Incoming scores only mark the plot dirty; the actual replot
+	// runs at most once per timer interval so that long games and
+	// MultiPV engines can't stall the UI thread
+	m_replotTimer = new QTimer(this);
+	m_replotTimer->setSingleShot(true);
+	m_replotTimer->setInterval(250);
+	connect(m_replotTimer, SIGNAL(timeout()),
+		this, SLOT(onReplotTimeout()));
+
 	auto x = m_plot->xAxis;
 	auto y = m_plot->yAxis;
 	auto ticker = new QCPAxisTickerFixed;
@@ -55,6 +66,8 @@ void EvalHistory::setGame(ChessGame* game)
 		m_game->disconnect(this);
 	m_game = game;
 	m_plot->clearGraphs();
+	m_replotTimer->stop();
+	m_maxPly = -1;
 	if (!game)
 	{
 		replot(0);
@@ -81,6 +94,12 @@ void EvalHistory::setGame(ChessGame* game)
 	cBlack.setAlpha(128);
 	m_plot->graph(1)->setBrush(QBrush(cBlack));
 
+	// Let QCustomPlot decimate the data to a min/max envelope per
+	// pixel column, keeping the replot cost proportional to the
+	// plot width instead of the game length
+	m_plot->graph(0)->setAdaptiveSampling(true);
+	m_plot->graph(1)->setAdaptiveSampling(true);
+
 	const auto& scores = game->scores();
 	int ply = -1;
 
@@ -123,11 +142,18 @@ void EvalHistory::replot(int maxPly)
 		ticker->setTickStep(double(step));
 		m_plot->rescaleAxes();
 	}
-	m_plot->replot();
+	m_plot->replot(QCustomPlot::rpQueuedReplot);
 }
 
 void EvalHistory::onScore(int ply, int score)
 {
 	addData(ply, score);
-	replot(ply);
+	m_maxPly = qMax(m_maxPly, ply);
+	if (!m_replotTimer->isActive())
+		m_replotTimer->start();
+}
+
+void EvalHistory::onReplotTimeout()
+{
+	replot(m_maxPly);
 }
@@ -23,6 +23,7 @@
 #include <QPointer>
 
 class QCustomPlot;
+class QTimer;
 class ChessGame;
 
 /*!
@@ -46,6 +47,7 @@ class EvalHistory : public QWidget
 
 	private slots:
 		void onScore(int ply, int score);
+		void onReplotTimeout();
 
 	private:
 		void addData(int ply, int score);
@@ -53,6 +55,8 @@ class EvalHistory : public QWidget
 
 		QCustomPlot* m_plot;
 		QPointer<ChessGame> m_game;
+		QTimer* m_replotTimer;
+		int m_maxPly;
 };
 
 #endif // EVALHISTORY_H
@@ -17,20 +17,162 @@
 */
 
 #include "evalwidget.h"
+#include <QAbstractTableModel>
 #include <QTableWidget>
 #include <QTableWidgetItem>
+#include <QTableView>
 #include <QHeaderView>
 #include <QVBoxLayout>
 #include <QVector>
 #include <QTime>
 #include <chessplayer.h>
 
+
+/*
+    A fixed-slot model for the PV table: row i holds PV line i + 1
+    and is updated in place, so an evaluation update is just a
+    dataChanged() on existing cells instead of new QTableWidgetItems.
+    With a MultiPV engine each line keeps its own row.
+*/
+class PvLineModel : public QAbstractTableModel
+{
+	Q_OBJECT
+
+	public:
+		enum Column
+		{
+			DepthColumn,
+			TimeColumn,
+			NodesColumn,
+			ScoreColumn,
+			PvColumn,
+			ColumnCount
+		};
+
+		explicit PvLineModel(QObject* parent = nullptr);
+
+		// Inherited from QAbstractTableModel
+		int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+		int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+		QVariant data(const QModelIndex& index,
+			      int role = Qt::DisplayRole) const override;
+		QVariant headerData(int section,
+				    Qt::Orientation orientation,
+				    int role = Qt::DisplayRole) const override;
+
+		// Updates the row slot for PV line number "row + 1",
+		// creating the slot on first use
+		void setLine(int row, const QStringList& texts);
+		// Removes all rows
+		void clear();
+
+	private:
+		struct Line
+		{
+			QString text[ColumnCount];
+		};
+
+		QVector<Line> m_lines;
+};
+
+PvLineModel::PvLineModel(QObject* parent)
+	: QAbstractTableModel(parent)
+{
+}
+
+int PvLineModel::rowCount(const QModelIndex& parent) const
+{
+	if (parent.isValid())
+		return 0;
+	return m_lines.size();
+}
+
+int PvLineModel::columnCount(const QModelIndex& parent) const
+{
+	if (parent.isValid())
+		return 0;
+	return ColumnCount;
+}
+
+QVariant PvLineModel::data(const QModelIndex& index, int role) const
+{
+	if (!index.isValid() || index.row() >= m_lines.size())
+		return QVariant();
+
+	if (role == Qt::DisplayRole)
+		return m_lines.at(index.row()).text[index.column()];
+	if (role == Qt::TextAlignmentRole && index.column() != PvColumn)
+		return int(Qt::AlignVCenter | Qt::AlignRight);
+
+	return QVariant();
+}
+
+QVariant PvLineModel::headerData(int section,
+				 Qt::Orientation orientation,
+				 int role) const
+{
+	if (role != Qt::DisplayRole || orientation != Qt::Horizontal)
+		return QVariant();
+
+	switch (section)
+	{
+	case DepthColumn:
+		return tr("Depth");
+	case TimeColumn:
+		return tr("Time");
+	case NodesColumn:
+		return tr("Nodes");
+	case ScoreColumn:
+		return tr("Score");
+	case PvColumn:
+		return tr("PV");
+	default:
+		return QVariant();
+	}
+}
+
+void PvLineModel::setLine(int row, const QStringList& texts)
+{
+	Q_ASSERT(texts.size() == ColumnCount);
+
+	if (row >= m_lines.size())
+	{
+		beginInsertRows(QModelIndex(), m_lines.size(), row);
+		m_lines.resize(row + 1);
+		endInsertRows();
+	}
+
+	Line& line = m_lines[row];
+	bool changed = false;
+	for (int i = 0; i < ColumnCount; i++)
+	{
+		if (line.text[i] == texts.at(i))
+			continue;
+		line.text[i] = texts.at(i);
+		changed = true;
+	}
+
+	if (changed)
+		emit dataChanged(index(row, 0), index(row, ColumnCount - 1));
+}
+
+void PvLineModel::clear()
+{
+	if (m_lines.isEmpty())
+		return;
+
+	beginResetModel();
+	m_lines.clear();
+	endResetModel();
+}
+
+
 EvalWidget::EvalWidget(QWidget *parent)
 	: QWidget(parent),
 	  m_player(nullptr),
 	  m_statsTable(new QTableWidget(1, 5, this)),
-	  m_pvTable(new QTableWidget(0, 5, this)),
-	  m_depth(-1)
+	  m_pvTable(new QTableView(this)),
+	  m_pvModel(new PvLineModel(this))
 {
 	m_statsTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
 	auto hHeader = m_statsTable->horizontalHeader();
@@ -48,17 +190,14 @@ EvalWidget::EvalWidget(QWidget *parent)
 	protoItem->setTextAlignment(Qt::AlignVCenter | Qt::AlignRight);
 	m_statsTable->setItemPrototype(protoItem);
 
+	m_pvTable->setModel(m_pvModel);
 	m_pvTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
 	m_pvTable->verticalHeader()->hide();
 
-	QStringList pvHeaders;
-	pvHeaders << tr("Depth") << tr("Time") << tr("Nodes")
-		  << tr("Score") << tr("PV");
-	m_pvTable->setHorizontalHeaderLabels(pvHeaders);
-	m_pvTable->setColumnWidth(0, 60);
-	m_pvTable->setColumnWidth(1, 60);
-	m_pvTable->setColumnWidth(2, 100);
-	m_pvTable->setColumnWidth(3, 60);
+	m_pvTable->setColumnWidth(PvLineModel::DepthColumn, 60);
+	m_pvTable->setColumnWidth(PvLineModel::TimeColumn, 60);
+	m_pvTable->setColumnWidth(PvLineModel::NodesColumn, 100);
+	m_pvTable->setColumnWidth(PvLineModel::ScoreColumn, 60);
 	m_pvTable->horizontalHeader()->setStretchLastSection(true);
 
 	QVBoxLayout* layout = new QVBoxLayout();
@@ -71,10 +210,7 @@ EvalWidget::EvalWidget(QWidget *parent)
 void EvalWidget::clear()
 {
 	m_statsTable->clearContents();
-	m_depth = -1;
-	m_pv.clear();
-	m_pvTable->clearContents();
-	m_pvTable->setRowCount(0);
+	m_pvModel->clear();
 }
 
 void EvalWidget::setPlayer(ChessPlayer* player)
@@ -91,44 +227,48 @@ void EvalWidget::setPlayer(ChessPlayer* player)
 		this, SLOT(clear()));
 	connect(player, SIGNAL(thinking(MoveEvaluation)),
 		this, SLOT(onEval(MoveEvaluation)));
+	connect(player, SIGNAL(multiPvThinking(QVector<MoveEvaluation>)),
+		this, SLOT(onMultiPv(QVector<MoveEvaluation>)));
+
+	// The player's evaluation keeps accumulating while its tab is
+	// hidden, so a newly activated tab shows the latest search
+	// state right away instead of waiting for the next update
+	const MoveEvaluation& eval = player->evaluation();
+	if (!eval.isEmpty())
+		onEval(eval);
 }
 
 void EvalWidget::onEval(const MoveEvaluation& eval)
 {
+	// Stats cells are reused; only their text changes
+	auto setStat = [this](int column, const QString& text)
+	{
+		auto item = m_statsTable->item(0, column);
+		if (item == nullptr)
+		{
+			item = m_statsTable->itemPrototype()->clone();
+			m_statsTable->setItem(0, column, item);
+		}
+		item->setText(text);
+	};
+
 	auto nps = eval.nps();
 	if (nps)
-	{
-		QString npsStr = QString("%1k").arg(nps / 1000);
-		auto item = m_statsTable->itemPrototype()->clone();
-		item->setText(npsStr);
-		m_statsTable->setItem(0, NpsHeader, item);
-	}
+		setStat(NpsHeader, QString("%1k").arg(nps / 1000));
 	if (eval.tbHits() && eval.tbHits() != MoveEvaluation::NULL_TBHITS)
-	{
-		auto item = m_statsTable->itemPrototype()->clone();
-		item->setText(QString::number(eval.tbHits()));
-		m_statsTable->setItem(0, TbHeader, item);
-	}
+		setStat(TbHeader, QString::number(eval.tbHits()));
 	if (eval.hashUsage())
 	{
 		double usage = double(eval.hashUsage()) / 10.0;
-		auto item = m_statsTable->itemPrototype()->clone();
-		item->setText(QString("%1%").arg(usage, 0, 'f', 1));
-		m_statsTable->setItem(0, HashHeader, item);
+		setStat(HashHeader, QString("%1%").arg(usage, 0, 'f', 1));
 	}
 	auto ponderMove = eval.ponderMove();
 	if (!ponderMove.isEmpty())
-	{
-		auto item = m_statsTable->itemPrototype()->clone();
-		item->setText(ponderMove);
-		m_statsTable->setItem(0, PonderMoveHeader, item);
-	}
+		setStat(PonderMoveHeader, ponderMove);
 	if (eval.ponderhitRate())
 	{
 		double rate = double(eval.ponderhitRate() / 10.0);
-		auto item = m_statsTable->itemPrototype()->clone();
-		item->setText(QString("%1%").arg(rate, 0, 'f', 1));
-		m_statsTable->setItem(0, PonderHitHeader, item);
+		setStat(PonderHitHeader, QString("%1%").arg(rate, 0, 'f', 1));
 	}
 
 	QString depth;
@@ -154,23 +294,26 @@ void EvalWidget::onEval(const MoveEvaluation& eval)
 	if (eval.nodeCount())
 		nodeCount = QString::number(eval.nodeCount());
 
-	QString score = eval.scoreText();
-
-	QVector<QTableWidgetItem*> items;
-	items << new QTableWidgetItem(depth)
-	      << new QTableWidgetItem(time)
-	      << new QTableWidgetItem(nodeCount)
-	      << new QTableWidgetItem(score)
-	      << new QTableWidgetItem(eval.pv());
-
-	for (int i = 0; i < 4; i++)
-		items[i]->setTextAlignment(Qt::AlignVCenter | Qt::AlignRight);
-
-	if (eval.depth() != m_depth || (eval.pv() != m_pv && !m_pv.isEmpty()))
-		m_pvTable->insertRow(0);
-	m_depth = eval.depth();
-	m_pv = eval.pv();
+	// PV line n occupies row slot n - 1; single-PV updates always
+	// land on row 0
+	int row = qMax(0, eval.pvNumber() - 1);
+	m_pvModel->setLine(row, QStringList()
+			   << depth
+			   << time
+			   << nodeCount
+			   << eval.scoreText()
+			   << eval.pv());
+}
 
-	for (int i = 0; i < items.size(); i++)
-		m_pvTable->setItem(0, i, items.at(i));
+void EvalWidget::onMultiPv(const QVector<MoveEvaluation>& pvs)
+{
+	// One snapshot per completed iteration; every PV row is from
+	// the same depth
+	for (const MoveEvaluation& eval : pvs)
+	{
+		if (!eval.isEmpty())
+			onEval(eval);
+	}
 }
+
+#include "evalwidget.moc"
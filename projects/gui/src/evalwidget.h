@@ -24,7 +24,9 @@
 #include <moveevaluation.h>
 
 class QTableWidget;
+class QTableView;
 class ChessPlayer;
+class PvLineModel;
 
 /*!
  * \brief A widget that shows the engine's thinking in realtime.
@@ -46,6 +48,7 @@ class EvalWidget : public QWidget
 	private slots:
 		void clear();
 		void onEval(const MoveEvaluation& eval);
+		void onMultiPv(const QVector<MoveEvaluation>& pvs);
 
 	private:
 		enum StatHeaders
@@ -59,9 +62,9 @@ class EvalWidget : public QWidget
 
 		QPointer<ChessPlayer> m_player;
 		QTableWidget* m_statsTable;
-		QTableWidget* m_pvTable;
-		int m_depth;
-		QString m_pv;
+		QTableView* m_pvTable;
+		// One row slot per PV line, updated in place
+		PvLineModel* m_pvModel;
 };
 
 #endif // EVALWIDGET_H
@@ -0,0 +1,202 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "framepublisher.h"
+
+#include <cstring>
+
+#include <QTimer>
+#include <QWidget>
+
+namespace {
+
+const quint32 FrameMagic = 0x47574631; // 'GWF1'
+const quint32 FrameVersion = 1;
+
+// The header precedes the pixel data in the shared memory segment
+struct FrameHeader
+{
+	quint32 magic;
+	quint32 version;
+	quint32 width;
+	quint32 height;
+	quint32 bytesPerLine;
+	quint32 format;
+	quint32 frameCounter;
+	quint32 dirtyX;
+	quint32 dirtyY;
+	quint32 dirtyWidth;
+	quint32 dirtyHeight;
+};
+
+} // anonymous namespace
+
+FramePublisher::FramePublisher(QWidget* target,
+			       const QString& key,
+			       int frameRate)
+	: QObject(target),
+	  m_target(target),
+	  m_timer(new QTimer(this)),
+	  m_frameCounter(0)
+{
+	Q_ASSERT(target != nullptr);
+	Q_ASSERT(frameRate > 0);
+
+	m_memory.setKey(key);
+
+	m_timer->setInterval(1000 / qMax(frameRate, 1));
+	connect(m_timer, SIGNAL(timeout()), this, SLOT(publishFrame()));
+	m_timer->start();
+}
+
+FramePublisher::~FramePublisher()
+{
+}
+
+QRect FramePublisher::dirtyRect(const QImage& frame) const
+{
+	if (frame.size() != m_lastFrame.size())
+		return frame.rect();
+
+	// Find the vertical extent of the changes with per-row
+	// comparisons, then narrow the changed rows down to a
+	// bounding rectangle
+	const int rowBytes = frame.bytesPerLine();
+	int top = -1;
+	int bottom = -1;
+	for (int y = 0; y < frame.height(); y++)
+	{
+		if (memcmp(frame.constScanLine(y),
+			   m_lastFrame.constScanLine(y), rowBytes) != 0)
+		{
+			if (top < 0)
+				top = y;
+			bottom = y;
+		}
+	}
+	if (top < 0)
+		return QRect();
+
+	int left = frame.width() - 1;
+	int right = 0;
+	for (int y = top; y <= bottom; y++)
+	{
+		const quint32* row =
+			reinterpret_cast<const quint32*>(frame.constScanLine(y));
+		const quint32* lastRow =
+			reinterpret_cast<const quint32*>(m_lastFrame.constScanLine(y));
+
+		for (int x = 0; x < left; x++)
+		{
+			if (row[x] != lastRow[x])
+			{
+				left = x;
+				break;
+			}
+		}
+		for (int x = frame.width() - 1; x > right; x--)
+		{
+			if (row[x] != lastRow[x])
+			{
+				right = x;
+				break;
+			}
+		}
+	}
+
+	return QRect(left, top, right - left + 1, bottom - top + 1);
+}
+
+bool FramePublisher::ensureSegment(int frameBytes)
+{
+	const int total = int(sizeof(FrameHeader)) + frameBytes;
+	if (m_memory.isAttached())
+	{
+		if (m_memory.size() >= total)
+			return true;
+		// The widget was resized; consumers re-attach when the
+		// header dimensions no longer match the segment
+		m_memory.detach();
+	}
+
+	if (m_memory.create(total))
+		return true;
+
+	// A segment from a crashed run may still exist: attach to it
+	// to release it, then try again
+	if (m_memory.error() == QSharedMemory::AlreadyExists
+	&&  m_memory.attach())
+	{
+		if (m_memory.size() >= total)
+			return true;
+		m_memory.detach();
+		if (m_memory.create(total))
+			return true;
+	}
+
+	qWarning("FramePublisher: cannot create shared memory segment: %s",
+		 qUtf8Printable(m_memory.errorString()));
+	return false;
+}
+
+void FramePublisher::writeFrame(const QImage& frame, const QRect& dirty)
+{
+	if (!ensureSegment(frame.byteCount()))
+		return;
+
+	m_memory.lock();
+
+	FrameHeader* header = static_cast<FrameHeader*>(m_memory.data());
+	header->magic = FrameMagic;
+	header->version = FrameVersion;
+	header->width = frame.width();
+	header->height = frame.height();
+	header->bytesPerLine = frame.bytesPerLine();
+	header->format = frame.format();
+	header->frameCounter = ++m_frameCounter;
+	header->dirtyX = dirty.x();
+	header->dirtyY = dirty.y();
+	header->dirtyWidth = dirty.width();
+	header->dirtyHeight = dirty.height();
+
+	// Copy only the dirty rows; the rest of the segment still
+	// holds the previous frame's identical pixels
+	uchar* pixels = static_cast<uchar*>(m_memory.data())
+		      + sizeof(FrameHeader);
+	const int rowBytes = frame.bytesPerLine();
+	for (int y = dirty.top(); y <= dirty.bottom(); y++)
+		memcpy(pixels + y * rowBytes, frame.constScanLine(y), rowBytes);
+
+	m_memory.unlock();
+}
+
+void FramePublisher::publishFrame()
+{
+	if (!m_target->isVisible() || m_target->size().isEmpty())
+		return;
+
+	QImage frame(m_target->size(), QImage::Format_RGB32);
+	m_target->render(&frame);
+
+	QRect dirty = dirtyRect(frame);
+	if (dirty.isEmpty())
+		return;
+
+	writeFrame(frame, dirty);
+	m_lastFrame = frame;
+}
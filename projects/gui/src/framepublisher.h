@@ -0,0 +1,81 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FRAMEPUBLISHER_H
+#define FRAMEPUBLISHER_H
+
+#include <QObject>
+#include <QImage>
+#include <QSharedMemory>
+
+class QTimer;
+class QWidget;
+
+/*!
+ * \brief Publishes a widget's frames into shared memory.
+ *
+ * The target widget is rendered into an off-screen image at a fixed
+ * rate and the result is written to a QSharedMemory segment, so
+ * capture tools (OBS scripts, stream overlays) can ingest the frames
+ * directly instead of screen-scraping through the compositor.
+ *
+ * Each frame is compared against the previous one; if nothing
+ * changed, nothing is published, so an idle widget costs no
+ * bandwidth. When pixels did change, only the dirty rows are copied
+ * into the segment and the dirty bounding rectangle is stored in the
+ * header, letting the consumer update incrementally.
+ *
+ * The segment starts with eleven quint32 fields - magic ('GWF1'),
+ * version, width, height, bytes per line, QImage format, frame
+ * counter, dirty x/y/width/height - followed by the pixel data. The
+ * frame counter changes with every published frame, and the segment
+ * is recreated when the widget is resized, which consumers detect
+ * from the header size fields. Readers should hold the segment's
+ * built-in lock while copying.
+ */
+class FramePublisher : public QObject
+{
+	Q_OBJECT
+
+	public:
+		/*!
+		 * Creates a publisher that renders \a target into the
+		 * shared memory segment \a key at \a frameRate frames
+		 * per second.
+		 */
+		FramePublisher(QWidget* target,
+			       const QString& key,
+			       int frameRate);
+		virtual ~FramePublisher();
+
+	private slots:
+		void publishFrame();
+
+	private:
+		QRect dirtyRect(const QImage& frame) const;
+		bool ensureSegment(int frameBytes);
+		void writeFrame(const QImage& frame, const QRect& dirty);
+
+		QWidget* m_target;
+		QTimer* m_timer;
+		QSharedMemory m_memory;
+		QImage m_lastFrame;
+		quint32 m_frameCounter;
+};
+
+#endif // FRAMEPUBLISHER_H
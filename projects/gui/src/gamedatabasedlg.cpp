@@ -24,13 +24,16 @@
 #include <QtAlgorithms>
 #include <QModelIndex>
 #include <QFileDialog>
+#include <QFutureWatcher>
 #include <QInputDialog>
 #include <QClipboard>
+#include <QtConcurrentRun>
 
 #include <pgnstream.h>
 #include <pgngame.h>
 #include <pgngameentry.h>
 #include <polyglotbook.h>
+#include <positionindex.h>
 
 #include "pgndatabasemodel.h"
 #include "pgngameentrymodel.h"
@@ -133,7 +136,7 @@ class BookExportTask : public ThreadedTask
 			       QWidget* parent);
 
 	protected:
-		virtual void run();
+		virtual void work();
 
 	private:
 		PgnGameIterator* m_it;
@@ -153,10 +156,9 @@ BookExportTask::BookExportTask(PgnGameIterator* it,
 	  m_file(file),
 	  m_depth(maxDepth)
 {
-	m_file->moveToThread(this);
 }
 
-void BookExportTask::run()
+void BookExportTask::work()
 {
 	QDataStream out(m_file);
 	PolyglotBook openingBook;
@@ -201,7 +203,7 @@ class PgnExportTask : public ThreadedTask
 			      QWidget* parent);
 
 	protected:
-		virtual void run();
+		virtual void work();
 
 	private:
 		PgnGameIterator* m_it;
@@ -218,10 +220,9 @@ PgnExportTask::PgnExportTask(PgnGameIterator* it,
 	  m_it(it),
 	  m_file(file)
 {
-	m_file->moveToThread(this);
 }
 
-void PgnExportTask::run()
+void PgnExportTask::work()
 {
 	QTextStream out(m_file);
 
@@ -312,6 +313,9 @@ GameDatabaseDialog::GameDatabaseDialog(GameDatabaseManager* dbManager, QWidget*
 		ui->m_copyGameBtn->setText(tr("Copy PGN"));
 	});
 
+	connect(ui->m_findPositionBtn, SIGNAL(clicked()),
+		this, SLOT(findCurrentPosition()));
+
 	connect(ui->m_copyFenBtn, SIGNAL(pressed()), this, SLOT(copyFen()));
 	connect(ui->m_copyFenBtn, &QPushButton::released, this, [=]()
 	{
@@ -352,6 +356,11 @@ GameDatabaseDialog::~GameDatabaseDialog()
 void GameDatabaseDialog::databaseSelectionChanged(const QItemSelection& selected,
                                                   const QItemSelection& deselected)
 {
+	// The cached games may belong to databases that are about to
+	// go away
+	m_gameCache.clear();
+	m_pendingPrefetches.clear();
+
 	const auto deselectedIndexes = deselected.indexes();
 	for (const QModelIndex& index : deselectedIndexes)
 		m_selectedDatabases.remove(index.row());
@@ -389,10 +398,13 @@ void GameDatabaseDialog::gameSelectionChanged(const QModelIndex& current,
 
 	PgnDatabase* selectedDatabase = m_dbManager->databases().at(databaseIndex);
 
-	PgnDatabase::Status status;
+	PgnDatabase::Status status = PgnDatabase::Ok;
 	const PgnGameEntry* entry = m_pgnGameEntryModel->entryAt(current.row());
 
-	if ((status = selectedDatabase->game(entry, &m_game)) != PgnDatabase::Ok)
+	const GameKey key(selectedDatabase, entry->pos());
+	if (m_gameCache.contains(key))
+		m_game = m_gameCache.value(key);
+	else if ((status = selectedDatabase->game(entry, &m_game)) != PgnDatabase::Ok)
 	{
 		if (status == PgnDatabase::DoesNotExist)
 		{
@@ -453,6 +465,77 @@ void GameDatabaseDialog::gameSelectionChanged(const QModelIndex& current,
 	ui->label_variant->setVisible(!ui->m_variantLabel->text().isEmpty());
 
 	m_gameViewer->setGame(&m_game);
+
+	prefetchAdjacentGames(current.row());
+}
+
+void GameDatabaseDialog::prefetchAdjacentGames(int row)
+{
+	// How many games to parse ahead on each side of the selection
+	const int radius = 4;
+
+	// The cache is tiny compared to the databases; just drop it
+	// when it grows past the point where stepping benefits from it
+	if (m_gameCache.size() > 256)
+		m_gameCache.clear();
+
+	for (int i = row - radius; i <= row + radius; i++)
+	{
+		if (i < 0 || i == row || i >= m_pgnGameEntryModel->rowCount())
+			continue;
+
+		int databaseIndex = databaseIndexFromGame(i);
+		if (databaseIndex == -1)
+			continue;
+
+		PgnDatabase* db = m_dbManager->databases().at(databaseIndex);
+		const PgnGameEntry* entry = m_pgnGameEntryModel->entryAt(i);
+
+		const GameKey key(db, entry->pos());
+		if (m_gameCache.contains(key)
+		||  m_pendingPrefetches.contains(key)
+		||  db->status() != PgnDatabase::Ok)
+			continue;
+
+		m_pendingPrefetches.insert(key);
+
+		// The worker opens its own file handle: PgnDatabase's
+		// stream isn't thread-safe and stays owned by this thread
+		const QString fileName = db->fileName();
+		const qint64 pos = entry->pos();
+		const qint64 lineNumber = entry->lineNumber();
+
+		auto watcher = new QFutureWatcher<PgnGame>(this);
+		connect(watcher, &QFutureWatcher<PgnGame>::finished,
+			this, [=]()
+		{
+			// An emptied pending set means the database
+			// selection changed; the result is stale
+			if (!m_pendingPrefetches.remove(key))
+			{
+				watcher->deleteLater();
+				return;
+			}
+
+			PgnGame game(watcher->result());
+			if (!game.isNull())
+				m_gameCache.insert(key, game);
+			watcher->deleteLater();
+		});
+		watcher->setFuture(QtConcurrent::run(
+			[fileName, pos, lineNumber]()
+		{
+			PgnGame game;
+			QFile file(fileName);
+			if (file.open(QIODevice::ReadOnly | QIODevice::Text))
+			{
+				PgnStream stream(&file);
+				if (stream.seek(pos, lineNumber))
+					game.read(stream);
+			}
+			return game;
+		}));
+	}
 }
 
 void GameDatabaseDialog::updateSearch(const QString& terms)
@@ -572,6 +655,48 @@ void GameDatabaseDialog::copyFen()
 	ui->m_copyFenBtn->setText(tr("Copied"));
 }
 
+void GameDatabaseDialog::findCurrentPosition()
+{
+	if (m_gameViewer->board() == nullptr)
+		return;
+
+	const quint64 key = m_gameViewer->board()->key();
+
+	QList<const PgnGameEntry*> found;
+	bool missingIndex = false;
+
+	for (PgnDatabase* db : qAsConst(m_selectedDatabases))
+	{
+		PositionIndex* index = db->positionIndex();
+		if (index == nullptr)
+		{
+			missingIndex = true;
+			continue;
+		}
+
+		const auto entries = db->entries();
+		const auto gameIds = index->find(key);
+		for (int id : gameIds)
+		{
+			if (id >= 0 && id < entries.count())
+				found << entries.at(id);
+		}
+	}
+
+	if (missingIndex)
+		QMessageBox::information(this, tr("Find Position"),
+			tr("Some of the selected databases have no position "
+			   "index. Set \"ui/position_index_interval\" in the "
+			   "configuration file and import them again to "
+			   "include them in the search."));
+
+	// Selecting the databases again restores the full game list
+	ui->m_searchEdit->setText(tr("[Position search]"));
+	ui->m_searchEdit->setEnabled(false);
+	m_pgnGameEntryModel->setEntries(found);
+	ui->m_clearBtn->setEnabled(true);
+}
+
 void GameDatabaseDialog::updateUi()
 {
 	bool enable = m_pgnGameEntryModel->rowCount() > 0;
@@ -579,6 +704,7 @@ void GameDatabaseDialog::updateUi()
 	ui->m_exportBtn->setEnabled(enable);
 	ui->m_copyGameBtn->setEnabled(enable);
 	ui->m_copyFenBtn->setEnabled(enable);
+	ui->m_findPositionBtn->setEnabled(enable);
 }
 
 #include "gamedatabasedlg.moc"
@@ -22,6 +22,9 @@
 #include <QDialog>
 #include <QTimer>
 #include <QItemSelection>
+#include <QHash>
+#include <QSet>
+#include <QPair>
 
 #include <pgngame.h>
 
@@ -63,11 +66,17 @@ class GameDatabaseDialog : public QDialog
 		void createOpeningBook();
 		void copyGame();
 		void copyFen();
+		void findCurrentPosition();
 		void updateUi();
 
 	private:
 		friend class PgnGameIterator;
+		// A parsed game's identity: the database it lives in and
+		// its seek position in the file
+		typedef QPair<PgnDatabase*, qint64> GameKey;
+
 		int databaseIndexFromGame(int game) const;
+		void prefetchAdjacentGames(int row);
 
 		GameViewer* m_gameViewer;
 		PgnGame m_game;
@@ -78,6 +87,11 @@ class GameDatabaseDialog : public QDialog
 		PgnGameEntryModel* m_pgnGameEntryModel;
 		QMap<int, PgnDatabase*> m_selectedDatabases;
 
+		// Games parsed ahead of time around the selection, so
+		// stepping through the list doesn't pay parse latency
+		QHash<GameKey, PgnGame> m_gameCache;
+		QSet<GameKey> m_pendingPrefetches;
+
 		QTimer m_searchTimer;
 		QString m_searchTerms;
 		Ui::GameDatabaseDialog* ui;
@@ -20,6 +20,8 @@
 
 #include <QFileInfo>
 #include <QDataStream>
+#include <QSaveFile>
+#include <QSettings>
 #include <QThreadPool>
 
 #include <pgngameentry.h>
@@ -30,11 +32,13 @@
 #include "cutechessapp.h"
 
 #define GAME_DATABASE_STATE_MAGIC   0xDEADD00D
-#define GAME_DATABASE_STATE_VERSION 1
+#define GAME_DATABASE_STATE_VERSION 4
 
 GameDatabaseManager::GameDatabaseManager(QObject* parent)
 	: QObject(parent),
-	  m_modified(false)
+	  m_modified(false),
+	  m_savedDatabaseCount(0),
+	  m_canAppend(false)
 {
 }
 
@@ -43,16 +47,38 @@ GameDatabaseManager::~GameDatabaseManager()
 	qDeleteAll(m_databases);
 }
 
-QList<PgnDatabase*> GameDatabaseManager::databases() const
+QList<PgnDatabase*> GameDatabaseManager::databases()
 {
+	ensureStateRead();
 	return m_databases;
 }
 
+void GameDatabaseManager::setStateFile(const QString& fileName)
+{
+	m_pendingStateFile = fileName;
+}
+
+void GameDatabaseManager::ensureStateRead()
+{
+	if (m_pendingStateFile.isEmpty())
+		return;
+
+	// Clear the name before reading: readState() ends with a
+	// databasesReset() signal whose receivers typically query
+	// databases() again.
+	const QString fileName = m_pendingStateFile;
+	m_pendingStateFile.clear();
+	readState(fileName);
+}
+
 bool GameDatabaseManager::writeState(const QString& fileName)
 {
-	QFile stateFile(fileName);
+	// Write to a temporary file and rename it into place so that
+	// entries still referencing a mapping of the old state file
+	// stay valid until the mapping goes away.
+	QSaveFile stateFile(fileName);
 
-	if (!stateFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+	if (!stateFile.open(QIODevice::WriteOnly))
 		return false;
 
 	QDataStream out(&stateFile);
@@ -71,26 +97,121 @@ bool GameDatabaseManager::writeState(const QString& fileName)
 		out << db->fileName();
 		out << db->lastModified();
 		out << db->displayName();
+		out << db->indexedSize();
+		out << db->prefixChecksum();
 		out << (qint32)db->entries().count();
 
 		const auto entries = db->entries();
 		for (const PgnGameEntry* entry : entries)
-			entry->write(out);
+			entry->writeIndex(out);
 	}
 
+	if (!stateFile.commit())
+		return false;
+
 	m_modified = false;
+	m_savedDatabaseCount = m_databases.count();
+	m_canAppend = true;
 
 	return true;
 }
 
-bool GameDatabaseManager::readState(const QString& fileName)
+bool GameDatabaseManager::saveState(const QString& fileName)
+{
+	ensureStateRead();
+
+	if (m_canAppend
+	&&  m_savedDatabaseCount <= m_databases.count()
+	&&  QFileInfo(fileName).exists())
+	{
+		// Nothing changed since the last save
+		if (m_savedDatabaseCount == m_databases.count())
+		{
+			m_modified = false;
+			return true;
+		}
+
+		if (appendState(fileName))
+			return true;
+	}
+
+	return writeState(fileName);
+}
+
+bool GameDatabaseManager::appendState(const QString& fileName)
 {
 	QFile stateFile(fileName);
 
-	if (!stateFile.open(QIODevice::ReadOnly))
+	if (!stateFile.open(QIODevice::ReadWrite))
 		return false;
+	if (!stateFile.seek(stateFile.size()))
+		return false;
+
+	QDataStream out(&stateFile);
+	out.setVersion(QDataStream::Qt_4_6); // don't change
+
+	// Append only the databases that aren't in the file yet
+	for (int i = m_savedDatabaseCount; i < m_databases.count(); i++)
+	{
+		const PgnDatabase* db = m_databases.at(i);
+
+		out << db->fileName();
+		out << db->lastModified();
+		out << db->displayName();
+		out << db->indexedSize();
+		out << db->prefixChecksum();
+		out << (qint32)db->entries().count();
 
-	QDataStream in(&stateFile);
+		const auto entries = db->entries();
+		for (const PgnGameEntry* entry : entries)
+			entry->writeIndex(out);
+	}
+
+	// The database count is patched last, right after the magic
+	// and version numbers: a crash mid-append then leaves trailing
+	// bytes that the reader never looks at instead of a truncated
+	// record inside the counted region.
+	if (!stateFile.seek(8))
+		return false;
+	out << (qint32)m_databases.count();
+
+	if (out.status() != QDataStream::Ok)
+		return false;
+
+	m_modified = false;
+	m_savedDatabaseCount = m_databases.count();
+
+	return true;
+}
+
+bool GameDatabaseManager::readState(const QString& fileName)
+{
+	// An explicit read supersedes a deferred one
+	m_pendingStateFile.clear();
+
+	// The file is parented to the manager and kept open for the
+	// lifetime of the application: the entries reference the
+	// mapping directly instead of copying their tag data, which
+	// keeps startup fast and memory flat for large databases.
+	QFile* stateFile = new QFile(fileName, this);
+
+	if (!stateFile->open(QIODevice::ReadOnly))
+	{
+		delete stateFile;
+		return false;
+	}
+
+	const qint64 stateFileSize = stateFile->size();
+	uchar* mapped = stateFile->map(0, stateFileSize);
+	if (mapped == nullptr)
+	{
+		qWarning("GameDatabaseManager: cannot map state file");
+		delete stateFile;
+		return false;
+	}
+	const char* indexData = reinterpret_cast<const char*>(mapped);
+
+	QDataStream in(stateFile);
 	in.setVersion(QDataStream::Qt_4_6); // don't change
 
 	// Read and verify the magic value
@@ -100,6 +221,7 @@ bool GameDatabaseManager::readState(const QString& fileName)
 	if (magic != GAME_DATABASE_STATE_MAGIC)
 	{
 		qWarning("GameDatabaseManager: bad magic value in state file");
+		delete stateFile;
 		return false;
 	}
 
@@ -112,6 +234,7 @@ bool GameDatabaseManager::readState(const QString& fileName)
 	{
 		// TODO: Add backward compatibility
 		qWarning("GameDatabaseManager: state file version mismatch");
+		delete stateFile;
 		return false;
 	}
 
@@ -123,51 +246,103 @@ bool GameDatabaseManager::readState(const QString& fileName)
 	QString dbFileName;
 	QDateTime dbLastModified;
 	QString dbDisplayName;
+	qint64 dbIndexedSize;
+	quint16 dbChecksum;
 	QList<PgnDatabase*> readDatabases;
+	bool allKept = true;
 
 	for (int i = 0; i < dbCount; i++)
 	{
 		in >> dbFileName;
 		in >> dbLastModified;
 		in >> dbDisplayName;
+		in >> dbIndexedSize;
+		in >> dbChecksum;
+
+		qint32 dbEntryCount;
+		in >> dbEntryCount;
+
+		// Slice the entries straight out of the mapping. The
+		// records must be walked even if the database is then
+		// discarded, to find where the next one begins.
+		qint64 offset = stateFile->pos();
+		QList<const PgnGameEntry*> entries;
+		bool entriesOk = true;
+
+		for (int j = 0; j < dbEntryCount; j++)
+		{
+			PgnGameEntry* entry = new PgnGameEntry;
+			qint64 recordSize = entry->readIndex(
+			    indexData + offset, stateFileSize - offset);
+			if (recordSize < 0)
+			{
+				delete entry;
+				entriesOk = false;
+				break;
+			}
+
+			offset += recordSize;
+			entries << entry;
+		}
+
+		if (!entriesOk || !stateFile->seek(offset))
+		{
+			qWarning("GameDatabaseManager: corrupt state file");
+			qDeleteAll(entries);
+			delete stateFile;
+			return false;
+		}
 
 		// Check if the database exists
 		QFileInfo fileInfo(dbFileName);
 		if (!fileInfo.exists())
 		{
+			qDeleteAll(entries);
 			m_modified = true;
+			allKept = false;
 			continue;
 		}
 
 		// Check if the database has been modified
+		bool importTail = false;
 		if (fileInfo.lastModified() > dbLastModified)
 		{
-			m_modified = true;
-			importPgnFile(dbFileName);
-			continue;
-		}
-
-		qint32 dbEntryCount;
-		in >> dbEntryCount;
-
-		// Read the entries
-		QList<const PgnGameEntry*> entries;
-		for (int j = 0; j < dbEntryCount; j++)
-		{
-			PgnGameEntry* entry = new PgnGameEntry;
-			entry->read(in);
-			entries << entry;
+			// If the file has only grown, the indexed prefix
+			// and the stored entries are still valid: keep
+			// them and scan just the appended tail. Anything
+			// else gets a full re-import.
+			importTail = canImportTail(entries, dbIndexedSize,
+						   dbChecksum, fileInfo);
+			if (!importTail)
+			{
+				qDeleteAll(entries);
+				m_modified = true;
+				allKept = false;
+				importPgnFile(dbFileName);
+				continue;
+			}
 		}
 
 		PgnDatabase* db = new PgnDatabase(dbFileName);
 		db->setEntries(entries);
 		db->setLastModified(dbLastModified);
 		db->setDisplayName(dbDisplayName);
+		db->setIndexedSize(dbIndexedSize);
+		db->setPrefixChecksum(dbChecksum);
+
+		for (const PgnGameEntry* entry : qAsConst(entries))
+			m_gameHashes.insert(entry->hash());
 
 		readDatabases << db;
+		if (importTail)
+			importPgnTail(db);
 	}
 
 	m_modified = false;
+	// New databases can be appended to the file only if it still
+	// matches the loaded list exactly
+	m_savedDatabaseCount = allKept ? readDatabases.count() : 0;
+	m_canAppend = allKept;
 
 	m_databases = readDatabases;
 	emit databasesReset();
@@ -177,7 +352,13 @@ bool GameDatabaseManager::readState(const QString& fileName)
 
 void GameDatabaseManager::importPgnFile(const QString& fileName)
 {
-	PgnImporter* pgnImporter = new PgnImporter(fileName);
+	// The importer needs the stored game hashes for duplicate
+	// detection
+	ensureStateRead();
+
+	PgnImporter* pgnImporter = new PgnImporter(fileName, m_gameHashes);
+	pgnImporter->setPositionIndexInterval(
+		QSettings().value("ui/position_index_interval", 0).toInt());
 	connect(pgnImporter, SIGNAL(databaseRead(PgnDatabase*)),
 		this, SLOT(addDatabase(PgnDatabase*)));
 
@@ -189,8 +370,94 @@ void GameDatabaseManager::importPgnFile(const QString& fileName)
 	QThreadPool::globalInstance()->start(pgnImporter);
 }
 
+bool GameDatabaseManager::canImportTail(const QList<const PgnGameEntry*>& entries,
+					qint64 indexedSize,
+					quint16 checksum,
+					const QFileInfo& fileInfo) const
+{
+	// A tail import doesn't update the position index, so indexed
+	// databases always get the full treatment
+	if (QSettings().value("ui/position_index_interval", 0).toInt() > 0)
+		return false;
+
+	if (entries.isEmpty() || indexedSize <= 0 || checksum == 0)
+		return false;
+
+	// The file must have grown and the end of the indexed prefix
+	// must be unchanged; the checksum doesn't cover the whole
+	// prefix, but an in-place rewrite that grows the file and still
+	// ends the old range with the same bytes is not a realistic
+	// way for a PGN collection to change
+	if (fileInfo.size() <= indexedSize)
+		return false;
+
+	return PgnDatabase::computePrefixChecksum(fileInfo.absoluteFilePath(),
+						  indexedSize) == checksum;
+}
+
+void GameDatabaseManager::importPgnTail(PgnDatabase* database)
+{
+	// Rescan from the start of the last known game: its hash is in
+	// m_gameHashes so it's dropped as a duplicate, and a game the
+	// file ended in the middle of last time is picked up whole
+	const PgnGameEntry* last = database->entries().last();
+
+	PgnImporter* pgnImporter = new PgnImporter(database->fileName(),
+						   m_gameHashes);
+	pgnImporter->setStartPosition(last->pos(), last->lineNumber());
+	connect(pgnImporter, SIGNAL(databaseRead(PgnDatabase*)),
+		this, SLOT(mergeDatabaseTail(PgnDatabase*)));
+
+	// The scan is bounded by the appended data, so there's no
+	// progress dialog to dismiss for a routine refresh
+	QThreadPool::globalInstance()->start(pgnImporter);
+}
+
+void GameDatabaseManager::mergeDatabaseTail(PgnDatabase* database)
+{
+	// Find the database the tail belongs to; it may have been
+	// removed while the import was running
+	PgnDatabase* target = nullptr;
+	for (PgnDatabase* db : qAsConst(m_databases))
+	{
+		if (db->fileName() == database->fileName())
+		{
+			target = db;
+			break;
+		}
+	}
+	if (target == nullptr)
+	{
+		delete database;
+		return;
+	}
+
+	const auto entries = database->takeEntries();
+	for (const PgnGameEntry* entry : entries)
+		m_gameHashes.insert(entry->hash());
+
+	target->appendEntries(entries);
+	target->setLastModified(database->lastModified());
+	target->setIndexedSize(database->indexedSize());
+	target->setPrefixChecksum(database->prefixChecksum());
+	delete database;
+
+	// The entries of an already-saved database changed, so the
+	// next save must rewrite the state file
+	setModified(true);
+	emit databasesReset();
+}
+
 void GameDatabaseManager::addDatabase(PgnDatabase* database)
 {
+	// A new database must land after the stored ones, not replace
+	// them in the next save
+	ensureStateRead();
+
+	const auto entries = database->entries();
+	for (const PgnGameEntry* entry : entries)
+		m_gameHashes.insert(entry->hash());
+
 	m_databases << database;
 	m_modified = true;
 	emit databaseAdded(m_databases.count() - 1);
@@ -198,9 +465,22 @@ void GameDatabaseManager::addDatabase(PgnDatabase* database)
 
 void GameDatabaseManager::removeDatabase(int index)
 {
+	ensureStateRead();
+
 	emit databaseAboutToBeRemoved(index);
 	m_databases.removeAt(index);
 	m_modified = true;
+	m_canAppend = false;
+
+	// Rebuild the hash set so that the removed database's games
+	// aren't skipped if they're imported again
+	m_gameHashes.clear();
+	for (const PgnDatabase* db : qAsConst(m_databases))
+	{
+		const auto entries = db->entries();
+		for (const PgnGameEntry* entry : entries)
+			m_gameHashes.insert(entry->hash());
+	}
 }
 
 void GameDatabaseManager::importDatabaseAgain(int index)
@@ -219,4 +499,8 @@ bool GameDatabaseManager::isModified() const
 void GameDatabaseManager::setModified(bool modified)
 {
 	m_modified = modified;
+	// Changes to already-saved databases (eg. renames) can't be
+	// appended, so force a full rewrite on the next save
+	if (modified)
+		m_canAppend = false;
 }
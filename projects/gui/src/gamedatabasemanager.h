@@ -21,9 +21,12 @@
 
 #include <QObject>
 #include <QList>
+#include <QSet>
 
+class QFileInfo;
 class PgnImporter;
 class PgnDatabase;
+class PgnGameEntry;
 
 /*!
  * \brief Manages chess game databases.
@@ -43,7 +46,7 @@ class GameDatabaseManager : public QObject
 		/*!
 		 * Returns the list of currently managed databases.
 		 */
-		QList<PgnDatabase*> databases() const;
+		QList<PgnDatabase*> databases();
 
 		/*!
 		 * Writes the state to a file pointed by \a fileName.
@@ -51,12 +54,36 @@ class GameDatabaseManager : public QObject
 		 * \sa readState
 		 */
 		bool writeState(const QString& fileName);
+		/*!
+		 * Saves the state to a file pointed by \a fileName.
+		 *
+		 * If only new databases were added since the state was
+		 * last read or written, their records are appended to
+		 * the existing file; otherwise the whole state is
+		 * rewritten with writeState(). Appending keeps the cost
+		 * of saving proportional to the new entries instead of
+		 * the whole collection.
+		 *
+		 * \sa writeState
+		 */
+		bool saveState(const QString& fileName);
 		/*!
 		 * Reads the state from a file pointed by \a fileName.
 		 *
 		 * \sa writeState
 		 */
 		bool readState(const QString& fileName);
+		/*!
+		 * Points the manager at the state file \a fileName without
+		 * reading it.
+		 *
+		 * The state is read lazily when the databases are first
+		 * accessed, so application startup doesn't pay for the
+		 * size of the stored collections.
+		 *
+		 * \sa readState
+		 */
+		void setStateFile(const QString& fileName);
 
 		/*! Returns true if the current state has been modified. */
 		bool isModified() const;
@@ -108,10 +135,39 @@ class GameDatabaseManager : public QObject
 		 */
 		void databasesReset();
 
+	private slots:
+		// Merges the entries of \a database, read by a tail
+		// import, into the managed database of the same file
+		void mergeDatabaseTail(PgnDatabase* database);
+
 	private:
+		bool appendState(const QString& fileName);
+		// Performs the state read deferred by setStateFile()
+		void ensureStateRead();
+		// Returns true if a database whose stored state is
+		// \a entries, \a indexedSize and \a checksum can be
+		// refreshed by scanning only the tail of the file
+		// described by \a fileInfo
+		bool canImportTail(const QList<const PgnGameEntry*>& entries,
+				   qint64 indexedSize,
+				   quint16 checksum,
+				   const QFileInfo& fileInfo) const;
+		// Starts a tail import for \a database, scanning the
+		// file from the start of its last known game
+		void importPgnTail(PgnDatabase* database);
+
+		// The state file set with setStateFile() that hasn't been
+		// read yet
+		QString m_pendingStateFile;
 		QList<PgnDatabase*> m_databases;
+		// Hashes of every game in m_databases, used to skip
+		// duplicates when importing overlapping collections
+		QSet<quint64> m_gameHashes;
 		bool m_modified;
-
+		// How many of m_databases the state file already holds,
+		// and whether it still matches them exactly
+		int m_savedDatabaseCount;
+		bool m_canAppend;
 };
 
 #endif // GAME_DATABASE_MANAGER_H
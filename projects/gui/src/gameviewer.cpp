@@ -21,6 +21,7 @@
 #include <QVBoxLayout>
 #include <QToolButton>
 #include <QSlider>
+#include <QTimer>
 #include <QMessageBox>
 #include <pgngame.h>
 #include <chessgame.h>
@@ -38,8 +39,16 @@ GameViewer::GameViewer(Qt::Orientation orientation,
 	  m_viewPreviousMoveBtn(new QToolButton),
 	  m_viewNextMoveBtn(new QToolButton),
 	  m_viewLastMoveBtn(new QToolButton),
-	  m_moveIndex(0)
+	  m_moveIndex(0),
+	  m_replayTimer(new QTimer(this))
 {
+	// Replays a loaded game toward its final position in small
+	// batches between event loop iterations, so opening a long
+	// game never blocks the UI
+	m_replayTimer->setInterval(0);
+	connect(m_replayTimer, SIGNAL(timeout()),
+		this, SLOT(streamNextMoves()));
+
 	#ifdef Q_OS_MAC
 	setStyleSheet("QToolButton:!hover { border: none; }");
 	#endif
@@ -200,7 +209,19 @@ void GameViewer::setGame(const PgnGame* pgn)
 	m_moveNumberSlider->setMaximum(m_moves.count());
 	m_moveNumberSlider->setValue(0);
 
-	viewLastMove();
+	// Show the starting position right away and stream the rest
+	// of the game in; user navigation cancels the streaming
+	if (!m_moves.isEmpty())
+		m_replayTimer->start();
+}
+
+void GameViewer::streamNextMoves()
+{
+	for (int i = 0; i < 16 && m_moveIndex < m_moves.count(); i++)
+		viewNextMove();
+
+	if (m_moveIndex >= m_moves.count())
+		m_replayTimer->stop();
 }
 
 void GameViewer::disconnectGame()
@@ -235,6 +256,7 @@ BoardScene* GameViewer::boardScene() const
 
 void GameViewer::viewFirstMoveClicked()
 {
+	m_replayTimer->stop();
 	viewFirstMove();
 	emit moveSelected(m_moveIndex - 1);
 }
@@ -247,6 +269,7 @@ void GameViewer::viewFirstMove()
 
 void GameViewer::viewPreviousMoveClicked()
 {
+	m_replayTimer->stop();
 	viewPreviousMove();
 	emit moveSelected(m_moveIndex - 1);
 }
@@ -272,6 +295,7 @@ void GameViewer::viewPreviousMove()
 
 void GameViewer::viewNextMoveClicked()
 {
+	m_replayTimer->stop();
 	viewNextMove();
 	emit moveSelected(m_moveIndex - 1);
 }
@@ -298,6 +322,7 @@ void GameViewer::viewNextMove()
 
 void GameViewer::viewLastMoveClicked()
 {
+	m_replayTimer->stop();
 	viewLastMove();
 	emit moveSelected(m_moveIndex - 1);
 }
@@ -319,6 +344,11 @@ void GameViewer::viewPosition(int index)
 	if (m_moves.isEmpty())
 		return;
 
+	// Slider positions set by the streaming replay arrive here
+	// too, but they match m_moveIndex and fall through the loops
+	if (index != m_moveIndex)
+		m_replayTimer->stop();
+
 	while (index < m_moveIndex)
 		viewPreviousMove();
 	while (index > m_moveIndex)
@@ -330,6 +360,8 @@ void GameViewer::viewMove(int index, bool keyLeft)
 	Q_ASSERT(index >= 0);
 	Q_ASSERT(!m_moves.isEmpty());
 
+	m_replayTimer->stop();
+
 	if (keyLeft && index == m_moveIndex - 2)
 		viewPreviousMove();
 	else if (index < m_moveIndex)
@@ -349,6 +381,7 @@ void GameViewer::viewMove(int index, bool keyLeft)
 
 void GameViewer::onFenChanged(const QString& fen)
 {
+	m_replayTimer->stop();
 	m_moves.clear();
 	m_moveIndex = 0;
 
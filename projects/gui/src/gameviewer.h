@@ -26,6 +26,7 @@
 #include <board/genericmove.h>
 class QToolButton;
 class QSlider;
+class QTimer;
 class ChessGame;
 class PgnGame;
 class BoardScene;
@@ -67,6 +68,7 @@ class GameViewer : public QWidget
 
 		void onFenChanged(const QString& fen);
 		void onMoveMade(const Chess::GenericMove& move);
+		void streamNextMoves();
 
 	private:
 		void viewFirstMove();
@@ -88,6 +90,7 @@ class GameViewer : public QWidget
 		QPointer<ChessGame> m_game;
 		QVector<Chess::GenericMove> m_moves;
 		int m_moveIndex;
+		QTimer* m_replayTimer;
 };
 
 #endif // GAMEVIEWER_H
@@ -19,6 +19,7 @@
 #include "gamewall.h"
 
 #include <QPointer>
+#include <QTimer>
 
 #include <chessplayer.h>
 #include <chessgame.h>
@@ -40,16 +41,28 @@ class GameWallWidget : public QWidget
 		virtual ~GameWallWidget();
 
 		void setGame(ChessGame* game);
+		void flushUpdates();
+
+	signals:
+		void updateNeeded();
+
+	private slots:
+		void onFenChanged(const QString& fen);
+		void onMoveMade(const Chess::GenericMove& move);
 
 	private:
 		ChessClock* m_clocks[2];
 		BoardScene* m_scene;
 		BoardView* m_view;
 		QPointer<ChessPlayer> m_players[2];
+		QList<Chess::GenericMove> m_pendingMoves;
+		QString m_pendingFen;
+		bool m_hasPendingFen;
 };
 
 GameWallWidget::GameWallWidget(QWidget* parent)
-	: QWidget(parent)
+	: QWidget(parent),
+	  m_hasPendingFen(false)
 {
 	QHBoxLayout* clockLayout = new QHBoxLayout();
 	for (int i = 0; i < 2; i++)
@@ -65,6 +78,9 @@ GameWallWidget::GameWallWidget(QWidget* parent)
 	clockLayout->insertSpacing(1, 20);
 
 	m_scene = new BoardScene(this);
+	// With dozens of boards on screen the move animations are the
+	// biggest repaint cost, so wall tiles skip them
+	m_scene->setAnimationDuration(0);
 	m_view = new BoardView(m_scene);
 
 	QVBoxLayout* mainLayout = new QVBoxLayout();
@@ -81,11 +97,17 @@ GameWallWidget::~GameWallWidget()
 
 void GameWallWidget::setGame(ChessGame* game)
 {
+	m_pendingMoves.clear();
+	m_hasPendingFen = false;
+
 	game->lockThread();
+	// Moves and FEN changes are buffered and applied by the wall's
+	// shared update timer, so a burst of moves from many concurrent
+	// games becomes one repaint per tile per frame
 	connect(game, SIGNAL(fenChanged(QString)),
-		m_scene, SLOT(setFenString(QString)));
+		this, SLOT(onFenChanged(QString)));
 	connect(game, SIGNAL(moveMade(Chess::GenericMove, QString, QString)),
-		m_scene, SLOT(makeMove(Chess::GenericMove)));
+		this, SLOT(onMoveMade(Chess::GenericMove)));
 	connect(game, SIGNAL(humanEnabled(bool)),
 		m_view, SLOT(setEnabled(bool)));
 	connect(game, SIGNAL(finished(ChessGame*, Chess::Result)),
@@ -135,6 +157,35 @@ void GameWallWidget::setGame(ChessGame* game)
 			   game->playerToMove()->isHuman());
 }
 
+void GameWallWidget::flushUpdates()
+{
+	if (m_hasPendingFen)
+	{
+		m_scene->setFenString(m_pendingFen);
+		m_hasPendingFen = false;
+	}
+
+	for (const Chess::GenericMove& move : m_pendingMoves)
+		m_scene->makeMove(move);
+	m_pendingMoves.clear();
+}
+
+void GameWallWidget::onFenChanged(const QString& fen)
+{
+	m_pendingFen = fen;
+	m_hasPendingFen = true;
+	m_pendingMoves.clear();
+
+	emit updateNeeded();
+}
+
+void GameWallWidget::onMoveMade(const Chess::GenericMove& move)
+{
+	m_pendingMoves.append(move);
+
+	emit updateNeeded();
+}
+
 
 GameWall::GameWall(GameManager* manager, QWidget *parent)
 	: QWidget(parent)
@@ -143,6 +194,14 @@ GameWall::GameWall(GameManager* manager, QWidget *parent)
 
 	setLayout(new TileLayout());
 
+	// All tiles share one timer that caps the wall's repaint rate;
+	// each timeout applies every buffered move at once
+	m_updateTimer = new QTimer(this);
+	m_updateTimer->setSingleShot(true);
+	m_updateTimer->setInterval(100);
+	connect(m_updateTimer, SIGNAL(timeout()),
+		this, SLOT(onUpdateTimeout()));
+
 	const auto activeGames = manager->activeGames();
 	for (ChessGame* game : activeGames)
 	{
@@ -163,10 +222,24 @@ GameWallWidget* GameWall::getFreeWidget()
 
 	auto widget = new GameWallWidget(this);
 	layout()->addWidget(widget);
+	connect(widget, SIGNAL(updateNeeded()),
+		this, SLOT(onUpdateNeeded()));
 
 	return widget;
 }
 
+void GameWall::onUpdateNeeded()
+{
+	if (!m_updateTimer->isActive())
+		m_updateTimer->start();
+}
+
+void GameWall::onUpdateTimeout()
+{
+	for (GameWallWidget* widget : m_games)
+		widget->flushUpdates();
+}
+
 void GameWall::addGame(ChessGame* game)
 {
 	Q_ASSERT(game != nullptr);
@@ -23,6 +23,7 @@
 #include <QMap>
 #include <QList>
 
+class QTimer;
 class ChessGame;
 class GameManager;
 class GameWallWidget;
@@ -39,11 +40,16 @@ class GameWall : public QWidget
 		void addGame(ChessGame* game);
 		void removeGame(ChessGame* game);
 
+	private slots:
+		void onUpdateNeeded();
+		void onUpdateTimeout();
+
 	private:
 		GameWallWidget* getFreeWidget();
 
 		QMap<ChessGame*, GameWallWidget*> m_games;
 		QList<GameWallWidget*> m_gamesToRemove;
+		QTimer* m_updateTimer;
 };
 
 #endif // GAMEWALL_H
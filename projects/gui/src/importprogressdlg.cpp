@@ -21,10 +21,14 @@
 #include "pgnimporter.h"
 
 #include <QFileInfo>
+#include <QTime>
+#include <QTimer>
 
 ImportProgressDialog::ImportProgressDialog(PgnImporter* pgnImporter,
 					   QWidget* parent)
 	: QDialog(parent),
+	  m_pgnImporter(pgnImporter),
+	  m_updateTimer(new QTimer(this)),
 	  m_lastUpdateSecs(0),
 	  m_importError(false),
 	  ui(new Ui::ImportProgressDialog)
@@ -46,8 +50,13 @@ ImportProgressDialog::ImportProgressDialog(PgnImporter* pgnImporter,
 		SLOT(onImporterFinished()));
 	connect(pgnImporter, SIGNAL(error(int)), this,
 		SLOT(onImportError(int)));
-	connect(pgnImporter, SIGNAL(databaseReadStatus(const QTime&, int, qint64)),
-		this, SLOT(updateImportStatus(const QTime&, int, qint64)));
+
+	// The importer threads just bump atomic counters; the dialog
+	// samples them on a timer so progress reporting costs the
+	// import nothing
+	connect(m_updateTimer, SIGNAL(timeout()), this,
+		SLOT(updateImportStatus()));
+	m_updateTimer->start(100);
 }
 
 ImportProgressDialog::~ImportProgressDialog()
@@ -55,31 +64,35 @@ ImportProgressDialog::~ImportProgressDialog()
 	delete ui;
 }
 
-void ImportProgressDialog::updateImportStatus(const QTime& startTime,
-                                             int numReadGames, qint64 numReadBytes)
+void ImportProgressDialog::updateImportStatus()
 {
-	int elapsed = startTime.secsTo(QTime::currentTime());
-	if (elapsed == 0)
+	const qint64 numReadBytes = m_pgnImporter->numReadBytes();
+
+	ui->m_importProgressBar->setMinimum(0);
+	ui->m_importProgressBar->setMaximum(100);
+	ui->m_importProgressBar->setValue(int((double(numReadBytes) / m_totalFileSize) * 100));
+
+	int elapsed = m_pgnImporter->startTime().secsTo(QTime::currentTime());
+	if (elapsed == 0 || numReadBytes == 0)
 		return;
 
-	// Update the status once a second
+	// Update the status text once a second
 	if (elapsed <= m_lastUpdateSecs)
 		return;
 
 	m_lastUpdateSecs = elapsed;
 
-	ui->m_importProgressBar->setMinimum(0);
-	ui->m_importProgressBar->setMaximum(100);
-	ui->m_importProgressBar->setValue(int((double(numReadBytes) / m_totalFileSize) * 100));
-
 	int remainingSecs = (m_totalFileSize - numReadBytes) / (numReadBytes / elapsed);
 
-	ui->m_statusLabel->setText(QString(tr("%1 games/sec - %2")).arg((int)numReadGames / elapsed)
+	ui->m_statusLabel->setText(QString(tr("%1 games/sec - %2"))
+	    .arg(m_pgnImporter->numReadGames() / elapsed)
 	    .arg(humaniseTime(remainingSecs)));
 }
 
 void ImportProgressDialog::onImporterFinished()
 {
+	m_updateTimer->stop();
+
 	if (!m_importError)
 		accept();  // close the dialog automatically if no error occured
 }
@@ -87,6 +100,7 @@ void ImportProgressDialog::onImporterFinished()
 void ImportProgressDialog::onImportError(int error)
 {
 	m_importError = true;
+	m_updateTimer->stop();
 	setWindowTitle(tr("Import failed"));
 
 	switch (error)
@@ -21,6 +21,7 @@
 
 #include <QDialog>
 
+class QTimer;
 class PgnImporter;
 
 namespace Ui {
@@ -46,10 +47,13 @@ class ImportProgressDialog : public QDialog
 	private slots:
 		void onImporterFinished();
 		void onImportError(int error);
-		void updateImportStatus(const QTime& startTime, int numReadGames, qint64 numReadBytes);
+		// Samples the importer's progress counters
+		void updateImportStatus();
 
 	private:
 		QString humaniseTime(int sec);
+		PgnImporter* m_pgnImporter;
+		QTimer* m_updateTimer;
 		qint64 m_totalFileSize;
 		int m_lastUpdateSecs;
 		bool m_importError;
@@ -38,6 +38,7 @@ int main(int argc, char* argv[])
 	qRegisterMetaType<Chess::Side>("Chess::Side");
 	qRegisterMetaType<Chess::Result>("Chess::Result");
 	qRegisterMetaType<MoveEvaluation>("MoveEvaluation");
+	qRegisterMetaType<QVector<MoveEvaluation>>("QVector<MoveEvaluation>");
 
 	QLoggingCategory::defaultCategory()->setEnabled(QtDebugMsg, true);
 
@@ -589,7 +589,7 @@ void MainWindow::setCurrentGame(const TabData& gameData)
 		m_players[i] = player;
 
 		connect(player, SIGNAL(debugMessage(QString)),
-			m_engineDebugLog, SLOT(appendPlainText(QString)));
+			m_engineDebugLog, SLOT(appendLine(QString)));
 
 		auto clock = m_gameViewer->chessClock(side);
 
@@ -791,7 +791,7 @@ void MainWindow::newTournament()
 	connect(t, SIGNAL(gameStarted(ChessGame*, int, int, int)),
 		this, SLOT(addGame(ChessGame*)));
 	connect(t, SIGNAL(gameFinished(ChessGame*, int, int, int)),
-		resultsDialog, SLOT(update()));
+		resultsDialog, SLOT(update(ChessGame*, int, int, int)));
 	connect(t, SIGNAL(gameFinished(ChessGame*, int, int, int)),
 		this, SLOT(onGameFinished(ChessGame*)));
 	t->start();
@@ -953,11 +953,12 @@ void MainWindow::editMoveComment(int ply, const QString& comment)
 		lockCurrentGame();
 		PgnGame* pgn(m_tabs.at(m_tabBar->currentIndex()).m_pgn);
 		PgnGame::MoveData md(pgn->moves().at(ply));
-		md.comment = text;
+		md.comment = text.toUtf8();
 		pgn->setMove(ply, md);
 		unlockCurrentGame();
 
-		m_moveList->setMove(ply, md.move, md.moveString, text);
+		m_moveList->setMove(ply, md.move,
+				    QString::fromUtf8(md.moveString), text);
 	}
 }
 
@@ -126,7 +126,8 @@ void MoveList::setGame(ChessGame* game, PgnGame* pgn)
 	m_moveCount = 0;
 	for (const PgnGame::MoveData& md : pgn->moves())
 	{
-		insertMove(m_moveCount++, md.moveString, md.comment, cursor);
+		insertMove(m_moveCount++, QString::fromUtf8(md.moveString),
+			   QString::fromUtf8(md.comment), cursor);
 	}
 	cursor.endEditBlock();
 
@@ -216,25 +217,17 @@ void MoveList::setMove(int ply,
 	commentToken.select(c);
 	commentToken.insert(c);
 
-	int newLength = commentToken.length();
-	int diff = newLength - oldLength;
-	if (diff == 0)
+	if (commentToken.length() == oldLength)
 		return;
 
-	for (int i = ply + 1; i < m_moves.size(); i++)
+	// The document adjusts the positions of the following tokens
+	// by itself; only the next move number may need re-rendering
+	// because its block format depends on the comment's length
+	if (ply + 1 < m_moves.size())
 	{
-		m_moves[i].number.move(diff);
-		if (i == ply + 1)
-		{
-			MoveNumberToken& nextNumber(m_moves[i].number);
-			oldLength = nextNumber.length();
-			nextNumber.select(c);
-			nextNumber.insert(c);
-			newLength = nextNumber.length();
-			diff += (newLength - oldLength);
-		}
-		m_moves[i].move.move(diff);
-		m_moves[i].comment.move(diff);
+		MoveNumberToken& nextNumber(m_moves[ply + 1].number);
+		nextNumber.select(c);
+		nextNumber.insert(c);
 	}
 }
 
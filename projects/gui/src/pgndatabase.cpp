@@ -18,10 +18,16 @@
 
 #include "pgndatabase.h"
 #include <pgnstream.h>
+#include <positionindex.h>
 #include <QFileInfo>
 
 PgnDatabase::PgnDatabase(const QString& fileName, QObject* parent)
 	: QObject(parent),
+	  m_stream(nullptr),
+	  m_positionIndex(nullptr),
+	  m_positionIndexTried(false),
+	  m_indexedSize(0),
+	  m_prefixChecksum(0),
 	  m_fileName(fileName),
 	  m_displayName(QFileInfo(fileName).completeBaseName())
 {
@@ -29,11 +35,27 @@ PgnDatabase::PgnDatabase(const QString& fileName, QObject* parent)
 
 PgnDatabase::~PgnDatabase()
 {
+	closeFile();
 	qDeleteAll(m_entries);
 }
 
+void PgnDatabase::closeFile()
+{
+	delete m_stream;
+	m_stream = nullptr;
+	if (m_file.isOpen())
+		m_file.close();
+
+	delete m_positionIndex;
+	m_positionIndex = nullptr;
+	m_positionIndexTried = false;
+}
+
 void PgnDatabase::setEntries(const QList<const PgnGameEntry*>& entries)
 {
+	// The entries' seek positions may come from a re-imported file,
+	// so any mapping of the old contents is stale
+	closeFile();
 	qDeleteAll(m_entries);
 	m_entries = entries;
 }
@@ -43,6 +65,21 @@ QList<const PgnGameEntry*> PgnDatabase::entries() const
 	return m_entries;
 }
 
+void PgnDatabase::appendEntries(const QList<const PgnGameEntry*>& entries)
+{
+	// The new entries point past the end of the old contents, so
+	// any open handle or mapping of the file is stale
+	closeFile();
+	m_entries += entries;
+}
+
+QList<const PgnGameEntry*> PgnDatabase::takeEntries()
+{
+	const QList<const PgnGameEntry*> entries = m_entries;
+	m_entries.clear();
+	return entries;
+}
+
 QString PgnDatabase::fileName() const
 {
 	return m_fileName;
@@ -82,6 +119,49 @@ void PgnDatabase::setDisplayName(const QString& displayName)
 	m_displayName = displayName;
 }
 
+qint64 PgnDatabase::indexedSize() const
+{
+	return m_indexedSize;
+}
+
+void PgnDatabase::setIndexedSize(qint64 size)
+{
+	m_indexedSize = size;
+}
+
+quint16 PgnDatabase::prefixChecksum() const
+{
+	return m_prefixChecksum;
+}
+
+void PgnDatabase::setPrefixChecksum(quint16 checksum)
+{
+	m_prefixChecksum = checksum;
+}
+
+quint16 PgnDatabase::computePrefixChecksum(const QString& fileName,
+					   qint64 size)
+{
+	// Checksumming the whole prefix would cost as much as importing
+	// it, so only its last few kilobytes are read. Appended games
+	// land after the prefix and never touch these bytes.
+	const qint64 window = qMin(size, Q_INT64_C(4096));
+	if (window <= 0)
+		return 0;
+
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly))
+		return 0;
+	if (!file.seek(size - window))
+		return 0;
+
+	const QByteArray data = file.read(window);
+	if (data.size() != window)
+		return 0;
+
+	return qChecksum(data.constData(), uint(data.size()));
+}
+
 PgnDatabase::Status PgnDatabase::game(const PgnGameEntry* entry,
 				      PgnGame* game)
 {
@@ -90,15 +170,38 @@ PgnDatabase::Status PgnDatabase::game(const PgnGameEntry* entry,
 
 	Status status = this->status();
 	if (status != Ok)
+	{
+		closeFile();
 		return status;
+	}
 
-	QFile file(m_fileName);
-	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
-		return Unreadable;
+	if (m_stream == nullptr)
+	{
+		m_file.setFileName(m_fileName);
+		if (!m_file.open(QIODevice::ReadOnly | QIODevice::Text))
+			return Unreadable;
+
+		m_stream = new PgnStream(&m_file);
+	}
 
-	PgnStream in(&file);
-	if (!in.seek(entry->pos(), entry->lineNumber()) || !game->read(in))
+	if (!m_stream->seek(entry->pos(), entry->lineNumber()) || !game->read(*m_stream))
 		return Corrupted;
 
 	return Ok;
 }
+
+PositionIndex* PgnDatabase::positionIndex()
+{
+	if (!m_positionIndexTried)
+	{
+		m_positionIndexTried = true;
+
+		PositionIndex* index = new PositionIndex;
+		if (index->open(m_fileName + ".cpi"))
+			m_positionIndex = index;
+		else
+			delete index;
+	}
+
+	return m_positionIndex;
+}
@@ -26,6 +26,7 @@
 #include <pgngame.h>
 #include <pgngameentry.h>
 class PgnStream;
+class PositionIndex;
 
 /*!
  * \brief PGN database
@@ -73,6 +74,19 @@ class PgnDatabase : public QObject
 		 * \sa game()
 		 */
 		QList<const PgnGameEntry*> entries() const;
+		/*!
+		 * Appends \a entries to the database's entry list.
+		 *
+		 * The database takes ownership of the PgnGameEntry objects
+		 * in \a entries. The existing entries keep their ordinals,
+		 * so a position index built for them stays valid.
+		 */
+		void appendEntries(const QList<const PgnGameEntry*>& entries);
+		/*!
+		 * Removes and returns the database's entries without
+		 * deleting them. The caller takes ownership.
+		 */
+		QList<const PgnGameEntry*> takeEntries();
 
 		/*! Returns the file name of this database. */
 		QString fileName() const;
@@ -114,15 +128,80 @@ class PgnDatabase : public QObject
 		 */
 		void setDisplayName(const QString& displayName);
 
+		/*!
+		 * Returns the size the database file had when its entries
+		 * were read, ie. the length of the indexed prefix of the
+		 * file, or 0 if it isn't known.
+		 *
+		 * \sa setIndexedSize
+		 */
+		qint64 indexedSize() const;
+		/*!
+		 * Sets the length of the indexed prefix to \a size.
+		 *
+		 * \sa indexedSize
+		 */
+		void setIndexedSize(qint64 size);
+		/*!
+		 * Returns the checksum over the end of the indexed prefix,
+		 * or 0 if it isn't known.
+		 *
+		 * \sa computePrefixChecksum
+		 */
+		quint16 prefixChecksum() const;
+		/*!
+		 * Sets the indexed prefix checksum to \a checksum.
+		 *
+		 * \sa prefixChecksum
+		 */
+		void setPrefixChecksum(quint16 checksum);
+		/*!
+		 * Computes a checksum over the end of the first \a size
+		 * bytes of \a fileName.
+		 *
+		 * Only the last few kilobytes of the prefix are covered,
+		 * so the cost doesn't depend on \a size; appending to the
+		 * file doesn't change the checksum, any other change to
+		 * the end of the prefix does.
+		 *
+		 * Returns 0 on failure.
+		 */
+		static quint16 computePrefixChecksum(const QString& fileName,
+						     qint64 size);
+
 		/*!
 		 * Reads \a game from the database using \a entry.
 		 *
+		 * The database file is opened and memory-mapped on the first
+		 * read and the handle is kept for subsequent reads, so paging
+		 * through games doesn't re-open the file and reads of nearby
+		 * games are served from already-cached pages.
+		 *
 		 * \note \a game must be allocated by the caller and must not be NULL.
 		 */
 		Status game(const PgnGameEntry* entry, PgnGame* game);
 
+		/*!
+		 * Returns the database's position index, or nullptr if
+		 * no index was built when the database was imported.
+		 *
+		 * The index maps board positions to ordinals in
+		 * entries().
+		 *
+		 * \sa PositionIndex
+		 */
+		PositionIndex* positionIndex();
+
 	private:
+		void closeFile();
+
+		QFile m_file;
+		PgnStream* m_stream;
+		PositionIndex* m_positionIndex;
+		bool m_positionIndexTried;
 		QList<const PgnGameEntry*> m_entries;
+		qint64 m_indexedSize;
+		quint16 m_prefixChecksum;
 		QDateTime m_lastModified;
 		QString m_fileName;
 		QString m_displayName;
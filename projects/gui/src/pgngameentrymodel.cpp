@@ -18,24 +18,57 @@
 
 #include "pgngameentrymodel.h"
 #include <QtConcurrentFilter>
+#include <QtConcurrentMap>
 #include <pgngameentry.h>
 
 
+namespace {
+
+// Lowercase concatenation of an entry's tag values. With the keys
+// precomputed, a fixed-string filter run is a plain substring
+// search instead of a case-insensitive scan over every tag of
+// every entry.
+QByteArray s_searchKey(const PgnGameEntry* entry)
+{
+	QByteArray key;
+	for (int type = PgnGameEntry::EventTag;
+	     type <= PgnGameEntry::VariantTag; type++)
+	{
+		key += entry->tagValue(PgnGameEntry::TagType(type))
+		       .toLower().toLatin1();
+		key += '\n';
+	}
+
+	return key;
+}
+
+} // anonymous namespace
+
+
 struct EntryContains
 {
 	EntryContains(const QList<const PgnGameEntry*>& entries,
+		      const QVector<QByteArray>& keys,
 		      const PgnGameFilter& filter)
-		: m_entries(entries), m_filter(filter) { }
+		: m_entries(entries),
+		  m_keys(keys),
+		  m_filter(filter),
+		  m_pattern(QByteArray(filter.pattern()).toLower()) { }
 
 	typedef bool result_type;
 
 	inline bool operator()(int index)
 	{
+		if (m_filter.type() == PgnGameFilter::FixedString)
+			return m_keys.at(index).contains(m_pattern);
+
 		return m_entries.at(index)->match(m_filter);
 	}
 
 	const QList<const PgnGameEntry*>& m_entries;
+	const QVector<QByteArray>& m_keys;
 	PgnGameFilter m_filter;
+	QByteArray m_pattern;
 };
 
 
@@ -67,6 +100,20 @@ void PgnGameEntryModel::setEntries(const QList<const PgnGameEntry*>& entries)
 	m_watcher.cancel();
 	m_watcher.waitForFinished();
 
+	// The cached keys are positional, so they can be reused only
+	// if the new list extends the old one. Selection changes and
+	// position-search results pass a different list: their keys
+	// are rebuilt, or they would match against other entries.
+	bool extendsOld = entries.size() >= m_entries.size()
+			  && m_keys.size() == m_entries.size();
+	for (int i = 0; extendsOld && i < m_entries.size(); i++)
+	{
+		if (entries.at(i) != m_entries.at(i))
+			extendsOld = false;
+	}
+	if (!extendsOld)
+		m_keys.clear();
+
 	m_entries = entries;
 
 	if (entries.size() > m_indexes.size())
@@ -76,6 +123,17 @@ void PgnGameEntryModel::setEntries(const QList<const PgnGameEntry*>& entries)
 			m_indexes.append(i);
 	}
 
+	if (entries.size() > m_keys.size())
+	{
+		// Precompute search keys for the new entries in
+		// parallel; this is a one-time cost per database load
+		const auto newKeys = QtConcurrent::blockingMapped(
+			entries.mid(m_keys.size()), s_searchKey);
+		m_keys.reserve(entries.size());
+		for (const QByteArray& key : newKeys)
+			m_keys.append(key);
+	}
+
 	applyFilter(m_filter);
 }
 
@@ -92,7 +150,7 @@ void PgnGameEntryModel::applyFilter(const PgnGameFilter& filter)
 
 	m_filtered = QtConcurrent::filtered(m_indexes.constBegin(),
 					    m_indexes.constBegin() + m_entries.size(),
-					    EntryContains(m_entries, filter));
+					    EntryContains(m_entries, m_keys, filter));
 
 	m_watcher.setFuture(m_filtered);
 	endResetModel();
@@ -100,8 +158,10 @@ void PgnGameEntryModel::applyFilter(const PgnGameFilter& filter)
 
 void PgnGameEntryModel::setFilter(const PgnGameFilter& filter)
 {
+	// The superseded run is only canceled, not waited for: it
+	// reads the same entries as the new run, and waiting here
+	// would stall the UI thread on every keystroke
 	m_watcher.cancel();
-	m_watcher.waitForFinished();
 
 	m_filter = filter;
 	applyFilter(filter);
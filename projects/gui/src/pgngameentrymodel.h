@@ -21,6 +21,8 @@
 
 #include <QAbstractItemModel>
 #include <QList>
+#include <QVector>
+#include <QByteArray>
 #include <QFuture>
 #include <QFutureWatcher>
 #include <pgngamefilter.h>
@@ -82,6 +84,7 @@ class PgnGameEntryModel : public QAbstractItemModel
 
 		QList<const PgnGameEntry*> m_entries;
 		QVector<int> m_indexes;
+		QVector<QByteArray> m_keys;
 		int m_entryCount;
 		QFuture<int> m_filtered;
 		QFutureWatcher<int> m_watcher;
@@ -18,16 +18,70 @@
 
 #include "pgnimporter.h"
 
+#include <cstring>
 #include <QFile>
 #include <QFileInfo>
+#include <QThread>
+#include <QVector>
+#include <QtConcurrentRun>
 
 #include <pgnstream.h>
 #include <pgngameentry.h>
+#include <positionindex.h>
 #include "pgndatabase.h"
 
-PgnImporter::PgnImporter(const QString& fileName)
+namespace {
+
+const int updateInterval = 1024;
+
+//! Smallest amount of data worth giving to a scanning thread.
+const qint64 minShardSize = Q_INT64_C(4) * 1024 * 1024;
+
+/*!
+ * Returns the position of the first game that starts at or after
+ * \a pos in \a data, or \a size if there is none.
+ *
+ * A game is assumed to begin with an "[Event" tag at the start of
+ * a line, which holds for any database that follows the PGN export
+ * format.
+ */
+qint64 nextGameStart(const char* data, qint64 size, qint64 pos)
+{
+	if (pos <= 0)
+		return 0;
+
+	for (qint64 i = pos - 1; i + 8 <= size; i++)
+	{
+		if (data[i] == '\n'
+		&&  memcmp(data + i + 1, "[Event ", 7) == 0)
+			return i + 1;
+	}
+
+	return size;
+}
+
+qint64 countNewlines(const char* data, qint64 size)
+{
+	qint64 count = 0;
+	for (qint64 i = 0; i < size; i++)
+	{
+		if (data[i] == '\n')
+			count++;
+	}
+
+	return count;
+}
+
+} // anonymous namespace
+
+PgnImporter::PgnImporter(const QString& fileName,
+			 const QSet<quint64>& knownHashes)
 	: Worker(QString("PGN import: %1").arg(fileName)),
-	  m_fileName(fileName)
+	  m_fileName(fileName),
+	  m_knownHashes(knownHashes),
+	  m_positionIndexInterval(0),
+	  m_startPos(0),
+	  m_startLine(1)
 {
 }
 
@@ -36,12 +90,159 @@ QString PgnImporter::fileName() const
 	return m_fileName;
 }
 
+void PgnImporter::setPositionIndexInterval(int interval)
+{
+	m_positionIndexInterval = interval;
+}
+
+void PgnImporter::setStartPosition(qint64 pos, qint64 lineNumber)
+{
+	m_startPos = pos;
+	m_startLine = lineNumber;
+}
+
+int PgnImporter::numReadGames() const
+{
+	return m_numReadGames.loadAcquire();
+}
+
+qint64 PgnImporter::numReadBytes() const
+{
+	return m_numReadBytes.loadAcquire();
+}
+
+QList<const PgnGameEntry*> PgnImporter::readSequentially(QFile& file)
+{
+	int numReadGames = 0;
+	qint64 lastPos = m_startPos;
+
+	PgnStream pgnStream(&file);
+	QList<const PgnGameEntry*> games;
+
+	if (m_startPos > 0 && !pgnStream.seek(m_startPos, m_startLine))
+		return games;
+
+	for (;;)
+	{
+		PgnGameEntry* game = new PgnGameEntry;
+		if (cancelRequested() || !game->read(pgnStream))
+		{
+			delete game;
+			break;
+		}
+
+		games << game;
+		numReadGames++;
+
+		// Progress is published in batches; the counters are only
+		// sampled a few times a second anyway
+		if (numReadGames % updateInterval == 0)
+		{
+			m_numReadGames.fetchAndAddRelaxed(updateInterval);
+			m_numReadBytes.fetchAndAddRelaxed(pgnStream.pos() - lastPos);
+			lastPos = pgnStream.pos();
+		}
+	}
+
+	return games;
+}
+
+QList<const PgnGameEntry*> PgnImporter::readSharded(const char* data,
+						    qint64 size,
+						    int shardCount)
+{
+	// Split the file into shards at game boundaries. The split
+	// points only need to be roughly even; scanning cost is
+	// proportional to shard size.
+	QVector<qint64> bounds;
+	bounds.append(0);
+	for (int i = 1; i < shardCount; i++)
+	{
+		qint64 start = nextGameStart(data, size, size * i / shardCount);
+		if (start > bounds.last() && start < size)
+			bounds.append(start);
+	}
+	bounds.append(size);
+	const int shards = bounds.size() - 1;
+
+	// The entries record absolute line numbers, so each shard needs
+	// to know the line its first game starts on before parsing
+	// begins. Counting newlines runs at memory bandwidth and is
+	// cheap compared to tokenizing.
+	QVector< QFuture<qint64> > lineFutures;
+	for (int i = 0; i < shards; i++)
+		lineFutures << QtConcurrent::run(countNewlines,
+		    data + bounds.at(i), bounds.at(i + 1) - bounds.at(i));
+
+	QVector<qint64> startLines(shards);
+	qint64 line = 1;
+	for (int i = 0; i < shards; i++)
+	{
+		startLines[i] = line;
+		line += lineFutures.at(i).result();
+	}
+
+	QVector< QFuture<QList<const PgnGameEntry*> > > futures;
+	for (int i = 0; i < shards; i++)
+	{
+		const qint64 start = bounds.at(i);
+		const qint64 end = bounds.at(i + 1);
+		const qint64 startLine = startLines.at(i);
+
+		futures << QtConcurrent::run(
+		[this, start, end, startLine]()
+		{
+			QList<const PgnGameEntry*> entries;
+
+			QFile file(m_fileName);
+			if (!file.open(QIODevice::ReadOnly))
+				return entries;
+
+			PgnStream pgnStream(&file);
+			if (!pgnStream.seek(start, startLine))
+				return entries;
+
+			int count = 0;
+			qint64 lastPos = start;
+
+			for (;;)
+			{
+				PgnGameEntry* game = new PgnGameEntry;
+				if (cancelRequested()
+				||  !game->read(pgnStream)
+				||  game->pos() >= end)
+				{
+					delete game;
+					break;
+				}
+
+				entries << game;
+				count++;
+
+				if (count % updateInterval == 0)
+				{
+					m_numReadGames.fetchAndAddRelaxed(updateInterval);
+					m_numReadBytes.fetchAndAddRelaxed(
+					    pgnStream.pos() - lastPos);
+					lastPos = pgnStream.pos();
+				}
+			}
+
+			return entries;
+		});
+	}
+
+	QList<const PgnGameEntry*> games;
+	for (int i = 0; i < futures.size(); i++)
+		games << futures.at(i).result();
+
+	return games;
+}
+
 void PgnImporter::work()
 {
 	QFile file(m_fileName);
 	QFileInfo fileInfo(m_fileName);
-	static const int updateInterval = 1024;
-	int numReadGames = 0;
 
 	if (!fileInfo.exists())
 	{
@@ -55,28 +256,70 @@ void PgnImporter::work()
 		return;
 	}
 
-	PgnStream pgnStream(&file);
+	const qint64 fileSize = fileInfo.size();
+
+	// A tail import starts mid-file and is bounded by the appended
+	// data, so it's always read sequentially
+	int shardCount = 0;
+	if (m_startPos <= 0)
+		shardCount = int(qMin(qint64(QThread::idealThreadCount()),
+				      fileSize / minShardSize));
+
 	QList<const PgnGameEntry*> games;
+	uchar* data = nullptr;
+	if (shardCount >= 2)
+		data = file.map(0, fileSize);
 
-	for (;;)
+	if (data != nullptr)
+		games = readSharded(reinterpret_cast<const char*>(data),
+				    fileSize, shardCount);
+	else
+		games = readSequentially(file);
+
+	// Drop games whose hash was already seen, either in a
+	// previously imported database or earlier in this file
+	QSet<quint64> seen = m_knownHashes;
+	QList<const PgnGameEntry*> uniqueGames;
+	int duplicates = 0;
+
+	for (const PgnGameEntry* game : qAsConst(games))
 	{
-		PgnGameEntry* game = new PgnGameEntry;
-		if (cancelRequested() || !game->read(pgnStream))
+		const quint64 hash = game->hash();
+		if (seen.contains(hash))
 		{
 			delete game;
-			break;
+			duplicates++;
+			continue;
 		}
 
-		games << game;
-		numReadGames++;
+		seen.insert(hash);
+		uniqueGames << game;
+	}
+	if (duplicates > 0)
+		qInfo("PgnImporter: skipped %d duplicate game(s) in %s",
+		      duplicates, qUtf8Printable(m_fileName));
 
-		if (numReadGames % updateInterval == 0)
-			emit databaseReadStatus(startTime(), numReadGames,
-			    pgnStream.pos());
+	// Build or remove the position index before publishing the
+	// database, so that searches never see a stale index. A tail
+	// import holds only part of the file's games, so the index is
+	// left alone; the caller falls back to a full import when
+	// indexing is enabled.
+	if (m_startPos <= 0)
+	{
+		const QString indexFile = m_fileName + ".cpi";
+		if (m_positionIndexInterval > 0)
+			PositionIndex::build(m_fileName, indexFile, uniqueGames,
+					     m_positionIndexInterval);
+		else if (QFile::exists(indexFile))
+			QFile::remove(indexFile);
 	}
+
 	PgnDatabase* db = new PgnDatabase(m_fileName);
-	db->setEntries(games);
+	db->setEntries(uniqueGames);
 	db->setLastModified(fileInfo.lastModified());
+	db->setIndexedSize(fileSize);
+	db->setPrefixChecksum(
+	    PgnDatabase::computePrefixChecksum(m_fileName, fileSize));
 
 	emit databaseRead(db);
 }
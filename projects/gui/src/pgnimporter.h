@@ -19,13 +19,21 @@
 #ifndef PGN_IMPORTER_H
 #define PGN_IMPORTER_H
 
+#include <QAtomicInteger>
+#include <QList>
+#include <QSet>
 #include <worker.h>
 
+class QFile;
 class PgnDatabase;
+class PgnGameEntry;
 
 /*!
  * \brief Reads PGN database in a separate thread.
  *
+ * Large databases are split into shards at game boundaries and
+ * scanned by a pool of threads; small ones are read sequentially.
+ *
  * \sa PgnDatabase
  */
 class PgnImporter : public Worker
@@ -43,27 +51,85 @@ class PgnImporter : public Worker
 		/*!
 		 * Constructs a PgnImporter with \a fileName as
 		 * database to be imported.
+		 *
+		 * Games whose hash is in \a knownHashes are skipped as
+		 * duplicates of already-imported games, as are repeats
+		 * within the file itself.
+		 *
+		 * \sa PgnGameEntry::hash()
 		 */
-		PgnImporter(const QString& fileName);
+		PgnImporter(const QString& fileName,
+			    const QSet<quint64>& knownHashes = QSet<quint64>());
 		/*! Returns the file name of the database to be imported. */
 		QString fileName() const;
 
+		/*!
+		 * Makes the import also build a position index with a
+		 * sampling interval of \a interval plies, or disables
+		 * index building if \a interval is zero (the default).
+		 *
+		 * Building the index replays every game, which makes
+		 * the import considerably slower.
+		 *
+		 * \sa PositionIndex
+		 */
+		void setPositionIndexInterval(int interval);
+
+		/*!
+		 * Makes the import start at byte offset \a pos, which
+		 * must be the start of a game on line \a lineNumber,
+		 * instead of at the beginning of the file.
+		 *
+		 * This scans only the tail of a file whose indexed
+		 * prefix is known to be intact; the cost is bounded by
+		 * the appended data, not the size of the file. The game
+		 * starting at \a pos is read again and relies on the
+		 * duplicate filter, so anything the previous import left
+		 * unfinished at the end of the file is picked up.
+		 *
+		 * A tail import doesn't touch the position index.
+		 *
+		 * \sa PgnDatabase::indexedSize()
+		 */
+		void setStartPosition(qint64 pos, qint64 lineNumber);
+
+		/*!
+		 * Returns the number of games read so far.
+		 *
+		 * Thread-safe; meant to be sampled periodically from the
+		 * GUI thread while the import is running.
+		 */
+		int numReadGames() const;
+		/*!
+		 * Returns the number of bytes read so far.
+		 *
+		 * Thread-safe; meant to be sampled periodically from the
+		 * GUI thread while the import is running.
+		 */
+		qint64 numReadBytes() const;
+
 	protected:
 		void work() override;
 
 	signals:
 		/*! Emitted when \a database is read. */
 		void databaseRead(PgnDatabase* database);
-		/*!
-		 * Emitted periodically to give progress information about the import.
-		 *
-		 * The import was initiated at \a started and so far \a numReadGames games
-		 * and \a numReadBytes bytes have been read.
-		 */
-		void databaseReadStatus(const QTime& started, int numReadGames, qint64 numReadBytes);
 
 	private:
+		QList<const PgnGameEntry*> readSequentially(QFile& file);
+		QList<const PgnGameEntry*> readSharded(const char* data,
+						       qint64 size,
+						       int shardCount);
+
 		QString m_fileName;
+		QSet<quint64> m_knownHashes;
+		int m_positionIndexInterval;
+		// Where a tail import starts; 0 means the whole file
+		qint64 m_startPos;
+		qint64 m_startLine;
+		// Progress counters, sampled by the progress dialog
+		QAtomicInteger<int> m_numReadGames;
+		QAtomicInteger<qint64> m_numReadBytes;
 
 };
 
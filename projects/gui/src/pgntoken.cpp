@@ -20,8 +20,6 @@
 
 
 PgnToken::PgnToken()
-	: m_begin(-1),
-	  m_end(-1)
 {
 }
 
@@ -36,7 +34,10 @@ bool PgnToken::isEmpty() const
 
 int PgnToken::length() const
 {
-	return m_end - m_begin;
+	if (m_cursor.isNull())
+		return 0;
+
+	return m_cursor.position() - m_cursor.anchor();
 }
 
 void PgnToken::insert(QTextCursor& cursor)
@@ -44,36 +45,34 @@ void PgnToken::insert(QTextCursor& cursor)
 	if (isEmpty())
 		return;
 
+	int begin;
 	if (!cursor.hasSelection())
-		m_begin = cursor.position();
+		begin = cursor.position();
 	else
-		m_begin = cursor.selectionStart();
+		begin = cursor.selectionStart();
 
 	vInsert(cursor);
-	m_end = cursor.position();
+
+	m_cursor = cursor;
+	m_cursor.setPosition(begin);
+	m_cursor.setPosition(cursor.position(), QTextCursor::KeepAnchor);
 }
 
 void PgnToken::select(QTextCursor& cursor)
 {
-	if (m_begin == -1 || m_end == -1)
+	if (m_cursor.isNull())
 		return;
 
-	cursor.setPosition(m_begin);
-	cursor.setPosition(m_end, QTextCursor::KeepAnchor);
+	cursor.setPosition(m_cursor.anchor());
+	cursor.setPosition(m_cursor.position(), QTextCursor::KeepAnchor);
 }
 
-void PgnToken::move(int diff)
+void PgnToken::mergeCharFormat(QTextCursor& cursor, const QTextCharFormat& format)
 {
-	if (m_begin == -1 || m_end == -1)
+	if (m_cursor.isNull())
 		return;
 
-	m_begin += diff;
-	m_end += diff;
-}
-
-void PgnToken::mergeCharFormat(QTextCursor& cursor, const QTextCharFormat& format)
-{
-	cursor.setPosition(m_begin);
-	cursor.setPosition(m_end - 1, QTextCursor::KeepAnchor);
+	cursor.setPosition(m_cursor.anchor());
+	cursor.setPosition(m_cursor.position() - 1, QTextCursor::KeepAnchor);
 	cursor.mergeCharFormat(format);
 }
@@ -50,8 +50,6 @@ class PgnToken
 		void insert(QTextCursor& cursor);
 		/*! Selects the token with \a cursor. */
 		void select(QTextCursor& cursor);
-		/*! Moves the token's begin and end positions by \a diff. */
-		void move(int diff);
 		/*! Merges the token's character format with \a format. */
 		void mergeCharFormat(QTextCursor& cursor,
 				     const QTextCharFormat& format);
@@ -64,8 +62,10 @@ class PgnToken
 		virtual void vInsert(QTextCursor& cursor) = 0;
 
 	private:
-		int m_begin;
-		int m_end;
+		// The document keeps cursor positions up to date when
+		// text is inserted or removed, so the token's location
+		// stays valid without any explicit adjustment
+		QTextCursor m_cursor;
 };
 
 #endif // PGNTOKEN_H
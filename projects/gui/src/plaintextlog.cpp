@@ -24,17 +24,58 @@
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QTextStream>
+#include <QTimer>
 
 PlainTextLog::PlainTextLog(QWidget* parent)
 	: QPlainTextEdit(parent)
 {
-	setReadOnly(true);
+	init();
 }
 
 PlainTextLog::PlainTextLog(const QString& text, QWidget* parent)
 	: QPlainTextEdit(text, parent)
+{
+	init();
+}
+
+void PlainTextLog::init()
 {
 	setReadOnly(true);
+	// Keep the document bounded: when the limit is reached the
+	// oldest lines are dropped, so the log can stay open for hours
+	// of debug traffic without eating memory
+	setMaximumBlockCount(10000);
+
+	m_flushTimer = new QTimer(this);
+	m_flushTimer->setSingleShot(true);
+	m_flushTimer->setInterval(100);
+	connect(m_flushTimer, SIGNAL(timeout()),
+		this, SLOT(flushPendingLines()));
+}
+
+void PlainTextLog::appendLine(const QString& line)
+{
+	m_pendingLines.append(line);
+	if (!m_flushTimer->isActive())
+		m_flushTimer->start();
+}
+
+void PlainTextLog::clearLog()
+{
+	m_pendingLines.clear();
+	m_flushTimer->stop();
+	clear();
+}
+
+void PlainTextLog::flushPendingLines()
+{
+	if (m_pendingLines.isEmpty())
+		return;
+
+	// One appendPlainText() call lays the document out once no
+	// matter how many lines arrived during the batching interval
+	appendPlainText(m_pendingLines.join("\n"));
+	m_pendingLines.clear();
 }
 
 void PlainTextLog::contextMenuEvent(QContextMenuEvent* event)
@@ -42,7 +83,7 @@ void PlainTextLog::contextMenuEvent(QContextMenuEvent* event)
 	QMenu* menu = createStandardContextMenu();
 
 	menu->addSeparator();
-	menu->addAction(tr("Clear Log"), this, SLOT(clear()));
+	menu->addAction(tr("Clear Log"), this, SLOT(clearLog()));
 
 	menu->addSeparator();
 	auto saveAct = menu->addAction(tr("Save Log to File..."));
@@ -65,6 +106,8 @@ void PlainTextLog::saveLogToFile(const QString& fileName)
 	if (fileName.isEmpty())
 		return;
 
+	flushPendingLines();
+
 	QFile file(fileName);
 	if (!file.open(QFile::WriteOnly | QFile::Text))
 	{
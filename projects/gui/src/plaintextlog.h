@@ -20,12 +20,20 @@
 #define PLAIN_TEXT_LOG_H
 
 #include <QPlainTextEdit>
+#include <QStringList>
 
 class QContextMenuEvent;
 class QAction;
+class QTimer;
 
 /*!
  * \brief Widget that is used to display log messages in plain text.
+ *
+ * The log holds a bounded number of lines; when the limit is
+ * reached the oldest lines are discarded. Incoming lines are
+ * buffered and inserted in batches, so a high-volume source like
+ * engine debug output doesn't re-layout the document for every
+ * message.
  */
 class PlainTextLog : public QPlainTextEdit
 {
@@ -41,6 +49,15 @@ class PlainTextLog : public QPlainTextEdit
 		PlainTextLog(const QString& text, QWidget* parent = nullptr);
 
 	public slots:
+		/*!
+		 * Appends the line \a line to the log.
+		 *
+		 * The line is buffered and shown at the next batch
+		 * insertion, usually within a tenth of a second.
+		 */
+		void appendLine(const QString& line);
+		/*! Discards all lines, including buffered ones. */
+		void clearLog();
 		/*! Save the log to file \a filename. */
 		void saveLogToFile(const QString& fileName);
 
@@ -48,6 +65,14 @@ class PlainTextLog : public QPlainTextEdit
 		// Inherited from QPlainTextEdit
 		virtual void contextMenuEvent(QContextMenuEvent* event);
 
+	private slots:
+		void flushPendingLines();
+
+	private:
+		void init();
+
+		QStringList m_pendingLines;
+		QTimer* m_flushTimer;
 };
 
 #endif // PLAIN_TEXT_LOG_H
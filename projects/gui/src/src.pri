@@ -3,6 +3,7 @@ DEPENDPATH += $$PWD
 HEADERS += $$PWD/chessclock.h \
     $$PWD/engineconfigurationmodel.h \
     $$PWD/engineconfigurationdlg.h \
+    $$PWD/enginedetectionbatch.h \
     $$PWD/mainwindow.h \
     $$PWD/plaintextlog.h \
     $$PWD/newgamedlg.h \
@@ -21,6 +22,7 @@ HEADERS += $$PWD/chessclock.h \
     $$PWD/timecontroldlg.h \
     $$PWD/engineconfigproxymodel.h \
     $$PWD/gamewall.h \
+    $$PWD/framepublisher.h \
     $$PWD/tilelayout.h \
     $$PWD/movelist.h \
     $$PWD/pgntagsmodel.h \
@@ -40,12 +42,14 @@ HEADERS += $$PWD/chessclock.h \
     $$PWD/settingsdlg.h \
     $$PWD/enginemanagementwidget.h \
     $$PWD/tournamentresultsdlg.h \
+    $$PWD/tournamentstandingsmodel.h \
     $$PWD/gamesettingswidget.h \
     $$PWD/tournamentsettingswidget.h
 SOURCES += $$PWD/main.cpp \
     $$PWD/chessclock.cpp \
     $$PWD/engineconfigurationmodel.cpp \
     $$PWD/engineconfigurationdlg.cpp \
+    $$PWD/enginedetectionbatch.cpp \
     $$PWD/mainwindow.cpp \
     $$PWD/plaintextlog.cpp \
     $$PWD/newgamedlg.cpp \
@@ -64,6 +68,7 @@ SOURCES += $$PWD/main.cpp \
     $$PWD/timecontroldlg.cpp \
     $$PWD/engineconfigproxymodel.cpp \
     $$PWD/gamewall.cpp \
+    $$PWD/framepublisher.cpp \
     $$PWD/tilelayout.cpp \
     $$PWD/movelist.cpp \
     $$PWD/pgntagsmodel.cpp \
@@ -83,5 +88,6 @@ SOURCES += $$PWD/main.cpp \
     $$PWD/settingsdlg.cpp \
     $$PWD/enginemanagementwidget.cpp \
     $$PWD/tournamentresultsdlg.cpp \
+    $$PWD/tournamentstandingsmodel.cpp \
     $$PWD/gamesettingswidget.cpp \
     $$PWD/tournamentsettingswidget.cpp
@@ -17,17 +17,21 @@
 
 #include "threadedtask.h"
 #include <QProgressDialog>
+#include <QThreadPool>
 
 ThreadedTask::ThreadedTask(const QString& title,
 			   const QString& labelText,
 			   int minimum,
 			   int maximum,
 			   QWidget* parent)
-	: QThread(parent),
-	  m_cancel(false),
+	: Worker(title),
 	  m_statusMessage(labelText),
-	  m_taskStart(QTime::currentTime())
+	  m_lastUpdate(0)
 {
+	// The task deletes itself on the GUI thread after finishing,
+	// not in the pool thread that ran it
+	setAutoDelete(false);
+
 	m_dlg = new QProgressDialog(tr("%1 - Undefined time remaining").arg(labelText),
 						   tr("Cancel"),
 						   minimum,
@@ -38,8 +42,6 @@ ThreadedTask::ThreadedTask(const QString& title,
 	m_dlg->setMinimumDuration(1000);
 	m_dlg->setValue(0);
 
-	m_lastUpdate = 0;
-
 	connect(this, SIGNAL(finished()), this, SLOT(deleteLater()));
 	connect(this, SIGNAL(destroyed()), m_dlg, SLOT(deleteLater()));
 	connect(this, SIGNAL(progressValueChanged(int)),
@@ -53,19 +55,14 @@ ThreadedTask::~ThreadedTask()
 {
 }
 
-void ThreadedTask::cancel()
-{
-	m_cancel = true;
-}
-
-bool ThreadedTask::cancelRequested() const
+void ThreadedTask::start(int priority)
 {
-	return m_cancel;
+	QThreadPool::globalInstance()->start(this, priority);
 }
 
 void ThreadedTask::updateProgress(int value)
 {
-	int elapsed = m_taskStart.secsTo(QTime::currentTime());
+	int elapsed = startTime().secsTo(QTime::currentTime());
 
 	if (elapsed > m_lastUpdate)
 	{
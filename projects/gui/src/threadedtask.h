@@ -18,28 +18,33 @@
 #ifndef THREADEDTASK_H
 #define THREADEDTASK_H
 
-#include <QThread>
-#include <QTime>
+#include <worker.h>
 class QWidget;
 class QProgressDialog;
 
 /*!
- * \brief A long task that is executed in its own thread.
+ * \brief A long task that is executed in the shared thread pool.
  *
  * ThreadedTask is the base class for tasks that can take a long
- * time and should be executed in a separate thread. ThreadedTask
+ * time and should be executed off the GUI thread. ThreadedTask
  * automatically creates a progress dialog with a "cancel" button
  * for the task.
  *
+ * Tasks run on the global QThreadPool, so concurrent background
+ * jobs (imports, exports, filtering) share a bounded set of worker
+ * threads sized to the machine instead of each spawning a thread
+ * of its own.
+ *
  * The ThreadedTask class should be extended by reimplementing
- * QThread::run() and checking for cancellation by calling
- * cancelRequested() periodically. The subclass should also notify
+ * Worker::work() and checking for cancellation by calling
+ * cancelRequested() periodically; the "cancel" button is connected
+ * to the inherited cancel() slot. The subclass should also notify
  * the progress dialog by emitting the progressValueChanged() signal.
  *
  * ThreadedTask destroys itself and the progress dialog automatically
  * after the task is finished or cancelled.
  */
-class ThreadedTask : public QThread
+class ThreadedTask : public Worker
 {
 	Q_OBJECT
 
@@ -61,9 +66,17 @@ class ThreadedTask : public QThread
 		/*! Destroys the task and its progress dialog. */
 		virtual ~ThreadedTask();
 
+		/*!
+		 * Submits the task to the shared thread pool.
+		 *
+		 * Queued tasks with a higher \a priority run before
+		 * those with a lower one.
+		 */
+		void start(int priority = 0);
+
 	signals:
 		/*!
-		 * The reimplementation of QThread::run() should emit this
+		 * The reimplementation of Worker::work() should emit this
 		 * signal periodically to keep the progress dialog informed
 		 * of progress.
 		 */
@@ -75,34 +88,18 @@ class ThreadedTask : public QThread
 		void statusMessageChanged(const QString& message);
 
 	protected:
-		/*!
-		 * Returns true if the user had pressed the "cancel" button
-		 * on the progress dialog; otherwise returns false.
-		 *
-		 * The reimplementation of QThread::run() should check this
-		 * value periodically and return if cancel was requested.
-		 */
-		bool cancelRequested() const;
-
 		/*!
 		 * Returns human-readable version of the given time \a
 		 * sec.
 		 */
 		QString humaniseTime(int sec) const;
-	
-	private slots:
-		// Yes, QThread subclasses shouldn't normally have slots
-		// because they're executed in the wrong thread. But in this
-		// case it doesn't matter because we're just setting a flag.
-		void cancel();
 
+	private slots:
 		void updateProgress(int value);
 		void setStatusMessage(const QString& msg);
 
 	private:
-		bool m_cancel;
 		QString m_statusMessage;
-		QTime m_taskStart;
 		int m_lastUpdate;
 		QProgressDialog* m_dlg;
 };
@@ -20,27 +20,43 @@
 
 #include <limits>
 
-#include <QPlainTextEdit>
+#include <QTableView>
+#include <QHeaderView>
+#include <QLabel>
 #include <QBoxLayout>
 #include <QFont>
 
 #include <tournament.h>
+#include <elo.h>
+#include <sprt.h>
+
+#include "tournamentstandingsmodel.h"
 
 TournamentResultsDialog::TournamentResultsDialog(QWidget* parent)
 	: QDialog(parent)
 {
 	setWindowTitle(tr("Tournament Results"));
 
-	m_resultsEdit = new QPlainTextEdit(this);
-	m_resultsEdit->setReadOnly(true);
+	m_model = new TournamentStandingsModel(this);
+
+	m_resultsView = new QTableView(this);
+	m_resultsView->setModel(m_model);
+	m_resultsView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+	m_resultsView->verticalHeader()->hide();
+	m_resultsView->horizontalHeader()->setSectionResizeMode(
+		1, QHeaderView::Stretch);
+
+	m_statusLabel = new QLabel(this);
+	m_statusLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
 
 	QFont font("Courier New");
 	font.setStyleHint(QFont::Monospace);
 	font.setPointSize(font.pointSize() - 1);
-	m_resultsEdit->document()->setDefaultFont(font);
+	m_statusLabel->setFont(font);
 
 	auto layout = new QBoxLayout(QBoxLayout::TopToBottom);
-	layout->addWidget(m_resultsEdit);
+	layout->addWidget(m_resultsView);
+	layout->addWidget(m_statusLabel);
 	layout->setContentsMargins(0, 0, 0, 0);
 
 	setLayout(layout);
@@ -54,13 +70,29 @@ TournamentResultsDialog::~TournamentResultsDialog()
 void TournamentResultsDialog::setTournament(Tournament* tournament)
 {
 	setWindowTitle(tournament->name());
-	m_resultsEdit->setPlainText(tournament->results());
+	m_model->setTournament(tournament);
+	updateStatus(tournament);
 }
 
-void TournamentResultsDialog::update()
+void TournamentResultsDialog::update(ChessGame* game,
+				     int gameNumber,
+				     int whitePlayer,
+				     int blackPlayer)
 {
+	Q_UNUSED(game)
+	Q_UNUSED(gameNumber)
+
 	auto tournament = qobject_cast<Tournament*>(QObject::sender());
 	Q_ASSERT(tournament != nullptr);
+
+	// Only the two players of the finished game changed, so the
+	// standings are adjusted in place instead of being rebuilt
+	m_model->update(whitePlayer, blackPlayer);
+	updateStatus(tournament);
+}
+
+void TournamentResultsDialog::updateStatus(Tournament* tournament)
+{
 	QString text;
 
 	// A quick fix, copied from the CLI side.
@@ -79,11 +111,31 @@ void TournamentResultsDialog::update()
 		       .arg(scp.wins())
 		       .arg(fcp.draws())
 		       .arg(scoreRatio, 0, 'f', 3);
+
+		Elo elo(fcp.wins(), fcp.losses(), fcp.draws());
+		text += tr("Elo difference: %1 +/- %2\n")
+			.arg(elo.diff(), 0, 'f', 2)
+			.arg(elo.errorMargin(), 0, 'f', 2);
+	}
+
+	Sprt::Status sprtStatus = tournament->sprt()->status();
+	if (sprtStatus.llr != 0.0
+	||  sprtStatus.lBound != 0.0
+	||  sprtStatus.uBound != 0.0)
+	{
+		text += tr("SPRT: llr %1, lbound %2, ubound %3")
+			.arg(sprtStatus.llr, 0, 'g', 3)
+			.arg(sprtStatus.lBound, 0, 'g', 3)
+			.arg(sprtStatus.uBound, 0, 'g', 3);
+		if (sprtStatus.result == Sprt::AcceptH0)
+			text.append(tr(" - H0 was accepted"));
+		else if (sprtStatus.result == Sprt::AcceptH1)
+			text.append(tr(" - H1 was accepted"));
+		text.append("\n");
 	}
 
-	text += tournament->results();
-	text += tr("\n\n%1 of %2 games finished.")
+	text += tr("%1 of %2 games finished.")
 		.arg(tournament->finishedGameCount())
 		.arg(tournament->finalGameCount());
-	m_resultsEdit->setPlainText(text);
+	m_statusLabel->setText(text);
 }
@@ -21,8 +21,11 @@
 
 #include <QDialog>
 
-class QPlainTextEdit;
+class QLabel;
+class QTableView;
+class ChessGame;
 class Tournament;
+class TournamentStandingsModel;
 
 class TournamentResultsDialog : public QDialog
 {
@@ -37,10 +40,17 @@ class TournamentResultsDialog : public QDialog
 	    void setTournament(Tournament* tournament);
 
 	public slots:
-		void update();
+		void update(ChessGame* game,
+			    int gameNumber,
+			    int whitePlayer,
+			    int blackPlayer);
 
 	private:
-		QPlainTextEdit* m_resultsEdit;
+		void updateStatus(Tournament* tournament);
+
+		TournamentStandingsModel* m_model;
+		QTableView* m_resultsView;
+		QLabel* m_statusLabel;
 };
 
 #endif // TOURNAMENTRESULTSDLG_H
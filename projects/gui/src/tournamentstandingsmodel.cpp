@@ -0,0 +1,206 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "tournamentstandingsmodel.h"
+
+#include <algorithm>
+
+#include <tournament.h>
+#include <tournamentplayer.h>
+#include <elo.h>
+
+
+TournamentStandingsModel::TournamentStandingsModel(QObject* parent)
+	: QAbstractTableModel(parent),
+	  m_tournament(nullptr)
+{
+}
+
+TournamentStandingsModel::Row TournamentStandingsModel::makeRow(int player) const
+{
+	const TournamentPlayer& tp(m_tournament->playerAt(player));
+	Elo elo(tp.wins(), tp.losses(), tp.draws());
+
+	Row row = { player,
+		    tp.name(),
+		    tp.gamesFinished(),
+		    elo.pointRatio(),
+		    elo.drawRatio(),
+		    elo.errorMargin(),
+		    elo.diff(),
+		    -1.0 };
+
+	// Same ranking key as Tournament::results(): the gauntlet
+	// player (if any) first, then players with finished games
+	// sorted by point ratio, then players without finished games.
+	if (player > 0 || !m_tournament->hasGauntletRatingsOrder())
+	{
+		if (row.games)
+			row.key = 1.0 - row.score;
+		else
+			row.key = 2.0;
+	}
+
+	return row;
+}
+
+void TournamentStandingsModel::setTournament(Tournament* tournament)
+{
+	Q_ASSERT(tournament != nullptr);
+
+	beginResetModel();
+
+	m_tournament = tournament;
+	m_rows.clear();
+	for (int i = 0; i < tournament->playerCount(); i++)
+		m_rows.append(makeRow(i));
+	std::stable_sort(m_rows.begin(), m_rows.end(),
+			 [](const Row& a, const Row& b)
+	{
+		return a.key < b.key;
+	});
+
+	endResetModel();
+}
+
+void TournamentStandingsModel::update(int whitePlayer, int blackPlayer)
+{
+	if (m_tournament == nullptr)
+		return;
+
+	updateRow(whitePlayer);
+	updateRow(blackPlayer);
+}
+
+void TournamentStandingsModel::updateRow(int player)
+{
+	int i = 0;
+	for (; i < m_rows.size(); i++)
+	{
+		if (m_rows.at(i).player == player)
+			break;
+	}
+	if (i >= m_rows.size())
+		return;
+
+	m_rows[i] = makeRow(player);
+	emit dataChanged(index(i, 1), index(i, columnCount() - 1));
+
+	// Only this player's key changed, so the order is restored
+	// by moving the row past its strictly better or worse
+	// neighbors instead of re-sorting the whole list. Ties keep
+	// their current relative order.
+	const qreal key = m_rows.at(i).key;
+	int dest = i;
+	while (dest > 0 && key < m_rows.at(dest - 1).key)
+		dest--;
+	while (dest < m_rows.size() - 1 && key > m_rows.at(dest + 1).key)
+		dest++;
+	if (dest == i)
+		return;
+
+	beginMoveRows(QModelIndex(), i, i,
+		      QModelIndex(), dest > i ? dest + 1 : dest);
+	m_rows.move(i, dest);
+	endMoveRows();
+
+	// The ranks of the rows between the old and new positions
+	// shifted by one
+	emit dataChanged(index(qMin(i, dest), 0), index(qMax(i, dest), 0));
+}
+
+int TournamentStandingsModel::rowCount(const QModelIndex& parent) const
+{
+	Q_UNUSED(parent)
+
+	return m_rows.size();
+}
+
+int TournamentStandingsModel::columnCount(const QModelIndex& parent) const
+{
+	Q_UNUSED(parent)
+
+	return 7;
+}
+
+QVariant TournamentStandingsModel::data(const QModelIndex& index, int role) const
+{
+	if (!index.isValid())
+		return QVariant();
+
+	if (role == Qt::DisplayRole)
+	{
+		const Row& row(m_rows.at(index.row()));
+
+		switch (index.column())
+		{
+		case 0:
+			// The gauntlet player gets rank zero, like in
+			// Tournament::results()
+			if (m_tournament->hasGauntletRatingsOrder())
+				return index.row();
+			return index.row() + 1;
+		case 1:
+			return row.name;
+		case 2:
+			return QString::number(row.eloDiff, 'f', 0);
+		case 3:
+			return QString::number(row.errorMargin, 'f', 0);
+		case 4:
+			return row.games;
+		case 5:
+			return QString("%1%").arg(row.score * 100.0, 0, 'f', 1);
+		case 6:
+			return QString("%1%").arg(row.draws * 100.0, 0, 'f', 1);
+		default:
+			return QVariant();
+		}
+	}
+	else if (role == Qt::TextAlignmentRole && index.column() != 1)
+		return int(Qt::AlignRight | Qt::AlignVCenter);
+
+	return QVariant();
+}
+
+QVariant TournamentStandingsModel::headerData(int section,
+					      Qt::Orientation orientation,
+					      int role) const
+{
+	if (role != Qt::DisplayRole || orientation != Qt::Horizontal)
+		return QVariant();
+
+	switch (section)
+	{
+	case 0:
+		return tr("Rank");
+	case 1:
+		return tr("Name");
+	case 2:
+		return tr("Elo");
+	case 3:
+		return tr("+/-");
+	case 4:
+		return tr("Games");
+	case 5:
+		return tr("Score");
+	case 6:
+		return tr("Draws");
+	default:
+		return QVariant();
+	}
+}
@@ -0,0 +1,88 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TOURNAMENT_STANDINGS_MODEL_H
+#define TOURNAMENT_STANDINGS_MODEL_H
+
+#include <QAbstractTableModel>
+#include <QVector>
+
+class Tournament;
+
+/*!
+ * \brief A model of a tournament's current standings.
+ *
+ * The model keeps one row per tournament player, ordered like
+ * Tournament::results(): the gauntlet player first (if any), then
+ * players with finished games sorted by point ratio, then players
+ * without finished games.
+ *
+ * Unlike the results() text dump the model is updated incrementally:
+ * when a game finishes only the two participants' rows are refreshed
+ * and moved to their new positions, so the cost of an update doesn't
+ * grow with the number of players in the tournament.
+ */
+class TournamentStandingsModel : public QAbstractTableModel
+{
+	Q_OBJECT
+
+	public:
+		/*! Constructs an empty standings model. */
+		TournamentStandingsModel(QObject* parent = nullptr);
+
+		/*!
+		 * Rebuilds the standings from \a tournament's players.
+		 *
+		 * The model doesn't take ownership of \a tournament.
+		 */
+		void setTournament(Tournament* tournament);
+		/*!
+		 * Refreshes the rows of players \a whitePlayer and
+		 * \a blackPlayer after one of their games finished.
+		 */
+		void update(int whitePlayer, int blackPlayer);
+
+		// Inherited from QAbstractTableModel
+		virtual int rowCount(const QModelIndex& parent = QModelIndex()) const;
+		virtual int columnCount(const QModelIndex& parent = QModelIndex()) const;
+		virtual QVariant data(const QModelIndex& index, int role) const;
+		virtual QVariant headerData(int section,
+					    Qt::Orientation orientation,
+					    int role = Qt::DisplayRole) const;
+
+	private:
+		struct Row
+		{
+			int player;	// index in the tournament's player list
+			QString name;
+			int games;
+			qreal score;
+			qreal draws;
+			qreal errorMargin;
+			qreal eloDiff;
+			qreal key;	// ranking key, smaller sorts first
+		};
+
+		Row makeRow(int player) const;
+		void updateRow(int player);
+
+		Tournament* m_tournament;
+		QVector<Row> m_rows;
+};
+
+#endif // TOURNAMENT_STANDINGS_MODEL_H
@@ -169,6 +169,8 @@ static void close_tb(FD fd)
 #endif
 }
 
+int TB_MLOCK_ENABLED = 0;
+
 static char *map_file(const char *name, const char *suffix, uint64 *mapping)
 {
   FD fd = open_tb(name, suffix);
@@ -188,6 +190,8 @@ static char *map_file(const char *name, const char *suffix, uint64 *mapping)
     printf("Could not mmap() %s.\n", name);
     exit(1);
   }
+  if (TB_MLOCK_ENABLED && mlock(data, statbuf.st_size) != 0)
+    printf("Could not mlock() %s.\n", name);
 #else
   DWORD size_low, size_high;
   size_low = GetFileSize(fd, &size_high);
@@ -204,6 +208,9 @@ static char *map_file(const char *name, const char *suffix, uint64 *mapping)
     printf("MapViewOfFile() failed, name = %s%s, error = %lu.\n", name, suffix, GetLastError());
     exit(1);
   }
+  if (TB_MLOCK_ENABLED
+      && !VirtualLock(data, ((uint64)size_high << 32) | size_low))
+    printf("Could not VirtualLock() %s%s.\n", name, suffix);
 #endif
   close_tb(fd);
   return data;
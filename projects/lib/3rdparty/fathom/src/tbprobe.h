@@ -160,6 +160,14 @@ extern unsigned tb_probe_root_impl(
  */
 extern unsigned TB_LARGEST;
 
+/*
+ * When set to a non-zero value, tablebase files are locked into physical
+ * memory (mlock/VirtualLock) as they are mapped, so probes never stall on
+ * page faults.  Tables are mapped lazily on first use, so the flag can be
+ * set any time before probing starts.  A failed lock is not fatal.
+ */
+extern int TB_MLOCK_ENABLED;
+
 /*
  * Initialize the tablebase.
  *
@@ -0,0 +1,4 @@
+include(../benchmarks.pri)
+
+TARGET = tst_hotpaths
+SOURCES += tst_hotpaths.cpp
@@ -0,0 +1,257 @@
+#include <QtTest/QtTest>
+#include <QBuffer>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <board/board.h>
+#include <board/boardfactory.h>
+#include <pgnstream.h>
+#include <pgngame.h>
+#include <polyglotbook.h>
+#include <openingsuite.h>
+#include <jsonparser.h>
+
+/*
+ * Microbenchmarks for the lib's hot paths beyond move generation:
+ * PGN tokenization, opening book probes, Zobrist key computation,
+ * JSON parsing, SAN round trips and opening suite loading.
+ *
+ * Each benchmark runs on a fixed in-source corpus so the numbers are
+ * comparable across machines and releases. QTest's benchmark options
+ * give machine-readable output for charting, eg. "-csv results.csv".
+ */
+
+// A real game with evaluation comments; repeated to build corpora
+static QByteArray sampleGame()
+{
+	return "[Event \"CCRL 40/40\"]\n"
+	       "[Site \"CCRL\"]\n"
+	       "[Date \"2009.03.01\"]\n"
+	       "[Round \"164.1.156\"]\n"
+	       "[White \"Cheese 1.3\"]\n"
+	       "[Black \"Chezzz 1.0.3\"]\n"
+	       "[Result \"0-1\"]\n"
+	       "[ECO \"C15\"]\n"
+	       "[Opening \"French\"]\n"
+	       "[Variation \"Winawer (Nimzovich) variation\"]\n"
+	       "[PlyCount \"102\"]\n"
+	       "[WhiteElo \"2408\"]\n\n"
+	       "1. e4 e6 2. d4 d5 3. Nc3 Bb4 4. Qd3 Ne7 5. Ne2 c5 6. Bg5 f6 7. Bd2 Nbc6 8.\n"
+	       "O-O-O {-0.23/13 33s} O-O {+0.03/12 45s} 9. a3 {-0.13/13 28s} c4 {+0.11/13 45s}\n"
+	       "10. Qg3 {+0.04/13 46s} Ba5 {+0.20/12 45s} 11. f3 {+0.04/13 45s} a6 {+0.05/12\n"
+	       "45s} 12. h4 {+0.17/13 37s} b5 {+0.14/13 45s} 13. h5 {+0.26/13 46s} Bxc3\n"
+	       "{+0.31/13 45s} 14. Bxc3 {+0.13/14 44s} a5 {+0.33/13 45s} 15. h6 {+0.24/13 46s}\n"
+	       "g6 {+0.42/13 45s} 16. Bd2 {+0.12/14 33s} b4 {+0.50/13 45s} 17. a4 {+0.12/12\n"
+	       "29s} b3 {+0.82/13 45s} 18. c3 {-0.36/14 47s} Qd7 {+1.02/15 113s} 19. Bf4\n"
+	       "{-0.40/14 48s} Na7 {+1.01/14 42s} 20. Bd6 {-0.70/15 48s} Rf7 {+1.15/14 42s} 21.\n"
+	       "Kd2 {-1.08/14 26s} Bb7 {+1.50/14 84s} 22. Bxe7 {-0.50/14 49s} Rxe7 {+1.50/12\n"
+	       "20s} 23. Nf4 {-0.73/14 49s} Kh8 {+1.53/13 41s} 24. exd5 {-0.98/13 49s} exd5\n"
+	       "{+1.57/13 20s} 25. Nxg6+ {-0.95/14 49s} hxg6 {+2.31/14 21s} 26. Qxg6 {-1.15/15\n"
+	       "31s} Qd6 {+2.44/14 43s} 27. Kc1 {-1.92/15 50s} Rg8 {+2.97/14 43s} 28. Qh5\n"
+	       "{-2.36/15 50s} Qf4+ {+3.89/15 43s} 29. Kb1 {-3.69/17 36s} Rg5 {+4.02/15 263s}\n"
+	       "30. Qh3 {-3.85/16 51s} Qd2 {+3.60/15 26s} 31. Bd3 {-4.28/16 30s} Qxg2 {+3.71/14\n"
+	       "23s} 32. Qxg2 {-3.02/16 54s} Rxg2 {+3.81/15 11s} 33. Bf1 {-3.05/16 54s} Rc2\n"
+	       "{+3.77/15 25s} 34. Ka1 {-3.49/16 54s} Bc6 {+3.62/14 25s} 35. Bh3 {-3.74/16 30s}\n"
+	       "Bxa4 {+3.84/14 25s} 36. Rb1 {-3.80/15 58s} Nb5 {+3.87/14 25s} 37. Bf5 {-4.29/15\n"
+	       "38s} Nxc3 {+3.93/15 25s} 38. Bxc2 {-5.02/17 65s} bxc2 {+4.19/14 12s} 39. bxc3\n"
+	       "{-5.24/17 65s} cxb1=R+ {+4.76/14 42s} 40. Kxb1 {-5.35/17 32s} Bb3 {+4.76/13\n"
+	       "19s} 41. Rh2 {-5.42/18 38s} Re3 {+5.16/14 37s} 42. Kb2 {-6.35/17 21s} Rxf3\n"
+	       "{+5.37/14 37s} 43. Rg2 {-6.96/17 38s} Kh7 {+5.51/14 37s} 44. Rh2 {-7.15/20 38s}\n"
+	       "f5 {+6.09/14 46s} 45. Re2 {-7.95/16 38s} Kxh6 {+5.96/13 37s} 46. Re6+ {-8.34/16\n"
+	       "38s} Kg5 {+6.32/14 37s} 47. Re2 {-8.66/16 38s} Kf4 {+6.66/13 37s} 48. Rg2\n"
+	       "{-10.04/17 38s} Ke3 {+8.12/13 37s} 49. Ka3 {-11.44/18 38s} f4 {+9.40/14 37s}\n"
+	       "50. Rg5 {-12.37/18 38s} Rf1 {+9.91/13 37s} 51. Re5+ {-16.96/17 38s} Kd3\n"
+	       "{+12.91/14 37s 0-1 Adjudication} 0-1\n\n";
+}
+
+class tst_HotPaths: public QObject
+{
+	Q_OBJECT
+
+	private slots:
+		void initTestCase();
+		void pgnTokenization();
+		void pgnAnnotationSkip();
+		void bookProbe();
+		void zobristKeys();
+		void jsonParse();
+		void sanRoundTrip();
+		void suiteLoading();
+		void cleanupTestCase();
+
+	private:
+		Chess::Board* m_board = nullptr;
+};
+
+void tst_HotPaths::initTestCase()
+{
+	m_board = Chess::BoardFactory::create("standard");
+	QVERIFY(m_board != nullptr);
+	QVERIFY(m_board->setFenString(m_board->defaultFenString()));
+}
+
+void tst_HotPaths::cleanupTestCase()
+{
+	delete m_board;
+}
+
+void tst_HotPaths::pgnTokenization()
+{
+	// 50 games, roughly 150 kB; the benchmark time divided by the
+	// corpus size gives the tokenizer's MB/s
+	QByteArray corpus;
+	for (int i = 0; i < 50; i++)
+		corpus += sampleGame();
+
+	PgnStream stream(&corpus);
+	QBENCHMARK
+	{
+		int games = 0;
+		while (stream.nextGame())
+		{
+			while (stream.readNext() != PgnStream::NoToken)
+				;
+			games++;
+		}
+		QCOMPARE(games, 50);
+		stream.rewind();
+	}
+}
+
+void tst_HotPaths::pgnAnnotationSkip()
+{
+	// The same corpus with annotation skipping enabled; the
+	// comments dominate the bytes, so this bounds the scan rate
+	// of passes that need only the moves
+	QByteArray corpus;
+	for (int i = 0; i < 50; i++)
+		corpus += sampleGame();
+
+	PgnStream stream(&corpus);
+	stream.setSkipAnnotations(true);
+	QBENCHMARK
+	{
+		int games = 0;
+		while (stream.nextGame())
+		{
+			while (stream.readNext() != PgnStream::NoToken)
+				;
+			games++;
+		}
+		QCOMPARE(games, 50);
+		stream.rewind();
+	}
+}
+
+void tst_HotPaths::bookProbe()
+{
+	QByteArray pgn = sampleGame();
+	PgnStream stream(&pgn);
+	PolyglotBook book;
+	QVERIFY(book.import(stream, 20) > 0);
+
+	// Probe the keys of the imported line plus one miss
+	QVector<quint64> keys;
+	m_board->setFenString(m_board->defaultFenString());
+	PgnStream stream2(&pgn);
+	PgnGame game;
+	QVERIFY(game.read(stream2));
+	const auto& moves = game.moves();
+	for (int i = 0; i < 20 && i < moves.size(); i++)
+	{
+		keys.append(m_board->key());
+		m_board->makeMove(m_board->moveFromGenericMove(moves.at(i).move));
+	}
+	keys.append(m_board->key());
+	m_board->setFenString(m_board->defaultFenString());
+
+	QBENCHMARK
+	{
+		for (quint64 key : qAsConst(keys))
+			(void)book.move(key);
+	}
+}
+
+void tst_HotPaths::zobristKeys()
+{
+	// Setting a position computes its Zobrist key from scratch
+	const QString fen =
+		"r3k2r/1bq1bppp/p2ppn2/1p4B1/3NPP2/2N2Q2/PPP3PP/2KR1B1R w kq -";
+
+	QBENCHMARK
+	{
+		QVERIFY(m_board->setFenString(fen));
+	}
+
+	QVERIFY(m_board->setFenString(m_board->defaultFenString()));
+}
+
+void tst_HotPaths::jsonParse()
+{
+	// An engines.json-like document: an array of option-heavy
+	// configuration objects
+	QString document = "[\n";
+	for (int i = 0; i < 50; i++)
+	{
+		document += QString(
+			"{\"name\":\"engine%1\",\"command\":\"/usr/bin/engine%1\","
+			"\"protocol\":\"uci\",\"ponder\":false,\"rating\":%2,"
+			"\"options\":[{\"name\":\"Hash\",\"value\":128},"
+			"{\"name\":\"Threads\",\"value\":4},"
+			"{\"name\":\"SyzygyPath\",\"value\":\"/data/tb\"}]}")
+			.arg(i).arg(2000 + i);
+		document += (i + 1 < 50) ? ",\n" : "\n";
+	}
+	document += "]\n";
+
+	QBENCHMARK
+	{
+		QTextStream stream(&document, QIODevice::ReadOnly);
+		JsonParser parser(stream);
+		QVariant data = parser.parse();
+		QCOMPARE(data.toList().size(), 50);
+	}
+}
+
+void tst_HotPaths::sanRoundTrip()
+{
+	const auto moves = m_board->legalMoves();
+	QVERIFY(!moves.isEmpty());
+
+	QBENCHMARK
+	{
+		for (const Chess::Move& move : moves)
+		{
+			QString san = m_board->moveString(
+				move, Chess::Board::StandardAlgebraic);
+			Chess::Move parsed = m_board->moveFromString(san);
+			QCOMPARE(parsed, move);
+		}
+	}
+}
+
+void tst_HotPaths::suiteLoading()
+{
+	// The suite file lives in a temporary directory because
+	// initialize() persists an index file beside it; after the
+	// first pass the benchmark measures the indexed load
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString fileName = dir.path() + "/suite.pgn";
+
+	QFile file(fileName);
+	QVERIFY(file.open(QIODevice::WriteOnly));
+	for (int i = 0; i < 50; i++)
+		file.write(sampleGame());
+	file.close();
+
+	QBENCHMARK
+	{
+		OpeningSuite suite(fileName, OpeningSuite::PgnFormat);
+		QVERIFY(suite.initialize());
+		PgnGame game = suite.nextGame(16);
+		QVERIFY(!game.isNull());
+	}
+}
+
+QTEST_MAIN(tst_HotPaths)
+#include "tst_hotpaths.moc"
@@ -50,6 +50,7 @@ QString JsonParser::tokenString(JsonParser::Token type, const QString& str)
 
 JsonParser::JsonParser(QTextStream& stream)
 	: m_error(false),
+	  m_firstItem(false),
 	  m_currentLine(1),
 	  m_errorLine(0),
 	  m_stream(stream)
@@ -96,6 +97,116 @@ QVariant JsonParser::parse()
 	return parseValue();
 }
 
+bool JsonParser::openArray()
+{
+	Token t = parseToken();
+	if (t != JsonBeginArray)
+	{
+		setError(tr("Expected opening bracket instead of: %1")
+			 .arg(tokenString(t, m_lastToken)));
+		return false;
+	}
+
+	m_firstItem = true;
+	return true;
+}
+
+QVariant JsonParser::parseNextItem(bool* atEnd)
+{
+	Q_ASSERT(atEnd != 0);
+	*atEnd = false;
+
+	if (m_firstItem)
+	{
+		m_firstItem = false;
+
+		Token t = JsonNone;
+		QVariant value = parseValue(&t);
+		if (t == JsonEndArray)
+		{
+			clearError();
+			*atEnd = true;
+			return QVariant();
+		}
+		return value;
+	}
+
+	Token t = parseToken();
+	if (t == JsonEndArray)
+	{
+		*atEnd = true;
+		return QVariant();
+	}
+	if (t != JsonComma)
+	{
+		setError(tr("Expected comma or closing bracket instead of: %1")
+			 .arg(tokenString(t, m_lastToken)));
+		return QVariant();
+	}
+
+	return parseValue();
+}
+
+bool JsonParser::skipNextItem(bool* atEnd)
+{
+	Q_ASSERT(atEnd != 0);
+	*atEnd = false;
+
+	Token t = parseToken();
+	if (t == JsonEndArray)
+	{
+		*atEnd = true;
+		m_firstItem = false;
+		return true;
+	}
+	if (!m_firstItem)
+	{
+		if (t != JsonComma)
+		{
+			setError(tr("Expected comma or closing bracket instead of: %1")
+				 .arg(tokenString(t, m_lastToken)));
+			return false;
+		}
+		t = parseToken();
+	}
+	m_firstItem = false;
+
+	return skipValue(t);
+}
+
+// Consumes the rest of a value whose first token is 'type' without
+// building a QVariant tree for it. Only bracket balance is checked;
+// the contents are not validated.
+bool JsonParser::skipValue(Token type)
+{
+	if (type == JsonError)
+		return false;
+	if (type != JsonBeginObject && type != JsonBeginArray)
+		return true;
+
+	int depth = 1;
+	while (depth > 0)
+	{
+		switch (parseToken())
+		{
+		case JsonError:
+			return false;
+		case JsonBeginObject:
+		case JsonBeginArray:
+			depth++;
+			break;
+		case JsonEndObject:
+		case JsonEndArray:
+			depth--;
+			break;
+		default:
+			break;
+		}
+	}
+
+	return true;
+}
+
 JsonParser::Token JsonParser::parseToken()
 {
 	static const QString termination(",]}");
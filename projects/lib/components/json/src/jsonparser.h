@@ -56,6 +56,44 @@ class LIB_EXPORT JsonParser
 		 */
 		QVariant parse();
 
+		/*!
+		 * Parses the opening bracket of a top-level JSON array
+		 * and prepares the parser for pulling the array's items
+		 * one at a time.
+		 *
+		 * Unlike parse(), which materializes the whole document
+		 * as one QVariant tree, an array opened with this
+		 * function is consumed item by item with parseNextItem()
+		 * and skipNextItem(), so only one item is in memory at a
+		 * time. This is much cheaper for large documents like
+		 * engine configuration files.
+		 *
+		 * Returns false if the stream doesn't begin with an
+		 * array.
+		 */
+		bool openArray();
+		/*!
+		 * Parses and returns the next item of an array opened
+		 * with openArray().
+		 *
+		 * If the end of the array was reached, \a atEnd is set
+		 * to true and a null QVariant is returned. Use
+		 * hasError() to tell a parsing error from a valid null
+		 * item.
+		 */
+		QVariant parseNextItem(bool* atEnd);
+		/*!
+		 * Skips the next item of an array opened with
+		 * openArray() without converting it into a QVariant.
+		 *
+		 * A skipped item is only scanned for balanced brackets,
+		 * not fully validated.
+		 *
+		 * If the end of the array was reached, \a atEnd is set
+		 * to true. Returns false on a parsing error.
+		 */
+		bool skipNextItem(bool* atEnd);
+
 		/*! Returns true if a parsing error occured. */
 		bool hasError() const;
 		/*! Returns a detailed description of the error. */
@@ -90,10 +128,12 @@ class LIB_EXPORT JsonParser
 		QVariant parseObject();
 		QVariant parseArray();
 		QString parseString();
+		bool skipValue(Token type);
 		void setError(const QString& message);
 		void clearError();
 
 		bool m_error;
+		bool m_firstItem;
 		qint64 m_currentLine;
 		qint64 m_errorLine;
 		QString m_errorString;
@@ -28,9 +28,42 @@
 
 namespace {
 
+bool needsEscaping(const QChar& c)
+{
+	switch (c.toLatin1())
+	{
+	case '\"':
+	case '\\':
+	case '\b':
+	case '\f':
+	case '\n':
+	case '\r':
+	case '\t':
+		return true;
+	default:
+		return c.unicode() >= 128;
+	}
+}
+
 QString jsonString(const QString& source)
 {
+	// Most strings need no escaping at all; detect that with one
+	// scan and share the source's data instead of building a copy
+	// character by character
+	bool clean = true;
+	for (const QChar& c : source)
+	{
+		if (needsEscaping(c))
+		{
+			clean = false;
+			break;
+		}
+	}
+	if (clean)
+		return source;
+
 	QString str;
+	str.reserve(source.size() + 8);
 	for (const QChar& c : source)
 	{
 		switch (c.toLatin1())
@@ -97,7 +130,7 @@ void JsonSerializer::setError(const QString &message)
 	m_errorString = message;
 }
 
-bool JsonSerializer::serializeNode(QTextStream& stream,
+bool JsonSerializer::serializeNode(QString& buffer,
 				   const QVariant& node,
 				   int indentLevel)
 {
@@ -106,53 +139,61 @@ bool JsonSerializer::serializeNode(QTextStream& stream,
 	switch (node.type())
 	{
 	case QVariant::Invalid:
-		stream << "null";
+		buffer += "null";
 		break;
 	case QVariant::Map:
 		{
-			stream << "{\n";
+			buffer += "{\n";
 
 			const QVariantMap map(node.toMap());
 			QVariantMap::const_iterator it;
 			for (it = map.constBegin(); it != map.constEnd(); ++it)
 			{
-				stream << indent << "\t\"" << jsonString(it.key()) << "\" : ";
-				if (!serializeNode(stream, it.value(), indentLevel + 1))
+				buffer += indent;
+				buffer += "\t\"";
+				buffer += jsonString(it.key());
+				buffer += "\" : ";
+				if (!serializeNode(buffer, it.value(), indentLevel + 1))
 					return false;
 				if (it != map.constEnd() - 1)
-					stream << ',';
-				stream << '\n';
+					buffer += ',';
+				buffer += '\n';
 			}
 
-			stream << indent << '}';
+			buffer += indent;
+			buffer += '}';
 		}
 		break;
 	case QVariant::List:
 	case QVariant::StringList:
 		{
-			stream << "[\n";
+			buffer += "[\n";
 
 			const QVariantList list(node.toList());
 			for (int i = 0; i < list.size(); i++)
 			{
-				stream << indent << '\t';
-				if (!serializeNode(stream, list.at(i), indentLevel + 1))
+				buffer += indent;
+				buffer += '\t';
+				if (!serializeNode(buffer, list.at(i), indentLevel + 1))
 					return false;
 				if (i != list.size() - 1)
-					stream << ',';
-				stream << '\n';
+					buffer += ',';
+				buffer += '\n';
 			}
 
-			stream << indent << ']';
+			buffer += indent;
+			buffer += ']';
 		}
 		break;
 	case QVariant::String:
 	case QVariant::ByteArray:
-		stream << '\"' << jsonString(node.toString()) << '\"';
+		buffer += '\"';
+		buffer += jsonString(node.toString());
+		buffer += '\"';
 		break;
 	default:
 		if (node.canConvert(QVariant::String))
-			stream << node.toString();
+			buffer += node.toString();
 		else
 		{
 			setError(tr("Invalid variant type: %1")
@@ -167,8 +208,18 @@ bool JsonSerializer::serializeNode(QTextStream& stream,
 
 bool JsonSerializer::serialize(QTextStream& stream)
 {
-	bool ok = serializeNode(stream, m_data, 0);
+	// Build the whole document in one growing buffer and hand it
+	// to the stream in a single write. Streaming each token
+	// separately spends most of the time in QTextStream's
+	// conversion machinery for tiny writes.
+	QString buffer;
+	buffer.reserve(4096);
+
+	bool ok = serializeNode(buffer, m_data, 0);
 	if (ok)
-		stream << '\n';
+	{
+		buffer += '\n';
+		stream << buffer;
+	}
 	return ok;
 }
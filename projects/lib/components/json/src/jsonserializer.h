@@ -72,7 +72,7 @@ class LIB_EXPORT JsonSerializer
 		QString errorString() const;
 
 	private:
-		bool serializeNode(QTextStream& stream,
+		bool serializeNode(QString& buffer,
 				   const QVariant& node,
 				   int indentLevel);
 		void setError(const QString& message);
@@ -40,6 +40,8 @@ class tst_JsonParser: public QObject
 		void advanced_data() const;
 		void advanced() const;
 
+		void streaming() const;
+
 	private:
 		QVariant sample1() const;
 		QVariant sample2() const;
@@ -375,5 +377,67 @@ void tst_JsonParser::advanced() const
 	QCOMPARE(data, expected);
 }
 
+void tst_JsonParser::streaming() const
+{
+	bool atEnd = false;
+
+	QString input("[{\"id\": 1, \"tags\": [1, 2]}, null, \"str\", {\"id\": 2}]");
+	QTextStream stream(&input, QIODevice::ReadOnly);
+	JsonParser parser(stream);
+
+	QVERIFY(parser.openArray());
+
+	QVariantMap first;
+	first["id"] = 1;
+	first["tags"] = QVariantList() << 1 << 2;
+	QCOMPARE(parser.parseNextItem(&atEnd), QVariant(first));
+	QVERIFY(!atEnd);
+
+	QCOMPARE(parser.parseNextItem(&atEnd), QVariant());
+	QVERIFY(!atEnd);
+	QVERIFY(!parser.hasError());
+
+	QCOMPARE(parser.parseNextItem(&atEnd), QVariant("str"));
+	QVERIFY(!atEnd);
+
+	QVERIFY(parser.skipNextItem(&atEnd));
+	QVERIFY(!atEnd);
+
+	parser.parseNextItem(&atEnd);
+	QVERIFY(atEnd);
+	QVERIFY(!parser.hasError());
+
+	QString empty("[]");
+	QTextStream emptyStream(&empty, QIODevice::ReadOnly);
+	JsonParser emptyParser(emptyStream);
+
+	QVERIFY(emptyParser.openArray());
+	emptyParser.parseNextItem(&atEnd);
+	QVERIFY(atEnd);
+	QVERIFY(!emptyParser.hasError());
+
+	QString nested("[ {\"a\": {\"b\": [null]}}, [[], {}], 25 ]");
+	QTextStream nestedStream(&nested, QIODevice::ReadOnly);
+	JsonParser nestedParser(nestedStream);
+
+	QVERIFY(nestedParser.openArray());
+	QVERIFY(nestedParser.skipNextItem(&atEnd));
+	QVERIFY(!atEnd);
+	QVERIFY(nestedParser.skipNextItem(&atEnd));
+	QVERIFY(!atEnd);
+	QVERIFY(nestedParser.skipNextItem(&atEnd));
+	QVERIFY(!atEnd);
+	QVERIFY(nestedParser.skipNextItem(&atEnd));
+	QVERIFY(atEnd);
+	QVERIFY(!nestedParser.hasError());
+
+	QString notArray("{\"a\": 1}");
+	QTextStream notArrayStream(&notArray, QIODevice::ReadOnly);
+	JsonParser notArrayParser(notArrayStream);
+
+	QVERIFY(!notArrayParser.openArray());
+	QVERIFY(notArrayParser.hasError());
+}
+
 QTEST_MAIN(tst_JsonParser)
 #include "tst_jsonparser.moc"
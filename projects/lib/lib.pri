@@ -1,2 +1,2 @@
 INCLUDEPATH += $$PWD/src $$PWD/components/json/src
-LIBS += -lcutechess -L$$PWD
+LIBS += -lcutechess -L$$PWD -lz
@@ -31,7 +31,7 @@ namespace Chess {
  *
  * \note Rules:
  */
-class LIB_EXPORT AiWokBoard : public MakrukBoard
+class LIB_EXPORT AiWokBoard final : public MakrukBoard
 {
 	public:
 		/*! Creates a new AiWokBoard object. */
@@ -36,7 +36,7 @@ namespace Chess {
  * \sa ChancellorBoard
  * \sa CapablancaBoard
  */
-class LIB_EXPORT AlmostBoard : public WesternBoard
+class LIB_EXPORT AlmostBoard final : public WesternBoard
 {
 	public:
 		/*! Creates a new AlmostBoard object. */
@@ -35,7 +35,7 @@ namespace Chess {
  * \note Rules: https://en.wikipedia.org/wiki/Amazon_Chess
  *
  */
-class LIB_EXPORT AmazonBoard : public WesternBoard
+class LIB_EXPORT AmazonBoard final : public WesternBoard
 {
 	public:
 		/*! Creates a new AmazonBoard object. */
@@ -89,6 +89,13 @@ void AndernachBoard::vUndoMove(const Move& move)
 	StandardBoard::vUndoMove(move);
 }
 
+bool AndernachBoard::hasStagedLegalityFilter() const
+{
+	// A moved piece can switch sides and attack its own former
+	// king, which the pin and check analysis can't foresee
+	return false;
+}
+
 bool AndernachBoard::switchesSides(const Move& move) const
 {
 	return captureType(move) != Piece::NoPiece
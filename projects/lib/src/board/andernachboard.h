@@ -61,6 +61,7 @@ class LIB_EXPORT AndernachBoard : public StandardBoard
 		virtual bool switchesSides(const Move& move) const;
 
 		// Inherited from StandardBoard
+		virtual bool hasStagedLegalityFilter() const;
 		virtual Move moveFromSanString(const QString& str);
 		virtual QString sanMoveString(const Move& move);
 		virtual void vMakeMove(const Move& move,
@@ -76,7 +77,7 @@ class LIB_EXPORT AndernachBoard : public StandardBoard
  * change of color (except for Kings). Used in problem chess.
  * \sa AndernachBoard
  */
-class LIB_EXPORT AntiAndernachBoard : public AndernachBoard
+class LIB_EXPORT AntiAndernachBoard final : public AndernachBoard
 {
 	public:
 		/*! Creates a new AntiAndernachBoard object. */
@@ -101,7 +102,7 @@ class LIB_EXPORT AntiAndernachBoard : public AndernachBoard
  * Super-Andernach chess. This variant is used in problem chess.
  * \sa AndernachBoard
  */
-class LIB_EXPORT SuperAndernachBoard : public AndernachBoard
+class LIB_EXPORT SuperAndernachBoard final : public AndernachBoard
 {
 	public:
 		/*! Creates a new SuperAndernachBoard object. */
@@ -76,32 +76,57 @@ bool AntiBoard::inCheck(Side, int) const
 	return false;
 }
 
+bool AntiBoard::hasStagedLegalityFilter() const
+{
+	// The king isn't royal, so there are no pins or checks for
+	// the analysis to find
+	return false;
+}
+
+bool AntiBoard::captureExists()
+{
+	QVarLengthArray<Move> moves;
+	const int size = arraySize();
+
+	// Generate moves piece by piece and stop at the first legal
+	// capture instead of enumerating the whole move list
+	for (int i = 0; i < size; i++)
+	{
+		const Piece piece = pieceAt(i);
+		if (piece.side() != sideToMove())
+			continue;
+
+		moves.clear();
+		generateMovesForPiece(moves, piece.type(), i);
+		for (int j = 0; j < moves.size(); j++)
+		{
+			if (captureType(moves[j]) != Piece::NoPiece
+			&&  StandardBoard::vIsLegalMove(moves[j]))
+				return true;
+		}
+	}
+	return false;
+}
+
 bool AntiBoard::vIsLegalMove(const Move& move)
 {
 	if (!StandardBoard::vIsLegalMove(move))
 		return false;
 
 	if (captureType(move) != Piece::NoPiece)
+	{
+		// A legal capture proves captures exist, so seed the
+		// cache for the quiet moves tested in this position
+		m_testKey = key();
+		m_canCapture = true;
 		return true;
+	}
 
 	//try to use old results to gain higher efficiency
 	if (key() != m_testKey)
 	{
 		m_testKey = key();
-		m_canCapture = false;
-		QVarLengthArray<Move> moves;
-		generateMoves(moves);
-
-		// search for any legal capture move
-		for (int i = 0; i < moves.size(); i++)
-		{
-			if (captureType(moves[i]) != Piece::NoPiece
-			&&  StandardBoard::vIsLegalMove(moves[i]))
-			{
-				m_canCapture = true;
-				break;
-			}
-		}
+		m_canCapture = captureExists();
 	}
 	// move is illegal if a capture move exists else legal
 	return !m_canCapture;
@@ -68,6 +68,7 @@ class LIB_EXPORT AntiBoard : public StandardBoard
 						 int blackKings) const;
 		virtual bool vSetFenString(const QStringList& fen);
 		virtual bool inCheck(Side side, int square = 0) const;
+		virtual bool hasStagedLegalityFilter() const;
 		virtual bool vIsLegalMove(const Move& move);
 		virtual void addPromotions(int sourceSquare,
 					   int targetSquare,
@@ -77,6 +78,11 @@ class LIB_EXPORT AntiBoard : public StandardBoard
 		virtual Result vResultOfStalemate() const;
 
 	private:
+		// Returns true if the side to move has a legal capture,
+		// generating moves one piece at a time and stopping at
+		// the first capture found
+		bool captureExists();
+
 		quint64 m_testKey;
 		bool m_canCapture;
 }; // namespace Chess
@@ -57,7 +57,7 @@ namespace Chess {
  * \sa MakrukBoard
  *
  */
-class LIB_EXPORT AseanBoard : public MakrukBoard
+class LIB_EXPORT AseanBoard final : public MakrukBoard
 {
 	public:
 		/*! Creates a new AseanBoard object. */
@@ -76,12 +76,15 @@ bool AtomicBoard::inCheck(Side side, int square) const
 	if (square == 0)
 	{
 		int kingSq = kingSquare(side);
+		int opKingSq = kingSquare(side.opposite());
 
-		// If the kings touch, there's no check
+		// If the kings touch, there's no check. Compare the
+		// tracked king squares instead of probing all eight
+		// neighbor squares of the board array.
 		for (int i = 0; i < 8; i++)
 		{
-			Piece pc = pieceAt(kingSq + m_offsets[i]);
-			if (pc.type() == King)
+			if (kingSq + m_offsets[i] == opKingSq
+			&&  pieceAt(opKingSq).type() == King)
 				return false;
 		}
 	}
@@ -129,14 +132,22 @@ void AtomicBoard::vMakeMove(const Move& move, BoardTransition* transition)
 	{
 		int target = move.targetSquare();
 		setSquare(target, Piece::NoPiece);
+
+		// Sweep the blast zone in one pass, recording only the
+		// pieces that actually explode. Empty and wall squares
+		// and surviving pawns don't get redundant setSquare()
+		// calls here or on undo.
 		for (int i = 0; i < 8; i++)
 		{
 			int sq = target + m_offsets[i];
-			Piece& pc = md.captures[i];
-			pc = pieceAt(sq);
-			if (pc.isWall() || pc.type() == Pawn)
+			Piece pc = pieceAt(sq);
+			if (!pc.isValid() || pc.type() == Pawn)
+			{
+				md.captures[i] = Piece::NoPiece;
 				continue;
-			
+			}
+			md.captures[i] = pc;
+
 			removeCastlingRights(sq);
 			setSquare(sq, Piece::NoPiece);
 
@@ -31,7 +31,7 @@ namespace Chess {
  *
  * \note Rules: http://en.wikipedia.org/wiki/Atomic_chess
  */
-class LIB_EXPORT AtomicBoard : public WesternBoard
+class LIB_EXPORT AtomicBoard final : public WesternBoard
 {
 	public:
 		/*! Creates a new AtomicBoard object. */
@@ -38,7 +38,7 @@ namespace Chess {
  * \note Standard Chess Rules: http://www.fide.com/component/handbook/?id=124&view=article
  * \sa PolyglotBook
  */
-class LIB_EXPORT BerolinaBoard : public StandardBoard
+class LIB_EXPORT BerolinaBoard final : public StandardBoard
 {
 	public:
 		/*! Creates a new BerolinaBoard object. */
@@ -0,0 +1,168 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "bitboards.h"
+#include <QtAlgorithms>
+
+namespace Chess {
+namespace Bitboards {
+
+namespace {
+
+// Ray directions, ordered so that the first four advance towards
+// higher square indexes and the last four towards lower ones.
+enum Direction
+{
+	NorthWest, North, NorthEast, East,
+	West, SouthWest, South, SouthEast
+};
+
+bool s_initialized = false;
+Bitboard s_knightAttacks[64];
+Bitboard s_kingAttacks[64];
+Bitboard s_rays[8][64];
+
+int lsb(Bitboard bb)
+{
+	Q_ASSERT(bb != 0);
+	return qCountTrailingZeroBits(bb);
+}
+
+int msb(Bitboard bb)
+{
+	Q_ASSERT(bb != 0);
+	return 63 - qCountLeadingZeroBits(bb);
+}
+
+Bitboard hoppingAttacks(int square, const int offsets[][2], int count)
+{
+	Bitboard attacks = 0;
+	int file = square & 7;
+	int rank = square >> 3;
+
+	for (int i = 0; i < count; i++)
+	{
+		int f = file + offsets[i][0];
+		int r = rank + offsets[i][1];
+		if (f >= 0 && f < 8 && r >= 0 && r < 8)
+			attacks |= Q_UINT64_C(1) << (r * 8 + f);
+	}
+	return attacks;
+}
+
+Bitboard ray(int square, int fileStep, int rankStep)
+{
+	Bitboard bb = 0;
+	int file = (square & 7) + fileStep;
+	int rank = (square >> 3) + rankStep;
+
+	while (file >= 0 && file < 8 && rank >= 0 && rank < 8)
+	{
+		bb |= Q_UINT64_C(1) << (rank * 8 + file);
+		file += fileStep;
+		rank += rankStep;
+	}
+	return bb;
+}
+
+Bitboard rayAttacks(Direction dir, int square, Bitboard occupied)
+{
+	Bitboard attacks = s_rays[dir][square];
+	Bitboard blockers = attacks & occupied;
+
+	if (blockers)
+	{
+		// The first blocker cuts off the rest of the ray, but
+		// is itself a valid (capture) target.
+		int blocker = (dir < West) ? lsb(blockers) : msb(blockers);
+		attacks ^= s_rays[dir][blocker];
+	}
+	return attacks;
+}
+
+} // anonymous namespace
+
+void initialize()
+{
+	if (s_initialized)
+		return;
+	s_initialized = true;
+
+	const int knightOffsets[8][2] = {
+		{-2, -1}, {-2, 1}, {-1, -2}, {-1, 2},
+		{1, -2}, {1, 2}, {2, -1}, {2, 1}
+	};
+	const int kingOffsets[8][2] = {
+		{-1, -1}, {-1, 0}, {-1, 1}, {0, -1},
+		{0, 1}, {1, -1}, {1, 0}, {1, 1}
+	};
+
+	for (int sq = 0; sq < 64; sq++)
+	{
+		s_knightAttacks[sq] = hoppingAttacks(sq, knightOffsets, 8);
+		s_kingAttacks[sq] = hoppingAttacks(sq, kingOffsets, 8);
+
+		s_rays[NorthWest][sq] = ray(sq, -1, 1);
+		s_rays[North][sq] = ray(sq, 0, 1);
+		s_rays[NorthEast][sq] = ray(sq, 1, 1);
+		s_rays[East][sq] = ray(sq, 1, 0);
+		s_rays[West][sq] = ray(sq, -1, 0);
+		s_rays[SouthWest][sq] = ray(sq, -1, -1);
+		s_rays[South][sq] = ray(sq, 0, -1);
+		s_rays[SouthEast][sq] = ray(sq, 1, -1);
+	}
+}
+
+Bitboard knightAttacks(int square)
+{
+	Q_ASSERT(square >= 0 && square < 64);
+	return s_knightAttacks[square];
+}
+
+Bitboard kingAttacks(int square)
+{
+	Q_ASSERT(square >= 0 && square < 64);
+	return s_kingAttacks[square];
+}
+
+Bitboard bishopAttacks(int square, Bitboard occupied)
+{
+	Q_ASSERT(square >= 0 && square < 64);
+	return rayAttacks(NorthWest, square, occupied)
+	     | rayAttacks(NorthEast, square, occupied)
+	     | rayAttacks(SouthWest, square, occupied)
+	     | rayAttacks(SouthEast, square, occupied);
+}
+
+Bitboard rookAttacks(int square, Bitboard occupied)
+{
+	Q_ASSERT(square >= 0 && square < 64);
+	return rayAttacks(North, square, occupied)
+	     | rayAttacks(East, square, occupied)
+	     | rayAttacks(West, square, occupied)
+	     | rayAttacks(South, square, occupied);
+}
+
+Bitboard queenAttacks(int square, Bitboard occupied)
+{
+	return bishopAttacks(square, occupied)
+	     | rookAttacks(square, occupied);
+}
+
+} // namespace Bitboards
+} // namespace Chess
@@ -0,0 +1,74 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef BITBOARDS_H
+#define BITBOARDS_H
+
+#include <QtGlobal>
+
+namespace Chess {
+
+/*!
+ * \brief Attack bitboards for 8x8 boards.
+ *
+ * This namespace provides precomputed attack tables for the standard
+ * 8x8 board. Boards for variants that use the standard geometry and
+ * piece movements (eg. StandardBoard) can use these tables as a fast
+ * alternative to walking offset arrays in the mailbox representation.
+ *
+ * Squares are indexed from 0 (a1) to 63 (h8), rank by rank, which is
+ * not the same as the padded mailbox indexing used by Board.
+ *
+ * \sa StandardBoard
+ */
+namespace Bitboards {
+
+/*! A set of 8x8 board squares, one bit per square. */
+typedef quint64 Bitboard;
+
+/*!
+ * Initializes the attack tables.
+ *
+ * This function must be called before any of the attack functions.
+ * Calling it multiple times is allowed and cheap.
+ */
+LIB_EXPORT void initialize();
+
+/*! Returns the squares attacked by a knight at \a square. */
+LIB_EXPORT Bitboard knightAttacks(int square);
+/*! Returns the squares attacked by a king at \a square. */
+LIB_EXPORT Bitboard kingAttacks(int square);
+/*!
+ * Returns the squares attacked by a bishop at \a square with
+ * the squares in \a occupied blocking its path.
+ */
+LIB_EXPORT Bitboard bishopAttacks(int square, Bitboard occupied);
+/*!
+ * Returns the squares attacked by a rook at \a square with
+ * the squares in \a occupied blocking its path.
+ */
+LIB_EXPORT Bitboard rookAttacks(int square, Bitboard occupied);
+/*!
+ * Returns the squares attacked by a queen at \a square with
+ * the squares in \a occupied blocking its path.
+ */
+LIB_EXPORT Bitboard queenAttacks(int square, Bitboard occupied);
+
+} // namespace Bitboards
+} // namespace Chess
+#endif // BITBOARDS_H
@@ -19,10 +19,14 @@
 #include "board.h"
 #include <QStringList>
 #include "zobrist.h"
+#include "scratchmoves.h"
 
 
 namespace Chess {
 
+thread_local QVarLengthArray<Move> ScratchMoveList::s_pool[ScratchMoveList::MaxDepth];
+thread_local int ScratchMoveList::s_depth = 0;
+
 QDebug operator<<(QDebug dbg, const Board* board)
 {
 	QString str = "FEN: " + board->fenString() + '\n';
@@ -56,12 +60,15 @@ Board::Board(Zobrist* zobrist)
 	: m_initialized(false),
 	  m_width(0),
 	  m_height(0),
+	  m_arraySize(0),
 	  m_side(Side::White),
 	  m_startingSide(Side::White),
 	  m_maxPieceSymbolLength(1),
 	  m_key(0),
 	  m_zobrist(zobrist),
-	  m_sharedZobrist(zobrist)
+	  m_sharedZobrist(zobrist),
+	  m_legalMoveCacheValid(false),
+	  m_legalMoveCacheKey(0)
 {
 	Q_ASSERT(zobrist != nullptr);
 
@@ -117,8 +124,10 @@ void Board::initialize()
 	m_initialized = true;
 	m_width = width();
 	m_height = height();
-	for (int i = 0; i < (m_width + 2) * (m_height + 4); i++)
-		m_squares.append(Piece::WallPiece);
+	m_arraySize = (m_width + 2) * (m_height + 4);
+	Q_ASSERT(m_arraySize <= MaxArraySize);
+	for (int i = 0; i < m_arraySize; i++)
+		m_squares[i] = Piece::WallPiece;
 	vInitialize();
 
 	m_maxPieceSymbolLength = 1;
@@ -268,7 +277,19 @@ bool Board::isValidSquare(const Chess::Square& square) const
 
 QString Board::squareString(int index) const
 {
-	return squareString(chessSquare(index));
+	// Square names never change for a given board size, so they
+	// are built once and then served from a flat table. Move
+	// notation asks for them over and over for every move of
+	// every game.
+	if (m_squareStringCache.size() != arraySize())
+		m_squareStringCache.resize(arraySize());
+	if (index < 0 || index >= m_squareStringCache.size())
+		return squareString(chessSquare(index));
+
+	QString& str = m_squareStringCache[index];
+	if (str.isEmpty())
+		str = squareString(chessSquare(index));
+	return str;
 }
 
 QString Board::squareString(const Square& square) const
@@ -384,8 +405,49 @@ QString Board::sanStringForPv(const QString& pv, MoveNotation notation)
 
 Move Board::moveFromLanString(const QString& istr)
 {
-	QString str(istr);
-	str.remove(QRegExp("[x=+#!?]"));
+	// Fast path for plain coordinate moves like "e2e4" and
+	// "e7e8q", which is what engines send on the move-relay
+	// path: parse the characters directly instead of slicing
+	// substrings.
+	const int size = istr.size();
+	if (coordinateSystem() == NormalCoordinates
+	&&  m_height <= 9
+	&&  (size == 4 || size == 5))
+	{
+		const QChar* u = istr.unicode();
+		const int sfile = u[0].toLatin1() - 'a';
+		const int srank = u[1].toLatin1() - '1';
+		const int tfile = u[2].toLatin1() - 'a';
+		const int trank = u[3].toLatin1() - '1';
+		int promotionType = Piece::NoPiece;
+
+		bool ok = sfile >= 0 && sfile < m_width
+		       && srank >= 0 && srank < m_height
+		       && tfile >= 0 && tfile < m_width
+		       && trank >= 0 && trank < m_height;
+		if (ok && size == 5)
+		{
+			Piece promotion(pieceFromSymbol(QString(u[4])));
+			if (promotion.isValid())
+				promotionType = promotion.type();
+			else
+				ok = false;
+		}
+		if (ok)
+			return Move(squareIndex(Square(sfile, srank)),
+				    squareIndex(Square(tfile, trank)),
+				    promotionType);
+	}
+
+	QString str;
+	str.reserve(size);
+	for (int i = 0; i < size; i++)
+	{
+		const QChar c = istr.at(i);
+		if (c != 'x' && c != '=' && c != '+'
+		&&  c != '#' && c != '!' && c != '?')
+			str += c;
+	}
 	int len = str.length();
 	if (len < 4)
 		return Move();
@@ -476,6 +538,10 @@ QStringList Board::pieceList(Side side) const
 
 QString Board::fenString(FenNotation notation) const
 {
+	QString& cached = m_fenCache[notation];
+	if (!cached.isEmpty())
+		return cached;
+
 	QString fen;
 
 	// Squares
@@ -531,7 +597,8 @@ QString Board::fenString(FenNotation notation) const
 	// Side to move
 	fen += QString(" %1 ").arg(m_side.symbol());
 
-	return fen + vFenString(notation);
+	cached = fen + vFenString(notation);
+	return cached;
 }
 
 bool Board::setFenString(const QString& fen)
@@ -551,9 +618,12 @@ bool Board::setFenString(const QString& fen)
 	int boardSize = m_width * m_height;
 	int k = (m_width + 2) * 2 + 1;
 
-	for (int i = 0; i < m_squares.size(); i++)
+	for (int i = 0; i < m_arraySize; i++)
 		m_squares[i] = Piece::WallPiece;
 	m_key = 0;
+	m_legalMoveCacheValid = false;
+	m_fenCache[XFen].clear();
+	m_fenCache[ShredderFen].clear();
 
 	// Get the board contents (squares)
 	int handPieceIndex = -1;
@@ -678,6 +748,7 @@ bool Board::setFenString(const QString& fen)
 		return false;
 
 	m_moveHistory.clear();
+	m_repetitions.clear();
 	m_startingFen = fen;
 
 	// Let subclasses handle the rest of the FEN string
@@ -708,11 +779,15 @@ void Board::makeMove(const Move& move, BoardTransition* transition)
 
 	MoveData md = { move, m_key };
 
+	m_legalMoveCacheValid = false;
+	m_fenCache[XFen].clear();
+	m_fenCache[ShredderFen].clear();
 	vMakeMove(move, transition);
 
 	xorKey(m_zobrist->side());
 	m_side = m_side.opposite();
 	m_moveHistory << md;
+	m_repetitions[md.key]++;
 }
 
 void Board::undoMove()
@@ -720,11 +795,19 @@ void Board::undoMove()
 	Q_ASSERT(!m_moveHistory.isEmpty());
 	Q_ASSERT(!m_side.isNull());
 
+	m_legalMoveCacheValid = false;
+	m_fenCache[XFen].clear();
+	m_fenCache[ShredderFen].clear();
 	m_side = m_side.opposite();
 	vUndoMove(m_moveHistory.last().move);
 
 	m_key = m_moveHistory.last().key;
 	m_moveHistory.pop_back();
+
+	QHash<quint64, int>::iterator it = m_repetitions.find(m_key);
+	Q_ASSERT(it != m_repetitions.end());
+	if (--it.value() <= 0)
+		m_repetitions.erase(it);
 }
 
 void Board::generateMoves(QVarLengthArray<Move>& moves, int pieceType) const
@@ -734,7 +817,7 @@ void Board::generateMoves(QVarLengthArray<Move>& moves, int pieceType) const
 	// Cut the wall squares (the ones with a value of WallPiece) off
 	// from the squares to iterate over. It bumps the speed up a bit.
 	unsigned begin = (m_width + 2) * 2;
-	unsigned end = m_squares.size() - begin;
+	unsigned end = m_arraySize - begin;
 
 	moves.clear();
 	for (unsigned sq = begin; sq < end; sq++)
@@ -809,7 +892,8 @@ bool Board::moveExists(const Move& move) const
 	Q_ASSERT(!move.isNull());
 
 	int source = move.sourceSquare();
-	QVarLengthArray<Move> moves;
+	ScratchMoveList scratch;
+	QVarLengthArray<Move>& moves = *scratch;
 
 	if (source == 0)
 		generateDropMoves(moves, move.promotion());
@@ -860,14 +944,10 @@ int Board::repeatCount() const
 	if (plyCount() < 4)
 		return 0;
 
-	int repeatCount = 0;
-	for (int i = plyCount() - 1; i >= 0; i--)
-	{
-		if (m_moveHistory.at(i).key == m_key)
-			repeatCount++;
-	}
-
-	return repeatCount;
+	// The position keys in the move history are counted incrementally
+	// in makeMove() and undoMove(), so late-game positions don't pay
+	// for a linear history scan.
+	return m_repetitions.value(m_key, 0);
 }
 
 int Board::reversibleMoveCount() const
@@ -888,7 +968,14 @@ bool Board::isRepetition(const Chess::Move& move)
 
 bool Board::canMove()
 {
-	QVarLengthArray<Move> moves;
+	// If the legal moves of this position were already generated,
+	// their count answers the question without another generation
+	// pass.
+	if (m_legalMoveCacheValid && m_legalMoveCacheKey == m_key)
+		return !m_legalMoveCache.isEmpty();
+
+	ScratchMoveList scratch;
+	QVarLengthArray<Move>& moves = *scratch;
 	generateMoves(moves);
 
 	for (int i = 0; i < moves.size(); i++)
@@ -902,7 +989,13 @@ bool Board::canMove()
 
 QVector<Move> Board::legalMoves()
 {
-	QVarLengthArray<Move> moves;
+	// ChessGame, result() and the GUI all query the same position
+	// repeatedly, so the last result is cached by zobrist key.
+	if (m_legalMoveCacheValid && m_legalMoveCacheKey == m_key)
+		return m_legalMoveCache;
+
+	ScratchMoveList scratch;
+	QVarLengthArray<Move>& moves = *scratch;
 	QVector<Move> legalMoves;
 
 	generateMoves(moves);
@@ -914,6 +1007,13 @@ QVector<Move> Board::legalMoves()
 			legalMoves << moves[i];
 	}
 
+	// The legality checks above made and unmade moves, which cleared
+	// the valid flag; set the cache only now that the position is
+	// back to the one the moves were generated for.
+	m_legalMoveCacheKey = m_key;
+	m_legalMoveCache = legalMoves;
+	m_legalMoveCacheValid = true;
+
 	return legalMoves;
 }
 
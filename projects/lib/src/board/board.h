@@ -19,8 +19,10 @@
 #ifndef BOARD_H
 #define BOARD_H
 
+#include <array>
 #include <QString>
 #include <QVector>
+#include <QHash>
 #include <QVarLengthArray>
 #include <QSharedPointer>
 #include <QDebug>
@@ -51,8 +53,8 @@ class BoardTransition;
  *
  * \internal
  * The board representation is (width + 2) x (height + 4), so a
- * traditional 8x8 board would be 10x12, and stored in a one-dimensional
- * vector with 10 * 12 = 120 elements.
+ * traditional 8x8 board uses 10 * 12 = 120 elements of a fixed-size
+ * one-dimensional array sized for the largest supported variant.
  */
 class LIB_EXPORT Board
 {
@@ -101,6 +103,21 @@ class LIB_EXPORT Board
 			ShredderFen
 		};
 
+		/*! Maximum board width supported by any variant. */
+		static const int MaxWidth = 12;
+		/*! Maximum board height supported by any variant. */
+		static const int MaxHeight = 12;
+		/*!
+		 * Maximum size of the board array, including the
+		 * two-file and four-rank wall padding.
+		 *
+		 * The square array has this fixed size regardless of
+		 * the variant's dimensions, so square accesses index
+		 * directly into the object instead of going through a
+		 * heap pointer.
+		 */
+		static const int MaxArraySize = (MaxWidth + 2) * (MaxHeight + 4);
+
 		/*!
 		 * Creates a new Board object.
 		 *
@@ -171,6 +188,9 @@ class LIB_EXPORT Board
 		/*!
 		 * Returns the FEN string of the current board position in
 		 * X-Fen or Shredder FEN notation
+		 *
+		 * The string is cached between calls and rebuilt only
+		 * after the position has changed.
 		 */
 		QString fenString(FenNotation notation = XFen) const;
 		/*!
@@ -284,7 +304,13 @@ class LIB_EXPORT Board
 		 * reached earlier in the game.
 		 */
 		bool isRepetition(const Move& move);
-		/*! Returns a vector of legal moves in the current position. */
+		/*!
+		 * Returns a vector of legal moves in the current position.
+		 *
+		 * The result is cached by zobrist key, so repeated calls for
+		 * the same position are cheap. The cache is invalidated by
+		 * makeMove(), undoMove() and setFenString().
+		 */
 		QVector<Move> legalMoves();
 		/*!
 		 * Returns the result of the game, or Result::NoResult if
@@ -534,6 +560,7 @@ class LIB_EXPORT Board
 		bool m_initialized;
 		int m_width;
 		int m_height;
+		int m_arraySize;
 		Side m_side;
 		Side m_startingSide;
 		QString m_startingFen;
@@ -542,9 +569,18 @@ class LIB_EXPORT Board
 		Zobrist* m_zobrist;
 		QSharedPointer<Zobrist> m_sharedZobrist;
 		QVarLengthArray<PieceData> m_pieceData;
-		QVarLengthArray<Piece> m_squares;
+		std::array<Piece, MaxArraySize> m_squares;
 		QVector<MoveData> m_moveHistory;
 		QVector<int> m_reserve[2];
+		QHash<quint64, int> m_repetitions;
+		bool m_legalMoveCacheValid;
+		quint64 m_legalMoveCacheKey;
+		QVector<Move> m_legalMoveCache;
+		// Cached FEN strings indexed by notation, built on demand
+		// and cleared when the position changes
+		mutable QString m_fenCache[2];
+		// Square names indexed by square index, built on demand
+		mutable QVector<QString> m_squareStringCache;
 };
 
 
@@ -552,7 +588,7 @@ extern LIB_EXPORT QDebug operator<<(QDebug dbg, const Board* board);
 
 inline int Board::arraySize() const
 {
-	return m_squares.size();
+	return m_arraySize;
 }
 
 inline Side Board::sideToMove() const
@@ -589,9 +625,9 @@ inline void Board::setSquare(int square, Piece piece)
 {
 	Piece& old = m_squares[square];
 	if (old.isValid())
-		xorKey(m_zobrist->piece(old, square));
+		xorKey(m_zobrist->pieceKey(old.side(), old.type(), square));
 	if (piece.isValid())
-		xorKey(m_zobrist->piece(piece, square));
+		xorKey(m_zobrist->pieceKey(piece.side(), piece.type(), square));
 
 	old = piece;
 }
@@ -17,6 +17,12 @@
 */
 
 #include "boardfactory.h"
+#include "frcboard.h"
+#include "standardboard.h"
+// A minimal_variants build (see board.pri) only registers standard
+// chess and Fischerandom, leaving the other variants out of the
+// binary entirely.
+#ifndef MINIMAL_VARIANTS
 #include "aiwokboard.h"
 #include "almostboard.h"
 #include "amazonboard.h"
@@ -36,7 +42,6 @@
 #include "crazyhouseboard.h"
 #include "embassyboard.h"
 #include "extinctionboard.h"
-#include "frcboard.h"
 #include "giveawayboard.h"
 #include "gothicboard.h"
 #include "grandboard.h"
@@ -58,13 +63,17 @@
 #include "seirawanboard.h"
 #include "shatranjboard.h"
 #include "sittuyinboard.h"
-#include "standardboard.h"
 #include "suicideboard.h"
 #include "threekingsboard.h"
 #include "twokingseachboard.h"
+#endif // !MINIMAL_VARIANTS
 
 namespace Chess {
 
+REGISTER_BOARD(FrcBoard, "fischerandom")
+REGISTER_BOARD(StandardBoard, "standard")
+
+#ifndef MINIMAL_VARIANTS
 REGISTER_BOARD(ThreeCheckBoard, "3check")
 REGISTER_BOARD(FiveCheckBoard, "5check")
 REGISTER_BOARD(AiWokBoard, "ai-wok")
@@ -92,7 +101,6 @@ REGISTER_BOARD(DisplacedGridBoard, "displacedgrid")
 REGISTER_BOARD(EmbassyBoard, "embassy")
 REGISTER_BOARD(ExtinctionBoard, "extinction")
 REGISTER_BOARD(KingletBoard, "kinglet")
-REGISTER_BOARD(FrcBoard, "fischerandom")
 REGISTER_BOARD(GiveawayBoard, "giveaway")
 REGISTER_BOARD(GothicBoard, "gothic")
 REGISTER_BOARD(GrandBoard, "grand")
@@ -116,12 +124,12 @@ REGISTER_BOARD(ShatranjBoard, "shatranj")
 REGISTER_BOARD(SimplifiedGryphonBoard, "simplifiedgryphon")
 REGISTER_BOARD(SittuyinBoard, "sittuyin")
 REGISTER_BOARD(SlippedGridBoard, "slippedgrid")
-REGISTER_BOARD(StandardBoard, "standard")
 REGISTER_BOARD(SuicideBoard, "suicide")
 REGISTER_BOARD(SuperAndernachBoard, "superandernach")
 REGISTER_BOARD(ThreeKingsBoard, "threekings")
 REGISTER_BOARD(TwoKingsEachBoard, "twokings")
 REGISTER_BOARD(TwoKingsSymmetricalBoard, "twokingssymmetric")
+#endif // !MINIMAL_VARIANTS
 
 
 ClassRegistry<Board>* BoardFactory::registry()
@@ -0,0 +1,54 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "boardpool.h"
+#include "boardfactory.h"
+
+
+namespace Chess {
+
+BoardPool::BoardPool()
+{
+}
+
+BoardPool::~BoardPool()
+{
+	qDeleteAll(m_boards);
+}
+
+Board* BoardPool::acquire(const QString& variant)
+{
+	QMultiHash<QString, Board*>::iterator it = m_boards.find(variant);
+	if (it != m_boards.end())
+	{
+		Board* board = it.value();
+		m_boards.erase(it);
+		return board;
+	}
+
+	return BoardFactory::create(variant);
+}
+
+void BoardPool::release(Board* board)
+{
+	if (board == nullptr)
+		return;
+	m_boards.insert(board->variant(), board);
+}
+
+} // namespace Chess
@@ -0,0 +1,75 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef BOARDPOOL_H
+#define BOARDPOOL_H
+
+#include <QMultiHash>
+#include <QString>
+
+namespace Chess {
+
+class Board;
+
+/*!
+ * \brief A pool of reusable Board objects.
+ *
+ * Code that needs a transient board for one variant — replaying a PGN,
+ * walking a PV, probing a tablebase — usually allocates a full Board
+ * with all of its piece and history arrays and throws it away moments
+ * later. When this happens once per move in every concurrent game the
+ * allocation churn shows up in malloc profiles.
+ *
+ * BoardPool keeps released boards per variant and hands them out
+ * again, so a steady-state caller allocates each transient board only
+ * once. The pool is not thread-safe; use one pool per thread.
+ *
+ * \sa BoardFactory
+ */
+class LIB_EXPORT BoardPool
+{
+	public:
+		/*! Creates a new empty BoardPool. */
+		BoardPool();
+		/*! Destroys the pool and all pooled boards. */
+		~BoardPool();
+
+		/*!
+		 * Returns a board of variant \a variant.
+		 *
+		 * A pooled board is reused if available; otherwise a new
+		 * one is created with BoardFactory. The caller must set a
+		 * position with Board::setFenString() before using the
+		 * board. Returns 0 if \a variant is not supported.
+		 */
+		Board* acquire(const QString& variant);
+		/*!
+		 * Returns \a board to the pool for reuse.
+		 *
+		 * The board must have been acquired from this pool.
+		 */
+		void release(Board* board);
+
+	private:
+		Q_DISABLE_COPY(BoardPool)
+
+		QMultiHash<QString, Board*> m_boards;
+};
+
+} // namespace Chess
+#endif // BOARDPOOL_H
@@ -40,22 +40,22 @@ void BoardTransition::clear()
 	m_reserve.clear();
 }
 
-QList<BoardTransition::Move> BoardTransition::moves() const
+const BoardTransition::MoveList& BoardTransition::moves() const
 {
 	return m_moves;
 }
 
-QList<BoardTransition::Drop> BoardTransition::drops() const
+const BoardTransition::DropList& BoardTransition::drops() const
 {
 	return m_drops;
 }
 
-QList<Square> BoardTransition::squares() const
+const BoardTransition::SquareList& BoardTransition::squares() const
 {
 	return m_squares;
 }
 
-QList<Piece> BoardTransition::reserve() const
+const BoardTransition::ReserveList& BoardTransition::reserve() const
 {
 	return m_reserve;
 }
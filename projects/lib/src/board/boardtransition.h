@@ -19,7 +19,7 @@
 #ifndef BOARDTRANSITION_H
 #define BOARDTRANSITION_H
 
-#include <QList>
+#include <QVarLengthArray>
 #include "square.h"
 #include "piece.h"
 
@@ -59,12 +59,31 @@ class LIB_EXPORT BoardTransition
 			Square target;	//!< Target square of the drop
 		};
 
+		/*!
+		 * The lists are stored inline in the transition with
+		 * capacities that cover any single move of the supported
+		 * variants, so filling and reusing a transition normally
+		 * never touches the heap.
+		 */
+		typedef QVarLengthArray<Move, 4> MoveList;
+		/*! List type for piece drops. */
+		typedef QVarLengthArray<Drop, 2> DropList;
+		/*! List type for changed squares. */
+		typedef QVarLengthArray<Square, 16> SquareList;
+		/*! List type for changed piece reserves. */
+		typedef QVarLengthArray<Piece, 4> ReserveList;
+
 		/*! Creates a new empty BoardTransition object. */
 		BoardTransition();
 
 		/*! Returns true if there are no transitions. */
 		bool isEmpty() const;
-		/*! Clears all data, ie. empties the transition. */
+		/*!
+		 * Clears all data, ie. empties the transition.
+		 *
+		 * The storage is retained, so a cleared transition can
+		 * be refilled without allocating.
+		 */
 		void clear();
 
 		/*!
@@ -73,13 +92,13 @@ class LIB_EXPORT BoardTransition
 		 * One chessmove can involve several moving pieces, and
 		 * the actual chessmove may not be on the returned list.
 		 */
-		QList<Move> moves() const;
+		const MoveList& moves() const;
 		/*! Returns a list of piece drops. */
-		QList<Drop> drops() const;
+		const DropList& drops() const;
 		/*! Returns a list of changed squares. */
-		QList<Square> squares() const;
+		const SquareList& squares() const;
 		/*! Returns a list of changed piece reserves. */
-		QList<Piece> reserve() const;
+		const ReserveList& reserve() const;
 
 		/*! Adds a new "move" from \a source to \a target. */
 		void addMove(const Square& source, const Square& target);
@@ -101,10 +120,10 @@ class LIB_EXPORT BoardTransition
 		void addReservePiece(const Piece& piece);
 
 	private:
-		QList<Move> m_moves;
-		QList<Drop> m_drops;
-		QList<Square> m_squares;
-		QList<Piece> m_reserve;
+		MoveList m_moves;
+		DropList m_drops;
+		SquareList m_squares;
+		ReserveList m_reserve;
 };
 
 } // namespace Chess
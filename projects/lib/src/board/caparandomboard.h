@@ -33,7 +33,7 @@ namespace Chess {
  * \sa CapablancaBoard
  * \sa FrcBoard
  */
-class LIB_EXPORT CaparandomBoard : public CapablancaBoard
+class LIB_EXPORT CaparandomBoard final : public CapablancaBoard
 {
 	public:
 		/*! Creates a new CaparandomBoard object. */
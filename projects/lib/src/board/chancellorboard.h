@@ -42,7 +42,7 @@ namespace Chess {
  * \sa CapablancaBoard
  * \sa ModernBoard
  */
-class LIB_EXPORT ChancellorBoard : public WesternBoard
+class LIB_EXPORT ChancellorBoard final : public WesternBoard
 {
 	public:
 		/*! Creates a new ChancellorBoard object. */
@@ -35,7 +35,7 @@ namespace Chess {
  *
  * \note Rules: https://en.wikipedia.org/wiki/Checkless_chess
  * */
-class LIB_EXPORT ChecklessBoard : public WesternBoard
+class LIB_EXPORT ChecklessBoard final : public WesternBoard
 {
 	public:
 		/*! Creates a new ChecklessBoard object. */
@@ -38,7 +38,7 @@ namespace Chess {
  * \note Rules: http://www.chessvariants.com/other.dir/chessgi.html
  *
  */
-class LIB_EXPORT ChessgiBoard : public LoopBoard
+class LIB_EXPORT ChessgiBoard final : public LoopBoard
 {
 	public:
 		/*! Creates a new ChessgiBoard object. */
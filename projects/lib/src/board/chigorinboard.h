@@ -40,7 +40,7 @@ namespace Chess {
  *
  * \sa ChancellorBoard
  */
-class LIB_EXPORT ChigorinBoard : public WesternBoard
+class LIB_EXPORT ChigorinBoard final : public WesternBoard
 {
 	public:
 		/*! Creates a new ChigorinBoard object. */
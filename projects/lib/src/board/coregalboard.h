@@ -37,7 +37,7 @@ namespace Chess {
  */
 
 
-class LIB_EXPORT CoRegalBoard : public WesternBoard
+class LIB_EXPORT CoRegalBoard final : public WesternBoard
 {
 	public:
 		/*! Creates a new CoregalBoard object. */
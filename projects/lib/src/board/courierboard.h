@@ -51,7 +51,7 @@ namespace Chess {
  *
  * \note Rules: http://en.wikipedia.org/wiki/Courier_chess
  */
-class LIB_EXPORT CourierBoard : public ShatranjBoard
+class LIB_EXPORT CourierBoard final : public ShatranjBoard
 {
 	public:
 		/*! Creates a new CourierBoard object. */
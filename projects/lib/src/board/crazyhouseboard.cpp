@@ -17,13 +17,16 @@
 */
 
 #include "crazyhouseboard.h"
+#include <QtAlgorithms>
 #include "westernzobrist.h"
 #include "boardtransition.h"
 
 namespace Chess {
 
 CrazyhouseBoard::CrazyhouseBoard()
-	: WesternBoard(new WesternZobrist())
+	: WesternBoard(new WesternZobrist()),
+	  m_emptySquareMaskValid(false),
+	  m_emptySquareMaskKey(0)
 {
 	setPieceType(PromotedKnight, tr("promoted knight"), "N~", KnightMovement);
 	setPieceType(PromotedBishop, tr("promoted bishop"), "B~", BishopMovement);
@@ -217,6 +220,41 @@ bool CrazyhouseBoard::pawnDropOkOnRank(int rank) const
 	return rank > 0 && rank < height() - 1;
 }
 
+void CrazyhouseBoard::updateDropMasks() const
+{
+	const int size = arraySize();
+	const int words = (size + 63) / 64;
+
+	// The geometry-dependent pawn mask only needs to be built once
+	if (m_pawnDropMask.size() != words)
+	{
+		m_pawnDropMask.resize(words);
+		for (int w = 0; w < words; w++)
+			m_pawnDropMask[w] = 0;
+		for (int i = 0; i < size; i++)
+		{
+			Square sq(chessSquare(i));
+			if (sq.isValid() && pawnDropOkOnRank(sq.rank()))
+				m_pawnDropMask[i / 64] |= Q_UINT64_C(1) << (i % 64);
+		}
+		m_emptySquareMask.resize(words);
+		m_emptySquareMaskValid = false;
+	}
+
+	if (m_emptySquareMaskValid && m_emptySquareMaskKey == key())
+		return;
+
+	for (int w = 0; w < words; w++)
+		m_emptySquareMask[w] = 0;
+	for (int i = 0; i < size; i++)
+	{
+		if (pieceAt(i).isEmpty())
+			m_emptySquareMask[i / 64] |= Q_UINT64_C(1) << (i % 64);
+	}
+	m_emptySquareMaskValid = true;
+	m_emptySquareMaskKey = key();
+}
+
 void CrazyhouseBoard::generateMovesForPiece(QVarLengthArray<Move>& moves,
 					    int pieceType,
 					    int square) const
@@ -224,19 +262,20 @@ void CrazyhouseBoard::generateMovesForPiece(QVarLengthArray<Move>& moves,
 	// Generate drops
 	if (square == 0)
 	{
-		const int size = arraySize();
-		for (int i = 0; i < size; i++)
+		updateDropMasks();
+
+		const int words = m_emptySquareMask.size();
+		for (int w = 0; w < words; w++)
 		{
-			Piece tmp = pieceAt(i);
-			if (!tmp.isEmpty())
-				continue;
+			quint64 bits = m_emptySquareMask[w];
 			if (pieceType == Pawn)
+				bits &= m_pawnDropMask[w];
+			while (bits)
 			{
-				Square sq(chessSquare(i));
-				if (!pawnDropOkOnRank(sq.rank()))
-					continue;
+				int i = w * 64 + qCountTrailingZeroBits(bits);
+				bits &= bits - 1;
+				moves.append(Move(0, i, pieceType));
 			}
-			moves.append(Move(0, i, pieceType));
 		}
 	}
 	else
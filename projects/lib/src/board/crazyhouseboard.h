@@ -84,6 +84,19 @@ class LIB_EXPORT CrazyhouseBoard : public WesternBoard
 		static int normalPieceType(int type);
 		void normalizePieces(Piece piece, QVarLengthArray<int>& squares);
 		void restorePieces(Piece piece, const QVarLengthArray<int>& squares);
+		// Rebuilds the drop masks below if they're stale
+		void updateDropMasks() const;
+
+		// Bitmask of empty squares, rebuilt lazily when the
+		// position key changes so that drop generation iterates
+		// set bits instead of scanning the whole board once per
+		// reserve piece type
+		mutable QVarLengthArray<quint64, 4> m_emptySquareMask;
+		mutable bool m_emptySquareMaskValid;
+		mutable quint64 m_emptySquareMaskKey;
+		// Squares where pawn drops are allowed; depends only on
+		// the board's geometry
+		mutable QVarLengthArray<quint64, 4> m_pawnDropMask;
 };
 
 } // namespace Chess
@@ -36,7 +36,7 @@ namespace Chess {
  * \sa CapablancaBoard
  * \sa GothicBoard
  */
-class LIB_EXPORT EmbassyBoard : public CapablancaBoard
+class LIB_EXPORT EmbassyBoard final : public CapablancaBoard
 {
 	public:
 		/*! Creates a new EmbassyBoard object. */
@@ -64,6 +64,13 @@ bool ExtinctionBoard::inCheck(Side, int) const
 	return false;
 }
 
+bool ExtinctionBoard::hasStagedLegalityFilter() const
+{
+	// The king isn't royal, so there are no pins or checks for
+	// the analysis to find
+	return false;
+}
+
 Piece ExtinctionBoard::extinctPiece(Side side) const
 {
 	for (const int type: m_pieceSet)
@@ -64,6 +64,7 @@ class LIB_EXPORT ExtinctionBoard : public StandardBoard
 		virtual bool kingsCountAssertion(int whiteKings,
 						 int blackKings) const;
 		virtual bool inCheck(Side side, int square = 0) const;
+		virtual bool hasStagedLegalityFilter() const;
 		virtual void addPromotions(int sourceSquare,
 					   int targetSquare,
 					   QVarLengthArray<Move>& moves) const;
@@ -90,7 +91,7 @@ class LIB_EXPORT ExtinctionBoard : public StandardBoard
  * \note Rules: https://en.wikipedia.org/wiki/V._R._Parton#Kinglet_Chess
  * \sa Extinction Chess
  */
-class LIB_EXPORT KingletBoard : public ExtinctionBoard
+class LIB_EXPORT KingletBoard final : public ExtinctionBoard
 {
 	public:
 		KingletBoard();
@@ -66,16 +66,29 @@ bool FrcBoard::isRandomVariant() const
 	return true;
 }
 
-QString FrcBoard::defaultFenString() const
+QString FrcBoard::fenFromNumber(int number) const
 {
+	// The possible knight placements on the five squares that are
+	// left after the bishops and the queen, in numbering order
+	static const int knightPos[10][2] = {
+		{0, 1}, {0, 2}, {0, 3}, {0, 4}, {1, 2},
+		{1, 3}, {1, 4}, {2, 3}, {2, 4}, {3, 4}
+	};
+
 	const int empty = Piece::NoPiece;
 	QVector<int> pieces(8, empty);
 
-	addPiece(pieces, Bishop, Mersenne::random() % 4, 0, 2);
-	addPiece(pieces, Bishop, Mersenne::random() % 4, 1, 2);
-	addPiece(pieces, Queen, Mersenne::random() % 6);
-	addPiece(pieces, Knight, Mersenne::random() % 5);
-	addPiece(pieces, Knight, Mersenne::random() % 4);
+	// Derive the arrangement from the position number with the
+	// standard Chess960 numbering scheme, so that eg. position
+	// 518 is the standard chess starting position
+	addPiece(pieces, Bishop, number % 4, 1, 2);
+	number /= 4;
+	addPiece(pieces, Bishop, number % 4, 0, 2);
+	number /= 4;
+	addPiece(pieces, Queen, number % 6);
+	number /= 6;
+	addPiece(pieces, Knight, knightPos[number][0]);
+	addPiece(pieces, Knight, knightPos[number][1] - 1);
 	addPiece(pieces, Rook, 0);
 	addPiece(pieces, King, 0);
 	addPiece(pieces, Rook, 0);
@@ -109,4 +122,27 @@ QString FrcBoard::defaultFenString() const
 	return fen;
 }
 
+QString FrcBoard::startingFenString(int number) const
+{
+	Q_ASSERT(number >= 0 && number < 960);
+
+	// Generate all 960 arrangements once; after that a setup is
+	// just a lookup by position number
+	static const QVector<QString> fens = [this]()
+	{
+		QVector<QString> fens;
+		fens.reserve(960);
+		for (int i = 0; i < 960; i++)
+			fens.append(fenFromNumber(i));
+		return fens;
+	}();
+
+	return fens.at(number);
+}
+
+QString FrcBoard::defaultFenString() const
+{
+	return startingFenString(Mersenne::random() % 960);
+}
+
 } // namespace Chess
@@ -35,12 +35,23 @@ namespace Chess {
  * \sa StandardBoard
  * \sa CaparandomBoard
  */
-class LIB_EXPORT FrcBoard : public StandardBoard
+class LIB_EXPORT FrcBoard final : public StandardBoard
 {
 	public:
 		/*! Creates a new FrcBoard object. */
 		FrcBoard();
 
+		/*!
+		 * Returns the starting FEN string of Chess960 position
+		 * \a number (0 to 959, standard numbering scheme).
+		 *
+		 * The FEN strings of all 960 positions are generated
+		 * once and cached, so repeated setups are cheap and
+		 * distributed workers only need to agree on a position
+		 * number.
+		 */
+		QString startingFenString(int number) const;
+
 		// Inherited from StandardBoard
 		virtual Board* copy() const;
 		virtual QString variant() const;
@@ -53,6 +64,9 @@ class LIB_EXPORT FrcBoard : public StandardBoard
 		 * this function.
 		 */
 		virtual QString defaultFenString() const;
+
+	private:
+		QString fenFromNumber(int number) const;
 };
 
 } // namespace Chess
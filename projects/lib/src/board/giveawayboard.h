@@ -44,7 +44,7 @@ namespace Chess {
  * \note Standard Chess Rules: http://www.fide.com/component/handbook/?id=124&view=article
  * \sa PolyglotBook
  */
-class LIB_EXPORT GiveawayBoard : public AntiBoard
+class LIB_EXPORT GiveawayBoard final : public AntiBoard
 {
 	public:
 		/*! Creates a new GiveawayBoard object. */
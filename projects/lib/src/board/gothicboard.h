@@ -32,7 +32,7 @@ namespace Chess {
  * \note Rules: http://www.gothicchess.com/rules.html
  * \sa CapablancaBoard
  */
-class LIB_EXPORT GothicBoard : public CapablancaBoard
+class LIB_EXPORT GothicBoard final : public CapablancaBoard
 {
 	public:
 		/*! Creates a new GothicBoard object. */
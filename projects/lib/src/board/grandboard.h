@@ -50,7 +50,7 @@ namespace Chess {
  * \sa CapablancaBoard
  * \sa EmbassyBoard
  */
-class LIB_EXPORT GrandBoard : public CapablancaBoard
+class LIB_EXPORT GrandBoard final : public CapablancaBoard
 {
 	public:
 		/*! Creates a new GrandBoard object. */
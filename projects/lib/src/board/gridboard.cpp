@@ -20,7 +20,11 @@
 
 namespace Chess {
 
-GridBoard::GridBoard() : RestrictedMoveBoard() {}
+GridBoard::GridBoard()
+	: RestrictedMoveBoard(),
+	  m_maskWords(0)
+{
+}
 
 Board* GridBoard::copy() const
 {
@@ -37,6 +41,30 @@ QString GridBoard::defaultFenString() const
 	return "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
 }
 
+void GridBoard::vInitialize()
+{
+	RestrictedMoveBoard::vInitialize();
+
+	// Tabulate the region-leaving relation for all square pairs,
+	// using the grid displacement of the concrete variant
+	const int size = arraySize();
+	const int fs = gridFileShift();
+	const int rs = gridRankShift();
+
+	m_maskWords = (size + 63) / 64;
+	m_regionMask.clear();
+	m_regionMask.resize(size * m_maskWords);
+	for (int source = 0; source < size; source++)
+	{
+		for (int target = 0; target < size; target++)
+		{
+			if (leavesRegion(Move(source, target), fs, rs))
+				m_regionMask[source * m_maskWords + target / 64] |=
+					Q_UINT64_C(1) << (target % 64);
+		}
+	}
+}
+
 bool GridBoard::leavesRegion(const Move& move, int fs, int rs) const
 {
 	Square sourceSq = chessSquare(move.sourceSquare());
@@ -46,9 +74,22 @@ bool GridBoard::leavesRegion(const Move& move, int fs, int rs) const
 	||      (sourceSq.rank() - rs) / 2 != (targetSq.rank() - rs) / 2;
 }
 
+int GridBoard::gridFileShift() const
+{
+	return 0;
+}
+
+int GridBoard::gridRankShift() const
+{
+	return 0;
+}
+
 bool GridBoard::restriction(const Move& move, bool) const
 {
-	return leavesRegion(move);
+	const int target = move.targetSquare();
+	const quint64 word =
+		m_regionMask[move.sourceSquare() * m_maskWords + target / 64];
+	return (word & (Q_UINT64_C(1) << (target % 64))) != 0;
 }
 
 
@@ -70,9 +111,14 @@ QString DisplacedGridBoard::defaultFenString() const
 	return "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
 }
 
-bool DisplacedGridBoard::restriction(const Move& move, bool) const
+int DisplacedGridBoard::gridFileShift() const
+{
+	return -1;
+}
+
+int DisplacedGridBoard::gridRankShift() const
 {
-	return leavesRegion(move, -1, -1);
+	return -1;
 }
 
 
@@ -94,9 +140,9 @@ QString SlippedGridBoard::defaultFenString() const
 	return "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
 }
 
-bool SlippedGridBoard::restriction(const Move& move, bool) const
+int SlippedGridBoard::gridFileShift() const
 {
-	return leavesRegion(move, -1, 0);
+	return -1;
 }
 
 
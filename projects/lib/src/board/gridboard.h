@@ -50,9 +50,15 @@ class LIB_EXPORT GridBoard : public RestrictedMoveBoard
 
 	protected:
 		// Inherited from RestrictedMoveBoard
+		virtual void vInitialize();
 		virtual bool restriction(const Move& move,
 					 bool reverse = false) const;
 
+		/*! Returns the file displacement of the grid. */
+		virtual int gridFileShift() const;
+		/*! Returns the rank displacement of the grid. */
+		virtual int gridRankShift() const;
+
 		/*!
 		 * Returns true if the \a move targets a different region
 		 * else false. Possible displacement of the grid is given by
@@ -61,6 +67,13 @@ class LIB_EXPORT GridBoard : public RestrictedMoveBoard
 		bool leavesRegion(const Move& move,
 				  int fs = 0,
 				  int rs = 0) const;
+
+	private:
+		// Per-source-square bitmasks of region-leaving target
+		// squares, built once at initialization so restriction()
+		// is a single load and mask instead of coordinate math
+		int m_maskWords;
+		QVector<quint64> m_regionMask;
 };
 
 /*!
@@ -76,7 +89,7 @@ class LIB_EXPORT GridBoard : public RestrictedMoveBoard
  *
  * \note Rules: http://en.wikipedia.org/wiki/Grid_chess
  */
-class LIB_EXPORT DisplacedGridBoard : public GridBoard
+class LIB_EXPORT DisplacedGridBoard final : public GridBoard
 {
 	public:
 		/*! Creates a new DisplacedGridBoard object. */
@@ -89,8 +102,8 @@ class LIB_EXPORT DisplacedGridBoard : public GridBoard
 
 	protected:
 		// Inherited from GridBoard
-		virtual bool restriction(const Move& move,
-					 bool reverse = false) const;
+		virtual int gridFileShift() const;
+		virtual int gridRankShift() const;
 };
 
 /*!
@@ -104,7 +117,7 @@ class LIB_EXPORT DisplacedGridBoard : public GridBoard
  *
  * \note Rules: http://en.wikipedia.org/wiki/Grid_chess
  */
-class LIB_EXPORT SlippedGridBoard : public GridBoard
+class LIB_EXPORT SlippedGridBoard final : public GridBoard
 {
 	public:
 		/*! Creates a new SlippedGridBoard object. */
@@ -117,8 +130,7 @@ class LIB_EXPORT SlippedGridBoard : public GridBoard
 
 	protected:
 		// Inherited from GridBoard
-		virtual bool restriction(const Move& move,
-					 bool reverse = false) const;
+		virtual int gridFileShift() const;
 };
 
 /*!
@@ -135,7 +147,7 @@ class LIB_EXPORT SlippedGridBoard : public GridBoard
  *
  * \note Rules: http://en.wikipedia.org/wiki/Grid_chess
  */
-class LIB_EXPORT BerolinaGridBoard : public GridBoard
+class LIB_EXPORT BerolinaGridBoard final : public GridBoard
 {
 	public:
 		/*! Creates a new BerolinaGridBoard object. */
@@ -102,6 +102,7 @@ void GryphonBoard::vMakeMove(const Move& move, BoardTransition* transition)
 	{
 		piece.setType(tgtType);
 		setSquare(target, piece);
+		invalidateMaterial();
 	}
 }
 
@@ -111,6 +112,8 @@ void GryphonBoard::vUndoMove(const Move& move)
 	Piece piece = pieceAt(target);
 	Piece oldpiece = m_pieceStack.pop();
 	Q_ASSERT(oldpiece.side() == piece.side());
+	if (oldpiece.type() != piece.type())
+		invalidateMaterial();
 	piece.setType(oldpiece.type());
 	setSquare(target, piece);
 
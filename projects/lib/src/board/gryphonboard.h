@@ -99,7 +99,7 @@ class LIB_EXPORT GryphonBoard : public WesternBoard
  *
  * \note Rules: https://en.wikipedia.org/wiki/V._R._Parton#Gryphon_Chess
  */
-class LIB_EXPORT SimplifiedGryphonBoard : public GryphonBoard
+class LIB_EXPORT SimplifiedGryphonBoard final : public GryphonBoard
 {
 	public:
 		/*! Creates a new SimplifiedGryphonBoard object. */
@@ -183,7 +183,7 @@ class LIB_EXPORT CircularGryphonBoard : public GryphonBoard
  *
  * \sa CircularGryphonBoard
  */
-class LIB_EXPORT ChangeOverBoard : public CircularGryphonBoard
+class LIB_EXPORT ChangeOverBoard final : public CircularGryphonBoard
 {
 	public:
 		/*! Creates a new ChangeOverBoard object. */
@@ -45,7 +45,7 @@ namespace Chess {
  * \note Standard Chess Rules: http://www.fide.com/component/handbook/?id=124&view=article
  * \sa PolyglotBook
  */
-class LIB_EXPORT HordeBoard : public StandardBoard
+class LIB_EXPORT HordeBoard final : public StandardBoard
 {
 	public:
 		/*! Creates a new HordeBoard object. */
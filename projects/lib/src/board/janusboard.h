@@ -41,7 +41,7 @@ namespace Chess {
  *
  * \sa CapablancaBoard
  */
-class LIB_EXPORT JanusBoard : public WesternBoard
+class LIB_EXPORT JanusBoard final : public WesternBoard
 {
 	public:
 		/*! Creates a new JanusBoard object. */
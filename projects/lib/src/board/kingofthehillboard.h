@@ -37,7 +37,7 @@ namespace Chess {
  * \note Standard Chess Rules: http://www.fide.com/component/handbook/?id=124&view=article
  * \sa PolyglotBook
  */
-class LIB_EXPORT KingOfTheHillBoard : public StandardBoard
+class LIB_EXPORT KingOfTheHillBoard final : public StandardBoard
 {
 	public:
 		/*! Creates a new KingOfTheHillBoard object. */
@@ -32,7 +32,7 @@ namespace Chess {
  *
  * \note Standard Chess Rules: http://www.fide.com/component/handbook/?id=124&view=article
  */
-class LIB_EXPORT KnightMateBoard : public WesternBoard
+class LIB_EXPORT KnightMateBoard final : public WesternBoard
 {
 	public:
 		/*! Creates a new KnightMateBoard object. */
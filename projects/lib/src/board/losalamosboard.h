@@ -34,7 +34,7 @@ namespace Chess {
  *
  * \note Rules: http://en.wikipedia.org/wiki/Los_Alamos_chess
  */
-class LIB_EXPORT LosAlamosBoard : public WesternBoard
+class LIB_EXPORT LosAlamosBoard final : public WesternBoard
 {
 	public:
 		/*! Creates a new LosAlamosBoard object. */
@@ -32,7 +32,7 @@ namespace Chess {
  *
  * \note Rules: http://wiki.wildchess.org/wiki/index.php/Losers
  */
-class LIB_EXPORT LosersBoard : public WesternBoard
+class LIB_EXPORT LosersBoard final : public WesternBoard
 {
 	public:
 		/*! Creates a new LosersBoard object. */
@@ -25,7 +25,9 @@ MakrukBoard::MakrukBoard()
 	  m_promotionRank(5),
 	  m_rules(Makruk),
 	  m_useWesternCounting(false),
-	  m_history()
+	  m_history(),
+	  m_material(0),
+	  m_materialDirty(true)
 {
 	// King, Ferz, Rook, Knight and Pawn as in chaturanga and shatranj
 	setPieceType(Bia, tr("bia"), "P");                    //! Cowry Shell, Chip
@@ -213,12 +215,21 @@ void MakrukBoard::vMakeMove(const Move& move, BoardTransition* transition)
 		md.plyCount = 0;
 		md.countingLimit = 2 * 64;
 	}
+
+	if (capture != Piece::NoPiece || promotion != Piece::NoPiece)
+		m_materialDirty = true;
 }
 
 void MakrukBoard::vUndoMove(const Move& move)
 {
 	ShatranjBoard::vUndoMove(move);
 	m_history.pop_back();
+
+	// The board is restored, so captureType() sees what the
+	// undone move captured
+	if (captureType(move) != Piece::NoPiece
+	||  move.promotion() != Piece::NoPiece)
+		m_materialDirty = true;
 }
 
 /*!
@@ -280,6 +291,7 @@ bool MakrukBoard::vSetFenString(const QStringList& inputFen)
 	// Count all pieces
 	initHistory();
 	setAllPieceCounters();
+	m_materialDirty = true;
 
 	// Short FEN format or normal ep field "-" turn off Makruk counting
 	bool ok = true;
@@ -338,6 +350,9 @@ void MakrukBoard::setAllPieceCounters()
 
 int MakrukBoard::material() const
 {
+	if (!m_materialDirty)
+		return m_material;
+
 	// Insufficient mating material?
 	int material = 0;
 	bool mets[] = { false, false };
@@ -368,6 +383,8 @@ int MakrukBoard::material() const
 			break;
 		}
 	}
+	m_material = material;
+	m_materialDirty = false;
 	return material;
 }
 
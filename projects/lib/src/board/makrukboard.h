@@ -184,6 +184,11 @@ class LIB_EXPORT MakrukBoard : public ShatranjBoard
 			int pieceCount[King + 1][2];
 		};
 		QVarLengthArray<MoveData> m_history;
+		// Cached material value for insufficientMaterial().
+		// A met can't change its square color, so the value
+		// only changes on captures and promotions.
+		mutable int m_material;
+		mutable bool m_materialDirty;
 
 		int material() const;
 };
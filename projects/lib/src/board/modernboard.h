@@ -43,7 +43,7 @@ namespace Chess {
  * \sa CapablancaBoard
  * \sa ChancellorBoard
  */
-class LIB_EXPORT ModernBoard : public WesternBoard
+class LIB_EXPORT ModernBoard final : public WesternBoard
 {
 	public:
 		/*! Creates a new ModernBoard object. */
@@ -31,6 +31,11 @@ namespace Chess {
  * and to store minimal information about the move. A Board object
  * is needed to verify the move's legality or to convert it to a string.
  *
+ * A move is packed into a single 32-bit word (10 bits each for the
+ * source square, target square and promotion type), and the type is
+ * declared primitive to Qt's container system so that move lists can
+ * be copied and resized with plain memcpy.
+ *
  * The source and target squares have an integer format specific to a
  * certain type of chess variant. The Board class has methods for
  * converting between these integers and the generic Square type.
@@ -131,6 +136,10 @@ inline int Move::promotion() const
 
 } // namespace Chess
 
+// A value-initialized Move is the null move, so the all-zero state is
+// valid and Qt containers may move and initialize Moves with memcpy
+// and memset.
+Q_DECLARE_TYPEINFO(Chess::Move, Q_PRIMITIVE_TYPE);
 Q_DECLARE_METATYPE(Chess::Move)
 
 #endif // MOVE_H
@@ -49,6 +49,7 @@ QString NCheckBoard::defaultFenString() const
 void NCheckBoard::vInitialize()
 {
 	m_checksToWin[Side::White] = m_checksToWin[Side::Black] = checkLimit();
+	m_checkHistory.clear();
 	StandardBoard::vInitialize();
 }
 
@@ -66,14 +67,22 @@ void NCheckBoard::vMakeMove(const Move& move,
 			    BoardTransition* transition)
 {
 	StandardBoard::vMakeMove(move, transition);
-	// If opponent in check then decrease counter of this side
-	updateCheckCounters(sideToMove(), -1);
+
+	// If opponent in check then decrease counter of this side,
+	// and record the verdict so undoing doesn't re-evaluate it
+	Side side = sideToMove();
+	bool givesCheck = inCheck(side.opposite());
+	if (givesCheck)
+		m_checksToWin[side]--;
+	m_checkHistory.append(givesCheck);
 }
 
 void NCheckBoard::vUndoMove(const Move& move)
 {
 	// If undoing checking move then increase counter of this side
-	updateCheckCounters(sideToMove(), +1);
+	if (m_checkHistory.last())
+		m_checksToWin[sideToMove()]++;
+	m_checkHistory.removeLast();
 	StandardBoard::vUndoMove(move);
 }
 
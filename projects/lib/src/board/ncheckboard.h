@@ -71,6 +71,9 @@ class LIB_EXPORT NCheckBoard : public StandardBoard
 	private:
 		int m_checkLimit;
 		int m_checksToWin[2];
+		// Per-ply record of whether the move gave check, so
+		// that undoing a move doesn't re-evaluate inCheck()
+		QVarLengthArray<bool> m_checkHistory;
 		void setChecksToWin(int whiteCount, int blackCount);
 		void updateCheckCounters(Side side, int d);
 };
@@ -82,7 +85,7 @@ class LIB_EXPORT NCheckBoard : public StandardBoard
  * A player also wins when he gives check three times in a game.
  * This is a trivial subclass of NCheckboard (variant: 3Check)
  */
-class LIB_EXPORT ThreeCheckBoard : public NCheckBoard
+class LIB_EXPORT ThreeCheckBoard final : public NCheckBoard
 {
 	public:
 		ThreeCheckBoard();
@@ -96,7 +99,7 @@ class LIB_EXPORT ThreeCheckBoard : public NCheckBoard
  * A player also wins when he gives check five times in a game.
  * This is a trivial subclass of NCheckboard (variant: 5Check)
  */
-class LIB_EXPORT FiveCheckBoard : public NCheckBoard
+class LIB_EXPORT FiveCheckBoard final : public NCheckBoard
 {
 	public:
 		FiveCheckBoard();
@@ -103,7 +103,7 @@ class LIB_EXPORT OukBoard : public MakrukBoard
  *
  */
 
-class LIB_EXPORT KarOukBoard : public OukBoard
+class LIB_EXPORT KarOukBoard final : public OukBoard
 {
 	public:
 		/*! Creates a new KarOukBoard object. */
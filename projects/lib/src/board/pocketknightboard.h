@@ -37,7 +37,7 @@ namespace Chess {
  * \note Rules: http://www.chessvariants.com/other.dir/pocket.html
  *
  */
-class LIB_EXPORT PocketKnightBoard : public WesternBoard
+class LIB_EXPORT PocketKnightBoard final : public WesternBoard
 {
 	public:
 		/*! Creates a new PocketKnightBoard object. */
@@ -36,7 +36,7 @@ namespace Chess {
  *
  * \note Rules: https://en.wikipedia.org/wiki/V._R._Parton#Racing_Kings
  * */
-class LIB_EXPORT RacingKingsBoard : public WesternBoard
+class LIB_EXPORT RacingKingsBoard final : public WesternBoard
 {
 	public:
 		/*! Creates a new RacingKingsBoard object. */
@@ -55,15 +55,13 @@ Result::Result(const QString& str)
 bool Result::operator==(const Result& other) const
 {
 	return (m_type == other.m_type &&
-		m_winner == other.m_winner &&
-		m_description == other.m_description);
+		m_winner == other.m_winner);
 }
 
 bool Result::operator!=(const Result& other) const
 {
 	return (m_type != other.m_type ||
-		m_winner != other.m_winner ||
-		m_description != other.m_description);
+		m_winner != other.m_winner);
 }
 
 bool Result::isNone() const
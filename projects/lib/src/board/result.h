@@ -30,6 +30,12 @@ namespace Chess {
  *
  * The Result class is used to store the result of a chess game,
  * and to compare it to other results.
+ *
+ * A result is a cheap value: the outcome is just the type and the
+ * winning side, and the human-readable text for it is generated by
+ * description() only when something prints it. The optional custom
+ * description given at construction adds detail to that text; it
+ * takes no part in comparisons.
  */
 class LIB_EXPORT Result
 {
@@ -78,9 +84,15 @@ class LIB_EXPORT Result
 		/*! Creates a new result from a string. */
 		explicit Result(const QString& str);
 
-		/*! Returns true if \a other is the same as this result. */
+		/*!
+		 * Returns true if \a other has the same outcome, ie. the
+		 * same type and winner, as this result.
+		 */
 		bool operator==(const Result& other) const;
-		/*! Returns true if \a other different from this result. */
+		/*!
+		 * Returns true if \a other has a different outcome than
+		 * this result.
+		 */
 		bool operator!=(const Result& other) const;
 		/*! Returns true if the result is NoResult. */
 		bool isNone() const;
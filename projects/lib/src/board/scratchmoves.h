@@ -0,0 +1,82 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SCRATCHMOVES_H
+#define SCRATCHMOVES_H
+
+#include <QVarLengthArray>
+#include "move.h"
+
+namespace Chess {
+
+/*!
+ * \brief A reusable per-thread move list.
+ *
+ * Board's move generation entry points need a temporary list of
+ * pseudo-legal moves. With many concurrent games each running on its
+ * own GameThread, allocating those lists on every call makes the heap
+ * a contention point. ScratchMoveList hands out buffers from a small
+ * per-thread pool instead: the buffers grow to each thread's
+ * high-water mark once and are then reused, so steady-state move
+ * generation performs no heap allocations.
+ *
+ * The pool has a fixed depth to support the nesting that occurs when
+ * legality filtering generates moves again (eg. canMove() inside a
+ * variant's result() implementation); deeper nestings fall back to a
+ * plain heap-allocated list.
+ */
+class ScratchMoveList
+{
+	public:
+		/*! Acquires a cleared buffer from the thread's pool. */
+		ScratchMoveList()
+			: m_owned(false)
+		{
+			if (s_depth < MaxDepth)
+				m_list = &s_pool[s_depth++];
+			else
+			{
+				m_list = new QVarLengthArray<Move>;
+				m_owned = true;
+			}
+			m_list->clear();
+		}
+		/*! Returns the buffer to the pool. */
+		~ScratchMoveList()
+		{
+			if (m_owned)
+				delete m_list;
+			else
+				s_depth--;
+		}
+		/*! Returns a reference to the move list. */
+		QVarLengthArray<Move>& operator*() { return *m_list; }
+
+	private:
+		Q_DISABLE_COPY(ScratchMoveList)
+
+		static const int MaxDepth = 4;
+		static thread_local QVarLengthArray<Move> s_pool[MaxDepth];
+		static thread_local int s_depth;
+
+		QVarLengthArray<Move>* m_list;
+		bool m_owned;
+};
+
+} // namespace Chess
+#endif // SCRATCHMOVES_H
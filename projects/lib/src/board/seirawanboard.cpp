@@ -23,7 +23,11 @@
 namespace Chess {
 
 SeirawanBoard::SeirawanBoard()
-	: WesternBoard(new WesternZobrist())
+	: WesternBoard(new WesternZobrist()),
+	  m_legalBaseKey(0),
+	  m_legalBaseSource(0),
+	  m_legalBaseTarget(0),
+	  m_legalBaseVerdict(false)
 {
 	setPieceType(Hawk, tr("hawk"), "H", KnightMovement | BishopMovement, "A");
 	setPieceType(Elephant, tr("elephant"), "E", KnightMovement | RookMovement, "C");
@@ -329,6 +333,41 @@ Move SeirawanBoard::moveFromLanString(const QString& str)
 	return Move(move.sourceSquare(), move.targetSquare(), promotion);
 }
 
+bool SeirawanBoard::vIsLegalMove(const Move& move)
+{
+	if (move.promotion() == Piece::NoPiece)
+	{
+		bool legal = WesternBoard::vIsLegalMove(move);
+		m_legalBaseKey = key();
+		m_legalBaseSource = move.sourceSquare();
+		m_legalBaseTarget = move.targetSquare();
+		m_legalBaseVerdict = legal;
+		return legal;
+	}
+
+	// Gating only adds a friendly piece behind the mover, which may
+	// block attacks on the own king but can never create new ones:
+	// a legal plain move makes every gated and promotion variant of
+	// it legal too. Test the plain move once per (source, target)
+	// pair and let its verdict cover the variants.
+	if (key() != m_legalBaseKey
+	||  move.sourceSquare() != m_legalBaseSource
+	||  move.targetSquare() != m_legalBaseTarget)
+	{
+		m_legalBaseKey = key();
+		m_legalBaseSource = move.sourceSquare();
+		m_legalBaseTarget = move.targetSquare();
+		m_legalBaseVerdict = WesternBoard::vIsLegalMove(
+			Move(move.sourceSquare(), move.targetSquare()));
+	}
+	if (m_legalBaseVerdict)
+		return true;
+
+	// The base move is illegal, but the gated piece may block a pin
+	// on the vacated square, so the variant needs its own test
+	return WesternBoard::vIsLegalMove(move);
+}
+
 void SeirawanBoard::vMakeMove(const Move& move, BoardTransition* transition)
 {
 	int source = move.sourceSquare();
@@ -394,7 +433,7 @@ void SeirawanBoard::generateMovesForPiece(QVarLengthArray< Move >& moves,
 	if (!isValidSquare(chessSquare(square)))
 		return;
 
-	QVarLengthArray< Move > moves1, moves2;
+	QVarLengthArray< Move > moves1;
 	WesternBoard::generateMovesForPiece(moves1, pieceType, square);
 
 	// add normal moves
@@ -405,34 +444,39 @@ void SeirawanBoard::generateMovesForPiece(QVarLengthArray< Move >& moves,
 	if (!m_squareMap.contains(square) ||  m_squareMap[square] > 0)
 		return;
 
-	// generate channeling moves as promotions on base rank
+	// collect the available gate piece types once instead of
+	// querying the reserve for every base move
 	Side side = sideToMove();
-	for (Move m: moves1)
+	QVarLengthArray<int, 4> gateTypes;
+	const QList<Piece> reserveTypes = reservePieceTypes();
+	for (const Piece& pc: reserveTypes)
 	{
-		const QList<Piece>& reserveTypes = reservePieceTypes();
-		for (const Piece& pc: reserveTypes)
-		{
-			if (pc.side() == side &&  reserveCount(pc) > 0)
-				moves2.append(Move(m.sourceSquare(),
-						   m.targetSquare(),
-						   pc.type()));
-		}
+		if (pc.side() == side && reserveCount(pc) > 0)
+			gateTypes.append(pc.type());
 	}
+	if (gateTypes.isEmpty())
+		return;
 
-	// add channeling moves
-	for (Move m: moves2)
+	// generate channeling moves as promotions on base rank
+	for (Move m: moves1)
 	{
-		moves.append(m);
-		// add castling move with channeling onto rook square
+		// castling moves also get channeling onto the rook square
 		Piece piece1 = pieceAt(m.sourceSquare());
 		Piece piece2 = pieceAt(m.targetSquare());
+		bool rookChanneling = piece1.type() == King
+				   && piece2.type() == Rook
+				   && piece2.side() == side;
 
-		if (piece1.type() == King
-		&&  piece2.type() == Rook
-		&&  piece2.side() == side)
+		for (int type: gateTypes)
+		{
 			moves.append(Move(m.sourceSquare(),
 					  m.targetSquare(),
-					  rookSquareChanneling(m.promotion())));
+					  type));
+			if (rookChanneling)
+				moves.append(Move(m.sourceSquare(),
+						  m.targetSquare(),
+						  rookSquareChanneling(type)));
+		}
 	}
 }
 
@@ -43,7 +43,7 @@ namespace Chess {
  * \note Rules: http://en.wikipedia.org/wiki/Seirawan_chess
  *
  */
-class LIB_EXPORT SeirawanBoard : public WesternBoard
+class LIB_EXPORT SeirawanBoard final : public WesternBoard
 {
 	public:
 		/*! Creates a new SeirawanBoard object. */
@@ -77,6 +77,7 @@ class LIB_EXPORT SeirawanBoard : public WesternBoard
 		virtual QString sanMoveString(const Move& move);
 		virtual Move moveFromSanString(const QString& str);
 		virtual Move moveFromLanString(const QString& str);
+		virtual bool vIsLegalMove(const Move& move);
 		virtual void vMakeMove(const Move& move,
 				       BoardTransition* transition);
 		virtual void vUndoMove(const Move& move);
@@ -85,6 +86,14 @@ class LIB_EXPORT SeirawanBoard : public WesternBoard
 						   int square) const;
 	private:
 		QMap<int, int> m_squareMap;
+		// Legality verdict of the last plain (source, target)
+		// pair tested in the position with the key below. A
+		// legal plain move approves all its gated and promotion
+		// variants without another make/undo test.
+		quint64 m_legalBaseKey;
+		int m_legalBaseSource;
+		int m_legalBaseTarget;
+		bool m_legalBaseVerdict;
 		void insertIntoSquareMap(int square, int count = 0);
 		void updateSquareMap(const Move& move, int increment);
 		enum direction { forward, backward };
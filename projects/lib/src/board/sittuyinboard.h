@@ -70,7 +70,7 @@ namespace Chess {
  * \sa ShatranjBoard
  *
  */
-class LIB_EXPORT SittuyinBoard : public MakrukBoard
+class LIB_EXPORT SittuyinBoard final : public MakrukBoard
 {
 	public:
 		/*! Creates a new SittuyinBoard object. */
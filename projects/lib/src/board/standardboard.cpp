@@ -1053,8 +1053,14 @@ const quint64 s_keys[] = {
 namespace Chess {
 
 StandardBoard::StandardBoard()
-	: WesternBoard(new WesternZobrist(s_keys))
+	: WesternBoard(new WesternZobrist(s_keys)),
+	  m_bbValid(false),
+	  m_bbKey(0),
+	  m_bbOccupied(0)
 {
+	Bitboards::initialize();
+	m_bbPieces[Side::White] = 0;
+	m_bbPieces[Side::Black] = 0;
 }
 
 Board* StandardBoard::copy() const
@@ -1072,6 +1078,102 @@ QString StandardBoard::defaultFenString() const
 	return "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
 }
 
+bool StandardBoard::hasReverseMoveLookup() const
+{
+	// Standard pieces move strictly by the pawn, knight, bishop and
+	// rook patterns, so SAN tokens can be resolved by scanning
+	// backwards from the target square.
+	return true;
+}
+
+bool StandardBoard::hasStagedLegalityFilter() const
+{
+	// Under standard rules a non-king move can endanger the
+	// mover's king only by leaving a line to it open, so the pin
+	// and check analysis decides legality without making moves.
+	return true;
+}
+
+int StandardBoard::bitIndex(int square) const
+{
+	// The mailbox is 10 squares wide and has two padding ranks
+	// above the eighth rank.
+	int file = square % 10 - 1;
+	int rank = 9 - square / 10;
+	return rank * 8 + file;
+}
+
+int StandardBoard::mailboxIndex(int bit) const
+{
+	int file = bit & 7;
+	int rank = bit >> 3;
+	return (9 - rank) * 10 + 1 + file;
+}
+
+void StandardBoard::updateOccupancy() const
+{
+	if (m_bbValid && m_bbKey == key())
+		return;
+
+	Q_ASSERT(width() == 8 && height() == 8);
+
+	Bitboards::Bitboard pieces[2] = { 0, 0 };
+	for (int bit = 0; bit < 64; bit++)
+	{
+		Piece piece(pieceAt(mailboxIndex(bit)));
+		if (piece.isValid())
+			pieces[piece.side()] |= Q_UINT64_C(1) << bit;
+	}
+
+	m_bbPieces[Side::White] = pieces[Side::White];
+	m_bbPieces[Side::Black] = pieces[Side::Black];
+	m_bbOccupied = pieces[Side::White] | pieces[Side::Black];
+	m_bbKey = key();
+	m_bbValid = true;
+}
+
+void StandardBoard::generateMovesForPiece(QVarLengthArray<Move>& moves,
+					  int pieceType,
+					  int square) const
+{
+	// Pawns, kings (castling) and piece drops use the generic
+	// mailbox generator.
+	if (square == 0
+	||  (pieceType != Knight && pieceType != Bishop
+	&&   pieceType != Rook && pieceType != Queen))
+		return WesternBoard::generateMovesForPiece(moves,
+							   pieceType,
+							   square);
+
+	updateOccupancy();
+
+	int from = bitIndex(square);
+	Bitboards::Bitboard targets = 0;
+	switch (pieceType)
+	{
+	case Knight:
+		targets = Bitboards::knightAttacks(from);
+		break;
+	case Bishop:
+		targets = Bitboards::bishopAttacks(from, m_bbOccupied);
+		break;
+	case Rook:
+		targets = Bitboards::rookAttacks(from, m_bbOccupied);
+		break;
+	case Queen:
+		targets = Bitboards::queenAttacks(from, m_bbOccupied);
+		break;
+	}
+	targets &= ~m_bbPieces[sideToMove()];
+
+	while (targets)
+	{
+		int to = qCountTrailingZeroBits(targets);
+		targets &= targets - 1;
+		moves.append(Move(square, mailboxIndex(to)));
+	}
+}
+
 Result StandardBoard::tablebaseResult(unsigned int* dtz) const
 {
 	SyzygyTablebase::PieceList pieces;
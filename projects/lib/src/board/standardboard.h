@@ -20,6 +20,7 @@
 #define STANDARDBOARD_H
 
 #include "westernboard.h"
+#include "bitboards.h"
 
 namespace Chess {
 
@@ -32,6 +33,12 @@ namespace Chess {
  * StandardBoard uses Polyglot-compatible zobrist position keys,
  * so Polyglot opening books can be used easily.
  *
+ * Moves for knights and sliding pieces are generated from bitboard
+ * attack tables instead of the generic mailbox scan. The padded
+ * mailbox representation in Board remains the authoritative board
+ * state; occupancy bitboards are derived from it on demand and cached
+ * per position.
+ *
  * \note Rules: http://www.fide.com/component/handbook/?id=124&view=article
  * \sa PolyglotBook
  */
@@ -46,6 +53,30 @@ class LIB_EXPORT StandardBoard : public WesternBoard
 		virtual QString variant() const;
 		virtual QString defaultFenString() const;
 		virtual Result tablebaseResult(unsigned int* dtm = nullptr) const;
+
+	protected:
+		// Inherited from WesternBoard
+		virtual void generateMovesForPiece(QVarLengthArray<Move>& moves,
+						   int pieceType,
+						   int square) const;
+		virtual bool hasReverseMoveLookup() const;
+		virtual bool hasStagedLegalityFilter() const;
+
+	private:
+		/*! Converts a mailbox square index into a bitboard index. */
+		int bitIndex(int square) const;
+		/*! Converts a bitboard index into a mailbox square index. */
+		int mailboxIndex(int bit) const;
+		/*!
+		 * Rebuilds the occupancy bitboards from the mailbox if the
+		 * position has changed since they were last built.
+		 */
+		void updateOccupancy() const;
+
+		mutable bool m_bbValid;
+		mutable quint64 m_bbKey;
+		mutable Bitboards::Bitboard m_bbOccupied;
+		mutable Bitboards::Bitboard m_bbPieces[2];
 };
 
 } // namespace Chess
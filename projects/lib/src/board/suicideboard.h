@@ -46,7 +46,7 @@ namespace Chess {
  * \note Standard Chess Rules: http://www.fide.com/component/handbook/?id=124&view=article
  * \sa PolyglotBook
  */
-class LIB_EXPORT SuicideBoard : public AntiBoard
+class LIB_EXPORT SuicideBoard final : public AntiBoard
 {
 	public:
 		/*! Creates a new SuicideBoard object. */
@@ -17,7 +17,9 @@
 */
 
 #include "syzygytablebase.h"
+#include <QCache>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QMutex>
 #include <QStringList>
 #include <tbprobe.h>
@@ -29,6 +31,65 @@ bool s_initialized = false, s_initOK = false, s_noRule50 = false;
 int s_pieces = INT_MAX;
 QMutex s_mutex;
 
+// Everything tb_probe_root() looks at; also stored in the cache
+// entries so a hash collision can't return the wrong position's
+// result.
+struct ProbeKey
+{
+	uint64_t white, black;
+	uint64_t kings, queens, rooks, bishops, knights, pawns;
+	unsigned rule50, ep;
+	bool wtm;
+
+	bool operator==(const ProbeKey& other) const
+	{
+		return white == other.white && black == other.black
+		    && kings == other.kings && queens == other.queens
+		    && rooks == other.rooks && bishops == other.bishops
+		    && knights == other.knights && pawns == other.pawns
+		    && rule50 == other.rule50 && ep == other.ep
+		    && wtm == other.wtm;
+	}
+};
+
+struct ProbeEntry
+{
+	ProbeKey key;
+	unsigned result;
+};
+
+// Probe results shared across all concurrent games. Games playing
+// the same openings keep reaching the same endgame positions, and a
+// cache hit skips a probe that can stall on cold disk pages.
+QCache<quint64, ProbeEntry> s_cache(8192);
+
+// Probe latency instrumentation, protected by s_mutex. Slow probes
+// stall adjudication and show up in the clock-time statistics, so
+// the maximum is tracked along with the total.
+quint64 s_probeCount = 0, s_cacheHits = 0;
+qint64 s_probeNsecs = 0, s_maxProbeNsecs = 0;
+
+quint64 mixHash(quint64 h, quint64 v)
+{
+	return h ^ (v + Q_UINT64_C(0x9E3779B97F4A7C15) + (h << 6) + (h >> 2));
+}
+
+quint64 probeHash(const ProbeKey& key)
+{
+	quint64 h = key.wtm;
+	h = mixHash(h, key.white);
+	h = mixHash(h, key.black);
+	h = mixHash(h, key.kings);
+	h = mixHash(h, key.queens);
+	h = mixHash(h, key.rooks);
+	h = mixHash(h, key.bishops);
+	h = mixHash(h, key.knights);
+	h = mixHash(h, key.pawns);
+	h = mixHash(h, key.rule50);
+	h = mixHash(h, key.ep);
+	return h;
+}
+
 int tbSquare(const Chess::Square& square)
 {
 	if (!square.isValid())
@@ -66,6 +127,31 @@ void SyzygyTablebase::setNoRule50()
 	s_noRule50 = true;
 }
 
+void SyzygyTablebase::setMemoryLock()
+{
+	TB_MLOCK_ENABLED = 1;
+}
+
+QString SyzygyTablebase::probeStats()
+{
+	s_mutex.lock();
+	const quint64 probes = s_probeCount;
+	const quint64 hits = s_cacheHits;
+	const qint64 total = s_probeNsecs;
+	const qint64 max = s_maxProbeNsecs;
+	s_mutex.unlock();
+
+	if (probes + hits == 0)
+		return QString();
+
+	const double avgMs = probes ? total / 1.0e6 / probes : 0.0;
+	return QString("%1 probes (%2 cache hits), avg %3 ms, max %4 ms")
+	       .arg(probes)
+	       .arg(hits)
+	       .arg(avgMs, 0, 'f', 2)
+	       .arg(max / 1.0e6, 0, 'f', 1);
+}
+
 Chess::Result SyzygyTablebase::result(const Chess::Side& side,
 					   const Chess::Square& enpassantSq,
 					   Castling castling,
@@ -113,9 +199,32 @@ Chess::Result SyzygyTablebase::result(const Chess::Side& side,
 		}
 	}
 
+	const ProbeKey key = { white, black, kings, queens, rooks,
+			       bishops, knights, pawns,
+			       unsigned(rule50), ep, wtm };
+	const quint64 hash = probeHash(key);
+	unsigned result;
+
 	s_mutex.lock();
-	unsigned result = tb_probe_root(white, black, kings, queens, rooks,
-		bishops, knights, pawns, rule50, 0, ep, wtm, nullptr);
+	const ProbeEntry* entry = s_cache.object(hash);
+	if (entry != nullptr && entry->key == key)
+	{
+		result = entry->result;
+		s_cacheHits++;
+	}
+	else
+	{
+		QElapsedTimer timer;
+		timer.start();
+		result = tb_probe_root(white, black, kings, queens, rooks,
+			bishops, knights, pawns, rule50, 0, ep, wtm, nullptr);
+		const qint64 nsecs = timer.nsecsElapsed();
+		s_probeCount++;
+		s_probeNsecs += nsecs;
+		if (nsecs > s_maxProbeNsecs)
+			s_maxProbeNsecs = nsecs;
+		s_cache.insert(hash, new ProbeEntry { key, result });
+	}
 	s_mutex.unlock();
 
 	Chess::Side winner(Chess::Side::NoSide); 
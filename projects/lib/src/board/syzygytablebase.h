@@ -77,6 +77,20 @@ class LIB_EXPORT SyzygyTablebase
 		 * Disable the 50 move rule from consideration.
 		 */
 		static void setNoRule50();
+		/*!
+		 * Lock tablebase files into physical memory as they're
+		 * mapped, so they stay resident for the whole tournament
+		 * and probes don't stall on page faults.
+		 *
+		 * Must be called before the first probe. Failure to lock
+		 * a file is not fatal.
+		 */
+		static void setMemoryLock();
+		/*!
+		 * Returns a one-line summary of probe latencies and
+		 * cache hits, or an empty string if no probes were made.
+		 */
+		static QString probeStats();
 		/*!
 		 * Returns the expected game result for the positions specified
 		 * by \a side, \a enpassantSq, \a castling and \a pieces.
@@ -34,7 +34,7 @@ namespace Chess {
  *
  * \note Standard Chess Rules: http://www.fide.com/component/handbook/?id=124&view=article
  */
-class LIB_EXPORT ThreeKingsBoard : public WesternBoard
+class LIB_EXPORT ThreeKingsBoard final : public WesternBoard
 {
 	public:
 		/*! Creates a new ThreeKingsBoard object. */
@@ -90,7 +90,7 @@ class LIB_EXPORT TwoKingsEachBoard : public WesternBoard
  *
  * \sa TwoKingsEachBoard
  */
-class LIB_EXPORT TwoKingsSymmetricalBoard : public TwoKingsEachBoard
+class LIB_EXPORT TwoKingsSymmetricalBoard final : public TwoKingsEachBoard
 {
 	public:
 		/*! Creates a new TwoKingsSymmetricalBoard object. */
@@ -19,6 +19,7 @@
 #include <QStringList>
 #include "westernzobrist.h"
 #include "boardtransition.h"
+#include "scratchmoves.h"
 
 
 namespace Chess {
@@ -37,8 +38,20 @@ WesternBoard::WesternBoard(WesternZobrist* zobrist)
 	  m_hasEnPassantCaptures(true),
 	  m_pawnAmbiguous(false),
 	  m_multiDigitNotation(false),
+	  m_material(0),
+	  m_materialDirty(true),
 	  m_zobrist(zobrist)
 {
+	m_legalityContext.valid = false;
+	m_legalityContext.key = 0;
+	m_legalityContext.checkers = 0;
+	for (int i = 0; i < 2; i++)
+	{
+		m_checkCache[i].valid = false;
+		m_checkCache[i].key = 0;
+		m_checkCache[i].inCheck = false;
+	}
+
 	setPieceType(Pawn, tr("pawn"), "P");
 	setPieceType(Knight, tr("knight"), "N", KnightMovement);
 	setPieceType(Bishop, tr("bishop"), "B", BishopMovement);
@@ -181,6 +194,9 @@ QString WesternBoard::lanMoveString(const Move& move)
 QString WesternBoard::sanMoveString(const Move& move)
 {
 	QString str;
+	// SAN is bounded at about ten characters; one reservation
+	// keeps the appends below from reallocating
+	str.reserve(10);
 	int source = move.sourceSquare();
 	int target = move.targetSquare();
 	Piece piece = pieceAt(source);
@@ -243,7 +259,8 @@ QString WesternBoard::sanMoveString(const Move& move)
 	if (piece.type() != Pawn)	// not pawn
 	{
 		str += pieceSymbol(piece).toUpper();
-		QVarLengthArray<Move> moves;
+		ScratchMoveList scratch;
+		QVarLengthArray<Move>& moves = *scratch;
 		generateMoves(moves, piece.type());
 
 		for (int i = 0; i < moves.size(); i++)
@@ -265,17 +282,20 @@ QString WesternBoard::sanMoveString(const Move& move)
 		}
 	}
 	if (needFile)
-		str += 'a' + square.file();
+		str += QLatin1Char('a' + square.file());
 	if (needRank)
 		str += QString::number(1 + square.rank());
 
 	if (capture.isValid())
-		str += 'x';
+		str += QLatin1Char('x');
 
 	str += squareString(target);
 
 	if (move.promotion() != Piece::NoPiece)
-		str += "=" + pieceSymbol(move.promotion()).toUpper();
+	{
+		str += QLatin1Char('=');
+		str += pieceSymbol(move.promotion()).toUpper();
+	}
 
 	if (checkOrMate != 0)
 		str += checkOrMate;
@@ -484,8 +504,12 @@ Move WesternBoard::moveFromSanString(const QString& str)
 			return Move();
 	}
 
-	QVarLengthArray<Move> moves;
-	generateMoves(moves, piece.type());
+	ScratchMoveList scratch;
+	QVarLengthArray<Move>& moves = *scratch;
+	if (hasReverseMoveLookup())
+		generateSanCandidates(moves, piece.type(), target);
+	else
+		generateMoves(moves, piece.type());
 	const Move* match = nullptr;
 
 	// Loop through all legal moves to find a move that matches
@@ -699,6 +723,8 @@ bool WesternBoard::vSetFenString(const QStringList& fen)
 		return false;
 	QStringList::const_iterator token = fen.begin();
 
+	m_materialDirty = true;
+
 	// Find the king squares
 	int kingCount[2] = {0, 0};
 	for (int sq = 0; sq < arraySize(); sq++)
@@ -897,8 +923,13 @@ void WesternBoard::vMakeMove(const Move& move, BoardTransition* transition)
 
 	Q_ASSERT(target != 0);
 
-	MoveData md = { capture, epSq, epTgt, m_castlingRights,
-			NoCastlingSide, m_reversibleMoveCount };
+	MoveData md;
+	md.setCastlingRights(m_castlingRights);
+	md.enpassantSquare = epSq;
+	md.enpassantTarget = epTgt;
+	md.castlingSide = NoCastlingSide;
+	md.capture = capture;
+	md.reversibleMoveCount = m_reversibleMoveCount;
 
 	if (source == 0)
 	{
@@ -1017,6 +1048,14 @@ void WesternBoard::vMakeMove(const Move& move, BoardTransition* transition)
 	else
 		m_reversibleMoveCount = 0;
 
+	// The cached material value can only change when a piece leaves
+	// the board or changes type. Bishop moves are included because
+	// the square color a bishop stands on matters to the value.
+	if (captureType(move) != Piece::NoPiece
+	||  move.promotion() != Piece::NoPiece
+	||  pieceType == Bishop)
+		m_materialDirty = true;
+
 	m_history.append(md);
 	m_sign *= -1;
 }
@@ -1032,9 +1071,9 @@ void WesternBoard::vUndoMove(const Move& move)
 
 	setEnpassantSquare(md.enpassantSquare, md.enpassantTarget);
 	m_reversibleMoveCount = md.reversibleMoveCount;
-	m_castlingRights = md.castlingRights;
+	m_castlingRights = md.castlingRights();
 
-	CastlingSide cside = md.castlingSide;
+	CastlingSide cside = CastlingSide(md.castlingSide);
 	if (cside != NoCastlingSide)
 	{
 		m_kingSquare[side] = source;
@@ -1074,6 +1113,14 @@ void WesternBoard::vUndoMove(const Move& move)
 		setSquare(source, pieceAt(target));
 
 	setSquare(target, md.capture);
+
+	// Same invalidation rule as in vMakeMove()
+	if (md.capture.isValid()
+	||  move.promotion() != Piece::NoPiece
+	||  target == m_enpassantSquare
+	||  pieceAt(source).type() == Bishop)
+		m_materialDirty = true;
+
 	m_history.pop_back();
 }
 
@@ -1101,14 +1148,32 @@ void WesternBoard::generateMovesForPiece(QVarLengthArray<Move>& moves,
 
 bool WesternBoard::inCheck(Side side, int square) const
 {
-	Side opSide = side.opposite();
+	if (square != 0)
+		return underAttack(side, square);
+
+	square = m_kingSquare[side];
+	// In the "horde" variant the horde side has no king
 	if (square == 0)
-	{
-		square = m_kingSquare[side];
-		// In the "horde" variant the horde side has no king
-		if (square == 0)
-			return false;
-	}
+		return false;
+
+	// Legality tests, SAN notation and result detection all ask
+	// about the same position's check state; repeat queries are
+	// answered from a per-side cache.
+	CheckCache& cache = m_checkCache[side];
+	if (cache.valid && cache.key == key())
+		return cache.inCheck;
+
+	bool check = underAttack(side, square);
+	cache.key = key();
+	cache.inCheck = check;
+	cache.valid = true;
+
+	return check;
+}
+
+bool WesternBoard::underAttack(Side side, int square) const
+{
+	Side opSide = side.opposite();
 
 	// Pawn attacks
 	int sign = (side == Side::White) ? 1 : -1;
@@ -1194,7 +1259,7 @@ bool WesternBoard::isLegalPosition()
 	// Make sure that no square between the king's initial and final
 	// squares (including the initial and final squares) are under
 	// attack (in check) by the opponent.
-	CastlingSide cside = m_history.last().castlingSide;
+	CastlingSide cside = CastlingSide(m_history.last().castlingSide);
 	if (cside != NoCastlingSide)
 	{
 		int source = move.sourceSquare();
@@ -1228,6 +1293,170 @@ bool WesternBoard::isLegalPosition()
 	return true;
 }
 
+void WesternBoard::scanKingRay(int kingSquare, int offset, unsigned movement)
+{
+	int ownSquare = 0;
+	int targetSquare = kingSquare + offset;
+	Piece piece;
+
+	while (!(piece = pieceAt(targetSquare)).isWall())
+	{
+		if (!piece.isEmpty())
+		{
+			if (piece.side() == sideToMove())
+			{
+				// A second piece of the side to move
+				// shields the first one from any pin
+				if (ownSquare != 0)
+					return;
+				ownSquare = targetSquare;
+			}
+			else
+			{
+				if (!pieceHasMovement(piece.type(), movement))
+					return;
+				if (ownSquare != 0)
+					m_legalityContext.pins.append(
+						{ ownSquare, offset });
+				else
+				{
+					// The king is attacked along this
+					// ray; interposing or capturing
+					// resolves the check
+					m_legalityContext.checkers++;
+					for (int i = kingSquare + offset;
+					     i != targetSquare; i += offset)
+						m_legalityContext.checkSquares.append(i);
+					m_legalityContext.checkSquares.append(targetSquare);
+				}
+				return;
+			}
+		}
+		targetSquare += offset;
+	}
+}
+
+void WesternBoard::updateLegalityContext()
+{
+	if (m_legalityContext.valid && m_legalityContext.key == key())
+		return;
+
+	m_legalityContext.checkers = 0;
+	m_legalityContext.checkSquares.clear();
+	m_legalityContext.pins.clear();
+
+	Side side = sideToMove();
+	Side opSide = side.opposite();
+	int kingSquare = m_kingSquare[side];
+
+	// No king, no checks or pins (eg. the horde side)
+	if (kingSquare != 0)
+	{
+		// Pawn checkers
+		int sign = (side == Side::White) ? 1 : -1;
+		for (const PawnStep& pStep: m_pawnSteps)
+		{
+			if (pStep.type != CaptureStep)
+				continue;
+			int fromSquare = kingSquare - pawnPushOffset(pStep, -sign);
+			if (pieceAt(fromSquare) == Piece(opSide, Pawn))
+			{
+				m_legalityContext.checkers++;
+				m_legalityContext.checkSquares.append(fromSquare);
+			}
+		}
+
+		// Knight-type checkers
+		for (int i = 0; i < m_knightOffsets.size(); i++)
+		{
+			int square = kingSquare + m_knightOffsets[i];
+			Piece piece = pieceAt(square);
+			if (piece.side() == opSide
+			&&  pieceHasMovement(piece.type(), KnightMovement))
+			{
+				m_legalityContext.checkers++;
+				m_legalityContext.checkSquares.append(square);
+			}
+		}
+
+		// Sliding checkers and pinned pieces
+		for (int i = 0; i < m_bishopOffsets.size(); i++)
+			scanKingRay(kingSquare, m_bishopOffsets[i],
+				    BishopMovement);
+		for (int i = 0; i < m_rookOffsets.size(); i++)
+			scanKingRay(kingSquare, m_rookOffsets[i],
+				    RookMovement);
+	}
+
+	m_legalityContext.key = key();
+	m_legalityContext.valid = true;
+}
+
+int WesternBoard::stagedLegalVerdict(const Move& move)
+{
+	int source = move.sourceSquare();
+	int target = move.targetSquare();
+
+	// King moves (including castling) and en-passant captures
+	// have rules of their own; let the generic make-check-undo
+	// path decide them
+	if (source == m_kingSquare[sideToMove()])
+		return -1;
+	if (target == m_enpassantSquare && m_enpassantSquare != 0
+	&&  pieceAt(source).type() == Pawn)
+		return -1;
+
+	updateLegalityContext();
+
+	// With more than one checker only the king can move
+	if (m_legalityContext.checkers > 1)
+		return 0;
+
+	// A pinned piece may only move along its pin ray
+	for (const PinnedPiece& pin: m_legalityContext.pins)
+	{
+		if (pin.square != source)
+			continue;
+
+		bool onRay = false;
+		for (int i = m_kingSquare[sideToMove()] + pin.direction;
+		     !pieceAt(i).isWall(); i += pin.direction)
+		{
+			if (i == target)
+			{
+				onRay = true;
+				break;
+			}
+			// The ray ends at the pinning piece
+			if (i != source && !pieceAt(i).isEmpty())
+				break;
+		}
+		if (!onRay)
+			return 0;
+		break;
+	}
+
+	// A single check must be resolved by capturing the checker
+	// or interposing. A pinned piece can't do either: its pin
+	// ray and the check ray only meet at the king.
+	if (m_legalityContext.checkers == 1)
+	{
+		for (int square: m_legalityContext.checkSquares)
+		{
+			if (square == target)
+				return 1;
+		}
+		return 0;
+	}
+
+	return 1;
+}
+
+bool WesternBoard::hasStagedLegalityFilter() const
+{
+	return false;
+}
+
 bool WesternBoard::vIsLegalMove(const Move& move)
 {
 	Q_ASSERT(!move.isNull());
@@ -1237,6 +1466,16 @@ bool WesternBoard::vIsLegalMove(const Move& move)
 	&&  captureType(move) != Piece::NoPiece)
 		return false;
 
+	if (hasStagedLegalityFilter())
+	{
+		int verdict = stagedLegalVerdict(move);
+		if (verdict >= 0)
+		{
+			Q_ASSERT((verdict != 0) == Board::vIsLegalMove(move));
+			return verdict != 0;
+		}
+	}
+
 	return Board::vIsLegalMove(move);
 }
 
@@ -1291,6 +1530,94 @@ void WesternBoard::generatePawnMoves(int sourceSquare,
 	}
 }
 
+bool WesternBoard::hasReverseMoveLookup() const
+{
+	return false;
+}
+
+void WesternBoard::generateSanCandidates(QVarLengthArray<Move>& moves,
+					 int pieceType,
+					 int target) const
+{
+	// Find the source squares that could reach 'target' by scanning
+	// backwards from it, then generate moves only for the pieces on
+	// those squares. The caller filters the moves by target square.
+	QVarLengthArray<int, 16> sources;
+	Piece piece(sideToMove(), pieceType);
+
+	if (pieceType == Pawn)
+	{
+		for (const PawnStep& pStep: m_pawnSteps)
+		{
+			int sq = target - pawnPushOffset(pStep, m_sign);
+			if (pieceAt(sq) == piece)
+				sources.append(sq);
+			if (pStep.type == FreeStep && m_pawnHasDoubleStep)
+			{
+				sq -= pawnPushOffset(pStep, m_sign);
+				if (pieceAt(sq) == piece)
+					sources.append(sq);
+			}
+		}
+	}
+	else if (pieceType == King)
+	{
+		for (int i = 0; i < m_bishopOffsets.size(); i++)
+		{
+			int sq = target + m_bishopOffsets[i];
+			if (pieceAt(sq) == piece)
+				sources.append(sq);
+		}
+		for (int i = 0; i < m_rookOffsets.size(); i++)
+		{
+			int sq = target + m_rookOffsets[i];
+			if (pieceAt(sq) == piece)
+				sources.append(sq);
+		}
+	}
+	else
+	{
+		if (pieceHasMovement(pieceType, KnightMovement))
+		{
+			for (int i = 0; i < m_knightOffsets.size(); i++)
+			{
+				int sq = target + m_knightOffsets[i];
+				if (pieceAt(sq) == piece)
+					sources.append(sq);
+			}
+		}
+		if (pieceHasMovement(pieceType, BishopMovement))
+		{
+			for (int i = 0; i < m_bishopOffsets.size(); i++)
+			{
+				int offset = m_bishopOffsets[i];
+				int sq = target + offset;
+				Piece tmp;
+				while ((tmp = pieceAt(sq)).isEmpty())
+					sq += offset;
+				if (tmp == piece)
+					sources.append(sq);
+			}
+		}
+		if (pieceHasMovement(pieceType, RookMovement))
+		{
+			for (int i = 0; i < m_rookOffsets.size(); i++)
+			{
+				int offset = m_rookOffsets[i];
+				int sq = target + offset;
+				Piece tmp;
+				while ((tmp = pieceAt(sq)).isEmpty())
+					sq += offset;
+				if (tmp == piece)
+					sources.append(sq);
+			}
+		}
+	}
+
+	for (int i = 0; i < sources.size(); i++)
+		generateMovesForPiece(moves, pieceType, sources[i]);
+}
+
 bool WesternBoard::canCastle(CastlingSide castlingSide) const
 {
 	Side side = sideToMove();
@@ -1381,6 +1708,11 @@ int WesternBoard::reversibleMoveCount() const
 	return m_reversibleMoveCount;
 }
 
+void WesternBoard::invalidateMaterial()
+{
+	m_materialDirty = true;
+}
+
 Result WesternBoard::result()
 {
 	QString str;
@@ -1402,38 +1734,44 @@ Result WesternBoard::result()
 		}
 	}
 
-	// Insufficient mating material
-	int material = 0;
-	bool bishops[] = { false, false };
-	for (int i = 0; i < arraySize(); i++)
+	// Insufficient mating material. The material value is cached
+	// and only recomputed after a move that could have changed it.
+	if (m_materialDirty)
 	{
-		const Piece& piece = pieceAt(i);
-		if (!piece.isValid())
-			continue;
-
-		switch (piece.type())
-		{
-		case King:
-			break;
-		case Bishop:
+		int material = 0;
+		bool bishops[] = { false, false };
+		for (int i = 0; i < arraySize(); i++)
 		{
-			auto color = chessSquare(i).color();
-			if (color != Square::NoColor && !bishops[color])
+			const Piece& piece = pieceAt(i);
+			if (!piece.isValid())
+				continue;
+
+			switch (piece.type())
 			{
+			case King:
+				break;
+			case Bishop:
+			{
+				auto color = chessSquare(i).color();
+				if (color != Square::NoColor && !bishops[color])
+				{
+					material++;
+					bishops[color] = true;
+				}
+				break;
+			}
+			case Knight:
 				material++;
-				bishops[color] = true;
+				break;
+			default:
+				material += 2;
+				break;
 			}
-			break;
-		}
-		case Knight:
-			material++;
-			break;
-		default:
-			material += 2;
-			break;
 		}
+		m_material = material;
+		m_materialDirty = false;
 	}
-	if (material <= 1)
+	if (m_material <= 1)
 	{
 		str = tr("Insufficient material");
 		return Result(Result::Draw, Side::NoSide, str);
@@ -101,6 +101,15 @@ class LIB_EXPORT WesternBoard : public Board
 		 * of the given \a type that are specified in pawnSteps.
 		 */
 		int pawnAmbiguity(StepType type = FreeStep) const;
+		/*!
+		 * Invalidates the cached material value used by result()'s
+		 * insufficient material rule. WesternBoard invalidates it
+		 * for captures, promotions, drops and bishop moves; a
+		 * variant that changes piece types by other means must
+		 * call this from its move handlers.
+		 * \sa GryphonBoard
+		 */
+		void invalidateMaterial();
 		/*!
 		 * Returns true if both counts of kings given by
 		 * \a whiteKings and \a blackKings are correct.
@@ -192,6 +201,39 @@ class LIB_EXPORT WesternBoard : public Board
 		 * If \a square is 0, then the king square is used.
 		 */
 		virtual bool inCheck(Side side, int square = 0) const;
+		/*!
+		 * Returns true if the moves of every piece type can be found
+		 * by scanning backwards from the target square with the
+		 * standard pawn, knight, bishop and rook movement patterns.
+		 *
+		 * moveFromSanString() uses this to resolve SAN tokens from a
+		 * handful of reverse lookups instead of enumerating all the
+		 * moves of the piece type. Variants that reimplement
+		 * generateMovesForPiece() with movements outside these
+		 * patterns must keep the default value of false.
+		 *
+		 * \sa StandardBoard
+		 */
+		virtual bool hasReverseMoveLookup() const;
+		/*!
+		 * Returns true if legal moves can be filtered with a
+		 * staged pin and check analysis of the position instead
+		 * of trying every pseudo-legal move on the board.
+		 *
+		 * When this returns true, vIsLegalMove() computes the
+		 * pinned pieces and checking pieces once per position
+		 * and accepts or rejects most moves from that analysis
+		 * alone; only king moves, castling and en-passant
+		 * captures go through the generic make-check-undo path.
+		 *
+		 * The default value is false. Variants where a move can
+		 * endanger the mover's king in other ways than exposing
+		 * it on a line - or where the king isn't royal at all -
+		 * must keep it.
+		 *
+		 * \sa StandardBoard
+		 */
+		virtual bool hasStagedLegalityFilter() const;
 
 		/*!
 		 * Returns FEN extensions. The default is an empty string.
@@ -228,20 +270,82 @@ class LIB_EXPORT WesternBoard : public Board
 			int rookSquare[2][2];
 		};
 
-		// Data for reversing/unmaking a move
+		// Data for reversing/unmaking a move, packed into a
+		// 16-byte record to keep long move histories compact
+		// and cache-friendly
 		struct MoveData
 		{
+			// CastlingRights::rookSquare values in 10-bit
+			// fields, least significant first, in
+			// 'side * 2 + castlingSide' order. Square indexes
+			// always fit in 10 bits (see Move).
+			quint64 rookSquares : 40;
+			quint64 enpassantSquare : 10;
+			quint64 enpassantTarget : 10;
+			quint64 castlingSide : 2;
 			Piece capture;
-			int enpassantSquare;
-			int enpassantTarget;
-			CastlingRights castlingRights;
-			CastlingSide castlingSide;
-			int reversibleMoveCount;
+			quint16 reversibleMoveCount;
+
+			void setCastlingRights(const CastlingRights& rights)
+			{
+				rookSquares = 0;
+				for (int i = 0; i < 4; i++)
+					rookSquares |= quint64(rights.rookSquare[i / 2][i % 2]) << (i * 10);
+			}
+			CastlingRights castlingRights() const
+			{
+				CastlingRights rights;
+				for (int i = 0; i < 4; i++)
+					rights.rookSquare[i / 2][i % 2] = int(rookSquares >> (i * 10)) & 0x3FF;
+				return rights;
+			}
+		};
+
+		// A piece of the side to move that can't leave the line
+		// between the king and an attacker
+		struct PinnedPiece
+		{
+			int square;
+			int direction;	// ray offset from the king
+		};
+
+		// One-entry inCheck() cache per side, keyed by
+		// position, so the repeat queries of a position
+		// collapse into lookups
+		struct CheckCache
+		{
+			bool valid;
+			quint64 key;
+			bool inCheck;
+		};
+
+		// Pin and check analysis of the current position, used
+		// by vIsLegalMove() when hasStagedLegalityFilter() is
+		// true. Rebuilt lazily and keyed by zobrist key, like
+		// the legal move cache.
+		struct LegalityContext
+		{
+			bool valid;
+			quint64 key;
+			int checkers;
+			// Squares that resolve a single check: the
+			// checker's square and the squares between the
+			// checker and the king
+			QVarLengthArray<int, 8> checkSquares;
+			QVarLengthArray<PinnedPiece, 8> pins;
 		};
 
 		void generateCastlingMoves(QVarLengthArray<Move>& moves) const;
 		void generatePawnMoves(int sourceSquare,
 				       QVarLengthArray<Move>& moves) const;
+		void generateSanCandidates(QVarLengthArray<Move>& moves,
+					   int pieceType,
+					   int target) const;
+
+		bool underAttack(Side side, int square) const;
+		void updateLegalityContext();
+		void scanKingRay(int kingSquare, int offset, unsigned movement);
+		int stagedLegalVerdict(const Move& move);
 
 		bool canCastle(CastlingSide castlingSide) const;
 		QString castlingRightsString(FenNotation notation) const;
@@ -269,7 +373,11 @@ class LIB_EXPORT WesternBoard : public Board
 		bool m_hasEnPassantCaptures;
 		bool m_pawnAmbiguous;
 		bool m_multiDigitNotation;
+		int m_material;
+		bool m_materialDirty;
 		QVector<MoveData> m_history;
+		LegalityContext m_legalityContext;
+		mutable CheckCache m_checkCache[2];
 		CastlingRights m_castlingRights;
 		int m_castleTarget[2][2];
 		const WesternZobrist* m_zobrist;
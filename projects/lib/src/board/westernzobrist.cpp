@@ -18,15 +18,13 @@
 
 #include "westernzobrist.h"
 #include <QMutexLocker>
-#include "piece.h"
 
 
 namespace Chess {
 
 WesternZobrist::WesternZobrist(const quint64* keys)
 	: Zobrist(keys),
-	  m_castlingIndex(0),
-	  m_pieceIndex(0)
+	  m_castlingIndex(0)
 {
 }
 
@@ -41,7 +39,7 @@ void WesternZobrist::initialize(int squareCount,
 	Zobrist::initialize(squareCount, pieceTypeCount);
 
 	m_castlingIndex = 1 + squareCount;
-	m_pieceIndex = m_castlingIndex + squareCount * 2;
+	setPieceIndex(m_castlingIndex + squareCount * 2);
 }
 
 quint64 WesternZobrist::side() const
@@ -49,17 +47,6 @@ quint64 WesternZobrist::side() const
 	return keys()[0];
 }
 
-quint64 WesternZobrist::piece(const Piece& piece, int square) const
-{
-	Q_ASSERT(piece.isValid());
-	Q_ASSERT(piece.type() >= 0 && piece.type() < pieceTypeCount());
-	Q_ASSERT(square >= 0 && square < squareCount());
-
-	int i = m_pieceIndex + squareCount() * pieceTypeCount() * piece.side() +
-		piece.type() * squareCount() + square;
-	return keys()[i];
-}
-
 quint64 WesternZobrist::enpassant(int square) const
 {
 	Q_ASSERT(square >= 0 && square < squareCount());
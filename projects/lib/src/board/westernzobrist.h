@@ -41,7 +41,6 @@ class LIB_EXPORT WesternZobrist : public Zobrist
 		virtual void initialize(int squareCount,
 					int pieceTypeCount);
 		virtual quint64 side() const;
-		virtual quint64 piece(const Piece& piece, int square) const;
 
 		/*!
 		 * Returns the zobrist value for an en-passant target
@@ -56,7 +55,6 @@ class LIB_EXPORT WesternZobrist : public Zobrist
 
 	private:
 		int m_castlingIndex;
-		int m_pieceIndex;
 		QMutex m_mutex;
 };
 
@@ -62,6 +62,7 @@ Zobrist::Zobrist(const quint64* keys)
 	: m_initialized(false),
 	  m_squareCount(0),
 	  m_pieceTypeCount(0),
+	  m_pieceIndex(1),
 	  m_keys(keys)
 {
 }
@@ -109,9 +110,7 @@ quint64 Zobrist::piece(const Piece& piece, int square) const
 	Q_ASSERT(piece.type() >= 0 && piece.type() < m_pieceTypeCount);
 	Q_ASSERT(square >= 0 && square < m_squareCount);
 
-	int i = 1 + m_squareCount * m_pieceTypeCount * piece.side() +
-		piece.type() * m_squareCount + square;
-	return m_keys[i];
+	return pieceKey(piece.side(), piece.type(), square);
 }
 
 quint64 Zobrist::reservePiece(const Piece& piece, int slot) const
@@ -77,6 +77,15 @@ class LIB_EXPORT Zobrist
 		 * \a piece is at slot 0.
 		 */
 		virtual quint64 reservePiece(const Piece& piece, int slot) const;
+		/*!
+		 * Returns the zobrist value for a piece of type \a pieceType
+		 * and side \a side at \a square.
+		 *
+		 * Unlike piece(), this function is non-virtual and inline, so
+		 * it can be folded into the make/undo hot path. Subclasses
+		 * control the table layout with setPieceIndex().
+		 */
+		quint64 pieceKey(int side, int pieceType, int square) const;
 
 	protected:
 		/*!
@@ -91,6 +100,11 @@ class LIB_EXPORT Zobrist
 		int pieceTypeCount() const;
 		/*! Returns the array of zobrist keys. */
 		const quint64* keys() const;
+		/*!
+		 * Sets the index of the first piece key in the key array.
+		 * The default value is 1 (right after the side-to-move key).
+		 */
+		void setPieceIndex(int index);
 
 		/*! Returns an unsigned 64-bit pseudo-random number. */
 		static quint64 random64();
@@ -102,6 +116,7 @@ class LIB_EXPORT Zobrist
 		bool m_initialized;
 		int m_squareCount;
 		int m_pieceTypeCount;
+		int m_pieceIndex;
 		const quint64* m_keys;
 };
 
@@ -120,5 +135,18 @@ inline const quint64* Zobrist::keys() const
 	return m_keys;
 }
 
+inline void Zobrist::setPieceIndex(int index)
+{
+	m_pieceIndex = index;
+}
+
+inline quint64 Zobrist::pieceKey(int side, int pieceType, int square) const
+{
+	return m_keys[m_pieceIndex
+		      + m_squareCount * m_pieceTypeCount * side
+		      + pieceType * m_squareCount
+		      + square];
+}
+
 } //namespace Chess
 #endif // ZOBRIST
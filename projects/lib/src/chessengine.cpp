@@ -22,9 +22,15 @@
 #include <QStringRef>
 #include <QtAlgorithms>
 #include "engineoption.h"
+#include "engineoptioncache.h"
+#include "timerwheel.h"
+#include "tracer.h"
 
 
 int ChessEngine::s_count = 0;
+QPointer<EngineCommLog> ChessEngine::s_commLog;
+int ChessEngine::s_stallTimeout = 90000;
+int ChessEngine::s_quitTimeout = 10000;
 
 QStringRef ChessEngine::nextToken(const QStringRef& previous, bool untilEnd)
 {
@@ -72,40 +78,97 @@ QStringRef ChessEngine::firstToken(const QString& str, bool untilEnd)
 ChessEngine::ChessEngine(QObject* parent)
 	: ChessPlayer(parent),
 	  m_id(s_count++),
+	  m_rxLineCount(0),
 	  m_pingState(NotStarted),
 	  m_pinging(false),
+	  m_pingNudged(false),
 	  m_whiteEvalPov(false),
 	  m_pondering(false),
-	  m_pingTimer(new QTimer(this)),
-	  m_quitTimer(new QTimer(this)),
-	  m_idleTimer(new QTimer(this)),
-	  m_protocolStartTimer(new QTimer(this)),
+	  m_hasPendingEval(false),
+	  m_pingTimer(new WheelTimer(this)),
+	  m_quitTimer(new WheelTimer(this)),
+	  m_idleTimer(new WheelTimer(this)),
+	  m_protocolStartTimer(new WheelTimer(this)),
+	  m_evalTimer(new QTimer(this)),
 	  m_ioDevice(nullptr),
+	  m_commLogChannel(nullptr),
 	  m_restartMode(EngineConfiguration::RestartAuto)
 {
-	m_pingTimer->setSingleShot(true);
-	m_pingTimer->setInterval(90000);
+	m_pingTimer->setInterval(s_stallTimeout);
 	connect(m_pingTimer, SIGNAL(timeout()), this, SLOT(onPingTimeout()));
 
-	m_quitTimer->setSingleShot(true);
-	m_quitTimer->setInterval(10000);
+	m_quitTimer->setInterval(s_quitTimeout);
 	connect(m_quitTimer, SIGNAL(timeout()), this, SLOT(onQuitTimeout()));
 
-	m_idleTimer->setSingleShot(true);
-	m_idleTimer->setInterval(90000);
+	m_idleTimer->setInterval(s_stallTimeout);
 	connect(m_idleTimer, SIGNAL(timeout()), this, SLOT(onIdleTimeout()));
 
-	m_protocolStartTimer->setSingleShot(true);
-	m_protocolStartTimer->setInterval(95000);
+	m_protocolStartTimer->setInterval(s_stallTimeout + 5000);
 	connect(m_protocolStartTimer, SIGNAL(timeout()),
 		this, SLOT(onProtocolStartTimeout()));
+
+	m_evalTimer->setSingleShot(true);
+	m_evalTimer->setInterval(25);
+	connect(m_evalTimer, SIGNAL(timeout()), this, SLOT(onEvalTimeout()));
+}
+
+void ChessEngine::emitThinking(const MoveEvaluation& eval)
+{
+	if (m_evalTimer->isActive())
+	{
+		// Coalesce bursts of updates: keep only the latest
+		// evaluation and deliver it when the timer fires.
+		m_pendingEval = eval;
+		m_hasPendingEval = true;
+		return;
+	}
+
+	emit thinking(eval);
+	m_evalTimer->start();
+}
+
+void ChessEngine::flushThinking()
+{
+	m_evalTimer->stop();
+	if (m_hasPendingEval)
+	{
+		m_hasPendingEval = false;
+		emit thinking(m_pendingEval);
+	}
+}
+
+void ChessEngine::onEvalTimeout()
+{
+	if (m_hasPendingEval)
+	{
+		m_hasPendingEval = false;
+		emit thinking(m_pendingEval);
+		m_evalTimer->start();
+	}
 }
 
 ChessEngine::~ChessEngine()
 {
+	if (m_commLogChannel != nullptr && !s_commLog.isNull())
+		s_commLog->releaseChannel(m_commLogChannel);
 	qDeleteAll(m_options);
 }
 
+void ChessEngine::setCommLog(EngineCommLog* log)
+{
+	s_commLog = log;
+}
+
+void ChessEngine::setStallTimeout(int msec)
+{
+	s_stallTimeout = qMax(msec, TimerWheel::Granularity);
+}
+
+void ChessEngine::setQuitTimeout(int msec)
+{
+	s_quitTimeout = qMax(msec, TimerWheel::Granularity);
+}
+
 QIODevice* ChessEngine::device() const
 {
 	return m_ioDevice;
@@ -117,6 +180,10 @@ void ChessEngine::setDevice(QIODevice* device)
 
 	m_ioDevice = device;
 	m_ioDevice->setParent(this);
+	m_readBuffer.clear();
+
+	if (!s_commLog.isNull() && m_commLogChannel == nullptr)
+		m_commLogChannel = s_commLog->createChannel(m_id);
 
 	connect(m_ioDevice, SIGNAL(readyRead()), this, SLOT(onReadyRead()));
 	connect(m_ioDevice, SIGNAL(readChannelFinished()), this, SLOT(onCrashed()));
@@ -127,6 +194,10 @@ void ChessEngine::applyConfiguration(const EngineConfiguration& configuration)
 	if (!configuration.name().isEmpty())
 		setName(configuration.name());
 
+	m_optionCacheKey = EngineOptionCache::binaryKey(
+		configuration.command(),
+		configuration.workingDirectory());
+
 	const auto initStrings = configuration.initStrings();
 	for (const QString& str : initStrings)
 		write(str);
@@ -168,7 +239,7 @@ EngineOption* ChessEngine::getOption(const QString& name) const
 	return nullptr;
 }
 
-void ChessEngine::setOption(const QString& name, const QVariant& value)
+void ChessEngine::setOption(const QString& name, const EngineOptionValue& value)
 {
 	if (state() == Starting || state() == NotStarted)
 	{
@@ -194,7 +265,21 @@ void ChessEngine::setOption(const QString& name, const QVariant& value)
 	}
 
 	option->setValue(value);
-	sendOption(option->name(), option->value());
+	updateOption(option->name(), option->value());
+}
+
+void ChessEngine::updateOption(const QString& name, const EngineOptionValue& value)
+{
+	if (m_sentOptions.contains(name) && m_sentOptions.value(name) == value)
+		return;
+
+	m_sentOptions[name] = value;
+	sendOption(name, value);
+}
+
+void ChessEngine::clearSentOptions()
+{
+	m_sentOptions.clear();
 }
 
 QList<EngineOption*> ChessEngine::options() const
@@ -202,6 +287,11 @@ QList<EngineOption*> ChessEngine::options() const
 	return m_options;
 }
 
+QString ChessEngine::optionCacheKey() const
+{
+	return m_optionCacheKey;
+}
+
 QStringList ChessEngine::variants() const
 {
 	return m_variants;
@@ -226,8 +316,9 @@ void ChessEngine::start()
 	m_pinging = false;
 	setState(Starting);
 
+	Tracer::begin("engine.init", this);
 	flushWriteBuffer();
-	
+
 	startProtocol();
 	m_pinging = true;
 	m_protocolStartTimer->start();
@@ -235,6 +326,7 @@ void ChessEngine::start()
 
 void ChessEngine::onProtocolStart()
 {
+	Tracer::end("engine.init", this);
 	m_protocolStartTimer->stop();
 	m_pinging = false;
 	setState(Idle);
@@ -242,7 +334,7 @@ void ChessEngine::onProtocolStart()
 
 	flushWriteBuffer();
 
-	QMap<QString, QVariant>::const_iterator i = m_optionBuffer.constBegin();
+	QMap<QString, EngineOptionValue>::const_iterator i = m_optionBuffer.constBegin();
 	while (i != m_optionBuffer.constEnd())
 	{
 		setOption(i.key(), i.value());
@@ -375,6 +467,7 @@ void ChessEngine::ping(bool sendCommand)
 		return;
 
 	m_pinging = true;
+	m_pingNudged = false;
 	m_pingState = state();
 	m_pingTimer->start();
 }
@@ -386,6 +479,7 @@ void ChessEngine::pong(bool emitReady)
 
 	m_pingTimer->stop();
 	m_pinging = false;
+	m_pingNudged = false;
 	flushWriteBuffer();
 
 	if (state() == FinishingGame)
@@ -410,6 +504,26 @@ void ChessEngine::pong(bool emitReady)
 
 void ChessEngine::onPingTimeout()
 {
+	// First nudge the engine by re-sending the ping: some engines
+	// drop a command when they're busy but answer a repeat. Only
+	// if the repeat also goes unanswered is the engine killed.
+	if (!m_pingNudged)
+	{
+		m_pinging = false;
+		bool sent = sendPing();
+		m_pinging = true;
+		if (sent)
+		{
+			m_pingNudged = true;
+			qWarning("Engine %s(%d): no response to ping in "
+				 "%d ms, retrying",
+				 qUtf8Printable(name()), m_id,
+				 m_pingTimer->interval());
+			m_pingTimer->start();
+			return;
+		}
+	}
+
 	setError(tr("no response to ping"));
 	qWarning("Engine %s(%d): %s",
 	         qUtf8Printable(name()), m_id,
@@ -423,6 +537,16 @@ void ChessEngine::onPingTimeout()
 }
 
 void ChessEngine::write(const QString& data, WriteMode mode)
+{
+	write(data.toLatin1(), mode);
+}
+
+void ChessEngine::write(const char* data, WriteMode mode)
+{
+	write(QByteArray(data), mode);
+}
+
+void ChessEngine::write(const QByteArray& data, WriteMode mode)
 {
 	if (state() == Disconnected)
 		return;
@@ -434,32 +558,76 @@ void ChessEngine::write(const QString& data, WriteMode mode)
 	}
 
 	Q_ASSERT(m_ioDevice->isWritable());
-	emit debugMessage(QString(">%1(%2): %3")
-			  .arg(name())
-			  .arg(m_id)
-			  .arg(data));
-
-	if (m_ioDevice->write(data.toLatin1() + "\n") == -1)
+	if (receivers(SIGNAL(debugMessage(QString))) > 0)
+		emit debugMessage(QString(">%1(%2): %3")
+				  .arg(name())
+				  .arg(m_id)
+				  .arg(QString::fromLatin1(data)));
+
+	// Reuse the output buffer's capacity instead of allocating a
+	// fresh array for every command
+	m_outBuffer.resize(0);
+	m_outBuffer += data;
+	m_outBuffer += '\n';
+	if (m_commLogChannel != nullptr)
+		m_commLogChannel->record(EngineCommLog::ToEngine,
+					 m_outBuffer.constData(),
+					 m_outBuffer.size());
+
+	if (m_ioDevice->write(m_outBuffer) == -1)
 		qWarning("Writing to engine %s(%d) failed",
 			 qUtf8Printable(name()), m_id);
 }
 
+qint64 ChessEngine::receivedLineCount() const
+{
+	return m_rxLineCount;
+}
+
 void ChessEngine::onReadyRead()
 {
-	while (m_ioDevice->isReadable() && m_ioDevice->canReadLine())
+	if (!m_ioDevice->isReadable())
+		return;
+
+	// Drain the device with one big read per batch instead of a
+	// readLine() allocation and buffer scan per line. A trailing
+	// partial line stays in m_readBuffer for the next batch.
+	const QByteArray chunk = m_ioDevice->readAll();
+	if (m_commLogChannel != nullptr)
+		m_commLogChannel->record(EngineCommLog::FromEngine,
+					 chunk.constData(), chunk.size());
+	m_readBuffer.append(chunk);
+
+	// Timestamp the batch right away so that the parsing below
+	// doesn't count against the engine's clock
+	markDataArrival();
+
+	// Only build the debug strings if something is listening
+	const bool debug = receivers(SIGNAL(debugMessage(QString))) > 0;
+
+	int start = 0;
+	int newline;
+	while ((newline = m_readBuffer.indexOf('\n', start)) != -1)
 	{
-		QString line = QString(m_ioDevice->readLine());
-		if (line.endsWith('\n'))
-			line.chop(1);
-		if (line.endsWith('\r'))
-			line.chop(1);
-		if (line.isEmpty())
+		int end = newline;
+		while (end > start && m_readBuffer.at(end - 1) == '\r')
+			end--;
+		if (end == start)
+		{
+			start = newline + 1;
 			continue;
+		}
 
-		emit debugMessage(QString("<%1(%2): %3")
-				  .arg(name())
-				  .arg(m_id)
-				  .arg(line));
+		const QString line(QString::fromUtf8(
+			m_readBuffer.constData() + start, end - start));
+		start = newline + 1;
+
+		if (debug)
+			emit debugMessage(QString("<%1(%2): %3")
+					  .arg(name())
+					  .arg(m_id)
+					  .arg(line));
+		m_rxLineCount++;
 		parseLine(line);
 
 		if (m_idleTimer->isActive())
@@ -470,6 +638,8 @@ void ChessEngine::onReadyRead()
 				m_idleTimer->stop();
 		}
 	}
+	if (start > 0)
+		m_readBuffer.remove(0, start);
 }
 
 void ChessEngine::flushWriteBuffer()
@@ -477,7 +647,7 @@ void ChessEngine::flushWriteBuffer()
 	if (m_pinging || state() == NotStarted)
 		return;
 
-	for (const QString& line : qAsConst(m_writeBuffer))
+	for (const QByteArray& line : qAsConst(m_writeBuffer))
 		write(line);
 	m_writeBuffer.clear();
 }
@@ -521,6 +691,8 @@ void ChessEngine::quit()
 	disconnect(m_ioDevice, SIGNAL(readChannelFinished()), this, SLOT(onCrashed()));
 	connect(m_ioDevice, SIGNAL(readChannelFinished()), this, SLOT(onQuitTimeout()));
 	sendQuit();
+	// The timeout may have been shortened after this engine was created
+	m_quitTimer->setInterval(s_quitTimeout);
 	m_quitTimer->start();
 }
 
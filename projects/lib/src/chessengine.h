@@ -22,10 +22,13 @@
 #include "chessplayer.h"
 #include <QVariant>
 #include <QStringList>
+#include <QPointer>
 #include "engineconfiguration.h"
+#include "enginecommlog.h"
+#include "engineoption.h"
 
 class QIODevice;
-class EngineOption;
+class WheelTimer;
 
 
 /*!
@@ -63,6 +66,43 @@ class LIB_EXPORT ChessEngine : public ChessPlayer
 		/*! Sets the current device to \a device. */
 		void setDevice(QIODevice* device);
 
+		/*!
+		 * Sets the binary communication log that all engines
+		 * record their raw input and output to.
+		 *
+		 * The log must be set before the engines are created
+		 * and must outlive them. A null \a log (the default)
+		 * disables recording.
+		 */
+		static void setCommLog(EngineCommLog* log);
+
+		/*!
+		 * Sets the stalled-engine timeout of all engines to
+		 * \a msec milliseconds.
+		 *
+		 * An engine that doesn't respond to a ping within the
+		 * timeout first gets the ping re-sent (some engines
+		 * drop a command when busy but answer a repeat); if it
+		 * stays silent for another timeout it's terminated and
+		 * forfeits the game. The effective granularity is that
+		 * of the timer wheel (100 ms). The default timeout is
+		 * 90 seconds.
+		 */
+		static void setStallTimeout(int msec);
+
+		/*!
+		 * Sets the quit timeout of all engines to \a msec
+		 * milliseconds.
+		 *
+		 * An engine that doesn't close its side of the
+		 * connection within the timeout after receiving the
+		 * quit command gets its process terminated. The default
+		 * timeout is 10 seconds; an aborting tournament
+		 * shortens it so that unresponsive engines can't hold
+		 * up the shutdown.
+		 */
+		static void setQuitTimeout(int msec);
+
 		// Inherited from ChessPlayer
 		virtual void endGame(const Chess::Result& result);
 		virtual bool isHuman() const;
@@ -96,6 +136,15 @@ class LIB_EXPORT ChessEngine : public ChessPlayer
 		/*! Returns the engine's chess protocol. */
 		virtual QString protocol() const = 0;
 
+		/*!
+		 * Returns the total number of lines received from the
+		 * engine so far.
+		 *
+		 * ChessGame samples this at game boundaries to compute
+		 * per-game output rates.
+		 */
+		qint64 receivedLineCount() const;
+
 		/*!
 		 * Writes text data to the chess engine.
 		 *
@@ -103,6 +152,17 @@ class LIB_EXPORT ChessEngine : public ChessPlayer
 		 * the device immediately even if the engine is being pinged.
 		 */
 		void write(const QString& data, WriteMode mode = Buffered);
+		/*!
+		 * Writes raw byte data to the chess engine.
+		 *
+		 * This variant skips the Unicode-to-Latin-1 conversion, so
+		 * commands that are assembled as bytes (moves and FEN
+		 * strings are pure ASCII) reach the device without a
+		 * transcoding pass.
+		 */
+		void write(const QByteArray& data, WriteMode mode = Buffered);
+		/*! \overload */
+		void write(const char* data, WriteMode mode = Buffered);
 
 		/*!
 		 * Sets an option with the name \a name to \a value.
@@ -110,7 +170,7 @@ class LIB_EXPORT ChessEngine : public ChessPlayer
 		 * \note If the engine doesn't have an option called \a name,
 		 * nothing happens.
 		 */
-		void setOption(const QString& name, const QVariant& value);
+		void setOption(const QString& name, const EngineOptionValue& value);
 
 		/*! Returns a list of supported options and their values. */
 		QList<EngineOption*> options() const;
@@ -156,6 +216,33 @@ class LIB_EXPORT ChessEngine : public ChessPlayer
 		static QStringRef nextToken(const QStringRef& previous,
 					    bool readToEnd = false);
 
+		/*!
+		 * Emits the thinking() signal with \a eval.
+		 *
+		 * Rapid updates are coalesced: at most one signal is
+		 * emitted per a short interval and only the latest
+		 * evaluation is kept in between, so a fast engine can't
+		 * flood the signal queue with stale updates.
+		 */
+		void emitThinking(const MoveEvaluation& eval);
+		/*!
+		 * Emits a pending coalesced evaluation update immediately.
+		 *
+		 * Should be called before emitting a move so that
+		 * consumers see the final evaluation before the move.
+		 */
+		void flushThinking();
+
+		/*!
+		 * Returns the key under which the engine's discovered
+		 * options can be cached, or an empty string if the
+		 * engine binary couldn't be resolved.
+		 *
+		 * The key is set by applyConfiguration().
+		 * \sa EngineOptionCache
+		 */
+		QString optionCacheKey() const;
+
 		// Inherited from ChessPlayer
 		virtual void startGame() = 0;
 
@@ -196,7 +283,22 @@ class LIB_EXPORT ChessEngine : public ChessPlayer
 		 */
 		EngineOption* getOption(const QString& name) const;
 		/*! Tells the engine to set option \a name's value to \a value. */
-		virtual void sendOption(const QString& name, const QVariant& value) = 0;
+		virtual void sendOption(const QString& name,
+					const EngineOptionValue& value) = 0;
+		/*!
+		 * Sends option \a name to the engine only if \a value
+		 * differs from the last value that was sent.
+		 *
+		 * Some engines reload large resources (eg. evaluation
+		 * nets) whenever an option is set, so re-sending an
+		 * unchanged value between games can cost seconds.
+		 */
+		void updateOption(const QString& name, const EngineOptionValue& value);
+		/*!
+		 * Forgets which option values have been sent, forcing
+		 * the next updateOption() calls to send everything.
+		 */
+		void clearSentOptions();
 
 		/*! Adds \a variant to the list of supported variants. */
 		void addVariant(const QString& variant);
@@ -272,26 +374,40 @@ class LIB_EXPORT ChessEngine : public ChessPlayer
 	private slots:
 		void onQuitTimeout();
 		void onProtocolStartTimeout();
+		void onEvalTimeout();
 
 	private:
 		static int s_count;
+		static QPointer<EngineCommLog> s_commLog;
+		static int s_stallTimeout;
+		static int s_quitTimeout;
 
 		int m_id;
+		qint64 m_rxLineCount;
 		State m_pingState;
 		bool m_pinging;
+		bool m_pingNudged;
 		bool m_whiteEvalPov;
 		bool m_pondering;
-		QTimer* m_pingTimer;
-		QTimer* m_quitTimer;
-		QTimer* m_idleTimer;
-		QTimer* m_protocolStartTimer;
+		bool m_hasPendingEval;
+		MoveEvaluation m_pendingEval;
+		WheelTimer* m_pingTimer;
+		WheelTimer* m_quitTimer;
+		WheelTimer* m_idleTimer;
+		WheelTimer* m_protocolStartTimer;
+		QTimer* m_evalTimer;
 		QIODevice *m_ioDevice;
-		QStringList m_writeBuffer;
+		EngineCommLog::Channel* m_commLogChannel;
+		QByteArray m_readBuffer;
+		QByteArray m_outBuffer;
+		QList<QByteArray> m_writeBuffer;
 		QStringList m_variants;
 		QList<EngineOption*> m_options;
-		QMap<QString, QVariant> m_optionBuffer;
+		QMap<QString, EngineOptionValue> m_optionBuffer;
+		QMap<QString, EngineOptionValue> m_sentOptions;
 		EngineConfiguration::RestartMode m_restartMode;
 		QString m_configurationString;
+		QString m_optionCacheKey;
 };
 
 #endif // CHESSENGINE_H
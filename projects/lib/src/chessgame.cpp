@@ -26,6 +26,9 @@
 #include "openingbook.h"
 #include "chessengine.h"
 #include "engineoption.h"
+#include "mersenne.h"
+#include "metrics.h"
+#include "tracer.h"
 
 QString ChessGame::evalString(const MoveEvaluation& eval, const Chess::Move& move)
 {
@@ -273,6 +276,8 @@ QString ChessGame::statusString(const Chess::Move& move, bool doMove)
 ChessGame::ChessGame(Chess::Board* board, PgnGame* pgn, QObject* parent)
 	: QObject(parent),
 	  m_board(board),
+	  m_openingDeferred(false),
+	  m_openingSeed(0),
 	  m_startDelay(0),
 	  m_finished(false),
 	  m_gameInProgress(false),
@@ -280,6 +285,9 @@ ChessGame::ChessGame(Chess::Board* board, PgnGame* pgn, QObject* parent)
 	  m_pgnInitialized(false),
 	  m_bookOwnership(false),
 	  m_boardShouldBeFlipped(false),
+	  m_adjudicationPending(false),
+	  m_recoveryRetries(0),
+	  m_recovering(false),
 	  m_pgn(pgn)
 {
 	Q_ASSERT(pgn != nullptr);
@@ -289,6 +297,11 @@ ChessGame::ChessGame(Chess::Board* board, PgnGame* pgn, QObject* parent)
 		m_player[i] = nullptr;
 		m_book[i] = nullptr;
 		m_bookDepth[i] = 0;
+		// Time usage is a percentage, so linear 10 % buckets
+		m_timeUsageStats[i] = Histogram(10, 11);
+		m_timeNearMisses[i] = 0;
+		m_startLineCount[i] = 0;
+		m_infoLineRate[i] = 0;
 	}
 }
 
@@ -392,6 +405,17 @@ void ChessGame::stop(bool emitMoveChanged)
 
 	initializePgn();
 	m_gameInProgress = false;
+	Tracer::end("game", this);
+
+	const qint64 gameMsecs = qMax(m_gameTimer.elapsed(), qint64(1));
+	for (int i = 0; i < 2; i++)
+	{
+		auto engine = qobject_cast<ChessEngine*>(m_player[i]);
+		if (engine != nullptr)
+			m_infoLineRate[i] =
+				(engine->receivedLineCount()
+				 - m_startLineCount[i]) * 1000 / gameMsecs;
+	}
 	const QVector<PgnGame::MoveData>& moves(m_pgn->moves());
 	int plies = moves.size();
 
@@ -406,7 +430,9 @@ void ChessGame::stop(bool emitMoveChanged)
 	if (emitMoveChanged && plies > 1)
 	{
 		const PgnGame::MoveData& md(moves.at(plies - 1));
-		emit moveChanged(plies - 1, md.move, md.moveString, md.comment);
+		emit moveChanged(plies - 1, md.move,
+				 QString::fromUtf8(md.moveString),
+				 QString::fromUtf8(md.comment));
 	}
 
 	m_player[Chess::Side::White]->endGame(m_result);
@@ -444,8 +470,9 @@ void ChessGame::addPgnMove(const Chess::Move& move, const QString& comment)
 	PgnGame::MoveData md;
 	md.key = m_board->key();
 	md.move = m_board->genericMove(move);
-	md.moveString = m_board->moveString(move, Chess::Board::StandardAlgebraic);
-	md.comment = comment;
+	md.moveString = m_board->moveString(move,
+		Chess::Board::StandardAlgebraic).toUtf8();
+	md.comment = comment.toUtf8();
 
 	m_board->makeMove(move);
 	m_pgn->addMove(md, m_board->key());
@@ -465,7 +492,8 @@ void ChessGame::emitLastMove()
 	}
 
 	const auto& md = m_pgn->moves().last();
-	emit moveMade(md.move, md.moveString, md.comment);
+	emit moveMade(md.move, QString::fromUtf8(md.moveString),
+		      QString::fromUtf8(md.comment));
 }
 
 void ChessGame::onMoveMade(const Chess::Move& move)
@@ -482,31 +510,75 @@ void ChessGame::onMoveMade(const Chess::Move& move)
 		return;
 	}
 
+	Tracer::end("think", this);
+
+	// A book move can arrive before the previous move's queued
+	// adjudication has run; do it now, while the board is still in
+	// the position the pending eval belongs to
+	if (m_adjudicationPending)
+	{
+		adjudicateMove();
+		if (m_finished)
+			return;
+	}
+
 	m_scores[m_moves.size()] = sender->evaluation().score();
 	m_moves.append(move);
 	addPgnMove(move, evalString(sender->evaluation(), move));
 
+	const TimeControl* tc = sender->timeControl();
+	const int moveTime = tc->lastMoveTime();
+	Metrics::add(Metrics::MovesMade);
+	Metrics::add(Metrics::MoveTimeMsecs, moveTime);
+
+	const Chess::Side side = m_board->sideToMove();
+	m_moveTimeStats[side].add(moveTime);
+	if (!tc->isInfinite())
+	{
+		// The time that was available for this move is what it
+		// took plus what's still on the clock
+		const qint64 budget = moveTime + qMax(tc->timeLeft(), 0);
+		if (budget > 0)
+		{
+			const int usage = int(qint64(moveTime) * 100 / budget);
+			m_timeUsageStats[side].add(usage);
+			if (usage >= 95)
+				m_timeNearMisses[side]++;
+		}
+	}
+
 	// Get the result before sending the move to the opponent
 	m_board->makeMove(move);
 	m_result = m_board->result();
-	if (m_result.isNone())
-	{
-		if (m_board->reversibleMoveCount() == 0)
-			m_adjudicator.resetDrawMoveCount();
-
-		m_adjudicator.addEval(m_board, sender->evaluation());
-		m_result = m_adjudicator.result();
-	}
 	m_board->undoMove();
 
 	ChessPlayer* player = playerToWait();
-	player->makeMove(move);
+	{
+		TraceSpan span("relay", this);
+		// A player being restarted after a crash gets the move
+		// with the rest of the history once it's ready
+		if (!m_recovering || player != m_player[m_recoverySide])
+			player->makeMove(move);
+	}
 	m_board->makeMove(move);
 
 	if (m_result.isNone())
 	{
 		emitLastMove();
-		startTurn();
+
+		// Run draw/resign adjudication and tablebase probing only
+		// after the move has been relayed and the next player told
+		// to go, so a slow probe overlaps the player's thinking
+		// instead of stalling the relay
+		m_pendingEval = sender->evaluation();
+		m_adjudicationPending = true;
+		QMetaObject::invokeMethod(this, "adjudicateMove",
+					  Qt::QueuedConnection);
+
+		// During recovery the turn starts when the restarted
+		// engine has caught up
+		if (!m_recovering)
+			startTurn();
 	}
 	else
 	{
@@ -515,6 +587,24 @@ void ChessGame::onMoveMade(const Chess::Move& move)
 	}
 }
 
+void ChessGame::adjudicateMove()
+{
+	if (!m_adjudicationPending || m_finished || !m_gameInProgress)
+		return;
+	m_adjudicationPending = false;
+
+	if (m_board->reversibleMoveCount() == 0)
+		m_adjudicator.resetDrawMoveCount();
+	m_adjudicator.addEval(m_board, m_pendingEval);
+
+	Chess::Result result = m_adjudicator.result();
+	if (result.isNone())
+		return;
+
+	m_result = result;
+	stop();
+}
+
 void ChessGame::startTurn()
 {
 	if (m_paused)
@@ -525,7 +615,13 @@ void ChessGame::startTurn()
 
 	emit humanEnabled(m_player[side]->isHuman());
 
+	Tracer::begin("book", this);
 	Chess::Move move(bookMove(side));
+	Tracer::end("book", this);
+
+	// The span ends in onMoveMade(); for a book move it measures
+	// the move's round trip through the player object
+	Tracer::begin("think", this);
 	if (move.isNull())
 	{
 		m_player[side]->go();
@@ -574,6 +670,27 @@ void ChessGame::onResultClaim(const Chess::Result& result)
 		if (m_player[side] != sender)
 			side = Chess::Side::Black;
 		m_result = Chess::Result(result.type(), side.opposite());
+
+		if (m_gameInProgress
+		&&  m_recoveryRetries > 0
+		&&  !sender->isHuman()
+		&&  (!m_recovering || side == m_recoverySide))
+		{
+			m_recoveryRetries--;
+			m_recovering = true;
+			m_recoverySide = side;
+			// Snapshot the crashed player's clock so the
+			// restarted engine continues with the time that
+			// was left at the start of the interrupted move
+			m_recoveryClock = *sender->timeControl();
+
+			qWarning("%s disconnected, restarting (%d %s left)",
+				 qUtf8Printable(sender->name()),
+				 m_recoveryRetries,
+				 m_recoveryRetries == 1 ? "retry" : "retries");
+			emit playerCrashed(side);
+			return;
+		}
 	}
 	else if (!m_gameInProgress && result.winner().isNull())
 	{
@@ -604,7 +721,16 @@ Chess::Move ChessGame::bookMove(Chess::Side side)
 	||  m_moves.size() >= m_bookDepth[side] * 2)
 		return Chess::Move();
 
-	Chess::GenericMove bookMove = m_book[side]->move(m_board->key());
+	Chess::GenericMove bookMove;
+	const quint64 key = m_board->key();
+	const auto it = m_bookCache[side].constFind(key);
+	if (it != m_bookCache[side].constEnd())
+		bookMove = it.value();
+	else
+	{
+		bookMove = m_book[side]->move(key);
+		m_bookCache[side].insert(key, bookMove);
+	}
 	Chess::Move move = m_board->moveFromGenericMove(bookMove);
 	if (move.isNull())
 		return Chess::Move();
@@ -649,6 +775,12 @@ void ChessGame::setTimeControl(const TimeControl& timeControl, Chess::Side side)
 		m_timeControl[Chess::Side::White] = timeControl;
 }
 
+const TimeControl* ChessGame::timeControl(Chess::Side side) const
+{
+	Q_ASSERT(!side.isNull());
+	return &m_timeControl[side];
+}
+
 void ChessGame::setMoves(const QVector<Chess::Move>& moves)
 {
 	Q_ASSERT(!m_gameInProgress);
@@ -656,7 +788,7 @@ void ChessGame::setMoves(const QVector<Chess::Move>& moves)
 	m_moves = moves;
 }
 
-bool ChessGame::setMoves(const PgnGame& pgn)
+bool ChessGame::setMoves(const PgnGame& pgn, bool validate)
 {
 	setStartingFen(pgn.startingFenString());
 	if (!resetBoard())
@@ -664,10 +796,18 @@ bool ChessGame::setMoves(const PgnGame& pgn)
 	m_scores.clear();
 	m_moves.clear();
 
+	// The moves were parsed under the rules of the PGN's own
+	// variant, so they can only be trusted if it's also the
+	// variant they're replayed under
+	if (pgn.variant() != m_board->variant())
+		validate = true;
+
 	for (const PgnGame::MoveData& md : pgn.moves())
 	{
 		Chess::Move move(m_board->moveFromGenericMove(md.move));
-		if (!m_board->isLegalMove(move))
+		if (move.isNull())
+			return false;
+		if (validate && !m_board->isLegalMove(move))
 			return false;
 
 		m_board->makeMove(move);
@@ -705,7 +845,7 @@ void ChessGame::setAdjudicator(const GameAdjudicator& adjudicator)
 
 void ChessGame::generateOpening()
 {
-	if (m_book[Chess::Side::White] == nullptr || m_book[Chess::Side::Black] == nullptr)
+	if (m_book[Chess::Side::White] == nullptr && m_book[Chess::Side::Black] == nullptr)
 		return;
 	if (!resetBoard())
 		return;
@@ -721,10 +861,18 @@ void ChessGame::generateOpening()
 			return;
 	}
 
-	// Then play the opening book moves
+	// Then pre-walk the book line as far as the books can see, so
+	// that the book phase replays without probing once the game is
+	// running. The walk ends at the first position where the side
+	// to move has no book: the opponent's reply isn't known in
+	// advance, so those positions have to be probed live.
 	for (;;)
 	{
-		Chess::Move move = bookMove(m_board->sideToMove());
+		Chess::Side side(m_board->sideToMove());
+		if (m_book[side] == nullptr)
+			break;
+
+		Chess::Move move = bookMove(side);
 		if (move.isNull())
 			break;
 
@@ -736,6 +884,12 @@ void ChessGame::generateOpening()
 	}
 }
 
+void ChessGame::generateOpeningLater(quint64 seed)
+{
+	m_openingDeferred = true;
+	m_openingSeed = seed;
+}
+
 void ChessGame::emitStartFailed()
 {
 	emit startFailed(this);
@@ -752,6 +906,101 @@ void ChessGame::setBookOwnership(bool enabled)
 	m_bookOwnership = enabled;
 }
 
+void ChessGame::setCrashRecovery(int retries)
+{
+	Q_ASSERT(retries >= 0);
+	m_recoveryRetries = retries;
+}
+
+void ChessGame::replacePlayer(Chess::Side side, ChessPlayer* player)
+{
+	Q_ASSERT(!side.isNull());
+
+	if (!m_recovering || side != m_recoverySide)
+		return;
+
+	ChessPlayer* crashed = m_player[side];
+	if (crashed != nullptr)
+		crashed->disconnect(this);
+
+	if (player == nullptr)
+	{
+		// The engine couldn't be restarted; fall back to the
+		// normal disconnection forfeit
+		m_recovering = false;
+		stop();
+		return;
+	}
+
+	m_player[side] = player;
+	connect(player, &ChessPlayer::resultClaim,
+		this, &ChessGame::onResultClaim, Qt::DirectConnection);
+	connect(player, &ChessPlayer::moveMade,
+		this, &ChessGame::onMoveMade, Qt::DirectConnection);
+
+	if (player->isReady())
+		finishRecovery();
+	else
+		connect(player, SIGNAL(ready()),
+			this, SLOT(onRecoveredPlayerReady()));
+}
+
+void ChessGame::onRecoveredPlayerReady()
+{
+	ChessPlayer* sender = qobject_cast<ChessPlayer*>(QObject::sender());
+	Q_ASSERT(sender != nullptr);
+
+	disconnect(sender, SIGNAL(ready()),
+		   this, SLOT(onRecoveredPlayerReady()));
+
+	finishRecovery();
+}
+
+void ChessGame::finishRecovery()
+{
+	// The game may have ended (or the replacement may have crashed
+	// too) while the engine was initializing
+	if (m_finished || !m_recovering)
+		return;
+
+	ChessPlayer* player = m_player[m_recoverySide];
+	if (player->state() == ChessPlayer::Disconnected)
+		return;
+
+	// Rewind the board and hand it to the restarted engine at the
+	// starting position, then replay the move history so that the
+	// engine sees the same game - repetitions included - as its
+	// opponent does.
+	for (int i = m_moves.size(); i > 0; i--)
+		m_board->undoMove();
+
+	player->setTimeControl(m_timeControl[m_recoverySide]);
+	player->newGame(m_recoverySide,
+			m_player[m_recoverySide.opposite()], m_board);
+
+	for (const Chess::Move& move : qAsConst(m_moves))
+	{
+		player->makeMove(move);
+		m_board->makeMove(move);
+	}
+
+	// newGame() reset the clock to a full time control; restore
+	// what the crashed engine had left
+	player->setTimeControl(m_recoveryClock);
+
+	m_recoveryLog << QString("%1 before move %2")
+			 .arg(player->name())
+			 .arg(m_moves.size() / 2 + 1);
+	m_pgn->setTag("EngineRestarts", m_recoveryLog.join(", "));
+
+	m_recovering = false;
+
+	// If the opponent was mid-think when the crash happened its
+	// clock never stopped; don't tell it to move again
+	if (playerToMove()->state() != ChessPlayer::Thinking)
+		startTurn();
+}
+
 void ChessGame::pauseThread()
 {
 	m_pauseSem.release();
@@ -775,6 +1024,26 @@ void ChessGame::unlockThread()
 	m_resumeSem.release();
 }
 
+const Histogram& ChessGame::moveTimeStats(Chess::Side side) const
+{
+	return m_moveTimeStats[side];
+}
+
+const Histogram& ChessGame::timeUsageStats(Chess::Side side) const
+{
+	return m_timeUsageStats[side];
+}
+
+int ChessGame::timeNearMisses(Chess::Side side) const
+{
+	return m_timeNearMisses[side];
+}
+
+qint64 ChessGame::infoLineRate(Chess::Side side) const
+{
+	return m_infoLineRate[side];
+}
+
 bool ChessGame::resetBoard()
 {
 	QString fen(m_startingFen);
@@ -855,8 +1124,8 @@ void ChessGame::start()
 
 	for (int i = 0; i < 2; i++)
 	{
-		connect(m_player[i], SIGNAL(resultClaim(Chess::Result)),
-			this, SLOT(onResultClaim(Chess::Result)));
+		connect(m_player[i], &ChessPlayer::resultClaim,
+			this, &ChessGame::onResultClaim, Qt::DirectConnection);
 	}
 
 	// Start the game in the correct thread
@@ -866,6 +1135,18 @@ void ChessGame::start()
 
 	m_result = Chess::Result();
 	emit humanEnabled(false);
+
+	// A deferred book walk runs here, on the game's thread, where
+	// it overlaps the engines' initialization: their ready signals
+	// arrive through the event loop only after start() returns, and
+	// startGame() replays the opening the moment both are ready.
+	if (m_openingDeferred)
+	{
+		m_openingDeferred = false;
+		Mersenne::initializeThread(m_openingSeed);
+		generateOpening();
+	}
+
 	resetBoard();
 	initializePgn();
 	emit initialized(this);
@@ -936,6 +1217,8 @@ void ChessGame::startGame()
 		return;
 
 	m_gameInProgress = true;
+	m_gameTimer.start();
+	Tracer::begin("game", this);
 	for (int i = 0; i < 2; i++)
 	{
 		ChessPlayer* player = m_player[i];
@@ -976,6 +1259,10 @@ void ChessGame::startGame()
 		Q_ASSERT(m_timeControl[side].isValid());
 		m_player[side]->setTimeControl(m_timeControl[side]);
 		m_player[side]->newGame(side, m_player[side.opposite()], m_board);
+
+		auto engine = qobject_cast<ChessEngine*>(m_player[side]);
+		m_startLineCount[side] = engine != nullptr
+				       ? engine->receivedLineCount() : 0;
 	}
 
 	// Play the forced opening moves first
@@ -992,10 +1279,11 @@ void ChessGame::startGame()
 		
 		emitLastMove();
 
-		if (!m_board->result().isNone())
+		Chess::Result result(m_board->result());
+		if (!result.isNone())
 		{
 			qWarning("Every move was played from the book");
-			m_result = m_board->result();
+			m_result = result;
 			stop();
 			return;
 		}
@@ -1003,8 +1291,13 @@ void ChessGame::startGame()
 	
 	for (int i = 0; i < 2; i++)
 	{
-		connect(m_player[i], SIGNAL(moveMade(Chess::Move)),
-			this, SLOT(onMoveMade(Chess::Move)));
+		// The players live on the game's thread, so the move
+		// relay can use compile-checked direct dispatch instead
+		// of going through the event queue; queued delivery is
+		// only needed by cross-thread (GUI) consumers.
+		Q_ASSERT(m_player[i]->thread() == thread());
+		connect(m_player[i], &ChessPlayer::moveMade,
+			this, &ChessGame::onMoveMade, Qt::DirectConnection);
 		if (m_player[i]->isHuman())
 			connect(m_player[i], SIGNAL(wokeUp()),
 				this, SLOT(resume()));
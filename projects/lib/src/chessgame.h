@@ -26,13 +26,15 @@
 #include "pgngame.h"
 #include "board/result.h"
 #include "board/move.h"
+#include <QElapsedTimer>
 #include "timecontrol.h"
 #include "gameadjudicator.h"
+#include "moveevaluation.h"
+#include "histogram.h"
 
 namespace Chess { class Board; }
 class ChessPlayer;
 class OpeningBook;
-class MoveEvaluation;
 
 
 class LIB_EXPORT ChessGame : public QObject
@@ -63,20 +65,95 @@ class LIB_EXPORT ChessGame : public QObject
 		void setStartingFen(const QString& fen);
 		void setTimeControl(const TimeControl& timeControl,
 				    Chess::Side side = Chess::Side());
+		/*! Returns the time control of the player on \a side. */
+		const TimeControl* timeControl(Chess::Side side) const;
 		void setMoves(const QVector<Chess::Move>& moves);
-		bool setMoves(const PgnGame& pgn);
+		/*!
+		 * Sets the game's opening moves from \a pgn.
+		 *
+		 * If \a validate is false the moves are trusted and
+		 * replayed without per-move legality checks. This is
+		 * safe for openings whose source already validated
+		 * them, like OpeningSuite games parsed from PGN. The
+		 * flag is ignored, and the moves are validated anyway,
+		 * if \a pgn uses a different variant than the game:
+		 * moves parsed under another variant's rules can be
+		 * illegal in this one.
+		 */
+		bool setMoves(const PgnGame& pgn, bool validate = true);
 		void setOpeningBook(const OpeningBook* book,
 				    Chess::Side side = Chess::Side(),
 				    int depth = 1000);
 		void setAdjudicator(const GameAdjudicator& adjudicator);
 		void setStartDelay(int time);
 		void setBookOwnership(bool enabled);
+		/*!
+		 * Allows up to \a retries in-game engine restarts after
+		 * a crash.
+		 *
+		 * By default a crashed engine forfeits the game. With a
+		 * nonzero retry budget the game instead emits
+		 * playerCrashed(), expecting its handler to call
+		 * replacePlayer() with a newly built player. The game
+		 * then replays the move history to the new engine,
+		 * restores its remaining clock time and continues. Each
+		 * restart is recorded in the PGN's "EngineRestarts" tag.
+		 */
+		void setCrashRecovery(int retries);
+		/*!
+		 * Hands the game a replacement for the crashed player on
+		 * \a side, or a null \a player if the engine could not
+		 * be restarted, in which case the game ends with the
+		 * normal disconnection forfeit.
+		 */
+		void replacePlayer(Chess::Side side, ChessPlayer* player);
 
 		void generateOpening();
+		/*!
+		 * Generates the opening moves later, on the game's own
+		 * thread, right before the game begins.
+		 *
+		 * The book walk of generateOpening() then overlaps the
+		 * engines' initialization instead of delaying it: it
+		 * runs after the game has moved to its thread, while
+		 * the engines are still starting up, and the opening is
+		 * replayed to them the moment both report ready. \a seed
+		 * seeds the game thread's random stream so the deferred
+		 * book picks match the ones an up-front call would make.
+		 *
+		 * Use generateOpening() instead when the resolved
+		 * opening is needed right away, eg. for repeating it in
+		 * a later game.
+		 */
+		void generateOpeningLater(quint64 seed);
 
 		void lockThread();
 		void unlockThread();
 
+		/*!
+		 * Returns the distribution of the move times (in
+		 * milliseconds) of the player on \a side.
+		 */
+		const Histogram& moveTimeStats(Chess::Side side) const;
+		/*!
+		 * Returns the distribution of the share (in percent) of
+		 * the available time the player on \a side spent per
+		 * move.
+		 */
+		const Histogram& timeUsageStats(Chess::Side side) const;
+		/*!
+		 * Returns the number of moves on which the player on
+		 * \a side used at least 95 percent of its available
+		 * time, ie. came close to a time forfeit.
+		 */
+		int timeNearMisses(Chess::Side side) const;
+		/*!
+		 * Returns the average rate (lines per second) at which
+		 * the engine on \a side sent output during the game, or
+		 * zero for non-engine players.
+		 */
+		qint64 infoLineRate(Chess::Side side) const;
+
 	public slots:
 		void start();
 		void pause();
@@ -106,18 +183,29 @@ class LIB_EXPORT ChessGame : public QObject
 		void startFailed(ChessGame* game = nullptr);
 		void playersReady();
 		void pgnMove();
+		/*!
+		 * Emitted when the player on \a side crashed mid-game
+		 * and the crash recovery budget allows a restart.
+		 *
+		 * The receiver should rebuild the player and pass it to
+		 * replacePlayer().
+		 */
+		void playerCrashed(Chess::Side side);
 
 	private slots:
 		void startGame();
 		void startTurn();
+		void adjudicateMove();
 		void finish();
 		void onResultClaim(const Chess::Result& result);
 		void onPlayerReady();
+		void onRecoveredPlayerReady();
 		void syncPlayers();
 		void pauseThread();
 
 	private:
 		Chess::Move bookMove(Chess::Side side);
+		void finishRecovery();
 		bool resetBoard();
 		void initializePgn();
 		void addPgnMove(const Chess::Move& move, const QString& comment);
@@ -131,6 +219,13 @@ class LIB_EXPORT ChessGame : public QObject
 		TimeControl m_timeControl[2];
 		const OpeningBook* m_book[2];
 		int m_bookDepth[2];
+		// Per-side memo of book probes, so a position that was
+		// already probed during the pre-walk isn't probed again
+		// during the game
+		QMap<quint64, Chess::GenericMove> m_bookCache[2];
+		// Deferred opening generation; see generateOpeningLater()
+		bool m_openingDeferred;
+		quint64 m_openingSeed;
 		int m_startDelay;
 		bool m_finished;
 		bool m_gameInProgress;
@@ -138,6 +233,15 @@ class LIB_EXPORT ChessGame : public QObject
 		bool m_pgnInitialized;
 		bool m_bookOwnership;
 		bool m_boardShouldBeFlipped;
+		bool m_adjudicationPending;
+		// In-game crash recovery: remaining restart budget, the
+		// side being restarted, and the crashed player's clock
+		// snapshot for the restarted engine
+		int m_recoveryRetries;
+		bool m_recovering;
+		Chess::Side m_recoverySide;
+		TimeControl m_recoveryClock;
+		QStringList m_recoveryLog;
 		QString m_error;
 		QString m_startingFen;
 		Chess::Result m_result;
@@ -147,6 +251,15 @@ class LIB_EXPORT ChessGame : public QObject
 		QSemaphore m_pauseSem;
 		QSemaphore m_resumeSem;
 		GameAdjudicator m_adjudicator;
+		MoveEvaluation m_pendingEval;
+		// Per-side latency statistics, merged into per-engine
+		// totals by Tournament when the game finishes
+		Histogram m_moveTimeStats[2];
+		Histogram m_timeUsageStats[2];
+		int m_timeNearMisses[2];
+		qint64 m_startLineCount[2];
+		qint64 m_infoLineRate[2];
+		QElapsedTimer m_gameTimer;
 };
 
 #endif // CHESSGAME_H
@@ -19,12 +19,13 @@
 #include "chessplayer.h"
 #include <QTimer>
 #include "board/board.h"
+#include "timerwheel.h"
 
 
 ChessPlayer::ChessPlayer(QObject* parent)
 	: QObject(parent),
 	  m_state(NotStarted),
-	  m_timer(new QTimer(this)),
+	  m_timer(new WheelTimer(this)),
 	  m_claimedResult(false),
 	  m_validateClaims(true),
 	  m_canPlayAfterTimeout(false),
@@ -32,7 +33,6 @@ ChessPlayer::ChessPlayer(QObject* parent)
 	  m_opponent(nullptr),
 	  m_rating(0)
 {
-	m_timer->setSingleShot(true);
 	connect(m_timer, SIGNAL(timeout()), this, SLOT(onTimeout()));
 }
 
@@ -275,6 +275,12 @@ void ChessPlayer::forfeit(Chess::Result::Type type, const QString& description)
 	claimResult(Chess::Result(type, m_side.opposite(), description));
 }
 
+void ChessPlayer::markDataArrival()
+{
+	if (m_state == Thinking)
+		m_timeControl.markArrival();
+}
+
 void ChessPlayer::emitMove(const Chess::Move& move)
 {
 	if (m_state == Thinking)
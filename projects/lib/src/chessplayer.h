@@ -27,6 +27,7 @@
 #include "timecontrol.h"
 #include "moveevaluation.h"
 class QTimer;
+class WheelTimer;
 namespace Chess { class Board; }
 
 
@@ -216,6 +217,18 @@ class LIB_EXPORT ChessPlayer : public QObject
 		 */
 		void thinking(const MoveEvaluation& eval);
 
+		/*!
+		 * This signal is emitted when a multi-PV engine completes
+		 * a search iteration.
+		 *
+		 * \a pvs holds one evaluation per PV line, ordered by PV
+		 * number and all from the same iteration, so consumers
+		 * get a coherent snapshot of the whole search instead of
+		 * one update per line. Single-PV engines only emit
+		 * thinking().
+		 */
+		void multiPvThinking(const QVector<MoveEvaluation>& pvs);
+
 		/*! Signals the player's move. */
 		void moveMade(const Chess::Move& move);
 		
@@ -282,7 +295,20 @@ class LIB_EXPORT ChessPlayer : public QObject
 		 * move came too late.
 		 */
 		void emitMove(const Chess::Move& move);
-		
+
+		/*!
+		 * Marks the current time as the arrival time of the
+		 * player's input data.
+		 *
+		 * If the player is thinking, the clock uses this
+		 * timestamp for the move time, so the time spent
+		 * processing the input doesn't count against the
+		 * player. Subclasses that read moves from an
+		 * asynchronous device should call this as soon as
+		 * new data arrives.
+		 */
+		void markDataArrival();
+
 		/*! Returns the opposing player. */
 		const ChessPlayer* opponent() const;
 
@@ -308,7 +334,7 @@ class LIB_EXPORT ChessPlayer : public QObject
 		QString m_error;
 		State m_state;
 		TimeControl m_timeControl;
-		QTimer* m_timer;
+		WheelTimer* m_timer;
 		bool m_claimedResult;
 		bool m_validateClaims;
 		bool m_canPlayAfterTimeout;
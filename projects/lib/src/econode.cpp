@@ -17,8 +17,10 @@
 */
 
 #include "econode.h"
+#include <algorithm>
 #include <QFile>
 #include <QDataStream>
+#include <QMap>
 #include <QMutex>
 #include "pgnstream.h"
 
@@ -59,16 +61,17 @@ QDataStream& operator>>(QDataStream& in, EcoNode& node)
 }
 
 QStringList EcoNode::s_openings;
-QMap<quint64, EcoNode> EcoNode::s_catalog;
+QVector<quint64> EcoNode::s_keys;
+QVector<EcoNode> EcoNode::s_nodes;
 
 void EcoNode::initialize()
 {
 	static QMutex mutex;
-	if (!s_catalog.isEmpty())
+	if (!s_keys.isEmpty())
 		return;
 
 	mutex.lock();
-	if (s_catalog.isEmpty())
+	if (s_keys.isEmpty())
 	{
 		Q_INIT_RESOURCE(eco);
 
@@ -79,7 +82,33 @@ void EcoNode::initialize()
 		{
 			QDataStream in(&file);
 			in.setVersion(QDataStream::Qt_4_6);
-			in >> s_openings >> s_catalog;
+			in >> s_openings;
+
+			// The catalog was serialized as a QMap, ie. a
+			// count followed by key/node pairs in descending
+			// key order. Read the pairs straight into the
+			// flat arrays instead of rebuilding the map.
+			quint32 count = 0;
+			in >> count;
+			s_keys.reserve(count);
+			s_nodes.reserve(count);
+			for (quint32 i = 0; i < count; i++)
+			{
+				quint64 key;
+				EcoNode node;
+				in >> key >> node;
+				if (in.status() != QDataStream::Ok)
+				{
+					qWarning("Corrupt ECO file");
+					s_keys.clear();
+					s_nodes.clear();
+					break;
+				}
+				s_keys.append(key);
+				s_nodes.append(node);
+			}
+			std::reverse(s_keys.begin(), s_keys.end());
+			std::reverse(s_nodes.begin(), s_nodes.end());
 		}
 	}
 	mutex.unlock();
@@ -87,7 +116,7 @@ void EcoNode::initialize()
 
 void EcoNode::initialize(PgnStream& in)
 {
-	if (!s_catalog.isEmpty())
+	if (!s_keys.isEmpty())
 		return;
 
 	if (!in.isOpen())
@@ -97,6 +126,7 @@ void EcoNode::initialize(PgnStream& in)
 	}
 
 	QMap<QString, int> tmpOpenings;
+	QMap<quint64, EcoNode> catalog;
 
 	PgnGame game;
 	while (game.read(in, INT_MAX - 1, false))
@@ -113,25 +143,39 @@ void EcoNode::initialize(PgnStream& in)
 					tmpOpenings[openingStr] = opening;
 					s_openings.append(openingStr);
 				}
-				s_catalog[game.key()] = EcoNode(opening,
-												game.tagValue("Variation"),
-												game.tagValue("ECO"));
+				catalog[game.key()] = EcoNode(opening,
+											  game.tagValue("Variation"),
+											  game.tagValue("ECO"));
 			}
 		}
 	}
+
+	// Flatten the catalog into arrays sorted by key
+	s_keys.reserve(catalog.size());
+	s_nodes.reserve(catalog.size());
+	for (auto it = catalog.constBegin(); it != catalog.constEnd(); ++it)
+	{
+		s_keys.append(it.key());
+		s_nodes.append(it.value());
+	}
 }
 
 const EcoNode* EcoNode::find(quint64 key)
 {
-	if (s_catalog.isEmpty())
+	if (s_keys.isEmpty())
 		initialize();
 
-	return s_catalog.contains(key) ? &s_catalog[key] : nullptr;
+	const auto it = std::lower_bound(s_keys.constBegin(),
+					 s_keys.constEnd(),
+					 key);
+	if (it == s_keys.constEnd() || *it != key)
+		return nullptr;
+	return &s_nodes.at(int(it - s_keys.constBegin()));
 }
 
 void EcoNode::write(const QString& fileName)
 {
-	if (s_catalog.isEmpty())
+	if (s_keys.isEmpty())
 		return;
 
 	QFile file(fileName);
@@ -143,7 +187,13 @@ void EcoNode::write(const QString& fileName)
 
 	QDataStream out(&file);
 	out.setVersion(QDataStream::Qt_4_6);
-	out << s_openings << s_catalog;
+	out << s_openings;
+
+	// Keep the file format compatible with the old QMap
+	// serialization: pairs are stored in descending key order.
+	out << quint32(s_keys.size());
+	for (int i = s_keys.size() - 1; i >= 0; i--)
+		out << s_keys.at(i) << s_nodes.at(i);
 }
 
 EcoNode::EcoNode()
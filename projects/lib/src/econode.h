@@ -20,7 +20,7 @@
 #define ECONODE_H
 
 #include <QStringList>
-#include <QMap>
+#include <QVector>
 #include "pgngame.h"
 class QDataStream;
 class PgnStream;
@@ -28,8 +28,10 @@ class PgnStream;
 /*!
  * \brief A node in the ECO catalog (Encyclopaedia of Chess Openings)
  *
- * The EcoNode class can be used to generate and query a database (a map) of
- * known chess openings that belong to the Encyclopaedia of Chess Openings.
+ * The EcoNode class can be used to generate and query a database of known
+ * chess openings that belong to the Encyclopaedia of Chess Openings. The
+ * catalog is kept as a flat array of nodes sorted by Zobrist key, so lookups
+ * are a binary search over a contiguous key array.
  * More about ECO: http://en.wikipedia.org/wiki/Encyclopaedia_of_Chess_Openings
  *
  * The ECO catalog can be generated from a PGN collection or from a binary file
@@ -74,7 +76,8 @@ class LIB_EXPORT EcoNode
 		EcoNode(int opening, const QString& variation, const QString& eco);
 
 		static QStringList s_openings;
-		static QMap<quint64, EcoNode> s_catalog;
+		static QVector<quint64> s_keys;
+		static QVector<EcoNode> s_nodes;
 
 		qint16 m_ecoCode;
 		qint32 m_opening;
@@ -18,10 +18,115 @@
 
 #include "enginebuilder.h"
 #include <QDir>
+#include <QSharedPointer>
 #include "engineprocess.h"
+#include "enginesocket.h"
 #include "enginefactory.h"
+#include "engineoption.h"
+#include "metrics.h"
+#include "tracer.h"
 #include "board/boardfactory.h"
+#ifdef Q_OS_LINUX
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
+#ifdef Q_OS_LINUX
+/*!
+ * Parses a comma-separated list of CPU numbers and ranges
+ * (e.g. "0-7,16-23") into \a cpuSet.
+ *
+ * Returns true if \a cpuList is valid; otherwise returns false.
+ */
+static bool parseCpuList(const QString& cpuList, cpu_set_t* cpuSet)
+{
+	CPU_ZERO(cpuSet);
+
+	const QStringList parts = cpuList.split(',', QString::SkipEmptyParts);
+	if (parts.isEmpty())
+		return false;
+
+	for (const QString& part : parts)
+	{
+		bool ok = true;
+		int first = 0;
+		int last = 0;
+
+		int dash = part.indexOf('-');
+		if (dash < 0)
+			first = last = part.toInt(&ok);
+		else
+		{
+			first = part.left(dash).toInt(&ok);
+			if (ok)
+				last = part.mid(dash + 1).toInt(&ok);
+		}
+		if (!ok || first < 0 || last < first || last >= CPU_SETSIZE)
+			return false;
+
+		for (int i = first; i <= last; i++)
+			CPU_SET(i, cpuSet);
+	}
+
+	return true;
+}
+
+/*!
+ * Parses an I/O scheduling class string ("idle" or "be0" to "be7")
+ * into the \a ioprio value expected by ioprio_set(2).
+ *
+ * Returns true if \a ioClass is valid; otherwise returns false.
+ */
+static bool parseIoClass(const QString& ioClass, int* ioprio)
+{
+	const int classShift = 13;	// IOPRIO_CLASS_SHIFT
+
+	if (ioClass == "idle")
+	{
+		*ioprio = 3 << classShift;	// IOPRIO_CLASS_IDLE
+		return true;
+	}
+	if (ioClass.startsWith("be") && ioClass.size() == 3)
+	{
+		bool ok = false;
+		int level = ioClass.midRef(2).toInt(&ok);
+		if (ok && level >= 0 && level <= 7)
+		{
+			// IOPRIO_CLASS_BE
+			*ioprio = (2 << classShift) | level;
+			return true;
+		}
+	}
+
+	return false;
+}
+#endif
+
+
+/*!
+ * Returns the number of CPU cores \a config makes the engine use,
+ * read from the "Threads" (UCI) or "cores" (Xboard) option. Engines
+ * without such an option are assumed to search on one core.
+ */
+static int configCpuCoreCount(const EngineConfiguration& config)
+{
+	const auto options = config.options();
+	for (const EngineOption* option : options)
+	{
+		if (option->name().compare("Threads", Qt::CaseInsensitive) != 0
+		&&  option->name().compare("cores", Qt::CaseInsensitive) != 0)
+			continue;
+
+		bool ok = false;
+		int count = option->value().toInt(&ok);
+		if (ok && count > 0)
+			return count;
+	}
+
+	return 1;
+}
 
 EngineBuilder::EngineBuilder(const EngineConfiguration& config)
 	: PlayerBuilder(config.name()),
@@ -30,6 +135,7 @@ EngineBuilder::EngineBuilder(const EngineConfiguration& config)
 	setRating(config.rating());
 	setStrikes(config.strikes());
 	setResumeScore(config.resumescore());
+	setCpuCoreCount(configCpuCoreCount(config));
 }
 
 void EngineBuilder::setConfiguration(const EngineConfiguration& config)
@@ -38,6 +144,7 @@ void EngineBuilder::setConfiguration(const EngineConfiguration& config)
 	setRating(config.rating());
 	setStrikes(config.strikes());
 	setResumeScore(config.resumescore());
+	setCpuCoreCount(configCpuCoreCount(config));
 }
 
 bool EngineBuilder::isHuman() const
@@ -50,6 +157,8 @@ ChessPlayer* EngineBuilder::create(QObject* receiver,
 				   QObject* parent,
 				   QString* error) const
 {
+	TraceSpan span("engine.create");
+
 	QString workDir = m_config.workingDirectory();
 	QString cmd = m_config.command().trimmed();
 	QString stderrFile = m_config.stderrFile();
@@ -67,6 +176,9 @@ ChessPlayer* EngineBuilder::create(QObject* receiver,
 		return nullptr;
 	}
 
+	if (m_config.isRemote())
+		return createRemote(receiver, method, parent, error);
+
 	EngineProcess* process = new EngineProcess();
 
 	if (workDir.isEmpty())
@@ -82,12 +194,45 @@ ChessPlayer* EngineBuilder::create(QObject* receiver,
 
 	if (!stderrFile.isEmpty())
 		process->setStandardErrorFile(stderrFile, QIODevice::Append);
+#ifndef Q_OS_WIN32
+	else
+	{
+		// Nothing else ever reads the stderr channel, so a verbosely
+		// logging engine would make EngineProcess buffer it without
+		// bound. Drain and discard it as it arrives, keeping only a
+		// small tail for the crash report. On Windows EngineProcess
+		// gives the child no stderr pipe at all.
+		const QString engineName = name();
+		auto tail = QSharedPointer<QByteArray>::create();
+
+		QObject::connect(process, &EngineProcess::readyReadStandardError,
+				 process, [process, tail]()
+		{
+			const int maxTailSize = 8192;
+
+			tail->append(process->readAllStandardError());
+			if (tail->size() > maxTailSize)
+				*tail = tail->right(maxTailSize);
+		});
+		QObject::connect(process, &EngineProcess::finished,
+				 process,
+				 [engineName, tail](int, EngineProcess::ExitStatus status)
+		{
+			if (status == EngineProcess::CrashExit && !tail->isEmpty())
+				qWarning("Last stderr output of engine %s:\n%s",
+					 qUtf8Printable(engineName),
+					 tail->constData());
+		});
+	}
+#endif
 
 	if (!m_config.arguments().isEmpty())
 		process->start(cmd, m_config.arguments());
 	else
 		process->start(cmd);
 
+	Metrics::add(Metrics::EngineStarts);
+
 	bool ok = process->waitForStarted();
 	if (!ok)
 	{
@@ -97,6 +242,63 @@ ChessPlayer* EngineBuilder::create(QObject* receiver,
 		return nullptr;
 	}
 
+	QString affinity = m_config.cpuAffinity();
+	if (!affinity.isEmpty())
+	{
+#ifdef Q_OS_LINUX
+		// Pinning the engine to a fixed set of CPUs keeps it from
+		// migrating between NUMA nodes; the kernel then allocates
+		// its memory on the node(s) the set belongs to.
+		cpu_set_t cpuSet;
+		if (!parseCpuList(affinity, &cpuSet))
+			qWarning("Invalid CPU affinity \"%s\" for engine %s",
+				 qUtf8Printable(affinity),
+				 qUtf8Printable(name()));
+		else if (sched_setaffinity(pid_t(process->processId()),
+					   sizeof(cpuSet), &cpuSet) != 0)
+			qWarning("Cannot set CPU affinity \"%s\" for engine %s",
+				 qUtf8Printable(affinity),
+				 qUtf8Printable(name()));
+#else
+		qWarning("CPU affinity is not supported on this platform");
+#endif
+	}
+
+	if (m_config.niceness() != 0)
+	{
+#ifdef Q_OS_LINUX
+		// A negative nice value lets the engine win the CPU
+		// over cutechess's own bookkeeping threads
+		if (setpriority(PRIO_PROCESS, id_t(process->processId()),
+				m_config.niceness()) != 0)
+			qWarning("Cannot set niceness %d for engine %s",
+				 m_config.niceness(),
+				 qUtf8Printable(name()));
+#else
+		qWarning("Process priority is not supported on this platform");
+#endif
+	}
+
+	const QString ioClass = m_config.ioPriority();
+	if (!ioClass.isEmpty())
+	{
+#ifdef Q_OS_LINUX
+		int ioprio = 0;
+		if (!parseIoClass(ioClass, &ioprio))
+			qWarning("Invalid I/O class \"%s\" for engine %s",
+				 qUtf8Printable(ioClass),
+				 qUtf8Printable(name()));
+		// 1 = IOPRIO_WHO_PROCESS
+		else if (syscall(SYS_ioprio_set, 1,
+				 pid_t(process->processId()), ioprio) != 0)
+			qWarning("Cannot set I/O class \"%s\" for engine %s",
+				 qUtf8Printable(ioClass),
+				 qUtf8Printable(name()));
+#else
+		qWarning("I/O priority is not supported on this platform");
+#endif
+	}
+
 	ChessEngine* engine = EngineFactory::create(m_config.protocol());
 	Q_ASSERT(engine != nullptr);
 
@@ -111,6 +313,52 @@ ChessPlayer* EngineBuilder::create(QObject* receiver,
 	return engine;
 }
 
+ChessPlayer* EngineBuilder::createRemote(QObject* receiver,
+					 const char* method,
+					 QObject* parent,
+					 QString* error) const
+{
+	const QString host = m_config.remoteHost();
+	quint16 port = m_config.remotePort();
+
+	if (host.isEmpty() || port == 0)
+	{
+		setError(error, tr("Invalid remote engine endpoint: %1")
+			 .arg(m_config.command()));
+		return nullptr;
+	}
+
+	EngineSocket* socket = new EngineSocket(host, port);
+	socket->start();
+
+	Metrics::add(Metrics::EngineStarts);
+
+	if (!socket->waitForStarted())
+	{
+		setError(error, tr("Cannot connect to engine at %1:%2")
+			 .arg(host).arg(port));
+		delete socket;
+		return nullptr;
+	}
+
+	qInfo("Connected to engine %s at %s:%u in %d ms",
+	      qUtf8Printable(name()), qUtf8Printable(host), uint(port),
+	      socket->latency());
+
+	ChessEngine* engine = EngineFactory::create(m_config.protocol());
+	Q_ASSERT(engine != nullptr);
+
+	engine->setParent(parent);
+	if (receiver != nullptr && method != nullptr)
+		QObject::connect(engine, SIGNAL(debugMessage(QString)),
+				 receiver, method);
+	engine->setDevice(socket);
+	engine->applyConfiguration(m_config);
+
+	engine->start();
+	return engine;
+}
+
 void EngineBuilder::setError(QString* error, const QString& message) const
 {
 	QChar sep = error ? '\n' : ' ';
@@ -44,6 +44,10 @@ class LIB_EXPORT EngineBuilder : public PlayerBuilder
 					    QString* error) const;
 
 	private:
+		ChessPlayer* createRemote(QObject* receiver,
+					  const char* method,
+					  QObject* parent,
+					  QString* error) const;
 		void setError(QString* error, const QString& message) const;
 
 		EngineConfiguration m_config;
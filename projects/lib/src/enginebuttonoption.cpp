@@ -19,7 +19,7 @@
 #include "enginebuttonoption.h"
 
 EngineButtonOption::EngineButtonOption(const QString& name)
-	: EngineOption(name, QVariant::Invalid)
+	: EngineOption(name, EngineOptionValue::Null)
 {
 }
 
@@ -28,7 +28,7 @@ EngineOption* EngineButtonOption::copy() const
 	return new EngineButtonOption(*this);
 }
 
-bool EngineButtonOption::isValid(const QVariant& value) const
+bool EngineButtonOption::isValid(const EngineOptionValue& value) const
 {
 	return value.isNull();
 }
@@ -19,10 +19,10 @@
 #include "enginecheckoption.h"
 
 EngineCheckOption::EngineCheckOption(const QString& name,
-                                     const QVariant& value,
-                                     const QVariant& defaultValue,
+                                     const EngineOptionValue& value,
+                                     const EngineOptionValue& defaultValue,
                                      const QString& alias)
-	: EngineOption(name, QVariant::Bool, value, defaultValue, alias)
+	: EngineOption(name, EngineOptionValue::Bool, value, defaultValue, alias)
 {
 }
 
@@ -31,9 +31,11 @@ EngineOption* EngineCheckOption::copy() const
 	return new EngineCheckOption(*this);
 }
 
-bool EngineCheckOption::isValid(const QVariant& value) const
+bool EngineCheckOption::isValid(const EngineOptionValue& value) const
 {
-	if (value.canConvert(QVariant::Bool))
+	if (value.type() == EngineOptionValue::Bool)
+		return true;
+	if (value.type() == EngineOptionValue::String)
 	{
 		QString str(value.toString());
 		return (str == "true" || str == "false");
@@ -48,8 +50,8 @@ QVariant EngineCheckOption::toVariant() const
 	map.insert("type", "check");
 
 	map.insert("name", name());
-	map.insert("value", value());
-	map.insert("default", defaultValue());
+	map.insert("value", value().toVariant());
+	map.insert("default", defaultValue().toVariant());
 	map.insert("alias", alias());
 
 	return map;
@@ -25,13 +25,13 @@ class LIB_EXPORT EngineCheckOption : public EngineOption
 {
 	public:
 		EngineCheckOption(const QString& name,
-		                  const QVariant& value = QVariant(),
-		                  const QVariant& defaultValue = QVariant(),
+		                  const EngineOptionValue& value = EngineOptionValue(),
+		                  const EngineOptionValue& defaultValue = EngineOptionValue(),
 		                  const QString& alias = QString());
 
 		// Inherited from EngineOption
 		virtual EngineOption* copy() const;
-		virtual bool isValid(const QVariant& value) const;
+		virtual bool isValid(const EngineOptionValue& value) const;
 		virtual QVariant toVariant() const;
 };
 
@@ -19,11 +19,11 @@
 #include "enginecombooption.h"
 
 EngineComboOption::EngineComboOption(const QString& name,
-                                     const QVariant& value,
-                                     const QVariant& defaultValue,
+                                     const EngineOptionValue& value,
+                                     const EngineOptionValue& defaultValue,
                                      const QStringList& choices,
                                      const QString& alias)
-	: EngineOption(name, QVariant::String, value, defaultValue, alias),
+	: EngineOption(name, EngineOptionValue::String, value, defaultValue, alias),
 	  m_choices(choices)
 {
 }
@@ -33,7 +33,7 @@ EngineOption* EngineComboOption::copy() const
 	return new EngineComboOption(*this);
 }
 
-bool EngineComboOption::isValid(const QVariant& value) const
+bool EngineComboOption::isValid(const EngineOptionValue& value) const
 {
 	return m_choices.contains(value.toString());
 }
@@ -55,8 +55,8 @@ QVariant EngineComboOption::toVariant() const
 	map.insert("type", "combo");
 
 	map.insert("name", name());
-	map.insert("value", value());
-	map.insert("default", defaultValue());
+	map.insert("value", value().toVariant());
+	map.insert("default", defaultValue().toVariant());
 	map.insert("alias", alias());
 
 	map.insert("choices", choices());
@@ -26,14 +26,14 @@ class LIB_EXPORT EngineComboOption : public EngineOption
 {
 	public:
 		EngineComboOption(const QString& name,
-		                  const QVariant& value = QVariant(),
-		                  const QVariant& defaultValue = QVariant(),
+		                  const EngineOptionValue& value = EngineOptionValue(),
+		                  const EngineOptionValue& defaultValue = EngineOptionValue(),
 		                  const QStringList& choices = QStringList(),
 		                  const QString& alias = QString());
 
 		// Inherited from EngineOption
 		virtual EngineOption* copy() const;
-		virtual bool isValid(const QVariant& value) const;
+		virtual bool isValid(const EngineOptionValue& value) const;
 		virtual QVariant toVariant() const;
 
 		QStringList choices() const;
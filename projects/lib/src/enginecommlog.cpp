@@ -0,0 +1,235 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "enginecommlog.h"
+#include <cstring>
+#include <QDataStream>
+#include <QTextStream>
+#include <QtEndian>
+
+
+EngineCommLog::Channel::Channel(EngineCommLog* log, int engineId)
+	: m_log(log),
+	  m_engineId(engineId),
+	  m_head(0),
+	  m_tail(0),
+	  m_dropped(0),
+	  m_closed(0)
+{
+}
+
+void EngineCommLog::Channel::copyIn(int pos, const char* data, int size)
+{
+	int chunk = qMin(size, BufferSize - pos);
+	memcpy(m_buffer + pos, data, chunk);
+	if (chunk < size)
+		memcpy(m_buffer, data + chunk, size - chunk);
+}
+
+void EngineCommLog::Channel::copyOut(int pos, char* data, int size) const
+{
+	int chunk = qMin(size, BufferSize - pos);
+	memcpy(data, m_buffer + pos, chunk);
+	if (chunk < size)
+		memcpy(data + chunk, m_buffer, size - chunk);
+}
+
+void EngineCommLog::Channel::record(Direction direction,
+				    const char* data,
+				    int size)
+{
+	if (size <= 0 || m_closed.loadAcquire())
+		return;
+
+	// Single-producer side: only the engine's thread writes m_head
+	int head = m_head.loadAcquire();
+	int tail = m_tail.loadAcquire();
+	int needed = HeaderSize + size;
+	int free = (tail - head - 1) & Mask;
+	if (needed > free)
+	{
+		m_dropped.ref();
+		return;
+	}
+
+	uchar header[HeaderSize];
+	qToBigEndian<qint64>(m_log->m_timer.nsecsElapsed(), header);
+	header[8] = quint8(direction);
+	qToBigEndian<quint32>(quint32(size), header + 9);
+
+	copyIn(head, reinterpret_cast<const char*>(header), HeaderSize);
+	copyIn((head + HeaderSize) & Mask, data, size);
+
+	// Publish the record to the writer thread
+	m_head.storeRelease((head + needed) & Mask);
+}
+
+
+EngineCommLog::EngineCommLog(const QString& fileName, QObject* parent)
+	: QThread(parent),
+	  m_file(fileName),
+	  m_quit(0)
+{
+}
+
+EngineCommLog::~EngineCommLog()
+{
+	if (isRunning())
+	{
+		m_quit.storeRelease(1);
+		wait();
+	}
+	qDeleteAll(m_channels);
+}
+
+bool EngineCommLog::open()
+{
+	if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+		return false;
+
+	QDataStream out(&m_file);
+	out << Magic << Version;
+
+	m_timer.start();
+	start();
+	return true;
+}
+
+EngineCommLog::Channel* EngineCommLog::createChannel(int engineId)
+{
+	Channel* channel = new Channel(this, engineId);
+
+	QMutexLocker locker(&m_mutex);
+	m_channels.append(channel);
+	return channel;
+}
+
+void EngineCommLog::releaseChannel(Channel* channel)
+{
+	Q_ASSERT(channel != nullptr);
+
+	// The writer thread drains and deletes the channel
+	channel->m_closed.storeRelease(1);
+}
+
+void EngineCommLog::drain(Channel* channel, QDataStream& out)
+{
+	// Single-consumer side: only the writer thread writes m_tail
+	int head = channel->m_head.loadAcquire();
+	int tail = channel->m_tail.loadAcquire();
+
+	while (tail != head)
+	{
+		uchar header[Channel::HeaderSize];
+		channel->copyOut(tail,
+				 reinterpret_cast<char*>(header),
+				 Channel::HeaderSize);
+		qint64 timestamp = qFromBigEndian<qint64>(header);
+		quint8 direction = header[8];
+		int size = int(qFromBigEndian<quint32>(header + 9));
+
+		QByteArray data(size, Qt::Uninitialized);
+		channel->copyOut((tail + Channel::HeaderSize) & Channel::Mask,
+				 data.data(), size);
+		tail = (tail + Channel::HeaderSize + size) & Channel::Mask;
+
+		out << timestamp << qint32(channel->m_engineId)
+		    << direction << data;
+	}
+
+	channel->m_tail.storeRelease(tail);
+}
+
+void EngineCommLog::drainAll(QDataStream& out)
+{
+	QMutexLocker locker(&m_mutex);
+
+	QList<Channel*>::iterator it = m_channels.begin();
+	while (it != m_channels.end())
+	{
+		Channel* channel = *it;
+		drain(channel, out);
+
+		if (channel->m_closed.loadAcquire()
+		&&  channel->m_tail.loadAcquire() == channel->m_head.loadAcquire())
+		{
+			int dropped = channel->m_dropped.loadAcquire();
+			if (dropped > 0)
+				qWarning("Engine log dropped %d records "
+					 "for engine %d",
+					 dropped, channel->m_engineId);
+			delete channel;
+			it = m_channels.erase(it);
+		}
+		else
+			++it;
+	}
+}
+
+void EngineCommLog::run()
+{
+	QDataStream out(&m_file);
+
+	while (!m_quit.loadAcquire())
+	{
+		drainAll(out);
+		msleep(FlushInterval);
+	}
+
+	// Flush whatever the engines wrote before the log was stopped
+	drainAll(out);
+	m_file.close();
+}
+
+bool EngineCommLog::writeAsText(const QString& fileName, QTextStream& out)
+{
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly))
+		return false;
+
+	QDataStream in(&file);
+	quint32 magic = 0;
+	quint8 version = 0;
+	in >> magic >> version;
+	if (magic != Magic || version != Version)
+		return false;
+
+	while (!in.atEnd())
+	{
+		qint64 timestamp;
+		qint32 engineId;
+		quint8 direction;
+		QByteArray data;
+		in >> timestamp >> engineId >> direction >> data;
+		if (in.status() != QDataStream::Ok)
+			return false;
+
+		QChar dir = (direction == quint8(ToEngine)) ? '>' : '<';
+		const QList<QByteArray> lines = data.split('\n');
+		for (const QByteArray& line : lines)
+		{
+			if (line.isEmpty())
+				continue;
+			out << QString::number(timestamp / 1E9, 'f', 6)
+			    << ' ' << dir << engineId << ": "
+			    << QString::fromUtf8(line).trimmed() << '\n';
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,166 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ENGINECOMMLOG_H
+#define ENGINECOMMLOG_H
+
+#include <QThread>
+#include <QList>
+#include <QMutex>
+#include <QFile>
+#include <QAtomicInt>
+#include <QElapsedTimer>
+class QTextStream;
+class QDataStream;
+
+
+/*!
+ * \brief A low-overhead binary log of engine communication.
+ *
+ * EngineCommLog records timestamped raw bytes sent to and received
+ * from chess engines into a compact binary file. Each engine writes
+ * into its own lock-free ring buffer, so logging adds only a memcpy
+ * and two atomic operations to the communication path; a dedicated
+ * writer thread drains the buffers to disk in the background. This
+ * makes the log cheap enough to leave enabled while measuring move
+ * times, unlike the debugMessage() text output.
+ *
+ * If an engine produces data faster than the writer thread can drain
+ * it, excess records are dropped (and counted) instead of blocking
+ * the engine's thread.
+ *
+ * The binary file can be converted to text with writeAsText().
+ *
+ * \sa ChessEngine
+ */
+class LIB_EXPORT EngineCommLog : public QThread
+{
+	Q_OBJECT
+
+	public:
+		/*! The magic number at the start of a log file. */
+		static const quint32 Magic = 0x43434C47; // "CCLG"
+		/*! The current log file format version. */
+		static const quint8 Version = 1;
+
+		/*! The direction of a logged message. */
+		enum Direction
+		{
+			ToEngine,	//!< Data written to the engine
+			FromEngine	//!< Data read from the engine
+		};
+
+		/*!
+		 * \brief A single engine's lock-free ring buffer.
+		 *
+		 * A channel has exactly one producer (the engine's
+		 * thread) and one consumer (the log's writer thread).
+		 */
+		class LIB_EXPORT Channel
+		{
+			friend class EngineCommLog;
+
+			public:
+				/*!
+				 * Records \a size bytes from \a data going
+				 * in \a direction.
+				 *
+				 * This function never blocks. If the ring
+				 * buffer is full the record is dropped.
+				 */
+				void record(Direction direction,
+					    const char* data,
+					    int size);
+
+			private:
+				Channel(EngineCommLog* log, int engineId);
+
+				static const int BufferSize = 1 << 16;
+				static const int Mask = BufferSize - 1;
+				static const int HeaderSize = 13;
+
+				void copyIn(int pos, const char* data, int size);
+				void copyOut(int pos, char* data, int size) const;
+
+				EngineCommLog* m_log;
+				int m_engineId;
+				QAtomicInt m_head;
+				QAtomicInt m_tail;
+				QAtomicInt m_dropped;
+				QAtomicInt m_closed;
+				char m_buffer[BufferSize];
+		};
+
+		/*!
+		 * Creates a new engine communication log that writes
+		 * to the file \a fileName.
+		 */
+		explicit EngineCommLog(const QString& fileName,
+				       QObject* parent = nullptr);
+		/*!
+		 * Flushes any remaining data, stops the writer thread
+		 * and deletes all channels.
+		 */
+		virtual ~EngineCommLog();
+
+		/*!
+		 * Opens the log file and starts the writer thread.
+		 * Returns true if successful; otherwise returns false.
+		 */
+		bool open();
+
+		/*!
+		 * Creates and returns a new channel for the engine with
+		 * the id \a engineId.
+		 *
+		 * The channel is owned by the log. Release it with
+		 * releaseChannel() when the engine is destroyed.
+		 */
+		Channel* createChannel(int engineId);
+		/*!
+		 * Releases \a channel. The writer thread drains and
+		 * deletes it; the caller must not use it afterwards.
+		 */
+		void releaseChannel(Channel* channel);
+
+		/*!
+		 * Converts the binary log file \a fileName to text on
+		 * \a out, one line of engine communication per line.
+		 * Returns true if successful; otherwise returns false.
+		 */
+		static bool writeAsText(const QString& fileName,
+					QTextStream& out);
+
+	protected:
+		// Inherited from QThread
+		virtual void run();
+
+	private:
+		static const unsigned long FlushInterval = 100; // ms
+
+		void drain(Channel* channel, QDataStream& out);
+		void drainAll(QDataStream& out);
+
+		QFile m_file;
+		QElapsedTimer m_timer;
+		QAtomicInt m_quit;
+		QMutex m_mutex;
+		QList<Channel*> m_channels;
+};
+
+#endif // ENGINECOMMLOG_H
@@ -0,0 +1,189 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "enginecommreplay.h"
+#include "enginecommlog.h"
+#include <QFile>
+#include <QDataStream>
+#include <QTimer>
+
+
+EngineCommReplay::EngineCommReplay(QObject* parent)
+	: QIODevice(parent),
+	  m_index(0),
+	  m_bytes(0),
+	  m_speed(0.0),
+	  m_uci(false),
+	  m_timer(new QTimer(this))
+{
+	m_timer->setSingleShot(true);
+	connect(m_timer, SIGNAL(timeout()), this, SLOT(onTimeout()));
+}
+
+bool EngineCommReplay::load(const QString& fileName, int engineId)
+{
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly))
+		return false;
+
+	QDataStream in(&file);
+	quint32 magic = 0;
+	quint8 version = 0;
+	in >> magic >> version;
+	if (magic != EngineCommLog::Magic
+	||  version != EngineCommLog::Version)
+		return false;
+
+	m_records.clear();
+	m_buffer.clear();
+	m_index = 0;
+	m_bytes = 0;
+	m_uci = false;
+
+	while (!in.atEnd())
+	{
+		qint64 timestamp;
+		qint32 id;
+		quint8 direction;
+		QByteArray data;
+		in >> timestamp >> id >> direction >> data;
+		if (in.status() != QDataStream::Ok)
+			return false;
+
+		if (direction != quint8(EngineCommLog::FromEngine))
+			continue;
+		if (engineId == -1)
+			engineId = id;
+		else if (id != engineId)
+			continue;
+
+		if (!m_uci && data.contains("uciok"))
+			m_uci = true;
+
+		Record record = { timestamp, data };
+		m_records.append(record);
+		m_bytes += data.size();
+	}
+
+	if (m_records.isEmpty())
+		return false;
+
+	return open(QIODevice::ReadWrite);
+}
+
+void EngineCommReplay::setSpeed(qreal factor)
+{
+	m_speed = qMax(factor, 0.0);
+}
+
+int EngineCommReplay::recordCount() const
+{
+	return m_records.size();
+}
+
+qint64 EngineCommReplay::byteCount() const
+{
+	return m_bytes;
+}
+
+bool EngineCommReplay::isUci() const
+{
+	return m_uci;
+}
+
+bool EngineCommReplay::isSequential() const
+{
+	return true;
+}
+
+qint64 EngineCommReplay::bytesAvailable() const
+{
+	return m_buffer.size() + QIODevice::bytesAvailable();
+}
+
+void EngineCommReplay::start()
+{
+	m_index = 0;
+	m_buffer.clear();
+
+	if (m_speed <= 0.0)
+	{
+		// Benchmark mode: everything at once
+		for (const Record& record : qAsConst(m_records))
+			m_buffer.append(record.data);
+		m_index = m_records.size();
+		emit readyRead();
+		return;
+	}
+
+	m_clock.start();
+	scheduleNext();
+}
+
+void EngineCommReplay::scheduleNext()
+{
+	if (m_index >= m_records.size())
+		return;
+
+	const qint64 base = m_records.first().timestamp;
+	const qint64 offset = m_records.at(m_index).timestamp - base;
+	qint64 due = qint64(offset / 1000000 / m_speed);
+	m_timer->start(int(qMax(due - m_clock.elapsed(), qint64(0))));
+}
+
+void EngineCommReplay::onTimeout()
+{
+	// Deliver every record that's due by now in one batch
+	const qint64 base = m_records.first().timestamp;
+	bool delivered = false;
+	while (m_index < m_records.size())
+	{
+		const Record& record = m_records.at(m_index);
+		qint64 due = qint64((record.timestamp - base)
+				    / 1000000 / m_speed);
+		if (due > m_clock.elapsed())
+			break;
+
+		m_buffer.append(record.data);
+		m_index++;
+		delivered = true;
+	}
+
+	if (delivered)
+		emit readyRead();
+	scheduleNext();
+}
+
+qint64 EngineCommReplay::readData(char* data, qint64 maxSize)
+{
+	int n = qMin(int(maxSize), m_buffer.size());
+	if (n <= 0)
+		return 0;
+
+	memcpy(data, m_buffer.constData(), size_t(n));
+	m_buffer.remove(0, n);
+	return n;
+}
+
+qint64 EngineCommReplay::writeData(const char* data, qint64 maxSize)
+{
+	// The recorded engine can't listen; GUI-to-engine data is
+	// dropped
+	Q_UNUSED(data);
+	return maxSize;
+}
@@ -0,0 +1,124 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ENGINECOMMREPLAY_H
+#define ENGINECOMMREPLAY_H
+
+#include <QIODevice>
+#include <QList>
+#include <QByteArray>
+#include <QElapsedTimer>
+class QTimer;
+
+
+/*!
+ * \brief Replays a recorded engine session from an EngineCommLog file.
+ *
+ * EngineCommReplay is a QIODevice that takes the place of the engine
+ * process: set it as a ChessEngine's device and it feeds the bytes a
+ * real engine sent during a recorded session back into the protocol
+ * parser. Data written to the device is discarded.
+ *
+ * The replay speed is configurable: at the default speed of 0 every
+ * record is made available immediately, which turns a recorded
+ * session into a deterministic parsing benchmark; a positive speed
+ * factor reproduces the recorded timing (1.0 = real time), which is
+ * useful for replaying a production incident's exact byte stream.
+ *
+ * \sa EngineCommLog
+ */
+class LIB_EXPORT EngineCommReplay : public QIODevice
+{
+	Q_OBJECT
+
+	public:
+		/*! Creates a new EngineCommReplay. */
+		explicit EngineCommReplay(QObject* parent = nullptr);
+
+		/*!
+		 * Loads the engine-to-GUI records of the engine with
+		 * the id \a engineId from the log file \a fileName.
+		 *
+		 * If \a engineId is -1 (the default), the first engine
+		 * found in the log is used.
+		 *
+		 * Returns true if at least one record was loaded;
+		 * otherwise returns false.
+		 */
+		bool load(const QString& fileName, int engineId = -1);
+
+		/*!
+		 * Sets the replay speed to \a factor times the
+		 * recorded speed. A factor of 0 (the default) makes
+		 * all records available immediately.
+		 */
+		void setSpeed(qreal factor);
+
+		/*! Returns the number of loaded records. */
+		int recordCount() const;
+		/*! Returns the total number of loaded payload bytes. */
+		qint64 byteCount() const;
+		/*!
+		 * Returns true if the recorded engine spoke the UCI
+		 * protocol (a "uciok" line was recorded); otherwise
+		 * returns false.
+		 */
+		bool isUci() const;
+
+		// Inherited from QIODevice
+		virtual bool isSequential() const;
+		virtual qint64 bytesAvailable() const;
+
+	public slots:
+		/*!
+		 * Starts the replay.
+		 *
+		 * At speed 0 all records become available at once and
+		 * readyRead() is emitted once, before this function
+		 * returns.
+		 */
+		void start();
+
+	protected:
+		// Inherited from QIODevice
+		virtual qint64 readData(char* data, qint64 maxSize);
+		virtual qint64 writeData(const char* data, qint64 maxSize);
+
+	private slots:
+		void onTimeout();
+
+	private:
+		struct Record
+		{
+			qint64 timestamp;
+			QByteArray data;
+		};
+
+		void scheduleNext();
+
+		QList<Record> m_records;
+		QByteArray m_buffer;
+		int m_index;
+		qint64 m_bytes;
+		qreal m_speed;
+		bool m_uci;
+		QTimer* m_timer;
+		QElapsedTimer m_clock;
+};
+
+#endif // ENGINECOMMREPLAY_H
@@ -28,6 +28,7 @@ EngineConfiguration::EngineConfiguration()
 	  m_pondering(false),
 	  m_validateClaims(true),
 	  m_restartMode(RestartAuto),
+	  m_niceness(0),
 	  m_rating(0),
 	  m_restart_score(0),
 	  m_strikes(0)
@@ -45,6 +46,7 @@ EngineConfiguration::EngineConfiguration(const QString& name,
 	  m_pondering(false),
 	  m_validateClaims(true),
 	  m_restartMode(RestartAuto),
+	  m_niceness(0),
 	  m_rating(0),
 	  m_restart_score(0),
 	  m_strikes(0)
@@ -57,6 +59,7 @@ EngineConfiguration::EngineConfiguration(const QVariant& variant)
 	  m_pondering(false),
 	  m_validateClaims(true),
 	  m_restartMode(RestartAuto),
+	  m_niceness(0),
 	  m_rating(0),
 	  m_restart_score(0),
 	  m_strikes(0)
@@ -67,6 +70,9 @@ EngineConfiguration::EngineConfiguration(const QVariant& variant)
 	setCommand(map["command"].toString());
 	setWorkingDirectory(map["workingDirectory"].toString());
 	setStderrFile(map["stderrFile"].toString());
+	setCpuAffinity(map["cpuAffinity"].toString());
+	setNiceness(map["niceness"].toInt());
+	setIoPriority(map["ioPriority"].toString());
 	setProtocol(map["protocol"].toString());
 
 	if (map.contains("initStrings"))
@@ -117,6 +123,9 @@ EngineConfiguration::EngineConfiguration(const EngineConfiguration& other)
 	  m_command(other.m_command),
 	  m_workingDirectory(other.m_workingDirectory),
 	  m_stderrFile(other.m_stderrFile),
+	  m_cpuAffinity(other.m_cpuAffinity),
+	  m_niceness(other.m_niceness),
+	  m_ioPriority(other.m_ioPriority),
 	  m_protocol(other.m_protocol),
 	  m_arguments(other.m_arguments),
 	  m_initStrings(other.m_initStrings),
@@ -145,6 +154,9 @@ EngineConfiguration& EngineConfiguration::operator=(EngineConfiguration&& other)
 	m_command = other.m_command;
 	m_workingDirectory = other.m_workingDirectory;
 	m_stderrFile = other.m_stderrFile;
+	m_cpuAffinity = other.m_cpuAffinity;
+	m_niceness = other.m_niceness;
+	m_ioPriority = other.m_ioPriority;
 	m_protocol = other.m_protocol;
 	m_arguments = other.m_arguments;
 	m_initStrings = other.m_initStrings;
@@ -177,6 +189,14 @@ QVariant EngineConfiguration::toVariant() const
 	map.insert("stderrFile", m_stderrFile);
 	map.insert("protocol", m_protocol);
 
+	if (!m_cpuAffinity.isEmpty())
+		map.insert("cpuAffinity", m_cpuAffinity);
+
+	if (m_niceness != 0)
+		map.insert("niceness", m_niceness);
+	if (!m_ioPriority.isEmpty())
+		map.insert("ioPriority", m_ioPriority);
+
 	if (!m_initStrings.isEmpty())
 		map.insert("initStrings", m_initStrings);
 	if (m_whiteEvalPov)
@@ -238,6 +258,21 @@ void EngineConfiguration::setStderrFile(const QString& fileName)
 	m_stderrFile = fileName;
 }
 
+void EngineConfiguration::setCpuAffinity(const QString& cpuList)
+{
+	m_cpuAffinity = cpuList;
+}
+
+void EngineConfiguration::setNiceness(int niceness)
+{
+	m_niceness = qBound(-20, niceness, 19);
+}
+
+void EngineConfiguration::setIoPriority(const QString& ioClass)
+{
+	m_ioPriority = ioClass;
+}
+
 void EngineConfiguration::setRating(const int rating)
 {
 	m_rating = rating > 0 ? rating : 0;
@@ -263,6 +298,33 @@ QString EngineConfiguration::command() const
 	return m_command;
 }
 
+bool EngineConfiguration::isRemote() const
+{
+	return m_command.startsWith("tcp://");
+}
+
+QString EngineConfiguration::remoteHost() const
+{
+	// The scheme prefix is 6 characters; the port starts after the
+	// last colon so that IPv6 addresses keep their colons
+	const QString endpoint = m_command.mid(6);
+	int i = endpoint.lastIndexOf(':');
+	if (i <= 0)
+		return QString();
+
+	return endpoint.left(i);
+}
+
+quint16 EngineConfiguration::remotePort() const
+{
+	const QString endpoint = m_command.mid(6);
+	int i = endpoint.lastIndexOf(':');
+	if (i <= 0)
+		return 0;
+
+	return endpoint.midRef(i + 1).toUShort();
+}
+
 QString EngineConfiguration::workingDirectory() const
 {
 	return m_workingDirectory;
@@ -273,6 +335,21 @@ QString EngineConfiguration::stderrFile() const
 	return m_stderrFile;
 }
 
+QString EngineConfiguration::cpuAffinity() const
+{
+	return m_cpuAffinity;
+}
+
+int EngineConfiguration::niceness() const
+{
+	return m_niceness;
+}
+
+QString EngineConfiguration::ioPriority() const
+{
+	return m_ioPriority;
+}
+
 QString EngineConfiguration::protocol() const
 {
 	return m_protocol;
@@ -358,24 +435,26 @@ void EngineConfiguration::addOption(EngineOption* option)
 
 void EngineConfiguration::setOption(const QString& name, const QVariant& value)
 {
+	const EngineOptionValue optionValue(EngineOptionValue::fromVariant(value));
+
 	for (EngineOption* option : qAsConst(m_options))
 	{
 		if (option->name() == name)
 		{
-			if (!option->isValid(value))
+			if (!option->isValid(optionValue))
 			{
 				qWarning("Invalid value for engine option %s: %s",
 					 qUtf8Printable(name),
-					 qUtf8Printable(value.toString()));
+					 qUtf8Printable(optionValue.toString()));
 			}
 			else
-				option->setValue(value);
+				option->setValue(optionValue);
 
 			return;
 		}
 	}
 
-	m_options << new EngineTextOption(name, value, value);
+	m_options << new EngineTextOption(name, optionValue, optionValue);
 }
 
 bool EngineConfiguration::whiteEvalPov() const
@@ -426,6 +505,9 @@ EngineConfiguration& EngineConfiguration::operator=(const EngineConfiguration& o
 		m_command = other.m_command;
 		m_workingDirectory = other.m_workingDirectory;
 		m_stderrFile = other.m_stderrFile;
+		m_cpuAffinity = other.m_cpuAffinity;
+		m_niceness = other.m_niceness;
+		m_ioPriority = other.m_ioPriority;
 		m_protocol = other.m_protocol;
 		m_arguments = other.m_arguments;
 		m_initStrings = other.m_initStrings;
@@ -475,6 +557,9 @@ bool EngineConfiguration::operator==(const EngineConfiguration& other) const
 		|| m_command != other.m_command
 		|| m_workingDirectory != other.m_workingDirectory
 		|| m_stderrFile != other.m_stderrFile
+		|| m_cpuAffinity != other.m_cpuAffinity
+		|| m_niceness != other.m_niceness
+		|| m_ioPriority != other.m_ioPriority
 		|| m_protocol != other.m_protocol
 		|| m_arguments != other.m_arguments
 		|| m_initStrings != other.m_initStrings
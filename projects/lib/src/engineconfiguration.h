@@ -96,6 +96,50 @@ class LIB_EXPORT EngineConfiguration
 		 * \sa stderrFile()
 		 */
 		void setStderrFile(const QString& fileName);
+		/*!
+		 * Sets the CPU affinity of the engine process.
+		 *
+		 * \a cpuList is a comma-separated list of CPU numbers
+		 * and ranges (e.g. "0-7,16-23"). An empty list means
+		 * the engine inherits the parent's affinity. On NUMA
+		 * systems restricting an engine to the CPUs of one
+		 * node also keeps its memory allocations local.
+		 *
+		 * \note Affinity is currently applied only on Linux.
+		 *
+		 * \sa cpuAffinity()
+		 */
+		void setCpuAffinity(const QString& cpuList);
+		/*!
+		 * Sets the scheduling priority (nice value) of the
+		 * engine process to \a niceness.
+		 *
+		 * Valid values range from -20 (highest priority) to 19
+		 * (lowest); negative values usually require elevated
+		 * privileges. The default of 0 inherits the parent's
+		 * priority. Running engines at a negative nice value
+		 * lets them win the CPU over cutechess's own
+		 * bookkeeping threads.
+		 *
+		 * \note Priority is currently applied only on Linux.
+		 *
+		 * \sa niceness()
+		 */
+		void setNiceness(int niceness);
+		/*!
+		 * Sets the I/O scheduling class of the engine process.
+		 *
+		 * \a ioClass is "idle", or "be0" to "be7" for the
+		 * best-effort class with the given level (0 is the
+		 * highest). An empty string, the default, inherits the
+		 * parent's I/O class.
+		 *
+		 * \note The I/O class is currently applied only on
+		 * Linux.
+		 *
+		 * \sa ioPriority()
+		 */
+		void setIoPriority(const QString& ioClass);
 		/*!
 		 * Sets the communication protocol the engine uses.
 		 *
@@ -127,6 +171,29 @@ class LIB_EXPORT EngineConfiguration
 		 * \sa setCommand()
 		 */
 		QString command() const;
+		/*!
+		 * Returns true if the command is a remote engine
+		 * endpoint of the form "tcp://host:port"; otherwise
+		 * returns false.
+		 *
+		 * A remote engine is not launched as a local process.
+		 * Instead a TCP connection to the endpoint takes the
+		 * place of the process pipes, and the engine is spoken
+		 * to over it with its normal chess protocol.
+		 *
+		 * \sa remoteHost(), remotePort()
+		 */
+		bool isRemote() const;
+		/*!
+		 * Returns the host part of a remote engine endpoint,
+		 * or an empty string if the endpoint is invalid.
+		 */
+		QString remoteHost() const;
+		/*!
+		 * Returns the port part of a remote engine endpoint,
+		 * or 0 if the endpoint is invalid.
+		 */
+		quint16 remotePort() const;
 		/*!
 		 * Returns the working directory the engine uses.
 		 *
@@ -140,6 +207,26 @@ class LIB_EXPORT EngineConfiguration
 		 * \sa setStderrFile()
 		 */
 		QString stderrFile() const;
+		/*!
+		 * Returns the CPU affinity of the engine process.
+		 *
+		 * \sa setCpuAffinity()
+		 */
+		QString cpuAffinity() const;
+		/*!
+		 * Returns the scheduling priority (nice value) of the
+		 * engine process.
+		 *
+		 * \sa setNiceness()
+		 */
+		int niceness() const;
+		/*!
+		 * Returns the I/O scheduling class of the engine
+		 * process.
+		 *
+		 * \sa setIoPriority()
+		 */
+		QString ioPriority() const;
 		/*!
 		 * Returns the communication protocol the engine uses.
 		 *
@@ -246,6 +333,9 @@ class LIB_EXPORT EngineConfiguration
 		QString m_command;
 		QString m_workingDirectory;
 		QString m_stderrFile;
+		QString m_cpuAffinity;
+		int m_niceness;
+		QString m_ioPriority;
 		QString m_protocol;
 		QStringList m_arguments;
 		QStringList m_initStrings;
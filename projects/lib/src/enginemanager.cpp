@@ -101,61 +101,138 @@ bool EngineManager::supportsVariant(const QString& variant) const
 	return true;
 }
 
-void EngineManager::loadEngines(const QString& fileName)
+void EngineManager::setConfigFile(const QString& fileName)
 {
-	if (!QFile::exists(fileName))
-		return;
+	m_configFile = fileName;
+}
 
-	QFile input(fileName);
+QString EngineManager::configFile() const
+{
+	return m_configFile;
+}
+
+bool EngineManager::findEngine(const QString& name, EngineConfiguration* config)
+{
+	Q_ASSERT(config != nullptr);
+
+	const int index = engineIndex(name);
+	if (index >= 0)
+	{
+		*config = engineAt(index);
+		return true;
+	}
+
+	if (m_configFile.isEmpty() || !QFile::exists(m_configFile))
+		return false;
+
+	QFile input(m_configFile);
 	if (!input.open(QIODevice::ReadOnly | QIODevice::Text))
 	{
 		qWarning("cannot open engine configuration file: %s",
-			 qUtf8Printable(fileName));
-		return;
+			 qUtf8Printable(m_configFile));
+		return false;
 	}
 
 	QTextStream stream(&input);
 	JsonParser parser(stream);
-	const QVariantList engines(parser.parse().toList());
 
-	if (parser.hasError())
+	// Scan the file entry by entry and construct a full
+	// EngineConfiguration only for the one that matches
+	if (parser.openArray())
 	{
-		qWarning("%s", qUtf8Printable(QString("bad engine configuration file line %1 in %2: %3")
-			.arg(parser.errorLineNumber()).arg(fileName).arg(parser.errorString()))); // clazy:exclude=qstring-arg
-		return;
+		bool atEnd = false;
+		for (;;)
+		{
+			const QVariant engine = parser.parseNextItem(&atEnd);
+			if (atEnd || parser.hasError())
+				break;
+			if (engine.toMap().value("name").toString() == name)
+			{
+				*config = EngineConfiguration(engine);
+				addEngine(*config);
+				return true;
+			}
+		}
 	}
 
-	for (const QVariant& engine : engines)
-		addEngine(EngineConfiguration(engine));
+	if (parser.hasError())
+		qWarning("%s", qUtf8Printable(QString("bad engine configuration file line %1 in %2: %3")
+			.arg(parser.errorLineNumber()).arg(m_configFile).arg(parser.errorString()))); // clazy:exclude=qstring-arg
+
+	return false;
 }
 
-void EngineManager::reloadEngines(const QString& fileName)
+// Reads the engine entries of 'fileName' one at a time with the
+// parser's pull interface, so only one entry's QVariant tree is in
+// memory at a time instead of the whole document's.
+QList<EngineConfiguration> EngineManager::readEngines(const QString& fileName,
+						      bool* ok)
 {
-	if (!QFile::exists(fileName))
-		return;
+	Q_ASSERT(ok != nullptr);
+	*ok = false;
+
+	QList<EngineConfiguration> engines;
 
 	QFile input(fileName);
 	if (!input.open(QIODevice::ReadOnly | QIODevice::Text))
 	{
-		qWarning("cannot open engine configuration file: %s", qUtf8Printable(fileName));
-		return;
+		qWarning("cannot open engine configuration file: %s",
+			 qUtf8Printable(fileName));
+		return engines;
 	}
 
 	QTextStream stream(&input);
 	JsonParser parser(stream);
-	const QVariantList engines(parser.parse().toList());
+
+	if (parser.openArray())
+	{
+		bool atEnd = false;
+		for (;;)
+		{
+			const QVariant engine = parser.parseNextItem(&atEnd);
+			if (atEnd || parser.hasError())
+				break;
+			engines << EngineConfiguration(engine);
+		}
+	}
 
 	if (parser.hasError())
 	{
 		qWarning("%s", qUtf8Printable(QString("bad engine configuration file line %1 in %2: %3")
 			.arg(parser.errorLineNumber()).arg(fileName).arg(parser.errorString()))); // clazy:exclude=qstring-arg
-		return;
+		engines.clear();
+		return engines;
 	}
 
+	*ok = true;
+	return engines;
+}
+
+void EngineManager::loadEngines(const QString& fileName)
+{
+	if (!QFile::exists(fileName))
+		return;
+
+	bool ok = false;
+	const QList<EngineConfiguration> engines = readEngines(fileName, &ok);
+	if (!ok)
+		return;
+
+	for (const EngineConfiguration& engine : engines)
+		addEngine(engine);
+}
+
+void EngineManager::reloadEngines(const QString& fileName)
+{
+	if (!QFile::exists(fileName))
+		return;
+
+	bool ok = false;
+	const QList<EngineConfiguration> newEngines = readEngines(fileName, &ok);
+	if (!ok)
+		return;
+
 	QSet<QString> names = engineNames();
-	QList<EngineConfiguration> newEngines;
-	for (const QVariant& engine : engines)
-		newEngines << engine;
 
 	for (const EngineConfiguration& engine : newEngines)
 	{
@@ -61,6 +61,35 @@ class LIB_EXPORT EngineManager : public QObject
 		 */
 		bool supportsVariant(const QString& variant) const;
 
+		/*!
+		 * Sets the engine configuration file to \a fileName
+		 * without parsing it.
+		 *
+		 * Entries of the file are then located and parsed on
+		 * demand by findEngine(), so an application that
+		 * references only a couple of engines by name doesn't
+		 * pay for loading a large configuration file at
+		 * startup.
+		 */
+		void setConfigFile(const QString& fileName);
+		/*! Returns the engine configuration file name. */
+		QString configFile() const;
+		/*!
+		 * Finds the engine configuration named \a name.
+		 *
+		 * Already loaded configurations are searched first. If
+		 * \a name isn't among them and a configuration file was
+		 * set with setConfigFile(), the file is scanned and
+		 * only the matching entry is turned into an
+		 * EngineConfiguration and added to the list of
+		 * available engines.
+		 *
+		 * Returns true and assigns the configuration to
+		 * \a config if the engine was found; otherwise returns
+		 * false.
+		 */
+		bool findEngine(const QString& name, EngineConfiguration* config);
+
 		void loadEngines(const QString& fileName);
 		void reloadEngines(const QString& fileName);
 		void saveEngines(const QString& fileName);
@@ -86,7 +115,11 @@ class LIB_EXPORT EngineManager : public QObject
 		void engineUpdated(int index);
 
 	private:
+		static QList<EngineConfiguration> readEngines(const QString& fileName,
+							      bool* ok);
+
 		QList<EngineConfiguration> m_engines;
+		QString m_configFile;
 
 };
 
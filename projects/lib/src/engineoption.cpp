@@ -19,10 +19,154 @@
 #include "engineoption.h"
 
 
+EngineOptionValue::EngineOptionValue()
+	: m_type(Null),
+	  m_number(0)
+{
+}
+
+EngineOptionValue::EngineOptionValue(bool value)
+	: m_type(Bool),
+	  m_number(value ? 1 : 0)
+{
+}
+
+EngineOptionValue::EngineOptionValue(int value)
+	: m_type(Int),
+	  m_number(value)
+{
+}
+
+EngineOptionValue::EngineOptionValue(const QString& value)
+	: m_type(String),
+	  m_number(0),
+	  m_string(value)
+{
+}
+
+EngineOptionValue::Type EngineOptionValue::type() const
+{
+	return m_type;
+}
+
+bool EngineOptionValue::isNull() const
+{
+	return m_type == Null;
+}
+
+bool EngineOptionValue::toBool() const
+{
+	if (m_type == String)
+		return m_string == "true";
+	return m_number != 0;
+}
+
+int EngineOptionValue::toInt(bool* ok) const
+{
+	switch (m_type)
+	{
+	case Bool:
+	case Int:
+		if (ok != nullptr)
+			*ok = true;
+		return m_number;
+	case String:
+		return m_string.toInt(ok);
+	default:
+		if (ok != nullptr)
+			*ok = false;
+		return 0;
+	}
+}
+
+QString EngineOptionValue::toString() const
+{
+	switch (m_type)
+	{
+	case Bool:
+		return m_number != 0 ? QStringLiteral("true")
+				     : QStringLiteral("false");
+	case Int:
+		return QString::number(m_number);
+	case String:
+		return m_string;
+	default:
+		return QString();
+	}
+}
+
+EngineOptionValue EngineOptionValue::convertTo(Type type) const
+{
+	if (m_type == type || m_type == Null)
+		return *this;
+
+	switch (type)
+	{
+	case Bool:
+		return EngineOptionValue(toBool());
+	case Int:
+		return EngineOptionValue(toInt());
+	case String:
+		return EngineOptionValue(toString());
+	default:
+		return EngineOptionValue();
+	}
+}
+
+QVariant EngineOptionValue::toVariant() const
+{
+	switch (m_type)
+	{
+	case Bool:
+		return QVariant(m_number != 0);
+	case Int:
+		return QVariant(m_number);
+	case String:
+		return QVariant(m_string);
+	default:
+		return QVariant();
+	}
+}
+
+EngineOptionValue EngineOptionValue::fromVariant(const QVariant& variant)
+{
+	if (variant.isNull())
+		return EngineOptionValue();
+
+	switch (variant.type())
+	{
+	case QVariant::Bool:
+		return EngineOptionValue(variant.toBool());
+	case QVariant::Int:
+	case QVariant::UInt:
+	case QVariant::LongLong:
+	case QVariant::ULongLong:
+	case QVariant::Double:
+		return EngineOptionValue(variant.toInt());
+	default:
+		return EngineOptionValue(variant.toString());
+	}
+}
+
+bool EngineOptionValue::operator==(const EngineOptionValue& other) const
+{
+	if (m_type != other.m_type)
+		return false;
+	if (m_type == String)
+		return m_string == other.m_string;
+	return m_number == other.m_number;
+}
+
+bool EngineOptionValue::operator!=(const EngineOptionValue& other) const
+{
+	return !operator==(other);
+}
+
+
 EngineOption::EngineOption(const QString& name,
-			   QVariant::Type valueType,
-			   const QVariant& value,
-			   const QVariant& defaultValue,
+			   EngineOptionValue::Type valueType,
+			   const EngineOptionValue& value,
+			   const EngineOptionValue& defaultValue,
 			   const QString& alias)
 	: m_valueType(valueType),
 	  m_name(name),
@@ -30,10 +174,10 @@ EngineOption::EngineOption(const QString& name,
 	  m_defaultValue(defaultValue),
 	  m_alias(alias)
 {
-	if (valueType != QVariant::Invalid)
+	if (valueType != EngineOptionValue::Null)
 	{
-		m_value.convert(valueType);
-		m_defaultValue.convert(valueType);
+		m_value = m_value.convertTo(valueType);
+		m_defaultValue = m_defaultValue.convertTo(valueType);
 	}
 }
 
@@ -41,7 +185,7 @@ EngineOption::~EngineOption()
 {
 }
 
-QVariant::Type EngineOption::valueType() const
+EngineOptionValue::Type EngineOption::valueType() const
 {
 	return m_valueType;
 }
@@ -68,12 +212,12 @@ QString EngineOption::name() const
 	return m_name;
 }
 
-QVariant EngineOption::value() const
+const EngineOptionValue& EngineOption::value() const
 {
 	return m_value;
 }
 
-QVariant EngineOption::defaultValue() const
+const EngineOptionValue& EngineOption::defaultValue() const
 {
 	return m_defaultValue;
 }
@@ -88,16 +232,14 @@ void EngineOption::setName(const QString& name)
 	m_name = name;
 }
 
-void EngineOption::setValue(const QVariant& value)
+void EngineOption::setValue(const EngineOptionValue& value)
 {
-	m_value = value;
-	m_value.convert(m_valueType);
+	m_value = value.convertTo(m_valueType);
 }
 
-void EngineOption::setDefaultValue(const QVariant& value)
+void EngineOption::setDefaultValue(const EngineOptionValue& value)
 {
-	m_defaultValue = value;
-	m_defaultValue.convert(m_valueType);
+	m_defaultValue = value.convertTo(m_valueType);
 }
 
 void EngineOption::setAlias(const QString& alias)
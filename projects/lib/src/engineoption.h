@@ -22,41 +22,124 @@
 #include <QString>
 #include <QVariant>
 
+/*!
+ * \brief A small typed value of an engine option.
+ *
+ * Engine options only ever hold booleans, integers or strings, so
+ * their values are kept in a tagged type of exactly those three
+ * alternatives instead of a QVariant. Copying and comparing values
+ * then never allocates or type-dispatches, which matters because
+ * every engine start applies and compares the whole option list and
+ * every EngineConfiguration copy clones it.
+ *
+ * QVariant still exists at the boundaries - JSON serialization and
+ * the GUI's item models - via toVariant() and fromVariant().
+ */
+class LIB_EXPORT EngineOptionValue
+{
+	public:
+		/*! The type of the value. */
+		enum Type
+		{
+			Null,	//!< No value (eg. button options)
+			Bool,	//!< Boolean value
+			Int,	//!< Integer value
+			String	//!< String value
+		};
+
+		/*! Creates a new null value. */
+		EngineOptionValue();
+		/*! Creates a new boolean value. */
+		EngineOptionValue(bool value);
+		/*! Creates a new integer value. */
+		EngineOptionValue(int value);
+		/*! Creates a new string value. */
+		EngineOptionValue(const QString& value);
+
+		/*! Returns the type of the value. */
+		Type type() const;
+		/*! Returns true if the value is null. */
+		bool isNull() const;
+
+		/*!
+		 * Returns the value as a boolean.
+		 *
+		 * Integers convert to their truth value and strings
+		 * compare against "true"; a null value is false.
+		 */
+		bool toBool() const;
+		/*!
+		 * Returns the value as an integer.
+		 *
+		 * If \a ok is not null, it's set to true if the value
+		 * is convertible to an integer; otherwise it's set to
+		 * false.
+		 */
+		int toInt(bool* ok = nullptr) const;
+		/*! Returns the value as a string. */
+		QString toString() const;
+
+		/*!
+		 * Returns the value converted to \a type.
+		 *
+		 * A null value stays null regardless of \a type.
+		 */
+		EngineOptionValue convertTo(Type type) const;
+
+		/*! Returns the value as a QVariant. */
+		QVariant toVariant() const;
+		/*! Creates a value from \a variant. */
+		static EngineOptionValue fromVariant(const QVariant& variant);
+
+		/*!
+		 * Returns true if \a other has the same type and
+		 * payload as this value; otherwise returns false.
+		 */
+		bool operator==(const EngineOptionValue& other) const;
+		/*! Returns true if \a other differs from this value. */
+		bool operator!=(const EngineOptionValue& other) const;
+
+	private:
+		Type m_type;
+		int m_number;	// the Bool and Int payload
+		QString m_string;
+};
+
 class LIB_EXPORT EngineOption
 {
 	public:
 		explicit EngineOption(const QString& name,
-				      QVariant::Type valueType,
-		                      const QVariant& value = QVariant(),
-		                      const QVariant& defaultValue = QVariant(),
+				      EngineOptionValue::Type valueType,
+		                      const EngineOptionValue& value = EngineOptionValue(),
+		                      const EngineOptionValue& defaultValue = EngineOptionValue(),
 		                      const QString& alias = QString());
 		virtual ~EngineOption();
 
 		/*! Creates and returns a deep copy of this option. */
 		virtual EngineOption* copy() const = 0;
 
-		QVariant::Type valueType() const;
+		EngineOptionValue::Type valueType() const;
 		bool isValid() const;
-		virtual bool isValid(const QVariant& value) const = 0;
+		virtual bool isValid(const EngineOptionValue& value) const = 0;
 		virtual bool isEditable() const;
 
 		QString name() const;
-		QVariant value() const;
-		QVariant defaultValue() const;
+		const EngineOptionValue& value() const;
+		const EngineOptionValue& defaultValue() const;
 		QString alias() const;
 
 		void setName(const QString& name);
-		void setValue(const QVariant& value);
-		void setDefaultValue(const QVariant& value);
+		void setValue(const EngineOptionValue& value);
+		void setDefaultValue(const EngineOptionValue& value);
 		void setAlias(const QString& alias);
 
 		virtual QVariant toVariant() const = 0;
 
 	private:
-		QVariant::Type m_valueType;
+		EngineOptionValue::Type m_valueType;
 		QString m_name;
-		QVariant m_value;
-		QVariant m_defaultValue;
+		EngineOptionValue m_value;
+		EngineOptionValue m_defaultValue;
 		QString m_alias;
 };
 
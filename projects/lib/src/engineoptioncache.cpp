@@ -0,0 +1,180 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "engineoptioncache.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutex>
+#include <QSettings>
+#include <QTextStream>
+#include <jsonparser.h>
+#include <jsonserializer.h>
+
+
+static QVariantMap s_cache;
+static bool s_loaded = false;
+static QMutex s_mutex;
+
+// Returns the program part of an engine command: the first token,
+// honoring quotes and skipping a "wine" launcher prefix.
+static QString commandProgram(const QString& command)
+{
+	QString cmd = command.trimmed();
+	if (cmd.startsWith("wine "))
+		cmd = cmd.mid(5).trimmed();
+
+	if (cmd.startsWith('\"'))
+	{
+		int end = cmd.indexOf('\"', 1);
+		if (end < 0)
+			return QString();
+		return cmd.mid(1, end - 1);
+	}
+
+	int end = cmd.indexOf(' ');
+	if (end < 0)
+		return cmd;
+	return cmd.left(end);
+}
+
+QString EngineOptionCache::binaryKey(const QString& command,
+				     const QString& workingDirectory)
+{
+	QString program = commandProgram(command);
+	if (program.isEmpty())
+		return QString();
+
+	QFileInfo info(program);
+	if (info.isRelative() && !workingDirectory.isEmpty())
+		info.setFile(QDir(workingDirectory), program);
+	if (!info.isFile())
+		return QString();
+
+	return info.canonicalFilePath();
+}
+
+QString EngineOptionCache::cacheFilePath()
+{
+	// Same directory that engines.json and the QSettings file
+	// live in; QDesktopServices would require QtGui
+	QSettings settings;
+	QFileInfo fi(settings.fileName());
+
+	return fi.absolutePath() + QLatin1String("/optioncache.json");
+}
+
+void EngineOptionCache::loadCache()
+{
+	if (s_loaded)
+		return;
+	s_loaded = true;
+
+	QFile input(cacheFilePath());
+	if (!input.exists())
+		return;
+	if (!input.open(QIODevice::ReadOnly | QIODevice::Text))
+	{
+		qWarning("cannot open engine option cache: %s",
+			 qUtf8Printable(input.fileName()));
+		return;
+	}
+
+	QTextStream stream(&input);
+	JsonParser parser(stream);
+	const QVariant data = parser.parse();
+
+	if (parser.hasError())
+	{
+		qWarning("%s", qUtf8Printable(QString("bad engine option cache line %1 in %2: %3")
+			.arg(parser.errorLineNumber()).arg(input.fileName()).arg(parser.errorString()))); // clazy:exclude=qstring-arg
+		return;
+	}
+
+	s_cache = data.toMap();
+}
+
+void EngineOptionCache::saveCache()
+{
+	QFileInfo fi(cacheFilePath());
+	QDir dir(fi.absolutePath());
+	if (!dir.exists())
+		dir.mkpath(fi.absolutePath());
+
+	QFile output(fi.absoluteFilePath());
+	if (!output.open(QIODevice::WriteOnly | QIODevice::Text))
+	{
+		qWarning("cannot open engine option cache: %s",
+			 qUtf8Printable(output.fileName()));
+		return;
+	}
+
+	QTextStream out(&output);
+	JsonSerializer serializer(s_cache);
+	serializer.serialize(out);
+}
+
+bool EngineOptionCache::lookup(const QString& binaryKey,
+			       const QString& protocol,
+			       QVariantMap* data)
+{
+	Q_ASSERT(data != nullptr);
+
+	if (binaryKey.isEmpty())
+		return false;
+
+	QMutexLocker locker(&s_mutex);
+	loadCache();
+
+	const QVariant entry = s_cache.value(protocol + ':' + binaryKey);
+	if (entry.isNull())
+		return false;
+
+	const QVariantMap map = entry.toMap();
+	QFileInfo info(binaryKey);
+	if (!info.isFile()
+	||  map.value("size").toLongLong() != info.size()
+	||  map.value("mtime").toLongLong() != info.lastModified().toMSecsSinceEpoch())
+		return false;
+
+	*data = map.value("data").toMap();
+	return true;
+}
+
+void EngineOptionCache::store(const QString& binaryKey,
+			      const QString& protocol,
+			      const QVariantMap& data)
+{
+	if (binaryKey.isEmpty())
+		return;
+
+	QFileInfo info(binaryKey);
+	if (!info.isFile())
+		return;
+
+	QVariantMap entry;
+	entry["size"] = info.size();
+	entry["mtime"] = info.lastModified().toMSecsSinceEpoch();
+	entry["data"] = data;
+
+	QMutexLocker locker(&s_mutex);
+	loadCache();
+
+	s_cache[protocol + ':' + binaryKey] = entry;
+	saveCache();
+}
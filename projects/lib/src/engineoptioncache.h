@@ -0,0 +1,85 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ENGINEOPTIONCACHE_H
+#define ENGINEOPTIONCACHE_H
+
+#include <QString>
+#include <QVariantMap>
+
+
+/*!
+ * \brief A persistent cache for discovered engine options
+ *
+ * Discovering an engine's options means starting the engine and
+ * parsing its full option dump, which for engines with hundreds of
+ * options delays readiness at every game start and makes the engine
+ * configuration dialog wait for a full protocol handshake.
+ *
+ * EngineOptionCache stores the result of one discovery on disk, keyed
+ * by the engine binary's canonical path together with the protocol the
+ * engine was probed under. The binary's size and modification time are
+ * stored with each entry, so an updated binary invalidates its entry
+ * automatically.
+ *
+ * What a cache entry contains is up to the chess protocol that stores
+ * it. UciEngine stores a map with the keys "options" (a list of
+ * EngineOption variant maps), "variants" (a string list), "ponder" and
+ * "opponent" (booleans).
+ *
+ * \sa UciEngine
+ */
+class LIB_EXPORT EngineOptionCache
+{
+	public:
+		/*!
+		 * Returns the cache key for the engine binary launched by
+		 * \a command in \a workingDirectory: the binary's canonical
+		 * path. Returns an empty string if the command doesn't
+		 * resolve to an existing file, in which case the engine
+		 * can't be cached.
+		 */
+		static QString binaryKey(const QString& command,
+					 const QString& workingDirectory);
+		/*!
+		 * Looks up the cache entry for binary \a binaryKey probed
+		 * under \a protocol and stores it in \a data.
+		 *
+		 * Returns true if a valid entry was found; otherwise (no
+		 * entry, or the binary has changed since the entry was
+		 * stored) returns false.
+		 */
+		static bool lookup(const QString& binaryKey,
+				   const QString& protocol,
+				   QVariantMap* data);
+		/*!
+		 * Stores \a data as the cache entry for binary \a binaryKey
+		 * probed under \a protocol, replacing any previous entry,
+		 * and saves the cache to disk.
+		 */
+		static void store(const QString& binaryKey,
+				  const QString& protocol,
+				  const QVariantMap& data);
+
+	private:
+		static QString cacheFilePath();
+		static void loadCache();
+		static void saveCache();
+};
+
+#endif // ENGINEOPTIONCACHE_H
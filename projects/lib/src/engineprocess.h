@@ -24,8 +24,7 @@
 #ifdef Q_OS_WIN32
   #include "engineprocess_win.h"
 #else // not Q_OS_WIN32
-  #include <QProcess>
-  #define EngineProcess QProcess
+  #include "engineprocess_unix.h"
 #endif // not Q_OS_WIN32
 
 #endif // ENGINEPROCESS_H
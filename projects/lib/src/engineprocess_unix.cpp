@@ -0,0 +1,590 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "engineprocess_unix.h"
+#include <QFile>
+#include <QRegExp>
+#include <QSocketNotifier>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QVarLengthArray>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <signal.h>
+#include <spawn.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+extern char** environ;
+
+namespace {
+
+bool setCloexec(int fd)
+{
+	return fcntl(fd, F_SETFD, FD_CLOEXEC) == 0;
+}
+
+bool setNonBlocking(int fd)
+{
+	int flags = fcntl(fd, F_GETFL);
+	if (flags == -1)
+		return false;
+	return fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+// Creates a pipe whose both ends close on exec. The dup2() file
+// actions clear the flag on the child's standard descriptors, so
+// nothing has to be closed by hand in the child.
+bool openPipe(int fds[2])
+{
+	if (pipe(fds) != 0)
+		return false;
+	return setCloexec(fds[0]) && setCloexec(fds[1]);
+}
+
+} // anonymous namespace
+
+EngineProcess::EngineProcess(QObject* parent)
+	: QIODevice(parent),
+	  m_started(false),
+	  m_finished(false),
+	  m_exitCode(0),
+	  m_exitStatus(EngineProcess::NormalExit),
+	  m_pid(0),
+	  m_stdErrFileMode(Truncate),
+	  m_inWrite(-1),
+	  m_outRead(-1),
+	  m_errRead(-1),
+	  m_outNotifier(nullptr),
+	  m_errNotifier(nullptr)
+{
+}
+
+EngineProcess::~EngineProcess()
+{
+	if (m_started)
+	{
+		qWarning("EngineProcess: Destroyed while process is still running.");
+		kill();
+		waitForFinished();
+	}
+	cleanup();
+}
+
+int EngineProcess::exitCode() const
+{
+	return m_exitCode;
+}
+
+EngineProcess::ExitStatus EngineProcess::exitStatus() const
+{
+	return m_exitStatus;
+}
+
+qint64 EngineProcess::processId() const
+{
+	if (!m_started)
+		return 0;
+	return qint64(m_pid);
+}
+
+qint64 EngineProcess::bytesAvailable() const
+{
+	return QIODevice::bytesAvailable() + m_readBuf.size();
+}
+
+bool EngineProcess::canReadLine() const
+{
+	return m_readBuf.contains('\n') || QIODevice::canReadLine();
+}
+
+void EngineProcess::closeFd(int* fd)
+{
+	if (*fd == -1)
+		return;
+	::close(*fd);
+	*fd = -1;
+}
+
+void EngineProcess::cleanup()
+{
+	delete m_outNotifier;
+	m_outNotifier = nullptr;
+	delete m_errNotifier;
+	m_errNotifier = nullptr;
+
+	closeFd(&m_inWrite);
+	closeFd(&m_outRead);
+	closeFd(&m_errRead);
+
+	m_started = false;
+}
+
+void EngineProcess::close()
+{
+	if (!m_started)
+		return;
+
+	emit aboutToClose();
+	kill();
+	waitForFinished(-1);
+	cleanup();
+	QIODevice::close();
+}
+
+bool EngineProcess::isSequential() const
+{
+	return true;
+}
+
+void EngineProcess::setWorkingDirectory(const QString& dir)
+{
+	m_workDir = dir;
+}
+
+void EngineProcess::setStandardErrorFile(const QString& fileName, OpenMode mode)
+{
+	m_stdErrFile = fileName;
+	m_stdErrFileMode = mode;
+}
+
+QByteArray EngineProcess::readAllStandardError()
+{
+	QByteArray data;
+	data.swap(m_errBuf);
+	return data;
+}
+
+void EngineProcess::start(const QString& program,
+			  const QStringList& arguments,
+			  OpenMode mode)
+{
+	if (m_started)
+		close();
+
+	m_started = false;
+	m_finished = false;
+	m_exitCode = 0;
+	m_exitStatus = NormalExit;
+	m_pid = 0;
+	m_readBuf.clear();
+	m_errBuf.clear();
+
+	// A write to an engine that just died must fail with EPIPE
+	// instead of killing the whole tournament process
+	static bool sigPipeIgnored = false;
+	if (!sigPipeIgnored)
+	{
+		signal(SIGPIPE, SIG_IGN);
+		sigPipeIgnored = true;
+	}
+
+	int inPipe[2] = { -1, -1 };
+	int outPipe[2] = { -1, -1 };
+	int errPipe[2] = { -1, -1 };
+	int errFile = -1;
+
+	if (!openPipe(inPipe) || !openPipe(outPipe))
+	{
+		closeFd(&inPipe[0]);
+		closeFd(&inPipe[1]);
+		closeFd(&outPipe[0]);
+		closeFd(&outPipe[1]);
+		return;
+	}
+
+#ifdef F_SETPIPE_SZ
+	// Enlarge the pipes beyond the default 64 kB. A chatty engine
+	// can then dump a long search's "info" lines without blocking
+	// on a full pipe, and bursts need fewer wakeups on both ends.
+	// Failure (old kernel, pipe-user-pages-soft limit) is fine.
+	fcntl(inPipe[1], F_SETPIPE_SZ, 262144);
+	fcntl(outPipe[1], F_SETPIPE_SZ, 262144);
+#endif
+
+	if (!m_stdErrFile.isEmpty())
+	{
+		int flags = O_WRONLY | O_CREAT;
+		flags |= (m_stdErrFileMode == Append) ? O_APPEND : O_TRUNC;
+
+		errFile = ::open(QFile::encodeName(m_stdErrFile).constData(),
+				 flags, 0666);
+		if (errFile == -1)
+			qWarning("EngineProcess: cannot open %s",
+				 qUtf8Printable(m_stdErrFile));
+		else
+			setCloexec(errFile);
+	}
+	else if (!openPipe(errPipe))
+	{
+		errPipe[0] = -1;
+		errPipe[1] = -1;
+	}
+
+	posix_spawn_file_actions_t actions;
+	posix_spawn_file_actions_init(&actions);
+	posix_spawn_file_actions_adddup2(&actions, inPipe[0], STDIN_FILENO);
+	posix_spawn_file_actions_adddup2(&actions, outPipe[1], STDOUT_FILENO);
+	if (errFile != -1)
+		posix_spawn_file_actions_adddup2(&actions, errFile, STDERR_FILENO);
+	else if (errPipe[1] != -1)
+		posix_spawn_file_actions_adddup2(&actions, errPipe[1], STDERR_FILENO);
+
+	posix_spawnattr_t attr;
+	posix_spawnattr_init(&attr);
+
+	short spawnFlags = POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF;
+#ifdef POSIX_SPAWN_USEVFORK
+	// Share the parent's address space until exec instead of
+	// duplicating its page tables. Recent glibc does this by
+	// default and treats the flag as a no-op.
+	spawnFlags |= POSIX_SPAWN_USEVFORK;
+#endif
+	posix_spawnattr_setflags(&attr, spawnFlags);
+
+	// Don't leak our signal mask or handlers into the engine
+	sigset_t sigMask;
+	sigemptyset(&sigMask);
+	posix_spawnattr_setsigmask(&attr, &sigMask);
+
+	sigset_t sigDefault;
+	sigfillset(&sigDefault);
+	posix_spawnattr_setsigdefault(&attr, &sigDefault);
+
+	QList<QByteArray> encodedArgs;
+	encodedArgs << QFile::encodeName(program);
+	for (const QString& arg : arguments)
+		encodedArgs << arg.toLocal8Bit();
+
+	QVarLengthArray<char*, 16> argv;
+	for (const QByteArray& arg : qAsConst(encodedArgs))
+		argv.append(const_cast<char*>(arg.constData()));
+	argv.append(nullptr);
+
+	// posix_spawn() has no portable way to set the child's working
+	// directory, so switch the parent's around the spawn instead.
+	// Engines are always launched from the main thread, so nothing
+	// else can see the temporary switch.
+	int oldWorkDir = -1;
+	if (!m_workDir.isEmpty())
+	{
+		oldWorkDir = ::open(".", O_RDONLY);
+		if (::chdir(QFile::encodeName(m_workDir).constData()) != 0)
+			qWarning("EngineProcess: cannot enter directory %s",
+				 qUtf8Printable(m_workDir));
+	}
+
+	int err = posix_spawnp(&m_pid,
+			       encodedArgs.first().constData(),
+			       &actions,
+			       &attr,
+			       argv.data(),
+			       environ);
+
+	if (oldWorkDir != -1)
+	{
+		if (fchdir(oldWorkDir) != 0)
+			qWarning("EngineProcess: cannot restore working directory");
+		::close(oldWorkDir);
+	}
+
+	posix_spawn_file_actions_destroy(&actions);
+	posix_spawnattr_destroy(&attr);
+
+	// Close the child's ends of the pipes to make sure that reads
+	// will return when the child terminates and closes its copies
+	closeFd(&inPipe[0]);
+	closeFd(&outPipe[1]);
+	closeFd(&errPipe[1]);
+	closeFd(&errFile);
+
+	if (err != 0)
+	{
+		closeFd(&inPipe[1]);
+		closeFd(&outPipe[0]);
+		closeFd(&errPipe[0]);
+		return;
+	}
+
+	m_started = true;
+	m_inWrite = inPipe[1];
+	m_outRead = outPipe[0];
+	m_errRead = errPipe[0];
+
+	setNonBlocking(m_outRead);
+	m_outNotifier = new QSocketNotifier(m_outRead, QSocketNotifier::Read, this);
+	connect(m_outNotifier, SIGNAL(activated(int)),
+		this, SLOT(onOutputReady()));
+
+	if (m_errRead != -1)
+	{
+		setNonBlocking(m_errRead);
+		m_errNotifier = new QSocketNotifier(m_errRead,
+						    QSocketNotifier::Read,
+						    this);
+		connect(m_errNotifier, SIGNAL(activated(int)),
+			this, SLOT(onErrorReady()));
+	}
+
+	// Make QIODevice aware that the device is now open
+	QIODevice::open(mode);
+}
+
+void EngineProcess::start(const QString& program,
+			  OpenMode mode)
+{
+	QStringList args = splitCommand(program);
+	if (args.isEmpty())
+		return;
+
+	QString prog = args.first();
+	args.removeFirst();
+	start(prog, args, mode);
+}
+
+QStringList EngineProcess::splitCommand(const QString& command)
+{
+	QStringList args;
+
+	QRegExp rx("((?:[^\\s\"]+)|(?:\"(?:\\\\\"|[^\"])*\"))");
+	int pos = 0;
+	while ((pos = rx.indexIn(command, pos)) != -1)
+	{
+		QString arg = rx.cap();
+		if (arg.startsWith('\"') && arg.endsWith('\"'))
+		{
+			arg.chop(1);
+			arg.remove(0, 1);
+		}
+		args << arg;
+		pos += rx.matchedLength();
+	}
+
+	return args;
+}
+
+void EngineProcess::kill()
+{
+	if (m_started && !m_finished)
+		::kill(m_pid, SIGKILL);
+}
+
+bool EngineProcess::reapProcess(bool blocking)
+{
+	if (m_finished)
+		return true;
+
+	int status = 0;
+	pid_t ret;
+	do
+	{
+		ret = waitpid(m_pid, &status, blocking ? 0 : WNOHANG);
+	}
+	while (ret == -1 && errno == EINTR);
+
+	if (ret != m_pid)
+		return false;
+
+	m_finished = true;
+	if (WIFSIGNALED(status))
+	{
+		m_exitCode = 0;
+		m_exitStatus = CrashExit;
+	}
+	else
+	{
+		m_exitCode = WEXITSTATUS(status);
+		m_exitStatus = NormalExit;
+	}
+
+	return true;
+}
+
+void EngineProcess::onFinished()
+{
+	if (!m_started || !m_finished)
+		return;
+
+	// Deliver the last stderr output before tearing the pipe down,
+	// so a crash report can include it
+	if (m_errRead != -1)
+		onErrorReady();
+
+	cleanup();
+	emit finished(m_exitCode, m_exitStatus);
+}
+
+bool EngineProcess::waitForFinished(int msecs)
+{
+	if (!m_started)
+		return true;
+
+	if (msecs < 0)
+	{
+		if (!reapProcess(true))
+			return false;
+	}
+	else
+	{
+		QElapsedTimer timer;
+		timer.start();
+
+		while (!reapProcess(false))
+		{
+			if (timer.hasExpired(msecs))
+				return false;
+			QThread::msleep(10);
+		}
+	}
+
+	onFinished();
+	return true;
+}
+
+bool EngineProcess::waitForStarted(int msecs)
+{
+	// Don't wait here because posix_spawn already did the waiting
+	Q_UNUSED(msecs);
+	return m_started;
+}
+
+QString EngineProcess::workingDirectory() const
+{
+	return m_workDir;
+}
+
+void EngineProcess::onOutputReady()
+{
+	char buf[0x8000];
+	bool gotData = false;
+	bool atEnd = false;
+
+	for (;;)
+	{
+		ssize_t n = ::read(m_outRead, buf, sizeof(buf));
+		if (n > 0)
+		{
+			m_readBuf.append(buf, int(n));
+			gotData = true;
+
+			// A short read means the pipe is drained; don't
+			// pay another syscall just to see EAGAIN. The
+			// notifier polls level-triggered, so anything
+			// arriving after the read fires it again.
+			if (n < ssize_t(sizeof(buf)))
+				break;
+		}
+		else if (n == 0)
+		{
+			atEnd = true;
+			break;
+		}
+		else
+		{
+			if (errno == EINTR)
+				continue;
+			break;
+		}
+	}
+
+	if (gotData)
+		emit readyRead();
+
+	if (atEnd)
+	{
+		m_outNotifier->setEnabled(false);
+		emit readChannelFinished();
+
+		// The receiver of readChannelFinished() may already have
+		// closed the device
+		if (m_started && reapProcess(false))
+			onFinished();
+	}
+}
+
+void EngineProcess::onErrorReady()
+{
+	if (m_errRead == -1)
+		return;
+
+	char buf[0x1000];
+	bool gotData = false;
+
+	for (;;)
+	{
+		ssize_t n = ::read(m_errRead, buf, sizeof(buf));
+		if (n > 0)
+		{
+			m_errBuf.append(buf, int(n));
+			gotData = true;
+
+			// Same short-read cutoff as onOutputReady()
+			if (n < ssize_t(sizeof(buf)))
+				break;
+		}
+		else if (n == 0)
+		{
+			if (m_errNotifier != nullptr)
+				m_errNotifier->setEnabled(false);
+			break;
+		}
+		else
+		{
+			if (errno == EINTR)
+				continue;
+			break;
+		}
+	}
+
+	if (gotData)
+		emit readyReadStandardError();
+}
+
+qint64 EngineProcess::readData(char* data, qint64 maxSize)
+{
+	qint64 n = qMin(maxSize, qint64(m_readBuf.size()));
+	if (n <= 0)
+		return m_started ? 0 : -1;
+
+	memcpy(data, m_readBuf.constData(), size_t(n));
+	m_readBuf.remove(0, int(n));
+	return n;
+}
+
+qint64 EngineProcess::writeData(const char* data, qint64 maxSize)
+{
+	if (!m_started)
+		return -1;
+
+	qint64 written = 0;
+	while (written < maxSize)
+	{
+		ssize_t n = ::write(m_inWrite, data + written,
+				    size_t(maxSize - written));
+		if (n == -1)
+		{
+			if (errno == EINTR)
+				continue;
+			return written > 0 ? written : -1;
+		}
+		written += n;
+	}
+
+	return written;
+}
@@ -0,0 +1,192 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ENGINEPROCESS_UNIX_H
+#define ENGINEPROCESS_UNIX_H
+
+#include <QIODevice>
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <sys/types.h>
+class QSocketNotifier;
+
+
+/*!
+ * \brief A replacement for QProcess on Unix
+ *
+ * QProcess launches children by forking the whole parent process. With
+ * a large resident parent (the GUI with game databases loaded, or a
+ * long-running tournament coordinator) duplicating the page tables adds
+ * measurable latency to every engine start. EngineProcess instead uses
+ * posix_spawn() with vfork semantics and pre-built file actions, so a
+ * launch borrows the parent's address space instead of copying it. The
+ * interface is the same as QProcess' with some unneeded features left
+ * out, mirroring the Windows implementation.
+ *
+ * \sa QProcess
+ */
+class LIB_EXPORT EngineProcess : public QIODevice
+{
+	Q_OBJECT
+
+	public:
+		/*! The process' exit status. */
+		enum ExitStatus
+		{
+			NormalExit,	//!< The process exited normally
+			CrashExit	//!< The process crashed
+		};
+
+		/*! Creates a new EngineProcess. */
+		explicit EngineProcess(QObject* parent = nullptr);
+		/*!
+		 * Destructs the EngineProcess and frees all resources.
+		 * If the process is still running, it is killed.
+		 */
+		virtual ~EngineProcess();
+
+		// Inherited from QIODevice
+		virtual qint64 bytesAvailable() const;
+		virtual bool canReadLine() const;
+		virtual void close();
+		virtual bool isSequential() const;
+
+		/*! Returns the exit code of the last process that finished. */
+		int exitCode() const;
+		/*! Returns the exit status of the last process that finished. */
+		ExitStatus exitStatus() const;
+
+		/*! Returns the process id of the running process, or 0. */
+		qint64 processId() const;
+
+		/*!
+		 * Returns the process' working directory.
+		 * Returns an empty string if the working directory wasn't
+		 * set with setWorkingDirectory().
+		 */
+		QString workingDirectory() const;
+		/*!
+		 * Sets the working directory to dir.
+		 * EngineProcess will start the process in this directory.
+		 */
+		void setWorkingDirectory(const QString& dir);
+		/*!
+		 * Redirects the process' standard error to the file fileName.
+		 * The file will be appended to if mode is Append; otherwise
+		 * it will be truncated.
+		 *
+		 * Without a redirection the standard error channel is read
+		 * into a buffer that can be emptied with
+		 * readAllStandardError().
+		 */
+		void setStandardErrorFile(const QString& fileName,
+					  OpenMode mode = Truncate);
+
+		/*!
+		 * Returns all data available on the standard error channel
+		 * and empties the buffer. Returns an empty array if the
+		 * channel was redirected to a file.
+		 */
+		QByteArray readAllStandardError();
+
+		/*!
+		 * Starts the program \a program in a new process, passing the
+		 * command line arguments in \a arguments. The OpenMode is set
+		 * to \a mode.
+		 *
+		 * \note Unlike the same function in QProcess, this one will
+		 * block until the process has started.
+		 *
+		 * \note To check if the process started successfully, call
+		 * the waitForStarted() method.
+		 */
+		void start(const QString& program,
+			   const QStringList& arguments,
+			   OpenMode mode = ReadWrite);
+		/*! Starts the program \a program with OpenMode \a mode. */
+		void start(const QString& program,
+			   OpenMode mode = ReadWrite);
+
+		/*!
+		 * Blocks until the process has finished and the finished()
+		 * signal has been emitted.
+		 *
+		 * Times out after \a msecs milliseconds. If \a msecs is -1
+		 * the function will not time out.
+		 *
+		 * \return true if the process finished.
+		 */
+		bool waitForFinished(int msecs = 30000);
+
+		/*!
+		 * Returns true if the process started successfully.
+		 * Doesn't really wait for anything since the start() method
+		 * already did the waiting.
+		 */
+		bool waitForStarted(int msecs = 30000);
+
+	public slots:
+		/*! Kills the process, causing it to exit immediately. */
+		void kill();
+
+	signals:
+		/*!
+		 * Emitted when the process finishes.
+		 * \param exitCode exit code of the process
+		 * \param exitStatus exit status of the process
+		 */
+		void finished(int exitCode, ExitStatus exitStatus);
+		/*! There's new data on the standard error channel. */
+		void readyReadStandardError();
+
+	protected:
+		// Inherited from QIODevice
+		virtual qint64 readData(char* data, qint64 maxSize);
+		virtual qint64 writeData(const char* data, qint64 maxSize);
+
+	private slots:
+		void onOutputReady();
+		void onErrorReady();
+
+	private:
+		static QStringList splitCommand(const QString& command);
+
+		void cleanup();
+		void closeFd(int* fd);
+		bool reapProcess(bool blocking);
+		void onFinished();
+
+		bool m_started;
+		bool m_finished;
+		int m_exitCode;
+		ExitStatus m_exitStatus;
+		pid_t m_pid;
+		QString m_workDir;
+		QString m_stdErrFile;
+		OpenMode m_stdErrFileMode;
+		int m_inWrite;
+		int m_outRead;
+		int m_errRead;
+		QSocketNotifier* m_outNotifier;
+		QSocketNotifier* m_errNotifier;
+		QByteArray m_readBuf;
+		QByteArray m_errBuf;
+};
+
+#endif // ENGINEPROCESS_UNIX_H
@@ -299,12 +299,16 @@ void EngineProcess::start(const QString& program,
 	ZeroMemory(&m_processInfo, sizeof(m_processInfo));
 
 #ifdef UNICODE
+	// The process is created suspended so that it can be placed in
+	// the job object before it executes anything; otherwise a child
+	// that crashes or spawns helpers right away could escape the job
 	ok = CreateProcessW(NULL,
 			    (WCHAR*)cmd.utf16(),
 			    NULL,	// process attributes
 			    NULL,	// thread attributes
 			    TRUE,	// inherit handles
-			    CREATE_NEW_PROCESS_GROUP | CREATE_NO_WINDOW, // creation flags
+			    CREATE_NEW_PROCESS_GROUP | CREATE_NO_WINDOW
+			    | CREATE_SUSPENDED, // creation flags
 			    NULL,	// environment
 			    wdir.isEmpty() ? NULL : (WCHAR*)wdir.utf16(),
 			    &startupInfo,
@@ -315,7 +319,8 @@ void EngineProcess::start(const QString& program,
 			    NULL,	// process attributes
 			    NULL,	// thread attributes
 			    TRUE,	// inherit handles
-			    CREATE_NEW_PROCESS_GROUP | CREATE_NO_WINDOW, // creation flags
+			    CREATE_NEW_PROCESS_GROUP | CREATE_NO_WINDOW
+			    | CREATE_SUSPENDED, // creation flags
 			    NULL,	// environment
 			    wdir.isEmpty() ? NULL : wdir.toLocal8Bit().data(),
 			    &startupInfo,
@@ -328,6 +333,7 @@ void EngineProcess::start(const QString& program,
 		// Assign the engine process to the main job to make sure it's
 		// terminated when CuteChess terminates.
 		AssignProcessToJobObject(mainJob(), m_processInfo.hProcess);
+		ResumeThread(m_processInfo.hThread);
 
 		// Close the child process' ends of the pipes to make sure
 		// that ReadFile and WriteFile will return when the child
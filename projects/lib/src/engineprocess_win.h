@@ -34,7 +34,8 @@ class PipeReader;
  * new data immediately (no polling) when it's available. The interface is
  * the same as QProcess' with some unneeded features left out.
  *
- * On non-Windows platforms EngineProcess is just a typedef to QProcess.
+ * On Unix platforms a posix_spawn() based implementation with the same
+ * interface is used instead.
  *
  * \sa QProcess
  * \sa PipeReader
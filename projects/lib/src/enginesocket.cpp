@@ -0,0 +1,89 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "enginesocket.h"
+#include <QThread>
+
+
+EngineSocket::EngineSocket(const QString& host,
+			   quint16 port,
+			   QObject* parent)
+	: QTcpSocket(parent),
+	  m_host(host),
+	  m_port(port),
+	  m_latency(-1)
+{
+	connect(this, SIGNAL(connected()), this, SLOT(onConnected()));
+	connect(this, SIGNAL(disconnected()), this, SLOT(onDisconnected()));
+}
+
+void EngineSocket::start()
+{
+	m_connectTimer.start();
+	connectToHost(m_host, m_port);
+}
+
+bool EngineSocket::waitForStarted(int timeout)
+{
+	QElapsedTimer deadline;
+	deadline.start();
+
+	forever
+	{
+		if (state() == UnconnectedState)
+		{
+			m_connectTimer.start();
+			connectToHost(m_host, m_port);
+		}
+
+		int left = timeout - int(deadline.elapsed());
+		if (left <= 0)
+			return false;
+		if (waitForConnected(qMin(left, 1000)))
+			return true;
+
+		// A refused or timed-out attempt is retried until the
+		// timeout expires; the remote wrapper may still be
+		// spawning the engine
+		abort();
+		QThread::msleep(250);
+	}
+}
+
+int EngineSocket::latency() const
+{
+	return m_latency;
+}
+
+void EngineSocket::onConnected()
+{
+	m_latency = int(m_connectTimer.elapsed());
+
+	// Engine commands are small and latency-bound, so they must
+	// not sit in the kernel waiting for a full segment
+	setSocketOption(QAbstractSocket::LowDelayOption, 1);
+}
+
+void EngineSocket::onDisconnected()
+{
+	// ChessEngine treats a finished read channel as a crash, which
+	// is what a dropped connection is from the game's point of
+	// view. A duplicate emission is harmless: the first one makes
+	// the engine disconnect from this device.
+	emit readChannelFinished();
+}
@@ -0,0 +1,85 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ENGINESOCKET_H
+#define ENGINESOCKET_H
+
+#include <QTcpSocket>
+#include <QElapsedTimer>
+
+
+/*!
+ * \brief A TCP connection to a remote chess engine
+ *
+ * EngineSocket takes the place of EngineProcess for engines that run
+ * on another machine behind a plain TCP endpoint, eg. a GPU box that
+ * exposes the engine's standard I/O on a port. The socket is a normal
+ * QIODevice, so ChessEngine reads and writes the chess protocol over
+ * it exactly as it would over local process pipes, and GameManager
+ * schedules remote engines like any others.
+ *
+ * A failed connection attempt is retried until waitForStarted() times
+ * out, as the remote wrapper may still be spawning the engine. Once a
+ * game is running a dropped connection can't be resumed - the remote
+ * engine's state is gone - so it surfaces as a crash through the
+ * readChannelFinished() path, and reconnecting happens by building
+ * the player again.
+ *
+ * \sa EngineBuilder, EngineConfiguration::isRemote()
+ */
+class LIB_EXPORT EngineSocket : public QTcpSocket
+{
+	Q_OBJECT
+
+	public:
+		/*! Creates a new EngineSocket for \a host and \a port. */
+		EngineSocket(const QString& host,
+			     quint16 port,
+			     QObject* parent = nullptr);
+
+		/*! Starts connecting to the remote engine. */
+		void start();
+		/*!
+		 * Waits until the connection is established, retrying
+		 * failed attempts, for at most \a timeout milliseconds.
+		 *
+		 * Returns true if the connection was established;
+		 * otherwise returns false.
+		 */
+		bool waitForStarted(int timeout = 10000);
+		/*!
+		 * Returns the time the connection handshake took in
+		 * milliseconds, or -1 if the socket never connected.
+		 *
+		 * The handshake time estimates the per-move latency the
+		 * endpoint adds on top of the engine's own thinking.
+		 */
+		int latency() const;
+
+	private slots:
+		void onConnected();
+		void onDisconnected();
+
+	private:
+		QString m_host;
+		quint16 m_port;
+		QElapsedTimer m_connectTimer;
+		int m_latency;
+};
+
+#endif // ENGINESOCKET_H
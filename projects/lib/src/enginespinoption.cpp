@@ -19,12 +19,12 @@
 #include "enginespinoption.h"
 
 EngineSpinOption::EngineSpinOption(const QString& name,
-                                   const QVariant& value,
-                                   const QVariant& defaultValue,
+                                   const EngineOptionValue& value,
+                                   const EngineOptionValue& defaultValue,
                                    int min,
                                    int max,
                                    const QString& alias)
-	: EngineOption(name, QVariant::Int, value, defaultValue, alias),
+	: EngineOption(name, EngineOptionValue::Int, value, defaultValue, alias),
 	  m_min(min),
 	  m_max(max)
 {
@@ -35,7 +35,7 @@ EngineOption* EngineSpinOption::copy() const
 	return new EngineSpinOption(*this);
 }
 
-bool EngineSpinOption::isValid(const QVariant& value) const
+bool EngineSpinOption::isValid(const EngineOptionValue& value) const
 {
 	if (m_min > m_max)
 		return false;
@@ -76,8 +76,8 @@ QVariant EngineSpinOption::toVariant() const
 	map.insert("type", "spin");
 
 	map.insert("name", name());
-	map.insert("value", value());
-	map.insert("default", defaultValue());
+	map.insert("value", value().toVariant());
+	map.insert("default", defaultValue().toVariant());
 	map.insert("alias", alias());
 
 	map.insert("min", min());
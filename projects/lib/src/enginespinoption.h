@@ -25,15 +25,15 @@ class LIB_EXPORT EngineSpinOption : public EngineOption
 {
 	public:
 		EngineSpinOption(const QString& name,
-		                 const QVariant& value = QVariant(),
-		                 const QVariant& defaultValue = QVariant(),
+		                 const EngineOptionValue& value = EngineOptionValue(),
+		                 const EngineOptionValue& defaultValue = EngineOptionValue(),
 		                 int min = 0,
 		                 int max = 0,
 		                 const QString& alias = QString());
 
 		// Inherited from EngineOption
 		virtual EngineOption* copy() const;
-		virtual bool isValid(const QVariant& value) const;
+		virtual bool isValid(const EngineOptionValue& value) const;
 		virtual QVariant toVariant() const;
 
 		int min() const;
@@ -19,11 +19,11 @@
 #include "enginetextoption.h"
 
 EngineTextOption::EngineTextOption(const QString& name,
-                                   const QVariant& value,
-                                   const QVariant& defaultValue,
+                                   const EngineOptionValue& value,
+                                   const EngineOptionValue& defaultValue,
 				   const QString& alias,
 				   EditorType editorType)
-	: EngineOption(name, QVariant::String, value, defaultValue, alias),
+	: EngineOption(name, EngineOptionValue::String, value, defaultValue, alias),
 	  m_editorType(editorType)
 {
 }
@@ -33,9 +33,9 @@ EngineOption* EngineTextOption::copy() const
 	return new EngineTextOption(*this);
 }
 
-bool EngineTextOption::isValid(const QVariant& value) const
+bool EngineTextOption::isValid(const EngineOptionValue& value) const
 {
-	return value.canConvert(QVariant::String);
+	return !value.isNull();
 }
 
 QVariant EngineTextOption::toVariant() const
@@ -56,8 +56,8 @@ QVariant EngineTextOption::toVariant() const
 	}
 
 	map.insert("name", name());
-	map.insert("value", value());
-	map.insert("default", defaultValue());
+	map.insert("value", value().toVariant());
+	map.insert("default", defaultValue().toVariant());
 	map.insert("alias", alias());
 
 	return map;
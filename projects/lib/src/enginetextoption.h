@@ -32,14 +32,14 @@ class LIB_EXPORT EngineTextOption : public EngineOption
 		};
 
 		EngineTextOption(const QString& name,
-		                 const QVariant& value = QVariant(),
-		                 const QVariant& defaultValue = QVariant(),
+		                 const EngineOptionValue& value = EngineOptionValue(),
+		                 const EngineOptionValue& defaultValue = EngineOptionValue(),
 				 const QString& alias = QString(),
 				 EditorType editorType = LineEdit);
 
 		// Inherited from EngineOption
 		virtual EngineOption* copy() const;
-		virtual bool isValid(const QVariant& value) const;
+		virtual bool isValid(const EngineOptionValue& value) const;
 		virtual QVariant toVariant() const;
 
 	private:
@@ -0,0 +1,99 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "eventstream.h"
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+
+EventStream::EventStream(const QString& fileName, QObject* parent)
+	: QThread(parent),
+	  m_file(fileName),
+	  m_quit(false)
+{
+	if (!m_file.open(QIODevice::WriteOnly | QIODevice::Append))
+	{
+		qWarning("Cannot open event stream file: %s",
+			 qUtf8Printable(fileName));
+		return;
+	}
+
+	start();
+}
+
+EventStream::~EventStream()
+{
+	stop();
+}
+
+bool EventStream::isOpen() const
+{
+	return m_file.isOpen();
+}
+
+void EventStream::post(const QVariantMap& event)
+{
+	if (!isOpen())
+		return;
+
+	QJsonObject obj(QJsonObject::fromVariantMap(event));
+	obj.insert("ts", QDateTime::currentMSecsSinceEpoch());
+
+	// The bundled JsonSerializer pretty-prints; the stream needs
+	// one object per line, so use Qt's compact writer
+	QByteArray line = QJsonDocument(obj).toJson(QJsonDocument::Compact);
+	line += '\n';
+
+	QMutexLocker locker(&m_mutex);
+	m_queue.append(line);
+	m_cond.wakeOne();
+}
+
+void EventStream::stop()
+{
+	if (!isRunning())
+		return;
+
+	m_mutex.lock();
+	m_quit = true;
+	m_cond.wakeOne();
+	m_mutex.unlock();
+	wait();
+}
+
+void EventStream::run()
+{
+	QMutexLocker locker(&m_mutex);
+	for (;;)
+	{
+		while (m_queue.isEmpty() && !m_quit)
+			m_cond.wait(&m_mutex);
+		if (m_queue.isEmpty())
+			return;
+
+		const auto batch = m_queue;
+		m_queue.clear();
+
+		locker.unlock();
+		for (const QByteArray& line : batch)
+			m_file.write(line);
+		m_file.flush();
+		locker.relock();
+	}
+}
@@ -0,0 +1,79 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef EVENTSTREAM_H
+#define EVENTSTREAM_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QFile>
+#include <QList>
+#include <QVariantMap>
+
+/*!
+ * \brief An append-only newline-delimited JSON event stream.
+ *
+ * Events are posted as variant maps, serialized to one compact JSON
+ * object per line and appended to the output file by a dedicated
+ * writer thread, so a slow disk or a blocked consumer can't stall
+ * the thread that runs the tournament. Consumers can simply tail
+ * the file; lines are complete and are never rewritten.
+ *
+ * \sa Tournament::setEventStreamOutput()
+ */
+class LIB_EXPORT EventStream : public QThread
+{
+	Q_OBJECT
+
+	public:
+		/*!
+		 * Creates a new event stream that appends to
+		 * \a fileName and starts the writer thread.
+		 */
+		explicit EventStream(const QString& fileName,
+				     QObject* parent = nullptr);
+		virtual ~EventStream();
+
+		/*! Returns true if the output file could be opened. */
+		bool isOpen() const;
+
+		/*!
+		 * Queues \a event for writing.
+		 *
+		 * A millisecond Unix timestamp is added under the key
+		 * "ts". This function returns immediately; the actual
+		 * write happens on the writer thread.
+		 */
+		void post(const QVariantMap& event);
+
+		/*! Drains the queue and terminates the writer thread. */
+		void stop();
+
+	protected:
+		virtual void run();
+
+	private:
+		QFile m_file;
+		QMutex m_mutex;
+		QWaitCondition m_cond;
+		QList<QByteArray> m_queue;
+		bool m_quit;
+};
+
+#endif // EVENTSTREAM_H
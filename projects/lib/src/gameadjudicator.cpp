@@ -130,7 +130,7 @@ void GameAdjudicator::addEval(const Chess::Board* board, const MoveEvaluation& e
 			&&  m_drawScoreCount >= m_drawMoveCount * 2)
 			{
 				m_result = Chess::Result(Chess::Result::Adjudication,
-							Chess::Side::NoSide, "TCEC draw rule");
+							Chess::Side::NoSide, QStringLiteral("TCEC draw rule"));
 				return;
 			}
 		}
@@ -156,12 +156,12 @@ void GameAdjudicator::addEval(const Chess::Board* board, const MoveEvaluation& e
             if (loserCount >= m_resignMoveCount
             				&& m_resignWinnerScoreCount[side.opposite()] >= m_resignMoveCount) {
             	m_result = Chess::Result(Chess::Result::Adjudication,
-										 side.opposite(), "TCEC win rule");
+										 side.opposite(), QStringLiteral("TCEC win rule"));
             	return;
             } else if (winnerCount >= m_resignMoveCount
             				&& m_resignScoreCount[side.opposite()] >= m_resignMoveCount) {
             	m_result = Chess::Result(Chess::Result::Adjudication,
-										 side, "TCEC win rule");
+										 side, QStringLiteral("TCEC win rule"));
             	return;
             }
 		}
@@ -175,7 +175,7 @@ void GameAdjudicator::addEval(const Chess::Board* board, const MoveEvaluation& e
 
 			if (count >= m_resignMoveCount) {
 				m_result = Chess::Result(Chess::Result::Adjudication,
-							 side.opposite(), "TCEC resign rule");
+							 side.opposite(), QStringLiteral("TCEC resign rule"));
 				return;
 			}
 		}
@@ -186,7 +186,7 @@ void GameAdjudicator::addEval(const Chess::Board* board, const MoveEvaluation& e
 	&&  board->plyCount() >= 2 * m_maxGameLength)
 	{
 		m_result = Chess::Result(Chess::Result::Adjudication, Chess::Side::NoSide,
-								 "TCEC max moves rule");
+								 QStringLiteral("TCEC max moves rule"));
 		return;
 	}
 }
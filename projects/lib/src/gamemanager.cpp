@@ -19,9 +19,12 @@
 #include "gamemanager.h"
 #include <QThread>
 #include <algorithm>
+#include <limits>
 #include "playerbuilder.h"
 #include "chessgame.h"
 #include "chessplayer.h"
+#include "timecontrol.h"
+#include "metrics.h"
 
 class GameInitializer : public QObject
 {
@@ -35,10 +38,13 @@ class GameInitializer : public QObject
 		const PlayerBuilder* whiteBuilder() const;
 		const PlayerBuilder* blackBuilder() const;
 		void swapPlayers();
+		void setBuilders(const PlayerBuilder* white,
+				 const PlayerBuilder* black);
 		void setGame(ChessGame* game);
 
 	public slots:
 		void initializeGame();
+		void warmUp();
 		void finish();
 
 	signals:
@@ -47,6 +53,7 @@ class GameInitializer : public QObject
 
 	private slots:
 		void onPlayerQuit();
+		void onPlayerCrashed(Chess::Side side);
 
 	private:
 		void deletePlayer(int index);
@@ -101,9 +108,46 @@ void GameInitializer::swapPlayers()
 	std::swap(m_player[0], m_player[1]);
 }
 
+void GameInitializer::setBuilders(const PlayerBuilder* white,
+				  const PlayerBuilder* black)
+{
+	// Align a shared builder with the side where its player
+	// already lives
+	if (white == m_builder[Chess::Side::Black]
+	||  black == m_builder[Chess::Side::White])
+		swapPlayers();
+
+	const PlayerBuilder* builders[] = { white, black };
+	for (int i = 0; i < 2; i++)
+	{
+		if (m_builder[i] == builders[i])
+			continue;
+
+		// Release the player whose builder changed; the other
+		// player stays alive for the next game.
+		ChessPlayer* player = m_player[i];
+		if (player != nullptr)
+		{
+			m_player[i] = nullptr;
+			if (player->state() == ChessPlayer::Disconnected)
+				player->deleteLater();
+			else
+			{
+				connect(player, SIGNAL(disconnected()),
+					player, SLOT(deleteLater()));
+				QMetaObject::invokeMethod(player, "quit",
+							  Qt::QueuedConnection);
+			}
+		}
+		m_builder[i] = builders[i];
+	}
+}
+
 void GameInitializer::setGame(ChessGame* game)
 {
 	m_game = game;
+	connect(game, SIGNAL(playerCrashed(Chess::Side)),
+		this, SLOT(onPlayerCrashed(Chess::Side)));
 }
 
 void GameInitializer::deletePlayer(int index)
@@ -159,6 +203,31 @@ void GameInitializer::initializeGame()
 	emit gameInitialized(true);
 }
 
+void GameInitializer::warmUp()
+{
+	if (m_finishing)
+		return;
+
+	// Create any missing players ahead of time so that the next
+	// game can start without waiting for engine initialization.
+	m_playerCount = 0;
+	for (int i = 0; i < 2; i++)
+	{
+		if (m_player[i] == nullptr)
+		{
+			QString error;
+			m_player[i] = m_builder[i]->create(thread()->parent(),
+							   SIGNAL(debugMessage(QString)),
+							   this, &error);
+			// A failure isn't fatal here; initializeGame()
+			// will retry and report the error when the game
+			// actually starts.
+		}
+		if (m_player[i] != nullptr)
+			m_playerCount++;
+	}
+}
+
 void GameInitializer::finish()
 {
 	if (m_finishing)
@@ -189,6 +258,31 @@ void GameInitializer::onPlayerQuit()
 		emit finished();
 }
 
+void GameInitializer::onPlayerCrashed(Chess::Side side)
+{
+	if (m_finishing)
+	{
+		m_game->replacePlayer(side, nullptr);
+		return;
+	}
+
+	// Rebuild the crashed player from its builder; the game then
+	// replays the move history to the new engine and continues
+	deletePlayer(side);
+
+	QString error;
+	m_player[side] = m_builder[side]->create(thread()->parent(),
+						 SIGNAL(debugMessage(QString)),
+						 this, &error);
+	if (m_player[side] == nullptr)
+	{
+		m_game->setError(error);
+		m_playerCount--;
+	}
+
+	m_game->replacePlayer(side, m_player[side]);
+}
+
 
 class GameThread : public QThread
 {
@@ -202,6 +296,7 @@ class GameThread : public QThread
 
 		bool isReady() const;
 		void newGame(ChessGame* game);
+		void warmUp();
 		void finish();
 		void finishAndDelete();
 
@@ -271,6 +366,15 @@ void GameThread::newGame(ChessGame* game)
 				  Qt::QueuedConnection);
 }
 
+void GameThread::warmUp()
+{
+	if (m_initializer == nullptr || !m_ready)
+		return;
+
+	QMetaObject::invokeMethod(m_initializer, "warmUp",
+				  Qt::QueuedConnection);
+}
+
 void GameThread::finish()
 {
 	if (m_initializer == nullptr)
@@ -330,10 +434,42 @@ void GameThread::onGameDestroyed()
 }
 
 
+/*
+ * Estimates the wall time of a game in milliseconds from its time
+ * controls, assuming an average game length of 60 full moves.
+ */
+static qint64 estimatedGameDuration(const ChessGame* game)
+{
+	const int expectedMoves = 60;
+	qint64 total = 0;
+
+	for (int i = 0; i < 2; i++)
+	{
+		const TimeControl* tc = game->timeControl(Chess::Side::Type(i));
+		if (!tc->isValid() || tc->isInfinite())
+			return std::numeric_limits<qint64>::max();
+
+		if (tc->timePerMove() != 0)
+			total += qint64(tc->timePerMove()) * expectedMoves;
+		else
+		{
+			qint64 time = tc->timePerTc();
+			if (tc->movesPerTc() > 0)
+				time = time * expectedMoves / tc->movesPerTc();
+			total += time
+			      +  qint64(tc->timeIncrement()) * expectedMoves;
+		}
+	}
+
+	return total;
+}
+
 GameManager::GameManager(QObject* parent)
 	: QObject(parent),
 	  m_finishing(false),
 	  m_concurrency(1),
+	  m_maxCpuCores(0),
+	  m_activeCpuCores(0),
 	  m_activeQueuedGameCount(0)
 {
 }
@@ -353,6 +489,25 @@ void GameManager::setConcurrency(int concurrency)
 	m_concurrency = concurrency;
 }
 
+int GameManager::maxCpuCores() const
+{
+	return m_maxCpuCores;
+}
+
+void GameManager::setMaxCpuCores(int cores)
+{
+	m_maxCpuCores = cores;
+}
+
+int GameManager::cpuCoreCount(const PlayerBuilder* white,
+			      const PlayerBuilder* black)
+{
+	Q_ASSERT(white != nullptr);
+	Q_ASSERT(black != nullptr);
+
+	return white->cpuCoreCount() + black->cpuCoreCount();
+}
+
 void GameManager::cleanupIdleThreads()
 {
 	QList<GameThread*>::iterator it = m_activeThreads.begin();
@@ -371,6 +526,29 @@ void GameManager::cleanupIdleThreads()
 	}
 }
 
+void GameManager::trimIdleThreads()
+{
+	// Park up to m_concurrency idle threads for later games and
+	// tear down only the excess ones. Keeping the threads (and
+	// their players) alive lets bursts of short games run without
+	// paying for thread and engine restarts.
+	int idleCount = 0;
+	QList<GameThread*>::iterator it = m_activeThreads.begin();
+	while (it != m_activeThreads.end())
+	{
+		GameThread* thread = *it;
+		Q_ASSERT(thread != nullptr);
+
+		if (thread->isReady() && ++idleCount > m_concurrency)
+		{
+			it = m_activeThreads.erase(it);
+			thread->finishAndDelete();
+		}
+		else
+			++it;
+	}
+}
+
 void GameManager::cleanup()
 {
 	m_finishing = false;
@@ -402,6 +580,7 @@ void GameManager::cleanup()
 
 void GameManager::finish()
 {
+	Metrics::add(Metrics::GamesQueued, -m_gameEntries.size());
 	m_gameEntries.clear();
 	if (m_activeGames.isEmpty())
 		cleanup();
@@ -431,6 +610,7 @@ void GameManager::newGame(ChessGame* game,
 	}
 
 	m_gameEntries << entry;
+	Metrics::add(Metrics::GamesQueued);
 	startQueuedGame();
 }
 
@@ -457,6 +637,16 @@ void GameManager::onThreadReady()
 
 	m_activeGames.removeOne(game);
 	m_threads.removeAll(nullptr);
+	Metrics::add(Metrics::GamesFinished);
+
+	// Release the thread's share of the core budget before the
+	// cleanup below can detach its initializer
+	if (thread->startMode() == Enqueue)
+	{
+		m_activeQueuedGameCount--;
+		m_activeCpuCores -= cpuCoreCount(thread->initializer()->whiteBuilder(),
+						 thread->initializer()->blackBuilder());
+	}
 
 	if (thread->cleanupMode() == DeletePlayers)
 	{
@@ -465,10 +655,7 @@ void GameManager::onThreadReady()
 	}
 
 	if (thread->startMode() == Enqueue)
-	{
-		m_activeQueuedGameCount--;
 		startQueuedGame();
-	}
 
 	emit gameDestroyed(game);
 	if (m_finishing && m_activeGames.isEmpty())
@@ -484,7 +671,11 @@ void GameManager::onGameInitialized(bool success)
 	if (!success)
 	{
 		if (gameThread->startMode() == Enqueue)
+		{
 			m_activeQueuedGameCount--;
+			m_activeCpuCores -= cpuCoreCount(gameThread->initializer()->whiteBuilder(),
+							 gameThread->initializer()->blackBuilder());
+		}
 
 		m_threads.removeOne(gameThread);
 		m_activeThreads.removeOne(gameThread);
@@ -498,7 +689,7 @@ void GameManager::onGameInitialized(bool success)
 
 	m_activeGames << game;
 	if (gameThread->startMode() == Enqueue)
-		cleanupIdleThreads();
+		trimIdleThreads();
 
 	game->moveToThread(gameThread);
 	connect(game, SIGNAL(started(ChessGame*)),
@@ -510,7 +701,8 @@ void GameManager::onGameInitialized(bool success)
 }
 
 GameThread* GameManager::getThread(const PlayerBuilder* white,
-				   const PlayerBuilder* black)
+				   const PlayerBuilder* black,
+				   CleanupMode cleanupMode)
 {
 	Q_ASSERT(white != nullptr);
 	Q_ASSERT(black != nullptr);
@@ -528,6 +720,45 @@ GameThread* GameManager::getThread(const PlayerBuilder* white,
 			return thread;
 	}
 
+	if (cleanupMode == ReusePlayers)
+	{
+		// No idle thread has this exact pairing. Reuse a thread
+		// that shares one of the players so only the other
+		// engine has to be restarted. This matters for engines
+		// with long initialization times in gauntlet-style
+		// tournaments where one player is in every pairing.
+		for (GameThread* thread : qAsConst(m_activeThreads))
+		{
+			if (!thread->isReady()
+			||  thread->cleanupMode() != ReusePlayers)
+				continue;
+
+			GameInitializer* tmp = thread->initializer();
+			const PlayerBuilder* w = tmp->whiteBuilder();
+			const PlayerBuilder* b = tmp->blackBuilder();
+			if (w == white || w == black
+			||  b == white || b == black)
+			{
+				tmp->setBuilders(white, black);
+				return thread;
+			}
+		}
+
+		// Failing that, rebind any parked thread. Both engines
+		// have to be restarted, but the thread itself (and its
+		// event loop) is reused instead of being torn down and
+		// started from scratch.
+		for (GameThread* thread : qAsConst(m_activeThreads))
+		{
+			if (!thread->isReady()
+			||  thread->cleanupMode() != ReusePlayers)
+				continue;
+
+			thread->initializer()->setBuilders(white, black);
+			return thread;
+		}
+	}
+
 	GameThread* gameThread = new GameThread(white, black, this);
 	m_threads << gameThread;
 	m_activeThreads << gameThread;
@@ -543,26 +774,149 @@ GameThread* GameManager::getThread(const PlayerBuilder* white,
 
 void GameManager::startGame(const GameEntry& entry)
 {
-	GameThread* gameThread = getThread(entry.white, entry.black);
+	GameThread* gameThread = getThread(entry.white,
+					   entry.black,
+					   entry.cleanupMode);
 	Q_ASSERT(gameThread != nullptr);
 
 	gameThread->setStartMode(entry.startMode);
 	gameThread->setCleanupMode(entry.cleanupMode);
 	gameThread->newGame(entry.game);
+	Metrics::add(Metrics::GamesStarted);
+}
+
+bool GameManager::hasWarmThread(const GameEntry& entry) const
+{
+	for (GameThread* thread : m_activeThreads)
+	{
+		if (!thread->isReady())
+			continue;
+
+		GameInitializer* tmp = thread->initializer();
+		const PlayerBuilder* w = tmp->whiteBuilder();
+		const PlayerBuilder* b = tmp->blackBuilder();
+		if ((w == entry.white && b == entry.black)
+		||  (w == entry.black && b == entry.white))
+			return true;
+	}
+
+	return false;
+}
+
+bool GameManager::pairIsPlaying(const GameEntry& entry) const
+{
+	for (GameThread* thread : m_activeThreads)
+	{
+		if (thread->isReady())
+			continue;
+
+		GameInitializer* tmp = thread->initializer();
+		if (tmp == nullptr)
+			continue;
+		const PlayerBuilder* w = tmp->whiteBuilder();
+		const PlayerBuilder* b = tmp->blackBuilder();
+		if ((w == entry.white && b == entry.black)
+		||  (w == entry.black && b == entry.white))
+			return true;
+	}
+
+	return false;
+}
+
+int GameManager::bestQueuedGameIndex() const
+{
+	if (m_gameEntries.isEmpty())
+		return -1;
+
+	// Affinity score of a queued game: players already idling in a
+	// slot (2) beats neutral (1) beats a pair whose previous game is
+	// still running in some slot (0). The last kind is best left in
+	// the queue: its own slot frees shortly and can host the reverse
+	// game with both engine processes still warm, whereas starting
+	// it on a foreign slot restarts both engines. Among equals the
+	// longest expected game goes first so that a slow game doesn't
+	// end up running alone at the tail of the tournament.
+	auto affinity = [this](const GameEntry& entry)
+	{
+		if (hasWarmThread(entry))
+			return 2;
+		if (pairIsPlaying(entry))
+			return 0;
+		return 1;
+	};
+
+	int best = 0;
+	int bestAffinity = affinity(m_gameEntries.first());
+	qint64 bestTime = estimatedGameDuration(m_gameEntries.first().game);
+
+	for (int i = 1; i < m_gameEntries.size(); i++)
+	{
+		const GameEntry& entry = m_gameEntries.at(i);
+		int entryAffinity = affinity(entry);
+		qint64 time = estimatedGameDuration(entry.game);
+
+		if (entryAffinity > bestAffinity
+		||  (entryAffinity == bestAffinity && time > bestTime))
+		{
+			best = i;
+			bestAffinity = entryAffinity;
+			bestTime = time;
+		}
+	}
+
+	return best;
 }
 
 void GameManager::startQueuedGame()
 {
 	if (m_activeQueuedGameCount >= m_concurrency)
+	{
+		warmUpQueuedGame();
 		return;
+	}
 	if (m_gameEntries.isEmpty())
 	{
 		emit ready();
 		return;
 	}
 
+	const int index = bestQueuedGameIndex();
+	const int cores = cpuCoreCount(m_gameEntries.at(index).white,
+				       m_gameEntries.at(index).black);
+
+	// Admit the game only if its players' cores fit in the budget;
+	// the first game is exempt so that one oversized game can't
+	// stall the queue
+	if (m_maxCpuCores > 0
+	&&  m_activeQueuedGameCount > 0
+	&&  m_activeCpuCores + cores > m_maxCpuCores)
+	{
+		warmUpQueuedGame();
+		return;
+	}
+
 	m_activeQueuedGameCount++;
-	startGame(m_gameEntries.takeFirst());
+	m_activeCpuCores += cores;
+	Metrics::add(Metrics::GamesQueued, -1);
+	startGame(m_gameEntries.takeAt(index));
+}
+
+void GameManager::warmUpQueuedGame()
+{
+	if (m_finishing || m_gameEntries.isEmpty())
+		return;
+
+	// Spawn the next queued game's engines while the current
+	// games are still running, so that the slot handover doesn't
+	// have to wait for engine initialization.
+	const GameEntry& entry = m_gameEntries.at(bestQueuedGameIndex());
+	if (entry.cleanupMode != ReusePlayers)
+		return;
+
+	GameThread* gameThread = getThread(entry.white,
+					   entry.black,
+					   entry.cleanupMode);
+	gameThread->warmUp();
 }
 
 #include "gamemanager.moc"
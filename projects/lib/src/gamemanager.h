@@ -50,6 +50,10 @@ class LIB_EXPORT GameManager : public QObject
 			/*!
 			 * The game is added to a queue, and is started when
 			 * a game slot becomes free. This could be immediately.
+			 *
+			 * Queued games aren't necessarily started in
+			 * insertion order: when a slot frees up, the
+			 * manager picks the game that best fits it.
 			 */
 			Enqueue
 		};
@@ -64,7 +68,10 @@ class LIB_EXPORT GameManager : public QObject
 			/*!
 			 * The players are left alive after the game is deleted.
 			 * If a new game with the same builder objects is started,
-			 * the players are reused for that game.
+			 * the players are reused for that game. If a new game
+			 * shares only one builder with an idle game slot, the
+			 * shared player is kept and only the other player is
+			 * restarted.
 			 */
 			ReusePlayers
 		};
@@ -98,6 +105,30 @@ class LIB_EXPORT GameManager : public QObject
 		 */
 		void setConcurrency(int concurrency);
 
+		/*!
+		 * Returns the CPU core budget for concurrent games,
+		 * or 0 if the budget is disabled.
+		 *
+		 * \sa setMaxCpuCores()
+		 */
+		int maxCpuCores() const;
+		/*!
+		 * Sets the CPU core budget to \a cores (0 disables the
+		 * budget, which is the default).
+		 *
+		 * When a budget is set, a queued game is only started if
+		 * the cores its players are configured to use - their
+		 * "Threads" or "cores" engine option - fit in the budget
+		 * next to the games already running. This keeps a mixed
+		 * field of single- and multi-threaded engines from
+		 * oversubscribing the machine, which would pollute the
+		 * move-time measurements. The first game is always
+		 * admitted so that an oversized game cannot stall the
+		 * queue. Like the concurrency limit, the budget only
+		 * affects games started in Enqueue mode.
+		 */
+		void setMaxCpuCores(int cores);
+
 		/*!
 		 * Cleans up and deletes all idle game threads
 		 *
@@ -111,6 +142,17 @@ class LIB_EXPORT GameManager : public QObject
 		 */
 		void cleanupIdleThreads();
 
+		/*!
+		 * Tears down idle game threads in excess of the
+		 * concurrency limit.
+		 *
+		 * Unlike cleanupIdleThreads(), up to concurrency()
+		 * idle threads are kept parked with their players
+		 * alive, ready to take the next game without paying
+		 * for thread and engine startup.
+		 */
+		void trimIdleThreads();
+
 		/*!
 		 * Adds a new game to the game manager.
 		 *
@@ -199,13 +241,24 @@ class LIB_EXPORT GameManager : public QObject
 		};
 
 		GameThread* getThread(const PlayerBuilder* white,
-				      const PlayerBuilder* black);
+				      const PlayerBuilder* black,
+				      CleanupMode cleanupMode);
+		bool hasWarmThread(const GameEntry& entry) const;
+		// Returns true if the entry's players are currently playing
+		// each other on some busy thread
+		bool pairIsPlaying(const GameEntry& entry) const;
+		int bestQueuedGameIndex() const;
+		static int cpuCoreCount(const PlayerBuilder* white,
+					const PlayerBuilder* black);
 		void startGame(const GameEntry& entry);
 		void startQueuedGame();
+		void warmUpQueuedGame();
 		void cleanup();
 
 		bool m_finishing;
 		int m_concurrency;
+		int m_maxCpuCores;
+		int m_activeCpuCores;
 		int m_activeQueuedGameCount;
 		QList< QPointer<GameThread> > m_threads;
 		QList<GameThread*> m_activeThreads;
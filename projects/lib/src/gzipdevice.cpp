@@ -0,0 +1,235 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gzipdevice.h"
+#include <cstring>
+#include <zlib.h>
+
+namespace {
+
+// Size of the scratch buffer for compressed data
+const int bufferSize = 1 << 16;
+
+// Window bits for the gzip format; the extra flag makes zlib
+// auto-detect gzip and zlib headers when inflating.
+const int gzipWindowBits = 15 + 16;
+const int autoWindowBits = 15 + 32;
+
+} // anonymous namespace
+
+GzipDevice::GzipDevice(QIODevice* device, QObject* parent)
+	: QIODevice(parent),
+	  m_device(device),
+	  m_zstream(nullptr),
+	  m_endOfStream(false)
+{
+	Q_ASSERT(device != nullptr);
+}
+
+GzipDevice::~GzipDevice()
+{
+	GzipDevice::close();
+}
+
+bool GzipDevice::open(OpenMode mode)
+{
+	if (isOpen())
+		return false;
+
+	OpenMode baseMode = mode & ~OpenMode(Text | Append);
+	if (baseMode != ReadOnly && baseMode != WriteOnly)
+		return false;
+	if (m_device == nullptr || !m_device->isOpen())
+		return false;
+
+	m_zstream = new z_stream_s;
+	memset(m_zstream, 0, sizeof(*m_zstream));
+
+	int ret;
+	if (baseMode == ReadOnly)
+		ret = inflateInit2(m_zstream, autoWindowBits);
+	else
+		ret = deflateInit2(m_zstream, Z_DEFAULT_COMPRESSION,
+				   Z_DEFLATED, gzipWindowBits, 8,
+				   Z_DEFAULT_STRATEGY);
+	if (ret != Z_OK)
+	{
+		delete m_zstream;
+		m_zstream = nullptr;
+		return false;
+	}
+
+	m_buffer.resize(bufferSize);
+	m_endOfStream = false;
+
+	return QIODevice::open(mode);
+}
+
+void GzipDevice::close()
+{
+	if (m_zstream != nullptr)
+	{
+		if (openMode() & WriteOnly)
+		{
+			// Finish the gzip stream
+			m_zstream->next_in = nullptr;
+			m_zstream->avail_in = 0;
+
+			int ret;
+			do
+			{
+				m_zstream->next_out =
+				    reinterpret_cast<Bytef*>(m_buffer.data());
+				m_zstream->avail_out = uInt(m_buffer.size());
+
+				ret = deflate(m_zstream, Z_FINISH);
+
+				qint64 produced = m_buffer.size()
+						- qint64(m_zstream->avail_out);
+				if (produced > 0)
+					m_device->write(m_buffer.constData(),
+							produced);
+			}
+			while (ret == Z_OK);
+
+			deflateEnd(m_zstream);
+		}
+		else
+			inflateEnd(m_zstream);
+
+		delete m_zstream;
+		m_zstream = nullptr;
+	}
+
+	QIODevice::close();
+}
+
+bool GzipDevice::isSequential() const
+{
+	return true;
+}
+
+bool GzipDevice::atEnd() const
+{
+	if (openMode() & WriteOnly)
+		return true;
+	return m_endOfStream && QIODevice::atEnd();
+}
+
+qint64 GzipDevice::readData(char* data, qint64 maxSize)
+{
+	if (m_zstream == nullptr)
+		return -1;
+
+	qint64 total = 0;
+	while (total < maxSize && !m_endOfStream)
+	{
+		if (m_zstream->avail_in == 0 && !m_device->atEnd())
+		{
+			qint64 len = m_device->read(m_buffer.data(),
+						    m_buffer.size());
+			if (len < 0)
+			{
+				setErrorString(m_device->errorString());
+				return -1;
+			}
+			m_zstream->next_in =
+			    reinterpret_cast<Bytef*>(m_buffer.data());
+			m_zstream->avail_in = uInt(len);
+		}
+
+		m_zstream->next_out =
+		    reinterpret_cast<Bytef*>(data + total);
+		uInt chunk = uInt(qMin(maxSize - total,
+				       qint64(bufferSize)));
+		m_zstream->avail_out = chunk;
+
+		int ret = inflate(m_zstream, Z_NO_FLUSH);
+		total += chunk - m_zstream->avail_out;
+
+		if (ret == Z_STREAM_END)
+		{
+			// Appending games to a gzipped PGN file produces
+			// concatenated gzip members, so keep going if
+			// there's more input.
+			if (m_zstream->avail_in > 0 || !m_device->atEnd())
+				inflateReset(m_zstream);
+			else
+				m_endOfStream = true;
+		}
+		else if (ret == Z_BUF_ERROR)
+		{
+			if (m_zstream->avail_in == 0 && m_device->atEnd())
+			{
+				setErrorString(tr("Unexpected end of gzip stream"));
+				return total > 0 ? total : -1;
+			}
+		}
+		else if (ret != Z_OK)
+		{
+			setErrorString(tr("Gzip decompression error: %1")
+				       .arg(QLatin1String(m_zstream->msg ? m_zstream->msg : "")));
+			return -1;
+		}
+	}
+
+	return total;
+}
+
+qint64 GzipDevice::writeData(const char* data, qint64 size)
+{
+	if (m_zstream == nullptr)
+		return -1;
+
+	qint64 written = 0;
+	while (written < size)
+	{
+		uInt chunk = uInt(qMin(size - written, qint64(bufferSize)));
+		m_zstream->next_in = reinterpret_cast<Bytef*>(
+		    const_cast<char*>(data + written));
+		m_zstream->avail_in = chunk;
+
+		while (m_zstream->avail_in > 0)
+		{
+			m_zstream->next_out =
+			    reinterpret_cast<Bytef*>(m_buffer.data());
+			m_zstream->avail_out = uInt(m_buffer.size());
+
+			if (deflate(m_zstream, Z_NO_FLUSH) != Z_OK)
+			{
+				setErrorString(tr("Gzip compression error: %1")
+					       .arg(QLatin1String(m_zstream->msg ? m_zstream->msg : "")));
+				return -1;
+			}
+
+			qint64 produced = m_buffer.size()
+					- qint64(m_zstream->avail_out);
+			if (produced > 0
+			&&  m_device->write(m_buffer.constData(), produced)
+			    != produced)
+			{
+				setErrorString(m_device->errorString());
+				return -1;
+			}
+		}
+
+		written += chunk;
+	}
+
+	return size;
+}
@@ -0,0 +1,70 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GZIPDEVICE_H
+#define GZIPDEVICE_H
+
+#include <QIODevice>
+#include <QByteArray>
+struct z_stream_s;
+
+
+/*!
+ * \brief A sequential I/O device for reading and writing gzip streams.
+ *
+ * GzipDevice wraps another device and compresses or decompresses the
+ * data on the fly with zlib, so gzipped PGN files can be read and
+ * written directly without an external pipeline stage or a temporary
+ * file. Reading supports concatenated gzip members, which is what
+ * appending games to a compressed PGN file produces.
+ *
+ * The device must be opened in either read-only or write-only mode,
+ * and the underlying device must already be open in a compatible
+ * mode. GzipDevice does not take ownership of the underlying device
+ * and never closes it; in write mode, close() must be called to
+ * finish the gzip stream before the underlying device is closed.
+ */
+class LIB_EXPORT GzipDevice : public QIODevice
+{
+	Q_OBJECT
+
+	public:
+		/*! Creates a new GzipDevice that wraps \a device. */
+		explicit GzipDevice(QIODevice* device, QObject* parent = nullptr);
+		/*! Destructs the device, finishing the stream if needed. */
+		virtual ~GzipDevice();
+
+		// Inherited from QIODevice
+		virtual bool open(OpenMode mode);
+		virtual void close();
+		virtual bool isSequential() const;
+		virtual bool atEnd() const;
+
+	protected:
+		// Inherited from QIODevice
+		virtual qint64 readData(char* data, qint64 maxSize);
+		virtual qint64 writeData(const char* data, qint64 size);
+
+	private:
+		QIODevice* m_device;
+		z_stream_s* m_zstream;
+		QByteArray m_buffer;
+		bool m_endOfStream;
+};
+
+#endif // GZIPDEVICE_H
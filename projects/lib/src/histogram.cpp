@@ -0,0 +1,121 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "histogram.h"
+#include <QtAlgorithms>
+
+Histogram::Histogram(qint64 bucketWidth, int bucketCount)
+	: m_bucketWidth(bucketWidth),
+	  m_count(0),
+	  m_total(0),
+	  m_buckets(bucketCount, 0)
+{
+	Q_ASSERT(bucketWidth >= 0);
+	Q_ASSERT(bucketCount > 0);
+}
+
+int Histogram::bucketAt(qint64 value) const
+{
+	if (value < 0)
+		value = 0;
+
+	int index;
+	if (m_bucketWidth > 0)
+		index = int(qMin(value / m_bucketWidth,
+				 qint64(m_buckets.size() - 1)));
+	else
+	{
+		// Bucket index is the number of significant bits, so
+		// bucket i covers [2^(i-1), 2^i - 1]
+		index = value > 0
+		      ? 64 - qCountLeadingZeroBits(quint64(value)) : 0;
+	}
+	return qMin(index, m_buckets.size() - 1);
+}
+
+void Histogram::add(qint64 value)
+{
+	m_buckets[bucketAt(value)]++;
+	m_count++;
+	m_total += value;
+}
+
+void Histogram::merge(const Histogram& other)
+{
+	if (other.m_count == 0)
+		return;
+	if (m_count == 0)
+	{
+		*this = other;
+		return;
+	}
+
+	Q_ASSERT(m_bucketWidth == other.m_bucketWidth);
+	Q_ASSERT(m_buckets.size() == other.m_buckets.size());
+
+	for (int i = 0; i < m_buckets.size(); i++)
+		m_buckets[i] += other.m_buckets.at(i);
+	m_count += other.m_count;
+	m_total += other.m_total;
+}
+
+qint64 Histogram::count() const
+{
+	return m_count;
+}
+
+qint64 Histogram::total() const
+{
+	return m_total;
+}
+
+QString Histogram::toString() const
+{
+	if (m_count == 0)
+		return "no samples";
+
+	QString str = QString("n=%1 mean=%2:")
+		      .arg(m_count)
+		      .arg(m_total / m_count);
+	for (int i = 0; i < m_buckets.size(); i++)
+	{
+		if (m_buckets.at(i) == 0)
+			continue;
+
+		qint64 lo, hi;
+		if (m_bucketWidth > 0)
+		{
+			lo = qint64(i) * m_bucketWidth;
+			hi = lo + m_bucketWidth - 1;
+		}
+		else
+		{
+			lo = (i == 0) ? 0 : Q_INT64_C(1) << (i - 1);
+			hi = (Q_INT64_C(1) << i) - 1;
+		}
+
+		if (i == m_buckets.size() - 1)
+			str += QString(" %1+:%2")
+			       .arg(lo).arg(m_buckets.at(i));
+		else
+			str += QString(" %1-%2:%3")
+			       .arg(lo).arg(hi).arg(m_buckets.at(i));
+	}
+
+	return str;
+}
@@ -0,0 +1,78 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include <QString>
+#include <QVector>
+
+/*!
+ * \brief A fixed-bucket histogram of integer samples.
+ *
+ * Adding a sample is one array increment, so histograms can sit on
+ * hot paths like the per-move bookkeeping in ChessGame. The bucket
+ * layout is either logarithmic (bucket \a i covers the values with
+ * \a i significant bits, suitable for latencies) or linear with a
+ * fixed bucket width (suitable for percentages).
+ *
+ * \sa Tournament::engineStats()
+ */
+class LIB_EXPORT Histogram
+{
+	public:
+		/*!
+		 * Creates a histogram with \a bucketCount buckets.
+		 *
+		 * If \a bucketWidth is zero the buckets are logarithmic,
+		 * otherwise each bucket covers \a bucketWidth values.
+		 * The last bucket is open-ended in both layouts.
+		 */
+		Histogram(qint64 bucketWidth = 0, int bucketCount = 16);
+
+		/*! Adds \a value to the histogram. */
+		void add(qint64 value);
+		/*!
+		 * Merges \a other into this histogram.
+		 *
+		 * An empty histogram adopts the other's bucket layout;
+		 * otherwise the layouts must match.
+		 */
+		void merge(const Histogram& other);
+
+		/*! Returns the number of samples. */
+		qint64 count() const;
+		/*! Returns the sum of all samples. */
+		qint64 total() const;
+		/*!
+		 * Returns a one-line summary with the sample count, the
+		 * mean and the non-empty buckets, eg.
+		 * "n=82 mean=438: 0-255:12 256-511:70".
+		 */
+		QString toString() const;
+
+	private:
+		int bucketAt(qint64 value) const;
+
+		qint64 m_bucketWidth;
+		qint64 m_count;
+		qint64 m_total;
+		QVector<qint64> m_buckets;
+};
+
+#endif // HISTOGRAM_H
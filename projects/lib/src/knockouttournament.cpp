@@ -113,7 +113,7 @@ void KnockoutTournament::initializePairing()
 			all[i] = player;
 	}
 
-	QList<TournamentPair*> pairs;
+	QVector<TournamentPair*> pairs;
 	int j = 0;
 	for (int i = 0; i < x; i += 2)
 	{
@@ -141,19 +141,31 @@ int KnockoutTournament::gamesPerCycle() const
 
 void KnockoutTournament::addScore(int player, int score)
 {
-	for (TournamentPair* pair : m_rounds.last())
+	// With speculative next-round starts, games from more than one
+	// round can run at the same time. The score belongs to the
+	// player's pair in the latest round, the only one still playing.
+	if (score > 0)
 	{
-		if (score > 0)
+		bool found = false;
+		for (int r = m_rounds.size() - 1; r >= 0 && !found; r--)
 		{
-			if (pair->firstPlayer() == player)
+			const auto round = m_rounds.at(r);
+			for (TournamentPair* pair : round)
 			{
-				pair->addFirstScore(score);
-				break;
-			}
-			if (pair->secondPlayer() == player)
-			{
-				pair->addSecondScore(score);
-				break;
+				if (pair == nullptr)
+					continue;
+				if (pair->firstPlayer() == player)
+				{
+					pair->addFirstScore(score);
+					found = true;
+					break;
+				}
+				if (pair->secondPlayer() == player)
+				{
+					pair->addSecondScore(score);
+					found = true;
+					break;
+				}
 			}
 		}
 	}
@@ -161,29 +173,45 @@ void KnockoutTournament::addScore(int player, int score)
 	Tournament::addScore(player, score);
 }
 
-QList<int> KnockoutTournament::lastRoundWinners() const
+bool KnockoutTournament::isDecided(const TournamentPair* pair) const
 {
-	QList<int> winners;
-	const auto last = m_rounds.last();
-	for (const TournamentPair* pair : last)
-		winners << pair->leader();
+	// Second player is a BYE
+	if (!pair->isValid())
+		return true;
 
-	return winners;
+	return pair->gamesInProgress() == 0 && !needMoreGames(pair);
 }
 
-bool KnockoutTournament::areAllGamesFinished() const
+int KnockoutTournament::winnerOf(const TournamentPair* pair) const
 {
-	const QList<TournamentPair*>& lastRound(m_rounds.last());
+	int winner = pair->leader();
+	if (winner >= 0)
+		return winner;
 
-	qWarning () << "lastRound.size:" << lastRound.size() << " , m_should_we_stop_global" << m_should_we_stop_global;
-	const auto last = m_rounds.last();
-	for (TournamentPair* pair : last)
+	// Tied encounter: advance the player with fewer strikes
+	const int iWhite = pair->firstPlayer();
+	const int iBlack = pair->secondPlayer();
+	if (Tournament::playerAt(iWhite).builder()->strikes() >
+	    Tournament::playerAt(iBlack).builder()->strikes())
+		return iBlack;
+	return iWhite;
+}
+
+bool KnockoutTournament::areAllGamesFinished() const
+{
+	for (const QVector<TournamentPair*>& round : m_rounds)
 	{
-		if (needMoreGames(pair))
-			return false;
+		for (TournamentPair* pair : round)
+		{
+			if (pair != nullptr && needMoreGames(pair))
+				return false;
+		}
 	}
 
-	return true;
+	// The bracket is complete once the final has been paired (and,
+	// per the loop above, played out)
+	return m_rounds.last().size() == 1
+	       && m_rounds.last().first() != nullptr;
 }
 
 void KnockoutTournament::setTC(TournamentPlayer white, TournamentPlayer black, ChessGame * game, const TournamentPair* pair)
@@ -374,41 +402,64 @@ bool KnockoutTournament::needMoreGames(const TournamentPair* pair) const
 	return true;
 }
 
-TournamentPair* KnockoutTournament::nextPair(int gameNumber)
+TournamentPair* KnockoutTournament::growBracket()
 {
-	Q_UNUSED(gameNumber);
+	TournamentPair* next = nullptr;
 
-	const auto last = m_rounds.last();
-	for (TournamentPair* pair : last)
+	// Note: the list can grow while we iterate, so newly decided
+	// BYE pairs cascade through the bracket in a single pass
+	for (int r = 0; r < m_rounds.size(); r++)
 	{
-		if (needMoreGames(pair))
-			return pair;
+		if (m_rounds.at(r).size() <= 1)
+			continue;
+		if (r + 1 >= m_rounds.size())
+			m_rounds.append(QVector<TournamentPair*>(
+					m_rounds.at(r).size() / 2, nullptr));
+
+		const QVector<TournamentPair*>& round = m_rounds.at(r);
+		QVector<TournamentPair*>& nextRound = m_rounds[r + 1];
+		for (int i = 0; i < nextRound.size(); i++)
+		{
+			if (nextRound.at(i) != nullptr)
+				continue;
+
+			TournamentPair* first = round.at(2 * i);
+			TournamentPair* second = round.at(2 * i + 1);
+			if (first == nullptr || second == nullptr
+			||  !isDecided(first) || !isDecided(second))
+				continue;
+
+			TournamentPair* newPair = pair(winnerOf(first),
+						       winnerOf(second));
+			nextRound[i] = newPair;
+			if (r + 2 > currentRound())
+				setCurrentRound(r + 2);
+
+			if (next == nullptr && needMoreGames(newPair))
+				next = newPair;
+		}
 	}
 
-	QList<int> winners(lastRoundWinners());
-	if (winners.size() <= 1 || gamesInProgress())
-		return nullptr;
+	return next;
+}
 
-	QList<TournamentPair*> nextRound;
-	for (int i = 0; i < winners.size(); i += 2)
-	{
-		nextRound << pair(winners.at(i), winners.at(i + 1));
-	}
-	m_rounds << nextRound;
-	if (currentRound() == 1)
-	{
-		return nullptr;
-	}
-	setCurrentRound(currentRound() + 1);
+TournamentPair* KnockoutTournament::nextPair(int gameNumber)
+{
+	Q_UNUSED(gameNumber);
 
-	for (TournamentPair* pair : qAsConst(nextRound))
+	for (const QVector<TournamentPair*>& round : qAsConst(m_rounds))
 	{
-		if (pair->isValid())
-			return pair;
+		for (TournamentPair* pair : round)
+		{
+			if (pair != nullptr && needMoreGames(pair))
+				return pair;
+		}
 	}
 
-	Q_UNREACHABLE();
-	return nullptr;
+	// Pair next-round matches as soon as both participants are
+	// known instead of waiting for the whole round to finish; one
+	// long-running match no longer idles the other slots.
+	return growBracket();
 }
 
 QString KnockoutTournament::results() const
@@ -438,6 +489,13 @@ QString KnockoutTournament::results() const
 		const auto nthRound = m_rounds.at(round);
 		for (const TournamentPair* pair : nthRound)
 		{
+			// Match not paired yet
+			if (pair == nullptr)
+			{
+				x++;
+				continue;
+			}
+
 			QString winner;
 			if (needMoreGames(pair) || pair->gamesInProgress())
 				winner = "...";
@@ -64,10 +64,19 @@ class LIB_EXPORT KnockoutTournament : public Tournament
 		static int playerSeed(int rank, int bracketSize);
 
 		QList<int> firstRoundPlayers() const;
-		QList<int> lastRoundWinners() const;
+		// Returns true if 'pair' has no games running and needs
+		// no further games, ie. its winner is known
+		bool isDecided(const TournamentPair* pair) const;
+		// Returns the player index advancing from 'pair'
+		int winnerOf(const TournamentPair* pair) const;
+		// Creates next-round pairs whose participants are known
+		// and returns the first new pair that can start a game
+		TournamentPair* growBracket();
 		bool needMoreGames(const TournamentPair* pair) const;
 
-		QList< QList<TournamentPair*> > m_rounds;
+		// Bracket rounds in slot order; a null slot is a match
+		// whose participants aren't determined yet
+		QList< QVector<TournamentPair*> > m_rounds;
 };
 
 #endif // KNOCKOUTTOURNAMENT_H
@@ -0,0 +1,117 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "layeredbook.h"
+
+LayeredBook::LayeredBook(BlendMode mode)
+	: OpeningBook(Ram),
+	  m_mode(mode)
+{
+}
+
+LayeredBook::~LayeredBook()
+{
+	for (const Layer& layer : qAsConst(m_layers))
+		delete layer.book;
+}
+
+void LayeredBook::addLayer(const OpeningBook* book, int weight)
+{
+	Q_ASSERT(book != nullptr);
+	Q_ASSERT(weight > 0);
+
+	m_layers.append({ book, weight });
+	m_cache.clear();
+}
+
+QList<OpeningBook::Entry> LayeredBook::entries(quint64 key) const
+{
+	auto it = m_cache.constFind(key);
+	if (it != m_cache.constEnd())
+		return it.value();
+
+	QList<Entry> entries;
+	for (const Layer& layer : qAsConst(m_layers))
+	{
+		const auto layerEntries = layer.book->entries(key);
+		if (layerEntries.isEmpty())
+			continue;
+
+		// In priority mode the topmost layer that knows the
+		// position wins
+		if (m_mode == Priority)
+		{
+			entries = layerEntries;
+			break;
+		}
+
+		// In blend mode the layers' entries are combined,
+		// with duplicate moves merged by adding their scaled
+		// weights
+		for (const Entry& entry : layerEntries)
+		{
+			quint32 weight = quint32(entry.weight) * layer.weight;
+
+			bool merged = false;
+			for (Entry& tmp : entries)
+			{
+				if (tmp.move == entry.move)
+				{
+					weight += tmp.weight;
+					tmp.weight = quint16(qMin(weight,
+					    quint32(0xffff)));
+					merged = true;
+					break;
+				}
+			}
+			if (!merged)
+			{
+				Entry tmp = { entry.move,
+				    quint16(qMin(weight, quint32(0xffff))) };
+				entries.append(tmp);
+			}
+		}
+	}
+
+	m_cache[key] = entries;
+	return entries;
+}
+
+int LayeredBook::entrySize() const
+{
+	Q_UNREACHABLE();
+	return 0;
+}
+
+OpeningBook::Entry LayeredBook::readEntry(QDataStream& in, quint64* key) const
+{
+	Q_UNUSED(in);
+	Q_UNUSED(key);
+
+	Q_UNREACHABLE();
+	return { Chess::GenericMove(), 0 };
+}
+
+void LayeredBook::writeEntry(quint64 key,
+			     const Entry& entry,
+			     QDataStream& out) const
+{
+	Q_UNUSED(key);
+	Q_UNUSED(entry);
+	Q_UNUSED(out);
+}
@@ -0,0 +1,94 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LAYERED_BOOK_H
+#define LAYERED_BOOK_H
+
+#include "openingbook.h"
+#include <QList>
+
+/*!
+ * \brief A stack of opening books probed as one book.
+ *
+ * LayeredBook composes other OpeningBook objects into a single
+ * logical book, eg. a narrow event book layered over a broad base
+ * book, without merging the book files offline.
+ *
+ * In \a Priority mode a position is resolved by the topmost layer
+ * that has entries for it. In \a Blend mode the entries of all
+ * layers are combined, with each layer's weights scaled by the
+ * layer's weight.
+ *
+ * The resolution of a position is cached, so after the first probe
+ * the layering costs nothing.
+ *
+ * \note A layered book is a view; it cannot be read from or written
+ * to a file.
+ */
+class LIB_EXPORT LayeredBook : public OpeningBook
+{
+	public:
+		/*! How a position is resolved across the layers. */
+		enum BlendMode
+		{
+			//! The topmost layer with entries wins
+			Priority,
+			//! All layers' entries are combined
+			Blend
+		};
+
+		/*! Creates a new empty LayeredBook in \a mode. */
+		LayeredBook(BlendMode mode = Priority);
+		/*! Destroys the book and its layers. */
+		virtual ~LayeredBook();
+
+		/*!
+		 * Adds \a book below the existing layers.
+		 *
+		 * The layered book takes ownership of \a book. In
+		 * \a Blend mode the entry weights of \a book are
+		 * scaled by \a weight.
+		 */
+		void addLayer(const OpeningBook* book, int weight = 1);
+
+		// Inherited from OpeningBook
+		virtual QList<Entry> entries(quint64 key) const;
+
+	protected:
+		// Inherited from OpeningBook. A layered book is not
+		// backed by a file, so these are never used.
+		virtual int entrySize() const;
+		virtual Entry readEntry(QDataStream& in, quint64* key) const;
+		virtual void writeEntry(quint64 key,
+					const Entry& entry,
+					QDataStream& out) const;
+
+	private:
+		struct Layer
+		{
+			const OpeningBook* book;
+			int weight;
+		};
+
+		BlendMode m_mode;
+		QList<Layer> m_layers;
+		// Cached per-position resolutions
+		mutable QHash<quint64, QList<Entry>> m_cache;
+};
+
+#endif // LAYERED_BOOK_H
@@ -17,51 +17,86 @@
 */
 
 #include "mersenne.h"
-#include <QMutex>
+#include <QAtomicInt>
 
 namespace {
 
-int s_index = 0;
-quint32 s_mt[624];
+const quint64 GOLDEN_GAMMA = Q_UINT64_C(0x9E3779B97F4A7C15);
 
-void generateNumbers()
+QAtomicInt s_baseSeed;
+QAtomicInt s_threadCount;
+
+struct ThreadState
 {
-	for (int i = 0; i < 624; i++)
-	{
-		quint32 y = (s_mt[i] & 0x1) + (s_mt[(i + 1) % 624] & 0x7FFFFFFF);
-		s_mt[i] = s_mt[(i + 397) % 624] ^ (y >> 1);
+	quint32 s[4];
+	bool initialized;
+};
 
-		if (y % 2)
-			s_mt[i] ^= 0x9908B0DF;
-	}
+// Each thread gets its own index and generator state, so random()
+// needs no locking and a thread's sequence doesn't depend on what
+// the other threads consume
+thread_local int t_index = s_threadCount.fetchAndAddRelaxed(1);
+thread_local ThreadState t_state = { { 0, 0, 0, 0 }, false };
+
+quint64 splitMix64(quint64& x)
+{
+	x += GOLDEN_GAMMA;
+	quint64 z = x;
+	z = (z ^ (z >> 30)) * Q_UINT64_C(0xBF58476D1CE4E5B9);
+	z = (z ^ (z >> 27)) * Q_UINT64_C(0x94D049BB133111EB);
+	return z ^ (z >> 31);
+}
+
+void seedState(quint64 x)
+{
+	for (int i = 0; i < 4; i++)
+		t_state.s[i] = quint32(splitMix64(x) >> 32);
+	if (!(t_state.s[0] | t_state.s[1] | t_state.s[2] | t_state.s[3]))
+		t_state.s[0] = 1;
+
+	t_state.initialized = true;
+}
+
+quint32 rotl(quint32 x, int k)
+{
+	return (x << k) | (x >> (32 - k));
 }
 
 } // anonymous namespace
 
 void Mersenne::initialize(quint32 seed)
 {
-	s_mt[0] = seed;
+	s_baseSeed.store(int(seed));
+
+	seedState(quint64(seed) + quint64(t_index) * GOLDEN_GAMMA);
+}
 
-	for (int i = 1; i < 624; i++)
-		s_mt[i] = (0x6C078965 * (s_mt[i - 1] ^ (s_mt[i - 1] >> 30)) + i) & 0xFFFFFFFF;
+void Mersenne::initializeThread(quint64 key)
+{
+	const quint64 base = quint64(quint32(s_baseSeed.load()));
+	seedState(base * GOLDEN_GAMMA + key);
 }
 
 quint32 Mersenne::random()
 {
-	static QMutex mutex;
-	mutex.lock();
+	quint32* s = t_state.s;
 
-	if (s_index == 0)
-		generateNumbers();
+	if (!t_state.initialized)
+	{
+		const quint64 base = quint64(quint32(s_baseSeed.load()));
+		seedState(base + quint64(t_index) * GOLDEN_GAMMA);
+	}
 
-	quint32 y = s_mt[s_index];
-	y ^= y >> 11;
-	y ^= (y << 7) & 0x9D2C5680;
-	y ^= (y << 15) & 0xEFC60000;
-	y ^= y >> 18;
+	// xoshiro128**
+	const quint32 result = rotl(s[1] * 5, 7) * 9;
+	const quint32 t = s[1] << 9;
 
-	s_index = (s_index + 1) % 624;
-	mutex.unlock();
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = rotl(s[3], 11);
 
-	return y;
+	return result;
 }
@@ -22,18 +22,39 @@
 #include <QtGlobal>
 
 /*!
- * \brief A "Mersenne Twister" pseudorandom number generator
+ * \brief A pseudorandom number generator
  *
- * The Mersenne PRNG produces pseudorandom numbers between
- * 0 and 0xFFFFFFFF - 1 at uniform distribution. Unlike Qt's
- * own random numbers, the sequences generated by this class
- * are not deterministic per thread.
+ * The PRNG produces pseudorandom numbers between 0 and
+ * 0xFFFFFFFF - 1 at uniform distribution. Every thread has a
+ * generator of its own, seeded deterministically from the global
+ * seed, so threads never contend for shared generator state and
+ * the sequence a thread sees doesn't depend on other threads.
+ *
+ * The class keeps its historical name for source compatibility;
+ * the generator is xoshiro128** seeded with a SplitMix64 mixer,
+ * not a Mersenne Twister.
  */
 class LIB_EXPORT Mersenne
 {
 	public:
-		/*! Initializes the PRNG with \a seed. */
+		/*!
+		 * Initializes the PRNG with \a seed.
+		 *
+		 * The seed applies to all threads; the calling thread's
+		 * generator is reseeded immediately and other threads'
+		 * generators when they're next used.
+		 */
 		static void initialize(quint32 seed);
+		/*!
+		 * Reseeds the calling thread's generator with the
+		 * global seed mixed with \a key.
+		 *
+		 * Seeding with a game index before generating a game's
+		 * opening makes the opening depend only on the seed and
+		 * the index, so separate workers reproduce identical
+		 * openings without coordination.
+		 */
+		static void initializeThread(quint64 key);
 		/*!
 		 * Returns a pseudorandom number between 0 and 0xFFFFFFFF -1.
 		 *
@@ -0,0 +1,58 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "metrics.h"
+
+QAtomicInteger<qint64> Metrics::s_counters[Metrics::CounterCount];
+
+void Metrics::add(Counter counter, qint64 value)
+{
+	Q_ASSERT(counter >= 0 && counter < CounterCount);
+
+	// A relaxed increment is enough: the counters are independent
+	// and only read by a periodic exporter.
+	s_counters[counter].fetchAndAddRelaxed(value);
+}
+
+qint64 Metrics::value(Counter counter)
+{
+	Q_ASSERT(counter >= 0 && counter < CounterCount);
+
+	return s_counters[counter].loadAcquire();
+}
+
+QString Metrics::key(Counter counter)
+{
+	switch (counter)
+	{
+	case GamesStarted:
+		return "games_started";
+	case GamesFinished:
+		return "games_finished";
+	case GamesQueued:
+		return "games_queued";
+	case EngineStarts:
+		return "engine_starts";
+	case MovesMade:
+		return "moves_made";
+	case MoveTimeMsecs:
+		return "move_time_msecs";
+	default:
+		return QString();
+	}
+}
@@ -0,0 +1,62 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <QAtomicInteger>
+#include <QString>
+
+/*!
+ * \brief Global operational counters.
+ *
+ * The counters track tournament and engine activity for monitoring
+ * purposes. Updates are plain relaxed atomic increments, so the
+ * instrumentation can stay enabled in production without affecting
+ * game timing, and the values can be polled from any thread, eg. by
+ * a statsd exporter.
+ *
+ * \sa CuteChessCoreApplication
+ */
+class LIB_EXPORT Metrics
+{
+	public:
+		/*! The available counters. */
+		enum Counter
+		{
+			GamesStarted,	//!< Games handed to a game thread
+			GamesFinished,	//!< Games that finished or were aborted
+			GamesQueued,	//!< Games currently waiting in the queue
+			EngineStarts,	//!< Engine processes started, restarts included
+			MovesMade,	//!< Moves made by the players
+			MoveTimeMsecs,	//!< Cumulated move time in milliseconds
+			CounterCount	//!< Number of counters; not a counter
+		};
+
+		/*! Adds \a value (default 1) to \a counter. */
+		static void add(Counter counter, qint64 value = 1);
+		/*! Returns the current value of \a counter. */
+		static qint64 value(Counter counter);
+		/*! Returns the export key of \a counter, eg. "games_started". */
+		static QString key(Counter counter);
+
+	private:
+		static QAtomicInteger<qint64> s_counters[CounterCount];
+};
+
+#endif // METRICS_H
@@ -18,118 +18,148 @@
 
 #include "moveevaluation.h"
 
+class MoveEvaluationData : public QSharedData
+{
+	public:
+		MoveEvaluationData();
+
+		bool isBookEval;
+		int depth;
+		int selDepth;
+		int score;
+		int time;
+		int pvNumber;
+		int hashUsage;
+		int ponderhitRate;
+		quint64 nodeCount;
+		quint64 nps;
+		quint64 tbHits;
+		QString pv;
+		QString ponderMove;
+};
+
+MoveEvaluationData::MoveEvaluationData()
+	: isBookEval(false),
+	  depth(0),
+	  selDepth(0),
+	  score(MoveEvaluation::NULL_SCORE),
+	  time(0),
+	  pvNumber(0),
+	  hashUsage(0),
+	  ponderhitRate(0),
+	  nodeCount(0),
+	  nps(0),
+	  tbHits(MoveEvaluation::NULL_TBHITS)
+{
+}
+
+
 MoveEvaluation::MoveEvaluation()
-	: m_isBookEval(false),
-	  m_depth(0),
-	  m_selDepth(0),
-	  m_score(NULL_SCORE),
-	  m_time(0),
-	  m_pvNumber(0),
-	  m_hashUsage(0),
-	  m_ponderhitRate(0),
-	  m_nodeCount(0),
-	  m_nps(0),
-	  m_tbHits(NULL_TBHITS)
+	: d(new MoveEvaluationData)
+{
+}
+
+MoveEvaluation::MoveEvaluation(const MoveEvaluation& other)
+	: d(other.d)
+{
+}
+
+MoveEvaluation::~MoveEvaluation()
 {
 }
 
+MoveEvaluation& MoveEvaluation::operator=(const MoveEvaluation& other)
+{
+	d = other.d;
+	return *this;
+}
+
 bool MoveEvaluation::operator==(const MoveEvaluation& other) const
 {
-	if (m_isBookEval == other.m_isBookEval
-	&&  m_depth == other.m_depth
-	&&  m_selDepth == other.m_selDepth
-	&&  m_score == other.m_score
-	&&  m_time == other.m_time
-	&&  m_pvNumber == other.m_pvNumber
-	&&  m_hashUsage == other.m_hashUsage
-	&&  m_ponderhitRate == other.m_ponderhitRate
-	&&  m_nodeCount == other.m_nodeCount
-	&&  m_nps == other.m_nps
-	&&  m_tbHits == other.m_tbHits
-	&&  m_ponderMove == other.m_ponderMove)
+	if (d == other.d)
+		return true;
+	if (d->isBookEval == other.d->isBookEval
+	&&  d->depth == other.d->depth
+	&&  d->selDepth == other.d->selDepth
+	&&  d->score == other.d->score
+	&&  d->time == other.d->time
+	&&  d->pvNumber == other.d->pvNumber
+	&&  d->hashUsage == other.d->hashUsage
+	&&  d->ponderhitRate == other.d->ponderhitRate
+	&&  d->nodeCount == other.d->nodeCount
+	&&  d->nps == other.d->nps
+	&&  d->tbHits == other.d->tbHits
+	&&  d->ponderMove == other.d->ponderMove)
 		return true;
 	return false;
 }
 
 bool MoveEvaluation::operator!=(const MoveEvaluation& other) const
 {
-	if (m_isBookEval != other.m_isBookEval
-	||  m_depth != other.m_depth
-	||  m_selDepth != other.m_selDepth
-	||  m_score != other.m_score
-	||  m_time != other.m_time
-	||  m_pvNumber != other.m_pvNumber
-	||  m_hashUsage != other.m_hashUsage
-	||  m_ponderhitRate != other.m_ponderhitRate
-	||  m_nodeCount != other.m_nodeCount
-	||  m_nps != other.m_nps
-	||  m_tbHits != other.m_tbHits
-	||  m_ponderMove != other.m_ponderMove)
-		return true;
-	return false;
+	return !operator==(other);
 }
 
 bool MoveEvaluation::isEmpty() const
 {
-	if (m_depth == 0
-	&&  m_selDepth == 0
-	&&  m_score == NULL_SCORE
-	&&  m_time < 500
-	&&  m_pvNumber == 0
-	&&  m_hashUsage == 0
-	&&  m_ponderhitRate == 0
-	&&  m_nodeCount == 0
-	&&  m_nps == 0
-	&&  m_tbHits == NULL_TBHITS
-	&&  m_ponderMove.isEmpty())
+	if (d->depth == 0
+	&&  d->selDepth == 0
+	&&  d->score == NULL_SCORE
+	&&  d->time < 500
+	&&  d->pvNumber == 0
+	&&  d->hashUsage == 0
+	&&  d->ponderhitRate == 0
+	&&  d->nodeCount == 0
+	&&  d->nps == 0
+	&&  d->tbHits == NULL_TBHITS
+	&&  d->ponderMove.isEmpty())
 		return true;
 	return false;
 }
 
 bool MoveEvaluation::isBookEval() const
 {
-	return m_isBookEval;
+	return d->isBookEval;
 }
 
 int MoveEvaluation::depth() const
 {
-	return m_depth;
+	return d->depth;
 }
 
 int MoveEvaluation::selectiveDepth() const
 {
-	return m_selDepth;
+	return d->selDepth;
 }
 
 int MoveEvaluation::score() const
 {
-	return m_score;
+	return d->score;
 }
 
 QString MoveEvaluation::scoreText() const
 {
 	if (isBookEval())
 		return "book";
-	if (m_score == NULL_SCORE)
+	if (d->score == NULL_SCORE)
 		return QString();
 
 	QString str;
 	if (depth() > 0)
 	{
-		int absScore = qAbs(m_score);
-		if (m_score > 0)
+		int absScore = qAbs(d->score);
+		if (d->score > 0)
 			str += "+";
 
 		// Detect mate-in-n scores
 		if (absScore > 98800
 		&&  (absScore = 1000 - (absScore % 1000)) < 200)
 		{
-			if (m_score < 0)
+			if (d->score < 0)
 				str += "-";
 			str += "M" + QString::number(absScore);
 		}
 		else
-			str += QString::number(double(m_score) / 100.0, 'f', 2);
+			str += QString::number(double(d->score) / 100.0, 'f', 2);
 	}
 
 	return str;
@@ -137,158 +167,167 @@ QString MoveEvaluation::scoreText() const
 
 int MoveEvaluation::time() const
 {
-	return m_time;
+	return d->time;
 }
 
 quint64 MoveEvaluation::nodeCount() const
 {
-	return m_nodeCount;
+	return d->nodeCount;
 }
 
 quint64 MoveEvaluation::nps() const
 {
-	if (m_nps || !m_time)
-		return m_nps;
-	return quint64(m_nodeCount / (double(m_time) / 1000.0));
+	if (d->nps || !d->time)
+		return d->nps;
+	return quint64(d->nodeCount / (double(d->time) / 1000.0));
 }
 
 quint64 MoveEvaluation::tbHits() const
 {
-	return m_tbHits;
+	return d->tbHits;
 }
 
 int MoveEvaluation::hashUsage() const
 {
-	return m_hashUsage;
+	return d->hashUsage;
 }
 
 int MoveEvaluation::ponderhitRate() const
 {
-	return m_ponderhitRate;
+	return d->ponderhitRate;
 }
 
 QString MoveEvaluation::ponderMove() const
 {
-	return m_ponderMove;
+	return d->ponderMove;
 }
 
 QString MoveEvaluation::pv() const
 {
-	return m_pv;
+	return d->pv;
 }
 
 int MoveEvaluation::pvNumber() const
 {
-	return m_pvNumber;
+	return d->pvNumber;
 }
 
 void MoveEvaluation::clear()
 {
-	m_isBookEval = false;
-	m_depth = 0;
-	m_selDepth = 0;
-	m_score = NULL_SCORE;
-	m_time = 0;
-	m_pvNumber = 0;
-	m_nodeCount = 0;
-	m_nps = 0;
-	m_tbHits = NULL_TBHITS;
-	m_hashUsage = 0;
-	m_ponderhitRate = 0;
-	m_pv.clear();
-	m_ponderMove.clear();
+	if (d.constData()->ref.load() > 1)
+	{
+		// Other evaluations share the data, so give this one a
+		// fresh block instead of detaching just to wipe the copy
+		d = QSharedDataPointer<MoveEvaluationData>(new MoveEvaluationData);
+		return;
+	}
+
+	MoveEvaluationData* data = d.data();
+	data->isBookEval = false;
+	data->depth = 0;
+	data->selDepth = 0;
+	data->score = NULL_SCORE;
+	data->time = 0;
+	data->pvNumber = 0;
+	data->nodeCount = 0;
+	data->nps = 0;
+	data->tbHits = NULL_TBHITS;
+	data->hashUsage = 0;
+	data->ponderhitRate = 0;
+	data->pv.clear();
+	data->ponderMove.clear();
 }
 
 void MoveEvaluation::setBookEval(bool isBookEval)
 {
-	m_isBookEval = isBookEval;
+	d->isBookEval = isBookEval;
 }
 
 void MoveEvaluation::setDepth(int depth)
 {
-	m_depth = depth;
+	d->depth = depth;
 }
 
 void MoveEvaluation::setSelectiveDepth(int depth)
 {
-	m_selDepth = depth;
+	d->selDepth = depth;
 }
 
 void MoveEvaluation::setScore(int score)
 {
-	m_score = score;
+	d->score = score;
 }
 
 void MoveEvaluation::setTime(int time)
 {
-	m_time = time;
+	d->time = time;
 }
 
 void MoveEvaluation::setNodeCount(quint64 nodeCount)
 {
-	m_nodeCount = nodeCount;
+	d->nodeCount = nodeCount;
 }
 
 void MoveEvaluation::setNps(quint64 nps)
 {
-	m_nps = nps;
+	d->nps = nps;
 }
 
 void MoveEvaluation::setTbHits(quint64 tbHits)
 {
-	m_tbHits = tbHits;
+	d->tbHits = tbHits;
 }
 
 void MoveEvaluation::setHashUsage(int hashUsage)
 {
-	m_hashUsage = hashUsage;
+	d->hashUsage = hashUsage;
 }
 
 void MoveEvaluation::setPonderhitRate(int rate)
 {
-	m_ponderhitRate = rate;
+	d->ponderhitRate = rate;
 }
 
 void MoveEvaluation::setPonderMove(const QString& san)
 {
-	m_ponderMove = san;
+	d->ponderMove = san;
 }
 
 void MoveEvaluation::setPv(const QString& pv)
 {
-	m_pv = pv;
+	d->pv = pv;
 }
 
 void MoveEvaluation::setPvNumber(int number)
 {
-	m_pvNumber = number;
+	d->pvNumber = number;
 }
 
 void MoveEvaluation::merge(const MoveEvaluation& other)
 {
-	if (other.m_depth)
-		m_depth = other.m_depth;
-	if (other.m_selDepth)
-		m_selDepth = other.m_selDepth;
-	m_isBookEval = other.m_isBookEval;
-	if (other.m_nodeCount)
-		m_nodeCount = other.m_nodeCount;
-	if (other.m_nps)
-		m_nps = other.m_nps;
-	if (other.m_tbHits != NULL_TBHITS)
-		m_tbHits = other.m_tbHits;
-	if (other.m_hashUsage)
-		m_hashUsage = other.m_hashUsage;
-	if (other.m_ponderhitRate)
-		m_ponderhitRate = other.m_ponderhitRate;
-	if (!other.m_ponderMove.isEmpty())
-		m_ponderMove = other.m_ponderMove;
-	if (!other.m_pv.isEmpty())
-		m_pv = other.m_pv;
-	if (other.m_pvNumber)
-		m_pvNumber = other.m_pvNumber;
-	if (other.m_score != NULL_SCORE)
-		m_score = other.m_score;
-	if (other.m_time)
-		m_time = other.m_time;
+	if (other.d->depth)
+		d->depth = other.d->depth;
+	if (other.d->selDepth)
+		d->selDepth = other.d->selDepth;
+	d->isBookEval = other.d->isBookEval;
+	if (other.d->nodeCount)
+		d->nodeCount = other.d->nodeCount;
+	if (other.d->nps)
+		d->nps = other.d->nps;
+	if (other.d->tbHits != NULL_TBHITS)
+		d->tbHits = other.d->tbHits;
+	if (other.d->hashUsage)
+		d->hashUsage = other.d->hashUsage;
+	if (other.d->ponderhitRate)
+		d->ponderhitRate = other.d->ponderhitRate;
+	if (!other.d->ponderMove.isEmpty())
+		d->ponderMove = other.d->ponderMove;
+	if (!other.d->pv.isEmpty())
+		d->pv = other.d->pv;
+	if (other.d->pvNumber)
+		d->pvNumber = other.d->pvNumber;
+	if (other.d->score != NULL_SCORE)
+		d->score = other.d->score;
+	if (other.d->time)
+		d->time = other.d->time;
 }
@@ -21,6 +21,9 @@
 
 #include <QString>
 #include <QMetaType>
+#include <QSharedDataPointer>
+
+class MoveEvaluationData;
 
 /*!
  * \brief Evaluation data for a chess move.
@@ -30,6 +33,12 @@
  * the search depth, etc. This class stores that information so that it
  * could be saved in a PGN file or displayed on the screen.
  *
+ * MoveEvaluation is implicitly shared: copying one, eg. through a
+ * queued signal connection, only references the same data, and the
+ * data is copied when a copy is modified. This keeps the heavy
+ * per-info-line evaluation traffic of a fast engine off the
+ * allocator.
+ *
  * From human players we can only get the move time.
  */
 class LIB_EXPORT MoveEvaluation
@@ -42,6 +51,12 @@ class LIB_EXPORT MoveEvaluation
 
 		/*! Constructs an empty MoveEvaluation object. */
 		MoveEvaluation();
+		/*! Creates a copy of \a other. */
+		MoveEvaluation(const MoveEvaluation& other);
+		~MoveEvaluation();
+
+		/*! Assigns \a other to this evaluation. */
+		MoveEvaluation& operator=(const MoveEvaluation& other);
 
 		/*! Returns true if \a other is the same as this eval. */
 		bool operator==(const MoveEvaluation& other) const;
@@ -177,19 +192,7 @@ class LIB_EXPORT MoveEvaluation
 		void merge(const MoveEvaluation& other);
 
 	private:
-		bool m_isBookEval;
-		int m_depth;
-		int m_selDepth;
-		int m_score;
-		int m_time;
-		int m_pvNumber;
-		int m_hashUsage;
-		int m_ponderhitRate;
-		quint64 m_nodeCount;
-		quint64 m_nps;
-		quint64 m_tbHits;
-		QString m_pv;
-		QString m_ponderMove;
+		QSharedDataPointer<MoveEvaluationData> d;
 };
 
 Q_DECLARE_METATYPE(MoveEvaluation)
@@ -17,14 +17,66 @@
 */
 
 #include "openingbook.h"
+#include <algorithm>
+#include <cstring>
+#include <functional>
 #include <QString>
 #include <QFile>
+#include <QFileDevice>
 #include <QDataStream>
+#include <QMutexLocker>
+#include <QThread>
+#include <QThreadPool>
+#include <QVector>
 #include <QtDebug>
 #include "pgngame.h"
 #include "pgnstream.h"
 #include "mersenne.h"
 
+namespace {
+
+//! Smallest amount of PGN data worth giving to an import thread.
+const qint64 s_minShardSize = Q_INT64_C(4) * 1024 * 1024;
+
+//! A QRunnable that runs an arbitrary function.
+class FunctionRunnable : public QRunnable
+{
+	public:
+		FunctionRunnable(std::function<void()> function)
+			: m_function(std::move(function))
+		{
+		}
+
+		virtual void run()
+		{
+			m_function();
+		}
+
+	private:
+		std::function<void()> m_function;
+};
+
+/*!
+ * Returns the position of the first game that starts at or after
+ * \a pos in \a data, or \a size if there is none.
+ */
+qint64 nextGameStart(const char* data, qint64 size, qint64 pos)
+{
+	if (pos <= 0)
+		return 0;
+
+	for (qint64 i = pos - 1; i + 8 <= size; i++)
+	{
+		if (data[i] == '\n'
+		&&  memcmp(data + i + 1, "[Event ", 7) == 0)
+			return i + 1;
+	}
+
+	return size;
+}
+
+} // anonymous namespace
+
 
 QDataStream& operator>>(QDataStream& in, OpeningBook* book)
 {
@@ -40,20 +92,43 @@ QDataStream& operator>>(QDataStream& in, OpeningBook* book)
 
 QDataStream& operator<<(QDataStream& out, const OpeningBook* book)
 {
-	OpeningBook::Map::const_iterator it;
-	for (it = book->m_map.constBegin(); it != book->m_map.constEnd(); ++it)
-		book->writeEntry(it, out);
+	book->sortEntries();
+	for (const OpeningBook::KeyedEntry& ke : qAsConst(book->m_entries))
+		book->writeEntry(ke.key, ke.entry, out);
 
 	return out;
 }
 
 OpeningBook::OpeningBook(AccessMode mode)
-	: m_mode(mode)
+	: m_mode(mode),
+	  m_sorted(true)
 {
 }
 
 OpeningBook::~OpeningBook()
 {
+	closeBookFiles();
+}
+
+void OpeningBook::closeBookFiles()
+{
+	for (const BookFile& bookFile : qAsConst(m_bookFiles))
+		delete bookFile.file;
+	m_bookFiles.clear();
+}
+
+QStringList OpeningBook::segmentFiles(const QString& filename)
+{
+	QStringList segments;
+	for (int i = 1;; i++)
+	{
+		QString segment = filename + ".d" + QString::number(i);
+		if (!QFile::exists(segment))
+			break;
+		segments.append(segment);
+	}
+
+	return segments;
 }
 
 bool OpeningBook::read(const QString& filename)
@@ -70,14 +145,73 @@ bool OpeningBook::read(const QString& filename)
 		return false;
 	}
 
+	QStringList names = segmentFiles(filename);
+	names.prepend(filename);
+
 	if (m_mode == Disk)
+	{
+		// Keep the base book and its delta segments open and
+		// memory-mapped so that probes can binary-search the
+		// records in place. If mapping a file fails, probes of
+		// that file fall back to buffered seeks.
+		closeBookFiles();
+		for (const QString& name : qAsConst(names))
+		{
+			QFile* bookFile = new QFile(name);
+			if (!bookFile->open(QIODevice::ReadOnly))
+			{
+				delete bookFile;
+				continue;
+			}
+			if ((bookFile->size() % entrySize()) != 0)
+			{
+				qWarning("Invalid size for opening book %s",
+					 qUtf8Printable(name));
+				delete bookFile;
+				continue;
+			}
+
+			BookFile bf = { name, bookFile, nullptr,
+					bookFile->size() };
+			bf.data = bookFile->map(0, bf.size);
+			if (bf.data == nullptr)
+			{
+				delete bookFile;
+				bf.file = nullptr;
+			}
+			m_bookFiles.append(bf);
+		}
+
 		return true;
+	}
 
-	m_map.clear();
-	QDataStream in(&file);
-	in >> this;
+	m_entries.clear();
+	m_sorted = true;
+	m_aliasCache.clear();
+
+	// Read the base book and every delta segment written since
+	// it was last compacted. Duplicate moves are merged, with
+	// their weights added, when the entries are sorted.
+	for (const QString& name : qAsConst(names))
+	{
+		QFile bookFile(name);
+		if (!bookFile.open(QIODevice::ReadOnly)
+		||  (bookFile.size() % entrySize()) != 0)
+		{
+			qWarning("Invalid delta segment %s",
+				 qUtf8Printable(name));
+			continue;
+		}
 
-	return !m_map.isEmpty();
+		QDataStream in(&bookFile);
+		in >> this;
+	}
+
+	// Everything read so far belongs to the book files, not to
+	// the next delta segment
+	m_deltaEntries.clear();
+
+	return !m_entries.isEmpty();
 }
 
 bool OpeningBook::write(const QString& filename) const
@@ -92,24 +226,113 @@ bool OpeningBook::write(const QString& filename) const
 	return true;
 }
 
+bool OpeningBook::writeDelta(const QString& filename)
+{
+	if (m_deltaEntries.isEmpty())
+		return true;
+
+	// A segment is a complete book file of its own: sorted, and
+	// with duplicate moves merged within the segment. Moves that
+	// also occur in the base book or in older segments keep their
+	// separate entries; read() adds the weights up.
+	sortAndMerge(m_deltaEntries);
+
+	// The first free segment number continues the chain
+	QString segment;
+	for (int i = 1;; i++)
+	{
+		segment = filename + ".d" + QString::number(i);
+		if (!QFile::exists(segment))
+			break;
+	}
+
+	QFile file(segment);
+	if (!file.open(QIODevice::WriteOnly))
+		return false;
+
+	QDataStream out(&file);
+	for (const KeyedEntry& ke : qAsConst(m_deltaEntries))
+		writeEntry(ke.key, ke.entry, out);
+	m_deltaEntries.clear();
+
+	return true;
+}
+
+bool OpeningBook::compact(const QString& filename)
+{
+	if (m_mode != Ram)
+	{
+		qWarning("Cannot compact opening book %s in disk mode",
+			 qUtf8Printable(filename));
+		return false;
+	}
+
+	QStringList segments = segmentFiles(filename);
+	if (!write(filename))
+		return false;
+
+	for (const QString& segment : qAsConst(segments))
+		QFile::remove(segment);
+	m_deltaEntries.clear();
+
+	return true;
+}
+
 void OpeningBook::addEntry(const Entry& entry, quint64 key)
 {
-	Map::iterator it = m_map.find(key);
-	while (it != m_map.end() && it.key() == key)
+	m_entries.append({ key, entry });
+	m_deltaEntries.append({ key, entry });
+	m_sorted = false;
+	m_aliasCache.clear();
+}
+
+void OpeningBook::sortAndMerge(EntryVector& entries)
+{
+	std::stable_sort(entries.begin(), entries.end(),
+	[](const KeyedEntry& a, const KeyedEntry& b)
 	{
-		Entry& tmp = it.value();
-		if (tmp.move == entry.move)
+		return a.key < b.key;
+	});
+
+	// Merge duplicate moves by adding their weights. Entries
+	// that share a key are adjacent now, and a position has at
+	// most a handful of distinct moves, so a linear scan over
+	// the current key's run is enough.
+	int count = 0;
+	for (int i = 0; i < entries.size(); i++)
+	{
+		const KeyedEntry& ke = entries.at(i);
+		bool merged = false;
+		for (int j = count - 1;
+		     j >= 0 && entries.at(j).key == ke.key; j--)
 		{
-			tmp.weight += entry.weight;
-			return;
+			if (entries.at(j).entry.move == ke.entry.move)
+			{
+				entries[j].entry.weight += ke.entry.weight;
+				merged = true;
+				break;
+			}
 		}
-		++it;
+		if (!merged)
+			entries[count++] = ke;
 	}
-	
-	m_map.insert(key, entry);
+	entries.resize(count);
 }
 
-int OpeningBook::import(const PgnGame& pgn, int maxMoves)
+void OpeningBook::sortEntries() const
+{
+	// Probes run on the game threads and the same book is shared
+	// by every concurrent game, so the first probe's sort must
+	// not race with another
+	QMutexLocker locker(&m_sortMutex);
+	if (m_sorted)
+		return;
+
+	sortAndMerge(m_entries);
+	m_sorted = true;
+}
+
+int OpeningBook::importGame(EntryVector& entries, const PgnGame& pgn, int maxMoves)
 {
 	Q_ASSERT(maxMoves > 0);
 
@@ -133,13 +356,127 @@ int OpeningBook::import(const PgnGame& pgn, int maxMoves)
 		if ((i % 2) != loserMod)
 		{
 			Entry entry = { moves.at(i).move, weight };
-			addEntry(entry, moves.at(i).key);
+			entries.append({ moves.at(i).key, entry });
 		}
 	}
 
 	return ret;
 }
 
+int OpeningBook::import(const PgnGame& pgn, int maxMoves)
+{
+	m_sorted = false;
+	m_aliasCache.clear();
+
+	int sizeBefore = m_entries.size();
+	int ret = importGame(m_entries, pgn, maxMoves);
+	for (int i = sizeBefore; i < m_entries.size(); i++)
+		m_deltaEntries.append(m_entries.at(i));
+
+	return ret;
+}
+
+int OpeningBook::importShard(EntryVector& entries,
+			     const QString& fileName,
+			     qint64 start,
+			     qint64 end,
+			     int maxMoves)
+{
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+		return 0;
+
+	PgnStream in(&file);
+	// Only the moves matter here; don't tokenize annotations
+	in.setSkipAnnotations(true);
+	if (!in.seek(start))
+		return 0;
+
+	int moveCount = 0;
+	while (in.status() == PgnStream::Ok)
+	{
+		// A game that starts at or after the shard boundary
+		// belongs to the next shard. Seeking to the next game
+		// here is harmless: PgnGame::read() does it again, and
+		// the stream doesn't move when it's already there.
+		if (!in.nextGame() || in.pos() >= end)
+			break;
+
+		PgnGame game;
+		game.read(in, maxMoves);
+		if (game.moves().isEmpty())
+			break;
+
+		moveCount += importGame(entries, game, maxMoves);
+	}
+
+	return moveCount;
+}
+
+int OpeningBook::importParallel(const QString& fileName, int maxMoves)
+{
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly))
+		return -1;
+
+	const qint64 size = file.size();
+	int shardCount = int(qMin(qint64(QThread::idealThreadCount()),
+				  size / s_minShardSize));
+	if (shardCount < 2)
+		return -1;
+
+	uchar* mapped = file.map(0, size);
+	if (mapped == nullptr)
+		return -1;
+	const char* data = reinterpret_cast<const char*>(mapped);
+
+	// Split the file into shards at game boundaries
+	QVector<qint64> bounds;
+	bounds.append(0);
+	for (int i = 1; i < shardCount; i++)
+	{
+		qint64 start = nextGameStart(data, size, size * i / shardCount);
+		if (start > bounds.last() && start < size)
+			bounds.append(start);
+	}
+	bounds.append(size);
+	const int shards = bounds.size() - 1;
+
+	// Parse the shards with a thread pool, accumulating entries
+	// into one vector per thread
+	QVector<EntryVector> vectors(shards);
+	QVector<int> counts(shards, 0);
+	QThreadPool pool;
+
+	for (int i = 0; i < shards; i++)
+	{
+		const qint64 start = bounds.at(i);
+		const qint64 end = bounds.at(i + 1);
+
+		pool.start(new FunctionRunnable(
+		[&vectors, &counts, i, fileName, start, end, maxMoves]()
+		{
+			counts[i] = importShard(vectors[i], fileName,
+						start, end, maxMoves);
+		}));
+	}
+	pool.waitForDone();
+
+	// Concatenate the shard vectors; entries for the same move
+	// are combined when the book is sorted
+	int moveCount = 0;
+	for (int i = 0; i < shards; i++)
+	{
+		moveCount += counts.at(i);
+		m_entries += vectors.at(i);
+		m_deltaEntries += vectors.at(i);
+	}
+	m_sorted = false;
+	m_aliasCache.clear();
+
+	return moveCount;
+}
+
 int OpeningBook::import(PgnStream& in, int maxMoves)
 {
 	Q_ASSERT(maxMoves > 0);
@@ -147,6 +484,19 @@ int OpeningBook::import(PgnStream& in, int maxMoves)
 	if (!in.isOpen())
 		return 0;
 
+	// Import file-based streams with multiple threads
+	QFileDevice* file = qobject_cast<QFileDevice*>(in.device());
+	if (file != nullptr && !file->fileName().isEmpty())
+	{
+		int moveCount = importParallel(file->fileName(), maxMoves);
+		if (moveCount >= 0)
+			return moveCount;
+	}
+
+	// Only the moves matter here; don't tokenize annotations
+	bool skip = in.skipAnnotations();
+	in.setSkipAnnotations(true);
+
 	int moveCount = 0;
 	while (in.status() == PgnStream::Ok)
 	{
@@ -157,18 +507,111 @@ int OpeningBook::import(PgnStream& in, int maxMoves)
 
 		moveCount += import(game, maxMoves);
 	}
+	in.setSkipAnnotations(skip);
 
 	return moveCount;
 }
 
+OpeningBook::Entry OpeningBook::readEntry(const uchar* data, quint64* key) const
+{
+	QByteArray buf(QByteArray::fromRawData(
+	    reinterpret_cast<const char*>(data), entrySize()));
+	QDataStream in(buf);
+
+	return readEntry(in, key);
+}
+
 QList<OpeningBook::Entry> OpeningBook::entriesFromDisk(quint64 key) const
+{
+	// Probe the base book by name if read() wasn't called
+	if (m_bookFiles.isEmpty())
+	{
+		BookFile bf = { m_filename, nullptr, nullptr, 0 };
+		return entriesFromSegment(bf, key);
+	}
+
+	QList<Entry> entries;
+	for (const BookFile& bookFile : m_bookFiles)
+	{
+		const auto found = entriesFromSegment(bookFile, key);
+
+		// The same move can occur in the base book and in
+		// delta segments; add the weights up like sorting
+		// does for in-memory entries
+		for (const Entry& entry : found)
+		{
+			bool merged = false;
+			for (Entry& existing : entries)
+			{
+				if (existing.move == entry.move)
+				{
+					existing.weight += entry.weight;
+					merged = true;
+					break;
+				}
+			}
+			if (!merged)
+				entries << entry;
+		}
+	}
+
+	return entries;
+}
+
+QList<OpeningBook::Entry> OpeningBook::entriesFromSegment(const BookFile& bookFile,
+							  quint64 key) const
 {
 	QList<Entry> entries;
-	QFile file(m_filename);
+
+	if (bookFile.data != nullptr)
+	{
+		const qint64 step = entrySize();
+		const qint64 n = bookFile.size / step;
+		quint64 entryKey = 0;
+		qint64 first = 0;
+		qint64 last = n - 1;
+
+		// Binary search in the mapped book
+		while (first <= last)
+		{
+			qint64 middle = (first + last) / 2;
+			Entry entry = readEntry(bookFile.data + middle * step,
+						&entryKey);
+			if (entryKey < key)
+				first = middle + 1;
+			else if (entryKey == key)
+			{
+				entries << entry;
+				for (qint64 i = middle - 1; i >= 0; i--)
+				{
+					entry = readEntry(bookFile.data + i * step,
+							  &entryKey);
+					if (entryKey != key)
+						break;
+					entries << entry;
+				}
+				for (qint64 i = middle + 1; i < n; i++)
+				{
+					entry = readEntry(bookFile.data + i * step,
+							  &entryKey);
+					if (entryKey != key)
+						break;
+					entries << entry;
+				}
+				break;
+			}
+			else
+				last = middle - 1;
+		}
+
+		return entries;
+	}
+
+	QFile file(bookFile.fileName);
 	if (!file.open(QIODevice::ReadOnly))
 	{
 		qWarning("Could not open book file %s",
-			 qUtf8Printable(m_filename));
+			 qUtf8Printable(bookFile.fileName));
 		return entries;
 	}
 	QDataStream in(&file);
@@ -220,38 +663,128 @@ QList<OpeningBook::Entry> OpeningBook::entriesFromDisk(quint64 key) const
 
 QList<OpeningBook::Entry> OpeningBook::entries(quint64 key) const
 {
-	if (m_mode == Ram)
-		return m_map.values(key);
-	return entriesFromDisk(key);
+	if (m_mode != Ram)
+		return entriesFromDisk(key);
+
+	sortEntries();
+
+	QList<Entry> entries;
+	auto it = std::lower_bound(m_entries.constBegin(),
+				   m_entries.constEnd(), key,
+	[](const KeyedEntry& ke, quint64 key)
+	{
+		return ke.key < key;
+	});
+	for (; it != m_entries.constEnd() && it->key == key; ++it)
+		entries << it->entry;
+
+	return entries;
 }
 
-Chess::GenericMove OpeningBook::move(quint64 key) const
+OpeningBook::AliasTable OpeningBook::buildAliasTable(quint64 key) const
 {
-	Chess::GenericMove move;
-	
-	// There can be multiple entries/moves with the same key.
-	// We need to find them all to choose the best one
+	AliasTable table;
+	table.total = 0;
+
 	const auto entries = this->entries(key);
 	if (entries.isEmpty())
-		return move;
-	
-	// Calculate the total weight of all available moves
-	int totalWeight = 0;
+		return table;
+
+	quint32 total = 0;
 	for (const Entry& entry : entries)
-		totalWeight += entry.weight;
-	if (totalWeight <= 0)
+		total += entry.weight;
+	if (total == 0)
+		return table;
+
+	const int n = entries.size();
+	table.moves.reserve(n);
+	QVector<qint64> scaled(n);
+	for (int i = 0; i < n; i++)
+	{
+		table.moves.append(entries.at(i).move);
+		scaled[i] = qint64(entries.at(i).weight) * n;
+	}
+
+	// Vose's alias method: distribute the weights into n columns
+	// of equal capacity, each shared by at most two moves
+	table.alias.fill(0, n);
+	table.threshold.fill(0, n);
+	QVector<int> small;
+	QVector<int> large;
+	for (int i = 0; i < n; i++)
+	{
+		if (scaled.at(i) < total)
+			small.append(i);
+		else
+			large.append(i);
+	}
+	while (!small.isEmpty() && !large.isEmpty())
+	{
+		int s = small.takeLast();
+		int l = large.last();
+		table.threshold[s] = quint32(scaled.at(s));
+		table.alias[s] = l;
+		scaled[l] -= qint64(total) - scaled.at(s);
+		if (scaled.at(l) < total)
+		{
+			large.removeLast();
+			small.append(l);
+		}
+	}
+	// The leftover columns are full; a column can end up in the
+	// wrong list only through rounding
+	while (!large.isEmpty())
+		table.threshold[large.takeLast()] = total;
+	while (!small.isEmpty())
+		table.threshold[small.takeLast()] = total;
+	table.total = total;
+
+	return table;
+}
+
+Chess::GenericMove OpeningBook::move(quint64 key) const
+{
+	Chess::GenericMove move;
+
+	// There can be multiple entries/moves with the same key. The
+	// alias table over them makes the weighted pick O(1), and is
+	// built only on the first probe of the position. The table is
+	// copied out of the cache (cheap, the vectors are implicitly
+	// shared) so that no reference into the hash is held without
+	// the lock.
+	AliasTable table;
+	bool cached = false;
+	{
+		QMutexLocker locker(&m_cacheMutex);
+		const auto it = m_aliasCache.constFind(key);
+		if (it != m_aliasCache.constEnd())
+		{
+			table = it.value();
+			cached = true;
+		}
+	}
+	if (!cached)
+	{
+		// Built outside the lock: probing the entries may take
+		// the sort mutex. Two threads can build the same
+		// table; the second insert is a harmless overwrite.
+		table = buildAliasTable(key);
+
+		QMutexLocker locker(&m_cacheMutex);
+		m_aliasCache.insert(key, table);
+	}
+
+	const int n = table.moves.size();
+	if (n == 0 || table.total == 0)
 		return move;
+	if (n == 1)
+		return table.moves.first();
 
 	// Pick a move randomly, with the highest-weighted move having
 	// the highest probability of getting picked.
-	int pick = Mersenne::random() % totalWeight;
-	int currentWeight = 0;
-	for (const Entry& entry : entries)
-	{
-		currentWeight += entry.weight;
-		if (currentWeight > pick)
-			return entry.move;
-	}
-	
-	return move;
+	int i = Mersenne::random() % n;
+	if (Mersenne::random() % table.total >= table.threshold.at(i))
+		i = table.alias.at(i);
+
+	return table.moves.at(i);
 }
@@ -20,11 +20,15 @@
 #define OPENING_BOOK_H
 
 #include <QtGlobal>
-#include <QMultiMap>
+#include <QVector>
+#include <QHash>
+#include <QMutex>
+#include <QStringList>
 #include "board/genericmove.h"
 
 class QString;
 class QDataStream;
+class QFile;
 class PgnGame;
 class PgnStream;
 
@@ -32,7 +36,7 @@ class PgnStream;
 /*!
  * \brief A collection of opening moves for chess.
  *
- * OpeningBook is a container (binary tree) class for opening moves that
+ * OpeningBook is a container (sorted array) class for opening moves that
  * can be played by the GUI. When the game goes "out of book", control
  * of the game is transferred to the players.
  *
@@ -47,7 +51,15 @@ class LIB_EXPORT OpeningBook
 		enum AccessMode
 		{
 			Ram,	//!< Load the entire book to RAM
-			Disk	//!< Read moves directly from disk
+			/*!
+			 * Read moves directly from disk.
+			 *
+			 * The book file is memory-mapped when possible, so
+			 * probes binary-search the sorted entries in place
+			 * with no parsing at startup and no resident
+			 * overhead beyond the pages that are touched.
+			 */
+			Disk
 		};
 
 		/*!
@@ -109,7 +121,7 @@ class LIB_EXPORT OpeningBook
 		Chess::GenericMove move(quint64 key) const;
 
 		/*! Returns all entries matching \a key. */
-		QList<Entry> entries(quint64 key) const;
+		virtual QList<Entry> entries(quint64 key) const;
 
 		/*!
 		 * Reads a book from \a filename.
@@ -118,18 +130,65 @@ class LIB_EXPORT OpeningBook
 		bool read(const QString& filename);
 
 		/*!
-		 * Writes the book to \a filename.
+		 * Writes the whole book to \a filename.
 		 * Returns true if successful; otherwise returns false.
+		 * \sa writeDelta()
 		 */
 		bool write(const QString& filename) const;
 
+		/*!
+		 * Writes the entries added to the book since it was read
+		 * as a new delta segment next to \a filename.
+		 *
+		 * The segment is a complete, sorted book file of its own,
+		 * named "<filename>.dN" with the first free segment
+		 * number N. read() merges the base file and its segments,
+		 * adding the weights of moves that appear in several of
+		 * them, so updating a big book means appending a small
+		 * segment instead of rewriting the whole file.
+		 *
+		 * Returns true if successful; otherwise returns false.
+		 * \sa compact()
+		 */
+		bool writeDelta(const QString& filename);
+		/*!
+		 * Merges the base file \a filename and all of its delta
+		 * segments into a single sorted book file and removes
+		 * the segments.
+		 *
+		 * The book must have been read in \a Ram mode, so that
+		 * the segments' entries are in memory.
+		 *
+		 * Returns true if successful; otherwise returns false.
+		 */
+		bool compact(const QString& filename);
+		/*!
+		 * Returns the delta segment files of book file
+		 * \a filename, oldest first.
+		 */
+		static QStringList segmentFiles(const QString& filename);
+
 
 	protected:
 		friend LIB_EXPORT QDataStream& operator>>(QDataStream& in, OpeningBook* book);
 		friend LIB_EXPORT QDataStream& operator<<(QDataStream& out, const OpeningBook* book);
 
-		/*! The type of binary tree. */
-		typedef QMultiMap<quint64, Entry> Map;
+		/*! An entry paired with its Zobrist key. */
+		struct KeyedEntry
+		{
+			/*! The Zobrist key of the entry's position. */
+			quint64 key;
+			/*! The entry itself. */
+			Entry entry;
+		};
+
+		/*!
+		 * The type of the in-memory entry storage: a flat
+		 * vector that is kept sorted by key, so probes are
+		 * cache-friendly binary searches and inserts are
+		 * plain appends.
+		 */
+		typedef QVector<KeyedEntry> EntryVector;
 
 		/*! Returns the book format's internal entry size in bytes. */
 		virtual int entrySize() const = 0;
@@ -144,17 +203,82 @@ class LIB_EXPORT OpeningBook
 		 * belongs to the entry.
 		 */
 		virtual Entry readEntry(QDataStream& in, quint64* key) const = 0;
-		
-		/*! Writes the key and entry pointed to by \a it, to \a out. */
-		virtual void writeEntry(const Map::const_iterator& it,
+
+		/*!
+		 * Reads a book entry from raw \a data (eg. a record in a
+		 * memory-mapped book file) and returns it.
+		 *
+		 * The implementation must set \a key to the hash that
+		 * belongs to the entry. The default implementation wraps
+		 * \a data in a data stream; subclasses can override it
+		 * to decode the record in place.
+		 */
+		virtual Entry readEntry(const uchar* data, quint64* key) const;
+
+		/*! Writes \a key and \a entry to \a out. */
+		virtual void writeEntry(quint64 key,
+					const Entry& entry,
 					QDataStream& out) const = 0;
 
 	private:
+		// Alias table over one position's entries, for O(1)
+		// weighted move selection
+		struct AliasTable
+		{
+			QVector<Chess::GenericMove> moves;
+			QVector<int> alias;
+			QVector<quint32> threshold;
+			quint32 total;
+		};
+
+		static int importGame(EntryVector& entries,
+				      const PgnGame& pgn,
+				      int maxMoves);
+		static int importShard(EntryVector& entries,
+				       const QString& fileName,
+				       qint64 start,
+				       qint64 end,
+				       int maxMoves);
+		// One book file of a disk-mode book: the base file or
+		// a delta segment
+		struct BookFile
+		{
+			QString fileName;
+			QFile* file;
+			const uchar* data;
+			qint64 size;
+		};
+
+		static void sortAndMerge(EntryVector& entries);
+		int importParallel(const QString& fileName, int maxMoves);
+		void sortEntries() const;
+		AliasTable buildAliasTable(quint64 key) const;
 		QList<Entry> entriesFromDisk(quint64 key) const;
+		QList<Entry> entriesFromSegment(const BookFile& bookFile,
+						quint64 key) const;
+		void closeBookFiles();
 
 		AccessMode m_mode;
 		QString m_filename;
-		Map m_map;
+		// Imports append unsorted; the vector is sorted and
+		// duplicate moves are merged on the first probe or write.
+		// The same book is shared by every concurrent game, so
+		// the lazy sort is guarded by m_sortMutex.
+		mutable EntryVector m_entries;
+		mutable bool m_sorted;
+		mutable QMutex m_sortMutex;
+		// Entries added since the last read() or compact(), for
+		// writeDelta()
+		EntryVector m_deltaEntries;
+		// Lazily built alias tables, keyed by position. The same
+		// early positions are probed by every game of an event,
+		// so the weighted pick is precomputed once per position.
+		// Guarded by m_cacheMutex; probes run on the game
+		// threads.
+		mutable QHash<quint64, AliasTable> m_aliasCache;
+		mutable QMutex m_cacheMutex;
+		// The base book and its delta segments in disk mode
+		QVector<BookFile> m_bookFiles;
 };
 
 /*!
@@ -17,15 +17,30 @@
 */
 
 #include "openingsuite.h"
+#include <QBuffer>
+#include <QDataStream>
+#include <QDateTime>
 #include <QFile>
+#include <QFileInfo>
+#include <QSet>
 #include <QTextStream>
+#include "board/board.h"
+#include "gzipdevice.h"
 #include "pgnstream.h"
 #include "epdrecord.h"
 #include "mersenne.h"
 
+namespace {
+
+const quint32 s_indexMagic = 0x4F505349;	// "OPSI"
+const quint32 s_indexVersion = 1;
+
+} // anonymous namespace
+
 OpeningSuite::OpeningSuite(const QString& fen)
 	: m_format(EpdFormat),
 	  m_order(SequentialOrder),
+	  m_dedupe(false),
 	  m_gamesRead(0),
 	  m_gameIndex(0),
 	  m_startIndex(0),
@@ -42,6 +57,7 @@ OpeningSuite::OpeningSuite(const QString& fileName,
 			   int startIndex)
 	: m_format(format),
 	  m_order(order),
+	  m_dedupe(false),
 	  m_gamesRead(0),
 	  m_gameIndex(0),
 	  m_startIndex(startIndex),
@@ -81,6 +97,11 @@ bool OpeningSuite::isNull() const
 	return m_epdStream == nullptr && m_pgnStream == nullptr;
 }
 
+void OpeningSuite::setDeduplication(bool enabled)
+{
+	m_dedupe = enabled;
+}
+
 bool OpeningSuite::initialize()
 {
 	if (!m_fen.isEmpty())
@@ -103,21 +124,57 @@ bool OpeningSuite::initialize()
 		m_pgnStream = nullptr;
 	}
 
-	m_file = new QFile(m_fileName);
-	if (!m_file->open(QIODevice::ReadOnly | QIODevice::Text))
+	const bool gzipped = m_fileName.endsWith(QLatin1String(".gz"),
+						 Qt::CaseInsensitive);
+
+	QFile* file = new QFile(m_fileName);
+	QIODevice::OpenMode mode = QIODevice::ReadOnly;
+	if (!gzipped)
+		mode |= QIODevice::Text;
+	if (!file->open(mode))
 	{
 		qWarning("Can't open opening suite %s",
 			 qUtf8Printable(m_fileName));
-		delete m_file;
+		delete file;
 		return false;
 	}
+	m_file = file;
+
+	if (gzipped)
+	{
+		// Openings are looked up by file position, which a gzip
+		// stream can't seek to, so decompress the suite into
+		// memory and read it from there.
+		GzipDevice gzip(file);
+		QByteArray data;
+		if (gzip.open(QIODevice::ReadOnly))
+			data = gzip.readAll();
+		delete file;
+		m_file = nullptr;
+
+		if (data.isEmpty())
+		{
+			qWarning("Can't decompress opening suite %s",
+				 qUtf8Printable(m_fileName));
+			return false;
+		}
+
+		QBuffer* buffer = new QBuffer;
+		buffer->setData(data);
+		buffer->open(QIODevice::ReadOnly | QIODevice::Text);
+		m_file = buffer;
+	}
 
 	if (m_format == PgnFormat)
 		m_pgnStream = new PgnStream(m_file);
 
-	if (m_order == RandomOrder)
+	// Load the offset index persisted beside the suite file, or
+	// build it with one pass over the file. With the index every
+	// opening can be seeked to directly, so resuming a tournament
+	// at a high start index or picking openings at random doesn't
+	// scan the file again.
+	if (!loadIndex())
 	{
-		// Create a shuffled vector of file positions
 		for (;;)
 		{
 			FilePosition pos;
@@ -129,30 +186,13 @@ bool OpeningSuite::initialize()
 			if (pos.pos == -1)
 				break;
 
-			int i = Mersenne::random() % (m_filePositions.size() + 1);
-			if (i == m_filePositions.size())
-				m_filePositions.append(pos);
-			else
-			{
-				m_filePositions.append(m_filePositions.at(i));
-				m_filePositions[i] = pos;
-			}
+			m_filePositions.append(pos);
 		}
+		saveIndex();
 	}
-	else if (m_order == SequentialOrder)
-	{
-		for (int i = 0; i < m_startIndex; i++)
-		{
-			FilePosition pos;
-			if (m_format == EpdFormat)
-				pos = getEpdPos();
-			else if (m_format == PgnFormat)
-				pos = getPgnPos();
 
-			if (pos.pos == -1)
-				break;
-		}
-	}
+	if (m_order == RandomOrder)
+		shuffle();
 
 	if (m_format == EpdFormat)
 	{
@@ -160,6 +200,25 @@ bool OpeningSuite::initialize()
 		m_epdStream = new QTextStream(m_file);
 	}
 
+	if (m_dedupe)
+		deduplicate();
+
+	if (m_order == SequentialOrder)
+	{
+		// Seek straight to the first opening
+		if (m_startIndex > 0
+		&&  m_startIndex < m_filePositions.size())
+		{
+			FilePosition pos = m_filePositions.at(m_startIndex);
+			if (m_format == EpdFormat)
+				m_epdStream->seek(pos.pos);
+			else if (m_format == PgnFormat)
+				m_pgnStream->seek(pos.pos, pos.lineNumber);
+		}
+		else if (m_format == PgnFormat)
+			m_pgnStream->rewind();
+	}
+
 	return true;
 }
 
@@ -180,7 +239,14 @@ PgnGame OpeningSuite::nextGame(int maxPlies)
 	{
 		pos = m_filePositions.at(m_gameIndex++);
 		if (m_gameIndex >= m_filePositions.size())
+		{
+			// The epoch is over: every opening was used
+			// exactly once. Reshuffle so the next epoch
+			// walks a fresh permutation instead of
+			// repeating this one.
 			m_gameIndex = 0;
+			shuffle();
+		}
 	}
 
 	bool ok = false;
@@ -228,6 +294,162 @@ PgnGame OpeningSuite::nextGame(int maxPlies)
 	return game;
 }
 
+void OpeningSuite::shuffle()
+{
+	// Fisher-Yates shuffle of the file positions. The picks come
+	// from the caller's Mersenne stream, so a shared seed yields
+	// the same permutations everywhere.
+	for (int i = m_filePositions.size() - 1; i > 0; i--)
+	{
+		int j = Mersenne::random() % (i + 1);
+		qSwap(m_filePositions[i], m_filePositions[j]);
+	}
+}
+
+void OpeningSuite::deduplicate()
+{
+	QSet<quint64> keys;
+	QVector<FilePosition> unique;
+	unique.reserve(m_filePositions.size());
+
+	for (const FilePosition& pos : qAsConst(m_filePositions))
+	{
+		PgnGame game;
+		bool ok = false;
+
+		if (m_format == EpdFormat)
+		{
+			m_epdStream->seek(pos.pos);
+			m_epdStream->resetStatus();
+
+			EpdRecord epd;
+			ok = epd.parse(*m_epdStream);
+
+			Chess::Side side(epd.fen().section(' ', 1, 1));
+			game.setStartingFenString(side, epd.fen());
+		}
+		else if (m_format == PgnFormat)
+		{
+			m_pgnStream->seek(pos.pos, pos.lineNumber);
+			ok = game.read(*m_pgnStream);
+		}
+
+		// Keep openings that can't be parsed; nextGame() will
+		// deal with them
+		if (!ok)
+		{
+			unique.append(pos);
+			continue;
+		}
+
+		quint64 key = game.key();
+		if (game.moves().isEmpty())
+		{
+			// There are no moves to replay, so the key comes
+			// straight from the starting position
+			Chess::Board* board = game.createBoard();
+			if (board == nullptr)
+			{
+				unique.append(pos);
+				continue;
+			}
+			key = board->key();
+			delete board;
+		}
+
+		if (keys.contains(key))
+			continue;
+		keys.insert(key);
+		unique.append(pos);
+	}
+
+	int elided = m_filePositions.size() - unique.size();
+	if (elided > 0)
+		qInfo("Elided %d duplicate or transposed opening(s) from %s",
+		      elided, qUtf8Printable(m_fileName));
+
+	m_filePositions = unique;
+
+	// Rewind the streams moved by the scan
+	if (m_format == EpdFormat)
+	{
+		m_epdStream->seek(0);
+		m_epdStream->resetStatus();
+	}
+	else if (m_format == PgnFormat)
+		m_pgnStream->rewind();
+}
+
+bool OpeningSuite::loadIndex()
+{
+	QFile file(m_fileName + ".idx");
+	if (!file.open(QIODevice::ReadOnly))
+		return false;
+
+	QDataStream in(&file);
+	in.setVersion(QDataStream::Qt_4_6);
+
+	quint32 magic;
+	quint32 version;
+	qint32 format;
+	qint64 fileSize;
+	QDateTime lastModified;
+
+	in >> magic >> version >> format >> fileSize >> lastModified;
+
+	// The index is only valid for an unchanged suite file
+	QFileInfo fileInfo(m_fileName);
+	if (magic != s_indexMagic
+	||  version != s_indexVersion
+	||  format != qint32(m_format)
+	||  fileSize != fileInfo.size()
+	||  lastModified != fileInfo.lastModified())
+		return false;
+
+	qint32 count;
+	in >> count;
+	if (count < 0)
+		return false;
+
+	QVector<FilePosition> positions;
+	positions.reserve(count);
+	for (qint32 i = 0; i < count; i++)
+	{
+		FilePosition pos;
+		in >> pos.pos >> pos.lineNumber;
+		positions.append(pos);
+	}
+	if (in.status() != QDataStream::Ok)
+		return false;
+
+	m_filePositions = positions;
+	return true;
+}
+
+void OpeningSuite::saveIndex() const
+{
+	QFile file(m_fileName + ".idx");
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+		return;
+
+	QDataStream out(&file);
+	out.setVersion(QDataStream::Qt_4_6);
+
+	QFileInfo fileInfo(m_fileName);
+	out << s_indexMagic;
+	out << s_indexVersion;
+	out << qint32(m_format);
+	out << fileInfo.size();
+	out << fileInfo.lastModified();
+
+	out << qint32(m_filePositions.size());
+	for (const FilePosition& pos : m_filePositions)
+	{
+		out << pos.pos;
+		out << pos.lineNumber;
+	}
+}
+
 OpeningSuite::FilePosition OpeningSuite::getPgnPos()
 {
 	FilePosition pos = { -1, -1 };
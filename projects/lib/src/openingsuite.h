@@ -22,7 +22,7 @@
 #include <QVector>
 #include "pgngame.h"
 class QString;
-class QFile;
+class QIODevice;
 class QTextStream;
 class PgnStream;
 
@@ -51,7 +51,12 @@ class LIB_EXPORT OpeningSuite
 		enum Order
 		{
 			SequentialOrder,	//!< Sequential order
-			RandomOrder		//!< Random order
+			/*!
+			 * Shuffled order: each pass over the suite uses
+			 * every opening exactly once, and a new
+			 * permutation is drawn for the next pass.
+			 */
+			RandomOrder
 		};
 
 		/*!
@@ -88,14 +93,31 @@ class LIB_EXPORT OpeningSuite
 		 */
 		bool isNull() const;
 
+		/*!
+		 * Sets opening deduplication to \a enabled.
+		 *
+		 * When deduplication is enabled, initialize() computes
+		 * the Zobrist key of every opening's end position and
+		 * elides openings whose key was already seen. This
+		 * catches both exact duplicates and transpositions, so
+		 * suites that accumulated them don't waste games on
+		 * repeated openings. The number of elided openings is
+		 * reported.
+		 *
+		 * \note Must be set before calling initialize().
+		 */
+		void setDeduplication(bool enabled);
+
 		/*!
 		 * Initializes the opening suite.
 		 *
-		 * If \a order is SequentialOrder, this function just opens
-		 * the opening suite file and gets ready to read data. If
-		 * \a order is RandomOrder, the file positions of all the
-		 * openings are parsed from the file, which could take some
-		 * time if the file is large.
+		 * This function opens the opening suite file and loads
+		 * the file positions of all the openings, either from an
+		 * index file persisted beside the suite file or by one
+		 * pass over the file, which could take some time if the
+		 * file is large. With the index, picking openings at
+		 * random and starting at a high start index both seek
+		 * straight to the right opening.
 		 *
 		 * Returns true if successful; otherwise returns false.
 		 */
@@ -115,15 +137,20 @@ class LIB_EXPORT OpeningSuite
 
 		FilePosition getPgnPos();
 		FilePosition getEpdPos();
+		bool loadIndex();
+		void saveIndex() const;
+		void shuffle();
+		void deduplicate();
 
 		Format m_format;
 		Order m_order;
+		bool m_dedupe;
 		int m_gamesRead;
 		int m_gameIndex;
 		int m_startIndex;
 		QString m_fileName;
 		QString m_fen;
-		QFile* m_file;
+		QIODevice* m_file;
 		QTextStream* m_epdStream;
 		PgnStream* m_pgnStream;
 		QVector<FilePosition> m_filePositions;
@@ -23,16 +23,25 @@
 #include <QDateTime>
 #include "board/boardfactory.h"
 #include "econode.h"
+#include "gzipdevice.h"
 #include "pgnstream.h"
 
 namespace {
 
-void writeTag(QTextStream& out, const QString& tag, const QString& value)
+//! A reusable per-thread buffer for formatting games, so that
+//! concurrent games don't pay repeated allocations per write.
+thread_local QByteArray s_renderBuffer;
+
+void renderTag(QByteArray& out, const QString& tag, const QString& value)
 {
+	out += '[';
+	out += tag.toUtf8();
+	out += " \"";
 	if (!value.isEmpty())
-		out << "[" << tag << " \"" << value << "\"]\n";
+		out += value.toUtf8();
 	else
-		out << "[" << tag << " \"?\"]\n";
+		out += '?';
+	out += "\"]\n";
 }
 
 } // anonymous namespace
@@ -192,7 +201,8 @@ bool PgnGame::parseMove(PgnStream& in, bool addEco)
 		m_startingSide = board->startingSide();
 	}
 
-	const QString str(in.tokenString());
+	const QByteArray token(in.tokenString());
+	const QString str(QString::fromUtf8(token));
 	Chess::Move move(board->moveFromString(str));
 	if (move.isNull())
 	{
@@ -201,7 +211,7 @@ bool PgnGame::parseMove(PgnStream& in, bool addEco)
 	}
 
 	MoveData md = { board->key(), board->genericMove(move),
-			str, QString() };
+			token, QByteArray() };
 	board->makeMove(move);
 	addMove(md, board->key(), addEco);
 
@@ -268,85 +278,137 @@ bool PgnGame::read(PgnStream& in, int maxMoves, bool addEco)
 	return true;
 }
 
-bool PgnGame::write(QTextStream& out, PgnMode mode) const
+void PgnGame::render(QByteArray& out, PgnMode mode) const
 {
-	if (m_tags.isEmpty())
-		return false;
-	
 	const QList< QPair<QString, QString> > tags = this->tags();
 	int maxTags = (mode == Verbose) ? tags.size() : 7;
 	for (int i = 0; i < maxTags; i++)
-		writeTag(out, tags.at(i).first, tags.at(i).second);
-	
+		renderTag(out, tags.at(i).first, tags.at(i).second);
+
 	if (mode == Minimal && m_tags.contains("FEN"))
 	{
-		writeTag(out, "FEN", m_tags["FEN"]);
-		writeTag(out, "SetUp", m_tags["SetUp"]);
+		renderTag(out, "FEN", m_tags["FEN"]);
+		renderTag(out, "SetUp", m_tags["SetUp"]);
 	}
 
 	if (mode == Minimal && m_tags.contains("Variant")
 	&&  variant() != "standard")
 	{
-		writeTag(out, "Variant", m_tags["Variant"]);
+		renderTag(out, "Variant", m_tags["Variant"]);
 	}
 
-	QString str;
+	QByteArray str;
 	int lineLength = 0;
 	int movenum = 0;
 	int side = m_startingSide;
 
 	if (!m_initialComment.isEmpty())
-		out << "\n" << "{" << m_initialComment << "}";
+	{
+		out += "\n{";
+		out += m_initialComment.toUtf8();
+		out += '}';
+	}
 
 	for (int i = 0; i < m_moves.size(); i++)
 	{
 		const MoveData& data = m_moves.at(i);
 
-		str.clear();
+		str.resize(0);
 		if (i == 0 && side == Chess::Side::Black)
-			str = QString::number(++movenum) + "... ";
+		{
+			str += QByteArray::number(++movenum);
+			str += "... ";
+		}
 		else if (side == Chess::Side::White)
-			str = QString::number(++movenum) + ". ";
+		{
+			str += QByteArray::number(++movenum);
+			str += ". ";
+		}
 
 		str += data.moveString;
 		if (mode == Verbose && !data.comment.isEmpty())
-			str += QString(" {%1}").arg(data.comment);
+		{
+			str += " {";
+			str += data.comment;
+			str += '}';
+		}
 
 		// Limit the lines to 80 characters
 		if (lineLength == 0 || lineLength + str.size() >= 80)
 		{
-			out << "\n" << str;
+			out += '\n';
+			out += str;
 			lineLength = str.size();
 		}
 		else
 		{
-			out << " " << str;
+			out += ' ';
+			out += str;
 			lineLength += str.size() + 1;
 		}
 
 		side = !side;
 	}
 
-	str = m_tags.value("Result");
+	str = m_tags.value("Result").toUtf8();
 
 	if (lineLength + str.size() >= 80)
-		out << "\n" << str << "\n\n";
+		out += '\n';
 	else
-		out << " " << str << "\n\n";
+		out += ' ';
+	out += str;
+	out += "\n\n";
+}
 
+bool PgnGame::write(QTextStream& out, PgnMode mode) const
+{
+	if (m_tags.isEmpty())
+		return false;
+
+	s_renderBuffer.resize(0);
+	render(s_renderBuffer, mode);
+	out << QString::fromUtf8(s_renderBuffer);
 	out.flush();
 
 	return (out.status() == QTextStream::Ok);
 }
 
+bool PgnGame::write(QIODevice* device, PgnMode mode) const
+{
+	Q_ASSERT(device != nullptr);
+
+	if (m_tags.isEmpty())
+		return false;
+
+	// Format the whole game into a reused buffer and push it to
+	// the device with one write
+	s_renderBuffer.resize(0);
+	render(s_renderBuffer, mode);
+
+	return device->write(s_renderBuffer) == s_renderBuffer.size();
+}
+
 bool PgnGame::write(const QString& filename, PgnMode mode) const
 {
 	QFile file(filename);
 	if (!file.open(QIODevice::WriteOnly | QIODevice::Append))
 		return false;
 
-	QTextStream out(&file);
-	return write(out, mode);
+	if (filename.endsWith(QLatin1String(".gz"), Qt::CaseInsensitive))
+	{
+		// Each append becomes a new gzip member, which
+		// concatenates into a valid gzip stream.
+		GzipDevice gzip(&file);
+		if (!gzip.open(QIODevice::WriteOnly))
+			return false;
+
+		bool ok = write(&gzip, mode);
+		gzip.close();
+
+		return ok;
+	}
+
+	return write(&file, mode);
 }
 
 bool PgnGame::isStandard() const
@@ -541,7 +603,7 @@ void PgnGame::setResultDescription(const QString& description)
 		return;
 	}
 
-	QString& comment = m_moves.last().comment;
+	QByteArray& comment = m_moves.last().comment;
 	if (!comment.isEmpty())
 	{
 		if (comment[comment.size() - 1] != ',')
@@ -549,7 +611,7 @@ void PgnGame::setResultDescription(const QString& description)
 		comment += ' ';
 	}
 
-	comment += description;
+	comment += description.toUtf8();
 }
 
 void PgnGame::setTagReceiver(QObject* receiver)
@@ -28,6 +28,7 @@
 #include "board/genericmove.h"
 #include "board/result.h"
 class QTextStream;
+class QIODevice;
 class PgnStream;
 class EcoNode;
 class QObject;
@@ -60,7 +61,14 @@ class LIB_EXPORT PgnGame
 			Verbose
 		};
 
-		/*! \brief A struct for storing the game's move history. */
+		/*!
+		 * \brief A struct for storing the game's move history.
+		 *
+		 * The strings are stored as UTF-8 bytes instead of
+		 * QStrings, which roughly halves the footprint of a
+		 * game held in memory; long runs and bulk imports keep
+		 * millions of them around.
+		 */
 		struct MoveData
 		{
 			/*! The zobrist position key before the move. */
@@ -68,9 +76,9 @@ class LIB_EXPORT PgnGame
 			/*! The move in the "generic" format. */
 			Chess::GenericMove move;
 			/*! The move in Standard Algebraic Notation. */
-			QString moveString;
+			QByteArray moveString;
 			/*! A comment/annotation describing the move. */
-			QString comment;
+			QByteArray comment;
 		};
 
 		/*! Creates a new PgnGame object. */
@@ -120,6 +128,17 @@ class LIB_EXPORT PgnGame
 		 * Returns true if successful; otherwise returns false.
 		 */
 		bool write(QTextStream& out, PgnMode mode = Verbose) const;
+		/*!
+		 * Writes the game to an I/O device.
+		 *
+		 * The game is formatted (UTF-8) into a reused per-thread
+		 * buffer and written to \a device with a single write,
+		 * which is the cheapest way to emit large volumes of
+		 * games.
+		 *
+		 * Returns true if successful; otherwise returns false.
+		 */
+		bool write(QIODevice* device, PgnMode mode = Verbose) const;
 		/*!
 		 * Writes the game to a file.
 		 * If the file already exists, the game will be appended
@@ -217,7 +236,8 @@ class LIB_EXPORT PgnGame
 
 	private:
 		bool parseMove(PgnStream& in, bool addEco);
-		
+		void render(QByteArray& out, PgnMode mode) const;
+
 		Chess::Side m_startingSide;
 		QMap<QString, QString> m_tags;
 		QVector<MoveData> m_moves;
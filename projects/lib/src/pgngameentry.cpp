@@ -20,6 +20,10 @@
 #include <cctype>
 #include <QDataStream>
 #include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+#include <QtEndian>
 #include "pgnstream.h"
 #include "pgngamefilter.h"
 
@@ -76,6 +80,34 @@ int s_stringToInt(const char *s, int size)
 	return num;
 }
 
+// Identical tag values are shared between all entries: a big game
+// collection repeats the same few thousand player, event and site
+// names millions of times. The mutex makes interning safe for
+// multi-threaded database scans.
+QSet<QByteArray> s_tagPool;
+QMutex s_tagPoolMutex;
+
+QByteArray s_internTag(const QByteArray& tagValue)
+{
+	QMutexLocker locker(&s_tagPoolMutex);
+	return *s_tagPool.insert(tagValue);
+}
+
+// Classifies a raw Result tag the same way Chess::Result parses it,
+// without creating QString or Chess::Result objects.
+PgnGameFilter::Outcome s_resultOutcome(const QByteArray& result)
+{
+	if (result.startsWith("1-0"))
+		return PgnGameFilter::OutcomeWhiteWin;
+	if (result.startsWith("0-1"))
+		return PgnGameFilter::OutcomeBlackWin;
+	if (result.startsWith("1/2-1/2"))
+		return PgnGameFilter::OutcomeDraw;
+	if (result.startsWith("*"))
+		return PgnGameFilter::OutcomeNone;
+	return PgnGameFilter::OutcomeUnknown;
+}
+
 } // anonymous namespace
 
 PgnStream& operator>>(PgnStream& in, PgnGameEntry& entry)
@@ -98,39 +130,50 @@ QDataStream& operator<<(QDataStream& out, const PgnGameEntry& entry)
 
 PgnGameEntry::PgnGameEntry()
 	: m_pos(0),
-	  m_lineNumber(1)
+	  m_lineNumber(1),
+	  m_hash(0)
 {
 }
 
 bool PgnGameEntry::match(const PgnGameFilter& filter) const
 {
-	const char* data = m_data.constData();
-
 	if (filter.type() == PgnGameFilter::FixedString)
-		return s_stringContains(data, filter.pattern(), m_data.size()) != -1;
+	{
+		for (int type = 0; type < TagCount; type++)
+		{
+			if (s_stringContains(m_tags[type].constData(),
+					     filter.pattern(),
+					     m_tags[type].size()) != -1)
+				return true;
+		}
 
-	int whitePlayer = 0;
+		return false;
+	}
 
-	int i = 0;
-	for (int type = 0; type < 8; type++)
-	{
-		int size = data[i++];
-		const char* str = data + i;
+	// When the filter has no player names, the name matching below
+	// would always pick the white player as the first player
+	int whitePlayer = 1;
 
-		switch (type)
+	for (const PgnGameFilter::Step& step : filter.steps())
+	{
+		switch (step.instruction)
 		{
-		case EventTag:
-			if (s_stringContains(str, filter.event(), size) == -1)
+		case PgnGameFilter::Step::MatchEvent:
+			if (s_stringContains(m_tags[EventTag].constData(),
+					     filter.event(),
+					     m_tags[EventTag].size()) == -1)
 				return false;
 			break;
-		case SiteTag:
-			if (s_stringContains(str, filter.site(), size) == -1)
+		case PgnGameFilter::Step::MatchSite:
+			if (s_stringContains(m_tags[SiteTag].constData(),
+					     filter.site(),
+					     m_tags[SiteTag].size()) == -1)
 				return false;
 			break;
-		case DateTag:
-			if (!filter.minDate().isNull() || !filter.maxDate().isNull())
+		case PgnGameFilter::Step::MatchDate:
 			{
-				if (size < 10)
+				const char* str = m_tags[DateTag].constData();
+				if (m_tags[DateTag].size() < 10)
 					return false;
 
 				int year = s_stringToInt(str, 4);
@@ -143,26 +186,30 @@ bool PgnGameEntry::match(const PgnGameFilter& filter) const
 				if (day == 0)
 					day = 1;
 
-				QDate date(year, month, day);
+				// The date compares as a packed yyyymmdd key
+				// against the compiled bounds
+				int date = year * 10000 + month * 100 + day;
 
-				if ((!filter.minDate().isNull() && date < filter.minDate())
-				||  (!filter.maxDate().isNull() && date > filter.maxDate()))
+				if ((step.arg1 != 0 && date < step.arg1)
+				||  (step.arg2 != 0 && date > step.arg2))
 					return false;
 			}
 			break;
-		case RoundTag:
-			if (filter.minRound() != 0 || filter.maxRound() != 0)
+		case PgnGameFilter::Step::MatchRound:
 			{
-				int round = s_stringToInt(str, size);
+				int round = s_stringToInt(m_tags[RoundTag].constData(),
+							  m_tags[RoundTag].size());
 
 				if (round == 0
-				||  (filter.minRound() != 0 && round < filter.minRound())
-				||  (filter.maxRound() != 0 && round > filter.maxRound()))
+				||  (step.arg1 != 0 && round < step.arg1)
+				||  (step.arg2 != 0 && round > step.arg2))
 					return false;
 			}
 			break;
-		case WhiteTag:
+		case PgnGameFilter::Step::MatchPlayers:
 			{
+				const char* str = m_tags[WhiteTag].constData();
+				int size = m_tags[WhiteTag].size();
 				int len1 = -1;
 				int len2 = -1;
 
@@ -174,12 +221,11 @@ bool PgnGameEntry::match(const PgnGameFilter& filter) const
 				if (len1 == -1 && len2 == -1)
 					return false;
 				whitePlayer = (len1 >= len2) ? 1 : 2;
-			}
-			break;
-		case BlackTag:
-			{
-				int len1 = -1;
-				int len2 = -1;
+
+				str = m_tags[BlackTag].constData();
+				size = m_tags[BlackTag].size();
+				len1 = -1;
+				len2 = -1;
 
 				if (filter.playerSide() != Chess::Side::White && whitePlayer != 1)
 					len1 = s_stringContains(str, filter.player(), size);
@@ -190,92 +236,59 @@ bool PgnGameEntry::match(const PgnGameFilter& filter) const
 					return false;
 			}
 			break;
-		case ResultTag:
-		{
-			if (filter.result() == PgnGameFilter::AnyResult)
-				break;
-
-			Chess::Result result(QString::fromLatin1(str, size));
-			int winner = 0;
-
-			if (!result.winner().isNull())
+		case PgnGameFilter::Step::MatchResult:
 			{
-				if (whitePlayer == 1)
-					winner = result.winner() + 1;
-				else
-				{
-					if (result.winner() == Chess::Side::White)
-						winner = 2;
-					else
-						winner = 1;
-				}
-			}
+				int mask = (whitePlayer == 1) ? step.arg1 : step.arg2;
 
-			bool ok;
-			switch (filter.result())
-			{
-			case PgnGameFilter::EitherPlayerWins:
-				ok = !result.winner().isNull();
-				break;
-			case PgnGameFilter::WhiteWins:
-				ok = result.winner() == Chess::Side::White;
-				break;
-			case PgnGameFilter::BlackWins:
-				ok = result.winner() == Chess::Side::Black;
-				break;
-			case PgnGameFilter::FirstPlayerWins:
-				ok = winner == 1;
-				break;
-			case PgnGameFilter::FirstPlayerLoses:
-				ok = winner == 2;
-				break;
-			case PgnGameFilter::Draw:
-				ok = result.isDraw();
-				break;
-			case PgnGameFilter::Unfinished:
-				ok = result.isNone();
-				break;
-			default:
-				ok = true;
-				break;
+				if (!(mask & (1 << s_resultOutcome(m_tags[ResultTag]))))
+					return false;
 			}
-
-			if (ok == filter.isResultInverted())
-				return false;
-		}
-			break;
-		default:
 			break;
 		}
-		i += size;
 	}
 
 	return true;
 }
 
-void PgnGameEntry::addTag(const QByteArray& tagValue)
+void PgnGameEntry::setTag(TagType type, const QByteArray& tagValue)
 {
-	int size = qMin(127, tagValue.size());
+	// The size is limited to 127 bytes so that it fits in the
+	// one-byte length prefix of the serialized formats.
+	m_tags[type] = s_internTag(tagValue.left(127));
+}
+
+QByteArray PgnGameEntry::packedTagData() const
+{
+	QByteArray data;
+	for (int type = 0; type < TagCount; type++)
+	{
+		data.append(char(m_tags[type].size()));
+		data.append(m_tags[type].constData(), m_tags[type].size());
+	}
 
-	m_data.append(char(size));
-	m_data.append(tagValue.constData(), size);
+	return data;
 }
 
 void PgnGameEntry::clear()
 {
 	m_pos = 0;
 	m_lineNumber = 1;
-	m_data.clear();
+	m_hash = 0;
+	for (int type = 0; type < TagCount; type++)
+		m_tags[type].clear();
 }
 
 bool PgnGameEntry::read(PgnStream& in)
 {
-	if (!in.nextGame())
+	// Only the tag section is indexed, so the previous game's
+	// movetext can be skipped without tokenizing it
+	if (!in.skipToNextGame())
 		return false;
 
 	m_pos = in.pos();
 	m_lineNumber = in.lineNumber();
-	m_data.clear();
+	for (int type = 0; type < TagCount; type++)
+		m_tags[type].clear();
 
 	char c;
 	QByteArray tagName;
@@ -285,6 +298,10 @@ bool PgnGameEntry::read(PgnStream& in)
 	bool inTag = false;
 	bool inQuotes = false;
 
+	// FNV-1a over the game's bytes, folded into the parsing loop
+	const quint64 fnvPrime = Q_UINT64_C(1099511628211);
+	quint64 hash = Q_UINT64_C(14695981039346656037);
+
 	while ((c = in.readChar()) != 0)
 	{
 		if (!inTag)
@@ -297,9 +314,12 @@ bool PgnGameEntry::read(PgnStream& in)
 				break;
 			}
 
+			hash = (hash ^ uchar(c)) * fnvPrime;
 			continue;
 		}
 
+		hash = (hash ^ uchar(c)) * fnvPrime;
+
 		if ((c == ']' && !inQuotes) || c == '\n' || c == '\r')
 		{
 			tags[tagName] = tagValue;
@@ -324,14 +344,29 @@ bool PgnGameEntry::read(PgnStream& in)
 			tagValue += c;
 	}
 
-	addTag(tags["Event"]);
-	addTag(tags["Site"]);
-	addTag(tags["Date"]);
-	addTag(tags["Round"]);
-	addTag(tags["White"]);
-	addTag(tags["Black"]);
-	addTag(tags["Result"]);
-	addTag(tags["Variant"]);
+	setTag(EventTag, tags["Event"]);
+	setTag(SiteTag, tags["Site"]);
+	setTag(DateTag, tags["Date"]);
+	setTag(RoundTag, tags["Round"]);
+	setTag(WhiteTag, tags["White"]);
+	setTag(BlackTag, tags["Black"]);
+	setTag(ResultTag, tags["Result"]);
+	setTag(VariantTag, tags["Variant"]);
+
+	// Hash the movetext too so that games differing only in their
+	// moves don't collide. This also advances the stream straight
+	// to the next game, making the next read's skip a no-op.
+	if (in.data() != nullptr)
+	{
+		qint64 start = in.pos();
+		in.skipToNextGame();
+
+		const char* p = in.data() + start;
+		const char* end = in.data() + in.pos();
+		for (; p != end; p++)
+			hash = (hash ^ uchar(*p)) * fnvPrime;
+	}
+	m_hash = hash;
 
 	return true;
 }
@@ -341,9 +376,19 @@ bool PgnGameEntry::read(QDataStream& in)
 	// modifying this function can cause backward compatibility issues
 	// in other programs.
 
+	QByteArray data;
 	in >> m_pos;
 	in >> m_lineNumber;
-	in >> m_data;
+	in >> data;
+
+	int i = 0;
+	for (int type = 0; type < TagCount && i < data.size(); type++)
+	{
+		int size = qMin(int(uchar(data.at(i))), data.size() - i - 1);
+		setTag(TagType(type),
+		       QByteArray(data.constData() + i + 1, size));
+		i += size + 1;
+	}
 
 	return in.status() == QDataStream::Ok;
 }
@@ -355,7 +400,57 @@ void PgnGameEntry::write(QDataStream& out) const
 
 	out << m_pos;
 	out << m_lineNumber;
-	out << m_data;
+	out << packedTagData();
+}
+
+void PgnGameEntry::writeIndex(QDataStream& out) const
+{
+	// The numbers are written in big-endian format, matching
+	// QDataStream's default byte order.
+
+	const QByteArray data = packedTagData();
+
+	out << m_pos;
+	out << m_lineNumber;
+	out << m_hash;
+	out << quint32(data.size());
+	out.writeRawData(data.constData(), data.size());
+}
+
+qint64 PgnGameEntry::readIndex(const char* data, qint64 size)
+{
+	const qint64 headerSize = 28;
+	if (size < headerSize)
+		return -1;
+
+	const uchar* header = reinterpret_cast<const uchar*>(data);
+	m_pos = qint64(qFromBigEndian<quint64>(header));
+	m_lineNumber = qint64(qFromBigEndian<quint64>(header + 8));
+	m_hash = qFromBigEndian<quint64>(header + 16);
+
+	quint32 dataSize = qFromBigEndian<quint32>(header + 24);
+	if (headerSize + dataSize > size)
+		return -1;
+
+	// The tag values point into the mapped record, so they are
+	// not interned: the mapping itself is shared memory.
+	qint64 i = headerSize;
+	const qint64 end = headerSize + dataSize;
+	for (int type = 0; type < TagCount; type++)
+	{
+		if (i >= end)
+			return -1;
+		int tagSize = uchar(data[i++]);
+		if (i + tagSize > end)
+			return -1;
+
+		m_tags[type] = QByteArray::fromRawData(data + i, tagSize);
+		i += tagSize;
+	}
+	if (i != end)
+		return -1;
+
+	return end;
 }
 
 qint64 PgnGameEntry::pos() const
@@ -368,14 +463,15 @@ qint64 PgnGameEntry::lineNumber() const
 	return m_lineNumber;
 }
 
-QString PgnGameEntry::tagValue(TagType type) const
+quint64 PgnGameEntry::hash() const
 {
-	int i = 0;
-	for (int j = 0; j < type; j++)
-		i += m_data[i] + 1;
+	return m_hash;
+}
 
-	int size = m_data[i];
-	if (size == 0)
+QString PgnGameEntry::tagValue(TagType type) const
+{
+	if (m_tags[type].isEmpty())
 		return QString();
-	return m_data.mid(i + 1, size);
+	return QString::fromLatin1(m_tags[type].constData(),
+				   m_tags[type].size());
 }
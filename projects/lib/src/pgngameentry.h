@@ -35,6 +35,11 @@ class QDataStream;
  * consumption, which is useful for quickly loading large game
  * collections.
  *
+ * Tag values read from a PGN stream are interned in a pool shared
+ * by all entries, so the few thousand distinct player, event and
+ * site names of a big collection are stored only once no matter
+ * how many games repeat them.
+ *
  * \sa PgnGame, PgnStream
  */
 class LIB_EXPORT PgnGameEntry
@@ -75,6 +80,27 @@ class LIB_EXPORT PgnGameEntry
 		 */
 		void write(QDataStream& out) const;
 
+		/*!
+		 * Writes the entry to \a out as a raw index record,
+		 * the format used by memory-mapped index files.
+		 * \sa readIndex()
+		 */
+		void writeIndex(QDataStream& out) const;
+
+		/*!
+		 * Points the entry at a raw index record of at most
+		 * \a size bytes starting at \a data.
+		 *
+		 * The tag data is not copied, so \a data must stay
+		 * valid (eg. a memory-mapped file) for the entry's
+		 * lifetime.
+		 *
+		 * Returns the size of the record, or -1 if the record
+		 * is invalid.
+		 * \sa writeIndex()
+		 */
+		qint64 readIndex(const char* data, qint64 size);
+
 		/*!
 		 * Returns true if the PGN tags match \a filter.
 		 * The matching is case insensitive.
@@ -86,16 +112,31 @@ class LIB_EXPORT PgnGameEntry
 		/*! Returns the line number where the game begins. */
 		qint64 lineNumber() const;
 
+		/*!
+		 * Returns a 64-bit hash of the game's contents.
+		 *
+		 * The hash covers the tag section and, when the stream's
+		 * contents are available as one block, the movetext. It's
+		 * computed on the fly while the entry is read, so equal
+		 * hashes can be used to skip duplicate games during an
+		 * import without parsing the games again.
+		 */
+		quint64 hash() const;
+
 		/*! Returns the tag value corresponding to \a type. */
 		QString tagValue(TagType type) const;
 
 	private:
-		void addTag(const QByteArray& tagValue);
+		static const int TagCount = VariantTag + 1;
+
+		void setTag(TagType type, const QByteArray& tagValue);
+		QByteArray packedTagData() const;
 
-		QByteArray m_data;
+		QByteArray m_tags[TagCount];
 
 		qint64 m_pos;
 		qint64 m_lineNumber;
+		quint64 m_hash;
 };
 
 /*! Reads a PGN game entry from a PGN stream. */
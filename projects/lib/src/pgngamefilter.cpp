@@ -20,6 +20,47 @@
 #include "pgngameentry.h"
 
 
+namespace {
+
+const int s_allOutcomes = (1 << (PgnGameFilter::OutcomeUnknown + 1)) - 1;
+
+// The set of outcomes a result criterion accepts, as a bitmask over
+// PgnGameFilter::Outcome. "First player wins/loses" depends on which
+// color the first player has, so both variants are compiled and the
+// executor picks one per entry.
+int s_outcomeMask(PgnGameFilter::Result result, bool whiteIsFirst)
+{
+	switch (result)
+	{
+	case PgnGameFilter::EitherPlayerWins:
+		return (1 << PgnGameFilter::OutcomeWhiteWin)
+		     | (1 << PgnGameFilter::OutcomeBlackWin);
+	case PgnGameFilter::WhiteWins:
+		return 1 << PgnGameFilter::OutcomeWhiteWin;
+	case PgnGameFilter::BlackWins:
+		return 1 << PgnGameFilter::OutcomeBlackWin;
+	case PgnGameFilter::FirstPlayerWins:
+		return whiteIsFirst ? 1 << PgnGameFilter::OutcomeWhiteWin
+				    : 1 << PgnGameFilter::OutcomeBlackWin;
+	case PgnGameFilter::FirstPlayerLoses:
+		return whiteIsFirst ? 1 << PgnGameFilter::OutcomeBlackWin
+				    : 1 << PgnGameFilter::OutcomeWhiteWin;
+	case PgnGameFilter::Draw:
+		return 1 << PgnGameFilter::OutcomeDraw;
+	case PgnGameFilter::Unfinished:
+		return 1 << PgnGameFilter::OutcomeNone;
+	default:
+		return s_allOutcomes;
+	}
+}
+
+int s_dateKey(const QDate& date)
+{
+	return date.year() * 10000 + date.month() * 100 + date.day();
+}
+
+} // anonymous namespace
+
 PgnGameFilter::PgnGameFilter()
 	: m_type(Advanced),
 	  m_minRound(0),
@@ -39,59 +80,115 @@ PgnGameFilter::PgnGameFilter(const QString& pattern)
 {
 }
 
+// Compiles the active criteria into a flat program of predicate steps
+// with their operands precomputed, executed by PgnGameEntry::match().
+// Criteria left at their defaults compile to nothing, and a scan
+// doesn't spend a cycle on them.
+void PgnGameFilter::compile()
+{
+	m_steps.clear();
+
+	if (m_type == FixedString)
+		return;
+
+	if (!m_event.isEmpty())
+		m_steps.append({ Step::MatchEvent, 0, 0 });
+	if (!m_site.isEmpty())
+		m_steps.append({ Step::MatchSite, 0, 0 });
+
+	if (!m_minDate.isNull() || !m_maxDate.isNull())
+	{
+		// The bounds become packed yyyymmdd keys, so entries
+		// are compared with plain integer arithmetic instead
+		// of per-entry QDate objects
+		int minKey = m_minDate.isNull() ? 0 : s_dateKey(m_minDate);
+		int maxKey = m_maxDate.isNull() ? 0 : s_dateKey(m_maxDate);
+		m_steps.append({ Step::MatchDate, minKey, maxKey });
+	}
+
+	if (m_minRound != 0 || m_maxRound != 0)
+		m_steps.append({ Step::MatchRound, m_minRound, m_maxRound });
+
+	if (!m_player.isEmpty() || !m_opponent.isEmpty())
+		m_steps.append({ Step::MatchPlayers, 0, 0 });
+
+	if (m_result != AnyResult)
+	{
+		int whiteFirst = s_outcomeMask(m_result, true);
+		int blackFirst = s_outcomeMask(m_result, false);
+		if (m_resultInverted)
+		{
+			whiteFirst ^= s_allOutcomes;
+			blackFirst ^= s_allOutcomes;
+		}
+		m_steps.append({ Step::MatchResult, whiteFirst, blackFirst });
+	}
+}
+
 void PgnGameFilter::setPattern(const QString& pattern)
 {
 	m_type = FixedString;
 	m_pattern = pattern.toLatin1();
+	compile();
 }
 
 void PgnGameFilter::setEvent(const QString& event)
 {
 	m_event = event.toLatin1();
+	compile();
 }
 
 void PgnGameFilter::setSite(const QString& site)
 {
 	m_site = site.toLatin1();
+	compile();
 }
 
 void PgnGameFilter::setPlayer(const QString& name, Chess::Side side)
 {
 	m_player = name.toLatin1();
 	m_playerSide = side;
+	compile();
 }
 
 void PgnGameFilter::setOpponent(const QString& name)
 {
 	m_opponent = name.toLatin1();
+	compile();
 }
 
 void PgnGameFilter::setMinDate(const QDate& date)
 {
 	m_minDate = date;
+	compile();
 }
 
 void PgnGameFilter::setMaxDate(const QDate& date)
 {
 	m_maxDate = date;
+	compile();
 }
 
 void PgnGameFilter::setMinRound(int round)
 {
 	m_minRound = round;
+	compile();
 }
 
 void PgnGameFilter::setMaxRound(int round)
 {
 	m_maxRound = round;
+	compile();
 }
 
 void PgnGameFilter::setResult(Result result)
 {
 	m_result = result;
+	compile();
 }
 
 void PgnGameFilter::setResultInverted(bool invert)
 {
 	m_resultInverted = invert;
+	compile();
 }
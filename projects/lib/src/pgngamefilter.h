@@ -21,6 +21,7 @@
 
 #include <QByteArray>
 #include <QDate>
+#include <QVarLengthArray>
 #include "board/side.h"
 class QString;
 class PgnGameEntry;
@@ -59,6 +60,52 @@ class LIB_EXPORT PgnGameFilter
 			Unfinished		//!< The game wasn't completed
 		};
 
+		/*!
+		 * The classified outcome of a game's \a Result tag.
+		 *
+		 * The values are bit indexes in the outcome masks of
+		 * compiled result predicates.
+		 */
+		enum Outcome
+		{
+			OutcomeWhiteWin,	//!< The white player won
+			OutcomeBlackWin,	//!< The black player won
+			OutcomeDraw,		//!< The game was drawn
+			OutcomeNone,		//!< The game wasn't completed
+			OutcomeUnknown		//!< The tag couldn't be classified
+		};
+
+		/*! A single predicate step of a compiled filter. */
+		struct Step
+		{
+			/*! The predicate a step evaluates. */
+			enum Instruction
+			{
+				MatchEvent,	//!< Substring match on the \a Event tag
+				MatchSite,	//!< Substring match on the \a Site tag
+				MatchDate,	//!< Date range test on the \a Date tag
+				MatchRound,	//!< Range test on the \a Round tag
+				MatchPlayers,	//!< Name match on the player tags
+				MatchResult	//!< Outcome mask test on the \a Result tag
+			};
+
+			Instruction instruction;	//!< The predicate to evaluate
+			/*!
+			 * The first operand: a minimum yyyymmdd date key
+			 * (\a MatchDate), a minimum round (\a MatchRound), or
+			 * the outcome mask to use when the first player has
+			 * white (\a MatchResult).
+			 */
+			int arg1;
+			/*!
+			 * The second operand: a maximum yyyymmdd date key
+			 * (\a MatchDate), a maximum round (\a MatchRound), or
+			 * the outcome mask to use when the first player has
+			 * black (\a MatchResult).
+			 */
+			int arg2;
+		};
+
 		/*!
 		 * Creates a new empty filter.
 		 *
@@ -119,6 +166,19 @@ class LIB_EXPORT PgnGameFilter
 		 */
 		bool isResultInverted() const;
 
+		/*!
+		 * Returns the compiled form of an \a Advanced filter.
+		 *
+		 * The active criteria are compiled into a flat list of
+		 * predicate steps whenever the filter changes, so a
+		 * database scan evaluates only the criteria that are
+		 * set and doesn't re-interpret dates or results for
+		 * every entry.
+		 *
+		 * The list is empty for a \a FixedString filter.
+		 */
+		const QVarLengthArray<Step, 8>& steps() const;
+
 		/*!
 		 * Sets the \a FixedString pattern to \a pattern.
 		 *
@@ -148,6 +208,8 @@ class LIB_EXPORT PgnGameFilter
 		void setResultInverted(bool invert);
 
 	private:
+		void compile();
+
 		Type m_type;
 		QByteArray m_pattern;
 		QByteArray m_event;
@@ -161,6 +223,7 @@ class LIB_EXPORT PgnGameFilter
 		int m_maxRound;
 		Result m_result;
 		bool m_resultInverted;
+		QVarLengthArray<Step, 8> m_steps;
 };
 
 inline PgnGameFilter::Type PgnGameFilter::type() const
@@ -228,4 +291,9 @@ inline Chess::Side PgnGameFilter::playerSide() const
 	return m_playerSide;
 }
 
+inline const QVarLengthArray<PgnGameFilter::Step, 8>& PgnGameFilter::steps() const
+{
+	return m_steps;
+}
+
 #endif // PGNGAMEFILTER_H
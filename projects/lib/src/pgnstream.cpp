@@ -20,11 +20,10 @@
 #include <cctype>
 #include <cstring>
 #include <QIODevice>
+#include <QFileDevice>
 #include "board/boardfactory.h"
 
-namespace {
-
-void skipSection(PgnStream* in, char start)
+void PgnStream::skipSection(char start)
 {
 	char end;
 	switch (start)
@@ -45,8 +44,41 @@ void skipSection(PgnStream* in, char start)
 	}
 
 	int level = 1;
+
+	// Skip to the matching bracket (or end of line) with span
+	// scans instead of one readChar() call per byte
+	while (m_data != nullptr)
+	{
+		const char* p = static_cast<const char*>(
+			memchr(m_data + m_pos, end, m_dataSize - m_pos));
+		if (p == nullptr)
+		{
+			countLines(m_pos, m_dataSize);
+			m_pos = m_dataSize;
+			m_status = ReadPastEnd;
+			return;
+		}
+
+		qint64 endPos = p - m_data;
+		if (start != 0)
+		{
+			const char* q = m_data + m_pos;
+			while ((q = static_cast<const char*>(
+				memchr(q, start, p - q))) != nullptr)
+			{
+				level++;
+				q++;
+			}
+		}
+
+		countLines(m_pos, endPos + 1);
+		m_pos = endPos + 1;
+		if (--level == 0)
+			return;
+	}
+
 	char c;
-	while ((c = in->readChar()) != 0)
+	while ((c = readChar()) != 0)
 	{
 		if (c == end && --level == 0)
 			break;
@@ -55,7 +87,17 @@ void skipSection(PgnStream* in, char start)
 	}
 }
 
-} // anonymous namespace
+void PgnStream::countLines(qint64 start, qint64 end)
+{
+	const char* p = m_data + start;
+	const char* e = m_data + end;
+
+	while ((p = static_cast<const char*>(memchr(p, '\n', e - p))) != nullptr)
+	{
+		m_lineNumber++;
+		p++;
+	}
+}
 
 PgnStream::PgnStream(const QString& variant)
 	: m_board(nullptr),
@@ -65,8 +107,11 @@ PgnStream::PgnStream(const QString& variant)
 	  m_tokenType(NoToken),
 	  m_device(nullptr),
 	  m_string(nullptr),
+	  m_data(nullptr),
+	  m_dataSize(0),
 	  m_status(Ok),
-	  m_phase(OutOfGame)
+	  m_phase(OutOfGame),
+	  m_skipAnnotations(false)
 {
 	setVariant(variant);
 }
@@ -101,8 +146,11 @@ void PgnStream::reset()
 	m_tokenType = NoToken;
 	m_device = nullptr;
 	m_string = nullptr;
+	m_data = nullptr;
+	m_dataSize = 0;
 	m_status = Ok;
 	m_phase = OutOfGame;
+	m_skipAnnotations = false;
 }
 
 Chess::Board* PgnStream::board()
@@ -121,6 +169,20 @@ void PgnStream::setDevice(QIODevice* device)
 
 	reset();
 	m_device = device;
+
+	// Tokenize random-access files straight from a memory mapping.
+	// The device is kept only for ownership and error reporting;
+	// reading goes through m_data.
+	QFileDevice* file = qobject_cast<QFileDevice*>(device);
+	if (file != nullptr && !file->isSequential() && file->size() > 0)
+	{
+		uchar* data = file->map(0, file->size());
+		if (data != nullptr)
+		{
+			m_data = reinterpret_cast<const char*>(data);
+			m_dataSize = file->size();
+		}
+	}
 }
 
 const QByteArray* PgnStream::string() const
@@ -133,6 +195,8 @@ void PgnStream::setString(const QByteArray* string)
 	Q_ASSERT(string != nullptr);
 	reset();
 	m_string = string;
+	m_data = string->constData();
+	m_dataSize = string->size();
 }
 
 QString PgnStream::variant() const
@@ -155,18 +219,33 @@ bool PgnStream::setVariant(const QString& variant)
 	return true;
 }
 
+bool PgnStream::skipAnnotations() const
+{
+	return m_skipAnnotations;
+}
+
+void PgnStream::setSkipAnnotations(bool skip)
+{
+	m_skipAnnotations = skip;
+}
+
 bool PgnStream::isOpen() const
 {
-	return (m_device && m_device->isOpen()) || m_string;
+	return (m_device && m_device->isOpen()) || m_data;
 }
 
 qint64 PgnStream::pos() const
 {
-	if (m_device)
+	if (m_device && !m_data)
 		return m_device->pos();
 	return m_pos;
 }
 
+const char* PgnStream::data() const
+{
+	return m_data;
+}
+
 qint64 PgnStream::lineNumber() const
 {
 	return m_lineNumber;
@@ -175,18 +254,23 @@ qint64 PgnStream::lineNumber() const
 char PgnStream::readChar()
 {
 	char c;
-	if (m_device)
+	if (m_data)
 	{
-		if (!m_device->getChar(&m_lastChar))
+		if (m_pos >= m_dataSize)
 		{
 			m_status = ReadPastEnd;
 			return 0;
 		}
-		c = m_lastChar;
+		c = m_data[m_pos++];
 	}
-	else if (m_string && m_pos < m_string->size())
+	else if (m_device)
 	{
-		c = m_string->at(m_pos++);
+		if (!m_device->getChar(&m_lastChar))
+		{
+			m_status = ReadPastEnd;
+			return 0;
+		}
+		c = m_lastChar;
 	}
 	else
 	{
@@ -210,14 +294,14 @@ void PgnStream::rewindChar()
 	Q_ASSERT(pos() > 0);
 
 	char c;
-	if (m_device)
+	if (m_data)
+		c = m_data[--m_pos];
+	else if (m_device)
 	{
 		c = m_lastChar;
 		m_device->ungetChar(m_lastChar);
 		m_lastChar = 0;
 	}
-	else if (m_string)
-		c = m_string->at(m_pos--);
 	else
 		return;
 
@@ -231,15 +315,15 @@ bool PgnStream::seek(qint64 pos, qint64 lineNumber)
 		return false;
 
 	bool ok = false;
-	if (m_device)
+	if (m_data)
 	{
-		ok = m_device->seek(pos);
-		m_pos = 0;
+		ok = pos < m_dataSize;
+		m_pos = pos;
 	}
-	else if (m_string)
+	else if (m_device)
 	{
-		ok = pos < m_string->size();
-		m_pos = pos;
+		ok = m_device->seek(pos);
+		m_pos = 0;
 	}
 	if (!ok)
 		return false;
@@ -261,6 +345,26 @@ void PgnStream::parseUntil(const char* chars)
 {
 	Q_ASSERT(chars != nullptr);
 
+	if (m_data != nullptr)
+	{
+		// Scan the run in place and append it as one span
+		// instead of one readChar() and append() per byte
+		qint64 start = m_pos;
+		while (m_pos < m_dataSize
+		&&     strchr(chars, m_data[m_pos]) == nullptr)
+			m_pos++;
+
+		countLines(start, m_pos);
+		m_tokenString.append(m_data + start, m_pos - start);
+
+		// Consume the terminating character
+		if (m_pos >= m_dataSize)
+			m_status = ReadPastEnd;
+		else if (m_data[m_pos++] == '\n')
+			m_lineNumber++;
+		return;
+	}
+
 	char c;
 	while ((c = readChar()) != 0)
 	{
@@ -307,7 +411,32 @@ void PgnStream::parseTag()
 			{
 				phase++;
 				if (c == '\"')
+				{
 					inQuotes = true;
+
+					// Copy the quoted value as one span
+					// up to the closing quote, leaving
+					// the quote for the outer loop
+					if (m_data != nullptr)
+					{
+						qint64 start = m_pos;
+						while (m_pos < m_dataSize)
+						{
+							char d = m_data[m_pos];
+							if (d == '\"'
+							||  d == '\n'
+							||  d == '\r')
+								break;
+							m_pos++;
+						}
+						m_tokenString.append(
+						    m_data + start,
+						    m_pos - start);
+						m_tagValue.append(
+						    m_data + start,
+						    m_pos - start);
+					}
+				}
 				else
 					m_tagValue.append(c);
 			}
@@ -337,6 +466,47 @@ void PgnStream::parseComment(char opBracket)
 	int level = 1;
 	char clBracket = (opBracket == '(') ? ')' : '}';
 
+	// Scan to the closing bracket with memchr() and append whole
+	// spans, so each comment byte is touched once at memory speed
+	while (m_data != nullptr)
+	{
+		const char* p = static_cast<const char*>(
+			memchr(m_data + m_pos, clBracket, m_dataSize - m_pos));
+		qint64 end = (p == nullptr) ? m_dataSize : p - m_data;
+
+		// Opening brackets within the span keep the comment open
+		const char* q = m_data + m_pos;
+		while ((q = static_cast<const char*>(
+			memchr(q, opBracket, m_data + end - q))) != nullptr)
+		{
+			level++;
+			q++;
+		}
+
+		countLines(m_pos, end);
+
+		// Skip the newlines before the comment text
+		qint64 start = m_pos;
+		if (m_tokenString.isEmpty())
+		{
+			while (start < end && m_data[start] == '\n')
+				start++;
+		}
+		m_tokenString.append(m_data + start, end - start);
+
+		if (p == nullptr)
+		{
+			m_pos = m_dataSize;
+			m_status = ReadPastEnd;
+			return;
+		}
+
+		m_pos = end + 1;
+		if (--level <= 0)
+			return;
+		m_tokenString.append(clBracket);
+	}
+
 	char c;
 	while ((c = readChar()) != 0)
 	{
@@ -362,12 +532,58 @@ bool PgnStream::nextGame()
 			return true;
 		}
 		else
-			skipSection(this, c);
+			skipSection(c);
 	}
 
 	return false;
 }
 
+bool PgnStream::skipToNextGame()
+{
+	if (m_data == nullptr)
+		return nextGame();
+
+	// The stream may already be at a tag section, eg. at the
+	// start of the data or right after a seek
+	qint64 pos = m_pos;
+	while (pos < m_dataSize && isspace(m_data[pos]))
+		pos++;
+	if (pos < m_dataSize && m_data[pos] == '[')
+	{
+		countLines(m_pos, pos);
+		m_pos = pos;
+		m_phase = InTags;
+		return true;
+	}
+
+	// Scan for the start of the next game's tag section instead
+	// of tokenizing the movetext in between. The PGN export format
+	// mandates that every game begins with an "Event" tag on its
+	// own line, so look for that pattern directly.
+	while (pos < m_dataSize)
+	{
+		const char* p = static_cast<const char*>(
+			memchr(m_data + pos, '\n', m_dataSize - pos));
+		if (p == nullptr)
+			break;
+
+		pos = p - m_data + 1;
+		if (pos + 7 <= m_dataSize
+		&&  memcmp(m_data + pos, "[Event ", 7) == 0)
+		{
+			countLines(m_pos, pos);
+			m_pos = pos;
+			m_phase = InTags;
+			return true;
+		}
+	}
+
+	countLines(m_pos, m_dataSize);
+	m_pos = m_dataSize;
+	m_status = ReadPastEnd;
+	return false;
+}
+
 PgnStream::TokenType PgnStream::readNext()
 {
 	if (m_phase == OutOfGame)
@@ -404,15 +620,31 @@ PgnStream::TokenType PgnStream::readNext()
 			return m_tokenType;
 		case '(':
 		case '{':
+			if (m_skipAnnotations)
+			{
+				skipSection(c);
+				break;
+			}
 			m_tokenType = PgnComment;
 			parseComment(c);
 			return m_tokenType;
 		case ';':
+			if (m_skipAnnotations)
+			{
+				skipSection(c);
+				break;
+			}
 			m_tokenType = PgnLineComment;
 			parseUntil("\n\r");
 			return m_tokenType;
 		case '$':
 			// NAG (Numeric Annotation Glyph)
+			if (m_skipAnnotations)
+			{
+				parseUntil(" \t\n\r");
+				m_tokenString.clear();
+				break;
+			}
 			m_tokenType = PgnNag;
 			parseUntil(" \t\n\r");
 			return m_tokenType;
@@ -36,6 +36,12 @@ namespace Chess { class Board; }
  * be changed at any time, so it's possible to read PGN streams that
  * contain games of multiple variants.
  *
+ * When the device is a random-access file, the stream maps it into
+ * memory and tokenizes the mapped region directly instead of pulling
+ * characters through the QIODevice, which makes large archive scans
+ * run at disk bandwidth. Sequential devices (pipes, sockets) and
+ * files that can't be mapped keep the buffered path.
+ *
  * \sa PgnGame
  * \sa OpeningBook
  */
@@ -120,12 +126,44 @@ class LIB_EXPORT PgnStream
 		 */
 		bool setVariant(const QString& variant);
 
+		/*!
+		 * Returns true if annotations are skipped; otherwise
+		 * returns false.
+		 * \sa setSkipAnnotations()
+		 */
+		bool skipAnnotations() const;
+		/*!
+		 * Enables or disables annotation skipping.
+		 *
+		 * When skipping is enabled, readNext() skips brace
+		 * comments, variations and NAGs with span scans instead
+		 * of tokenizing their contents, and never returns the
+		 * \a PgnComment, \a PgnLineComment or \a PgnNag token
+		 * types. Engine-annotated archives are mostly comment
+		 * bytes, so scans that need only the moves (eg. opening
+		 * book imports) run several times faster.
+		 *
+		 * The default is false. Setting a new device or string
+		 * disables skipping again.
+		 */
+		void setSkipAnnotations(bool skip);
+
 		/*! Returns true if the stream is open. */
 		bool isOpen() const;
 
 		/*! Returns the current position in the stream. */
 		qint64 pos() const;
 
+		/*!
+		 * Returns a pointer to the stream's contents, or nullptr
+		 * if the stream reads from a sequential device and its
+		 * contents aren't available as one block.
+		 *
+		 * The data covers the whole device; pos() is an offset
+		 * into it.
+		 */
+		const char* data() const;
+
 		/*! Returns the current line number. */
 		qint64 lineNumber() const;
 
@@ -169,6 +207,21 @@ class LIB_EXPORT PgnStream
 		 * \sa readNext()
 		 */
 		bool nextGame();
+		/*!
+		 * Seeks to the next game without tokenizing the movetext.
+		 *
+		 * On a memory-mapped stream the next game boundary is found
+		 * by scanning directly for the tag section pattern that
+		 * starts a game, which makes index-only scans run at memory
+		 * speed. On sequential devices this is equivalent to
+		 * nextGame().
+		 *
+		 * Returns true if a game is available; otherwise returns
+		 * false.
+		 *
+		 * \sa nextGame()
+		 */
+		bool skipToNextGame();
 		/*!
 		 * Reads the next token and returns its type.
 		 *
@@ -203,6 +256,8 @@ class LIB_EXPORT PgnStream
 		void parseUntil(const char* chars);
 		void parseTag();
 		void parseComment(char opBracket);
+		void skipSection(char start);
+		void countLines(qint64 start, qint64 end);
 
 		Chess::Board* m_board;
 		qint64 m_pos;
@@ -214,8 +269,11 @@ class LIB_EXPORT PgnStream
 		TokenType m_tokenType;
 		QIODevice* m_device;
 		const QByteArray* m_string;
+		const char* m_data;
+		qint64 m_dataSize;
 		Status m_status;
 		Phase m_phase;
+		bool m_skipAnnotations;
 };
 
 #endif // PGNSTREAM_H
@@ -0,0 +1,118 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "pgnverifier.h"
+#include <QRunnable>
+#include <QThread>
+#include "board/board.h"
+
+
+//! A QRunnable that replays one queued game.
+class PgnVerificationJob : public QRunnable
+{
+	public:
+		PgnVerificationJob(PgnVerifier* verifier,
+				   const PgnGame& game,
+				   int gameNumber)
+			: m_verifier(verifier),
+			  m_game(game),
+			  m_gameNumber(gameNumber)
+		{
+		}
+
+		virtual void run()
+		{
+			// Keep the replay out of the way of the engines and
+			// the game threads. Lowering the priority isn't
+			// supported on every platform, but it never hurts.
+			QThread* thread = QThread::currentThread();
+			thread->setPriority(QThread::LowestPriority);
+
+			QString message = PgnVerifier::findDiscrepancy(m_game);
+			if (!message.isEmpty())
+				emit m_verifier->discrepancyFound(m_gameNumber,
+								  message);
+
+			thread->setPriority(QThread::NormalPriority);
+		}
+
+	private:
+		PgnVerifier* m_verifier;
+		PgnGame m_game;
+		int m_gameNumber;
+};
+
+PgnVerifier::PgnVerifier(QObject* parent)
+	: QObject(parent)
+{
+	// Replaying is much cheaper than producing games, so one
+	// worker keeps up with any realistic game rate
+	m_pool.setMaxThreadCount(1);
+}
+
+PgnVerifier::~PgnVerifier()
+{
+	m_pool.waitForDone();
+}
+
+void PgnVerifier::verify(const PgnGame& game, int gameNumber)
+{
+	m_pool.start(new PgnVerificationJob(this, game, gameNumber));
+}
+
+QString PgnVerifier::findDiscrepancy(const PgnGame& game)
+{
+	Chess::Board* board = game.createBoard();
+	if (board == nullptr)
+		return tr("invalid variant or starting position");
+
+	QString message;
+	const QVector<PgnGame::MoveData>& moves = game.moves();
+	for (int i = 0; i < moves.size(); i++)
+	{
+		const PgnGame::MoveData& md = moves.at(i);
+		const QString sanString = QString::fromUtf8(md.moveString);
+
+		if (md.key != board->key())
+		{
+			message = tr("position key mismatch before move %1 (%2)")
+				  .arg(i + 1).arg(sanString);
+			break;
+		}
+
+		Chess::Move move = board->moveFromString(sanString);
+		if (move.isNull())
+		{
+			message = tr("move %1 (%2) is illegal or unparsable")
+				  .arg(i + 1).arg(sanString);
+			break;
+		}
+
+		if (board->genericMove(move) != md.move)
+		{
+			message = tr("move %1 (%2) doesn't match the stored move")
+				  .arg(i + 1).arg(sanString);
+			break;
+		}
+
+		board->makeMove(move);
+	}
+
+	delete board;
+	return message;
+}
@@ -0,0 +1,81 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PGNVERIFIER_H
+#define PGNVERIFIER_H
+
+#include <QObject>
+#include <QThreadPool>
+#include "pgngame.h"
+
+/*!
+ * \brief A background verifier for finished games.
+ *
+ * Each queued game is replayed on a fresh board in a low-priority
+ * worker thread: the stored SAN strings are parsed and checked for
+ * legality, and the resulting moves and position keys are compared
+ * against the stored ones. The replay happens completely off the
+ * game-play critical path, so games can be verified as they're
+ * produced instead of re-parsing the output afterwards.
+ *
+ * \sa PgnGame
+ */
+class LIB_EXPORT PgnVerifier : public QObject
+{
+	Q_OBJECT
+
+	public:
+		/*! Creates a new PgnVerifier. */
+		explicit PgnVerifier(QObject* parent = nullptr);
+		/*!
+		 * Destructs the verifier. Waits for the queued games to
+		 * be verified first.
+		 */
+		virtual ~PgnVerifier();
+
+		/*!
+		 * Queues a copy of \a game for verification as game
+		 * number \a gameNumber. Returns immediately.
+		 *
+		 * If the replay finds a discrepancy, the
+		 * discrepancyFound() signal is emitted.
+		 */
+		void verify(const PgnGame& game, int gameNumber);
+
+		/*!
+		 * Replays \a game on a fresh board and returns a
+		 * description of the first discrepancy, or an empty
+		 * string if the game replays cleanly.
+		 */
+		static QString findDiscrepancy(const PgnGame& game);
+
+	signals:
+		/*!
+		 * This signal is emitted when game \a gameNumber doesn't
+		 * replay cleanly. \a message describes the first
+		 * discrepancy.
+		 */
+		void discrepancyFound(int gameNumber, const QString& message);
+
+	private:
+		friend class PgnVerificationJob;
+
+		QThreadPool m_pool;
+};
+
+#endif // PGNVERIFIER_H
@@ -0,0 +1,122 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "pgnwriter.h"
+#include "gzipdevice.h"
+#ifdef Q_OS_LINUX
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+PgnWriter::PgnWriter(const QString& fileName, PgnGame::PgnMode mode)
+	: m_demoted(false),
+	  m_mode(mode),
+	  m_gzip(nullptr),
+	  m_out(nullptr)
+{
+	m_file.setFileName(fileName);
+
+	// Games are passed to the writer's thread by value
+	qRegisterMetaType<PgnGame>("PgnGame");
+}
+
+PgnWriter::~PgnWriter()
+{
+	close();
+}
+
+bool PgnWriter::ensureOpen()
+{
+	bool isOpen = m_file.isOpen();
+	if (isOpen && m_file.exists())
+		return true;
+
+	if (isOpen)
+	{
+		qWarning("PGN file %s does not exist. Reopening...",
+			 qUtf8Printable(m_file.fileName()));
+		close();
+	}
+
+	if (!m_file.open(QIODevice::WriteOnly | QIODevice::Append))
+	{
+		qWarning("Could not open PGN file %s",
+			 qUtf8Printable(m_file.fileName()));
+		return false;
+	}
+
+	if (m_file.fileName().endsWith(QLatin1String(".gz"),
+				       Qt::CaseInsensitive))
+	{
+		m_gzip = new GzipDevice(&m_file);
+		m_gzip->open(QIODevice::WriteOnly);
+		m_out = m_gzip;
+	}
+	else
+		m_out = &m_file;
+
+	return true;
+}
+
+void PgnWriter::lowerThreadPriority()
+{
+#ifdef Q_OS_LINUX
+	// The writer is bookkeeping: drop its CPU and I/O priority so
+	// engine processes always win the scheduler over it
+	const pid_t tid = pid_t(syscall(SYS_gettid));
+	setpriority(PRIO_PROCESS, id_t(tid), 10);
+	// 1 = IOPRIO_WHO_PROCESS; best-effort class, lowest level
+	syscall(SYS_ioprio_set, 1, tid, (2 << 13) | 7);
+#endif
+}
+
+void PgnWriter::writeGame(const PgnGame& pgn, int gameNumber)
+{
+	if (!m_demoted)
+	{
+		// Runs on the writer's own thread, so only this thread
+		// is demoted
+		m_demoted = true;
+		lowerThreadPriority();
+	}
+
+	if (!ensureOpen())
+	{
+		qWarning("Could not write PGN game %d", gameNumber);
+		return;
+	}
+
+	if (!pgn.write(m_out, m_mode)
+	||  m_file.error() != QFile::NoError)
+		qWarning("Could not write PGN game %d", gameNumber);
+}
+
+void PgnWriter::close()
+{
+	m_out = nullptr;
+	if (m_gzip != nullptr)
+	{
+		// Finish the gzip stream before closing the file
+		m_gzip->close();
+		delete m_gzip;
+		m_gzip = nullptr;
+	}
+	if (m_file.isOpen())
+		m_file.close();
+}
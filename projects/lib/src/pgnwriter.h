@@ -0,0 +1,81 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PGNWRITER_H
+#define PGNWRITER_H
+
+#include <QObject>
+#include <QFile>
+#include "pgngame.h"
+class GzipDevice;
+
+/*!
+ * \brief A background writer for tournament PGN output.
+ *
+ * A PgnWriter owns the output file and runs in a thread of its own:
+ * games queued with writeGame() are serialized and appended there,
+ * so the tournament's game-end processing never blocks on PGN
+ * formatting or file I/O. Queued calls keep their order, and the
+ * tournament hands games over in canonical game order, so the
+ * output file stays ordered without any locking.
+ */
+class LIB_EXPORT PgnWriter : public QObject
+{
+	Q_OBJECT
+
+	public:
+		/*!
+		 * Creates a new writer that appends games to
+		 * \a fileName in \a mode.
+		 *
+		 * The file is opened lazily by the first writeGame()
+		 * call, on the writer's thread. A ".gz" suffix makes
+		 * the output a gzip stream.
+		 */
+		PgnWriter(const QString& fileName, PgnGame::PgnMode mode);
+		virtual ~PgnWriter();
+
+	public slots:
+		/*!
+		 * Appends game number \a gameNumber to the output file.
+		 *
+		 * Write errors are reported with qWarning(); the writer
+		 * then tries to reopen the file for the next game.
+		 */
+		void writeGame(const PgnGame& pgn, int gameNumber);
+		/*!
+		 * Closes the output file, finishing a gzip stream.
+		 *
+		 * Invoke with Qt::BlockingQueuedConnection to make sure
+		 * every queued game is on disk before stopping the
+		 * writer's thread.
+		 */
+		void close();
+
+	private:
+		bool ensureOpen();
+		void lowerThreadPriority();
+
+		bool m_demoted;
+		PgnGame::PgnMode m_mode;
+		QFile m_file;
+		GzipDevice* m_gzip;
+		QIODevice* m_out;
+};
+
+#endif // PGNWRITER_H
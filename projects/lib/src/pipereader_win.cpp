@@ -31,6 +31,10 @@ PipeReader::PipeReader(HANDLE pipe, QObject* parent)
 	  m_lastNewLine(1)
 {
 	Q_ASSERT(m_pipe != INVALID_HANDLE_VALUE);
+
+	// The read loop needs very little stack, and with dozens of
+	// engines the default per-thread reservation adds up
+	setStackSize(0x40000);
 }
 
 qint64 PipeReader::bytesAvailable() const
@@ -22,7 +22,8 @@ PlayerBuilder::PlayerBuilder(const QString& name)
 	: m_name(name),
 	  m_rating(0),
 	  m_resume_score(0),
-	  m_strikes(0)
+	  m_strikes(0),
+	  m_cpuCoreCount(1)
 {
 }
 
@@ -60,6 +61,16 @@ void PlayerBuilder::setStrikes(const int strikes)
 	m_strikes = strikes;
 }
 
+int PlayerBuilder::cpuCoreCount() const
+{
+	return m_cpuCoreCount;
+}
+
+void PlayerBuilder::setCpuCoreCount(const int count)
+{
+	m_cpuCoreCount = qMax(count, 1);
+}
+
 void PlayerBuilder::setResumeScore(const int score)
 {
    m_resume_score = score;
@@ -60,6 +60,13 @@ class LIB_EXPORT PlayerBuilder
 		int strikes() const;
 		/*! Sets the player's mandated strikes to \a strikes. */
 		void setStrikes(const int strikes);
+		/*!
+		 * Returns the number of CPU cores the player is expected
+		 * to use. The default is 1.
+		 */
+		int cpuCoreCount() const;
+		/*! Sets the expected number of CPU cores to \a count. */
+		void setCpuCoreCount(const int count);
 		void setResumeScore(const int score);
 		int  resumescore() const;
 		/*!
@@ -82,6 +89,7 @@ class LIB_EXPORT PlayerBuilder
 		int m_rating;
 		int m_strikes;
 		int m_resume_score;
+		int m_cpuCoreCount;
 };
 
 #endif // PLAYERBUILDER_H
@@ -18,6 +18,7 @@
 
 #include "polyglotbook.h"
 #include <QDataStream>
+#include <QtEndian>
 
 namespace {
 
@@ -77,13 +78,23 @@ OpeningBook::Entry PolyglotBook::readEntry(QDataStream& in, quint64* key) const
 	return { moveFromBits(pgMove), weight };
 }
 
-void PolyglotBook::writeEntry(const Map::const_iterator& it,
+OpeningBook::Entry PolyglotBook::readEntry(const uchar* data,
+					   quint64* key) const
+{
+	// Decode the record in place; the book format is big-endian.
+	*key = qFromBigEndian<quint64>(data);
+	quint16 pgMove = qFromBigEndian<quint16>(data + 8);
+	quint16 weight = qFromBigEndian<quint16>(data + 10);
+
+	return { moveFromBits(pgMove), weight };
+}
+
+void PolyglotBook::writeEntry(quint64 key, const Entry& entry,
 			      QDataStream& out) const
 {
 	quint32 learn = 0;
-	quint64 key = it.key();
-	quint16 pgMove = moveToBits(it.value().move);
-	quint16 weight = it.value().weight;
+	quint16 pgMove = moveToBits(entry.move);
+	quint16 weight = entry.weight;
 	
 	// Store the data. Again, big-endian is used by default.
 	out << key << pgMove << weight << learn;
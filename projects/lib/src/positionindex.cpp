@@ -0,0 +1,213 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "positionindex.h"
+#include <algorithm>
+#include <QDataStream>
+#include <QSaveFile>
+#include <QSet>
+#include <QtEndian>
+#include "pgngame.h"
+#include "pgngameentry.h"
+#include "pgnstream.h"
+
+#define POSITION_INDEX_MAGIC   0xB0A4D1DE
+#define POSITION_INDEX_VERSION 1
+
+namespace {
+
+// Size of the magic, version, interval and record count fields
+const qint64 headerSize = 20;
+// Size of one key-to-game record
+const qint64 recordSize = 12;
+
+} // anonymous namespace
+
+PositionIndex::PositionIndex()
+	: m_records(nullptr),
+	  m_count(0),
+	  m_interval(0)
+{
+}
+
+PositionIndex::~PositionIndex()
+{
+}
+
+bool PositionIndex::build(const QString& pgnFile,
+			  const QString& indexFile,
+			  const QList<const PgnGameEntry*>& entries,
+			  int interval)
+{
+	Q_ASSERT(interval > 0);
+
+	QFile file(pgnFile);
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+		return false;
+
+	PgnStream in(&file);
+
+	struct Record
+	{
+		quint64 key;
+		quint32 game;
+	};
+	QVector<Record> records;
+
+	for (int i = 0; i < entries.count(); i++)
+	{
+		const PgnGameEntry* entry = entries.at(i);
+
+		PgnGame game;
+		if (!in.seek(entry->pos(), entry->lineNumber())
+		||  !game.read(in))
+			return false;
+
+		const QVector<PgnGame::MoveData>& moves = game.moves();
+		if (moves.isEmpty())
+			continue;
+
+		// Repetitions would produce duplicate records, so the
+		// sampled keys are collected into a set first. The
+		// starting position is left out: it would list every
+		// game of the collection.
+		QSet<quint64> keys;
+		for (int ply = interval; ply < moves.size(); ply += interval)
+			keys.insert(moves.at(ply).key);
+		keys.insert(game.key());
+
+		for (quint64 key : qAsConst(keys))
+			records.append({ key, quint32(i) });
+	}
+
+	std::sort(records.begin(), records.end(),
+		  [](const Record& a, const Record& b)
+	{
+		if (a.key != b.key)
+			return a.key < b.key;
+		return a.game < b.game;
+	});
+
+	// Write to a temporary file and rename it into place so that
+	// a mapping of the old index stays valid until it goes away
+	QSaveFile saveFile(indexFile);
+	if (!saveFile.open(QIODevice::WriteOnly))
+		return false;
+
+	QDataStream out(&saveFile);
+	out << quint32(POSITION_INDEX_MAGIC);
+	out << quint32(POSITION_INDEX_VERSION);
+	out << quint32(interval);
+	out << quint64(records.size());
+
+	for (const Record& record : qAsConst(records))
+	{
+		out << record.key;
+		out << record.game;
+	}
+
+	return saveFile.commit();
+}
+
+bool PositionIndex::open(const QString& indexFile)
+{
+	m_records = nullptr;
+	m_count = 0;
+	m_interval = 0;
+
+	if (m_file.isOpen())
+		m_file.close();
+	m_file.setFileName(indexFile);
+
+	if (!m_file.open(QIODevice::ReadOnly))
+		return false;
+
+	const qint64 size = m_file.size();
+	uchar* data = nullptr;
+	if (size >= headerSize)
+		data = m_file.map(0, size);
+	if (data == nullptr)
+	{
+		m_file.close();
+		return false;
+	}
+
+	if (qFromBigEndian<quint32>(data) != POSITION_INDEX_MAGIC
+	||  qFromBigEndian<quint32>(data + 4) != POSITION_INDEX_VERSION)
+	{
+		m_file.close();
+		return false;
+	}
+
+	m_interval = int(qFromBigEndian<quint32>(data + 8));
+	m_count = qint64(qFromBigEndian<quint64>(data + 12));
+
+	if (m_count < 0 || headerSize + m_count * recordSize > size)
+	{
+		m_count = 0;
+		m_file.close();
+		return false;
+	}
+
+	m_records = reinterpret_cast<const char*>(data) + headerSize;
+	return true;
+}
+
+bool PositionIndex::isOpen() const
+{
+	return m_records != nullptr;
+}
+
+int PositionIndex::interval() const
+{
+	return m_interval;
+}
+
+quint64 PositionIndex::keyAt(qint64 index) const
+{
+	return qFromBigEndian<quint64>(
+		reinterpret_cast<const uchar*>(m_records + index * recordSize));
+}
+
+QVector<int> PositionIndex::find(quint64 key) const
+{
+	QVector<int> games;
+	if (m_records == nullptr)
+		return games;
+
+	// Binary search for the first record with the key
+	qint64 lo = 0;
+	qint64 hi = m_count;
+	while (lo < hi)
+	{
+		qint64 mid = (lo + hi) / 2;
+		if (keyAt(mid) < key)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	for (qint64 i = lo; i < m_count && keyAt(i) == key; i++)
+	{
+		const uchar* record = reinterpret_cast<const uchar*>(
+			m_records + i * recordSize);
+		games.append(int(qFromBigEndian<quint32>(record + 8)));
+	}
+
+	return games;
+}
@@ -0,0 +1,97 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef POSITIONINDEX_H
+#define POSITIONINDEX_H
+
+#include <QFile>
+#include <QList>
+#include <QVector>
+class PgnGameEntry;
+
+
+/*!
+ * \brief An inverted index from board positions to games.
+ *
+ * A position index maps Zobrist keys, sampled every few plies while
+ * a game collection is imported, to the ordinals of the games that
+ * reach them. The index is stored as a sorted array of fixed-size
+ * records in a file that is memory-mapped for queries, so finding
+ * all games through a given position is a binary search instead of
+ * a replay of the whole collection.
+ *
+ * Positions between two sample points are not indexed, so a smaller
+ * sampling interval finds more transpositions at the cost of a
+ * bigger index file.
+ *
+ * \sa PgnGameEntry
+ * \sa Chess::Zobrist
+ */
+class LIB_EXPORT PositionIndex
+{
+	public:
+		/*! Creates a new closed PositionIndex. */
+		PositionIndex();
+		/*! Destructs the index and closes the index file. */
+		~PositionIndex();
+
+		/*!
+		 * Builds a position index for the games of \a pgnFile
+		 * listed in \a entries and writes it to \a indexFile.
+		 *
+		 * Every game is replayed and its position keys are
+		 * sampled every \a interval plies; the end position is
+		 * always included. The game ordinals stored in the
+		 * index are positions in \a entries.
+		 *
+		 * Returns true if successful; otherwise returns false.
+		 */
+		static bool build(const QString& pgnFile,
+				  const QString& indexFile,
+				  const QList<const PgnGameEntry*>& entries,
+				  int interval);
+
+		/*!
+		 * Opens the index in \a indexFile and maps it into
+		 * memory.
+		 * Returns true if successful; otherwise returns false.
+		 */
+		bool open(const QString& indexFile);
+		/*! Returns true if an index is open. */
+		bool isOpen() const;
+
+		/*! Returns the sampling interval of the open index. */
+		int interval() const;
+
+		/*!
+		 * Returns the ordinals of the games that reach the
+		 * position with Zobrist key \a key, in the order the
+		 * games appear in the collection.
+		 */
+		QVector<int> find(quint64 key) const;
+
+	private:
+		quint64 keyAt(qint64 index) const;
+
+		QFile m_file;
+		const char* m_records;
+		qint64 m_count;
+		int m_interval;
+};
+
+#endif // POSITIONINDEX_H
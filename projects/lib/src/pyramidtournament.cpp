@@ -48,6 +48,10 @@ int PyramidTournament::gamesPerCycle() const
 
 TournamentPair* PyramidTournament::nextPair(int gameNumber)
 {
+	// The pairing schedule is fixed: player N meets players
+	// 0..N-1 in sequence, regardless of results. Each call is
+	// constant time, so the pairing cost doesn't grow with the
+	// size of the pool.
 	if (gameNumber >= finalGameCount())
 		return nullptr;
 	if (gameNumber % gamesPerEncounter() != 0)
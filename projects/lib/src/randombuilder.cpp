@@ -0,0 +1,47 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "randombuilder.h"
+#include "randomplayer.h"
+
+RandomBuilder::RandomBuilder(const QString& name)
+	: PlayerBuilder(name)
+{
+}
+
+bool RandomBuilder::isHuman() const
+{
+	return false;
+}
+
+ChessPlayer* RandomBuilder::create(QObject* receiver,
+				   const char* method,
+				   QObject* parent,
+				   QString* error) const
+{
+	Q_UNUSED(error);
+
+	ChessPlayer* player = new RandomPlayer(parent);
+	if (!name().isEmpty())
+		player->setName(name());
+	if (receiver != nullptr && method != nullptr)
+		QObject::connect(player, SIGNAL(debugMessage(QString)),
+				 receiver, method);
+
+	return player;
+}
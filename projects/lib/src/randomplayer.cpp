@@ -0,0 +1,74 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "randomplayer.h"
+#include "board/board.h"
+#include "mersenne.h"
+
+RandomPlayer::RandomPlayer(QObject* parent)
+	: ChessPlayer(parent)
+{
+	setState(Idle);
+	setName("RandomPlayer");
+}
+
+void RandomPlayer::startGame()
+{
+}
+
+void RandomPlayer::startThinking()
+{
+	// Emit the move from the event loop instead of right here, so
+	// that a whole game of instant replies can't recurse through
+	// the two players' call stacks
+	QMetaObject::invokeMethod(this, "pickMove", Qt::QueuedConnection);
+}
+
+void RandomPlayer::pickMove()
+{
+	if (state() != Thinking)
+		return;
+
+	const QVector<Chess::Move> moves = board()->legalMoves();
+	if (moves.isEmpty())
+		return;
+
+	emitMove(moves.at(Mersenne::random() % moves.size()));
+}
+
+void RandomPlayer::endGame(const Chess::Result& result)
+{
+	ChessPlayer::endGame(result);
+	setState(Idle);
+}
+
+void RandomPlayer::makeMove(const Chess::Move& move)
+{
+	Q_UNUSED(move);
+}
+
+bool RandomPlayer::supportsVariant(const QString& variant) const
+{
+	Q_UNUSED(variant);
+	return true;
+}
+
+bool RandomPlayer::isHuman() const
+{
+	return false;
+}
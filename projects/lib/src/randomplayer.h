@@ -0,0 +1,62 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef RANDOMPLAYER_H
+#define RANDOMPLAYER_H
+
+#include "chessplayer.h"
+
+
+/*!
+ * \brief A chess player that plays random legal moves.
+ *
+ * A RandomPlayer replies to every position instantly with a
+ * uniformly chosen legal move. It spends no measurable time
+ * thinking, so a match between two RandomPlayer objects runs
+ * games through the full Tournament, GameManager and PgnGame
+ * pipeline as fast as the pipeline itself allows, which makes
+ * it suitable for benchmarking scheduler and bookkeeping
+ * changes without engine noise.
+ *
+ * Typically random players are created by using a RandomBuilder
+ * object.
+ */
+class LIB_EXPORT RandomPlayer : public ChessPlayer
+{
+	Q_OBJECT
+
+	public:
+		/*! Creates a new random player. */
+		RandomPlayer(QObject* parent = nullptr);
+
+		// Inherited from ChessPlayer
+		virtual void endGame(const Chess::Result& result);
+		virtual void makeMove(const Chess::Move& move);
+		virtual bool supportsVariant(const QString& variant) const;
+		virtual bool isHuman() const;
+
+	protected:
+		// Inherited from ChessPlayer
+		virtual void startGame();
+		virtual void startThinking();
+
+	private slots:
+		void pickMove();
+};
+
+#endif // RANDOMPLAYER_H
@@ -19,12 +19,13 @@
 
 #include "roundrobintournament.h"
 #include <algorithm>
+#include "sprt.h"
 
 RoundRobinTournament::RoundRobinTournament(GameManager* gameManager,
 					   EngineManager* engineManager,
 					   QObject *parent)
 	: Tournament(gameManager, engineManager, parent),
-	  m_pairNumber(0)
+	  m_roundsScheduled(0)
 {
 }
 
@@ -48,6 +49,12 @@ int RoundRobinTournament::gamesPerRound() const
 
 QList< QPair<QString, QString> > RoundRobinTournament::getPairings()
 {
+	// The pairing order is fixed once the tournament has started,
+	// so the list is generated only once and reused by the callers
+	// that refresh their output after every game.
+	if (m_pairings.size() == finalGameCount())
+		return m_pairings;
+
 	const int count = playerCount() + (playerCount() % 2);
 	QList< QPair<QString, QString> > pList;
 
@@ -94,29 +101,21 @@ QList< QPair<QString, QString> > RoundRobinTournament::getPairings()
 	}
 	else
 	{
-		QList<int> topHalf;
-		QList<int> bottomHalf;
+		int round = 0;
 		int pairNumber = 0;
 		int gameNumber = 0;
 
-		for (int i = 0; i < count / 2; i++)
-			topHalf.append(i);
-		for (int i = count - 1; i >= count / 2; i--)
-			bottomHalf.append(i);
-
 		while (gameNumber < finalGameCount())
 		{
-			if (pairNumber >= topHalf.size())
+			if (pairNumber >= count / 2)
 			{
 				pairNumber = 0;
-				topHalf.insert(1, bottomHalf.takeFirst());
-				bottomHalf.append(topHalf.takeLast());
+				++round;
 			}
 
-			int white = topHalf.at(pairNumber);
-			int black = bottomHalf.at(pairNumber);
-
-			++pairNumber;
+			const QPair<int, int> indexes = pairAt(round, pairNumber++);
+			int white = indexes.first;
+			int black = indexes.second;
 
 			if (white < playerCount() && black < playerCount())
 			{
@@ -133,25 +132,19 @@ QList< QPair<QString, QString> > RoundRobinTournament::getPairings()
 		}
 	}
 
+	m_pairings = pList;
 	return pList;
 }
 
 void RoundRobinTournament::initializePairing()
 {
-	m_pairNumber = 0;
+	m_roundsScheduled = 0;
+	m_pairQueue.clear();
+	m_pairings.clear();
 	if (bergerSchedule())
 		initializePairing(m_topHalf);
 	else
-	{
 		m_topHalf.clear();
-		m_bottomHalf.clear();
-		int count = playerCount() + (playerCount() % 2);
-
-		for (int i = 0; i < count / 2; i++)
-			m_topHalf.append(i);
-		for (int i = count - 1; i >= count / 2; i--)
-			m_bottomHalf.append(i);
-	}
 }
 
 void RoundRobinTournament::initializePairing(QList<int>& bergerTable)
@@ -172,24 +165,43 @@ int RoundRobinTournament::gamesPerCycle() const
 	return (playerCount() * (playerCount() - 1)) / 2;
 }
 
-TournamentPair* RoundRobinTournament::nextPair(int gameNumber)
+// Returns the player indexes of pair 'index' in 'round' of a
+// circle-method schedule. Player 0 sits still while the others
+// rotate one seat per round, so any pairing follows directly from
+// round/index arithmetic; no rotation state is kept or replayed.
+QPair<int, int> RoundRobinTournament::pairAt(int round, int index) const
 {
-	if (gameNumber >= finalGameCount())
-		return nullptr;
+	const int count = playerCount() + (playerCount() % 2);
+	const int rotating = count - 1;
+
+	// Value of the player on rotating seat j: the seats run along
+	// the top row and back along the bottom row, and every player
+	// moves up one seat per round.
+	auto seat = [=](int j)
+	{
+		return (j % rotating + rotating) % rotating + 1;
+	};
 
-	int white, black;
+	if (index == 0)
+		return qMakePair(0, seat(rotating - 1 - round));
+	return qMakePair(seat(index - 1 - round),
+			 seat(rotating - 1 - index - round));
+}
+
+void RoundRobinTournament::fillPairQueue()
+{
+	const int count = playerCount() + (playerCount() % 2);
 
 	if (bergerSchedule())
 	{
-		const int count = playerCount() + (playerCount() % 2);
 		const int roundsPerCycle = gamesPerCycle() / (count / 2);
 
-		if (m_pairNumber >= m_topHalf.size())
+		// Rotate the Berger table before every round but the first
+		if (m_roundsScheduled > 0)
 		{
 			for (int i = 0; i < count; i++)
 				if (m_topHalf[i] != count - 1)
 					m_topHalf[i] = (m_topHalf[i] + (count / 2)) % (count - 1);
-			m_pairNumber = 0;
 
 			const int cRound = currentRound();
 			m_topHalf.insert(!((cRound % roundsPerCycle) % 2),
@@ -197,27 +209,47 @@ TournamentPair* RoundRobinTournament::nextPair(int gameNumber)
 			setCurrentRound(cRound + 1);
 		}
 
-		white = m_topHalf[m_pairNumber++];
-		black = m_topHalf[m_pairNumber++];
+		for (int i = 0; i < count; i += 2)
+			m_pairQueue.append(qMakePair(m_topHalf.at(i),
+						     m_topHalf.at(i + 1)));
 	}
 	else
 	{
-		if (gameNumber % gamesPerEncounter() != 0)
-			return currentPair();
-
-		if (m_pairNumber >= m_topHalf.size())
-		{
-			m_pairNumber = 0;
+		if (m_roundsScheduled > 0)
 			setCurrentRound(currentRound() + 1);
-			m_topHalf.insert(1, m_bottomHalf.takeFirst());
-			m_bottomHalf.append(m_topHalf.takeLast());
-		}
 
-		white = m_topHalf.at(m_pairNumber);
-		black = m_bottomHalf.at(m_pairNumber);
+		for (int index = 0; index < count / 2; index++)
+			m_pairQueue.append(pairAt(currentRound() - 1, index));
+	}
+	m_roundsScheduled++;
 
-		m_pairNumber++;
+	// An undecided SPRT is fed fastest by direct evidence about the
+	// candidate (player 0), so play the candidate's encounters of
+	// the round first and the rest after; the tournament often
+	// terminates before the deferred ones would have run.
+	if (!sprt()->isNull() && sprt()->status().result == Sprt::Continue)
+	{
+		std::stable_partition(m_pairQueue.begin(), m_pairQueue.end(),
+				      [](const QPair<int, int>& p)
+		{
+			return p.first == 0 || p.second == 0;
+		});
 	}
+}
+
+TournamentPair* RoundRobinTournament::nextPair(int gameNumber)
+{
+	if (gameNumber >= finalGameCount())
+		return nullptr;
+	if (!bergerSchedule() && gameNumber % gamesPerEncounter() != 0)
+		return currentPair();
+
+	if (m_pairQueue.isEmpty())
+		fillPairQueue();
+
+	const QPair<int, int> indexes = m_pairQueue.takeFirst();
+	int white = indexes.first;
+	int black = indexes.second;
 
 	// If 'white' or 'black' equals 'playerCount()' it means
 	// that it's a "bye" player, that is an empty player that
@@ -50,10 +50,16 @@ class LIB_EXPORT RoundRobinTournament : public Tournament
 
 	private:
 		void initializePairing(QList<int>& bergerTable);
+		QPair<int, int> pairAt(int round, int index) const;
+		// Schedules the next round of encounters into the pair
+		// queue, putting the most informative ones first when a
+		// stopping rule is close to a decision
+		void fillPairQueue();
 
-		int m_pairNumber;
+		int m_roundsScheduled;
+		QList< QPair<int, int> > m_pairQueue;
 		QList<int> m_topHalf;
-		QList<int> m_bottomHalf;
+		QList< QPair<QString, QString> > m_pairings;
 };
 
 #endif // ROUNDROBINTOURNAMENT_H
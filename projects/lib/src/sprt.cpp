@@ -137,8 +137,11 @@ Sprt::Sprt()
 	  m_beta(0),
 	  m_wins(0),
 	  m_losses(0),
-	  m_draws(0)
+	  m_draws(0),
+	  m_statusValid(false)
 {
+	for (int i = 0; i < 5; i++)
+		m_pairCounts[i] = 0;
 }
 
 bool Sprt::isNull() const
@@ -153,45 +156,106 @@ void Sprt::initialize(double elo0, double elo1,
 	m_elo1 = elo1;
 	m_alpha = alpha;
 	m_beta = beta;
+	m_statusValid = false;
 }
 
 Sprt::Status Sprt::status() const
 {
+	// The status only changes with the result counts, so it's
+	// computed once per update no matter how often it's polled
+	if (m_statusValid)
+		return m_status;
+
 	Status status = {
 		Continue,
 		0.0,
 		0.0,
 		0.0
 	};
+	bool haveData = false;
+
+	if (m_wins > 0 && m_losses > 0 && m_draws > 0)
+	{
+		// Estimate draw_elo out of sample
+		const SprtProbability p(m_wins, m_losses, m_draws);
+		const BayesElo b(p);
+
+		// Probability laws under H0 and H1
+		const double s = b.scale();
+		const BayesElo b0(m_elo0 / s, b.drawElo());
+		const BayesElo b1(m_elo1 / s, b.drawElo());
+		const SprtProbability p0(b0), p1(b1);
+
+		// Log-Likelyhood Ratio
+		status.llr = m_wins * std::log(p1.pWin() / p0.pWin()) +
+			     m_losses * std::log(p1.pLoss() / p0.pLoss()) +
+			     m_draws * std::log(p1.pDraw() / p0.pDraw());
+		haveData = true;
+	}
+
+	// Paired games: a generalized SPRT over the five pair outcomes.
+	// The correlation between the two games of a pair is captured
+	// by the observed variance of the pair score, so the resulting
+	// llr doesn't overstate the evidence the way treating the games
+	// as independent observations would.
+	int pairCount = 0;
+	for (int i = 0; i < 5; i++)
+		pairCount += m_pairCounts[i];
+	if (pairCount > 0)
+	{
+		static const double scores[] = { 0.0, 0.25, 0.5, 0.75, 1.0 };
+		double mean = 0.0;
+		double sqMean = 0.0;
+		for (int i = 0; i < 5; i++)
+		{
+			const double p = double(m_pairCounts[i]) / pairCount;
+			mean += p * scores[i];
+			sqMean += p * scores[i] * scores[i];
+		}
+		const double variance = sqMean - mean * mean;
+
+		if (variance > 0.0)
+		{
+			// Expected scores under H0 and H1 (logistic Elo)
+			const double s0 = 1.0 / (1.0 + std::pow(10.0, -m_elo0 / 400.0));
+			const double s1 = 1.0 / (1.0 + std::pow(10.0, -m_elo1 / 400.0));
+
+			status.llr += (s1 - s0) * (2.0 * mean - s0 - s1)
+				   *  pairCount / (2.0 * variance);
+			haveData = true;
+		}
+	}
+
+	if (haveData)
+	{
+		// Bounds based on error levels of the test
+		status.lBound = std::log(m_beta / (1.0 - m_alpha));
+		status.uBound = std::log((1.0 - m_beta) / m_alpha);
+
+		if (status.llr > status.uBound)
+			status.result = AcceptH1;
+		else if (status.llr < status.lBound)
+			status.result = AcceptH0;
+	}
+
+	m_status = status;
+	m_statusValid = true;
+	return status;
+}
 
-	if (m_wins <= 0 || m_losses <= 0 || m_draws <= 0)
-		return status;
-
-	// Estimate draw_elo out of sample
-	const SprtProbability p(m_wins, m_losses, m_draws);
-	const BayesElo b(p);
-
-	// Probability laws under H0 and H1
-	const double s = b.scale();
-	const BayesElo b0(m_elo0 / s, b.drawElo());
-	const BayesElo b1(m_elo1 / s, b.drawElo());
-	const SprtProbability p0(b0), p1(b1);
-
-	// Log-Likelyhood Ratio
-	status.llr = m_wins * std::log(p1.pWin() / p0.pWin()) +
-		     m_losses * std::log(p1.pLoss() / p0.pLoss()) +
-		     m_draws * std::log(p1.pDraw() / p0.pDraw());
-
-	// Bounds based on error levels of the test
-	status.lBound = std::log(m_beta / (1.0 - m_alpha));
-	status.uBound = std::log((1.0 - m_beta) / m_alpha);
-
-	if (status.llr > status.uBound)
-		status.result = AcceptH1;
-	else if (status.llr < status.lBound)
-		status.result = AcceptH0;
+void Sprt::addPairResult(GameResult firstGame, GameResult secondGame)
+{
+	auto points = [](GameResult result)
+	{
+		if (result == Win)
+			return 2;
+		if (result == Draw)
+			return 1;
+		return 0;
+	};
 
-	return status;
+	m_pairCounts[points(firstGame) + points(secondGame)]++;
+	m_statusValid = false;
 }
 
 void Sprt::addGameResult(GameResult result)
@@ -202,4 +266,25 @@ void Sprt::addGameResult(GameResult result)
 		m_draws++;
 	else if (result == Loss)
 		m_losses++;
+	m_statusValid = false;
+}
+
+void Sprt::addGameResults(int wins, int losses, int draws)
+{
+	Q_ASSERT(wins >= 0 && losses >= 0 && draws >= 0);
+
+	m_wins += wins;
+	m_losses += losses;
+	m_draws += draws;
+	m_statusValid = false;
+}
+
+void Sprt::setGameResults(int wins, int losses, int draws)
+{
+	Q_ASSERT(wins >= 0 && losses >= 0 && draws >= 0);
+
+	m_wins = wins;
+	m_losses = losses;
+	m_draws = draws;
+	m_statusValid = false;
 }
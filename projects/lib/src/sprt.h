@@ -87,6 +87,31 @@ class LIB_EXPORT Sprt
 		 * check if H0 or H1 can be accepted.
 		 */
 		void addGameResult(GameResult result);
+		/*!
+		 * Updates the test with the outcome of a pair of games
+		 * played with the same opening and reversed colors.
+		 *
+		 * Paired games are correlated, so accounting for the
+		 * five possible pair outcomes (LL, LD/DL, DD/WL, WD/DW,
+		 * WW) instead of two independent game results reaches
+		 * the same error rates in fewer games.
+		 */
+		void addPairResult(GameResult firstGame,
+				   GameResult secondGame);
+		/*!
+		 * Updates the test with a batch of \a wins, \a losses
+		 * and \a draws at once, eg. results collected from
+		 * another machine.
+		 */
+		void addGameResults(int wins, int losses, int draws);
+		/*!
+		 * Sets the game results to \a wins, \a losses and \a draws.
+		 *
+		 * This function restores the state of the test when a
+		 * tournament is resumed, as if addGameResult() had been
+		 * called once per previously played game.
+		 */
+		void setGameResults(int wins, int losses, int draws);
 
 	private:
 		double m_elo0;
@@ -96,6 +121,11 @@ class LIB_EXPORT Sprt
 		int m_wins;
 		int m_losses;
 		int m_draws;
+		// Pair outcomes indexed by the first player's points
+		// over the pair (0-4)
+		int m_pairCounts[5];
+		mutable bool m_statusValid;
+		mutable Status m_status;
 };
 
 #endif // SPRT_H
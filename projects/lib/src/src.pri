@@ -6,7 +6,9 @@ HEADERS += $$PWD/chessengine.h \
     $$PWD/chessplayer.h \
     $$PWD/engineconfiguration.h \
     $$PWD/openingbook.h \
+    $$PWD/layeredbook.h \
     $$PWD/pgnstream.h \
+    $$PWD/gzipdevice.h \
     $$PWD/pgngame.h \
     $$PWD/polyglotbook.h \
     $$PWD/timecontrol.h \
@@ -22,14 +24,21 @@ HEADERS += $$PWD/chessengine.h \
     $$PWD/enginetextoption.h \
     $$PWD/enginebuttonoption.h \
     $$PWD/pgngameentry.h \
+    $$PWD/positionindex.h \
     $$PWD/gamemanager.h \
     $$PWD/playerbuilder.h \
     $$PWD/enginebuilder.h \
+    $$PWD/enginesocket.h \
     $$PWD/classregistry.h \
     $$PWD/enginefactory.h \
     $$PWD/humanbuilder.h \
+    $$PWD/randomplayer.h \
+    $$PWD/randombuilder.h \
+    $$PWD/engineoptioncache.h \
     $$PWD/engineoptionfactory.h \
     $$PWD/pgngamefilter.h \
+    $$PWD/pgnverifier.h \
+    $$PWD/pgnwriter.h \
     $$PWD/tournament.h \
     $$PWD/roundrobintournament.h \
     $$PWD/tournamentfactory.h \
@@ -43,15 +52,26 @@ HEADERS += $$PWD/chessengine.h \
     $$PWD/elo.h \
     $$PWD/knockouttournament.h \
     $$PWD/pyramidtournament.h \
+    $$PWD/swisstournament.h \
     $$PWD/tournamentplayer.h \
     $$PWD/tournamentpair.h \
-    $$PWD/worker.h
+    $$PWD/worker.h \
+    $$PWD/taskfuture.h \
+    $$PWD/enginecommlog.h \
+    $$PWD/enginecommreplay.h \
+    $$PWD/timerwheel.h \
+    $$PWD/metrics.h \
+    $$PWD/tracer.h \
+    $$PWD/histogram.h \
+    $$PWD/eventstream.h
 SOURCES += $$PWD/chessengine.cpp \
     $$PWD/chessgame.cpp \
     $$PWD/chessplayer.cpp \
     $$PWD/engineconfiguration.cpp \
     $$PWD/openingbook.cpp \
+    $$PWD/layeredbook.cpp \
     $$PWD/pgnstream.cpp \
+    $$PWD/gzipdevice.cpp \
     $$PWD/pgngame.cpp \
     $$PWD/polyglotbook.cpp \
     $$PWD/timecontrol.cpp \
@@ -67,13 +87,20 @@ SOURCES += $$PWD/chessengine.cpp \
     $$PWD/enginetextoption.cpp \
     $$PWD/enginebuttonoption.cpp \
     $$PWD/pgngameentry.cpp \
+    $$PWD/positionindex.cpp \
     $$PWD/gamemanager.cpp \
     $$PWD/playerbuilder.cpp \
     $$PWD/enginebuilder.cpp \
+    $$PWD/enginesocket.cpp \
     $$PWD/enginefactory.cpp \
     $$PWD/humanbuilder.cpp \
+    $$PWD/randomplayer.cpp \
+    $$PWD/randombuilder.cpp \
+    $$PWD/engineoptioncache.cpp \
     $$PWD/engineoptionfactory.cpp \
     $$PWD/pgngamefilter.cpp \
+    $$PWD/pgnverifier.cpp \
+    $$PWD/pgnwriter.cpp \
     $$PWD/tournament.cpp \
     $$PWD/roundrobintournament.cpp \
     $$PWD/tournamentfactory.cpp \
@@ -87,12 +114,23 @@ SOURCES += $$PWD/chessengine.cpp \
     $$PWD/elo.cpp \
     $$PWD/knockouttournament.cpp \
     $$PWD/pyramidtournament.cpp \
+    $$PWD/swisstournament.cpp \
     $$PWD/tournamentplayer.cpp \
     $$PWD/tournamentpair.cpp \
-    $$PWD/worker.cpp
-win32 { 
+    $$PWD/worker.cpp \
+    $$PWD/enginecommlog.cpp \
+    $$PWD/enginecommreplay.cpp \
+    $$PWD/timerwheel.cpp \
+    $$PWD/metrics.cpp \
+    $$PWD/tracer.cpp \
+    $$PWD/histogram.cpp \
+    $$PWD/eventstream.cpp
+win32 {
     HEADERS += $$PWD/engineprocess_win.h \
 	$$PWD/pipereader_win.h
     SOURCES += $$PWD/engineprocess_win.cpp \
 	$$PWD/pipereader_win.cpp
+} else {
+    HEADERS += $$PWD/engineprocess_unix.h
+    SOURCES += $$PWD/engineprocess_unix.cpp
 }
@@ -0,0 +1,208 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "swisstournament.h"
+#include <algorithm>
+#include "playerbuilder.h"
+
+SwissTournament::SwissTournament(GameManager* gameManager,
+				 EngineManager* engineManager,
+				 QObject *parent)
+	: Tournament(gameManager, engineManager, parent),
+	  m_generatedRounds(0)
+{
+}
+
+QString SwissTournament::type() const
+{
+	return "swiss";
+}
+
+int SwissTournament::gamesPerRound() const
+{
+	return (playerCount() / 2) * gamesPerEncounter();
+}
+
+int SwissTournament::gamesPerCycle() const
+{
+	// One Swiss round; the round multiplier sets the round count
+	return playerCount() / 2;
+}
+
+QList< QPair<QString, QString> > SwissTournament::getPairings()
+{
+	// Swiss pairings depend on the standings, so only the rounds
+	// that have been paired already can be listed.
+	return m_pairings;
+}
+
+void SwissTournament::initializePairing()
+{
+	m_pairQueue.clear();
+	m_pairings.clear();
+	m_opponents.clear();
+	m_opponents.resize(playerCount());
+	m_colorDiff.clear();
+	m_colorDiff.resize(playerCount());
+	m_byes.clear();
+	m_generatedRounds = 0;
+}
+
+int SwissTournament::playerScore(int index) const
+{
+	return playerAt(index).score()
+	       + playerAt(index).builder()->resumescore();
+}
+
+bool SwissTournament::matchPlayers(QList<int>& ranking,
+				   QList< QPair<int, int> >& pairs,
+				   bool allowRematches) const
+{
+	if (ranking.isEmpty())
+		return true;
+
+	const int first = ranking.takeFirst();
+	for (int i = 0; i < ranking.size(); i++)
+	{
+		const int opponent = ranking.at(i);
+		if (!allowRematches
+		&&  m_opponents.at(first).contains(opponent))
+			continue;
+
+		ranking.removeAt(i);
+		pairs.append(qMakePair(first, opponent));
+		if (matchPlayers(ranking, pairs, allowRematches))
+			return true;
+		pairs.removeLast();
+		ranking.insert(i, opponent);
+	}
+	ranking.prepend(first);
+
+	return false;
+}
+
+void SwissTournament::generateNextRound()
+{
+	const int count = playerCount();
+	QList<int> ranking;
+
+	if (m_generatedRounds == 0)
+	{
+		// First round: fold pairing, ie. the top seed meets the
+		// top seed of the bottom half and so on. Interleaving the
+		// halves here makes the matcher pick exactly those pairs.
+		const int half = (count + 1) / 2;
+		for (int i = 0; i < half; i++)
+		{
+			ranking.append(i);
+			if (half + i < count)
+				ranking.append(half + i);
+		}
+	}
+	else
+	{
+		// Sorting by score brings equal scores next to each
+		// other, so the matcher tries same-group opponents
+		// first and crosses group borders only when it must.
+		for (int i = 0; i < count; i++)
+			ranking.append(i);
+		std::stable_sort(ranking.begin(), ranking.end(),
+				 [this](int a, int b)
+		{
+			return playerScore(a) > playerScore(b);
+		});
+	}
+
+	// With an odd number of players the lowest-ranked player who
+	// hasn't sat out yet gets the bye and plays no game this round
+	if (count % 2 != 0)
+	{
+		// Once everyone has sat out, start a new bye rotation
+		if (m_byes.size() >= count)
+			m_byes.clear();
+		for (int i = ranking.size() - 1; i >= 0; i--)
+		{
+			if (!m_byes.contains(ranking.at(i)))
+			{
+				m_byes.insert(ranking.at(i));
+				ranking.removeAt(i);
+				break;
+			}
+		}
+	}
+
+	QList< QPair<int, int> > pairs;
+	if (!matchPlayers(ranking, pairs, false))
+	{
+		// Every completion runs into a rematch; this can only
+		// happen when the tournament has more rounds than the
+		// pool can support, so allow rematches for this round
+		pairs.clear();
+		matchPlayers(ranking, pairs, true);
+	}
+
+	for (const QPair<int, int>& p : qAsConst(pairs))
+	{
+		int white = p.first;
+		int black = p.second;
+
+		// Give the more white-heavy player the black pieces
+		if (m_colorDiff.at(white) > m_colorDiff.at(black))
+			qSwap(white, black);
+		m_colorDiff[white]++;
+		m_colorDiff[black]--;
+
+		m_opponents[white].insert(black);
+		m_opponents[black].insert(white);
+
+		TournamentPair* tp = pair(white, black);
+		if (tp->firstPlayer() != white)
+			tp->swapPlayers();
+		m_pairQueue.append(tp);
+		m_pairings.append(qMakePair(playerAt(white).builder()->name(),
+					    playerAt(black).builder()->name()));
+	}
+
+	m_generatedRounds++;
+}
+
+TournamentPair* SwissTournament::nextPair(int gameNumber)
+{
+	if (gameNumber >= finalGameCount())
+		return nullptr;
+	if (gameNumber % gamesPerEncounter() != 0)
+		return currentPair();
+
+	if (m_pairQueue.isEmpty())
+	{
+		// The next round can't be paired until the standings are
+		// complete; the manager's ready() signal gets us back
+		// here once the last game of the round has finished.
+		if (gamesInProgress())
+			return nullptr;
+
+		generateNextRound();
+		if (m_generatedRounds > 1)
+			setCurrentRound(currentRound() + 1);
+		if (m_pairQueue.isEmpty())
+			return nullptr;
+	}
+
+	return m_pairQueue.takeFirst();
+}
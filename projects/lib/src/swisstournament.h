@@ -0,0 +1,77 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SWISSTOURNAMENT_H
+#define SWISSTOURNAMENT_H
+
+#include "tournament.h"
+#include <QSet>
+
+/*!
+ * \brief Swiss-system chess tournament.
+ *
+ * In a Swiss tournament every player plays in every round, and
+ * players with equal or similar scores are paired against each
+ * other. No pair meets twice unless every other pairing has been
+ * exhausted. The number of rounds is set with the round multiplier.
+ */
+class LIB_EXPORT SwissTournament : public Tournament
+{
+	Q_OBJECT
+
+	public:
+		/*! Creates a new Swiss tournament. */
+		explicit SwissTournament(GameManager* gameManager,
+					 EngineManager* engineManager,
+					 QObject *parent = nullptr);
+		// Inherited from Tournament
+		virtual QString type() const;
+		virtual int gamesPerRound() const;
+		virtual QList< QPair<QString, QString> > getPairings();
+
+	protected:
+		// Inherited from Tournament
+		virtual void initializePairing();
+		virtual int gamesPerCycle() const;
+		virtual TournamentPair* nextPair(int gameNumber);
+
+	private:
+		// Current score of player 'index', including any score
+		// carried over from a resumed tournament
+		int playerScore(int index) const;
+		// Pairs the next round from the current standings and
+		// fills the pair queue
+		void generateNextRound();
+		// Pairs off 'ranking' front to back, skipping opponents
+		// the first player has already met unless 'allowRematches'
+		// is set. Backtracks when a tail can't be completed.
+		// Returns false if no complete pairing exists.
+		bool matchPlayers(QList<int>& ranking,
+				  QList< QPair<int, int> >& pairs,
+				  bool allowRematches) const;
+
+		QList<TournamentPair*> m_pairQueue;
+		QList< QPair<QString, QString> > m_pairings;
+		QVector< QSet<int> > m_opponents;
+		QVector<int> m_colorDiff;
+		QSet<int> m_byes;
+		int m_generatedRounds;
+};
+
+#endif // SWISSTOURNAMENT_H
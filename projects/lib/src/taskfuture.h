@@ -0,0 +1,304 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TASKFUTURE_H
+#define TASKFUTURE_H
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include <QRunnable>
+#include <QSharedPointer>
+#include <QThreadPool>
+#include <functional>
+
+/*!
+ * \brief A future for a task running in a thread pool.
+ *
+ * runTask() submits a callable to a QThreadPool and returns a
+ * TaskFuture for its result. The future can be waited on with
+ * result() or waitForFinished(), chained with then(), which runs
+ * another callable on the result in the same pool, and cancelled.
+ * Background features share a pool through this one interface
+ * instead of each growing a bespoke worker thread.
+ *
+ * The result type must be default-constructible and copyable. A
+ * cancelled task doesn't run if it hasn't started yet, and its
+ * continuations are skipped if the cancellation came before the task
+ * finished; result() then returns a default-constructed value.
+ *
+ * Example:
+ * \code
+ * runTask(pool, [fen]() { return probePosition(fen); })
+ *     .then([](const ProbeResult& result) { return render(result); });
+ * \endcode
+ *
+ * \sa Worker
+ */
+template<typename T>
+class TaskFuture
+{
+	public:
+		/*! Creates an invalid future. */
+		TaskFuture() {}
+
+		/*! Returns true if the future belongs to a task. */
+		bool isValid() const
+		{
+			return !m_state.isNull();
+		}
+
+		/*!
+		 * Returns true if the task has finished, which includes
+		 * being cancelled before it started.
+		 */
+		bool isFinished() const
+		{
+			Q_ASSERT(isValid());
+
+			QMutexLocker locker(&m_state->mutex);
+			return m_state->finished;
+		}
+
+		/*! Returns true if the task was cancelled. */
+		bool isCancelled() const
+		{
+			Q_ASSERT(isValid());
+
+			QMutexLocker locker(&m_state->mutex);
+			return m_state->cancelled;
+		}
+
+		/*!
+		 * Cancels the task.
+		 *
+		 * A task that hasn't started yet won't run at all. A
+		 * task that is already running completes, but its result
+		 * is dropped. Either way the continuations chained with
+		 * then() are cancelled too. Cancelling a finished task
+		 * has no effect on its continuations.
+		 */
+		void cancel()
+		{
+			Q_ASSERT(isValid());
+
+			QMutexLocker locker(&m_state->mutex);
+			if (!m_state->finished)
+				m_state->cancelled = true;
+		}
+
+		/*! Waits until the task has finished. */
+		void waitForFinished() const
+		{
+			Q_ASSERT(isValid());
+
+			QMutexLocker locker(&m_state->mutex);
+			while (!m_state->finished)
+				m_state->done.wait(&m_state->mutex);
+		}
+
+		/*!
+		 * Waits until the task has finished and returns its
+		 * result, or a default-constructed value if the task
+		 * was cancelled.
+		 */
+		T result() const
+		{
+			Q_ASSERT(isValid());
+
+			QMutexLocker locker(&m_state->mutex);
+			while (!m_state->finished)
+				m_state->done.wait(&m_state->mutex);
+			return m_state->result;
+		}
+
+		/*!
+		 * Chains \a fn to run on this task's result in the same
+		 * pool and returns a future for \a fn's result.
+		 *
+		 * If this task is cancelled before it finishes, \a fn is
+		 * skipped and the returned future is cancelled too.
+		 */
+		template<typename Fn>
+		auto then(Fn fn) const -> TaskFuture<decltype(fn(std::declval<T>()))>
+		{
+			using U = decltype(fn(std::declval<T>()));
+			Q_ASSERT(isValid());
+
+			TaskFuture<U> next;
+			next.m_state =
+				QSharedPointer<typename TaskFuture<U>::State>::create();
+			next.m_state->pool = m_state->pool;
+
+			auto nextState = next.m_state;
+			QThreadPool* pool = m_state->pool;
+
+			enum { Chain, RunNow, CancelNow } action = Chain;
+			T value = T();
+			{
+				QMutexLocker locker(&m_state->mutex);
+				if (m_state->cancelled)
+					action = CancelNow;
+				else if (m_state->finished)
+				{
+					action = RunNow;
+					value = m_state->result;
+				}
+				else
+					m_state->continuation =
+						[pool, nextState, fn](const T& result,
+								      bool cancelled)
+					{
+						if (cancelled)
+							TaskFuture<U>::finishCancelled(nextState);
+						else
+							pool->start(new typename TaskFuture<U>::Runnable(
+								nextState,
+								[fn, result]() { return fn(result); }));
+					};
+			}
+
+			if (action == RunNow)
+				pool->start(new typename TaskFuture<U>::Runnable(
+					nextState,
+					[fn, value]() { return fn(value); }));
+			else if (action == CancelNow)
+				TaskFuture<U>::finishCancelled(nextState);
+
+			return next;
+		}
+
+		/*!
+		 * Runs \a fn in \a pool and returns a future for its
+		 * result. Usually called through runTask().
+		 */
+		static TaskFuture<T> start(QThreadPool* pool, std::function<T()> fn)
+		{
+			TaskFuture<T> future;
+			future.m_state = QSharedPointer<State>::create();
+			future.m_state->pool = pool;
+			pool->start(new Runnable(future.m_state, fn));
+
+			return future;
+		}
+
+	private:
+		template<typename U> friend class TaskFuture;
+
+		struct State
+		{
+			State()
+				: finished(false),
+				  cancelled(false),
+				  result(T()),
+				  pool(nullptr)
+			{
+			}
+
+			QMutex mutex;
+			QWaitCondition done;
+			bool finished;
+			bool cancelled;
+			T result;
+			// Runs with the result (or the cancelled flag)
+			// once the task has finished
+			std::function<void(const T&, bool)> continuation;
+			QThreadPool* pool;
+		};
+
+		class Runnable : public QRunnable
+		{
+			public:
+				Runnable(const QSharedPointer<State>& state,
+					 const std::function<T()>& fn)
+					: m_state(state),
+					  m_fn(fn)
+				{
+				}
+
+				virtual void run()
+				{
+					bool cancelled;
+					{
+						QMutexLocker locker(&m_state->mutex);
+						cancelled = m_state->cancelled;
+					}
+
+					T result = T();
+					if (!cancelled)
+						result = m_fn();
+
+					std::function<void(const T&, bool)> continuation;
+					{
+						QMutexLocker locker(&m_state->mutex);
+						// May have been set while running
+						cancelled = m_state->cancelled;
+						if (!cancelled)
+							m_state->result = result;
+						m_state->finished = true;
+						continuation = m_state->continuation;
+						m_state->continuation = nullptr;
+						m_state->done.wakeAll();
+					}
+					if (continuation)
+						continuation(result, cancelled);
+				}
+
+			private:
+				QSharedPointer<State> m_state;
+				std::function<T()> m_fn;
+		};
+
+		// Finishes a future whose upstream task was cancelled,
+		// propagating the cancellation down the chain
+		static void finishCancelled(const QSharedPointer<State>& state)
+		{
+			std::function<void(const T&, bool)> continuation;
+			{
+				QMutexLocker locker(&state->mutex);
+				state->cancelled = true;
+				state->finished = true;
+				continuation = state->continuation;
+				state->continuation = nullptr;
+				state->done.wakeAll();
+			}
+			if (continuation)
+				continuation(T(), true);
+		}
+
+		QSharedPointer<State> m_state;
+};
+
+/*! Runs \a fn in \a pool and returns a future for its result. */
+template<typename Fn>
+auto runTask(QThreadPool* pool, Fn fn) -> TaskFuture<decltype(fn())>
+{
+	return TaskFuture<decltype(fn())>::start(pool, fn);
+}
+
+/*!
+ * Runs \a fn in the global thread pool and returns a future for its
+ * result.
+ */
+template<typename Fn>
+auto runTask(Fn fn) -> TaskFuture<decltype(fn())>
+{
+	return runTask(QThreadPool::globalInstance(), fn);
+}
+
+#endif // TASKFUTURE_H
@@ -47,12 +47,13 @@ TimeControl::TimeControl()
 	  m_timePerTc(0),
 	  m_timePerMove(0),
 	  m_increment(0),
-	  m_timeLeft(0),
+	  m_timeLeftUsecs(0),
 	  m_movesLeft(0),
 	  m_plyLimit(0),
 	  m_nodeLimit(0),
-	  m_lastMoveTime(0),
+	  m_lastMoveTimeUsecs(0),
 	  m_expiryMargin(0),
+	  m_arrivalNsecs(-1),
 	  m_expired(false),
 	  m_infinite(false)
 {
@@ -63,12 +64,13 @@ TimeControl::TimeControl(const QString& str)
 	  m_timePerTc(0),
 	  m_timePerMove(0),
 	  m_increment(0),
-	  m_timeLeft(0),
+	  m_timeLeftUsecs(0),
 	  m_movesLeft(0),
 	  m_plyLimit(0),
 	  m_nodeLimit(0),
-	  m_lastMoveTime(0),
+	  m_lastMoveTimeUsecs(0),
 	  m_expiryMargin(0),
+	  m_arrivalNsecs(-1),
 	  m_expired(false),
 	  m_infinite(false)
 {
@@ -198,15 +200,16 @@ QString TimeControl::toVerboseString() const
 void TimeControl::initialize()
 {
 	m_expired = false;
-	m_lastMoveTime = 0;
+	m_lastMoveTimeUsecs = 0;
+	m_arrivalNsecs = -1;
 
 	if (m_timePerTc != 0)
 	{
-		m_timeLeft = m_timePerTc;
+		setTimeLeft(m_timePerTc);
 		m_movesLeft = m_movesPerTc;
 	}
 	else if (m_timePerMove != 0)
-		m_timeLeft = m_timePerMove;
+		setTimeLeft(m_timePerMove);
 }
 
 bool TimeControl::isInfinite() const
@@ -236,7 +239,7 @@ int TimeControl::timePerMove() const
 
 int TimeControl::timeLeft() const
 {
-	return m_timeLeft;
+	return int(m_timeLeftUsecs / 1000);
 }
 
 int TimeControl::movesLeft() const
@@ -290,7 +293,7 @@ void TimeControl::setTimePerMove(int timePerMove)
 
 void TimeControl::setTimeLeft(int timeLeft)
 {
-	m_timeLeft = timeLeft;
+	m_timeLeftUsecs = qint64(timeLeft) * 1000;
 }
 
 void TimeControl::setMovesLeft(int movesLeft)
@@ -320,31 +323,42 @@ void TimeControl::setExpiryMargin(int expiryMargin)
 void TimeControl::startTimer()
 {
 	m_time.start();
+	m_arrivalNsecs = -1;
+}
+
+void TimeControl::markArrival()
+{
+	if (m_time.isValid())
+		m_arrivalNsecs = m_time.nsecsElapsed();
 }
 
 void TimeControl::update(bool applyIncrement)
 {
-	/*
-	 * This will overflow after roughly 49 days however it's unlikely
-	 * we'll ever hit that limit.
-	 */
 	if (m_time.isValid())
-		m_lastMoveTime = (int)m_time.elapsed();
+	{
+		// Prefer the timestamp taken when the move arrived so
+		// that processing delays don't count as thinking time
+		qint64 elapsedNsecs = m_arrivalNsecs >= 0
+				    ? m_arrivalNsecs
+				    : m_time.nsecsElapsed();
+		m_lastMoveTimeUsecs = elapsedNsecs / 1000;
+	}
 	else
-		m_lastMoveTime = 0;
+		m_lastMoveTimeUsecs = 0;
+	m_arrivalNsecs = -1;
 
-	if (!m_infinite && m_lastMoveTime > m_timeLeft + m_expiryMargin)
+	if (!m_infinite
+	&&  m_lastMoveTimeUsecs > m_timeLeftUsecs + qint64(m_expiryMargin) * 1000)
 		m_expired = true;
 
 	if (m_timePerMove != 0)
 		setTimeLeft(m_timePerMove);
 	else
 	{
-	        int newTimeLeft = m_timeLeft - m_lastMoveTime;
+		m_timeLeftUsecs -= m_lastMoveTimeUsecs;
 		if (applyIncrement)
-			newTimeLeft += m_increment;
-		setTimeLeft(newTimeLeft);
-		
+			m_timeLeftUsecs += qint64(m_increment) * 1000;
+
 		if (m_movesPerTc > 0)
 		{
 			setMovesLeft(m_movesLeft - 1);
@@ -353,7 +367,7 @@ void TimeControl::update(bool applyIncrement)
 			if (m_movesLeft == 0)
 			{
 				setMovesLeft(m_movesPerTc);
-				setTimeLeft(m_timePerTc + m_timeLeft);
+				m_timeLeftUsecs += qint64(m_timePerTc) * 1000;
 			}
 		}
 	}
@@ -361,7 +375,7 @@ void TimeControl::update(bool applyIncrement)
 
 int TimeControl::lastMoveTime() const
 {
-	return m_lastMoveTime;
+	return int(m_lastMoveTimeUsecs / 1000);
 }
 
 bool TimeControl::expired() const
@@ -372,8 +386,8 @@ bool TimeControl::expired() const
 int TimeControl::activeTimeLeft() const
 {
 	if (m_time.isValid())
-		return m_timeLeft - m_time.elapsed();
-	return m_timeLeft;
+		return int((m_timeLeftUsecs - m_time.nsecsElapsed() / 1000) / 1000);
+	return timeLeft();
 }
 
 void TimeControl::readSettings(QSettings* settings)
@@ -30,7 +30,9 @@ class QSettings;
  * TimeControl is used for telling the chess players how much time
  * they can spend thinking of their moves.
  *
- * \note All time handling is done in milliseconds.
+ * \note The public interface works in milliseconds, but time is
+ * tracked internally with microsecond accuracy so that rounding
+ * errors don't accumulate over the course of a game.
  */
 class LIB_EXPORT TimeControl
 {
@@ -173,7 +175,19 @@ class LIB_EXPORT TimeControl
 		
 		/*! Start the timer. */
 		void startTimer();
-		
+
+		/*!
+		 * Marks the current time as the arrival time of the
+		 * player's move.
+		 *
+		 * The next update() call uses this timestamp for the
+		 * elapsed move time instead of the time of the call,
+		 * so delays between receiving and processing the move
+		 * don't count against the clock. The mark is cleared
+		 * by update() and startTimer().
+		 */
+		void markArrival();
+
 		/*!
 		 * Update the time control with the elapsed time.
 		 * A move time increment will only be applied if
@@ -209,12 +223,13 @@ class LIB_EXPORT TimeControl
 		int m_timePerTc;
 		int m_timePerMove;
 		int m_increment;
-		int m_timeLeft;
+		qint64 m_timeLeftUsecs;
 		int m_movesLeft;
 		int m_plyLimit;
 		int m_nodeLimit;
-		int m_lastMoveTime;
+		qint64 m_lastMoveTimeUsecs;
 		int m_expiryMargin;
+		qint64 m_arrivalNsecs;
 		bool m_expired;
 		bool m_infinite;
 		QElapsedTimer m_time;
@@ -0,0 +1,135 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "timerwheel.h"
+#include <QThreadStorage>
+#include <QEvent>
+
+
+static QThreadStorage<TimerWheel*> s_wheels;
+
+TimerWheel* TimerWheel::instance()
+{
+	if (!s_wheels.hasLocalData())
+		s_wheels.setLocalData(new TimerWheel);
+	return s_wheels.localData();
+}
+
+TimerWheel::TimerWheel()
+	: QObject()
+{
+	m_clock.start();
+}
+
+void TimerWheel::add(WheelTimer* timer)
+{
+	if (!m_timers.contains(timer))
+		m_timers.append(timer);
+	if (!m_tick.isActive())
+		m_tick.start(Granularity, this);
+}
+
+void TimerWheel::remove(WheelTimer* timer)
+{
+	m_timers.removeOne(timer);
+	if (m_timers.isEmpty())
+		m_tick.stop();
+}
+
+void TimerWheel::timerEvent(QTimerEvent* event)
+{
+	if (event->timerId() != m_tick.timerId())
+	{
+		QObject::timerEvent(event);
+		return;
+	}
+
+	qint64 now = m_clock.elapsed();
+
+	// Collect the due timers first: a timeout handler may start
+	// or stop other timers and modify the active list.
+	QList<WheelTimer*> due;
+	QList<WheelTimer*>::iterator it = m_timers.begin();
+	while (it != m_timers.end())
+	{
+		WheelTimer* timer = *it;
+		if (timer->m_deadline <= now)
+		{
+			timer->m_deadline = -1;
+			due.append(timer);
+			it = m_timers.erase(it);
+		}
+		else
+			++it;
+	}
+	if (m_timers.isEmpty())
+		m_tick.stop();
+
+	for (WheelTimer* timer : qAsConst(due))
+		emit timer->timeout();
+}
+
+
+WheelTimer::WheelTimer(QObject* parent)
+	: QObject(parent),
+	  m_interval(0),
+	  m_deadline(-1)
+{
+}
+
+WheelTimer::~WheelTimer()
+{
+	stop();
+}
+
+void WheelTimer::setInterval(int msec)
+{
+	m_interval = msec;
+}
+
+int WheelTimer::interval() const
+{
+	return m_interval;
+}
+
+bool WheelTimer::isActive() const
+{
+	return m_deadline != -1;
+}
+
+void WheelTimer::start()
+{
+	TimerWheel* wheel = TimerWheel::instance();
+	m_deadline = wheel->m_clock.elapsed() + m_interval;
+	wheel->add(this);
+}
+
+void WheelTimer::start(int msec)
+{
+	setInterval(msec);
+	start();
+}
+
+void WheelTimer::stop()
+{
+	if (m_deadline == -1)
+		return;
+
+	m_deadline = -1;
+	TimerWheel::instance()->remove(this);
+}
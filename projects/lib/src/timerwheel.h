@@ -0,0 +1,126 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include <QObject>
+#include <QList>
+#include <QBasicTimer>
+#include <QElapsedTimer>
+class WheelTimer;
+
+
+/*!
+ * \brief A coarse per-thread scheduler for deadline checks.
+ *
+ * TimerWheel services all WheelTimer objects of one thread with a
+ * single system timer ticking every 100 milliseconds, instead of
+ * one system timer per deadline. Starting or restarting a
+ * WheelTimer just updates its deadline, so per-move timer churn is
+ * nearly free even with dozens of engines.
+ *
+ * The tick runs only while at least one WheelTimer is active.
+ *
+ * \sa WheelTimer
+ */
+class LIB_EXPORT TimerWheel : public QObject
+{
+	Q_OBJECT
+
+	public:
+		/*! The tick interval in milliseconds. */
+		static const int Granularity = 100;
+
+		/*! Returns the calling thread's timer wheel. */
+		static TimerWheel* instance();
+
+	protected:
+		// Inherited from QObject
+		virtual void timerEvent(QTimerEvent* event);
+
+	private:
+		friend class WheelTimer;
+
+		TimerWheel();
+
+		void add(WheelTimer* timer);
+		void remove(WheelTimer* timer);
+
+		QElapsedTimer m_clock;
+		QBasicTimer m_tick;
+		QList<WheelTimer*> m_timers;
+};
+
+/*!
+ * \brief A single-shot timer serviced by the thread's TimerWheel.
+ *
+ * WheelTimer mimics the single-shot part of the QTimer interface
+ * but doesn't own a system timer: all WheelTimer objects in a
+ * thread share the thread's TimerWheel. A timeout can therefore
+ * fire up to \a TimerWheel::Granularity milliseconds late, which
+ * makes WheelTimer suitable for coarse deadlines like ping and
+ * clock expiry checks, but not for short intervals.
+ *
+ * Like QTimer, a WheelTimer can only be used in the thread it
+ * lives in.
+ *
+ * \sa TimerWheel
+ */
+class LIB_EXPORT WheelTimer : public QObject
+{
+	Q_OBJECT
+
+	public:
+		/*! Creates a new inactive WheelTimer. */
+		explicit WheelTimer(QObject* parent = nullptr);
+		virtual ~WheelTimer();
+
+		/*! Sets the timeout interval to \a msec milliseconds. */
+		void setInterval(int msec);
+		/*! Returns the timeout interval in milliseconds. */
+		int interval() const;
+		/*! Returns true if the timer is running. */
+		bool isActive() const;
+
+	public slots:
+		/*!
+		 * Starts or restarts the timer with the timeout
+		 * interval set by setInterval().
+		 */
+		void start();
+		/*!
+		 * Starts or restarts the timer with a timeout
+		 * interval of \a msec milliseconds.
+		 */
+		void start(int msec);
+		/*! Stops the timer. */
+		void stop();
+
+	signals:
+		/*! This signal is emitted when the timer times out. */
+		void timeout();
+
+	private:
+		friend class TimerWheel;
+
+		int m_interval;
+		qint64 m_deadline;
+};
+
+#endif // TIMERWHEEL_H
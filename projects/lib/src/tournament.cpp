@@ -20,17 +20,24 @@
 #include <QFile>
 #include <QMultiMap>
 #include <QSet>
+#include <QThread>
 #include "gamemanager.h"
 #include "playerbuilder.h"
 #include "enginebuilder.h"
 #include "board/boardfactory.h"
 #include "chessplayer.h"
+#include "chessengine.h"
 #include "chessgame.h"
+#include "tracer.h"
+#include "eventstream.h"
 #include "pgnstream.h"
+#include "pgnwriter.h"
 #include "openingsuite.h"
 #include "openingbook.h"
+#include "pgnverifier.h"
 #include "sprt.h"
 #include "elo.h"
+#include "mersenne.h"
 #include <jsonserializer.h>
 #include <QFileInfo>
 #include <chessgame.h>
@@ -54,6 +61,7 @@ Tournament::Tournament(GameManager* gameManager, EngineManager* engineManager,
 	  m_seedCount(0),
 	  m_stopping(false),
 	  m_openingRepetitions(1),
+	  m_crashRetries(0),
 	  m_recover(false),
 	  m_pgnCleanup(true),
 	  m_pgnWriteUnfinishedGames(true),
@@ -61,17 +69,21 @@ Tournament::Tournament(GameManager* gameManager, EngineManager* engineManager,
 	  m_bookOwnership(false),
 	  m_openingSuite(nullptr),
 	  m_sprt(new Sprt),
-	  m_repetitionCounter(0),
 	  m_swapSides(true),
+	  m_pgnWriter(nullptr),
+	  m_pgnWriterThread(nullptr),
 	  m_pgnOutMode(PgnGame::Verbose),
 	  m_pair(nullptr),
 	  m_livePgnOutMode(PgnGame::Verbose),
 	  m_pgnFormat(true),
 	  m_jsonFormat(true),
+	  m_livePgnStream(false),
 	  m_resumeGameNumber(0),
 	  m_bergerSchedule(false),
 	  m_reloadEngines(false),
-	  m_strikes(0)
+	  m_strikes(0),
+	  m_eventStream(nullptr),
+	  m_pgnVerifier(nullptr)
 {
 	Q_ASSERT(gameManager != nullptr);
 	Q_ASSERT(engineManager != nullptr);
@@ -100,9 +112,9 @@ Tournament::~Tournament()
 
 	delete m_openingSuite;
 	delete m_sprt;
+	delete m_eventStream;
 
-	if (m_pgnFile.isOpen())
-		m_pgnFile.close();
+	closePgnOutput();
 
 	if (m_epdFile.isOpen())
 		m_epdFile.close();
@@ -188,6 +200,11 @@ Sprt* Tournament::sprt() const
 	return m_sprt;
 }
 
+const QMap<QString, Tournament::EngineStats>& Tournament::engineStats() const
+{
+	return m_engineStats;
+}
+
 bool Tournament::swapSides() const
 {
 	return m_swapSides;
@@ -269,6 +286,12 @@ void Tournament::setRecoveryMode(bool recover)
 	m_recover = recover;
 }
 
+void Tournament::setCrashRecovery(int retries)
+{
+	Q_ASSERT(retries >= 0);
+	m_crashRetries = retries;
+}
+
 void Tournament::setAdjudicator(const GameAdjudicator& adjudicator)
 {
 	m_adjudicator = adjudicator;
@@ -292,10 +315,10 @@ void Tournament::setSeedCount(int seedCount)
 
 void Tournament::setPgnOutput(const QString& fileName, PgnGame::PgnMode mode)
 {
-	if (fileName != m_pgnFile.fileName())
+	if (fileName != m_pgnFileName)
 	{
-		m_pgnFile.close();
-		m_pgnFile.setFileName(fileName);
+		closePgnOutput();
+		m_pgnFileName = fileName;
 	}
 	m_pgnOutMode = mode;
 }
@@ -319,6 +342,27 @@ void Tournament::setEpdOutput(const QString& fileName)
 	}
 }
 
+void Tournament::setPgnVerification(bool enabled)
+{
+	if (enabled && m_pgnVerifier == nullptr)
+	{
+		m_pgnVerifier = new PgnVerifier(this);
+		connect(m_pgnVerifier, SIGNAL(discrepancyFound(int, QString)),
+			this, SLOT(onDiscrepancyFound(int, QString)));
+	}
+	else if (!enabled)
+	{
+		delete m_pgnVerifier;
+		m_pgnVerifier = nullptr;
+	}
+}
+
+void Tournament::onDiscrepancyFound(int gameNumber, const QString& message)
+{
+	qWarning("Game %d failed verification: %s",
+		 gameNumber, qUtf8Printable(message));
+}
+
 void Tournament::setLivePgnOutput(const QString& fileName, PgnGame::PgnMode mode)
 {
 	m_livePgnOut = fileName;
@@ -331,6 +375,26 @@ void Tournament::setLivePgnFormats(bool pgnFormat, bool jsonFormat)
 	m_jsonFormat = jsonFormat;
 }
 
+void Tournament::setLivePgnStream(bool enabled)
+{
+	m_livePgnStream = enabled;
+}
+
+void Tournament::setEventStreamOutput(const QString& fileName)
+{
+	delete m_eventStream;
+	m_eventStream = new EventStream(fileName, this);
+}
+
+void Tournament::postEvent(const QString& type, QVariantMap event) const
+{
+	if (m_eventStream == nullptr)
+		return;
+
+	event.insert("type", type);
+	m_eventStream->post(event);
+}
+
 void Tournament::setStrikes(int strikes)
 {
 	m_strikes = strikes;
@@ -530,6 +594,11 @@ void Tournament::startGame(TournamentPair* pair)
 	game->setOpeningBook(white.book(), Chess::Side::White, white.bookDepth());
 	game->setOpeningBook(black.book(), Chess::Side::Black, black.bookDepth());
 
+	// Seed this game's random stream from the game index, so book
+	// picks and random-variant positions for game N come out the
+	// same no matter which games ran before it
+	Mersenne::initializeThread(quint64(m_nextGameNumber));
+
 	if (usesBerger)
 	{
 		QPair<QVector<Chess::Move>, QString>& cycleGame =
@@ -539,13 +608,17 @@ void Tournament::startGame(TournamentPair* pair)
 			game->setStartingFen(cycleGame.second);
 			game->setMoves(cycleGame.first);
 
-			game->generateOpening();
+			// The cycle opening is already resolved, so any
+			// remaining book walk can overlap the engines'
+			// initialization on the game thread
+			game->generateOpeningLater(quint64(m_nextGameNumber));
 		}
 		else
 		{
 			if (m_openingSuite != nullptr)
 			{
-				if (!game->setMoves(m_openingSuite->nextGame(m_openingDepth)))
+				if (!game->setMoves(m_openingSuite->nextGame(m_openingDepth),
+						    false))
 					qWarning("The opening suite is incompatible with the "
 					"current chess variant");
 			}
@@ -562,35 +635,48 @@ void Tournament::startGame(TournamentPair* pair)
 	}
 	else
 	{
-		if (!m_startFen.isEmpty() || !m_openingMoves.isEmpty())
+		int repetition = m_pair->openingRepetition();
+		if (repetition > 0)
 		{
-			game->setStartingFen(m_startFen);
-			game->setMoves(m_openingMoves);
-			m_startFen.clear();
-			m_openingMoves.clear();
-			m_repetitionCounter++;
+			// Repeat the opening resolved for the pair's
+			// previous game instead of parsing it again
+			game->setStartingFen(m_pair->openingFen());
+			game->setMoves(m_pair->openingMoves());
+			repetition++;
 		}
 		else
 		{
-			m_repetitionCounter = 1;
+			repetition = 1;
 			if (m_openingSuite != nullptr)
 			{
-				if (!game->setMoves(m_openingSuite->nextGame(m_openingDepth)))
+				if (!game->setMoves(m_openingSuite->nextGame(m_openingDepth),
+						    false))
 					qWarning("The opening suite is incompatible with the "
 					"current chess variant");
 			}
 		}
 
-		game->generateOpening();
-		if (m_repetitionCounter < m_openingRepetitions)
+		if (repetition < m_openingRepetitions)
 		{
-			m_startFen = game->startingFen();
-			if (m_startFen.isEmpty() && board->isRandomVariant())
+			// The resolved opening is reused by the pair's
+			// next game, so it has to be generated now
+			game->generateOpening();
+
+			QString fen = game->startingFen();
+			if (fen.isEmpty() && board->isRandomVariant())
 			{
-				m_startFen = board->defaultFenString();
-				game->setStartingFen(m_startFen);
+				fen = board->defaultFenString();
+				game->setStartingFen(fen);
 			}
-			m_openingMoves = game->moves();
+			m_pair->setOpening(game->moves(), fen, repetition);
+		}
+		else
+		{
+			// Nothing reads the resolved opening before the
+			// game starts, so the book walk can run on the
+			// game thread while the engines initialize
+			game->generateOpeningLater(quint64(m_nextGameNumber));
+			m_pair->clearOpening();
 		}
 	}
 
@@ -603,9 +689,11 @@ void Tournament::startGame(TournamentPair* pair)
 
 	game->setStartDelay(m_startDelay);
 	game->setAdjudicator(m_adjudicator);
+	game->setCrashRecovery(m_crashRetries);
 
 	GameData* data = new GameData;
 	data->number = ++m_nextGameNumber;
+	data->round = m_round;
 	data->whiteIndex = m_pair->firstPlayer();
 	data->blackIndex = m_pair->secondPlayer();
 	m_gameData[game] = data;
@@ -660,6 +748,10 @@ void Tournament::skipGame(TournamentPair* pair)
 	game->setOpeningBook(white.book(), Chess::Side::White, white.bookDepth());
 	game->setOpeningBook(black.book(), Chess::Side::Black, black.bookDepth());
 
+	// Use the same per-game seeding as startGame() so a skipped
+	// game consumes exactly the stream it would have when played
+	Mersenne::initializeThread(quint64(m_nextGameNumber));
+
 	if (usesBerger)
 	{
 		QPair<QVector<Chess::Move>, QString>& cycleGame =
@@ -675,7 +767,8 @@ void Tournament::skipGame(TournamentPair* pair)
 		{
 			if (m_openingSuite != nullptr)
 			{
-				if (!game->setMoves(m_openingSuite->nextGame(m_openingDepth)))
+				if (!game->setMoves(m_openingSuite->nextGame(m_openingDepth),
+						    false))
 					qWarning("The opening suite is incompatible with the "
 					"current chess variant");
 			}
@@ -692,41 +785,58 @@ void Tournament::skipGame(TournamentPair* pair)
 	}
 	else
 	{
-		if (!m_startFen.isEmpty() || !m_openingMoves.isEmpty())
+		int repetition = m_pair->openingRepetition();
+		if (repetition > 0)
 		{
-			game->setStartingFen(m_startFen);
-			game->setMoves(m_openingMoves);
-			m_startFen.clear();
-			m_openingMoves.clear();
-			m_repetitionCounter++;
+			// Repeat the opening resolved for the pair's
+			// previous game instead of parsing it again
+			game->setStartingFen(m_pair->openingFen());
+			game->setMoves(m_pair->openingMoves());
+			repetition++;
 		}
 		else
 		{
-			m_repetitionCounter = 1;
+			repetition = 1;
 			if (m_openingSuite != nullptr)
 			{
-				if (!game->setMoves(m_openingSuite->nextGame(m_openingDepth)))
+				if (!game->setMoves(m_openingSuite->nextGame(m_openingDepth),
+						    false))
 					qWarning("The opening suite is incompatible with the "
 					"current chess variant");
 			}
 		}
 
 		game->generateOpening();
-		if (m_repetitionCounter < m_openingRepetitions)
+		if (repetition < m_openingRepetitions)
 		{
-			m_startFen = game->startingFen();
-			if (m_startFen.isEmpty() && board->isRandomVariant())
+			QString fen = game->startingFen();
+			if (fen.isEmpty() && board->isRandomVariant())
 			{
-				m_startFen = board->defaultFenString();
-				game->setStartingFen(m_startFen);
+				fen = board->defaultFenString();
+				game->setStartingFen(fen);
 			}
-			m_openingMoves = game->moves();
+			m_pair->setOpening(game->moves(), fen, repetition);
 		}
+		else
+			m_pair->clearOpening();
 	}
 
 	++m_nextGameNumber;
 	++m_finishedGameCount;
-	++m_savedGameCount;
+
+	// Keep the in-order PGN writer's sequence intact. Advancing
+	// m_savedGameCount directly would jump past games that are
+	// still in flight, leaving them stuck in the reorder buffer
+	// forever; a null placeholder lets the writer pass over the
+	// skipped number when its turn comes.
+	if (m_pgnFileName.isEmpty())
+		++m_savedGameCount;
+	else if (m_nextGameNumber == m_savedGameCount + 1)
+		++m_savedGameCount;
+	else
+		m_pgnGames[m_nextGameNumber] = PgnGame();
+	// Queued entries imply an open output, so draining here is safe
+	flushQueuedPgnGames();
 
 	if (m_nextGameNumber > m_finalGameCount)
 		m_finalGameCount = m_nextGameNumber;
@@ -780,11 +890,9 @@ void Tournament::startNextGame()
 
 		needtoResetBook = resetBook(pair);
 		qWarning () << "CAlling resetBook ,needtoResetBook:" << needtoResetBook;
-		if (needtoResetBook || ((!pair->hasSamePlayers(m_pair) && m_players.size() > 2)))
-		{
-			m_startFen.clear();
-			m_openingMoves.clear();
-		}
+		// A reloaded book invalidates the pair's cached opening
+		if (needtoResetBook)
+			pair->clearOpening();
 
 		if (m_strikes == 0)
 		{
@@ -817,51 +925,85 @@ inline bool faulty(const Chess::Result::Type& type)
 	    || type == Chess::Result::StalledConnection;
 }
 
+void Tournament::closePgnOutput()
+{
+	if (m_pgnWriterThread == nullptr)
+		return;
+
+	// close() runs on the writer's thread after every queued
+	// game, so when it returns all of them are on disk
+	QMetaObject::invokeMethod(m_pgnWriter, "close",
+				  Qt::BlockingQueuedConnection);
+	m_pgnWriterThread->quit();
+	m_pgnWriterThread->wait();
+	delete m_pgnWriter;
+	delete m_pgnWriterThread;
+	m_pgnWriter = nullptr;
+	m_pgnWriterThread = nullptr;
+}
+
 bool Tournament::writePgn(PgnGame* pgn, int gameNumber)
 {
 	Q_ASSERT(pgn != nullptr);
 	Q_ASSERT(gameNumber > 0);
 
-	if (m_pgnFile.fileName().isEmpty())
+	if (m_pgnFileName.isEmpty())
 		return true;
 
-	bool isOpen = m_pgnFile.isOpen();
-	if (!isOpen || !m_pgnFile.exists())
+	if (m_pgnWriter == nullptr)
 	{
-		if (isOpen)
-		{
-			qWarning("PGN file %s does not exist. Reopening...",
-				 qUtf8Printable(m_pgnFile.fileName()));
-			m_pgnFile.close();
-		}
+		// The writer owns the output file and appends the games
+		// on its own thread, so finishing a game never blocks
+		// on PGN serialization or file I/O
+		m_pgnWriter = new PgnWriter(m_pgnFileName, m_pgnOutMode);
+		m_pgnWriterThread = new QThread(this);
+		m_pgnWriter->moveToThread(m_pgnWriterThread);
+		m_pgnWriterThread->start();
+	}
 
-		if (!m_pgnFile.open(QIODevice::WriteOnly | QIODevice::Append))
-		{
-			qWarning("Could not open PGN file %s",
-				 qUtf8Printable(m_pgnFile.fileName()));
-			return false;
-		}
-		m_pgnOut.setDevice(&m_pgnFile);
+	bool ok = true;
+	if (gameNumber == m_savedGameCount + 1)
+	{
+		// The common in-order case: write the game directly
+		// instead of copying it through the reorder buffer
+		m_savedGameCount++;
+		ok = writeFinishedPgn(*pgn);
 	}
+	else
+		m_pgnGames[gameNumber] = *pgn;
 
+	return flushQueuedPgnGames() && ok;
+}
+
+bool Tournament::writeFinishedPgn(const PgnGame& pgn)
+{
+	Chess::Result::Type type = pgn.result().type();
+	if (!m_pgnWriteUnfinishedGames
+	&&  (pgn.result().isNone() || (m_stopping && faulty(type))))
+	{
+		qWarning("Omitted incomplete game %d", m_savedGameCount);
+		return true;
+	}
+	// The game is copied to the writer's thread; queued calls
+	// keep their order, so the file stays in game order
+	QMetaObject::invokeMethod(m_pgnWriter, "writeGame",
+				  Qt::QueuedConnection,
+				  Q_ARG(PgnGame, pgn),
+				  Q_ARG(int, m_savedGameCount));
+	return true;
+}
+
+bool Tournament::flushQueuedPgnGames()
+{
 	bool ok = true;
-	m_pgnGames[gameNumber] = *pgn;
 	while (m_pgnGames.contains(m_savedGameCount + 1))
 	{
 		PgnGame tmp = m_pgnGames.take(++m_savedGameCount);
-		Chess::Result::Type type = tmp.result().type();
-		if (!m_pgnWriteUnfinishedGames
-		&&  (tmp.result().isNone() || (m_stopping && faulty(type))))
-		{
-			qWarning("Omitted incomplete game %d", m_savedGameCount);
+		// Null games are placeholders for skipped game numbers
+		if (tmp.isNull())
 			continue;
-		}
-		if (!tmp.write(m_pgnOut, m_pgnOutMode)
-		||  m_pgnFile.error() != QFile::NoError)
-		{
+		if (!writeFinishedPgn(tmp))
 			ok = false;
-			qWarning("Could not write PGN game %d", m_savedGameCount);
-		}
 	}
 
 	return ok;
@@ -924,12 +1066,130 @@ void Tournament::onGameStarted(ChessGame* game)
 
 	emit gameStarted(game, data->number, iWhite, iBlack);
 
+	if (m_eventStream != nullptr)
+	{
+		QVariantMap event;
+		event.insert("game", data->number);
+		event.insert("round", data->round);
+		event.insert("variant", game->board()->variant());
+		event.insert("white", m_players[iWhite].name());
+		event.insert("black", m_players[iBlack].name());
+		event.insert("fen", game->startingFen());
+		postEvent("gameStarted", event);
+	}
+
 	onPgnMove();
 }
 
+void Tournament::streamLivePgn(ChessGame* game, GameData* data)
+{
+	PgnGame* pgn(game->pgn());
+	Q_ASSERT(pgn != 0);
+
+	if (data->liveStream == nullptr)
+	{
+		const QString fileName(m_livePgnOut
+				       + QString("_%1.pgns").arg(data->number));
+		data->liveStream = new QFile(fileName);
+		if (!data->liveStream->open(QIODevice::WriteOnly
+					    | QIODevice::Truncate
+					    | QIODevice::Unbuffered))
+		{
+			qWarning("cannot open live PGN stream file: %s",
+				 qUtf8Printable(fileName));
+			delete data->liveStream;
+			data->liveStream = nullptr;
+			return;
+		}
+
+		QString header;
+		const QList< QPair<QString, QString> >& tags = pgn->tags();
+		for (const QPair<QString, QString>& tag : tags)
+		{
+			if (!tag.second.isEmpty())
+				header += QString("[%1 \"%2\"]\n")
+					  .arg(tag.first, tag.second);
+		}
+		header += "\n";
+		data->liveStream->write(header.toUtf8());
+	}
+
+	const QVector<PgnGame::MoveData>& moves(pgn->moves());
+	if (data->liveStreamPlies >= moves.size())
+		return;
+
+	const bool blackStart = pgn->startingSide() == Chess::Side::Black;
+	QString text;
+	for (int i = data->liveStreamPlies; i < moves.size(); i++)
+	{
+		const PgnGame::MoveData& md(moves.at(i));
+		const int offset = blackStart ? i + 1 : i;
+
+		QString str;
+		if (i == 0 && blackStart)
+			str = "1... ";
+		else if (offset % 2 == 0)
+			str = QString::number(offset / 2 + 1) + ". ";
+
+		str += QString::fromUtf8(md.moveString);
+		if (m_livePgnOutMode == PgnGame::Verbose && !md.comment.isEmpty())
+			str += QString(" {%1}").arg(QString::fromUtf8(md.comment));
+		text += str + "\n";
+	}
+	data->liveStreamPlies = moves.size();
+
+	// Emit the new plies with a single write so a reader tailing
+	// the file never sees a torn move.
+	data->liveStream->write(text.toUtf8());
+}
+
+void Tournament::postMoveEvents(ChessGame* game, GameData* data)
+{
+	PgnGame* pgn(game->pgn());
+	Q_ASSERT(pgn != 0);
+
+	const QVector<PgnGame::MoveData>& moves(pgn->moves());
+	const bool blackStart = pgn->startingSide() == Chess::Side::Black;
+
+	for (int i = data->eventStreamPlies; i < moves.size(); i++)
+	{
+		const PgnGame::MoveData& md(moves.at(i));
+		const int offset = blackStart ? i + 1 : i;
+		const Chess::Side side = (offset % 2 == 0) ? Chess::Side::White
+							   : Chess::Side::Black;
+
+		QVariantMap event;
+		event.insert("game", data->number);
+		event.insert("ply", i + 1);
+		event.insert("side", side == Chess::Side::White ? "white"
+								: "black");
+		event.insert("san", QString::fromUtf8(md.moveString));
+
+		// The mover's evaluation and clock are only current for
+		// the latest ply; earlier plies (eg. forced book moves)
+		// carry just the move itself.
+		const ChessPlayer* player = game->player(side);
+		if (i == moves.size() - 1 && player != nullptr)
+		{
+			const MoveEvaluation& eval = player->evaluation();
+			if (!eval.isEmpty() && !eval.isBookEval())
+			{
+				event.insert("score", eval.score());
+				event.insert("depth", eval.depth());
+				event.insert("time", eval.time());
+			}
+			event.insert("clock", player->timeControl()->timeLeft());
+		}
+
+		postEvent("move", event);
+	}
+	data->eventStreamPlies = moves.size();
+}
+
 void Tournament::onPgnMove()
 {
-	if (m_livePgnOut.isEmpty()) return;
+	if (m_livePgnOut.isEmpty() && m_eventStream == nullptr)
+		return;
 
 	ChessGame* sender = qobject_cast<ChessGame*>(QObject::sender());
 	Q_ASSERT(sender != 0);
@@ -937,6 +1197,15 @@ void Tournament::onPgnMove()
 	PgnGame* pgn(sender->pgn());
 	Q_ASSERT(pgn != 0);
 
+	if (m_eventStream != nullptr && m_gameData.contains(sender))
+		postMoveEvents(sender, m_gameData[sender]);
+
+	if (m_livePgnOut.isEmpty())
+		return;
+
+	if (m_livePgnStream && m_gameData.contains(sender))
+		streamLivePgn(sender, m_gameData[sender]);
+
 	if (m_pgnFormat)
 	{
 		const QString fileName(m_livePgnOut + ".pgn");
@@ -946,10 +1215,12 @@ void Tournament::onPgnMove()
 
 	if (m_jsonFormat)
 	{
-		Chess::Board* board(sender->board());
-		Q_ASSERT(board != 0);
-		board = board->copy();
-		board->setFenString(board->startingFenString());
+		Chess::Board* gameBoard(sender->board());
+		Q_ASSERT(gameBoard != 0);
+		// Replay on a pooled board instead of cloning the game's
+		// board on every move.
+		Chess::Board* board = m_boardPool.acquire(gameBoard->variant());
+		board->setFenString(gameBoard->startingFenString());
 
 		QVariantMap pMap;
 
@@ -995,7 +1266,7 @@ void Tournament::onPgnMove()
 			QVariantMap mMap;
 			QVariantMap aMap;
 
-			mMap["m"] = move.moveString;
+			mMap["m"] = QString::fromUtf8(move.moveString);
 
 			QString sq(static_cast<char>(move.move.sourceSquare().file() + 'a'));
 			sq += static_cast<char>(move.move.sourceSquare().rank() + '1');
@@ -1007,7 +1278,8 @@ void Tournament::onPgnMove()
 
 			mMap["book"] = false;
 
-			QStringList stats = move.comment.split(',', QString::SkipEmptyParts);
+			QStringList stats = QString::fromUtf8(move.comment)
+				.split(',', QString::SkipEmptyParts);
 			for(QString& stat : stats)
 			{
 				stat = stat.trimmed();
@@ -1094,7 +1366,7 @@ void Tournament::onPgnMove()
 		}
 		pMap["Moves"] = mList;
 
-		delete board;
+		m_boardPool.release(board);
 
 		const QString tempName(m_livePgnOut + "_temp.json");
 		const QString finalName(m_livePgnOut + ".json");
@@ -1133,6 +1405,22 @@ void Tournament::onEngineUpdated(int engineIndex)
 void Tournament::onGameFinished(ChessGame* game)
 {
 	Q_ASSERT(game != nullptr);
+	TraceSpan span("tournament.gameFinished", game);
+
+	for (int i = 0; i < 2; i++)
+	{
+		Chess::Side side = Chess::Side::Type(i);
+		ChessPlayer* player = game->player(side);
+		if (player == nullptr)
+			continue;
+
+		EngineStats& stats = m_engineStats[player->name()];
+		stats.moveTime.merge(game->moveTimeStats(side));
+		stats.timeUsage.merge(game->timeUsageStats(side));
+		if (game->infoLineRate(side) > 0)
+			stats.infoLineRate.add(game->infoLineRate(side));
+		stats.timeNearMisses += game->timeNearMisses(side);
+	}
 
 	PgnGame* pgn(game->pgn());
 	Chess::Result result(game->result());
@@ -1141,6 +1429,13 @@ void Tournament::onGameFinished(ChessGame* game)
 
 	Q_ASSERT(m_gameData.contains(game));
 	GameData* data = m_gameData.take(game);
+	if (data->liveStream != nullptr)
+	{
+		// Flush any trailing plies and terminate the movetext
+		streamLivePgn(game, data);
+		data->liveStream->write(result.toShortString().toUtf8() + "\n");
+		data->liveStream->close();
+	}
 	int gameNumber = data->number;
 	Sprt::GameResult sprtResult = Sprt::NoResult;
 
@@ -1195,6 +1490,8 @@ void Tournament::onGameFinished(ChessGame* game)
 
 	writeEpd(game);
 	writePgn(pgn, gameNumber);
+	if (m_pgnVerifier != nullptr)
+		m_pgnVerifier->verify(*pgn, gameNumber);
 
 	Chess::Result::Type resultType(result.type());
 	bool crashed = (resultType == Chess::Result::Disconnection ||
@@ -1204,11 +1501,54 @@ void Tournament::onGameFinished(ChessGame* game)
 
 	if (!m_sprt->isNull() && sprtResult != Sprt::NoResult)
 	{
-		m_sprt->addGameResult(sprtResult);
+		// With two games per encounter the games are paired by
+		// opening, so feed the test complete pair outcomes; the
+		// pentanomial bookkeeping models the pair correlation
+		// and stops the test in fewer games.
+		if (gamesPerEncounter() == 2)
+		{
+			const int encounter = (gameNumber - 1) / 2;
+			if (m_pendingSprtResults.contains(encounter))
+				m_sprt->addPairResult(
+					m_pendingSprtResults.take(encounter),
+					sprtResult);
+			else
+				m_pendingSprtResults[encounter] = sprtResult;
+		}
+		else
+			m_sprt->addGameResult(sprtResult);
+
 		if (m_sprt->status().result != Sprt::Continue)
 			QMetaObject::invokeMethod(this, "stop", Qt::QueuedConnection);
 	}
 
+	if (m_eventStream != nullptr)
+	{
+		// Flush plies that arrived after the last pgnMove signal
+		postMoveEvents(game, data);
+
+		QVariantMap event;
+		event.insert("game", gameNumber);
+		event.insert("white", m_players[iWhite].name());
+		event.insert("black", m_players[iBlack].name());
+		event.insert("result", result.toShortString());
+		event.insert("reason", result.description());
+		postEvent("result", event);
+
+		// Standings delta for the two players involved
+		for (int i : { iWhite, iBlack })
+		{
+			const TournamentPlayer& tp = m_players.at(i);
+			QVariantMap standing;
+			standing.insert("player", tp.name());
+			standing.insert("wins", tp.wins());
+			standing.insert("draws", tp.draws());
+			standing.insert("losses", tp.losses());
+			standing.insert("score", tp.score());
+			postEvent("standings", standing);
+		}
+	}
+
 	emit gameFinished(game, gameNumber, iWhite, iBlack);
 
 	if (m_pgnCleanup)
@@ -1250,6 +1590,13 @@ void Tournament::onFinished()
 {
 	m_gameManager->cleanupIdleThreads();
 	m_finished = true;
+
+	QVariantMap event;
+	event.insert("games", m_finishedGameCount);
+	postEvent("tournamentFinished", event);
+	if (m_eventStream != nullptr)
+		m_eventStream->stop();
+
 	emit finished();
 }
 
@@ -1266,8 +1613,7 @@ void Tournament::start()
 
 	m_gameData.clear();
 	m_pgnGames.clear();
-	m_startFen.clear();
-	m_openingMoves.clear();
+	m_pendingSprtResults.clear();
 	const bool usesBerger = usesBergerSchedule();
 	if (usesBerger)
 		m_cycleOpenings.resize(gamesPerCycle());
@@ -1291,11 +1637,6 @@ void Tournament::start()
 				break;
 			}
 
-			if (!pair->hasSamePlayers(m_pair) && m_players.size() > 2)
-			{
-				m_startFen.clear();
-				m_openingMoves.clear();
-			}
 			skipGame(pair);
 		}
 	}
@@ -1324,6 +1665,34 @@ void Tournament::stop()
 		QMetaObject::invokeMethod(game, "stop", Qt::QueuedConnection);
 }
 
+void Tournament::abort()
+{
+	// Engines that ignore the quit command during the teardown
+	// below get one second before they're terminated
+	ChessEngine::setQuitTimeout(1000);
+
+	if (!m_stopping)
+	{
+		disconnect(m_gameManager, SIGNAL(ready()),
+			   this, SLOT(startNextGame()));
+
+		if (m_gameData.isEmpty())
+		{
+			onFinished();
+			return;
+		}
+		m_stopping = true;
+	}
+
+	// Kill the players of every active game instead of waiting
+	// for the games to end on their own. The games still finish
+	// normally with an unterminated result, so the results that
+	// are already in get saved.
+	const auto games = m_gameData.keys();
+	for (ChessGame* game : games)
+		QMetaObject::invokeMethod(game, "kill", Qt::QueuedConnection);
+}
+
 QString Tournament::results() const
 {
 	QMultiMap<qreal, RankingData> ranking;
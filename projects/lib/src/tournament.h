@@ -25,19 +25,26 @@
 #include <QMap>
 #include <QFile>
 #include <QTextStream>
+#include <QVariantMap>
 #include "board/move.h"
+#include "board/boardpool.h"
 #include "timecontrol.h"
 #include "pgngame.h"
 #include "gameadjudicator.h"
 #include "tournamentplayer.h"
 #include "tournamentpair.h"
 #include "enginemanager.h"
+#include "histogram.h"
+#include "sprt.h"
+class QThread;
+class EventStream;
 class GameManager;
 class PlayerBuilder;
 class ChessGame;
 class OpeningBook;
 class OpeningSuite;
-class Sprt;
+class PgnVerifier;
+class PgnWriter;
 
 /*!
  * \brief Base class for chess tournaments
@@ -125,6 +132,23 @@ class LIB_EXPORT Tournament : public QObject
 		 * stopping criterion.
 		 */
 		Sprt* sprt() const;
+		/*!
+		 * \brief Latency statistics of one engine, accumulated
+		 * over all of its finished games.
+		 */
+		struct EngineStats
+		{
+			/*! Move times in milliseconds. */
+			Histogram moveTime;
+			/*! Share of the available time used per move. */
+			Histogram timeUsage;
+			/*! Output lines per second, one sample per game. */
+			Histogram infoLineRate;
+			/*! Moves that nearly forfeited on time. */
+			qint64 timeNearMisses = 0;
+		};
+		/*! Returns per-engine latency statistics by player name. */
+		const QMap<QString, EngineStats>& engineStats() const;
 		/*! Returns true if the players swap sides in an encounter. */
 		bool swapSides() const;
 		/*! Returns true if the tournament wants Berger/Schurig scheduling. */
@@ -178,6 +202,16 @@ class LIB_EXPORT Tournament : public QObject
 		 * whole tournament stops when a player crashes.
 		 */
 		void setRecoveryMode(bool recover);
+		/*!
+		 * Allows up to \a retries mid-game engine restarts per
+		 * game after a crash.
+		 *
+		 * A crashed engine is relaunched from its builder, the
+		 * game's move history is replayed to it, its clock is
+		 * restored and the game continues. With the default of
+		 * zero retries a crashed engine forfeits the game.
+		 */
+		void setCrashRecovery(int retries);
 		/*!
 		 * Sets the game adjudicator to \a adjudicator.
 		 *
@@ -230,6 +264,17 @@ class LIB_EXPORT Tournament : public QObject
 		 */
 		void setEpdOutput(const QString& fileName);
 
+		/*!
+		 * Sets background game verification to \a enabled.
+		 *
+		 * If \a enabled is true then every finished game is queued
+		 * to a low-priority worker that replays it on a fresh
+		 * board and reports discrepancies, so the output doesn't
+		 * have to be re-parsed externally before publishing.
+		 * Verification is disabled by default.
+		 */
+		void setPgnVerification(bool enabled);
+
  		/*!
  		 * Sets the live PGN output file for the games to \a fileName.
  		 *
@@ -244,6 +289,29 @@ class LIB_EXPORT Tournament : public QObject
  		 */
 		void setLivePgnFormats(bool pgnFormat, bool jsonFormat);
 
+		/*!
+		 * Enables or disables the append-only live PGN stream.
+		 *
+		 * When enabled, each game appends its moves (with the
+		 * clock and eval comments) to a per-game stream file as
+		 * they are played, without ever rewriting previously
+		 * emitted bytes. A broadcast layer can then tail the file
+		 * instead of re-reading the whole live PGN on every move.
+		 */
+		void setLivePgnStream(bool enabled);
+
+		/*!
+		 * Sets the NDJSON event stream output file to
+		 * \a fileName.
+		 *
+		 * When set, the tournament appends one JSON object per
+		 * line for each game start, move (with eval and clock),
+		 * game result and standings update, written from a
+		 * dedicated thread. Consumers tail the file; no line is
+		 * ever rewritten.
+		 */
+		void setEventStreamOutput(const QString& fileName);
+
  		/*! Sets the number of \a strikes at which a player is disqualified.
  		 */
 		void setStrikes(int strikes);
@@ -321,6 +389,19 @@ class LIB_EXPORT Tournament : public QObject
 		 * is fully stopped.
 		 */
 		void stop();
+		/*!
+		 * Stops the tournament without waiting for ongoing
+		 * games to finish.
+		 *
+		 * The engines of every active game are terminated right
+		 * away, and idle engines only get a short deadline to
+		 * obey the quit command before their processes are
+		 * terminated too. The interrupted games get an
+		 * unterminated result like in stop(), and the finished()
+		 * signal is emitted when the tournament is fully
+		 * stopped.
+		 */
+		void abort();
 
 	signals:
 		/*!
@@ -482,7 +563,16 @@ class LIB_EXPORT Tournament : public QObject
 
 	private slots:
 		void startNextGame();
+		// Posts an event of \a type to the event stream, if set
+		void postEvent(const QString& type, QVariantMap event) const;
 		bool writePgn(PgnGame* pgn, int gameNumber);
+		// Writes one finished game to the PGN output, or omits
+		// it if it shouldn't be saved
+		bool writeFinishedPgn(const PgnGame& pgn);
+		// Drains games that became writable from the reorder
+		// buffer, releasing their memory
+		bool flushQueuedPgnGames();
+		void closePgnOutput();
 		bool writeEpd(ChessGame* game);
 		void onGameStarted(ChessGame* game);
 		void onGameFinished(ChessGame* game);
@@ -490,13 +580,20 @@ class LIB_EXPORT Tournament : public QObject
 		void onGameStartFailed(ChessGame* game);
 		void onPgnMove();
 		void onEngineUpdated(int engineIndex);
+		void onDiscrepancyFound(int gameNumber, const QString& message);
 
 	private:
 		struct GameData
 		{
 			int number;
+			int round;
 			int whiteIndex;
 			int blackIndex;
+			QFile* liveStream = nullptr;
+			int liveStreamPlies = 0;
+			int eventStreamPlies = 0;
+
+			~GameData() { delete liveStream; }
 		};
 		struct RankingData
 		{
@@ -508,6 +605,10 @@ class LIB_EXPORT Tournament : public QObject
 			qreal eloDiff;
 		};
 
+		void streamLivePgn(ChessGame* game, GameData* data);
+		// Posts any plies not yet published to the event stream
+		void postMoveEvents(ChessGame* game, GameData* data);
+
 		GameManager* m_gameManager;
 		EngineManager* m_engineManager;
 		ChessGame* m_lastGame;
@@ -527,6 +628,7 @@ class LIB_EXPORT Tournament : public QObject
 		int m_seedCount;
 		bool m_stopping;
 		int m_openingRepetitions;
+		int m_crashRetries;
 		bool m_recover;
 		bool m_pgnCleanup;
 		bool m_pgnWriteUnfinishedGames;
@@ -535,12 +637,15 @@ class LIB_EXPORT Tournament : public QObject
 		GameAdjudicator m_adjudicator;
 		OpeningSuite* m_openingSuite;
 		Sprt* m_sprt;
-		QFile m_pgnFile;
-		QTextStream m_pgnOut;
+		// First-game results of encounters whose second game
+		// hasn't finished yet, keyed by encounter index
+		QMap<int, Sprt::GameResult> m_pendingSprtResults;
+		QString m_pgnFileName;
+		// Background PGN output; see writePgn()
+		PgnWriter* m_pgnWriter;
+		QThread* m_pgnWriterThread;
 		QFile m_epdFile;
 		QTextStream m_epdOut;
-		QString m_startFen;
-		int m_repetitionCounter;
 		int m_swapSides;
 		PgnGame::PgnMode m_pgnOutMode;
 		TournamentPair* m_pair;
@@ -548,11 +653,12 @@ class LIB_EXPORT Tournament : public QObject
 		QList<TournamentPlayer> m_players;
 		QMap<int, PgnGame> m_pgnGames;
 		QMap<ChessGame*, GameData*> m_gameData;
-		QVector<Chess::Move> m_openingMoves;
 		QString m_livePgnOut;
 		PgnGame::PgnMode m_livePgnOutMode;
+		Chess::BoardPool m_boardPool;
 		bool m_pgnFormat;
 		bool m_jsonFormat;
+		bool m_livePgnStream;
 		QString m_eventDate;
 		int m_resumeGameNumber;
 		bool m_bergerSchedule;
@@ -562,6 +668,9 @@ class LIB_EXPORT Tournament : public QObject
 		double m_eng1Score;
 		double m_eng2Score;
 		bool m_should_we_stop;
+		QMap<QString, EngineStats> m_engineStats;
+		EventStream* m_eventStream;
+		PgnVerifier* m_pgnVerifier;
 };
 
 #endif // TOURNAMENT_H
@@ -23,7 +23,8 @@
 TournamentPair::TournamentPair(int firstPlayer,
 			       int secondPlayer)
 	: m_gamesStarted(0),
-	  m_hasOriginalOrder(true)
+	  m_hasOriginalOrder(true),
+	  m_openingRepetition(0)
 {
 	m_first.index = firstPlayer;
 	m_first.score = 0;
@@ -134,3 +135,34 @@ void TournamentPair::swapPlayers()
 	std::swap(m_first, m_second);
 	m_hasOriginalOrder = !m_hasOriginalOrder;
 }
+
+int TournamentPair::openingRepetition() const
+{
+	return m_openingRepetition;
+}
+
+const QVector<Chess::Move>& TournamentPair::openingMoves() const
+{
+	return m_openingMoves;
+}
+
+const QString& TournamentPair::openingFen() const
+{
+	return m_openingFen;
+}
+
+void TournamentPair::setOpening(const QVector<Chess::Move>& moves,
+				const QString& fen,
+				int repetition)
+{
+	m_openingMoves = moves;
+	m_openingFen = fen;
+	m_openingRepetition = repetition;
+}
+
+void TournamentPair::clearOpening()
+{
+	m_openingMoves.clear();
+	m_openingFen.clear();
+	m_openingRepetition = 0;
+}
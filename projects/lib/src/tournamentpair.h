@@ -19,6 +19,10 @@
 #ifndef TOURNAMENTPAIR_H
 #define TOURNAMENTPAIR_H
 
+#include <QVector>
+#include <QString>
+#include "board/move.h"
+
 /*!
  * \brief A single encounter in a tournament
  *
@@ -111,6 +115,29 @@ class LIB_EXPORT TournamentPair
 		 * second player and vice versa.
 		 */
 		void swapPlayers();
+		/*!
+		 * Returns which repetition of the pair's current opening
+		 * the cached opening is for.
+		 * Returns 0 if no opening is cached.
+		 */
+		int openingRepetition() const;
+		/*! Returns the cached opening moves. */
+		const QVector<Chess::Move>& openingMoves() const;
+		/*! Returns the cached opening's starting FEN string. */
+		const QString& openingFen() const;
+		/*!
+		 * Caches the pair's resolved opening so that the next
+		 * game between the pair can repeat it without parsing
+		 * the opening again.
+		 *
+		 * \a repetition is the number of games played with the
+		 * opening so far.
+		 */
+		void setOpening(const QVector<Chess::Move>& moves,
+				const QString& fen,
+				int repetition);
+		/*! Clears the cached opening. */
+		void clearOpening();
 
 	private:
 		struct Player
@@ -123,6 +150,9 @@ class LIB_EXPORT TournamentPair
 		Player m_second;
 		int m_gamesStarted;
 		bool m_hasOriginalOrder;
+		int m_openingRepetition;
+		QVector<Chess::Move> m_openingMoves;
+		QString m_openingFen;
 };
 
 #endif // TOURNAMENTPAIR_H
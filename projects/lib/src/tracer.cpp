@@ -0,0 +1,149 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "tracer.h"
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QVector>
+
+namespace {
+
+struct TraceEvent
+{
+	const char* name;	// string literal, not owned
+	char phase;		// 'B' or 'E'
+	qint64 timestamp;	// microseconds since Tracer::start()
+	quintptr threadId;
+	quintptr id;		// optional span tag, 0 if unset
+};
+
+QMutex s_mutex;
+QElapsedTimer s_timer;
+QString s_fileName;
+QVector<TraceEvent> s_events;
+
+void mergeEvents(QVector<TraceEvent>& events)
+{
+	if (events.isEmpty())
+		return;
+
+	QMutexLocker locker(&s_mutex);
+	s_events += events;
+	locker.unlock();
+
+	events.clear();
+}
+
+// Thread-local event buffer. The destructor merges any leftover
+// events into the global log when the thread exits, which on a
+// normal shutdown happens before Tracer::finish() runs.
+struct TraceBuffer
+{
+	QVector<TraceEvent> events;
+
+	~TraceBuffer()
+	{
+		mergeEvents(events);
+	}
+};
+
+thread_local TraceBuffer t_buffer;
+
+// Merging in batches of this size keeps lock traffic negligible
+// while bounding the events a crashing thread could lose
+const int s_mergeThreshold = 256;
+
+} // anonymous namespace
+
+QAtomicInt Tracer::s_enabled;
+
+void Tracer::start(const QString& fileName)
+{
+	Q_ASSERT(!fileName.isEmpty());
+
+	QMutexLocker locker(&s_mutex);
+	s_fileName = fileName;
+	s_events.clear();
+	s_timer.start();
+	locker.unlock();
+
+	s_enabled.storeRelease(1);
+}
+
+void Tracer::finish()
+{
+	if (!isEnabled())
+		return;
+	s_enabled.storeRelease(0);
+
+	mergeEvents(t_buffer.events);
+
+	QMutexLocker locker(&s_mutex);
+
+	QFile file(s_fileName);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+	{
+		qWarning("Cannot open trace file %s",
+			 qUtf8Printable(s_fileName));
+		s_events.clear();
+		return;
+	}
+
+	file.write("{\"traceEvents\":[\n");
+	for (int i = 0; i < s_events.size(); i++)
+	{
+		const TraceEvent& ev = s_events.at(i);
+
+		QByteArray line = "{\"name\":\"";
+		line += ev.name;
+		line += "\",\"ph\":\"";
+		line += ev.phase;
+		line += "\",\"ts\":";
+		line += QByteArray::number(ev.timestamp);
+		line += ",\"pid\":0,\"tid\":";
+		line += QByteArray::number(quint64(ev.threadId));
+		if (ev.id != 0)
+		{
+			line += ",\"args\":{\"id\":\"0x";
+			line += QByteArray::number(quint64(ev.id), 16);
+			line += "\"}";
+		}
+		line += (i + 1 < s_events.size()) ? "},\n" : "}\n";
+
+		file.write(line);
+	}
+	file.write("]}\n");
+
+	s_events.clear();
+}
+
+void Tracer::record(const char* name, char phase, const void* id)
+{
+	TraceEvent ev = { name,
+			  phase,
+			  s_timer.nsecsElapsed() / 1000,
+			  quintptr(QThread::currentThreadId()),
+			  quintptr(id) };
+	t_buffer.events.append(ev);
+
+	if (t_buffer.events.size() >= s_mergeThreshold)
+		mergeEvents(t_buffer.events);
+}
@@ -0,0 +1,125 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <QString>
+#include <QAtomicInt>
+
+/*!
+ * \brief Opt-in trace instrumentation for the game lifecycle.
+ *
+ * The tracer records named begin/end spans with microsecond
+ * timestamps and writes them out in the Chrome trace-event JSON
+ * format, so a tournament run can be inspected in a trace viewer
+ * (chrome://tracing, Perfetto) to see where the time between games
+ * actually goes: engine startup, book probing, thinking, move relay
+ * or scheduling gaps.
+ *
+ * Tracing is off by default and the begin()/end() calls reduce to a
+ * single atomic flag test. When enabled, events are buffered in
+ * thread-local storage and merged into the global log in batches, so
+ * tracing doesn't serialize the game threads.
+ *
+ * \sa TraceSpan
+ */
+class LIB_EXPORT Tracer
+{
+	public:
+		/*!
+		 * Enables tracing and sets the output file to \a fileName.
+		 *
+		 * Must be called before any threads emit events.
+		 */
+		static void start(const QString& fileName);
+		/*!
+		 * Disables tracing and writes the collected events to
+		 * the output file.
+		 *
+		 * Events still buffered by threads that are alive when
+		 * this function is called are discarded.
+		 */
+		static void finish();
+		/*! Returns true if tracing is enabled. */
+		static bool isEnabled();
+
+		/*!
+		 * Records the beginning of span \a name, optionally
+		 * tagged with \a id (eg. the game object).
+		 *
+		 * \note \a name must be a string literal; only the
+		 * pointer is stored.
+		 */
+		static void begin(const char* name, const void* id = nullptr);
+		/*! Records the end of span \a name. */
+		static void end(const char* name, const void* id = nullptr);
+
+	private:
+		static void record(const char* name, char phase, const void* id);
+
+		static QAtomicInt s_enabled;
+};
+
+inline bool Tracer::isEnabled()
+{
+	return s_enabled.loadAcquire() != 0;
+}
+
+inline void Tracer::begin(const char* name, const void* id)
+{
+	if (isEnabled())
+		record(name, 'B', id);
+}
+
+inline void Tracer::end(const char* name, const void* id)
+{
+	if (isEnabled())
+		record(name, 'E', id);
+}
+
+/*!
+ * \brief A scoped Tracer span.
+ *
+ * Emits a begin event on construction and the matching end event on
+ * destruction, for phases that coincide with a C++ scope.
+ */
+class LIB_EXPORT TraceSpan
+{
+	public:
+		/*! Begins span \a name tagged with \a id. */
+		TraceSpan(const char* name, const void* id = nullptr)
+			: m_name(name),
+			  m_id(id)
+		{
+			Tracer::begin(name, id);
+		}
+		/*! Ends the span. */
+		~TraceSpan()
+		{
+			Tracer::end(m_name, m_id);
+		}
+
+	private:
+		Q_DISABLE_COPY(TraceSpan)
+
+		const char* m_name;
+		const void* m_id;
+};
+
+#endif // TRACER_H
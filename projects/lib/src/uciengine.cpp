@@ -29,6 +29,8 @@
 #include "enginecombooption.h"
 #include "enginespinoption.h"
 #include "enginetextoption.h"
+#include "engineoptioncache.h"
+#include "engineoptionfactory.h"
 
 namespace {
 
@@ -84,14 +86,19 @@ QStringRef joinTokens(const QVarLengthArray<QStringRef>& tokens)
 
 UciEngine::UciEngine(QObject* parent)
 	: ChessEngine(parent),
+	  m_positionPrefixLength(0),
+	  m_positionPending(false),
 	  m_useDirectPv(false),
 	  m_sendOpponentsName(false),
 	  m_canPonder(false),
+	  m_optionsRestored(false),
 	  m_ponderState(NotPondering),
 	  m_movesPondered(0),
 	  m_ponderHits(0),
 	  m_ignoreThinking(false),
-	  m_rePing(false)
+	  m_rePing(false),
+	  m_multiPvDepth(0),
+	  m_lastPvNumber(0)
 {
 	addVariant("standard");
 	setName("UciEngine");
@@ -99,28 +106,84 @@ UciEngine::UciEngine(QObject* parent)
 
 void UciEngine::startProtocol()
 {
+	restoreFromOptionCache();
+
 	// Tell the engine to turn on UCI mode
 	write("uci");
 }
 
-QString UciEngine::positionString()
+void UciEngine::restoreFromOptionCache()
 {
-	QString str("position");
+	QVariantMap data;
+	if (!EngineOptionCache::lookup(optionCacheKey(), "uci", &data))
+		return;
 
-	if (board()->isRandomVariant() || m_startFen != board()->defaultFenString())
-		str += QString(" fen ") + m_startFen;
-	else
-		str += " startpos";
+	const QVariantList options = data.value("options").toList();
+	for (const QVariant& optionData : options)
+	{
+		EngineOption* option = EngineOptionFactory::create(optionData.toMap());
+		if (option != nullptr)
+			addOption(option);
+	}
 
-	if (!m_moveStrings.isEmpty())
-		str += QString(" moves") + m_moveStrings;
+	const QStringList variants = data.value("variants").toStringList();
+	for (const QString& variant : variants)
+		addVariant(variant);
 
-	return str;
+	m_canPonder = data.value("ponder").toBool();
+	m_sendOpponentsName = data.value("opponent").toBool();
+	m_optionsRestored = true;
+}
+
+void UciEngine::storeToOptionCache() const
+{
+	const QString key = optionCacheKey();
+	if (key.isEmpty())
+		return;
+
+	// At this point the options still hold the values the engine
+	// reported as defaults; configured values are applied later
+	QVariantList optionList;
+	const auto options = this->options();
+	for (const EngineOption* option : options)
+		optionList << option->toVariant();
+
+	QVariantMap data;
+	data["options"] = optionList;
+	data["variants"] = variants();
+	data["ponder"] = m_canPonder;
+	data["opponent"] = m_sendOpponentsName;
+
+	EngineOptionCache::store(key, "uci", data);
+}
+
+const QByteArray& UciEngine::positionString() const
+{
+	return m_positionString;
+}
+
+void UciEngine::appendPositionMove(const QString& moveString)
+{
+	if (m_positionString.length() == m_positionPrefixLength)
+		m_positionString += " moves";
+	m_positionString += ' ';
+	m_positionString += moveString.toLatin1();
+}
+
+void UciEngine::removeLastPositionMove()
+{
+	m_positionString.truncate(m_positionString.lastIndexOf(' '));
+	if (m_positionString.length() == m_positionPrefixLength + 6)
+		m_positionString.chop(6); // strip a trailing " moves"
 }
 
 void UciEngine::sendPosition()
 {
-	write(positionString());
+	// The engine needs the position only when it's told to think
+	// about it. Defer the send; startThinking() prepends it to
+	// the "go" command, so a move costs one pipe write and one
+	// engine wakeup instead of two.
+	m_positionPending = true;
 }
 
 void UciEngine::startGame()
@@ -136,7 +199,6 @@ void UciEngine::startGame()
 	m_movesPondered = 0;
 	m_ponderHits = 0;
 	m_bmBuffer.clear();
-	m_moveStrings.clear();
 	m_useDirectPv = directPvList.contains(board()->variant());
 
 	if (board()->isRandomVariant())
@@ -145,17 +207,30 @@ void UciEngine::startGame()
 		m_startFen = board()->fenString(Chess::Board::XFen);
 	setVariant(board()->variant());
 
+	// Assemble the "position" command once; makeMove() then appends
+	// each new move in place instead of rebuilding the whole move
+	// list before every "go".
+	m_positionString.clear();
+	m_positionString.reserve(1024);
+	m_positionString += "position";
+	if (board()->isRandomVariant()
+	||  m_startFen != board()->defaultFenString())
+		m_positionString += " fen " + m_startFen.toLatin1();
+	else
+		m_positionString += " startpos";
+	m_positionPrefixLength = m_positionString.length();
+
 	write("ucinewgame");
 
 	if (m_canPonder)
-		sendOption("Ponder", pondering());
+		updateOption("Ponder", pondering());
 
 	if (m_sendOpponentsName)
 	{
 		QString opType = opponent()->isHuman() ? "human" : "computer";
 		QString value = QString("none none %1 %2")
 				.arg(opType, opponent()->name());
-		sendOption("UCI_Opponent", value);
+		updateOption("UCI_Opponent", value);
 	}
 
 	sendPosition();
@@ -187,7 +262,7 @@ void UciEngine::makeMove(const Chess::Move& move)
 			m_ponderMoveSan.clear();
 			if (m_ponderState != PonderHit)
 			{
-				m_moveStrings.truncate(m_moveStrings.lastIndexOf(' '));
+				removeLastPositionMove();
 				if (isReady())
 				{
 					m_ignoreThinking = true;
@@ -207,9 +282,12 @@ void UciEngine::makeMove(const Chess::Move& move)
 	if (m_ponderState != PonderHit)
 	{
 		m_ponderState = NotPondering;
-		m_moveStrings += " " + board()->moveString(move, Chess::Board::LongAlgebraic);
+		appendPositionMove(board()->moveString(move, Chess::Board::LongAlgebraic));
 		if (m_ignoreThinking)
+		{
 			m_bmBuffer << positionString() << "isready";
+			m_positionPending = false;
+		}
 		else
 			sendPosition();
 	}
@@ -280,7 +358,13 @@ void UciEngine::startThinking()
 	if (myTc->nodeLimit() > 0)
 		command += QString(" nodes %1").arg(myTc->nodeLimit());
 
-	write(command);
+	if (m_positionPending)
+	{
+		m_positionPending = false;
+		write(positionString() + '\n' + command.toLatin1());
+	}
+	else
+		write(command);
 }
 
 void UciEngine::startPondering()
@@ -288,7 +372,7 @@ void UciEngine::startPondering()
 	if (!pondering() || m_ponderMove.isNull())
 		return;
 
-	m_moveStrings += " " + board()->moveString(m_ponderMove, Chess::Board::LongAlgebraic);
+	appendPositionMove(board()->moveString(m_ponderMove, Chess::Board::LongAlgebraic));
 	sendPosition();
 	ping();
 	startThinking();
@@ -389,19 +473,19 @@ void UciEngine::parseInfo(const QVarLengthArray<QStringRef>& tokens,
 	switch (type)
 	{
 	case InfoDepth:
-		eval->setDepth(tokens[0].toString().toInt());
+		eval->setDepth(tokens[0].toInt());
 		break;
 	case InfoSelDepth:
-		eval->setSelectiveDepth(tokens[0].toString().toInt());
+		eval->setSelectiveDepth(tokens[0].toInt());
 		break;
 	case InfoTime:
-		eval->setTime(tokens[0].toString().toInt());
+		eval->setTime(tokens[0].toInt());
 		break;
 	case InfoNodes:
-		eval->setNodeCount(tokens[0].toString().toULongLong());
+		eval->setNodeCount(tokens[0].toULongLong());
 		break;
 	case InfoMultiPv:
-		eval->setPvNumber(tokens[0].toString().toInt());
+		eval->setPvNumber(tokens[0].toInt());
 		break;
 	case InfoPv:
 		eval->setPv(m_useDirectPv ?  directPv(tokens) : sanPv(tokens));
@@ -412,10 +496,10 @@ void UciEngine::parseInfo(const QVarLengthArray<QStringRef>& tokens,
 			for (int i = 1; i < tokens.size(); i++)
 			{
 				if (tokens[i - 1] == "cp")
-					score = tokens[i].toString().toInt();
+					score = tokens[i].toInt();
 				else if (tokens[i - 1] == "mate")
 				{
-					score = tokens[i].toString().toInt();
+					score = tokens[i].toInt();
 					if (score > 0)
 						score = 99000 + 1 - score * 2;
 					else if (score < 0)
@@ -432,13 +516,13 @@ void UciEngine::parseInfo(const QVarLengthArray<QStringRef>& tokens,
 		}
 		break;
 	case InfoNps:
-		eval->setNps(tokens[0].toString().toULongLong());
+		eval->setNps(tokens[0].toULongLong());
 		break;
 	case InfoTbHits:
-		eval->setTbHits(tokens[0].toString().toULongLong());
+		eval->setTbHits(tokens[0].toULongLong());
 		break;
 	case InfoHashFull:
-		eval->setHashUsage(tokens[0].toString().toInt());
+		eval->setHashUsage(tokens[0].toInt());
 		break;
 	default:
 		break;
@@ -498,10 +582,40 @@ void UciEngine::parseInfo(const QStringRef& line)
 			m_currentEval.clear();
 		m_currentEval.merge(eval);
 
-		emit thinking(m_currentEval);
+		emitThinking(m_currentEval);
 	}
-	else
-		emit thinking(eval);
+
+	// In MultiPV mode ("multipv" present on the line) the PV lines
+	// are collected and delivered once per completed iteration
+	// instead of one signal per line
+	if (eval.pvNumber() >= 1 && !eval.pv().isEmpty())
+		addToMultiPvBatch(eval);
+}
+
+void UciEngine::addToMultiPvBatch(const MoveEvaluation& eval)
+{
+	// The PV numbering restarting or the depth changing means the
+	// previous iteration is complete
+	if (!m_multiPvBatch.isEmpty()
+	&&  (eval.pvNumber() <= m_lastPvNumber
+	||   eval.depth() != m_multiPvDepth))
+		flushMultiPvBatch();
+
+	m_lastPvNumber = eval.pvNumber();
+	m_multiPvDepth = eval.depth();
+	if (eval.pvNumber() > m_multiPvBatch.size())
+		m_multiPvBatch.resize(eval.pvNumber());
+	m_multiPvBatch[eval.pvNumber() - 1] = eval;
+}
+
+void UciEngine::flushMultiPvBatch()
+{
+	if (!m_multiPvBatch.isEmpty())
+	{
+		emit multiPvThinking(m_multiPvBatch);
+		m_multiPvBatch.clear();
+	}
+	m_lastPvNumber = 0;
 }
 
 EngineOption* UciEngine::parseOption(const QStringRef& line)
@@ -625,7 +739,7 @@ void UciEngine::parseLine(const QString& line)
 				 qUtf8Printable(name()));
 			m_ponderMove = Chess::Move();
 			m_ponderMoveSan.clear();
-			m_moveStrings.truncate(m_moveStrings.lastIndexOf(' '));
+			removeLastPositionMove();
 			pong();
 			return;
 		}
@@ -641,8 +755,13 @@ void UciEngine::parseLine(const QString& line)
 
 		QStringRef token(nextToken(command));
 		QString moveString(token.toString());
-		m_moveStrings += " " + moveString;
-		Chess::Move move = board()->moveFromString(moveString);
+		appendPositionMove(moveString);
+		// UCI moves are coordinate notation, so try the direct
+		// parse first and fall back to the generic one, which
+		// starts with the more expensive SAN attempt
+		Chess::Move move = board()->moveFromLanString(moveString);
+		if (move.isNull() || !board()->isLegalMove(move))
+			move = board()->moveFromString(moveString);
 		if (move.isNull())
 		{
 			forfeit(Chess::Result::IllegalMove, moveString);
@@ -656,6 +775,10 @@ void UciEngine::parseLine(const QString& line)
 			board()->undoMove();
 		}
 
+		// Deliver the final evaluation and the last, possibly
+		// partial, multi-PV iteration before the move
+		flushThinking();
+		flushMultiPvBatch();
 		emitMove(move);
 	}
 	else if (command == "readyok")
@@ -673,6 +796,8 @@ void UciEngine::parseLine(const QString& line)
 	{
 		if (state() == Starting)
 		{
+			if (!m_optionsRestored)
+				storeToOptionCache();
 			onProtocolStart();
 			ping();
 		}
@@ -694,6 +819,11 @@ void UciEngine::parseLine(const QString& line)
 	}
 	else if (command == "option")
 	{
+		// The dump was already restored from the option cache;
+		// don't parse it a second time
+		if (m_optionsRestored)
+			return;
+
 		EngineOption* option = parseOption(command);
 		QString variant;
 
@@ -749,18 +879,18 @@ void UciEngine::setVariant(const QString& variant)
 {
 	QString uciVariant(variantToUci(variant));
 	if (uciVariant != m_variantOption && !m_variantOption.isEmpty())
-		sendOption(m_variantOption, false);
+		updateOption(m_variantOption, false);
 
 	if (m_comboVariants.contains(variant))
 	{
 		m_variantOption.clear();
-		sendOption("UCI_Variant", variantToUci(variant, false));
+		updateOption("UCI_Variant", variantToUci(variant, false));
 	}
 	else
 	{
 		m_variantOption = uciVariant;
 		if (!uciVariant.isEmpty())
-			sendOption(uciVariant, true);
+			updateOption(uciVariant, true);
 	}
 }
 
@@ -812,6 +942,10 @@ QString UciEngine::directPv(const QVarLengthArray<QStringRef>& tokens)
 QString UciEngine::sanPv(const QVarLengthArray<QStringRef>& tokens)
 {
 	Chess::Board* board = this->board();
+	// Without a game there's no position to convert the moves in
+	if (board == nullptr)
+		return directPv(tokens);
+
 	QString pv;
 	int movesMade = 0;
 
@@ -844,7 +978,7 @@ QString UciEngine::sanPv(const QVarLengthArray<QStringRef>& tokens)
 	return pv;
 }
 
-void UciEngine::sendOption(const QString& name, const QVariant& value)
+void UciEngine::sendOption(const QString& name, const EngineOptionValue& value)
 {
 	if (!value.isNull())
 		write(QString("setoption name %1 value %2").arg(name, value.toString()));
@@ -52,7 +52,8 @@ class LIB_EXPORT UciEngine : public ChessEngine
 		virtual void startGame();
 		virtual void startThinking();
 		virtual void parseLine(const QString& line);
-		virtual void sendOption(const QString& name, const QVariant& value);
+		virtual void sendOption(const QString& name,
+					const EngineOptionValue& value);
 		virtual bool isPondering() const;
 		
 	private:
@@ -73,23 +74,38 @@ class LIB_EXPORT UciEngine : public ChessEngine
 			       MoveEvaluation* eval);
 		void parseInfo(const QStringRef& line);
 		EngineOption* parseOption(const QStringRef& line);
+		void restoreFromOptionCache();
+		void storeToOptionCache() const;
 		void addVariantsFromOption(const EngineOption* option);
 		void setVariant(const QString& variant);
-		QString positionString();
+		const QByteArray& positionString() const;
+		void appendPositionMove(const QString& moveString);
+		void removeLastPositionMove();
 		void sendPosition();
 		void setPonderMove(const QString& moveString);
 		QString directPv(const QVarLengthArray<QStringRef>& tokens);
 		QString sanPv(const QVarLengthArray<QStringRef>& tokens);
+		void addToMultiPvBatch(const MoveEvaluation& eval);
+		void flushMultiPvBatch();
 		
 		QString m_variantOption;
 		QString m_startFen;
-		QString m_moveStrings;
+		// The full "position" command as raw bytes, extended in
+		// place as moves are played
+		QByteArray m_positionString;
+		int m_positionPrefixLength;
+		// The position changed but hasn't been sent yet; it's
+		// prepended to the next "go" in the same pipe write
+		bool m_positionPending;
 		bool m_useDirectPv;
 		// Write buffer for messages that will be flushed to the engine
 		// after it sends a "bestmove"
-		QStringList m_bmBuffer;
+		QList<QByteArray> m_bmBuffer;
 		bool m_sendOpponentsName;
 		bool m_canPonder;
+		// The option dump was restored from EngineOptionCache,
+		// so the engine's own dump can be skipped
+		bool m_optionsRestored;
 		PonderState m_ponderState;
 		Chess::Move m_ponderMove;
 		QString m_ponderMoveSan;
@@ -98,6 +114,12 @@ class LIB_EXPORT UciEngine : public ChessEngine
 		bool m_ignoreThinking;
 		bool m_rePing;
 		MoveEvaluation m_currentEval;
+		// PV lines of the current search iteration, collected
+		// until the iteration completes and delivered as one
+		// multiPvThinking() snapshot
+		QVector<MoveEvaluation> m_multiPvBatch;
+		int m_multiPvDepth;
+		int m_lastPvNumber;
 		QStringList m_comboVariants;
 };
 
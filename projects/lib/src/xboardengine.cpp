@@ -643,17 +643,17 @@ void XboardEngine::parseLine(const QString& line)
 		bool ok = false;
 		int val = 0;
 		QStringRef ref(command);
-		
+
 		// Search depth
-		QString depth(ref.toString());
-		if (!(depth.cend() - 1)->isDigit())
-			depth.chop(1);
+		QStringRef depth(ref);
+		if (!depth.at(depth.size() - 1).isDigit())
+			depth = depth.left(depth.size() - 1);
 		m_eval.setDepth(depth.toInt());
 
 		// Evaluation
 		if ((ref = nextToken(ref)).isNull())
 			return;
-		val = ref.toString().toInt(&ok);
+		val = ref.toInt(&ok);
 		if (ok)
 		{
 			if (whiteEvalPov() && side() == Chess::Side::Black)
@@ -664,14 +664,14 @@ void XboardEngine::parseLine(const QString& line)
 		// Search time
 		if ((ref = nextToken(ref)).isNull())
 			return;
-		val = ref.toString().toInt(&ok);
+		val = ref.toInt(&ok);
 		if (ok)
 			m_eval.setTime(val * 10);
 
 		// Node count
 		if ((ref = nextToken(ref)).isNull())
 			return;
-		val = ref.toString().toULongLong(&ok);
+		val = ref.toULongLong(&ok);
 		if (ok)
 			m_eval.setNodeCount(val);
 
@@ -680,7 +680,7 @@ void XboardEngine::parseLine(const QString& line)
 			return;
 		m_eval.setPv(ref.toString());
 
-		emit thinking(m_eval);
+		emitThinking(m_eval);
 
 		return;
 	}
@@ -688,8 +688,10 @@ void XboardEngine::parseLine(const QString& line)
 	// move format of old CECP engines: 1. ... e2e4
 	bool testDigitAndDot = command.at(0).isDigit() && command.contains(".");
 
-	const QString args(nextToken(command, true).toString());
-	if (command == "move" || (testDigitAndDot && args.startsWith("...")))
+	// Kept as a reference into the line; only the branches that
+	// need a real string make one
+	const QStringRef args(nextToken(command, true));
+	if (command == "move" || (testDigitAndDot && args.startsWith(QLatin1String("..."))))
 	{
 		if (state() != Thinking)
 		{
@@ -702,8 +704,9 @@ void XboardEngine::parseLine(const QString& line)
 		}
 
 		// remove "..." of old format if necessary
-		int mark = (args.indexOf("..."));
-		const QString& movestr = mark < 0 ? args : args.mid(4);
+		const QString movestr = args.startsWith(QLatin1String("..."))
+					? args.mid(4).toString()
+					: args.toString();
 		const QString& newMovestr = transformMove(movestr, board()->height(), +1);
 
 		Chess::Move move = board()->moveFromString(newMovestr);
@@ -730,6 +733,8 @@ void XboardEngine::parseLine(const QString& line)
 			}
 		}
 
+		// Deliver the final evaluation before the move
+		flushThinking();
 		emitMove(move);
 	}
 	else if (command == "pong")
@@ -739,24 +744,56 @@ void XboardEngine::parseLine(const QString& line)
 	}
 	else if (command == "feature")
 	{
-		QRegExp rx("\\w+\\s*=\\s*(\"[^\"]*\"|\\d+)");
-		
+		// name=value pairs, where the value is either a number
+		// or a quoted string; anything else is skipped over
 		int pos = 0;
-		
-		while ((pos = rx.indexIn(args, pos)) != -1)
+		const int len = args.size();
+
+		while (pos < len)
 		{
-			QString cap = rx.cap();
-			int index = cap.indexOf('=');
-			if (index != -1)
+			while (pos < len && !args.at(pos).isLetterOrNumber()
+			&&     args.at(pos) != '_')
+				pos++;
+			const int nameStart = pos;
+			while (pos < len && (args.at(pos).isLetterOrNumber()
+			||     args.at(pos) == '_'))
+				pos++;
+			if (pos == nameStart)
+				break;
+			const QStringRef feature(args.mid(nameStart,
+							  pos - nameStart));
+
+			while (pos < len && args.at(pos).isSpace())
+				pos++;
+			if (pos >= len || args.at(pos) != '=')
+				continue;
+			pos++;
+			while (pos < len && args.at(pos).isSpace())
+				pos++;
+			if (pos >= len)
+				break;
+
+			QStringRef val;
+			if (args.at(pos) == '\"')
 			{
-				QString feature = cap.left(index).trimmed();
-				QString val = cap.mid(index + 1).trimmed();
-				val.remove('\"');
-
-				setFeature(feature, val);
+				const int valStart = ++pos;
+				while (pos < len && args.at(pos) != '\"')
+					pos++;
+				val = args.mid(valStart, pos - valStart);
+				if (pos < len)
+					pos++;
+			}
+			else
+			{
+				const int valStart = pos;
+				while (pos < len && args.at(pos).isDigit())
+					pos++;
+				if (pos == valStart)
+					continue;
+				val = args.mid(valStart, pos - valStart);
 			}
 
-			pos += rx.matchedLength();
+			setFeature(feature.toString(), val.toString());
 		}
 	}
 	else if (command.startsWith("Illegal"))
@@ -764,19 +801,19 @@ void XboardEngine::parseLine(const QString& line)
 		forfeit(Chess::Result::Adjudication,
 			tr("%1 claims illegal %2")
 			.arg(this->side().toString())
-			.arg(args));
+			.arg(args.toString()));
 	}
 	else if (command == "Error")
 	{
 		// If the engine complains about an unknown result command,
 		// we can assume that it's safe to finish the game.
-		QString str = args.section(':', 1).trimmed();
+		QString str = args.toString().section(':', 1).trimmed();
 		if (str.startsWith("result"))
 			finishGame();
 	}
 }
 
-void XboardEngine::sendOption(const QString& name, const QVariant& value)
+void XboardEngine::sendOption(const QString& name, const EngineOptionValue& value)
 {
 	if (name == "memory" || name == "cores" || name.startsWith("egtpath "))
 		write(name + " " + value.toString());
@@ -787,7 +824,7 @@ void XboardEngine::sendOption(const QString& name, const QVariant& value)
 		else
 		{
 			QString tmp;
-			if (value.type() == QVariant::Bool)
+			if (value.type() == EngineOptionValue::Bool)
 				tmp = value.toBool() ? "1" : "0";
 			else
 				tmp = value.toString();
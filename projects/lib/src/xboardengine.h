@@ -49,7 +49,8 @@ class LIB_EXPORT XboardEngine : public ChessEngine
 		virtual void startGame();
 		virtual void startThinking();
 		virtual void parseLine(const QString& line);
-		virtual void sendOption(const QString& name, const QVariant& value);
+		virtual void sendOption(const QString& name,
+					const EngineOptionValue& value);
 		virtual bool restartsBetweenGames() const;
 
 	protected slots:
@@ -0,0 +1,4 @@
+include(../tests.pri)
+
+TARGET = tst_allocations
+SOURCES += tst_allocations.cpp
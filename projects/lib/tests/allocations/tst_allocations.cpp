@@ -0,0 +1,224 @@
+#include <QtTest/QtTest>
+#include <QAtomicInteger>
+#include <QBuffer>
+#include <cstdlib>
+#include <new>
+#include <board/board.h>
+#include <board/boardfactory.h>
+#include <pgnstream.h>
+#include <pgngame.h>
+
+/*
+ * Allocation-regression guard for the hot paths.
+ *
+ * The global allocation operators are replaced with counting
+ * versions, representative workloads are run in a loop, and the test
+ * fails when the per-iteration allocation count exceeds a recorded
+ * baseline. The baselines are ceilings with headroom, not exact
+ * counts: the goal is to catch a change that quietly reintroduces
+ * per-move or per-game heap traffic, not to pin the allocator's
+ * behavior bit for bit. When an optimization lands that lowers a
+ * count, tighten the baseline here to lock it in.
+ */
+
+static QAtomicInteger<qint64> s_allocationCount;
+
+static qint64 allocationCount()
+{
+	return s_allocationCount.loadAcquire();
+}
+
+void* operator new(std::size_t size)
+{
+	s_allocationCount.fetchAndAddRelaxed(1);
+	void* ptr = std::malloc(size);
+	if (ptr == nullptr)
+		throw std::bad_alloc();
+	return ptr;
+}
+
+void* operator new[](std::size_t size)
+{
+	s_allocationCount.fetchAndAddRelaxed(1);
+	void* ptr = std::malloc(size);
+	if (ptr == nullptr)
+		throw std::bad_alloc();
+	return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+
+class tst_Allocations: public QObject
+{
+	Q_OBJECT
+
+	private slots:
+		void initTestCase();
+		void moveGeneration();
+		void sanRoundTrip();
+		void pgnStreaming();
+		void cleanupTestCase();
+
+	private:
+		Chess::Board* m_board = nullptr;
+};
+
+void tst_Allocations::initTestCase()
+{
+	// Make sure the counting operators are actually interposed on
+	// this platform; if not, the counts would read zero and every
+	// baseline check would pass vacuously.
+	const qint64 before = allocationCount();
+	delete new char;
+	QVERIFY2(allocationCount() > before,
+		 "counting allocator not in effect");
+
+	m_board = Chess::BoardFactory::create("standard");
+	QVERIFY(m_board != nullptr);
+	QVERIFY(m_board->setFenString(m_board->defaultFenString()));
+}
+
+void tst_Allocations::cleanupTestCase()
+{
+	delete m_board;
+}
+
+void tst_Allocations::moveGeneration()
+{
+	// A short fixed line; each iteration walks it forward and back,
+	// generating the legal moves in every position
+	const QStringList line = QStringList()
+		<< "e4" << "e5" << "Nf3" << "Nc6" << "Bb5" << "a6";
+	QVector<Chess::Move> moves;
+	for (const QString& str : line)
+	{
+		Chess::Move move = m_board->moveFromString(str);
+		QVERIFY(!move.isNull());
+		moves.append(move);
+		m_board->makeMove(move);
+	}
+	for (int i = 0; i < moves.size(); i++)
+		m_board->undoMove();
+
+	const int iterations = 100;
+	// One warm-up pass grows the history and cache containers to
+	// their steady-state capacity
+	auto iterate = [&]()
+	{
+		for (const Chess::Move& move : qAsConst(moves))
+		{
+			m_board->makeMove(move);
+			(void)m_board->legalMoves();
+		}
+		for (int i = 0; i < moves.size(); i++)
+			m_board->undoMove();
+	};
+	iterate();
+
+	const qint64 before = allocationCount();
+	for (int i = 0; i < iterations; i++)
+		iterate();
+	const qint64 perIteration = (allocationCount() - before) / iterations;
+
+	// Warm move generation should run the positions of an entire
+	// ply set without per-move heap traffic
+	QVERIFY2(perIteration <= 8,
+		 qPrintable(QString("%1 allocations per iteration")
+			    .arg(perIteration)));
+}
+
+void tst_Allocations::sanRoundTrip()
+{
+	const auto moves = m_board->legalMoves();
+	QVERIFY(!moves.isEmpty());
+
+	auto iterate = [&]()
+	{
+		for (const Chess::Move& move : moves)
+		{
+			QString san = m_board->moveString(
+				move, Chess::Board::StandardAlgebraic);
+			Chess::Move parsed = m_board->moveFromString(san);
+			QCOMPARE(parsed, move);
+		}
+	};
+	iterate();
+
+	const int iterations = 50;
+	const qint64 before = allocationCount();
+	for (int i = 0; i < iterations; i++)
+		iterate();
+	const qint64 perMove = (allocationCount() - before)
+			     / (iterations * moves.size());
+
+	// The QString round trip is inherently a few allocations per
+	// move; the guard is against per-move heap traffic creeping
+	// into generation and disambiguation
+	QVERIFY2(perMove <= 12,
+		 qPrintable(QString("%1 allocations per move").arg(perMove)));
+}
+
+void tst_Allocations::pgnStreaming()
+{
+	const QByteArray pgn =
+		"[Event \"?\"]\n"
+		"[Site \"?\"]\n"
+		"[Date \"????.??.??\"]\n"
+		"[Round \"1\"]\n"
+		"[White \"Player A\"]\n"
+		"[Black \"Player B\"]\n"
+		"[Result \"1-0\"]\n"
+		"\n"
+		"1. e4 e5 2. Nf3 Nc6 3. Bb5 a6 4. Ba4 Nf6 5. O-O Be7\n"
+		"6. Re1 b5 7. Bb3 d6 8. c3 O-O 9. h3 Nb8 10. d4 Nbd7 1-0\n";
+
+	QByteArray data = pgn;
+	QBuffer buffer(&data);
+	QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+	PgnStream stream(m_board->variant());
+	stream.setDevice(&buffer);
+
+	auto iterate = [&]()
+	{
+		stream.rewind();
+		PgnGame game;
+		QVERIFY(game.read(stream));
+		QCOMPARE(game.moves().size(), 20);
+	};
+	iterate();
+
+	const int iterations = 20;
+	const qint64 before = allocationCount();
+	for (int i = 0; i < iterations; i++)
+		iterate();
+	const qint64 perGame = (allocationCount() - before) / iterations;
+
+	// Reading a game builds the tag map, the move vector and the
+	// SAN strings; the ceiling leaves room for that but catches a
+	// regression to per-token or per-ply container churn
+	QVERIFY2(perGame <= 512,
+		 qPrintable(QString("%1 allocations per game").arg(perGame)));
+}
+
+QTEST_MAIN(tst_Allocations)
+#include "tst_allocations.moc"
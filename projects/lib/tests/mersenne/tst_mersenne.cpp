@@ -8,6 +8,7 @@ class tst_Mersenne: public QObject
 	private slots:
 		void numbers_data();
 		void numbers();
+		void threadSeeding();
 };
 
 void tst_Mersenne::numbers_data()
@@ -18,13 +19,13 @@ void tst_Mersenne::numbers_data()
 
 	QTest::newRow("0")
 		<< quint32(0U)
-		<< quint32(2357136044U)
-		<< quint32(1745961492U);
+		<< quint32(2582401460U)
+		<< quint32(3211664042U);
 
 	QTest::newRow("0xFFFFFFFF")
 		<< quint32(0xFFFFFFFFU)
-		<< quint32(485482874U)
-		<< quint32(4213522654U);
+		<< quint32(1441002626U)
+		<< quint32(1326858296U);
 }
 
 void tst_Mersenne::numbers()
@@ -39,5 +40,24 @@ void tst_Mersenne::numbers()
 }
 
 
+void tst_Mersenne::threadSeeding()
+{
+	Mersenne::initialize(12345);
+
+	Mersenne::initializeThread(7);
+	quint32 a1 = Mersenne::random();
+	quint32 a2 = Mersenne::random();
+
+	Mersenne::initializeThread(8);
+	quint32 b1 = Mersenne::random();
+
+	// The same seed and key must reproduce the same sequence,
+	// and a different key must give a different one
+	Mersenne::initializeThread(7);
+	QCOMPARE(Mersenne::random(), a1);
+	QCOMPARE(Mersenne::random(), a2);
+	QVERIFY(a1 != b1);
+}
+
 QTEST_MAIN(tst_Mersenne)
 #include "tst_mersenne.moc"
@@ -0,0 +1,4 @@
+include(../tests.pri)
+
+TARGET = tst_pgnverifier
+SOURCES += tst_pgnverifier.cpp
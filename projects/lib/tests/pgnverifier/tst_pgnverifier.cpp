@@ -0,0 +1,92 @@
+#include <QtTest/QtTest>
+#include <pgnstream.h>
+#include <pgngame.h>
+#include <pgnverifier.h>
+
+
+class tst_PgnVerifier: public QObject
+{
+	Q_OBJECT
+
+	private slots:
+		void cleanGame();
+		void corruptMove();
+		void corruptKey();
+		void queuedVerification();
+
+	private:
+		PgnGame readGame() const;
+};
+
+PgnGame tst_PgnVerifier::readGame() const
+{
+	const QByteArray text =
+		"[Event \"?\"]\n"
+		"[Site \"?\"]\n"
+		"[Date \"????.??.??\"]\n"
+		"[Round \"?\"]\n"
+		"[White \"White\"]\n"
+		"[Black \"Black\"]\n"
+		"[Result \"1-0\"]\n"
+		"\n"
+		"1. e4 e5 2. Nf3 Nc6 3. Bb5 a6 4. Ba4 Nf6 5. O-O 1-0\n";
+
+	PgnStream stream(&text);
+	PgnGame game;
+	game.read(stream);
+
+	return game;
+}
+
+void tst_PgnVerifier::cleanGame()
+{
+	PgnGame game = readGame();
+	QCOMPARE(game.moves().size(), 9);
+	QVERIFY(PgnVerifier::findDiscrepancy(game).isEmpty());
+}
+
+void tst_PgnVerifier::corruptMove()
+{
+	PgnGame game = readGame();
+
+	// An illegal SAN string must be flagged
+	PgnGame::MoveData md = game.moves().at(4);
+	md.moveString = "Bxe5";
+	game.setMove(4, md);
+
+	QVERIFY(!PgnVerifier::findDiscrepancy(game).isEmpty());
+}
+
+void tst_PgnVerifier::corruptKey()
+{
+	PgnGame game = readGame();
+
+	// A stored position key that doesn't match the replay must
+	// be flagged
+	PgnGame::MoveData md = game.moves().at(6);
+	md.key ^= 1;
+	game.setMove(6, md);
+
+	QVERIFY(!PgnVerifier::findDiscrepancy(game).isEmpty());
+}
+
+void tst_PgnVerifier::queuedVerification()
+{
+	PgnGame game = readGame();
+	PgnGame::MoveData md = game.moves().at(2);
+	md.moveString = "Nc3";
+	game.setMove(2, md);
+
+	PgnVerifier verifier;
+	QSignalSpy spy(&verifier, SIGNAL(discrepancyFound(int, QString)));
+
+	verifier.verify(readGame(), 1);
+	verifier.verify(game, 2);
+
+	// Only the corrupted game should be reported
+	QTRY_COMPARE(spy.count(), 1);
+	QCOMPARE(spy.at(0).at(0).toInt(), 2);
+}
+
+QTEST_MAIN(tst_PgnVerifier)
+#include "tst_pgnverifier.moc"
@@ -10,6 +10,7 @@ class tst_PolyglotBook: public QObject
 	private slots:
 		void initialValues();
 		void startPos();
+		void deltaSegments();
 
 	private:
 		QMap<QString,quint16> entries(const OpeningBook* book,
@@ -74,5 +75,57 @@ void tst_PolyglotBook::startPos()
 	QCOMPARE(entries, expect);
 }
 
+void tst_PolyglotBook::deltaSegments()
+{
+	const QString base = "book_delta.bin";
+	const QString segment = base + ".d1";
+	QFile::remove(base);
+	QFile::remove(segment);
+	QVERIFY(QFile::copy("book_small.bin", base));
+
+	Chess::StandardBoard board;
+	board.initialize();
+	board.setFenString(board.defaultFenString());
+
+	auto book = PolyglotBook(OpeningBook::Ram);
+	QVERIFY(book.read(base));
+	auto expect = this->entries(&book, &board);
+	QVERIFY(!expect.isEmpty());
+
+	// Add the whole base book again as new entries and write
+	// them out as a delta segment
+	{
+		QFile file("book_small.bin");
+		QVERIFY(file.open(QIODevice::ReadOnly));
+		QDataStream in(&file);
+		in >> &book;
+	}
+	QVERIFY(book.writeDelta(base));
+	QVERIFY(QFile::exists(segment));
+	QCOMPARE(OpeningBook::segmentFiles(base), QStringList(segment));
+
+	// Reading merges the base book and the segment, doubling
+	// every weight
+	QMap<QString,quint16> doubled;
+	for (auto it = expect.constBegin(); it != expect.constEnd(); ++it)
+		doubled[it.key()] = it.value() * 2;
+
+	QVERIFY(book.read(base));
+	QCOMPARE(this->entries(&book, &board), doubled);
+
+	// Same test with direct disk access
+	auto diskBook = PolyglotBook(OpeningBook::Disk);
+	QVERIFY(diskBook.read(base));
+	QCOMPARE(this->entries(&diskBook, &board), doubled);
+
+	// Compacting folds the segment into the base file
+	QVERIFY(book.compact(base));
+	QVERIFY(!QFile::exists(segment));
+	QVERIFY(book.read(base));
+	QCOMPARE(this->entries(&book, &board), doubled);
+
+	QFile::remove(base);
+}
+
 QTEST_MAIN(tst_PolyglotBook)
 #include "tst_polyglotbook.moc"
@@ -9,6 +9,7 @@ class tst_Sprt: public QObject
 	private slots:
 		void sprt_data() const;
 		void sprt();
+		void pentanomial();
 
 	private:
 		bool fuzzyCompare(double val1, double val2);
@@ -100,5 +101,35 @@ void tst_Sprt::sprt()
 	QVERIFY(fuzzyCompare(status.uBound, ubound));
 }
 
+void tst_Sprt::pentanomial()
+{
+	Sprt sprt;
+	sprt.initialize(0.0, 10.0, 0.05, 0.05);
+
+	// 135 pairs: 10 LL, 25 LD/DL, 50 DD/WL, 35 WD/DW, 15 WW
+	const struct
+	{
+		Sprt::GameResult first;
+		Sprt::GameResult second;
+		int count;
+	} pairs[] = {
+		{ Sprt::Loss, Sprt::Loss, 10 },
+		{ Sprt::Loss, Sprt::Draw, 25 },
+		{ Sprt::Draw, Sprt::Draw, 30 },
+		{ Sprt::Win,  Sprt::Loss, 20 },
+		{ Sprt::Win,  Sprt::Draw, 35 },
+		{ Sprt::Win,  Sprt::Win,  15 }
+	};
+	for (const auto& pair : pairs)
+		for (int i = 0; i < pair.count; i++)
+			sprt.addPairResult(pair.first, pair.second);
+
+	Sprt::Status status = sprt.status();
+	QCOMPARE(status.result, Sprt::Continue);
+	QVERIFY(fuzzyCompare(status.llr, 0.80));
+	QVERIFY(fuzzyCompare(status.lBound, -2.94));
+	QVERIFY(fuzzyCompare(status.uBound, 2.94));
+}
+
 QTEST_MAIN(tst_Sprt)
 #include "tst_sprt.moc"
@@ -0,0 +1,4 @@
+include(../tests.pri)
+
+TARGET = tst_taskfuture
+SOURCES += tst_taskfuture.cpp
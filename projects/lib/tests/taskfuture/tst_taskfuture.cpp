@@ -0,0 +1,93 @@
+#include <QtTest/QtTest>
+#include <QSemaphore>
+#include <taskfuture.h>
+
+
+class tst_TaskFuture: public QObject
+{
+	Q_OBJECT
+
+	private slots:
+		void result();
+		void continuations();
+		void lateContinuation();
+		void cancelBeforeStart();
+		void cancelledContinuation();
+};
+
+void tst_TaskFuture::result()
+{
+	auto future = runTask([]() { return 6 * 7; });
+	QCOMPARE(future.result(), 42);
+	QVERIFY(future.isFinished());
+	QVERIFY(!future.isCancelled());
+}
+
+void tst_TaskFuture::continuations()
+{
+	auto future = runTask([]() { return 20; })
+		.then([](int value) { return value + 1; })
+		.then([](int value) { return QString::number(value * 2); });
+
+	QCOMPARE(future.result(), QString("42"));
+}
+
+void tst_TaskFuture::lateContinuation()
+{
+	// A continuation chained after the task finished must still run
+	auto future = runTask([]() { return 5; });
+	future.waitForFinished();
+
+	auto next = future.then([](int value) { return value + 1; });
+	QCOMPARE(next.result(), 6);
+}
+
+void tst_TaskFuture::cancelBeforeStart()
+{
+	QThreadPool pool;
+	pool.setMaxThreadCount(1);
+
+	// Block the pool's only thread so that the second task can't
+	// start before it's cancelled
+	QSemaphore blocker;
+	auto first = runTask(&pool, [&blocker]()
+	{
+		blocker.acquire();
+		return 1;
+	});
+	auto second = runTask(&pool, []() { return 2; });
+
+	second.cancel();
+	blocker.release();
+
+	second.waitForFinished();
+	QVERIFY(second.isCancelled());
+	QCOMPARE(second.result(), 0);
+	QCOMPARE(first.result(), 1);
+}
+
+void tst_TaskFuture::cancelledContinuation()
+{
+	QThreadPool pool;
+	pool.setMaxThreadCount(1);
+
+	QSemaphore blocker;
+	auto first = runTask(&pool, [&blocker]()
+	{
+		blocker.acquire();
+		return 1;
+	});
+	auto next = first.then([](int value) { return value + 1; });
+
+	first.cancel();
+	blocker.release();
+
+	// The cancellation must propagate down the chain without
+	// running the continuation
+	next.waitForFinished();
+	QVERIFY(next.isCancelled());
+	QCOMPARE(next.result(), 0);
+}
+
+QTEST_MAIN(tst_TaskFuture)
+#include "tst_taskfuture.moc"
@@ -1,5 +1,5 @@
 TEMPLATE = subdirs
-SUBDIRS = chessboard tb sprt mersenne tournamentplayer tournamentpair polyglotbook
+SUBDIRS = chessboard tb sprt mersenne tournamentplayer tournamentpair polyglotbook pgnverifier taskfuture allocations
 win32 {
     SUBDIRS += pipereader
 }
@@ -0,0 +1,251 @@
+/*
+    This file is part of Cute Chess.
+    Copyright (C) 2008-2018 Cute Chess authors
+
+    Cute Chess is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Cute Chess is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Cute Chess.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * A perft benchmark for the board classes.
+ *
+ * Runs fixed-depth perft on the default starting position of one or
+ * more variants and reports node counts and nodes/sec. The output is
+ * one tab-separated line per variant, so results from two builds can
+ * be diffed or joined to spot move-generation regressions before a
+ * new cutechess-cli is deployed.
+ *
+ * With -t the root moves are split across a thread pool, each worker
+ * searching its share on a private Board clone. Besides speed this
+ * doubles as a smoke test for the thread-safety of the board layer,
+ * which the concurrent-game architecture depends on: the node counts
+ * must match a single-threaded run exactly.
+ *
+ * Usage: perft [-d depth] [-t threads] [variant ...]
+ */
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QStringList>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QAtomicInt>
+#include <QVector>
+#include <board/board.h>
+#include <board/boardfactory.h>
+
+namespace {
+
+struct BenchVariant
+{
+	const char* name;
+	int depth;
+};
+
+// Default benchmark set: the variants our tournaments actually run,
+// with depths chosen so each takes a few seconds on current hardware.
+const BenchVariant s_defaultVariants[] = {
+	{ "standard", 5 },
+	{ "capablanca", 4 },
+	{ "crazyhouse", 4 },
+	{ "makruk", 5 },
+	{ "atomic", 4 },
+	{ "berolina", 5 }
+};
+
+quint64 perft(Chess::Board* board, int depth)
+{
+	const QVector<Chess::Move> moves(board->legalMoves());
+	if (depth == 1 || moves.size() == 0)
+		return moves.size();
+
+	quint64 nodeCount = 0;
+	for (const Chess::Move& move: moves)
+	{
+		board->makeMove(move);
+		nodeCount += perft(board, depth - 1);
+		board->undoMove();
+	}
+
+	return nodeCount;
+}
+
+// Searches a dynamically assigned share of the root moves on a
+// private clone of the root board and stores the node count in a
+// result slot of its own, so no locking is needed.
+class PerftWorker : public QRunnable
+{
+	public:
+		PerftWorker(const Chess::Board* board,
+			    const QVector<Chess::Move>* moves,
+			    QAtomicInt* nextIndex,
+			    int depth,
+			    quint64* result)
+			: m_board(board),
+			  m_moves(moves),
+			  m_nextIndex(nextIndex),
+			  m_depth(depth),
+			  m_result(result)
+		{
+		}
+
+		virtual void run()
+		{
+			Chess::Board* board = m_board->copy();
+			quint64 nodes = 0;
+
+			int i;
+			while ((i = m_nextIndex->fetchAndAddRelaxed(1)) < m_moves->size())
+			{
+				board->makeMove(m_moves->at(i));
+				nodes += perft(board, m_depth - 1);
+				board->undoMove();
+			}
+
+			delete board;
+			*m_result = nodes;
+		}
+
+	private:
+		const Chess::Board* m_board;
+		const QVector<Chess::Move>* m_moves;
+		QAtomicInt* m_nextIndex;
+		int m_depth;
+		quint64* m_result;
+};
+
+quint64 parallelPerft(Chess::Board* board, int depth, int threadCount)
+{
+	const QVector<Chess::Move> moves(board->legalMoves());
+	if (depth == 1 || moves.size() == 0)
+		return moves.size();
+
+	QThreadPool pool;
+	pool.setMaxThreadCount(threadCount);
+
+	QAtomicInt nextIndex(0);
+	QVector<quint64> results(threadCount, 0);
+	for (int i = 0; i < threadCount; i++)
+		pool.start(new PerftWorker(board, &moves, &nextIndex,
+					   depth, &results[i]));
+	pool.waitForDone();
+
+	quint64 nodeCount = 0;
+	for (quint64 result: qAsConst(results))
+		nodeCount += result;
+	return nodeCount;
+}
+
+int runBenchmark(QTextStream& out, const QString& variant, int depth, int threadCount)
+{
+	Chess::Board* board = Chess::BoardFactory::create(variant);
+	if (board == nullptr)
+	{
+		QTextStream(stderr) << "Unknown variant: "
+				    << variant << '\n';
+		return 1;
+	}
+
+	board->reset();
+
+	QElapsedTimer timer;
+	timer.start();
+	quint64 nodes = (threadCount > 1) ? parallelPerft(board, depth, threadCount)
+					  : perft(board, depth);
+	qint64 msecs = timer.elapsed();
+
+	quint64 nps = (msecs > 0) ? nodes * 1000 / msecs : 0;
+	out << variant << '\t'
+	    << "depth " << depth << '\t'
+	    << nodes << " nodes\t"
+	    << msecs << " ms\t"
+	    << nps << " nodes/s" << '\n';
+	out.flush();
+
+	delete board;
+	return 0;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+	QCoreApplication app(argc, argv);
+	QTextStream out(stdout);
+
+	int depth = 0;
+	int threadCount = 1;
+	QStringList variants;
+
+	const QStringList args = app.arguments().mid(1);
+	for (int i = 0; i < args.size(); i++)
+	{
+		if (args.at(i) == "-d" || args.at(i) == "--depth")
+		{
+			if (++i >= args.size())
+			{
+				QTextStream(stderr)
+					<< "Missing depth argument\n";
+				return 1;
+			}
+			depth = args.at(i).toInt();
+			if (depth < 1)
+			{
+				QTextStream(stderr)
+					<< "Invalid depth: "
+					<< args.at(i) << '\n';
+				return 1;
+			}
+		}
+		else if (args.at(i) == "-t" || args.at(i) == "--threads")
+		{
+			if (++i >= args.size())
+			{
+				QTextStream(stderr)
+					<< "Missing thread count argument\n";
+				return 1;
+			}
+			threadCount = args.at(i).toInt();
+			if (threadCount < 1)
+			{
+				QTextStream(stderr)
+					<< "Invalid thread count: "
+					<< args.at(i) << '\n';
+				return 1;
+			}
+		}
+		else
+			variants << args.at(i);
+	}
+
+	int ret = 0;
+	if (variants.isEmpty())
+	{
+		for (const BenchVariant& bv: s_defaultVariants)
+			ret |= runBenchmark(out,
+					    bv.name,
+					    depth > 0 ? depth : bv.depth,
+					    threadCount);
+	}
+	else
+	{
+		for (const QString& variant: qAsConst(variants))
+			ret |= runBenchmark(out,
+					    variant,
+					    depth > 0 ? depth : 5,
+					    threadCount);
+	}
+
+	return ret;
+}
@@ -0,0 +1,24 @@
+TARGET = perft
+DESTDIR = $$PWD
+
+include(../lib/lib.pri)
+include(../lib/libexport.pri)
+
+OBJECTS_DIR = .obj/
+MOC_DIR = .moc/
+
+win32 {
+    CONFIG += console
+}
+
+!win32-msvc* {
+	QMAKE_CXXFLAGS += -Wextra -Wshadow
+}
+
+mac {
+    CONFIG -= app_bundle
+}
+
+QT = core
+
+SOURCES += main.cpp
@@ -1,7 +1,9 @@
 CONFIG += ordered
 
 TEMPLATE = subdirs
-SUBDIRS = lib gui cli
+SUBDIRS = lib gui cli perft boardimg
 
 cli.depends = lib
 gui.depends = lib
+perft.depends = lib
+boardimg.depends = lib